@@ -112,6 +112,8 @@ AlignmentParameters::selectedDerivatives(const TrajectoryStateOnSurface& tsos,
   const int nrows  = dev.num_row();
   const int nsel   = numSelected();
 
+  if (nsel == nrows) return dev; // all parameters selected, nothing to remove
+
   AlgebraicMatrix seldev(nsel, ncols);
 
   int ir2 = 0;
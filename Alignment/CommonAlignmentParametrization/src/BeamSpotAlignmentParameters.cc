@@ -115,6 +115,8 @@ BeamSpotAlignmentParameters::selectedDerivatives( const TrajectoryStateOnSurface
   int nrows  = dev.num_row();
   int nsel   = numSelected();
 
+  if (nsel == nrows) return dev;
+
   AlgebraicMatrix seldev( nsel, ncols );
 
   int ir2=0;
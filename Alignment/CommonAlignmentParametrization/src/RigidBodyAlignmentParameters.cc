@@ -109,6 +109,8 @@ RigidBodyAlignmentParameters::selectedDerivatives( const TrajectoryStateOnSurfac
   int nrows  = dev.num_row();
   int nsel   = numSelected();
 
+  if (nsel == nrows) return dev;
+
   AlgebraicMatrix seldev( nsel, ncols );
 
   int ir2=0;
@@ -559,7 +559,7 @@ void SiStripGainFromCalibTree::algoComputeMPVandGain() {
 
       if(APV->isMasked){MASKED++; continue;}
 
-      Proj = (TH1F*)(chvsidx->ProjectionY("",chvsidx->GetXaxis()->FindBin(APV->Index),chvsidx->GetXaxis()->FindBin(APV->Index),"e"));
+      Proj = (TH1F*)(chvsidx->ProjectionY("",APV->Bin,APV->Bin,"e"));
       if(!Proj)continue;
 
       if(CalibrationLevel==0){
@@ -31,6 +31,26 @@ public:
      int puppi_register_;     /// Used by puppi algorithm to decide neutrals vs PV vs PU
   };
 
+  // Index of a list of particles in cells of rapidity and phi, so that the particles
+  // within a cone are only searched among the ones of the cells it overlaps.
+  // The candidates are returned in the order of the list, the cone selection still
+  // has to be applied on them.
+  class ParticleGrid {
+   public :
+     ParticleGrid() : fParticles(0) {}
+     void reset(std::vector<fastjet::PseudoJet> const &iParticles);
+     void candidates(fastjet::PseudoJet const &iCentre, double iR, std::vector<fastjet::PseudoJet> &oParticles);
+
+   private :
+     int rapBin(double iRap) const;
+
+     std::vector<fastjet::PseudoJet> const *fParticles;
+     std::vector<unsigned int> fCellStart;   // of the cells in fIndex, and the end
+     std::vector<unsigned int> fIndex;       // of the particles, by cell
+     std::vector<unsigned int> fUnbinned;    // particles with a non finite rapidity or phi
+     std::vector<unsigned int> fCandidates;
+  };
+
 
 
 
@@ -44,7 +64,7 @@ public:
 
 protected:
     double  goodVar      (fastjet::PseudoJet const &iPart,std::vector<fastjet::PseudoJet> const &iParts, int iOpt,double iRCone);
-    void    getRMSAvg    (int iOpt,std::vector<fastjet::PseudoJet> const &iConstits,std::vector<fastjet::PseudoJet> const &iParticles,std::vector<fastjet::PseudoJet> const &iChargeParticles);
+    void    getRMSAvg    (int iOpt,std::vector<fastjet::PseudoJet> const &iConstits,ParticleGrid &iParticles,ParticleGrid &iChargeParticles);
     double  getChi2FromdZ(double iDZ);
     int     getPuppiId   ( float iPt, float iEta);
     double  var_within_R (int iId, const std::vector<fastjet::PseudoJet> & particles, const fastjet::PseudoJet& centre, double R);  
@@ -52,6 +72,9 @@ protected:
     std::vector<RecoObj>   fRecoParticles;
     std::vector<fastjet::PseudoJet> fPFParticles;
     std::vector<fastjet::PseudoJet> fChargedPV;
+    ParticleGrid fPFGrid;
+    ParticleGrid fChargedPVGrid;
+    std::vector<fastjet::PseudoJet> fNearParticles;
     std::vector<fastjet::PseudoJet> fPupParticles;
     std::vector<double>    fWeights;
     std::vector<double>    fVals;
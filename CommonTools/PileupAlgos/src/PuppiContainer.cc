@@ -5,12 +5,75 @@
 #include "TMath.h"
 #include <iostream>
 #include <math.h>
+#include <algorithm>
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/isFinite.h"
 
 using namespace std;
 using namespace fastjet;
 
+namespace {
+  // the cones are up to 0.4
+  const double kGridRapMax    = 5.;
+  const int    kGridNRap      = 40;
+  const int    kGridNPhi      = 25;
+  const double kGridRapSize   = 2.*kGridRapMax/kGridNRap;
+  const double kGridPhiSize   = 2.*M_PI/kGridNPhi;
+}
+
+int PuppiContainer::ParticleGrid::rapBin(double iRap) const {
+  double lBin = std::floor((iRap + kGridRapMax)/kGridRapSize);
+  return lBin < 0 ? 0 : (lBin >= kGridNRap ? kGridNRap - 1 : int(lBin));
+}
+
+void PuppiContainer::ParticleGrid::reset(std::vector<fastjet::PseudoJet> const &iParticles) {
+  fParticles = &iParticles;
+  fUnbinned.clear();
+  // counting sort of the particles by cell, keeping their order within a cell
+  std::vector<int> lCells(iParticles.size());
+  fCellStart.assign(kGridNRap*kGridNPhi + 1, 0);
+  for(unsigned int i0 = 0; i0 < iParticles.size(); i0++) {
+    double lRap = iParticles[i0].rap(), lPhi = iParticles[i0].phi();
+    if(std::abs(lRap) < 1e9 && std::abs(lPhi) < 1e9) {
+      int lPhiBin = int(std::floor(lPhi/kGridPhiSize));
+      lCells[i0] = rapBin(lRap)*kGridNPhi + ((lPhiBin % kGridNPhi) + kGridNPhi) % kGridNPhi;
+      ++fCellStart[lCells[i0] + 1];
+    } else {
+      lCells[i0] = -1;
+      fUnbinned.push_back(i0);
+    }
+  }
+  for(unsigned int i0 = 0; i0 + 1 < fCellStart.size(); i0++) fCellStart[i0 + 1] += fCellStart[i0];
+  fIndex.resize(fCellStart.back());
+  std::vector<unsigned int> lNext(fCellStart.begin(), fCellStart.end() - 1);
+  for(unsigned int i0 = 0; i0 < iParticles.size(); i0++)
+    if(lCells[i0] >= 0) fIndex[lNext[lCells[i0]]++] = i0;
+}
+
+void PuppiContainer::ParticleGrid::candidates(fastjet::PseudoJet const &iCentre, double iR, std::vector<fastjet::PseudoJet> &oParticles) {
+  oParticles.clear();
+  // a margin for the rounding of the cell boundaries
+  double lRange = iR + 1e-5*(1. + iR);
+  double lRap = iCentre.rap(), lPhi = iCentre.phi();
+  if(!(std::abs(lRap) < 1e9 && std::abs(lPhi) < 1e9 && lRange < 1e9)) {
+    oParticles = *fParticles;
+    return;
+  }
+  fCandidates.assign(fUnbinned.begin(), fUnbinned.end());
+  int lRapFirst = rapBin(lRap - lRange), lRapLast = rapBin(lRap + lRange);
+  int lPhiFirst = int(std::floor((lPhi - lRange)/kGridPhiSize));
+  int lPhiLast  = std::min(int(std::floor((lPhi + lRange)/kGridPhiSize)), lPhiFirst + kGridNPhi - 1);
+  for(int i0 = lRapFirst; i0 <= lRapLast; i0++) {
+    for(int i1 = lPhiFirst; i1 <= lPhiLast; i1++) {
+      unsigned int lCell = i0*kGridNPhi + ((i1 % kGridNPhi) + kGridNPhi) % kGridNPhi;
+      fCandidates.insert(fCandidates.end(), fIndex.begin() + fCellStart[lCell], fIndex.begin() + fCellStart[lCell + 1]);
+    }
+  }
+  std::sort(fCandidates.begin(), fCandidates.end());
+  oParticles.reserve(fCandidates.size());
+  for(unsigned int i0 = 0; i0 < fCandidates.size(); i0++) oParticles.push_back((*fParticles)[fCandidates[i0]]);
+}
+
 PuppiContainer::PuppiContainer(const edm::ParameterSet &iConfig) {
   fApplyCHS        = iConfig.getParameter<bool>("applyCHS"); 
   fUseExp          = iConfig.getParameter<bool>("useExp");
@@ -57,6 +120,8 @@ void PuppiContainer::initialize(const std::vector<RecoObj> &iRecoObjects) {
   }
   if (fPVFrac != 0) fPVFrac = double(fChargedPV.size())/fPVFrac;
   else fPVFrac = 0;
+  fPFGrid       .reset(fPFParticles);
+  fChargedPVGrid.reset(fChargedPV);
 }
 PuppiContainer::~PuppiContainer(){}
 
@@ -93,7 +158,7 @@ double PuppiContainer::var_within_R(int iId, const vector<PseudoJet> & particles
   return var;
 }
 //In fact takes the median not the average
-void PuppiContainer::getRMSAvg(int iOpt,std::vector<fastjet::PseudoJet> const &iConstits,std::vector<fastjet::PseudoJet> const &iParticles,std::vector<fastjet::PseudoJet> const &iChargedParticles) { 
+void PuppiContainer::getRMSAvg(int iOpt,std::vector<fastjet::PseudoJet> const &iConstits,ParticleGrid &iParticles,ParticleGrid &iChargedParticles) { 
   for(unsigned int i0 = 0; i0 < iConstits.size(); i0++ ) { 
     double pVal = -1;
     //Calculate the Puppi Algo to use
@@ -107,8 +172,10 @@ void PuppiContainer::getRMSAvg(int iOpt,std::vector<fastjet::PseudoJet> const &i
     bool pCharged = fPuppiAlgo[pPupId].isCharged(iOpt);
     double pCone  = fPuppiAlgo[pPupId].coneSize (iOpt);
     //Compute the Puppi Metric 
-    if(!pCharged) pVal = goodVar(iConstits[i0],iParticles       ,pAlgo,pCone);
-    if( pCharged) pVal = goodVar(iConstits[i0],iChargedParticles,pAlgo,pCone);
+    //Only the particles of the cells overlapping the cone are looked at
+    if(!pCharged) iParticles       .candidates(iConstits[i0],pCone,fNearParticles);
+    if( pCharged) iChargedParticles.candidates(iConstits[i0],pCone,fNearParticles);
+    pVal = goodVar(iConstits[i0],fNearParticles,pAlgo,pCone);
     fVals.push_back(pVal);
     //if(std::isnan(pVal) || std::isinf(pVal)) cerr << "====> Value is Nan " << pVal << " == " << iConstits[i0].pt() << " -- " << iConstits[i0].eta() << endl;
     if( ! edm::isFinite(pVal)) {
@@ -155,7 +222,7 @@ std::vector<double> const & PuppiContainer::puppiWeights() {
     //Run through all compute mean and RMS
     int lNParticles    = fRecoParticles.size();
   for(int i0 = 0; i0 < lNMaxAlgo; i0++) { 
-    getRMSAvg(i0,fPFParticles,fPFParticles,fChargedPV);
+    getRMSAvg(i0,fPFParticles,fPFGrid,fChargedPVGrid);
   }
   std::vector<double> pVals;
   for(int i0 = 0; i0 < lNParticles; i0++) {
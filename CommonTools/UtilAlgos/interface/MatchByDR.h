@@ -11,13 +11,12 @@ namespace reco {
   template <typename T1, typename T2> class MatchByDR {
   public:
     MatchByDR (const edm::ParameterSet& cfg) :
-      maxDR_(cfg.getParameter<double>("maxDeltaR")) {}
+      maxDR2_(cfg.getParameter<double>("maxDeltaR")*cfg.getParameter<double>("maxDeltaR")) {}
     bool operator() (const T1& t1, const T2& t2) const {
-      return deltaR_(t1,t2)<maxDR_;
+      return reco::deltaR2(t1,t2)<maxDR2_;
     }
   private:
-    DeltaR<T1,T2> deltaR_;
-    double maxDR_;
+    double maxDR2_;
   };
 }
 
@@ -1,14 +1,18 @@
 #include "CommonTools/Utils/interface/ExpressionEvaluator.h"
 #include "FWCore/Version/interface/GetReleaseVersion.h"
 #include "FWCore/Utilities/interface/GetEnvironmentVariable.h"
+#include "FWCore/Utilities/interface/Digest.h"
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 #include "popenCPP.h"
 
+#include <cstdio>
 #include <fstream>
 #include <regex>
+#include <sstream>
 #include <dlfcn.h>
+#include <sys/stat.h>
 
 
 #ifdef VI_DEBUG
@@ -28,6 +32,20 @@ namespace {
     return n1;
   }
 
+ // path, size and modification time of the precompiled header (or of the header if it is not
+ // precompiled), so that rebuilding it in the local area invalidates the cached libraries
+ std::string fileIdentity(std::string const & header) {
+   std::ostringstream id;
+   struct stat st;
+   for (auto const & file : { header + ".gch", header }) {
+     if (::stat(file.c_str(), &st) == 0) {
+       id << file << ' ' << st.st_size << ' ' << st.st_mtime;
+       break;
+     }
+   }
+   return id.str();
+ }
+
  void remove(std::string const & name) {
   std::string sfile = "/tmp/"+name+".cc";
   std::string ofile = "/tmp/"+name+".so";
@@ -93,17 +111,39 @@ ExpressionEvaluator::ExpressionEvaluator(const char * pkg, const char * iname, s
   COUT << cpp << std::endl;
 
 
+  // if EXPRESSION_EVALUATOR_CACHE is set to a directory, the libraries are kept there and reused by
+  // the following jobs, named after the MD5 digest of the release, of the compiler flags, of the precompiled
+  // header used and of the expression
+  std::string symbol = m_name;
+  std::string cfile;
+  auto cacheDir = edm::getEnvironmentVariable("EXPRESSION_EVALUATOR_CACHE");
+  if (!cacheDir.empty()) {
+    cms::Digest digest(edm::getReleaseVersion() + '\n' + cpp.substr(0, cpp.find(" -o ")) + '\n' + pch + '\n' + fileIdentity(incDir + pch) + '\n' +
+                       iname + '\n' + iexpr);
+    symbol = "VI_" + digest.digest().toString();
+    cfile = cacheDir + '/' + symbol + ".so";
+    void * dl = dlopen(cfile.c_str(),RTLD_LAZY);
+    if (dl) {
+      m_expr = dlsym(dl,("factory" + symbol).c_str());
+      if (m_expr) {
+        COUT << "using " << cfile << std::endl;
+        return;
+      }
+      dlclose(dl);
+    }
+  }
+
   //  prepare the file to compile
-  std::string factory = "factory" + m_name;
+  std::string factory = "factory" + symbol;
 
   std::string source = std::string("#include ")+quote+ pch +quote+"\n";
-  source+="struct "+m_name+" final : public "+iname + "{\n";
+  source+="struct "+symbol+" final : public "+iname + "{\n";
   source+=iexpr;
   source+="\n};\n";
 
 
   source += "extern " + quote+'C'+quote+' ' + std::string(iname) + "* "+factory+"() {\n";
-  source += "static "+m_name+" local;\n";
+  source += "static "+symbol+" local;\n";
   source += "return &local;\n}\n";
 
 
@@ -128,6 +168,20 @@ ExpressionEvaluator::ExpressionEvaluator(const char * pkg, const char * iname, s
   }
 
   m_expr = dlsym(dl,factory.c_str());
+
+  if (!cfile.empty()) {
+    // copy the library to the cache, renaming it at the end so that concurrent jobs never see a partial file
+    std::string tfile = cfile + '.' + m_name;
+    {
+      std::ifstream in(ofile.c_str(), std::ios::binary);
+      std::ofstream out(tfile.c_str(), std::ios::binary);
+      out << in.rdbuf();
+    }
+    if (std::rename(tfile.c_str(), cfile.c_str()) != 0) {
+      std::remove(tfile.c_str());
+      edm::LogWarning("ExpressionEvaluator") << "cannot store the compiled expression in " << cfile;
+    }
+  }
   remove(m_name);
 }
 
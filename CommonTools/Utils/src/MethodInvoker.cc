@@ -17,10 +17,12 @@ MethodInvoker(const edm::FunctionWithDict& method,
   , member_()
   , ints_(ints)
   , isFunction_(true)
+  , wrapper_(nullptr)
 {
   setArgs();
   if (isFunction_) {
     retTypeFinal_ = method_.finalReturnType();
+    wrapper_ = method_.wrapper();
   }
   //std::cout <<
   //   "Booking " <<
@@ -42,6 +44,7 @@ MethodInvoker(const edm::MemberWithDict& member)
   , member_(member)
   , ints_()
   , isFunction_(false)
+  , wrapper_(nullptr)
 {
   setArgs();
   //std::cout <<
@@ -65,6 +68,7 @@ MethodInvoker(const MethodInvoker& rhs)
   , ints_(rhs.ints_)
   , isFunction_(rhs.isFunction_)
   , retTypeFinal_(rhs.retTypeFinal_)
+  , wrapper_(rhs.wrapper_)
 {
   setArgs();
 }
@@ -79,6 +83,7 @@ operator=(const MethodInvoker& rhs)
     ints_ = rhs.ints_;
     isFunction_ = rhs.isFunction_;
     retTypeFinal_ =rhs.retTypeFinal_;
+    wrapper_ = rhs.wrapper_;
 
     setArgs();
   }
@@ -127,7 +132,13 @@ invoke(const edm::ObjectWithDict& o, edm::ObjectWithDict& retstore) const
     //  << " at " << o.address()
     //  << " with " << args_.size() << " arguments"
     //  << std::endl;
-    method_.invoke(o, &ret, args_);
+    if (wrapper_) {
+      // the same call as FunctionWithDict::invoke, without going through the interpreter
+      wrapper_(o.address(), args_.size(), const_cast<void**>(args_.data()), ret.address());
+    }
+    else {
+      method_.invoke(o, &ret, args_);
+    }
     // this is correct, it takes pointers and refs into account
     retType = retTypeFinal_; 
   }
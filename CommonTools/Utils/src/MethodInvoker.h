@@ -26,6 +26,7 @@ private: // Private Data Members
 
   bool isFunction_;
   edm::TypeWithDict retTypeFinal_;
+  edm::FunctionWithDict::Wrapper wrapper_; // resolved once, to skip the interpreter lookup at each call
 private: // Private Function Members
   void setArgs();
 public: // Public Function Members
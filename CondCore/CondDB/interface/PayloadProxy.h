@@ -4,6 +4,9 @@
 #include "CondCore/CondDB/interface/Session.h"
 #include "CondCore/CondDB/interface/Time.h"
 
+#include <list>
+#include <utility>
+
 namespace cond {
 
   namespace persistency {
@@ -55,6 +58,12 @@ namespace cond {
       const std::vector<Iov_t>& requests() const {
 	return m_requests;
       }
+
+      // number of payloads, other than the current one, kept by hash to be reused when
+      // an IOV with the same payload comes back (0: none)
+      void setPayloadCacheSize( size_t size ){
+	m_payloadCacheSize = size;
+      }
     
     private:
       virtual void loadPayload() = 0;   
@@ -65,6 +74,7 @@ namespace cond {
       Iov_t m_currentIov;
       Session m_session;
       std::vector<Iov_t> m_requests;
+      size_t m_payloadCacheSize;
       
     };
     
@@ -115,7 +125,23 @@ namespace cond {
 	if( m_currentIov.payloadId.empty() ){
 	  throwException( "Can't load payload: no valid IOV found.","PayloadProxy::loadPayload" );
 	}
-	m_data = m_session.fetchPayload<DataT>( m_currentIov.payloadId );
+	m_data.reset();
+	// the most recently used payloads are at the front
+	for( auto it = m_payloadCache.begin(); it != m_payloadCache.end(); ++it ){
+	  if( it->first == m_currentIov.payloadId ){
+	    m_data = it->second;
+	    m_payloadCache.splice( m_payloadCache.begin(), m_payloadCache, it );
+	    break;
+	  }
+	}
+	if( !m_data ){
+	  m_data = m_session.fetchPayload<DataT>( m_currentIov.payloadId );
+	  if( m_payloadCacheSize ){
+	    m_payloadCache.push_front( std::make_pair( m_currentIov.payloadId, m_data ) );
+	    // the current payload is in the cache too
+	    if( m_payloadCache.size() > m_payloadCacheSize+1 ) m_payloadCache.pop_back();
+	  }
+	}
 	m_currentPayloadId = m_currentIov.payloadId;	  
 	m_requests.push_back( m_currentIov );
       }
@@ -123,6 +149,7 @@ namespace cond {
     private:
       boost::shared_ptr<DataT> m_data;
       Hash m_currentPayloadId;
+      std::list<std::pair<Hash,boost::shared_ptr<DataT> > > m_payloadCache;
     };
     
   }
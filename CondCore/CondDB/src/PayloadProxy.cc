@@ -5,7 +5,7 @@ namespace cond {
   namespace persistency {
 
     BasePayloadProxy::BasePayloadProxy() :
-      m_iovProxy(),m_session() {
+      m_iovProxy(),m_session(),m_payloadCacheSize(0) {
     }
 
     BasePayloadProxy::~BasePayloadProxy(){}
@@ -192,6 +192,9 @@ CondDBESSource::CondDBESSource( const edm::ParameterSet& iConfig ) :
   }
 
   // now all required libraries have been loaded
+  // payloads kept by each proxy for the IOVs that come back, e.g. with several runs per job
+  const unsigned int payloadCacheSize = iConfig.getUntrackedParameter<unsigned int>( "payloadCacheSize", 0 );
+
   // init sessions and DataProxies
   ipb=0;
   for(it=itBeg;it!=itEnd;++it){
@@ -216,6 +219,7 @@ CondDBESSource::CondDBESSource( const edm::ParameterSet& iConfig ) :
     m_proxies.insert(std::make_pair(it->second.recordName(), proxy));
     // initialize
     proxy->lateInit(nsess, tag, it->second.recordLabel(), connStr);
+    proxy->proxy()->setPayloadCacheSize( payloadCacheSize );
   }
 
   // one loaded expose all other tags to the Proxy! 
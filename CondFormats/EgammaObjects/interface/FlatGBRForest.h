@@ -0,0 +1,90 @@
+#ifndef EGAMMAOBJECTS_FlatGBRForest
+#define EGAMMAOBJECTS_FlatGBRForest
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// FlatGBRForest                                                        //
+//                                                                      //
+// The trees of a GBRForest or GBRForestD in a single node array, to    //
+// evaluate the forest on a batch of objects: the trees are the outer   //
+// loop, so that the nodes of a tree stay in cache while all the        //
+// objects go through it.                                               //
+// The responses of each object are summed in the order of the trees,   //
+// as in GetResponse, so the results are identical.                     //
+//                                                                      //
+// Not persistent: build it again when the forest changes (new IOV).   //
+//////////////////////////////////////////////////////////////////////////
+
+#include "CondFormats/EgammaObjects/interface/GBRForest.h"
+#include "CondFormats/EgammaObjects/interface/GBRForestD.h"
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template<typename ForestT>
+class FlatGBRForestT {
+  public:
+    // float for GBRForest, double for GBRForestD
+    typedef typename std::decay<decltype(std::declval<ForestT>().Trees().front().Responses().front())>::type ResponseT;
+
+    FlatGBRForestT() : fInitialResponse(0) {}
+    explicit FlatGBRForestT(const ForestT &forest) : fInitialResponse(forest.InitialResponse()) {
+      for (auto const &tree : forest.Trees()) {
+        int nodeOffset = fNodes.size();
+        int responseOffset = fResponses.size();
+        fRoots.push_back(nodeOffset);
+        for (unsigned int k=0; k!=tree.CutIndices().size(); ++k) {
+          Node node;
+          node.cut = tree.CutVals()[k];
+          node.index = tree.CutIndices()[k];
+          int const c[2] = {tree.LeftIndices()[k], tree.RightIndices()[k]};
+          for (int s=0; s!=2; ++s) node.child[s] = c[s]>0 ? nodeOffset + c[s] : ~(responseOffset - c[s]);
+          fNodes.push_back(node);
+        }
+        fResponses.insert(fResponses.end(), tree.Responses().begin(), tree.Responses().end());
+      }
+    }
+
+    /// GetResponse of the n objects, whose nvars variables are contiguous in vars
+    void GetResponses(const float *vars, unsigned int nvars, unsigned int n, double *out) const {
+      for (unsigned int t=0; t!=n; ++t) out[t] = fInitialResponse;
+      for (auto root : fRoots) {
+        const float *v = vars;
+        for (unsigned int t=0; t!=n; ++t, v+=nvars) {
+          int i = root;
+          while (true) {
+            Node const &node = fNodes[i];
+            int c = node.child[v[node.index] > node.cut];
+            if (c<0) { out[t] += fResponses[~c]; break; }
+            i = c;
+          }
+        }
+      }
+    }
+
+    /// GetClassifier of the n objects
+    void GetClassifiers(const float *vars, unsigned int nvars, unsigned int n, float *out) const {
+      std::vector<double> response(n);
+      GetResponses(vars, nvars, n, response.data());
+      for (unsigned int t=0; t!=n; ++t) out[t] = 2.0/(1.0+exp(-2.0*response[t]))-1;
+    }
+
+  private:
+    struct Node {
+      float cut;
+      int index;
+      int child[2];   // left, right; a terminal node l is stored as ~l
+    };
+
+    double fInitialResponse;
+    std::vector<int> fRoots;
+    std::vector<Node> fNodes;
+    std::vector<ResponseT> fResponses;
+};
+
+typedef FlatGBRForestT<GBRForest> FlatGBRForest;
+typedef FlatGBRForestT<GBRForestD> FlatGBRForestD;
+
+#endif
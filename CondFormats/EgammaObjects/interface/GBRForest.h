@@ -38,6 +38,7 @@
        double GetResponse(const float* vector) const;
        double GetClassifier(const float* vector) const;
        
+       double InitialResponse() const { return fInitialResponse; }
        void SetInitialResponse(double response) { fInitialResponse = response; }
        
        std::vector<GBRTree> &Trees() { return fTrees; }
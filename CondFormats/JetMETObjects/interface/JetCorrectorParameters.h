@@ -64,7 +64,7 @@ class JetCorrectorParameters
         float xMax(unsigned fVar)           const {return mMax[fVar];                 }
         float xMiddle(unsigned fVar)        const {return 0.5*(xMin(fVar)+xMax(fVar));}
         float parameter(unsigned fIndex)    const {return mParameters[fIndex];        }
-        std::vector<float> parameters()     const {return mParameters;                }
+        const std::vector<float>& parameters() const {return mParameters;          }
         unsigned nParameters()              const {return mParameters.size();         }
         int operator< (const Record& other) const {return xMin(0) < other.xMin(0);    }
       private:
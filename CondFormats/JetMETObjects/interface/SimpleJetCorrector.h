@@ -29,15 +29,20 @@ class SimpleJetCorrector
   //-------- Member functions -----------
   SimpleJetCorrector(const SimpleJetCorrector&);
   SimpleJetCorrector& operator= (const SimpleJetCorrector&);
-  float    invert(const std::vector<float>& fX, TFormula&) const;
+  float    invert(const float* fX, unsigned N, const double* fPar) const;
   float    correctionBin(unsigned fBin,const std::vector<float>& fY) const;
+  int      binIndex(const std::vector<float>& fX) const;
   unsigned findInvertVar();
+  void     findSortedBins();
   void     setFuncParameters();
   //-------- Member variables -----------
   JetCorrectorParameters  mParameters;
   TFormula                mFunc;
   unsigned                mInvertVar; 
   bool                    mDoInterpolation;
+  // lower edges of the bins, if there is one bin variable and the bins are
+  // ordered and do not overlap: the bin is then found by a binary search
+  std::vector<float>      mBinXMin;
 };
 
 #endif
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
 
 //------------------------------------------------------------------------
 //--- Default SimpleJetCorrector constructor -----------------------------
@@ -24,6 +25,7 @@ SimpleJetCorrector::SimpleJetCorrector(const std::string& fDataFile, const std::
   mDoInterpolation = false;
   if (mParameters.definitions().isResponse())
     mInvertVar = findInvertVar();
+  findSortedBins();
 }
 //------------------------------------------------------------------------
 //--- SimpleJetCorrector constructor -------------------------------------
@@ -36,6 +38,7 @@ SimpleJetCorrector::SimpleJetCorrector(const JetCorrectorParameters& fParameters
   mDoInterpolation = false;
   if (mParameters.definitions().isResponse())
     mInvertVar = findInvertVar();
+  findSortedBins();
 }
 //------------------------------------------------------------------------
 //--- SimpleJetCorrector destructor --------------------------------------
@@ -52,7 +55,7 @@ float SimpleJetCorrector::correction(const std::vector<float>& fX,const std::vec
   float result = 1.;
   float tmp    = 0.0;
   float cor    = 0.0;
-  int bin = mParameters.binIndex(fX);
+  int bin = binIndex(fX);
   if (bin<0)
     return result;
   if (!mDoInterpolation)
@@ -105,27 +108,65 @@ float SimpleJetCorrector::correctionBin(unsigned fBin,const std::vector<float>&
       handleError("SimpleJetCorrector",sserr.str());
     }
   float result = -1;
-  //Have to do calculation using a temporary TFormula to avoid
-  // thread safety issues
-  TFormula tFunc(mFunc);
-
+  // The formula is evaluated with the parameters of the bin passed to
+  // EvalPar, rather than set in a copy of mFunc, to be thread safe
   const std::vector<float>& par = mParameters.record(fBin).parameters();
-  for(unsigned int i=2*N;i<par.size();i++)
-    tFunc.SetParameter(i-2*N,par[i]);
-  float x[4] = {};
-  std::vector<float> tmp;
-  for(unsigned i=0;i<N;i++)
+  unsigned nPar = par.size() > 2*N ? par.size()-2*N : 0;
+  unsigned nParFunc = std::max<int>(mFunc.GetNpar(),nPar);
+  double parBuffer[32];
+  std::vector<double> parVector;
+  double* p = parBuffer;
+  if (nParFunc > 32)
     {
-      x[i] = (fY[i] < par[2*i]) ? par[2*i] : (fY[i] > par[2*i+1]) ? par[2*i+1] : fY[i];
-      tmp.push_back(x[i]);
+      parVector.resize(nParFunc);
+      p = &parVector[0];
     }
+  for(unsigned i=0;i<nParFunc;i++)
+    p[i] = (i < nPar) ? par[i+2*N] : 0.;
+  float x[4] = {};
+  for(unsigned i=0;i<N;i++)
+    x[i] = (fY[i] < par[2*i]) ? par[2*i] : (fY[i] > par[2*i+1]) ? par[2*i+1] : fY[i];
   if (mParameters.definitions().isResponse())
-    result = invert(tmp,tFunc);
+    result = invert(x,N,p);
   else
-    result = tFunc.Eval(x[0],x[1],x[2],x[3]);
+    {
+      double xx[4] = {x[0],x[1],x[2],x[3]};
+      result = mFunc.EvalPar(xx,p);
+    }
   return result;
 }
 //------------------------------------------------------------------------
+//--- returns the bin of fX: binary search if the bins allow it ----------
+//------------------------------------------------------------------------
+int SimpleJetCorrector::binIndex(const std::vector<float>& fX) const
+{
+  if (mBinXMin.empty() || fX.size() != 1)
+    return mParameters.binIndex(fX);
+  int i = int(std::upper_bound(mBinXMin.begin(),mBinXMin.end(),fX[0]) - mBinXMin.begin()) - 1;
+  if (i >= 0 && fX[0] >= mParameters.record(i).xMin(0) && fX[0] < mParameters.record(i).xMax(0))
+    return i;
+  return -1;
+}
+//------------------------------------------------------------------------
+//--- fills mBinXMin if the bins are ordered and do not overlap ----------
+//------------------------------------------------------------------------
+void SimpleJetCorrector::findSortedBins()
+{
+  mBinXMin.clear();
+  if (mParameters.definitions().nBinVar() != 1)
+    return;
+  for(unsigned i=0;i<mParameters.size();i++)
+    {
+      const JetCorrectorParameters::Record& r = mParameters.record(i);
+      if (i > 0 && !(r.xMin(0) >= mParameters.record(i-1).xMax(0)))
+        {
+          mBinXMin.clear();
+          return;
+        }
+      mBinXMin.push_back(r.xMin(0));
+    }
+}
+//------------------------------------------------------------------------
 //--- find invertion variable (JetPt) ------------------------------------
 //------------------------------------------------------------------------
 unsigned SimpleJetCorrector::findInvertVar()
@@ -145,10 +186,9 @@ unsigned SimpleJetCorrector::findInvertVar()
 //------------------------------------------------------------------------
 //--- inversion ----------------------------------------------------------
 //------------------------------------------------------------------------
-float SimpleJetCorrector::invert(const std::vector<float>& fX, TFormula& tFunc) const
+float SimpleJetCorrector::invert(const float* fX, unsigned N, const double* fPar) const
 {
   unsigned nMax = 50;
-  unsigned N = fX.size();
   float precision = 0.0001;
   float rsp = 1.0;
   float e = 1.0;
@@ -158,7 +198,8 @@ float SimpleJetCorrector::invert(const std::vector<float>& fX, TFormula& tFunc)
   unsigned nLoop=0;
   while(e > precision && nLoop < nMax)
     {
-      rsp = tFunc.Eval(x[0],x[1],x[2],x[3]);
+      double xx[4] = {x[0],x[1],x[2],x[3]};
+      rsp = mFunc.EvalPar(xx,fPar);
       float tmp = x[mInvertVar] * rsp;
       e = fabs(tmp - fX[mInvertVar])/fX[mInvertVar];
       x[mInvertVar] = fX[mInvertVar]/rsp;
@@ -166,11 +207,3 @@ float SimpleJetCorrector::invert(const std::vector<float>& fX, TFormula& tFunc)
     }
   return 1./rsp;
 }
-
-
-
-
-
-
-
-
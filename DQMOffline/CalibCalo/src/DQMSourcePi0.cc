@@ -148,6 +148,9 @@ void DQMSourcePi0::bookHistograms(DQMStore::IBooker & ibooker, edm::Run const &
   // create and cd into new folder
   ibooker.setCurrentFolder(folderName_);
 
+  // all the histograms are filled for the sampled events only
+  bookSamplingPrescale(ibooker, "samplingPrescale", prescaleFactor_);
+
   // book some histograms 1D
 
   hiPhiDistrEBpi0_ = ibooker.book1D("iphiDistributionEBpi0", "RechitEB pi0 iphi", 361, 1,361);
@@ -343,7 +346,7 @@ void DQMSourcePi0::beginLuminosityBlock(const LuminosityBlock& lumiSeg,
 void DQMSourcePi0::analyze(const Event& iEvent, 
 			       const EventSetup& iSetup ){  
  
-  if (eventCounter_% prescaleFactor_ ) return; 
+  if (!sampleEvent(iEvent.id(), prescaleFactor_)) return;
   eventCounter_++;
 
   edm::ESHandle<CaloTopology> theCaloTopology;
@@ -9,6 +9,7 @@
 #include "DQMServices/Components/src/DQMStoreStats.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/MessageLogger/interface/JobReport.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 using namespace std;
 using namespace edm;
@@ -71,6 +72,7 @@ DQMStoreStats::DQMStoreStats( const edm::ParameterSet& ps )
   runonendlumi_   = ps.getUntrackedParameter<bool>( "runOnEndLumi", false );
   runineventloop_ = ps.getUntrackedParameter<bool>( "runInEventLoop", false );
   dumpToFWJR_     = ps.getUntrackedParameter<bool>( "dumpToFWJR", false );
+  memoryBudgetMB_ = ps.getUntrackedParameter<double>( "memoryBudgetMB", 0. );
 
   startingTime_ = time( 0 );
 }
@@ -432,6 +434,24 @@ int DQMStoreStats::calcstats( int mode = DQMStoreStats::considerAllME ) {
   std::cout << "Total number of histograms: " << overallNHistograms << " with: " << overallNBins << " bins alltogether" << std::endl;
   std::cout << "Total memory occupied by histograms (excl. overhead): " << overallNBytes / 1024. / 1000. << " MB" << std::endl;
 
+  // warn when the histograms exceed the configured budget, with the largest subsystem
+  if( memoryBudgetMB_ > 0. && mode == DQMStoreStats::considerAllME && overallNBytes / 1024. / 1024. > memoryBudgetMB_ ) {
+    std::string largestName;
+    unsigned int largestNBytes = 0;
+    for( DQMStoreStatsTopLevel::const_iterator it0 = dqmStoreStatsTopLevel.begin(); it0 < dqmStoreStatsTopLevel.end(); ++it0 ) {
+      unsigned int nBytes = 0;
+      for( DQMStoreStatsSubsystem::const_iterator it1 = it0->begin(); it1 < it0->end(); ++it1 ) nBytes += it1->totalMemory_;
+      if( nBytes > largestNBytes ) {
+        largestNBytes = nBytes;
+        largestName = it0->subsystemName_;
+      }
+    }
+    edm::LogWarning("DQMStoreStats")
+      << "The histograms occupy " << overallNBytes / 1024. / 1024. << " MB, more than the budget of "
+      << memoryBudgetMB_ << " MB; the largest subsystem is " << largestName
+      << " with " << largestNBytes / 1024. / 1024. << " MB";
+  }
+
 
 
   std::cout << endl;
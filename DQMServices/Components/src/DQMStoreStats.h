@@ -357,6 +357,7 @@ private:
   bool runineventloop_ ;
   bool dumpMemHistory_;
   bool dumpToFWJR_;
+  double memoryBudgetMB_;
 
   // ---------- member data ----------
 
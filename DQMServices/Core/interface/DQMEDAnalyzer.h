@@ -12,7 +12,7 @@
 //<<<<<< PUBLIC FUNCTIONS                                               >>>>>>
 //<<<<<< CLASS DECLARATIONS                                             >>>>>>
 
-namespace edm {class StreamID;}
+namespace edm {class StreamID; class EventID;}
 
 namespace dqmDetails {struct NoCache {};}
 
@@ -52,6 +52,20 @@ public:
   virtual void dqmBeginRun(edm::Run const&, edm::EventSetup const&) {}
   virtual void bookHistograms(DQMStore::IBooker &i, edm::Run const&, edm::EventSetup const&) = 0;
 
+protected:
+  /// for the MEs which only need a fraction of the events: true for one
+  /// event in @a prescale, chosen by event number, so that the same events
+  /// are sampled whatever the stream or job; always true if @a prescale <= 1.
+  /// Modules skip the computation of the quantities of these MEs for the
+  /// other events, and scale the contents by @a prescale when needed.
+  static bool sampleEvent(edm::EventID const& id, unsigned int prescale);
+
+  /// books in the current folder the int ME @a name holding the @a prescale
+  /// of a group of MEs filled with sampleEvent, so that it is kept with them
+  static MonitorElement * bookSamplingPrescale(DQMStore::IBooker &ibooker,
+                                               std::string const& name,
+                                               unsigned int prescale);
+
 private:
   uint32_t stream_id_;
 };
@@ -691,6 +691,8 @@ class DQMStore
   typedef std::map<std::string, QCriterion *>                           QCMap;
   typedef std::map<std::string, QCriterion *(*)(const std::string &)>   QAMap;
 
+  MEMap::const_iterator         skipSubdirs(const std::string &dir, MEMap::const_iterator i) const;
+
   unsigned                      verbose_;
   unsigned                      verboseQT_;
   bool                          reset_;
@@ -5,6 +5,7 @@
 #include "FWCore/Framework/interface/LuminosityBlock.h"
 #include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
 #include "FWCore/Utilities/interface/StreamID.h"
+#include "DataFormats/Provenance/interface/EventID.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 DQMEDAnalyzer::DQMEDAnalyzer() {}
@@ -14,6 +15,20 @@ void DQMEDAnalyzer::beginStream(edm::StreamID id)
   stream_id_ = id.value();
 }
 
+bool DQMEDAnalyzer::sampleEvent(edm::EventID const& id, unsigned int prescale)
+{
+  return prescale <= 1 || id.event() % prescale == 0;
+}
+
+MonitorElement * DQMEDAnalyzer::bookSamplingPrescale(DQMStore::IBooker &ibooker,
+                                                     std::string const& name,
+                                                     unsigned int prescale)
+{
+  MonitorElement * me = ibooker.bookInt(name);
+  me->Fill(prescale <= 1 ? 1U : prescale);
+  return me;
+}
+
 void DQMEDAnalyzer::beginRun(edm::Run const &iRun,
                              edm::EventSetup const &iSetup) {
   dqmBeginRun(iRun, iSetup);
@@ -369,8 +369,10 @@ void DQMStore::mergeAndResetMEsRunSummaryCache(uint32_t run,
       continue;
     }
 
-    MonitorElement global_me(*i);
-    global_me.globalize();
+    // Only the key of the global object, so that the histogram is
+    // only cloned if the global object does not exist yet.
+    MonitorElement global_me(i->data_.dirname, i->data_.objname, run);
+    global_me.setLumi(i->data_.lumi);
     // Since this accesses the data, the operation must be
     // be locked.
     std::lock_guard<std::mutex> guard(book_mutex_);
@@ -386,8 +388,10 @@ void DQMStore::mergeAndResetMEsRunSummaryCache(uint32_t run,
     } else {
       if (verbose_ > 1)
         std::cout << "No global Object found. " << std::endl;
+      MonitorElement new_me(*i);
+      new_me.globalize();
       std::pair<std::set<MonitorElement>::const_iterator, bool> gme;
-      gme = data_.insert(global_me);
+      gme = data_.insert(new_me);
       assert(gme.second);
     }
     // TODO(rovere): eventually reset the local object and mark it as reusable??
@@ -421,8 +425,8 @@ void DQMStore::mergeAndResetMEsLuminositySummaryCache(uint32_t run,
       continue;
     }
 
-    MonitorElement global_me(*i);
-    global_me.globalize();
+    // Only the key of the global object, as for the runs.
+    MonitorElement global_me(i->data_.dirname, i->data_.objname, run);
     global_me.setLumi(lumi);
     // Since this accesses the data, the operation must be
     // be locked.
@@ -438,8 +442,11 @@ void DQMStore::mergeAndResetMEsLuminositySummaryCache(uint32_t run,
     } else {
       if (verbose_ > 1)
         std::cout << "No global Object found. " << std::endl;
+      MonitorElement new_me(*i);
+      new_me.globalize();
+      new_me.setLumi(lumi);
       std::pair<std::set<MonitorElement>::const_iterator, bool> gme;
-      gme = data_.insert(global_me);
+      gme = data_.insert(new_me);
       assert(gme.second);
     }
     // make the ME reusable for the next LS
@@ -1706,9 +1713,11 @@ DQMStore::getMEs(void) const
   std::vector<std::string> result;
   MEMap::const_iterator e = data_.end();
   MEMap::const_iterator i = data_.lower_bound(proto);
-  for ( ; i != e && isSubdirectory(pwd_, *i->data_.dirname); ++i)
+  while (i != e && isSubdirectory(pwd_, *i->data_.dirname))
     if (pwd_ == *i->data_.dirname)
-      result.push_back(i->getName());
+      result.push_back((i++)->getName());
+    else
+      i = skipSubdirs(pwd_, i);
 
   return result;
 }
@@ -1737,6 +1746,21 @@ DQMStore::get(const std::string &path) const
           : const_cast<MonitorElement *>(&*mepos));
 }
 
+/// skip from @a i, an ME in a subdirectory of @a dir, to the first ME
+/// after the subdirectories of @a dir with the same run, lumi, stream
+/// and module: in the ordering of the store these all have a directory
+/// name between dir + "/" and dir + "0".
+DQMStore::MEMap::const_iterator
+DQMStore::skipSubdirs(const std::string &dir, MEMap::const_iterator i) const
+{
+  if (dir.empty())
+    return ++i;
+  std::string next(dir + '0');
+  MonitorElement proto(&next, std::string(), i->data_.run, i->data_.streamId, i->data_.moduleId);
+  proto.setLumi(i->data_.lumi);
+  return data_.lower_bound(proto);
+}
+
 /// get all MonitorElements tagged as <tag>
 std::vector<MonitorElement *>
 DQMStore::get(unsigned int tag) const
@@ -1765,9 +1789,11 @@ DQMStore::getContents(const std::string &path) const
   std::vector<MonitorElement *> result;
   MEMap::const_iterator e = data_.end();
   MEMap::const_iterator i = data_.lower_bound(proto);
-  for ( ; i != e && isSubdirectory(*cleaned, *i->data_.dirname); ++i)
+  while (i != e && isSubdirectory(*cleaned, *i->data_.dirname))
     if (*cleaned == *i->data_.dirname)
-      result.push_back(const_cast<MonitorElement *>(&*i));
+      result.push_back(const_cast<MonitorElement *>(&*i++));
+    else
+      i = skipSubdirs(*cleaned, i);
 
   return result;
 }
@@ -1784,11 +1810,18 @@ DQMStore::getContents(const std::string &path, unsigned int tag) const
   std::vector<MonitorElement *> result;
   MEMap::const_iterator e = data_.end();
   MEMap::const_iterator i = data_.lower_bound(proto);
-  for ( ; i != e && isSubdirectory(*cleaned, *i->data_.dirname); ++i)
-    if (*cleaned == *i->data_.dirname
-        && (i->data_.flags & DQMNet::DQM_PROP_TAGGED)
+  while (i != e && isSubdirectory(*cleaned, *i->data_.dirname))
+  {
+    if (*cleaned != *i->data_.dirname)
+    {
+      i = skipSubdirs(*cleaned, i);
+      continue;
+    }
+    if ((i->data_.flags & DQMNet::DQM_PROP_TAGGED)
         && i->data_.tag == tag)
       result.push_back(const_cast<MonitorElement *>(&*i));
+    ++i;
+  }
 
   return result;
 }
@@ -1813,12 +1846,15 @@ DQMStore::getContents(std::vector<std::string> &into, bool showContents /* = tru
     MEMap::const_iterator m = mi;
     size_t sz = di->size() + 2;
     size_t nfound = 0;
-    for ( ; m != me && isSubdirectory(*di, *m->data_.dirname); ++m)
+    while (m != me && isSubdirectory(*di, *m->data_.dirname))
       if (*di == *m->data_.dirname)
       {
         sz += m->data_.objname.size() + 1;
         ++nfound;
+        ++m;
       }
+      else
+        m = skipSubdirs(*di, m);
 
     if (! nfound)
       continue;
@@ -1903,13 +1939,21 @@ DQMStore::getAllTags(std::vector<std::string> &into) const
     MEMap::const_iterator m = mi;
     size_t sz = di->size() + 2;
     size_t nfound = 0;
-    for ( ; m != me && isSubdirectory(*di, *m->data_.dirname); ++m)
-      if (*di == *m->data_.dirname && (m->data_.flags & DQMNet::DQM_PROP_TAGGED))
+    while (m != me && isSubdirectory(*di, *m->data_.dirname))
+    {
+      if (*di != *m->data_.dirname)
+      {
+        m = skipSubdirs(*di, m);
+        continue;
+      }
+      if (m->data_.flags & DQMNet::DQM_PROP_TAGGED)
       {
         // the tags count for '/' + up to 10 digits, otherwise ',' + ME name
         sz += 1 + m->data_.objname.size() + 11;
         ++nfound;
       }
+      ++m;
+    }
 
     if (! nfound)
       continue;
@@ -2446,7 +2490,7 @@ void DQMStore::savePB(const std::string &filename,
   using google::protobuf::io::StringOutputStream;
 
   std::set<std::string>::iterator di, de;
-  MEMap::iterator mi, me = data_.end();
+  MEMap::const_iterator mi, me = data_.end();
   dqmstorepb::ROOTFilePB dqmstore_message;
   int nme = 0;
 
@@ -2483,9 +2527,12 @@ void DQMStore::savePB(const std::string &filename,
       if (enableMultiThread_ && ((*mi).lumi() != lumi))
 	break;
 
-      // Skip if it isn't a direct child.
-      if (*di != *mi->data_.dirname)
+      // Skip if it isn't a direct child, with all the MEs of the
+      // subdirectories.
+      if (*di != *mi->data_.dirname) {
+        mi = std::prev(skipSubdirs(*di, mi));
         continue;
+      }
 
       // Keep backward compatibility with the old way of
       // booking/handlind MonitorElements into the DQMStore. If run is
@@ -2575,7 +2622,7 @@ DQMStore::save(const std::string &filename,
 	       const bool resetMEsAfterWriting /* = false */)
 {
   std::set<std::string>::iterator di, de;
-  MEMap::iterator mi, me = data_.end();
+  MEMap::const_iterator mi, me = data_.end();
   DQMNet::QReports::const_iterator qi, qe;
   int nme=0;
 
@@ -2646,10 +2693,12 @@ DQMStore::save(const std::string &filename,
       if (enableMultiThread_ && ((*mi).lumi() != lumi))
         break;
 
-      // Skip if it isn't a direct child.
+      // Skip if it isn't a direct child, with all the MEs of the
+      // subdirectories.
       if (*di != *mi->data_.dirname) {
 	if (verbose_ > 1)
 	  std::cout << "DQMStore::save: isn't a direct child. Skipping" << std::endl;
+        mi = std::prev(skipSubdirs(*di, mi));
         continue;
       }
       
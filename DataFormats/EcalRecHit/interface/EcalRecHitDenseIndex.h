@@ -0,0 +1,70 @@
+#ifndef DataFormats_EcalRecHit_EcalRecHitDenseIndex_h
+#define DataFormats_EcalRecHit_EcalRecHitDenseIndex_h
+
+/** \class EcalRecHitDenseIndex
+ *
+ * Index of the barrel and endcap rechits of an EcalRecHitCollection by the
+ * hashed index of their crystal, for a find() in constant time instead of
+ * the binary search of the collection. find() returns an iterator of the
+ * collection, so it can replace EcalRecHitCollection::find() as is; other
+ * ids, e.g. of the preshower, are searched in the collection.
+ *
+ * The collection must not change while the index is used; an index can be
+ * kept and reset() for each event, to reuse its memory.
+ */
+
+#include "DataFormats/EcalRecHit/interface/EcalRecHitCollections.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+
+#include <vector>
+
+class EcalRecHitDenseIndex {
+ public:
+  typedef EcalRecHitCollection::const_iterator const_iterator;
+
+  EcalRecHitDenseIndex() : hits_(0) {}
+  explicit EcalRecHitDenseIndex(const EcalRecHitCollection& hits) : hits_(0) { reset(hits); }
+
+  /// index the rechits of a collection; the index of a subdetector is
+  /// only filled if the collection has rechits of it
+  void reset(const EcalRecHitCollection& hits) {
+    hits_ = &hits;
+    ebIndex_.clear();
+    eeIndex_.clear();
+    for (unsigned int i = 0; i < hits.size(); ++i) {
+      const DetId id = hits[i].id();
+      if (id.det() != DetId::Ecal) continue;
+      if (id.subdetId() == EcalBarrel) set(ebIndex_, EBDetId::kSizeForDenseIndexing, EBDetId(id).hashedIndex(), i);
+      else if (id.subdetId() == EcalEndcap) set(eeIndex_, EEDetId::kSizeForDenseIndexing, EEDetId(id).hashedIndex(), i);
+    }
+  }
+
+  const_iterator find(DetId id) const {
+    if (id.det() == DetId::Ecal) {
+      if (id.subdetId() == EcalBarrel) return get(ebIndex_, EBDetId(id).hashedIndex());
+      if (id.subdetId() == EcalEndcap) return get(eeIndex_, EEDetId(id).hashedIndex());
+    }
+    return hits_->find(id);
+  }
+  const_iterator end() const { return hits_->end(); }
+
+  const EcalRecHitCollection& collection() const { return *hits_; }
+
+ private:
+  static void set(std::vector<int>& index, unsigned int size, int hash, unsigned int i) {
+    if (index.empty()) index.assign(size, -1);
+    // keep the first one, as EcalRecHitCollection::find()
+    if (index[hash] < 0) index[hash] = i;
+  }
+  const_iterator get(const std::vector<int>& index, int hash) const {
+    int i = index.empty() ? -1 : index[hash];
+    return i < 0 ? hits_->end() : hits_->begin() + i;
+  }
+
+  const EcalRecHitCollection* hits_;
+  std::vector<int> ebIndex_;
+  std::vector<int> eeIndex_;
+};
+
+#endif
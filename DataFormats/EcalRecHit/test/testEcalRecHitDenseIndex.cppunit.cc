@@ -0,0 +1,45 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include "DataFormats/EcalRecHit/interface/EcalRecHitDenseIndex.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/EcalDetId/interface/ESDetId.h"
+
+class testEcalRecHitDenseIndex: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(testEcalRecHitDenseIndex);
+  CPPUNIT_TEST(testFind);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp(){}
+  void tearDown(){}
+
+  void testFind();
+
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(testEcalRecHitDenseIndex);
+
+void testEcalRecHitDenseIndex::testFind() {
+  EcalRecHitCollection hits;
+  hits.push_back(EcalRecHit(EBDetId(1,1),1.,0.));
+  hits.push_back(EcalRecHit(EBDetId(-85,360),2.,0.));
+  hits.push_back(EcalRecHit(EEDetId(20,50,1),3.,0.));
+  hits.push_back(EcalRecHit(ESDetId(1,1,1,1,1),4.,0.));
+  hits.sort();
+
+  EcalRecHitDenseIndex index(hits);
+  const DetId ids[] = { EBDetId(1,1), EBDetId(-85,360), EBDetId(2,1), EEDetId(20,50,1), EEDetId(20,50,-1),
+                        ESDetId(1,1,1,1,1), ESDetId(2,1,1,1,1) };
+  for (unsigned int i = 0; i < sizeof(ids)/sizeof(ids[0]); ++i)
+    CPPUNIT_ASSERT(index.find(ids[i]) == hits.find(ids[i]));
+  CPPUNIT_ASSERT(index.find(EEDetId(20,50,1))->energy() == 3.f);
+
+  // an index is only filled for the subdetectors of the collection
+  EcalRecHitCollection ebHits;
+  ebHits.push_back(EcalRecHit(EBDetId(1,1),1.,0.));
+  index.reset(ebHits);
+  CPPUNIT_ASSERT(index.find(EBDetId(1,1)) == ebHits.begin());
+  CPPUNIT_ASSERT(index.find(EEDetId(20,50,1)) == ebHits.end());
+}
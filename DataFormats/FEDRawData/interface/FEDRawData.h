@@ -7,6 +7,9 @@
  *  The raw data is owned as a binary buffer. It is required that the 
  *  lenght of the data is a multiple of the S-Link64 word lenght (8 byte).
  *  The FED data should include the standard FED header and trailer.
+ *  The data can also reference an external buffer (e.g. the input
+ *  buffer of the DAQ source) which is kept alive by a shared holder;
+ *  such data are copied into the owned buffer only if they are modified.
  *
  *  \author G. Bruno - CERN, EP Division
  *  \author S. Argiro - CERN and INFN - 
@@ -15,6 +18,7 @@
 
 
 #include <vector>
+#include <memory>
 #include <cstddef>
 
 class FEDRawData {
@@ -31,6 +35,12 @@ class FEDRawData {
   /// word (8 bytes)
   FEDRawData(size_t newsize);
 
+  /// Ctor referencing size bytes at data without copying them. The
+  /// buffer must stay valid as long as holder (or a copy of it) is alive.
+  /// It is required that the size is a multiple of the size of a FED
+  /// word (8 bytes)
+  FEDRawData(const unsigned char * data, size_t size, std::shared_ptr<const void> holder);
+
   /// Copy constructor
   FEDRawData(const FEDRawData &);
 
@@ -40,11 +50,15 @@ class FEDRawData {
   /// Return a const pointer to the beginning of the data buffer
   const unsigned char * data() const;
 
-  /// Return a pointer to the beginning of the data buffer
+  /// Return a pointer to the beginning of the data buffer.
+  /// Referenced external data are copied into the owned buffer first.
   unsigned char * data();
 
   /// Lenght of the data buffer in bytes
-  size_t size() const {return data_.size();}
+  size_t size() const {return externalData_ ? externalSize_ : data_.size();}
+
+  /// True if the data reference an external buffer
+  bool isExternal() const {return externalData_ != nullptr;}
     
   /// Resize to the specified size in bytes. It is required that 
   /// the size is a multiple of the size of a FED word (8 bytes)
@@ -52,9 +66,15 @@ class FEDRawData {
 
  private:
 
+  void copyExternalData();
 
   Data data_;
 
+  // transient reference to an external buffer
+  const unsigned char * externalData_ = nullptr;
+  size_t externalSize_ = 0;
+  std::shared_ptr<const void> externalHolder_;
+
 };
 
 #endif
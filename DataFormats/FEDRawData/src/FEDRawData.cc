@@ -19,20 +19,39 @@ FEDRawData::FEDRawData(size_t newsize):data_(newsize){
   if (newsize%8!=0) throw cms::Exception("DataCorrupt") << "FEDRawData::resize: " << newsize << " is not a multiple of 8 bytes." << endl;
 }
 
-FEDRawData::FEDRawData(const FEDRawData &in) : data_(in.data_)
+FEDRawData::FEDRawData(const unsigned char * data, size_t size, std::shared_ptr<const void> holder):
+  externalData_(data), externalSize_(size), externalHolder_(std::move(holder)) {
+  if (size%8!=0) throw cms::Exception("DataCorrupt") << "FEDRawData::FEDRawData: " << size << " is not a multiple of 8 bytes." << endl;
+}
+
+FEDRawData::FEDRawData(const FEDRawData &in) : data_(in.data_),
+  externalData_(in.externalData_), externalSize_(in.externalSize_), externalHolder_(in.externalHolder_)
 {
 }
 FEDRawData::~FEDRawData()
 {
 }
-const unsigned char * FEDRawData::data()const {return &data_[0];}
+const unsigned char * FEDRawData::data()const {return externalData_ ? externalData_ : &data_[0];}
 
-unsigned char * FEDRawData::data() {return &data_[0];}
+unsigned char * FEDRawData::data() {
+  copyExternalData();
+  return &data_[0];
+}
 
 void FEDRawData::resize(size_t newsize) {
   if (size()==newsize) return;
 
+  copyExternalData();
+
   data_.resize(newsize);
 
   if (newsize%8!=0) throw cms::Exception("DataCorrupt") << "FEDRawData::resize: " << newsize << " is not a multiple of 8 bytes." << endl;
 }
+
+void FEDRawData::copyExternalData() {
+  if (!externalData_) return;
+  data_.assign(externalData_, externalData_ + externalSize_);
+  externalData_ = nullptr;
+  externalSize_ = 0;
+  externalHolder_.reset();
+}
@@ -9,7 +9,10 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <DataFormats/FEDRawData/interface/FEDRawData.h>
 
+#include <FWCore/Utilities/interface/Exception.h>
+
 #include <iostream>
+#include <memory>
 
 class testFEDRawData: public CppUnit::TestFixture {
 
@@ -17,6 +20,7 @@ class testFEDRawData: public CppUnit::TestFixture {
 
   CPPUNIT_TEST(testCtor);
   CPPUNIT_TEST(testdata);
+  CPPUNIT_TEST(testExternal);
  
   CPPUNIT_TEST_SUITE_END();
 
@@ -27,6 +31,7 @@ public:
   void tearDown(){}  
   void testCtor();
   void testdata(); 
+  void testExternal();
  
 }; 
 
@@ -56,5 +61,35 @@ void testFEDRawData::testdata(){
   CPPUNIT_ASSERT(buf[47] == 'c');
 }
 
+void testFEDRawData::testExternal(){
+  std::shared_ptr<unsigned char> buffer(new unsigned char[16], [](unsigned char* p) {delete [] p;});
+  buffer.get()[0]='a';
+  buffer.get()[15]='b';
+  std::weak_ptr<unsigned char> watch(buffer);
+
+  FEDRawData f(buffer.get(), 16, buffer);
+  buffer.reset();
+  CPPUNIT_ASSERT(f.isExternal());
+  CPPUNIT_ASSERT(f.size()==size_t(16));
+
+  const FEDRawData& cf = f;
+  CPPUNIT_ASSERT(cf.data()[0] == 'a');
+  CPPUNIT_ASSERT(cf.data()[15] == 'b');
+
+  FEDRawData copy(f);
+  CPPUNIT_ASSERT(copy.isExternal());
+  copy.data()[0]='c';
+  CPPUNIT_ASSERT(!copy.isExternal());
+  CPPUNIT_ASSERT(cf.data()[0] == 'a');
+  CPPUNIT_ASSERT(copy.size()==size_t(16));
+  CPPUNIT_ASSERT(copy.data()[15] == 'b');
+
+  f.resize(24);
+  CPPUNIT_ASSERT(!f.isExternal());
+  CPPUNIT_ASSERT(f.data()[0] == 'a');
+  CPPUNIT_ASSERT(watch.expired());
+
+  CPPUNIT_ASSERT_THROW(FEDRawData(cf.data(), 12, std::shared_ptr<const void>()), cms::Exception);
+}
 
 #include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
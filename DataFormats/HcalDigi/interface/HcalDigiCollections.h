@@ -43,6 +43,10 @@ public:
   int size() const { return int(edm::DataFrameContainer::size()); }
   Digi operator[](size_type i) const { return Digi(edm::DataFrameContainer::operator[](i));}
   void addDataFrame(DetId detid, const uint16_t* data) { push_back(detid.rawId(),data); }
+  /// add the digis of another collection with the same number of samples
+  void append(const HcalDataFrameContainer& other) {
+    for (size_type i=0; i<other.edm::DataFrameContainer::size(); ++i) push_back(other.id(i),other.frame(i));
+  }
   int samples() const { return int((stride()-Digi::HEADER_WORDS)/Digi::WORDS_PER_SAMPLE); }
   void sort() { edm::DataFrameContainer::sort(); }
 };
@@ -0,0 +1,117 @@
+#ifndef DataFormats_ParticleFlowCandidate_PFCandidateEtaPhiIndex_h
+#define DataFormats_ParticleFlowCandidate_PFCandidateEtaPhiIndex_h
+
+/** \class PFCandidateEtaPhiIndex
+ *
+ * Index of PF candidates in bins of eta and phi, so that the isolation cones
+ * of all the objects of an event only loop over the candidates of the bins
+ * they overlap instead of over the whole collection. The candidates of a cone
+ * are given by their position in the indexed collection, in increasing order,
+ * so the isolation sums are the same as without the index: the bins of a cone
+ * contain all the candidates with |deta| and |dphi| up to the cone size, the
+ * deltaR cut still has to be applied. Candidates with a non finite eta or phi
+ * are in every cone.
+ *
+ * The collection must not change while the index is used; an index can be
+ * kept and reset() for each event, to reuse its memory.
+ */
+
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class PFCandidateEtaPhiIndex {
+ public:
+  /// bins of binSize in eta up to |eta| etaMax, the last ones also take the candidates beyond,
+  /// and of about binSize in phi
+  explicit PFCandidateEtaPhiIndex(double binSize = 0.1, double etaMax = 5.)
+    : nEta_(std::max(1, int(std::ceil(2*etaMax/binSize)))),
+      nPhi_(std::max(1, int(2*M_PI/binSize))),
+      etaMax_(etaMax), etaBinSize_(2*etaMax/nEta_), phiBinSize_(2*M_PI/nPhi_), size_(0) {}
+
+  void reset(const reco::PFCandidateCollection& cands) {
+    std::vector<std::pair<double, double> > etaPhi;
+    etaPhi.reserve(cands.size());
+    for (const auto& cand : cands) etaPhi.push_back(std::make_pair(cand.eta(), cand.phi()));
+    fill(etaPhi);
+  }
+  void reset(const std::vector<reco::PFCandidatePtr>& cands) {
+    std::vector<std::pair<double, double> > etaPhi;
+    etaPhi.reserve(cands.size());
+    for (const auto& cand : cands) etaPhi.push_back(std::make_pair(cand->eta(), cand->phi()));
+    fill(etaPhi);
+  }
+
+  /// the positions in the collection of the candidates which may be within dR of (eta, phi), increasing
+  void candidatesInCone(double eta, double phi, double dR, std::vector<unsigned int>& indices) const {
+    indices.assign(unbinned_.begin(), unbinned_.end());
+    // a margin for the rounding of the bin boundaries
+    const double range = dR + 1e-5*(1. + dR);
+    if (!(std::abs(eta) < 1e9 && std::abs(phi) < 1e9 && range < 1e9)) {
+      // compare with everything, as the deltaR cut would
+      indices.resize(size_);
+      for (unsigned int i = 0; i < size_; ++i) indices[i] = i;
+      return;
+    }
+    const int etaFirst = etaBin(eta - range), etaLast = etaBin(eta + range);
+    const int phiFirst = int(std::floor((phi - range + M_PI)/phiBinSize_));
+    const int phiLast = std::min(int(std::floor((phi + range + M_PI)/phiBinSize_)), phiFirst + nPhi_ - 1);
+    for (int ieta = etaFirst; ieta <= etaLast; ++ieta) {
+      for (int iphi = phiFirst; iphi <= phiLast; ++iphi) {
+	const unsigned int bin = ieta*nPhi_ + ((iphi % nPhi_) + nPhi_) % nPhi_;
+	indices.insert(indices.end(), index_.begin() + binStart_[bin], index_.begin() + binStart_[bin + 1]);
+      }
+    }
+    std::sort(indices.begin(), indices.end());
+  }
+
+  unsigned int size() const { return size_; }
+
+ private:
+  int etaBin(double eta) const {
+    const double bin = std::floor((eta + etaMax_)/etaBinSize_);
+    return bin < 0 ? 0 : (bin >= nEta_ ? nEta_ - 1 : int(bin));
+  }
+  int phiBin(double phi) const {
+    const int bin = int(std::floor((phi + M_PI)/phiBinSize_));
+    return ((bin % nPhi_) + nPhi_) % nPhi_;
+  }
+
+  void fill(const std::vector<std::pair<double, double> >& etaPhi) {
+    size_ = etaPhi.size();
+    unbinned_.clear();
+    // counting sort of the candidates by bin, keeping their order within a bin
+    std::vector<int> bins(size_);
+    binStart_.assign(nEta_*nPhi_ + 1, 0);
+    for (unsigned int i = 0; i < size_; ++i) {
+      const double eta = etaPhi[i].first, phi = etaPhi[i].second;
+      if (std::abs(eta) < 1e9 && std::abs(phi) < 1e9) {
+	bins[i] = etaBin(eta)*nPhi_ + phiBin(phi);
+	++binStart_[bins[i] + 1];
+      } else {
+	bins[i] = -1;
+	unbinned_.push_back(i);
+      }
+    }
+    for (unsigned int bin = 0; bin + 1 < binStart_.size(); ++bin) binStart_[bin + 1] += binStart_[bin];
+    index_.resize(binStart_.back());
+    std::vector<unsigned int> next(binStart_.begin(), binStart_.end() - 1);
+    for (unsigned int i = 0; i < size_; ++i)
+      if (bins[i] >= 0) index_[next[bins[i]]++] = i;
+  }
+
+  int nEta_;
+  int nPhi_;
+  double etaMax_;
+  double etaBinSize_;
+  double phiBinSize_;
+  unsigned int size_;
+  std::vector<unsigned int> binStart_;   // of the bins in index_, and the end
+  std::vector<unsigned int> index_;      // of the candidates, by bin
+  std::vector<unsigned int> unbinned_;   // candidates with a non finite eta or phi
+};
+
+#endif
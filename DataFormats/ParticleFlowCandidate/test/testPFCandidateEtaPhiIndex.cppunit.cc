@@ -0,0 +1,161 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateEtaPhiIndex.h"
+#include "DataFormats/Math/interface/deltaR.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+class testPFCandidateEtaPhiIndex: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(testPFCandidateEtaPhiIndex);
+  CPPUNIT_TEST(testRandomCones);
+  CPPUNIT_TEST(testPhiWrap);
+  CPPUNIT_TEST(testEtaEdges);
+  CPPUNIT_TEST(testNonFinite);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp(){}
+  void tearDown(){}
+
+  void testRandomCones();
+  void testPhiWrap();
+  void testEtaEdges();
+  void testNonFinite();
+
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(testPFCandidateEtaPhiIndex);
+
+namespace {
+
+  reco::PFCandidate candidate(double eta, double phi) {
+    const reco::Candidate::PolarLorentzVector p4(1., eta, phi, 0.);
+    return reco::PFCandidate(0, reco::Candidate::LorentzVector(p4), reco::PFCandidate::h0);
+  }
+
+  reco::PFCandidate nonFiniteCandidate(double value) {
+    return reco::PFCandidate(0, reco::Candidate::LorentzVector(value, value, value, value), reco::PFCandidate::h0);
+  }
+
+  bool isFinite(const reco::PFCandidate& cand) {
+    return std::isfinite(cand.eta()) && std::isfinite(cand.phi());
+  }
+
+  // the candidates of the index within dR of (eta, phi) must be those of a scan of the whole
+  // collection, and the index must return all the candidates with a non finite eta or phi
+  void checkCone(const PFCandidateEtaPhiIndex& index, const reco::PFCandidateCollection& cands,
+		 double eta, double phi, double dR) {
+    std::vector<unsigned int> indices;
+    index.candidatesInCone(eta, phi, dR, indices);
+    CPPUNIT_ASSERT(std::is_sorted(indices.begin(), indices.end()));
+    CPPUNIT_ASSERT(std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+
+    std::vector<unsigned int> inCone, scanned;
+    for (unsigned int i : indices) {
+      CPPUNIT_ASSERT(i < cands.size());
+      if (reco::deltaR2(cands[i].eta(), cands[i].phi(), eta, phi) <= dR*dR) inCone.push_back(i);
+    }
+    for (unsigned int i = 0; i < cands.size(); ++i) {
+      if (reco::deltaR2(cands[i].eta(), cands[i].phi(), eta, phi) <= dR*dR) scanned.push_back(i);
+      if (!isFinite(cands[i])) CPPUNIT_ASSERT(std::binary_search(indices.begin(), indices.end(), i));
+    }
+    CPPUNIT_ASSERT(inCone == scanned);
+  }
+
+}
+
+void testPFCandidateEtaPhiIndex::testRandomCones() {
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<double> eta(-5., 5.), phi(-M_PI, M_PI), dR(0.01, 1.);
+
+  reco::PFCandidateCollection cands;
+  for (int i = 0; i < 2000; ++i) cands.push_back(candidate(eta(rng), phi(rng)));
+
+  for (double binSize : {0.05, 0.1, 0.3}) {
+    PFCandidateEtaPhiIndex index(binSize);
+    index.reset(cands);
+    CPPUNIT_ASSERT(index.size() == cands.size());
+    for (int i = 0; i < 200; ++i) checkCone(index, cands, eta(rng), phi(rng), dR(rng));
+  }
+
+  // cones wider than the whole phi range
+  PFCandidateEtaPhiIndex index;
+  index.reset(cands);
+  checkCone(index, cands, 0., 0., 4.);
+  checkCone(index, cands, 1., 3., 7.);
+}
+
+void testPFCandidateEtaPhiIndex::testPhiWrap() {
+  reco::PFCandidateCollection cands;
+  const double eps = 1e-6;
+  for (double phi : {M_PI - eps, M_PI - 0.05, M_PI - 0.3, -M_PI + eps, -M_PI + 0.05, -M_PI + 0.3, 0., M_PI/2}) {
+    cands.push_back(candidate(0.5, phi));
+    cands.push_back(candidate(0.6, phi));
+  }
+
+  PFCandidateEtaPhiIndex index;
+  index.reset(cands);
+  for (double phi : {M_PI, -M_PI, M_PI - eps, -M_PI + eps, M_PI - 0.1, -M_PI + 0.1})
+    for (double dR : {0.01, 0.1, 0.4})
+      checkCone(index, cands, 0.5, phi, dR);
+
+  // the candidates on the other side of phi = pi are found
+  std::vector<unsigned int> indices;
+  index.candidatesInCone(0.5, M_PI - eps, 0.1, indices);
+  CPPUNIT_ASSERT(std::binary_search(indices.begin(), indices.end(), 6u));
+}
+
+void testPFCandidateEtaPhiIndex::testEtaEdges() {
+  reco::PFCandidateCollection cands;
+  for (double eta : {-7., -5.5, -5., -4.95, -4.5, 4.5, 4.95, 5., 5.5, 7.})
+    for (double phi : {-1., 0., 1.})
+      cands.push_back(candidate(eta, phi));
+
+  // an etaMax below the largest |eta| of the candidates: the last bins take them
+  for (double etaMax : {5., 2.5}) {
+    PFCandidateEtaPhiIndex index(0.1, etaMax);
+    index.reset(cands);
+    for (double eta : {-8., -7., -5.3, -5., -4.9, 0., 4.9, 5., 5.3, 7., 8.})
+      for (double dR : {0.1, 0.5, 2.5})
+	checkCone(index, cands, eta, 0., dR);
+  }
+}
+
+void testPFCandidateEtaPhiIndex::testNonFinite() {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+
+  reco::PFCandidateCollection cands;
+  cands.push_back(candidate(0., 0.));
+  cands.push_back(nonFiniteCandidate(nan));
+  cands.push_back(candidate(0.05, 0.05));
+  cands.push_back(nonFiniteCandidate(inf));
+  cands.push_back(candidate(3., -2.));
+  CPPUNIT_ASSERT(!isFinite(cands[1]));
+
+  PFCandidateEtaPhiIndex index;
+  index.reset(cands);
+  checkCone(index, cands, 0., 0., 0.1);
+  checkCone(index, cands, 3., -2., 0.4);
+  checkCone(index, cands, -3., 1., 0.4);
+
+  // a non finite cone axis or size is compared with every candidate
+  std::vector<unsigned int> all(cands.size());
+  for (unsigned int i = 0; i < all.size(); ++i) all[i] = i;
+  std::vector<unsigned int> indices;
+  index.candidatesInCone(nan, 0., 0.4, indices);
+  CPPUNIT_ASSERT(indices == all);
+  index.candidatesInCone(0., inf, 0.4, indices);
+  CPPUNIT_ASSERT(indices == all);
+  index.candidatesInCone(0., 0., inf, indices);
+  CPPUNIT_ASSERT(indices == all);
+
+  // the index can be refilled with another collection
+  cands.erase(cands.begin() + 1, cands.end());
+  index.reset(cands);
+  index.candidatesInCone(0., 0., 0.4, indices);
+  CPPUNIT_ASSERT(indices == std::vector<unsigned int>(1, 0));
+}
@@ -66,6 +66,12 @@ namespace reco {
     /// copy
     PFRecHit(const PFRecHit& other);
 
+    /// move, without reallocating the corners and neighbours
+    PFRecHit(PFRecHit&& other) noexcept;
+
+    PFRecHit& operator=(const PFRecHit& other) = default;
+    PFRecHit& operator=(PFRecHit&& other) noexcept;
+
     /// destructor
     virtual ~PFRecHit();
 
@@ -81,6 +81,44 @@ PFRecHit::PFRecHit(const PFRecHit& other) :
   neighbours8_(other.neighbours8_)
 {}
 
+PFRecHit::PFRecHit(PFRecHit&& other) noexcept :
+  detId_(other.detId_), 
+  layer_(other.layer_), 
+  energy_(other.energy_), 
+  time_(other.time_),
+  depth_(other.depth_),
+  position_(other.position_), 
+  positionrep_(other.positionrep_),
+  axisxyz_(other.axisxyz_),
+  cornersxyz_(std::move(other.cornersxyz_)),
+  cornersrep_(std::move(other.cornersrep_)),
+  neighbours_(std::move(other.neighbours_)),
+  neighbourInfos_(std::move(other.neighbourInfos_)),
+  neighbours4_(std::move(other.neighbours4_)),
+  neighbours8_(std::move(other.neighbours8_))
+{
+  originalRecHit_.swap(other.originalRecHit_);
+}
+
+PFRecHit& PFRecHit::operator=(PFRecHit&& other) noexcept {
+  originalRecHit_.swap(other.originalRecHit_);
+  detId_ = other.detId_;
+  layer_ = other.layer_;
+  energy_ = other.energy_;
+  time_ = other.time_;
+  depth_ = other.depth_;
+  position_ = other.position_;
+  positionrep_ = other.positionrep_;
+  axisxyz_ = other.axisxyz_;
+  cornersxyz_ = std::move(other.cornersxyz_);
+  cornersrep_ = std::move(other.cornersrep_);
+  neighbours_ = std::move(other.neighbours_);
+  neighbourInfos_ = std::move(other.neighbourInfos_);
+  neighbours4_ = std::move(other.neighbours4_);
+  neighbours8_ = std::move(other.neighbours8_);
+  return *this;
+}
+
 
 
 PFRecHit::~PFRecHit() 
@@ -156,6 +194,13 @@ void PFRecHit::addNeighbour(short x,short y,short z,const PFRecHitRef& ref) {
     bitmask = bitmask | (1<<8) ;
   bitmask = bitmask | (absz << 9);
   
+  // room for the 8 neighbours of a 2D cell at the first one
+  if (neighbours_.empty()) {
+    neighbours_.reserve(8);
+    neighbourInfos_.reserve(8);
+    neighbours8_.reserve(8);
+    neighbours4_.reserve(4);
+  }
   neighbours_.push_back(ref);
   neighbourInfos_.push_back(bitmask);
 
@@ -15,6 +15,9 @@ ProductProvenanceRetriever: Manages the per event/lumi/run per product provenanc
 
 #include <iosfwd>
 #include <memory>
+#ifndef __GCCXML__
+#include <mutex>
+#endif
 #include <set>
 
 /*
@@ -40,6 +43,9 @@ namespace edm {
     void mergeProvenanceRetrievers(std::shared_ptr<ProductProvenanceRetriever> other);
 
     void deepSwap(ProductProvenanceRetriever&);
+
+    //Reads any delayed provenance of iFrom and copies it, leaving iFrom usable
+    void deepCopy(ProductProvenanceRetriever const& iFrom);
     
     void reset();
   private:
@@ -51,6 +57,12 @@ namespace edm {
     typedef std::set<ProductProvenance> eiSet;
 
     mutable eiSet entryInfoSet_;
+#ifndef __GCCXML__
+    //Products may be put concurrently when prefetching runs modules in parallel
+    mutable std::mutex entryInfoSetMutex_;
+    //A SubProcess may copy the provenance while the parent's end paths read it
+    mutable std::mutex readProvenanceMutex_;
+#endif
     std::shared_ptr<ProductProvenanceRetriever> nextRetriever_;
     mutable std::shared_ptr<ProvenanceReaderBase> provenanceReader_;
     unsigned int transitionIndex_;
@@ -32,6 +32,7 @@ namespace edm {
 
   void
   ProductProvenanceRetriever::readProvenance() const {
+    std::lock_guard<std::mutex> guard(readProvenanceMutex_);
     if(delayedRead_ && provenanceReader_) {
       provenanceReader_->readProvenance(*this,transitionIndex_);
       delayedRead_ = false; // only read once
@@ -53,6 +54,24 @@ namespace edm {
     }
   }
 
+  void ProductProvenanceRetriever::deepCopy(ProductProvenanceRetriever const& iFrom)
+  {
+    //the provenance reader is not thread safe so read everything now
+    iFrom.readProvenance();
+    {
+      std::lock_guard<std::mutex> guard(iFrom.entryInfoSetMutex_);
+      entryInfoSet_ = iFrom.entryInfoSet_;
+    }
+    provenanceReader_.reset();
+    delayedRead_ = false;
+    if(iFrom.nextRetriever_) {
+      if(not nextRetriever_) {
+        nextRetriever_.reset(new ProductProvenanceRetriever(transitionIndex_));
+      }
+      nextRetriever_->deepCopy(*(iFrom.nextRetriever_));
+    }
+  }
+
   void
   ProductProvenanceRetriever::reset() {
     entryInfoSet_.clear();
@@ -68,6 +87,7 @@ namespace edm {
     // provenance when someone tries to access it not when doing the insert
     // doing the delay saves 20% of time when doing an analysis job
     //readProvenance();
+    std::lock_guard<std::mutex> guard(entryInfoSetMutex_);
     entryInfoSet_.insert(entryInfo);
   }
  
@@ -80,15 +100,17 @@ namespace edm {
   ProductProvenanceRetriever::branchIDToProvenance(BranchID const& bid) const {
     readProvenance();
     ProductProvenance ei(bid);
-    eiSet::const_iterator it = entryInfoSet_.find(ei);
-    if(it == entryInfoSet_.end()) {
-      if(nextRetriever_) {
-        return nextRetriever_->branchIDToProvenance(bid);
-      } else {
-        return 0;
+    {
+      std::lock_guard<std::mutex> guard(entryInfoSetMutex_);
+      eiSet::const_iterator it = entryInfoSet_.find(ei);
+      if(it != entryInfoSet_.end()) {
+        return &*it;
       }
     }
-    return &*it;
+    if(nextRetriever_) {
+      return nextRetriever_->branchIDToProvenance(bid);
+    }
+    return 0;
   }
 
   ProvenanceReaderBase::~ProvenanceReaderBase() {
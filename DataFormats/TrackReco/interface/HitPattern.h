@@ -405,6 +405,7 @@ private:
 
     int countHits(HitCategory category, filterType filter) const;
     int countTypedHits(HitCategory category, filterType typeFilter, filterType filter) const;
+    int countTrackerLayers(HitCategory category, uint16_t substr, uint16_t nLayers, uint32_t layerCase) const;
 
     bool insertTrackHit(const uint16_t pattern);
     bool insertExpectedInnerHit(const uint16_t pattern);
@@ -514,278 +514,157 @@ int HitPattern::trackerLayersWithoutMeasurement(HitCategory category) const {
 }
 
 
-int HitPattern::pixelBarrelLayersWithMeasurement() const
+// number of layers from 1 to nLayers of a tracker substructure for which getTrackerLayerCase
+// returns layerCase, in a single pass over the hits
+int HitPattern::countTrackerLayers(HitCategory category, uint16_t substr, uint16_t nLayers, uint32_t layerCase) const
 {
-    int count = 0;
-    uint16_t NPixBarrel = 4;
-    for (uint16_t layer = 1; layer <= NPixBarrel; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, PixelSubdetector::PixelBarrel, layer) == HIT_TYPE::VALID) {
-            count++;
-        }
+    uint16_t tk_substr = (0x1 << SubDetectorOffset)
+                         + ((substr & SubstrMask) << SubstrOffset);
+
+    uint16_t mask = (SubDetectorMask << SubDetectorOffset)
+                    + (SubstrMask << SubstrOffset);
+
+    // bit l is set if layer l has a hit of this type
+    uint32_t valid = 0, missing = 0, inactive = 0;
+    std::pair<uint8_t, uint8_t> range = getCategoryIndexRange(category);
+    for (int i = range.first; i < range.second; ++i) {
+        uint16_t pattern = getHitPatternByAbsoluteIndex(i);
+        if ((pattern & mask) != tk_substr) continue;
+        uint32_t layer = 1u << ((pattern >> LayerOffset) & LayerMask);
+        uint16_t hitType = (pattern >> HitTypeOffset) & HitTypeMask;
+        if (hitType == HIT_TYPE::VALID) valid |= layer;
+        else if (hitType == HIT_TYPE::MISSING) missing |= layer;
+        else inactive |= layer; // BAD and INACTIVE as the same type
     }
-    return count;
+
+    uint32_t layers;
+    if (layerCase == HIT_TYPE::VALID) layers = valid;
+    else if (layerCase == HIT_TYPE::MISSING) layers = missing & ~valid;
+    else if (layerCase == HIT_TYPE::INACTIVE) layers = inactive & ~missing & ~valid;
+    else layers = ~(valid | missing | inactive); // NULL_RETURN
+    layers &= (1u << (nLayers + 1)) - 2;
+    return std::bitset<32>(layers).count();
+}
+
+int HitPattern::pixelBarrelLayersWithMeasurement() const
+{
+    return countTrackerLayers(TRACK_HITS, PixelSubdetector::PixelBarrel, 4, HIT_TYPE::VALID);
 }
 
 int HitPattern::pixelEndcapLayersWithMeasurement() const
 {
-    int count = 0;
-    uint16_t NPixForward = 3;
-    for (uint16_t layer = 1; layer <= NPixForward; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, PixelSubdetector::PixelEndcap, layer) == HIT_TYPE::VALID) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, PixelSubdetector::PixelEndcap, 3, HIT_TYPE::VALID);
 }
 
 int HitPattern::stripTIBLayersWithMeasurement() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 4; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TIB, layer) == HIT_TYPE::VALID) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TIB, 4, HIT_TYPE::VALID);
 }
 
 int HitPattern::stripTIDLayersWithMeasurement() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 3; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TID, layer) == HIT_TYPE::VALID) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TID, 3, HIT_TYPE::VALID);
 }
 
 int HitPattern::stripTOBLayersWithMeasurement() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 6; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TOB, layer) == HIT_TYPE::VALID) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TOB, 6, HIT_TYPE::VALID);
 }
 
 int HitPattern::stripTECLayersWithMeasurement() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 9; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TEC, layer) == HIT_TYPE::VALID) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TEC, 9, HIT_TYPE::VALID);
 }
 
 int HitPattern::pixelBarrelLayersWithoutMeasurement(HitCategory category) const
 {
-    int count = 0;
-    uint16_t NPixBarrel = 4;
-    for (uint16_t layer = 1; layer <= NPixBarrel; layer++) {
-        if (getTrackerLayerCase(category, PixelSubdetector::PixelBarrel, layer) == HIT_TYPE::MISSING) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(category, PixelSubdetector::PixelBarrel, 4, HIT_TYPE::MISSING);
 }
 
 int HitPattern::pixelEndcapLayersWithoutMeasurement(HitCategory category) const
 {
-    int count = 0;
-    uint16_t NPixForward = 3;
-    for (uint16_t layer = 1; layer <= NPixForward; layer++) {
-        if (getTrackerLayerCase(category, PixelSubdetector::PixelEndcap, layer) == HIT_TYPE::MISSING) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(category, PixelSubdetector::PixelEndcap, 3, HIT_TYPE::MISSING);
 }
 
 int HitPattern::stripTIBLayersWithoutMeasurement(HitCategory category) const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 4; layer++) {
-        if (getTrackerLayerCase(category, StripSubdetector::TIB, layer) == HIT_TYPE::MISSING) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(category, StripSubdetector::TIB, 4, HIT_TYPE::MISSING);
 }
 
 int HitPattern::stripTIDLayersWithoutMeasurement(HitCategory category) const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 3; layer++) {
-        if (getTrackerLayerCase(category, StripSubdetector::TID, layer) == HIT_TYPE::MISSING) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(category, StripSubdetector::TID, 3, HIT_TYPE::MISSING);
 }
 
 int HitPattern::stripTOBLayersWithoutMeasurement(HitCategory category) const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 6; layer++) {
-        if (getTrackerLayerCase(category, StripSubdetector::TOB, layer) == HIT_TYPE::MISSING) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(category, StripSubdetector::TOB, 6, HIT_TYPE::MISSING);
 }
 
 int HitPattern::stripTECLayersWithoutMeasurement(HitCategory category) const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 9; layer++) {
-        if (getTrackerLayerCase(category, StripSubdetector::TEC, layer) == HIT_TYPE::MISSING) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(category, StripSubdetector::TEC, 9, HIT_TYPE::MISSING);
 }
 
 
 int HitPattern::pixelBarrelLayersTotallyOffOrBad() const
 {
-    int count = 0;
-    uint16_t NPixBarrel = 4;
-    for (uint16_t layer = 1; layer <= NPixBarrel; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, PixelSubdetector::PixelBarrel, layer) == HIT_TYPE::INACTIVE) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, PixelSubdetector::PixelBarrel, 4, HIT_TYPE::INACTIVE);
 }
 
 int HitPattern::pixelEndcapLayersTotallyOffOrBad() const
 {
-    int count = 0;
-    uint16_t NPixForward = 3;
-    for (uint16_t layer = 1; layer <= NPixForward; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, PixelSubdetector::PixelEndcap, layer) == HIT_TYPE::INACTIVE) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, PixelSubdetector::PixelEndcap, 3, HIT_TYPE::INACTIVE);
 }
 
 int HitPattern::stripTIBLayersTotallyOffOrBad() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 4; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TIB, layer) == HIT_TYPE::INACTIVE) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TIB, 4, HIT_TYPE::INACTIVE);
 }
 
 int HitPattern::stripTIDLayersTotallyOffOrBad() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 3; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TID, layer) == HIT_TYPE::INACTIVE) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TID, 3, HIT_TYPE::INACTIVE);
 }
 
 int HitPattern::stripTOBLayersTotallyOffOrBad() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 6; layer++) {
-
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TOB, layer) == HIT_TYPE::INACTIVE) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TOB, 6, HIT_TYPE::INACTIVE);
 }
 
 int HitPattern::stripTECLayersTotallyOffOrBad() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 9; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TEC, layer) == HIT_TYPE::INACTIVE) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TEC, 9, HIT_TYPE::INACTIVE);
 }
 
 int HitPattern::pixelBarrelLayersNull() const
 {
-    int count = 0;
-    uint16_t NPixBarrel = 4;
-    for (uint16_t layer = 1; layer <= NPixBarrel; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, PixelSubdetector::PixelBarrel, layer) == NULL_RETURN) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, PixelSubdetector::PixelBarrel, 4, NULL_RETURN);
 }
 
 int HitPattern::pixelEndcapLayersNull() const
 {
-    int count = 0;
-    uint16_t NPixForward = 3;
-    for (uint16_t layer = 1; layer <= NPixForward; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, PixelSubdetector::PixelEndcap, layer) == NULL_RETURN) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, PixelSubdetector::PixelEndcap, 3, NULL_RETURN);
 }
 
 int HitPattern::stripTIBLayersNull() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 4; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TIB, layer) == NULL_RETURN) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TIB, 4, NULL_RETURN);
 }
 
 int HitPattern::stripTIDLayersNull() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 3; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TID, layer) == NULL_RETURN) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TID, 3, NULL_RETURN);
 }
 
 int HitPattern::stripTOBLayersNull() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 6; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TOB, layer) == NULL_RETURN) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TOB, 6, NULL_RETURN);
 }
 
 int HitPattern::stripTECLayersNull() const
 {
-    int count = 0;
-    for (uint16_t layer = 1; layer <= 9; layer++) {
-        if (getTrackerLayerCase(TRACK_HITS, StripSubdetector::TEC, layer) == NULL_RETURN) {
-            count++;
-        }
-    }
-    return count;
+    return countTrackerLayers(TRACK_HITS, StripSubdetector::TEC, 9, NULL_RETURN);
 }
 
 void HitPattern::printHitPattern(HitCategory category, int position, std::ostream &stream) const
@@ -158,6 +158,11 @@ EcalRawToDigi::EcalRawToDigi(edm::ParameterSet const& conf):
   dataToken_=consumes<FEDRawDataCollection>(dataLabel);
   if (REGIONAL_){
       fedsToken_=consumes<EcalListOfFEDS>(fedsLabel);
+      // one instance can unpack the FEDs of several regions, each FED once
+      std::vector<edm::InputTag> moreFedsLabels = conf.existsAs<std::vector<edm::InputTag> >("moreFedLabels") ?
+        conf.getParameter<std::vector<edm::InputTag> >("moreFedLabels") : std::vector<edm::InputTag>();
+      for (std::vector<edm::InputTag>::const_iterator l=moreFedsLabels.begin(); l!=moreFedsLabels.end(); ++l)
+        moreFedsTokens_.push_back(consumes<EcalListOfFEDS>(*l));
   }
 
   // Build a new Electronics mapper and parse default map file
@@ -244,6 +249,7 @@ void EcalRawToDigi::fillDescriptions(edm::ConfigurationDescriptions& description
   edm::ParameterSetDescription desc;
   desc.add<bool>("tccUnpacking",true);
   desc.add<edm::InputTag>("FedLabel",edm::InputTag("listfeds"));
+  desc.add<std::vector<edm::InputTag> >("moreFedLabels",std::vector<edm::InputTag>());
   desc.add<bool>("srpUnpacking",true);
   desc.add<bool>("syncCheck",true);
   desc.add<bool>("feIdCheck",true);
@@ -325,11 +331,15 @@ void EcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es)
   }
 
   // Get list of FEDS :
-  std::vector<int> FEDS_to_unpack;
+  std::bitset<FEDNumbering::MAXECALFEDID-FEDNumbering::MINECALFEDID+1> FEDS_to_unpack;
   if (REGIONAL_) {
         edm::Handle<EcalListOfFEDS> listoffeds;
         e.getByToken(fedsToken_, listoffeds);
-        FEDS_to_unpack = listoffeds -> GetList();
+        setFEDs(listoffeds->GetList(), FEDS_to_unpack);
+        for (std::vector<edm::EDGetTokenT<EcalListOfFEDS> >::const_iterator t=moreFedsTokens_.begin(); t!=moreFedsTokens_.end(); ++t) {
+          e.getByToken(*t, listoffeds);
+          setFEDs(listoffeds->GetList(), FEDS_to_unpack);
+        }
   }
 
 
@@ -442,8 +452,8 @@ void EcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es)
   for (std::vector<int>::const_iterator i=fedUnpackList_.begin(); i!=fedUnpackList_.end(); i++) {
 
     if (REGIONAL_) {
-      std::vector<int>::const_iterator fed_it = find(FEDS_to_unpack.begin(), FEDS_to_unpack.end(), *i);
-      if (fed_it == FEDS_to_unpack.end()) continue;
+      if (*i < FEDNumbering::MINECALFEDID || *i > FEDNumbering::MAXECALFEDID) continue;
+      if (!FEDS_to_unpack.test(*i-FEDNumbering::MINECALFEDID)) continue;
     }
 
   
@@ -33,6 +33,7 @@
 #include <FWCore/Framework/interface/ESWatcher.h>
 #include "DataFormats/EcalRawData/interface/EcalListOfFEDS.h"
 #include <sys/time.h>
+#include <bitset>
 
 class EcalElectronicsMapper;
 class EcalElectronicsMapping;
@@ -66,6 +67,12 @@ class EcalRawToDigi : public edm::stream::EDProducer<>{
   
  private:
 
+  // mark the ECAL FEDs of a list
+  template <size_t N> static void setFEDs(const std::vector<int>& feds, std::bitset<N>& mask) {
+    for (std::vector<int>::const_iterator f=feds.begin(); f!=feds.end(); ++f)
+      if (*f >= FEDNumbering::MINECALFEDID && *f <= FEDNumbering::MAXECALFEDID) mask.set(*f-FEDNumbering::MINECALFEDID);
+  }
+
   //list of FEDs to unpack
   std::vector<int> fedUnpackList_;
 
@@ -89,6 +96,8 @@ class EcalRawToDigi : public edm::stream::EDProducer<>{
   
   edm::EDGetTokenT<FEDRawDataCollection> dataToken_;
   edm::EDGetTokenT<EcalListOfFEDS> fedsToken_;  
+  // additional lists (e.g. of other seeds), a FED is unpacked if it is in any of them
+  std::vector<edm::EDGetTokenT<EcalListOfFEDS> > moreFedsTokens_;
 
   // -- For regional unacking :
   bool REGIONAL_ ;
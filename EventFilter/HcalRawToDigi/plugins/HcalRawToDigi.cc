@@ -10,6 +10,8 @@ using namespace std;
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include <iostream>
 
+#include "tbb/parallel_for.h"
+
 HcalRawToDigi::HcalRawToDigi(edm::ParameterSet const& conf):
   unpacker_(conf.getUntrackedParameter<int>("HcalFirstFED",int(FEDNumbering::MINHCALFEDID)),conf.getParameter<int>("firstSample"),conf.getParameter<int>("lastSample")),
   filter_(conf.getParameter<bool>("FilterDataQuality"),conf.getParameter<bool>("FilterDataQuality"),
@@ -24,7 +26,8 @@ HcalRawToDigi::HcalRawToDigi(edm::ParameterSet const& conf):
   silent_(conf.getUntrackedParameter<bool>("silent",true)),
   complainEmptyData_(conf.getUntrackedParameter<bool>("ComplainEmptyData",false)),
   unpackerMode_(conf.getUntrackedParameter<int>("UnpackerMode",0)),
-  expectedOrbitMessageTime_(conf.getUntrackedParameter<int>("ExpectedOrbitMessageTime",-1))
+  expectedOrbitMessageTime_(conf.getUntrackedParameter<int>("ExpectedOrbitMessageTime",-1)),
+  unpackInParallel_(conf.getUntrackedParameter<bool>("UnpackInParallel",false))
 {
   tok_data_ = consumes<FEDRawDataCollection>(conf.getParameter<edm::InputTag>("InputLabel"));
 
@@ -35,6 +38,7 @@ HcalRawToDigi::HcalRawToDigi(edm::ParameterSet const& conf):
   
   unpacker_.setExpectedOrbitMessageTime(expectedOrbitMessageTime_);
   unpacker_.setMode(unpackerMode_);
+  if (unpackInParallel_) fedUnpackers_.assign(fedUnpackList_.size(),unpacker_);
   std::ostringstream ss;
   for (unsigned int i=0; i<fedUnpackList_.size(); i++) 
     ss << fedUnpackList_[i] << " ";
@@ -76,6 +80,7 @@ void HcalRawToDigi::fillDescriptions(edm::ConfigurationDescriptions& description
   desc.addUntracked<bool>("ComplainEmptyData",false);
   desc.addUntracked<int>("UnpackerMode",0);
   desc.addUntracked<int>("ExpectedOrbitMessageTime",-1);
+  desc.addUntracked<bool>("UnpackInParallel",false);
   desc.add<edm::InputTag>("InputLabel",edm::InputTag("rawDataCollector"));
   descriptions.add("hcalRawToDigi",desc);
 }
@@ -125,28 +130,11 @@ void HcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es)
   if (unpackTTP_) colls.ttp=&ttp;
  
   // Step C: unpack all requested FEDs
-  for (std::vector<int>::const_iterator i=fedUnpackList_.begin(); i!=fedUnpackList_.end(); i++) {
-    const FEDRawData& fed = rawraw->FEDData(*i);
-    if (fed.size()==0) {
-      if (complainEmptyData_) {
-	if (!silent_) edm::LogWarning("EmptyData") << "No data for FED " << *i;
-	report->addError(*i);
-      }
-    } else if (fed.size()<8*3) {
-      if (!silent_) edm::LogWarning("EmptyData") << "Tiny data " << fed.size() << " for FED " << *i;
-      report->addError(*i);
-    } else {
-      try {
-	unpacker_.unpack(fed,*readoutMap,colls, *report,silent_);
-	report->addUnpacked(*i);
-      } catch (cms::Exception& e) {
-	if (!silent_) edm::LogWarning("Unpacking error") << e.what();
-	report->addError(*i);
-      } catch (...) {
-	if (!silent_) edm::LogWarning("Unpacking exception");
-	report->addError(*i);
-      }
-    }
+  if (unpackInParallel_) {
+    unpackFEDsInParallel(*rawraw,*readoutMap,colls,*report);
+  } else {
+    for (std::vector<int>::const_iterator i=fedUnpackList_.begin(); i!=fedUnpackList_.end(); i++)
+      unpackFED(unpacker_,rawraw->FEDData(*i),*i,*readoutMap,colls,*report);
   }
 
 
@@ -252,4 +240,81 @@ void HcalRawToDigi::produce(edm::Event& e, const edm::EventSetup& es)
 
 }
 
+void HcalRawToDigi::unpackFED(HcalUnpacker& unpacker, const FEDRawData& fed, int fedId, const HcalElectronicsMap& readoutMap, HcalUnpacker::Collections& colls, HcalUnpackerReport& report) {
+  if (fed.size()==0) {
+    if (complainEmptyData_) {
+      if (!silent_) edm::LogWarning("EmptyData") << "No data for FED " << fedId;
+      report.addError(fedId);
+    }
+  } else if (fed.size()<8*3) {
+    if (!silent_) edm::LogWarning("EmptyData") << "Tiny data " << fed.size() << " for FED " << fedId;
+    report.addError(fedId);
+  } else {
+    try {
+      unpacker.unpack(fed,readoutMap,colls,report,silent_);
+      report.addUnpacked(fedId);
+    } catch (cms::Exception& e) {
+      if (!silent_) edm::LogWarning("Unpacking error") << e.what();
+      report.addError(fedId);
+    } catch (...) {
+      if (!silent_) edm::LogWarning("Unpacking exception");
+      report.addError(fedId);
+    }
+  }
+}
 
+namespace {
+  // append the digis of all the FEDs, in the FED order, once their number is known
+  template <class Digi, class FEDDigis>
+  void appendDigis(std::vector<Digi>& digis, std::vector<FEDDigis>& fedDigis, std::vector<Digi> FEDDigis::* member) {
+    size_t n=digis.size();
+    for (size_t i=0; i<fedDigis.size(); i++) n+=(fedDigis[i].*member).size();
+    digis.reserve(n);
+    for (size_t i=0; i<fedDigis.size(); i++) {
+      std::vector<Digi>& v=fedDigis[i].*member;
+      digis.insert(digis.end(),v.begin(),v.end());
+    }
+  }
+}
+
+// The FEDs are unpacked concurrently, each with its own unpacker into its own
+// digis and report, which are then merged in the order of fedUnpackList_:
+// the output is the same as when unpacking the FEDs one after the other.
+void HcalRawToDigi::unpackFEDsInParallel(const FEDRawDataCollection& rawraw, const HcalElectronicsMap& readoutMap, HcalUnpacker::Collections& colls, HcalUnpackerReport& report) {
+  std::vector<FEDDigis> fedDigis(fedUnpackList_.size());
+  tbb::parallel_for(size_t(0), fedUnpackList_.size(), [&](size_t i) {
+      FEDDigis& d=fedDigis[i];
+      HcalUnpacker::Collections c;
+      c.hbheCont=&d.hbhe;
+      c.hoCont=&d.ho;
+      c.hfCont=&d.hf;
+      c.tpCont=&d.htp;
+      c.tphoCont=&d.hotp;
+      c.calibCont=&d.hc;
+      c.zdcCont=&d.zdc;
+      if (unpackTTP_) c.ttp=&d.ttp;
+      unpackFED(fedUnpackers_[i],rawraw.FEDData(fedUnpackList_[i]),fedUnpackList_[i],readoutMap,c,d.report);
+      d.qie10.reset(c.qie10);
+    });
+
+  appendDigis(*colls.hbheCont,fedDigis,&FEDDigis::hbhe);
+  appendDigis(*colls.hoCont,fedDigis,&FEDDigis::ho);
+  appendDigis(*colls.hfCont,fedDigis,&FEDDigis::hf);
+  appendDigis(*colls.tpCont,fedDigis,&FEDDigis::htp);
+  appendDigis(*colls.tphoCont,fedDigis,&FEDDigis::hotp);
+  appendDigis(*colls.calibCont,fedDigis,&FEDDigis::hc);
+  appendDigis(*colls.zdcCont,fedDigis,&FEDDigis::zdc);
+  if (unpackTTP_) appendDigis(*colls.ttp,fedDigis,&FEDDigis::ttp);
+
+  for (size_t i=0; i<fedDigis.size(); i++) {
+    report.merge(fedDigis[i].report);
+    if (!fedDigis[i].qie10) continue;
+    if (colls.qie10==0) {
+      colls.qie10=fedDigis[i].qie10.release();
+    } else if (colls.qie10->samples()!=fedDigis[i].qie10->samples()) {
+      edm::LogError("Invalid Data") << "Collection has " << colls.qie10->samples() << " samples per digi, raw data of FED " << fedUnpackList_[i] << " has " << fedDigis[i].qie10->samples() << "!";
+    } else {
+      colls.qie10->append(*fedDigis[i].qie10);
+    }
+  }
+}
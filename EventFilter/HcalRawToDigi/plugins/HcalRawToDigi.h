@@ -26,6 +26,9 @@
 
 #include "DataFormats/FEDRawData/interface/FEDRawDataCollection.h"
 
+#include <memory>
+#include <vector>
+
 class HcalRawToDigi : public edm::stream::EDProducer <>
 {
 public:
@@ -34,6 +37,9 @@ public:
   static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
   virtual void produce(edm::Event& , const edm::EventSetup&) override;
 private:
+  void unpackFED(HcalUnpacker& unpacker, const FEDRawData& fed, int fedId, const HcalElectronicsMap& readoutMap, HcalUnpacker::Collections& colls, HcalUnpackerReport& report);
+  void unpackFEDsInParallel(const FEDRawDataCollection& rawraw, const HcalElectronicsMap& readoutMap, HcalUnpacker::Collections& colls, HcalUnpackerReport& report);
+
   edm::EDGetTokenT<FEDRawDataCollection> tok_data_;
   HcalUnpacker unpacker_;
   HcalDataFrameFilter filter_;
@@ -42,6 +48,22 @@ private:
   const bool unpackCalib_, unpackZDC_, unpackTTP_;
   const bool silent_, complainEmptyData_;
   const int unpackerMode_, expectedOrbitMessageTime_;
+  const bool unpackInParallel_;
+
+  // with unpackInParallel, an unpacker per FED of fedUnpackList_ and its digis
+  std::vector<HcalUnpacker> fedUnpackers_;
+  struct FEDDigis {
+    std::vector<HBHEDataFrame> hbhe;
+    std::vector<HODataFrame> ho;
+    std::vector<HFDataFrame> hf;
+    std::vector<HcalTriggerPrimitiveDigi> htp;
+    std::vector<HcalCalibDataFrame> hc;
+    std::vector<ZDCDataFrame> zdc;
+    std::vector<HcalTTPDigi> ttp;
+    std::vector<HOTriggerPrimitiveDigi> hotp;
+    std::unique_ptr<QIE10DigiCollection> qie10;
+    HcalUnpackerReport report;
+  };
 
   struct Statistics {
     int max_hbhe, ave_hbhe;
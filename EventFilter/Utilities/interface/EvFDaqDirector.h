@@ -136,6 +136,7 @@ namespace evf{
       bool requireTSPSet_;
       std::string selectedTransferMode_;
       std::string hltSourceDirectory_;
+      unsigned int fuLockPollInterval_; // microseconds between two attempts to lock fu.lock
 
       std::string hostname_;
       std::string run_string_;
@@ -191,6 +192,11 @@ namespace evf{
       unsigned int eolsNFilesIndex_ = 1;
       std::string stopFilePath_;
 
+      // acquisitions of fu.lock in updateFuLock and the time waited for them, in microseconds
+      unsigned long fuLockAcquisitions_ = 0;
+      unsigned long long fuLockWaitTotal_ = 0;
+      unsigned long long fuLockWaitMax_ = 0;
+
       std::shared_ptr<Json::Value> transferSystemJson_;
   };
 }
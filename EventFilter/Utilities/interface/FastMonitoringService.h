@@ -149,6 +149,7 @@ namespace evf{
       void accumulateFileSize(unsigned int lumi, unsigned long fileSize);
       void startedLookingForFile();
       void stoppedLookingForFile(unsigned int lumi);
+      void reportInputChunkPool(unsigned int freeChunks, unsigned int totalChunks);
       unsigned int getEventsProcessedForLumi(unsigned int lumi);
       std::string getRunDirName() const { return runDirectory_.stem().string(); }
 
@@ -226,6 +227,9 @@ namespace evf{
       //helpers for source statistics:
       std::map<unsigned int, unsigned long> accuSize_;
       std::vector<double> leadTimes_;
+      //occupancy of the source input chunk pool
+      std::atomic<unsigned int> inputChunksFree_;
+      std::atomic<unsigned int> inputChunksTotal_;
 
       //for output module
       std::map<unsigned int, unsigned int> processedEventsPerLumi_;
@@ -26,6 +26,8 @@ namespace evf{
       DoubleJ fastThroughputJ_;
       DoubleJ fastAvgLeadTimeJ_;
       IntJ fastFilesProcessedJ_;
+      IntJ fastInputChunksFreeJ_;
+      IntJ fastInputChunksTotalJ_;
 
       unsigned int varIndexThrougput_;
 
@@ -52,10 +54,14 @@ namespace evf{
 	fastThroughputJ_ = 0;
 	fastAvgLeadTimeJ_ = 0;
 	fastFilesProcessedJ_ = 0;
+	fastInputChunksFreeJ_ = 0;
+	fastInputChunksTotalJ_ = 0;
         fastMacrostateJ_.setName("Macrostate");
         fastThroughputJ_.setName("Throughput");
         fastAvgLeadTimeJ_.setName("AverageLeadTime");
 	fastFilesProcessedJ_.setName("FilesProcessed");
+	fastInputChunksFreeJ_.setName("InputChunksFree");
+	fastInputChunksTotalJ_.setName("InputChunksTotal");
 
         fastPathProcessedJ_ = 0;
         fastPathProcessedJ_.setName("Processed");
@@ -68,6 +74,8 @@ namespace evf{
         fm->registerGlobalMonitorable(&fastThroughputJ_,false);
         fm->registerGlobalMonitorable(&fastAvgLeadTimeJ_,false);
         fm->registerGlobalMonitorable(&fastFilesProcessedJ_,false);
+        fm->registerGlobalMonitorable(&fastInputChunksFreeJ_,false);
+        fm->registerGlobalMonitorable(&fastInputChunksTotalJ_,false);
 
 	for (unsigned int i=0;i<nStreams;i++) {
 	 AtomicMonUInt * p  = new AtomicMonUInt;
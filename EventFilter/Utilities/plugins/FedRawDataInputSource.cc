@@ -26,6 +26,11 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Utilities/interface/UnixSignalHandlers.h"
+#include "FWCore/Utilities/interface/NumaTopology.h"
+
+#include "TClass.h"
+#include "TClassRef.h"
+#include "TClassStreamer.h"
 
 #include "EventFilter/FEDInterface/interface/GlobalEventNumber.h"
 #include "EventFilter/FEDInterface/interface/fed_header.h"
@@ -51,6 +56,36 @@
 
 using namespace jsoncollector;
 
+namespace {
+  //FEDRawData referencing the input chunks are written as if they owned their data
+  class FEDRawDataStreamer : public TClassStreamer {
+  public:
+    FEDRawDataStreamer() : cl_("FEDRawData") {}
+
+    virtual void operator()(TBuffer &R__b, void *objp) override {
+      if (R__b.IsReading()) {
+        cl_->ReadBuffer(R__b, objp);
+        return;
+      }
+      const FEDRawData* obj = static_cast<const FEDRawData*>(objp);
+      if (!obj->isExternal()) {
+        cl_->WriteBuffer(R__b, objp);
+        return;
+      }
+      FEDRawData owned(obj->size());
+      memcpy(owned.data(), obj->data(), obj->size());
+      cl_->WriteBuffer(R__b, &owned);
+    }
+
+    virtual TClassStreamer* Generate() const override {
+      return new FEDRawDataStreamer(*this);
+    }
+
+  private:
+    TClassRef cl_;
+  };
+}
+
 FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
                                              edm::InputSourceDescription const& desc) :
   edm::RawInputSource(pset, desc),
@@ -61,6 +96,8 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
   getLSFromFilename_(pset.getUntrackedParameter<bool> ("getLSFromFilename", true)),
   verifyAdler32_(pset.getUntrackedParameter<bool> ("verifyAdler32", true)),
   useL1EventID_(pset.getUntrackedParameter<bool> ("useL1EventID", false)),
+  useZeroCopyFEDRawData_(pset.getUntrackedParameter<bool> ("useZeroCopyFEDRawData", false)),
+  numaLocalChunks_(pset.getUntrackedParameter<bool> ("numaLocalChunks", false)),
   testModeNoBuilderUnit_(edm::Service<evf::EvFDaqDirector>()->getTestModeNoBuilderUnit()),
   runNumber_(edm::Service<evf::EvFDaqDirector>()->getRunNumber()),
   fuOutputDir_(edm::Service<evf::EvFDaqDirector>()->baseRunDir()),
@@ -102,6 +139,20 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
   numConcurrentReads_=numBuffers_-1;
   singleBufferMode_ = !(numBuffers_>1);
 
+  //FED data can only reference chunks which are not overwritten while events are in flight
+  if (useZeroCopyFEDRawData_) {
+    if (singleBufferMode_) {
+      edm::LogWarning("FedRawDataInputSource") << "useZeroCopyFEDRawData requires numBuffers > 1 and is ignored";
+      useZeroCopyFEDRawData_ = false;
+    }
+    else {
+      TClass *cl = TClass::GetClass(typeid(FEDRawData));
+      if (cl->GetStreamer() == 0) {
+        cl->AdoptStreamer(new FEDRawDataStreamer());
+      }
+    }
+  }
+
   //het handles to DaqDirector and FastMonitoringService because it isn't acessible in readSupervisor thread
 
   try {
@@ -122,10 +173,20 @@ FedRawDataInputSource::FedRawDataInputSource(edm::ParameterSet const& pset,
     assert(0);//test
   }
 
+  if (numaLocalChunks_ && edm::numa::numberOfNodes()<2) {
+    edm::LogInfo("FedRawDataInputSource") << "single NUMA node found, numaLocalChunks has no effect";
+    numaLocalChunks_ = false;
+  }
+
   //should delete chunks when run stops
-  for (unsigned int i=0;i<numBuffers_;i++) {
-    freeChunks_.push(new InputChunk(i,eventChunkSize_));
+  if (numaLocalChunks_)
+    allocateNumaLocalChunks();
+  else {
+    for (unsigned int i=0;i<numBuffers_;i++) {
+      freeChunks_->addChunk(new InputChunk(i,eventChunkSize_));
+    }
   }
+  if (fms_) fms_->reportInputChunkPool(freeChunks_->freeChunks(),freeChunks_->totalChunks());
 
   quit_threads_ = false;
 
@@ -171,7 +232,7 @@ FedRawDataInputSource::~FedRawDataInputSource()
   /*
   for (unsigned int i=0;i<numConcurrentReads_+1;i++) {
     InputChunk *ch;
-    while (!freeChunks_.try_pop(ch)) {}
+    while (!freeChunks_->try_pop(ch)) {}
     delete ch;
   }
   */
@@ -312,6 +373,8 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
   const size_t headerSize[4] = {0,2*sizeof(uint32),(4 + 1024) * sizeof(uint32),7*sizeof(uint32)}; //size per version of FRDEventHeader
 
   if (setExceptionState_) threadError();
+  //prefer chunks local to the node of the thread handing events to the streams
+  if (numaLocalChunks_) freeChunks_->setPreferredNode(edm::numa::currentNode());
   if (!currentFile_)
   {
     if (!streamFileTrackerPtr_) {
@@ -384,7 +447,10 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
   //file is finished
   if (currentFile_->bufferPosition_==currentFile_->fileSize_) {
     //release last chunk (it is never released elsewhere)
-    freeChunks_.push(currentFile_->chunks_[currentFile_->currentChunk_]);
+    if (useZeroCopyFEDRawData_)
+      currentChunkRef_.reset();
+    else
+      freeChunks_->push(currentFile_->chunks_[currentFile_->currentChunk_]);
     if (currentFile_->nEvents_!=currentFile_->nProcessed_)
     {
       throw cms::Exception("FedRawDataInputSource::getNextEvent")
@@ -476,6 +542,11 @@ inline evf::EvFDaqDirector::FileStatus FedRawDataInputSource::getNextEvent()
     //last chunk is released when this function is invoked next time
 
   }
+  //multibuffer mode, FED data referenced in the chunks:
+  else if (useZeroCopyFEDRawData_)
+  {
+    readEventInPlace(headerSize[detectedFRDversion_]);
+  }
   //multibuffer mode:
   else
   {
@@ -625,6 +696,7 @@ void FedRawDataInputSource::read(edm::EventPrincipal& eventPrincipal)
                      daqProvenanceHelper_.dummyProvenance());
 
   eventsThisLumi_++;
+  if (fms_) fms_->reportInputChunkPool(freeChunks_->freeChunks(),freeChunks_->totalChunks());
 
   //this old file check runs no more often than every 10 events
   if (!((currentFile_->nProcessed_-1)%(checkEvery_))) {
@@ -648,7 +720,7 @@ void FedRawDataInputSource::read(edm::EventPrincipal& eventPrincipal)
     }
 
   }
-  if (chunkIsFree_) freeChunks_.push(currentFile_->chunks_[currentFile_->currentChunk_-1]);
+  if (chunkIsFree_) freeChunks_->push(currentFile_->chunks_[currentFile_->currentChunk_-1]);
   chunkIsFree_=false;
   return;
 }
@@ -693,10 +765,17 @@ edm::Timestamp FedRawDataInputSource::fillFEDRawDataCollection(FEDRawDataCollect
       }
     }
     FEDRawData& fedData = rawData.FEDData(fedId);
-    fedData.resize(fedSize);
-    memcpy(fedData.data(), event + eventSize, fedSize);
+    if (eventDataHolder_) {
+      fedData = FEDRawData((unsigned char*)(event + eventSize), fedSize, eventDataHolder_);
+    }
+    else {
+      fedData.resize(fedSize);
+      memcpy(fedData.data(), event + eventSize, fedSize);
+    }
   }
   assert(eventSize == 0);
+  //the event data are now kept alive by the collection only
+  eventDataHolder_.reset();
 
   return tstamp;
 }
@@ -849,7 +928,7 @@ void FedRawDataInputSource::readSupervisor()
 
     //wait for at least one free thread and chunk
     int counter=0;
-    while ((workerPool_.empty() && !singleBufferMode_) || freeChunks_.empty())
+    while ((workerPool_.empty() && !singleBufferMode_) || freeChunks_->empty())
     {
       std::unique_lock<std::mutex> lkw(mWakeup_);
       //sleep until woken up by condition or a timeout
@@ -859,7 +938,7 @@ void FedRawDataInputSource::readSupervisor()
         LogDebug("FedRawDataInputSource") << "No free chunks or threads...";
       }
       else {
-        assert(!(workerPool_.empty() && !singleBufferMode_) || freeChunks_.empty());
+        assert(!(workerPool_.empty() && !singleBufferMode_) || freeChunks_->empty());
       }
       if (quit_threads_.load(std::memory_order_relaxed) || edm::shutdown_flag.load(std::memory_order_relaxed)) {stop=true;break;}
     }
@@ -949,7 +1028,7 @@ void FedRawDataInputSource::readSupervisor()
 	  }
 
 	  InputChunk * newChunk = nullptr;
-	  while (!freeChunks_.try_pop(newChunk)) {
+	  while (!freeChunks_->try_pop(newChunk)) {
             usleep(100000);
             if (quit_threads_.load(std::memory_order_relaxed)) break;
 	  }
@@ -986,7 +1065,7 @@ void FedRawDataInputSource::readSupervisor()
 	//in single-buffer mode put single chunk in the file and let the main thread read the file
 	InputChunk * newChunk;
 	//should be available immediately
-	while(!freeChunks_.try_pop(newChunk)) usleep(100000);
+	while(!freeChunks_->try_pop(newChunk)) usleep(100000);
 
         std::unique_lock<std::mutex> lkw(mWakeup_);
 
@@ -1151,6 +1230,147 @@ inline void InputFile::rewindChunk(const size_t size) {
   bufferPosition_-=size;
 }
 
+//allocate and first touch the chunks from threads bound to each node so the kernel places their pages there
+void FedRawDataInputSource::allocateNumaLocalChunks()
+{
+  const unsigned int nNodes = edm::numa::numberOfNodes();
+  freeChunks_->setNumberOfNodes(nNodes);
+  std::vector<std::vector<InputChunk*>> nodeChunks(nNodes);
+  std::vector<std::thread> allocators;
+  for (unsigned int node=0;node<nNodes;node++) {
+    allocators.emplace_back([this,node,nNodes,&nodeChunks]() {
+      if (!edm::numa::bindToNode(node))
+        edm::LogWarning("FedRawDataInputSource") << "could not bind chunk allocation to NUMA node " << node;
+      for (unsigned int i=node;i<numBuffers_;i+=nNodes) {
+        InputChunk *chunk = new InputChunk(i,eventChunkSize_,node);
+        memset(chunk->buf_,0,chunk->size_);
+        nodeChunks[node].push_back(chunk);
+      }
+    });
+  }
+  for (auto & allocator : allocators) allocator.join();
+  for (auto const& chunks : nodeChunks)
+    for (auto chunk : chunks) freeChunks_->addChunk(chunk);
+
+  edm::LogInfo("FedRawDataInputSource") << "allocated " << numBuffers_ << " chunks on " << nNodes << " NUMA nodes";
+}
+
+InputChunkPool::~InputChunkPool()
+{
+  for (auto queue : queues_) delete queue;
+}
+
+void InputChunkPool::setNumberOfNodes(unsigned int nNodes)
+{
+  assert(totalChunks_==0);
+  for (unsigned int i=queues_.size();i<nNodes;i++)
+    queues_.push_back(new tbb::concurrent_queue<InputChunk*>);
+}
+
+void InputChunkPool::push(InputChunk *chunk)
+{
+  //counted before it can be popped, so that the count never goes below zero
+  freeChunks_++;
+  queues_[chunk->numaNode_ < queues_.size() ? chunk->numaNode_ : 0]->push(chunk);
+}
+
+bool InputChunkPool::try_pop(InputChunk* & chunk)
+{
+  //take a chunk from the preferred node, or from any other one if none is free there
+  const unsigned int nNodes = queues_.size();
+  const unsigned int preferred = preferredNode_.load(std::memory_order_relaxed);
+  for (unsigned int i=0;i<nNodes;i++) {
+    if (queues_[(preferred+i)%nNodes]->try_pop(chunk)) {
+      freeChunks_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+//multi-buffer mode reading without copying the event, unless it spans two chunks
+void FedRawDataInputSource::readEventInPlace(const uint32_t headerSize)
+{
+  InputChunk *chunk = waitForChunkInCurrentFile(currentFile_->currentChunk_);
+  //the previous event ended the chunk, this one starts at the beginning of the next chunk
+  if (currentFile_->chunkPosition_ == chunk->size_) {
+    currentFile_->currentChunk_++;
+    currentFile_->chunkPosition_=0;
+    chunk = waitForChunkInCurrentFile(currentFile_->currentChunk_);
+  }
+  if (currentChunkRef_.get() != chunk) currentChunkRef_ = makeChunkReference(chunk);
+
+  const uint32_t chunkLeft = chunk->size_ - currentFile_->chunkPosition_;
+  unsigned char *dataPosition = chunk->buf_ + currentFile_->chunkPosition_;
+
+  //header at the chunk boundary is assembled from both chunks
+  InputChunk *nextChunk = nullptr;
+  std::vector<unsigned char> splitHeader;
+  if (chunkLeft < headerSize) {
+    nextChunk = waitForChunkInCurrentFile(currentFile_->currentChunk_+1);
+    splitHeader.resize(headerSize);
+    memcpy(&splitHeader[0], dataPosition, chunkLeft);
+    memcpy(&splitHeader[chunkLeft], nextChunk->buf_, headerSize - chunkLeft);
+    event_.reset( new FRDEventMsgView(&splitHeader[0]) );
+  }
+  else
+    event_.reset( new FRDEventMsgView(dataPosition) );
+
+  if (event_->size()>eventChunkSize_) {
+    throw cms::Exception("FedRawDataInputSource::getNextEvent")
+            << " event id:"<< event_->event()<< " lumi:" << event_->lumi()
+            << " run:" << event_->run() << " of size:" << event_->size()
+            << " bytes does not fit into a chunk of size:" << eventChunkSize_ << " bytes";
+  }
+  const uint32_t eventSize = event_->size();
+  if (currentFile_->fileSize_ - currentFile_->bufferPosition_ < eventSize)
+  {
+    throw cms::Exception("FedRawDataInputSource::getNextEvent") <<
+      "Premature end of input file while reading event data";
+  }
+
+  //everything is in a single chunk, reference it
+  if (eventSize <= chunkLeft) {
+    currentFile_->chunkPosition_+=eventSize;
+    currentFile_->bufferPosition_+=eventSize;
+    eventDataHolder_ = currentChunkRef_;
+    return;
+  }
+
+  //copy the event spanning two chunks into a buffer of its own
+  if (!nextChunk) nextChunk = waitForChunkInCurrentFile(currentFile_->currentChunk_+1);
+  std::shared_ptr<unsigned char> eventBuffer(new unsigned char[eventSize], std::default_delete<unsigned char[]>());
+  memcpy(eventBuffer.get(), dataPosition, chunkLeft);
+  memcpy(eventBuffer.get() + chunkLeft, nextChunk->buf_, eventSize - chunkLeft);
+  event_.reset( new FRDEventMsgView(eventBuffer.get()) );
+
+  //the previous chunk is freed once the events referencing it are done
+  currentFile_->currentChunk_++;
+  currentFile_->chunkPosition_=eventSize-chunkLeft;
+  currentFile_->bufferPosition_+=eventSize;
+  currentChunkRef_ = makeChunkReference(nextChunk);
+  eventDataHolder_ = eventBuffer;
+}
+
+InputChunk* FedRawDataInputSource::waitForChunkInCurrentFile(unsigned int chunkIndex)
+{
+  while (!currentFile_->waitForChunk(chunkIndex)) {
+    usleep(10000);
+    if (setExceptionState_) threadError();
+  }
+  return currentFile_->chunks_[chunkIndex];
+}
+
+std::shared_ptr<InputChunk> FedRawDataInputSource::makeChunkReference(InputChunk *chunk)
+{
+  //the last owner (the source or an event product) gives the chunk back to the reader threads,
+  //the pool is shared so that products outliving the source can still do so
+  std::shared_ptr<InputChunkPool> pool = freeChunks_;
+  return std::shared_ptr<InputChunk>(chunk, [pool](InputChunk *c) {
+    pool->push(c);
+  });
+}
+
 //single-buffer mode file reading
 void FedRawDataInputSource::readNextChunkIntoBuffer(InputFile *file)
 {
@@ -1,8 +1,10 @@
 #ifndef EventFilter_Utilities_FedRawDataInputSource_h
 #define EventFilter_Utilities_FedRawDataInputSource_h
 
+#include <atomic>
 #include <memory>
 #include <stdio.h>
+#include <vector>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
@@ -39,6 +41,30 @@ namespace jsoncollector {
 class DataPointDefinition;
 }
 
+//free input chunks, queued per NUMA node of their memory
+class InputChunkPool {
+public:
+  InputChunkPool(): queues_(1,new tbb::concurrent_queue<InputChunk*>), totalChunks_(0), freeChunks_(0), preferredNode_(0) {}
+  ~InputChunkPool();
+
+  void setNumberOfNodes(unsigned int nNodes);
+  void setPreferredNode(unsigned int node) {preferredNode_.store(node,std::memory_order_relaxed);}
+  void addChunk(InputChunk *chunk) {totalChunks_++; push(chunk);}
+
+  void push(InputChunk *chunk);
+  bool try_pop(InputChunk* & chunk);
+  bool empty() const {return freeChunks_.load()==0;}
+
+  unsigned int totalChunks() const {return totalChunks_;}
+  unsigned int freeChunks() const {return freeChunks_.load(std::memory_order_relaxed);}
+
+private:
+  std::vector<tbb::concurrent_queue<InputChunk*>*> queues_;
+  unsigned int totalChunks_;
+  std::atomic<unsigned int> freeChunks_;
+  std::atomic<unsigned int> preferredNode_;
+};
+
 
 class FedRawDataInputSource: public edm::RawInputSource {
 
@@ -75,6 +101,14 @@ private:
   //functions for single buffered reader
   void readNextChunkIntoBuffer(InputFile *file);
 
+  //chunk pool with memory local to the NUMA nodes
+  void allocateNumaLocalChunks();
+
+  //functions for referencing FED data in the input chunks
+  void readEventInPlace(const uint32_t headerSize);
+  InputChunk* waitForChunkInCurrentFile(unsigned int chunkIndex);
+  std::shared_ptr<InputChunk> makeChunkReference(InputChunk *chunk);
+
   //variables
   evf::FastMonitoringService* fms_=nullptr;
   evf::EvFDaqDirector* daqDirector_=nullptr;
@@ -91,6 +125,8 @@ private:
   const bool getLSFromFilename_;
   const bool verifyAdler32_;
   const bool useL1EventID_;
+  bool useZeroCopyFEDRawData_;
+  bool numaLocalChunks_;
   const bool testModeNoBuilderUnit_;
 
   const edm::RunNumber_t runNumber_;
@@ -133,7 +169,10 @@ private:
   tbb::concurrent_queue<unsigned int> workerPool_;
   std::vector<ReaderInfo> workerJob_;
 
-  tbb::concurrent_queue<InputChunk*> freeChunks_;
+  std::shared_ptr<InputChunkPool> freeChunks_ = std::make_shared<InputChunkPool>();
+  //chunk currently read and holder of the current event data in zero-copy mode
+  std::shared_ptr<InputChunk> currentChunkRef_;
+  std::shared_ptr<const void> eventDataHolder_;
   tbb::concurrent_queue<InputFile*> fileQueue_;
 
   std::mutex mReader_;
@@ -175,9 +214,10 @@ struct InputChunk {
   unsigned int index_;
   unsigned int offset_;
   unsigned int fileIndex_;
+  unsigned int numaNode_;
   std::atomic<bool> readComplete_;
 
-  InputChunk(unsigned int index, uint32_t size): size_(size),index_(index) {
+  InputChunk(unsigned int index, uint32_t size, unsigned int numaNode = 0): size_(size),index_(index),numaNode_(numaNode) {
     buf_ = new unsigned char[size_];
     reset(0,0,0);
   }
@@ -12,6 +12,7 @@
 #include "EventFilter/Utilities/interface/DataPointDefinition.h"
 #include "EventFilter/Utilities/interface/DataPoint.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <sys/time.h>
@@ -56,6 +57,7 @@ namespace evf {
     requireTSPSet_(pset.getUntrackedParameter<bool>("requireTransfersPSet",false)),
     selectedTransferMode_(pset.getUntrackedParameter<std::string>("selectedTransferMode","")),
     hltSourceDirectory_(pset.getUntrackedParameter<std::string>("hltSourceDirectory","")),
+    fuLockPollInterval_(std::max(1U,pset.getUntrackedParameter<unsigned int>("fuLockPollInterval",50000))),
     hostname_(""),
     bu_readlock_fd_(-1),
     bu_writelock_fd_(-1),
@@ -241,6 +243,10 @@ namespace evf {
   }
 
   void EvFDaqDirector::postEndRun(edm::GlobalContext const& globalContext) {
+    if (fuLockAcquisitions_)
+      edm::LogInfo("EvFDaqDirector") << "Waited for fu.lock " << fuLockAcquisitions_ << " times -: mean "
+                                     << fuLockWaitTotal_/fuLockAcquisitions_ << " us, max " << fuLockWaitMax_
+                                     << " us, polling every " << fuLockPollInterval_ << " us";
     close(bu_readlock_fd_);
     close(bu_writelock_fd_);
     if (directorBu_) {
@@ -436,13 +442,16 @@ namespace evf {
         //return runEnded;
     }
 
+    timeval ts_lockbegin;
+    gettimeofday(&ts_lockbegin,0);
+
     while (retval==-1) {
       retval = fcntl(fu_readwritelock_fd_, F_SETLK, &fu_rw_flk);
-      if (retval==-1) usleep(50000);
+      if (retval==-1) usleep(fuLockPollInterval_);
       else continue;
 
       lock_attempts++;
-      if (lock_attempts>100 ||  errno==116) {
+      if ((unsigned long long)lock_attempts*fuLockPollInterval_>5000000ULL ||  errno==116) {
         if (errno==116)
           edm::LogWarning("EvFDaqDirector") << "Stale lock file handle. Checking if run directory and fu.lock file are present" << std::endl;
         else
@@ -456,10 +465,14 @@ namespace evf {
     }
     if(retval!=0) return fileStatus;
 
-#ifdef DEBUG
     timeval ts_lockend;
     gettimeofday(&ts_lockend,0);
-#endif
+    long long lock_wait = (ts_lockend.tv_sec - ts_lockbegin.tv_sec)*1000000LL + (ts_lockend.tv_usec - ts_lockbegin.tv_usec);
+    if (lock_wait > 0) {
+      fuLockWaitTotal_ += lock_wait;
+      fuLockWaitMax_ = std::max(fuLockWaitMax_, (unsigned long long)lock_wait);
+    }
+    ++fuLockAcquisitions_;
 
     // if the stream is readable
     if (fu_rw_lock_stream != 0) {
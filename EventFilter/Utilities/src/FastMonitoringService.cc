@@ -40,6 +40,8 @@ namespace evf{
     ,fastMicrostateDefPath_(iPS.getUntrackedParameter<std::string>("fastMicrostateDefPath", microstateDefPath_))
     ,fastName_(iPS.getUntrackedParameter<std::string>("fastName", "fastmoni"))
     ,slowName_(iPS.getUntrackedParameter<std::string>("slowName", "slowmoni"))
+    ,inputChunksFree_(0)
+    ,inputChunksTotal_(0)
     ,totalEventsProcessed_(0)
   {
     reg.watchPreallocate(this, &FastMonitoringService::preallocate);//receiving information on number of threads
@@ -583,6 +585,11 @@ namespace evf{
 	  }
   }
 
+  void FastMonitoringService::reportInputChunkPool(unsigned int freeChunks, unsigned int totalChunks) {
+    inputChunksFree_.store(freeChunks,std::memory_order_relaxed);
+    inputChunksTotal_.store(totalChunks,std::memory_order_relaxed);
+  }
+
   //for the output module
   unsigned int FastMonitoringService::getEventsProcessedForLumi(unsigned int lumi) {
     std::lock_guard<std::mutex> lock(fmt_.monlock_);
@@ -615,6 +622,9 @@ namespace evf{
       if (iti != filesProcessedDuringLumi_.end())
 	fmt_.m_data.fastFilesProcessedJ_ = iti->second;
       else fmt_.m_data.fastFilesProcessedJ_=0;
+
+      fmt_.m_data.fastInputChunksFreeJ_ = inputChunksFree_.load(std::memory_order_relaxed);
+      fmt_.m_data.fastInputChunksTotalJ_ = inputChunksTotal_.load(std::memory_order_relaxed);
     }
     else return;
 
@@ -32,6 +32,8 @@ namespace edm {
 
     virtual std::string const* sourceCacheTempDir() const = 0;
     virtual double const* sourceCacheMinFree() const = 0;
+    virtual std::string const* sourceBlockCacheDir() const = 0;
+    virtual double const* sourceBlockCacheMaxSize() const = 0;
     virtual std::string const* sourceCacheHint() const = 0;
     virtual std::string const* sourceCloneCacheHint() const = 0;
     virtual std::string const* sourceReadHint() const = 0;
@@ -23,7 +23,10 @@ is the DataBlock.
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace edm {
@@ -74,6 +77,13 @@ namespace edm {
                             BranchListIndexes&& branchListIndexes,
                             ProductProvenanceRetriever& provRetriever,
                             DelayedReader* reader = nullptr);
+    //provRetriever is left unchanged, its contents are copied via ProductProvenanceRetriever::deepCopy
+    void fillEventPrincipal(EventAuxiliary const& aux,
+                            ProcessHistoryRegistry const& processHistoryRegistry,
+                            EventSelectionIDVector&& eventSelectionIDs,
+                            BranchListIndexes&& branchListIndexes,
+                            ProductProvenanceRetriever const& provRetriever,
+                            DelayedReader* reader = nullptr);
 
     
     void clearEventPrincipal();
@@ -192,17 +202,28 @@ namespace edm {
     
   private:
 
+    // Modules of the same event may run on several threads so each
+    // thread has its own stack of running unscheduled modules
+    typedef std::vector<std::pair<std::thread::id, std::string>> ModuleLabelsRunning;
+
     class UnscheduledSentry {
     public:
-      UnscheduledSentry(std::vector<std::string>* moduleLabelsRunning, std::string const& moduleLabel) :
-        moduleLabelsRunning_(moduleLabelsRunning) {
-        moduleLabelsRunning_->push_back(moduleLabel);
-      }
+      UnscheduledSentry(ModuleLabelsRunning* moduleLabelsRunning, std::mutex* mutex) :
+        moduleLabelsRunning_(moduleLabelsRunning), mutex_(mutex) {}
       ~UnscheduledSentry() {
-        moduleLabelsRunning_->pop_back();
+        std::lock_guard<std::mutex> guard(*mutex_);
+        auto const thisThread = std::this_thread::get_id();
+        for(auto it = moduleLabelsRunning_->end(); it != moduleLabelsRunning_->begin();) {
+          --it;
+          if(it->first == thisThread) {
+            moduleLabelsRunning_->erase(it);
+            break;
+          }
+        }
       }
     private:
-      std::vector<std::string>* moduleLabelsRunning_;
+      ModuleLabelsRunning* moduleLabelsRunning_;
+      std::mutex* mutex_;
     };
 
     EventAuxiliary aux_;
@@ -215,7 +236,8 @@ namespace edm {
     // Handler for unscheduled modules
     std::shared_ptr<UnscheduledHandler> unscheduledHandler_;
 
-    mutable std::vector<std::string> moduleLabelsRunning_;
+    mutable ModuleLabelsRunning moduleLabelsRunning_;
+    mutable std::mutex moduleLabelsRunningMutex_;
 
     EventSelectionIDVector eventSelectionIDs_;
 
@@ -85,6 +85,9 @@ class EventSetupProvider {
       ///Used when testing that all code properly updates on IOV changes of all Records
       void forceCacheClear();
 
+      ///When set, the data gotten during the previous IOV of a Record are gotten again in eventSetupForInstance
+      void setPrefetchDataAtNewInterval(bool iPrefetch);
+
       void checkESProducerSharing(EventSetupProvider & precedingESProvider,
                                   std::set<ParameterSetIDHolder>& sharingCheckDone,
                                   std::map<EventSetupRecordKey, std::vector<ComponentDescription const*> >& referencedESProducers,
@@ -128,6 +131,7 @@ class EventSetupProvider {
       typedef std::map<EventSetupRecordKey, boost::shared_ptr<EventSetupRecordProvider> > Providers;
       Providers providers_;
       bool mustFinishConfiguration_;
+      bool prefetchDataAtNewInterval_;
       unsigned subProcessIndex_;
 
       // The following are all used only during initialization and then cleared.
@@ -19,6 +19,7 @@
 //
 
 // user include files
+#include "FWCore/Framework/interface/DataKey.h"
 #include "FWCore/Framework/interface/EventSetupRecordKey.h"
 #include "FWCore/Framework/interface/ValidityInterval.h"
 
@@ -96,6 +97,12 @@ class EventSetupRecordProvider {
       
       ///This will clear the cache's of all the Proxies so that next time they are called they will run
       void resetProxies();
+
+      ///When set, the data gotten in an interval are fetched again as soon as the interval changes
+      void setPrefetchDataAtNewInterval(bool iPrefetch) { prefetchDataAtNewInterval_ = iPrefetch; }
+
+      ///Gets the data remembered at the last interval change, if the Record is valid for this time
+      void prefetchData(IOVSyncValue const&);
       
       boost::shared_ptr<EventSetupRecordIntervalFinder> finder() const { return finder_; }
 
@@ -131,6 +138,8 @@ class EventSetupRecordProvider {
       std::vector<boost::shared_ptr<DataProxyProvider> > providers_;
       std::auto_ptr<std::vector<boost::shared_ptr<EventSetupRecordIntervalFinder> > > multipleFinders_;
       bool lastSyncWasBeginOfRun_;
+      bool prefetchDataAtNewInterval_;
+      std::vector<DataKey> keysToPrefetch_;
 };
    }
 }
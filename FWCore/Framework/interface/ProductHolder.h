@@ -16,6 +16,7 @@ a set of related EDProducts. This is the storage unit of such information.
 #include "FWCore/Utilities/interface/ProductHolderIndex.h"
 #include "FWCore/Utilities/interface/TypeID.h"
 
+#include <atomic>
 #include <memory>
 
 #include <string>
@@ -330,17 +331,18 @@ namespace edm {
   class UnscheduledProductHolder : public ProducedProductHolder {
     public:
       explicit UnscheduledProductHolder(std::shared_ptr<BranchDescription const> bd, Principal* principal) :
-        ProducedProductHolder(), productData_(bd), theStatus_(UnscheduledNotRun), principal_(principal) {}
+        ProducedProductHolder(), productData_(bd), theStatus_(UnscheduledNotRun), principal_(principal), ranWithoutPut_(false) {}
       virtual ~UnscheduledProductHolder();
     private:
       virtual void swap_(ProductHolderBase& rhs) override {
         UnscheduledProductHolder& other = dynamic_cast<UnscheduledProductHolder&>(rhs);
         edm::swap(productData_, other.productData_);
         std::swap(theStatus_, other.theStatus_);
+        ranWithoutPut_.store(other.ranWithoutPut_.exchange(ranWithoutPut_.load()));
       }
       virtual ProductData const* resolveProduct_(ResolveStatus& resolveStatus, bool skipCurrentProcess,
                                                  ModuleCallingContext const* mcc) const override;
-      virtual void resetStatus_() override {theStatus_ = UnscheduledNotRun;}
+      virtual void resetStatus_() override {theStatus_ = UnscheduledNotRun; ranWithoutPut_.store(false);}
       virtual bool onDemand_() const override {return status() == UnscheduledNotRun;}
       virtual ProductData const& getProductData() const override {return productData_;}
       virtual ProductData& getProductData() override {return productData_;}
@@ -349,6 +351,9 @@ namespace edm {
       ProductData productData_;
       mutable ProductStatus theStatus_;
       Principal* principal_;
+      // Set once the module has run for this event without putting the
+      // product; several threads may look the product up at the same time.
+      mutable std::atomic<bool> ranWithoutPut_;
   };
 
   // Free swap function
@@ -466,6 +471,8 @@ namespace edm {
       std::vector<ProductHolderIndex> matchingHolders_;
       std::vector<bool> ambiguous_;
       Principal* principal_;
+      // holder found by the first successful lookup this event
+      mutable std::atomic<ProductHolderIndex> resolvedIndex_;
   };
 
   // Free swap function
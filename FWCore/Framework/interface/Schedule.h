@@ -82,6 +82,7 @@
 
 #include "boost/shared_ptr.hpp"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -135,7 +136,9 @@ namespace edm {
     void processOneEvent(unsigned int iStreamID,
                          typename T::MyPrincipal& principal,
                          EventSetup const& eventSetup,
-                         bool cleaningUpAfterException = false);
+                         bool cleaningUpAfterException = false,
+                         std::function<bool()> const& iBeforeEndPaths = std::function<bool()>(),
+                         std::function<void()> const& iConcurrentWithEndPaths = std::function<void()>());
 
     template <typename T>
     void processOneGlobal(typename T::MyPrincipal& principal,
@@ -242,6 +245,10 @@ namespace edm {
     /// inactive.
     bool endPathsEnabled() const;
 
+    /// Return true if the event data can be read by a SubProcess
+    /// while the end paths run.
+    bool endPathsCanRunConcurrently() const;
+
     /// Return the trigger report information on paths,
     /// modules-in-path, modules-in-endpath, and modules.
     void getTriggerReport(TriggerReport& rep) const;
@@ -291,9 +298,11 @@ namespace edm {
   void Schedule::processOneEvent(unsigned int iStreamID,
                                  typename T::MyPrincipal& ep,
                                  EventSetup const& es,
-                                 bool cleaningUpAfterException) {
+                                 bool cleaningUpAfterException,
+                                 std::function<bool()> const& iBeforeEndPaths,
+                                 std::function<void()> const& iConcurrentWithEndPaths) {
     assert(iStreamID<streamSchedules_.size());
-    streamSchedules_[iStreamID]->processOneEvent<T>(ep,es,cleaningUpAfterException);
+    streamSchedules_[iStreamID]->processOneEvent<T>(ep,es,cleaningUpAfterException,iBeforeEndPaths,iConcurrentWithEndPaths);
   }
 
   template <typename T>
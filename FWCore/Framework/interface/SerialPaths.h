@@ -0,0 +1,34 @@
+#ifndef FWCore_Framework_SerialPaths_h
+#define FWCore_Framework_SerialPaths_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     SerialPaths
+//
+/**\function edm::requireSerialPaths SerialPaths.h "FWCore/Framework/interface/SerialPaths.h"
+
+ Description: Lets a Service keep the Paths of an event running one after the other
+
+ Usage:
+    A Service which keeps per stream state between the Path and module signals of an event
+    (e.g. the Path being run) calls requireSerialPaths() in its constructor. The
+    'concurrentPaths' options parameter is then ignored, since the Services are
+    constructed before the Schedule.
+
+*/
+
+// system include files
+#include <string>
+#include <vector>
+
+// user include files
+
+namespace edm {
+
+  void requireSerialPaths(std::string const& iRequester);
+
+  ///the names given to requireSerialPaths
+  std::vector<std::string> serialPathsRequesters();
+}
+
+#endif
@@ -21,6 +21,7 @@
 // system include files
 
 // user include files
+#include <atomic>
 #include <vector>
 #include <mutex>
 #include <memory>
@@ -28,6 +29,13 @@
 // forward declarations
 class testSharedResourcesRegistry;
 namespace edm {
+  ///Time spent by all modules waiting to acquire one shared resource
+  struct SharedResourceWaitTime {
+    std::atomic<unsigned long long> nanoseconds{0};
+    std::atomic<unsigned long long> acquisitions{0};
+    std::atomic<unsigned long long> contended{0};
+  };
+
   class SharedResourcesAcquirer
   {
   public:
@@ -36,6 +44,10 @@ namespace edm {
     SharedResourcesAcquirer() = default;
     explicit SharedResourcesAcquirer(std::vector<std::recursive_mutex*>&& iResources):
     m_resources(iResources){}
+    ///iWaitTimes has one entry per resource, the waits for that resource are added to it
+    SharedResourcesAcquirer(std::vector<std::recursive_mutex*>&& iResources,
+                            std::vector<SharedResourceWaitTime*>&& iWaitTimes):
+    m_resources(iResources), m_waitTimes(iWaitTimes){}
     
     SharedResourcesAcquirer(SharedResourcesAcquirer&&) = default;
     SharedResourcesAcquirer(const SharedResourcesAcquirer&) = default;
@@ -62,6 +74,7 @@ namespace edm {
     
     // ---------- member data --------------------------------
     std::vector<std::recursive_mutex*> m_resources;
+    std::vector<SharedResourceWaitTime*> m_waitTimes;
   };
 }
 
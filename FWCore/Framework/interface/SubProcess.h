@@ -68,6 +68,14 @@ namespace edm {
 
     void doEvent(EventPrincipal const& principal);
 
+    /// Used instead of doEvent when running concurrently with the parent's
+    /// end paths. prepareEvent is called on the parent's thread before its
+    /// end paths start and copies everything this process needs from
+    /// principal. If it returns true, doPreparedEvent must then be called
+    /// and may run on another thread while the parent's end paths run.
+    bool prepareEvent(EventPrincipal const& principal);
+    void doPreparedEvent(EventPrincipal const& principal);
+
     void doBeginRun(RunPrincipal const& principal, IOVSyncValue const& ts);
 
     void doEndRun(RunPrincipal const& principal, IOVSyncValue const& ts, bool cleaningUpAfterException);
@@ -214,13 +222,16 @@ namespace edm {
   private:
      void beginJob();
      void endJob();
-     void process(EventPrincipal const& e);
+     bool selectEvent(EventPrincipal const& e);
+     void fillEvent(EventPrincipal const& e, bool iConcurrentWithParent);
+     void processFilledEvent(EventPrincipal const& e);
      void beginRun(RunPrincipal const& r, IOVSyncValue const& ts);
      void endRun(RunPrincipal const& r, IOVSyncValue const& ts, bool cleaningUpAfterException);
      void beginLuminosityBlock(LuminosityBlockPrincipal const& lb, IOVSyncValue const& ts);
      void endLuminosityBlock(LuminosityBlockPrincipal const& lb, IOVSyncValue const& ts, bool cleaningUpAfterException);
 
     void propagateProducts(BranchType type, Principal const& parentPrincipal, Principal& principal) const;
+    void resolveKeptProducts(EventPrincipal const& parentPrincipal) const;
     void fixBranchIDListsForEDAliases(std::map<BranchID::value_type, BranchID::value_type> const& droppedBranchIDToKeptBranchID);
     void keepThisBranch(BranchDescription const& desc,
                         std::map<BranchID, BranchDescription const*>& trueBranchIDToKeptBranchDesc,
@@ -265,6 +276,7 @@ namespace edm {
 
     //EventSelection
     bool wantAllEvents_;
+    bool concurrentSubProcess_;
     ParameterSetID selector_config_id_;
     mutable detail::TriggerResultsBasedEventSelector selectors_;
 
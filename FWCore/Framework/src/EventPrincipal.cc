@@ -77,6 +77,23 @@ namespace edm {
     fillEventPrincipal(aux,processHistoryRegistry,reader);
   }
 
+  void
+  EventPrincipal::fillEventPrincipal(EventAuxiliary const& aux,
+        ProcessHistoryRegistry const& processHistoryRegistry,
+        EventSelectionIDVector&& eventSelectionIDs,
+        BranchListIndexes&& branchListIndexes,
+        ProductProvenanceRetriever const& provRetriever,
+        DelayedReader* reader) {
+    eventSelectionIDs_ = eventSelectionIDs;
+    provRetrieverPtr_->deepCopy(provRetriever);
+    branchListIndexes_ = branchListIndexes;
+    if(branchIDListHelper_->hasProducedProducts()) {
+      // Add index into BranchIDListRegistry for products produced this process
+      branchListIndexes_.push_back(branchIDListHelper_->producedBranchListIndex());
+    }
+    fillEventPrincipal(aux,processHistoryRegistry,reader);
+  }
+
   void
   EventPrincipal::fillEventPrincipal(EventAuxiliary const& aux,
                                      ProcessHistoryRegistry const& processHistoryRegistry,
@@ -465,10 +482,10 @@ namespace edm {
     // EDProducts modules require and produce.  There is no safe way
     // to recover from this.  Here we check for this problem and throw
     // an exception.
-    std::vector<std::string>::const_iterator i =
-      find_in_all(moduleLabelsRunning_, moduleLabel);
+    std::unique_lock<std::mutex> labelsGuard(moduleLabelsRunningMutex_);
+    ModuleLabelsRunning::value_type const thisModule(std::this_thread::get_id(), moduleLabel);
 
-    if(i != moduleLabelsRunning_.end()) {
+    if(find_in_all(moduleLabelsRunning_, thisModule) != moduleLabelsRunning_.end()) {
       throw Exception(errors::LogicError)
         << "Hit circular dependency while trying to run an unscheduled module.\n"
         << "The last module on the stack shown above requested data from the\n"
@@ -479,7 +496,9 @@ namespace edm {
         << "https://twiki.cern.ch/twiki/bin/view/CMSPublic/SWGuideUnscheduledExecution#Circular_Dependence_Errors.";
     }
 
-    UnscheduledSentry sentry(&moduleLabelsRunning_, moduleLabel);
+    moduleLabelsRunning_.push_back(thisModule);
+    labelsGuard.unlock();
+    UnscheduledSentry sentry(&moduleLabelsRunning_, &moduleLabelsRunningMutex_);
 
     if(unscheduledHandler_) {
       if(mcc == nullptr) {
@@ -26,12 +26,15 @@
 #include "FWCore/Framework/interface/RunPrincipal.h"
 #include "FWCore/Framework/interface/Schedule.h"
 #include "FWCore/Framework/interface/ScheduleInfo.h"
+#include "FWCore/Framework/interface/SharedResourcesAcquirer.h"
 #include "FWCore/Framework/interface/SubProcess.h"
 #include "FWCore/Framework/src/Breakpoints.h"
 #include "FWCore/Framework/src/EPStates.h"
 #include "FWCore/Framework/src/EventSetupsController.h"
 #include "FWCore/Framework/src/InputSourceFactory.h"
+#include "FWCore/Framework/src/SharedResourcesRegistry.h"
 
+#include "FWCore/MessageLogger/interface/JobReport.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
@@ -65,6 +68,7 @@
 #include <exception>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <utility>
 #include <sstream>
 
@@ -246,6 +250,7 @@ namespace edm {
     forceLooperToEnd_(false),
     looperBeginJobRun_(false),
     forceESCacheClearOnNewRun_(false),
+    concurrentSubProcess_(false),
     numberOfForkedChildren_(0),
     numberOfSequentialEventsPerChild_(1),
     setCpuAffinity_(false),
@@ -287,6 +292,7 @@ namespace edm {
     forceLooperToEnd_(false),
     looperBeginJobRun_(false),
     forceESCacheClearOnNewRun_(false),
+    concurrentSubProcess_(false),
     numberOfForkedChildren_(0),
     numberOfSequentialEventsPerChild_(1),
     setCpuAffinity_(false),
@@ -331,6 +337,7 @@ namespace edm {
     forceLooperToEnd_(false),
     looperBeginJobRun_(false),
     forceESCacheClearOnNewRun_(false),
+    concurrentSubProcess_(false),
     numberOfForkedChildren_(0),
     numberOfSequentialEventsPerChild_(1),
     setCpuAffinity_(false),
@@ -371,6 +378,7 @@ namespace edm {
     forceLooperToEnd_(false),
     looperBeginJobRun_(false),
     forceESCacheClearOnNewRun_(false),
+    concurrentSubProcess_(false),
     numberOfForkedChildren_(0),
     numberOfSequentialEventsPerChild_(1),
     setCpuAffinity_(false),
@@ -413,6 +421,13 @@ namespace edm {
     fileMode_ = optionsPset.getUntrackedParameter<std::string>("fileMode", "");
     emptyRunLumiMode_ = optionsPset.getUntrackedParameter<std::string>("emptyRunLumiMode", "");
     forceESCacheClearOnNewRun_ = optionsPset.getUntrackedParameter<bool>("forceEventSetupCacheClearOnNewRun", false);
+    concurrentSubProcess_ = optionsPset.getUntrackedParameter<bool>("concurrentSubProcess", false);
+    // Resources which several copies of the thing they protect can use
+    // e.g. sharedResourceReplicas = cms.untracked.PSet(foo = cms.untracked.uint32(4))
+    ParameterSet const& replicasPset(optionsPset.getUntrackedParameterSet("sharedResourceReplicas", ParameterSet()));
+    for(auto const& resourceName : replicasPset.getParameterNamesForType<unsigned int>(false)) {
+      SharedResourcesRegistry::instance()->setNumberOfReplicas(resourceName, replicasPset.getUntrackedParameter<unsigned int>(resourceName));
+    }
     //threading
     unsigned int nThreads=1;
     if(optionsPset.existsAs<unsigned int>("numberOfThreads",false)) {
@@ -442,6 +457,9 @@ namespace edm {
      */
     unsigned int nConcurrentLumis =1;
     /*
+     The state machine ends a luminosity block before it reads the next one,
+     so numberOfConcurrentLuminosityBlocks stays disabled until it can overlap
+     them. PrincipalCache already keeps one slot per concurrent lumi.
     if(optionsPset.existsAs<unsigned int>("numberOfConcurrentLuminosityBlocks",false)) {
     nConcurrentLumis = optionsPset.getUntrackedParameter<unsigned int>("numberOfConcurrentLuminosityBlocks");
     } else {
@@ -497,6 +515,7 @@ namespace edm {
 
     // intialize the event setup provider
     esp_ = espController_->makeProvider(*parameterSet);
+    esp_->setPrefetchDataAtNewInterval(optionsPset.getUntrackedParameter<bool>("prefetchEventSetupData", false));
 
     // initialize the looper, if any
     looper_ = fillLooper(*espController_, *esp_, *parameterSet);
@@ -624,6 +643,32 @@ namespace edm {
     }
   }
 
+  namespace {
+    // Writes the time the modules waited for each shared resource to the job report
+    void reportSharedResourceWaits() {
+      std::map<std::string, std::string> data;
+      for(auto const& resource : SharedResourcesRegistry::instance()->waitTimes()) {
+        unsigned long long const acquisitions = resource.second->acquisitions.load();
+        if(acquisitions == 0U) {
+          continue;
+        }
+        std::ostringstream waitTime;
+        waitTime << resource.second->nanoseconds.load() * 1.0e-9;
+        data.insert(std::make_pair(resource.first + "-TotalWaitSecs", waitTime.str()));
+        std::ostringstream count;
+        count << acquisitions;
+        data.insert(std::make_pair(resource.first + "-Acquisitions", count.str()));
+        std::ostringstream contended;
+        contended << resource.second->contended.load();
+        data.insert(std::make_pair(resource.first + "-ContendedAcquisitions", contended.str()));
+      }
+      if(!data.empty()) {
+        Service<JobReport> reportSvc;
+        reportSvc->reportPerformanceSummary("SharedResources", data);
+      }
+    }
+  }
+
   void
   EventProcessor::endJob() {
     // Collects exceptions, so we don't throw before all operations are performed.
@@ -649,6 +694,7 @@ namespace edm {
     if(looper_) {
       c.call(std::bind(&EDLooperBase::endOfJob, looper_));
     }
+    c.call([](){ reportSharedResourceWaits(); });
     c.call([actReg](){actReg->postEndJobSignal_();});
     if(c.hasThrown()) {
       c.rethrow();
@@ -1791,7 +1837,7 @@ namespace edm {
   }
 
   int EventProcessor::readLuminosityBlock() {
-    if (principalCache_.hasLumiPrincipal()) {
+    if (!principalCache_.lumiSlotAvailable()) {
       throw edm::Exception(edm::errors::LogicError)
         << "EventProcessor::readRun\n"
         << "Illegal attempt to insert lumi into cache\n"
@@ -1804,7 +1850,7 @@ namespace edm {
         << "Run is invalid\n"
         << "Contact a Framework Developer\n";
     }
-    auto lbp = std::make_shared<LuminosityBlockPrincipal>(input_->luminosityBlockAuxiliary(), preg_, *processConfiguration_, historyAppender_.get(), 0);
+    auto lbp = std::make_shared<LuminosityBlockPrincipal>(input_->luminosityBlockAuxiliary(), preg_, *processConfiguration_, historyAppender_.get(), principalCache_.nextLumiIndex());
     {
       SendSourceTerminationSignalIfException sentry(actReg_.get());
       input_->readLuminosityBlock(*lbp, *historyAppender_);
@@ -2008,9 +2054,15 @@ namespace edm {
     EventSetup const& es = esp_->eventSetup();
     {
       typedef OccurrenceTraits<EventPrincipal, BranchActionStreamBegin> Traits;
-      schedule_->processOneEvent<Traits>(iStreamIndex,*pep, es);
-      if(hasSubProcess()) {
-        subProcess_->doEvent(*pep);
+      if(hasSubProcess() && concurrentSubProcess_ && schedule_->endPathsCanRunConcurrently()) {
+        schedule_->processOneEvent<Traits>(iStreamIndex,*pep, es, false,
+                                           [this, pep]() { return subProcess_->prepareEvent(*pep); },
+                                           [this, pep]() { subProcess_->doPreparedEvent(*pep); });
+      } else {
+        schedule_->processOneEvent<Traits>(iStreamIndex,*pep, es);
+        if(hasSubProcess()) {
+          subProcess_->doEvent(*pep);
+        }
       }
     }
 
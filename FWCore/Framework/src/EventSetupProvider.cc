@@ -49,6 +49,7 @@ EventSetupProvider::EventSetupProvider(unsigned subProcessIndex, const Preferred
 eventSetup_(),
 providers_(),
 mustFinishConfiguration_(true),
+prefetchDataAtNewInterval_(false),
 subProcessIndex_(subProcessIndex),
 preferredProviderInfo_((0!=iInfo) ? (new PreferredProviderInfo(*iInfo)): 0),
 finders_(new std::vector<boost::shared_ptr<EventSetupRecordIntervalFinder> >() ),
@@ -376,6 +377,9 @@ EventSetupProvider::finishConfiguration()
          itProvider->second->setDependentProviders(depProviders);
       }
    }
+   for(auto& recordProvider : providers_) {
+      recordProvider.second->setPrefetchDataAtNewInterval(prefetchDataAtNewInterval_);
+   }
    mustFinishConfiguration_ = false;
 }
 
@@ -430,6 +434,15 @@ EventSetupProvider::forceCacheClear()
    }
 }
 
+void
+EventSetupProvider::setPrefetchDataAtNewInterval(bool iPrefetch)
+{
+   prefetchDataAtNewInterval_ = iPrefetch;
+   for(auto& recordProvider : providers_) {
+      recordProvider.second->setPrefetchDataAtNewInterval(iPrefetch);
+   }
+}
+
 void
 EventSetupProvider::checkESProducerSharing(EventSetupProvider& precedingESProvider,
                                            std::set<ParameterSetIDHolder>& sharingCheckDone,
@@ -741,6 +754,12 @@ EventSetupProvider::eventSetupForInstance(const IOVSyncValue& iValue)
         ++itProvider) {
       itProvider->second->addRecordToIfValid(*this, iValue);
    }   
+   //all Records must be in the EventSetup before any data are gotten
+   if(prefetchDataAtNewInterval_) {
+      for(auto& recordProvider : providers_) {
+         recordProvider.second->prefetchData(iValue);
+      }
+   }
    return eventSetup_;
 }
 
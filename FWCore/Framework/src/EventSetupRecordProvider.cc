@@ -45,7 +45,9 @@ namespace edm {
 EventSetupRecordProvider::EventSetupRecordProvider(const EventSetupRecordKey& iKey) : key_(iKey),
     validityInterval_(), finder_(), providers_(),
     multipleFinders_(new std::vector<boost::shared_ptr<EventSetupRecordIntervalFinder> >()),
-    lastSyncWasBeginOfRun_(true)
+    lastSyncWasBeginOfRun_(true),
+    prefetchDataAtNewInterval_(false),
+    keysToPrefetch_()
 {
 }
 
@@ -213,6 +215,16 @@ EventSetupRecordProvider::setValidityIntervalFor(const IOVSyncValue& iTime)
          returnValue = true;
          //did we actually change?
          if(oldFirst != validityInterval_.first()) {
+            //remember what was used before the Providers forget it
+            if(prefetchDataAtNewInterval_) {
+               std::vector<DataKey> keys;
+               record().fillRegisteredDataKeys(keys);
+               for(auto const& dataKey : keys) {
+                  if(record().wasGotten(dataKey)) {
+                     keysToPrefetch_.push_back(dataKey);
+                  }
+               }
+            }
             //tell all Providers to update
             for(std::vector<boost::shared_ptr<DataProxyProvider> >::iterator itProvider = providers_.begin(),
 	        itProviderEnd = providers_.end();
@@ -240,6 +252,23 @@ EventSetupRecordProvider::resetProxies()
 
 }
 
+void
+EventSetupRecordProvider::prefetchData(const IOVSyncValue& iTime)
+{
+   std::vector<DataKey> keys;
+   keys.swap(keysToPrefetch_);
+   if(!validityInterval_.validFor(iTime)) {
+      return;
+   }
+   for(auto const& dataKey : keys) {
+      try {
+         record().doGet(dataKey);
+      } catch(...) {
+         //the failure is reported again to the module which gets the data
+      }
+   }
+}
+
 void
 EventSetupRecordProvider::getReferencedESProducers(std::map<EventSetupRecordKey, std::vector<ComponentDescription const*> >& referencedESProducers) {
    record().getESProducers(referencedESProducers[key_]);
@@ -10,8 +10,10 @@
 namespace edm {
 
   PrincipalCache::PrincipalCache() :
+    lumiPrincipals_(1U),
+    currentLumi_(0U),
     run_(0U),
-    lumi_(0U) {
+    lumis_(1U, 0U) {
   }
 
   PrincipalCache::~PrincipalCache() { }
@@ -20,6 +22,12 @@ namespace edm {
   void PrincipalCache::setNumberOfConcurrentPrincipals(PreallocationConfiguration const& iConfig)
   {
     eventPrincipals_.resize(iConfig.numberOfStreams());
+    unsigned int nLumis = iConfig.numberOfLuminosityBlocks();
+    if(nLumis == 0U) {
+      nLumis = 1U;
+    }
+    lumiPrincipals_.resize(nLumis);
+    lumis_.resize(nLumis, 0U);
   }
 
   RunPrincipal&
@@ -58,42 +66,81 @@ namespace edm {
     return runPrincipal_;
   }
 
-  LuminosityBlockPrincipal&
-  PrincipalCache::lumiPrincipal(ProcessHistoryID const& phid, RunNumber_t run, LuminosityBlockNumber_t lumi) const {
+  unsigned int
+  PrincipalCache::findLumi(ProcessHistoryID const& phid, RunNumber_t run, LuminosityBlockNumber_t lumi) const {
     if (phid != reducedInputProcessHistoryID_ ||
-        run != run_ ||
-        lumi != lumi_ ||
-        lumiPrincipal_.get() == 0) {
-      throwLumiMissing();
+        run != run_) {
+      return lumiPrincipals_.size();
+    }
+    for(unsigned int i = 0; i < lumiPrincipals_.size(); ++i) {
+      if(lumiPrincipals_[i] && lumis_[i] == lumi) {
+        return i;
+      }
     }
-    return *lumiPrincipal_.get();
+    return lumiPrincipals_.size();
+  }
+
+  LuminosityBlockPrincipal&
+  PrincipalCache::lumiPrincipal(ProcessHistoryID const& phid, RunNumber_t run, LuminosityBlockNumber_t lumi) const {
+    return *lumiPrincipalPtr(phid, run, lumi);
   }
 
   std::shared_ptr<LuminosityBlockPrincipal> const&
   PrincipalCache::lumiPrincipalPtr(ProcessHistoryID const& phid, RunNumber_t run, LuminosityBlockNumber_t lumi) const {
-    if (phid != reducedInputProcessHistoryID_ ||
-        run != run_ ||
-        lumi != lumi_ ||
-        lumiPrincipal_.get() == 0) {
+    unsigned int const index = findLumi(phid, run, lumi);
+    if (index == lumiPrincipals_.size()) {
       throwLumiMissing();
     }
-    return lumiPrincipal_;
+    return lumiPrincipals_[index];
   }
 
   LuminosityBlockPrincipal&
   PrincipalCache::lumiPrincipal() const {
-    if (lumiPrincipal_.get() == 0) {
+    return *lumiPrincipalPtr();
+  }
+
+  std::shared_ptr<LuminosityBlockPrincipal> const&
+  PrincipalCache::lumiPrincipalPtr() const {
+    if (!hasLumiPrincipal()) {
       throwLumiMissing();
     }
-    return *lumiPrincipal_.get();
+    return lumiPrincipals_[currentLumi_];
   }
 
   std::shared_ptr<LuminosityBlockPrincipal> const&
-  PrincipalCache::lumiPrincipalPtr() const {
-    if (lumiPrincipal_.get() == 0) {
+  PrincipalCache::lumiPrincipalPtr(LuminosityBlockIndex const& iIndex) const {
+    unsigned int const index = iIndex.value();
+    if (index >= lumiPrincipals_.size() ||
+        lumiPrincipals_[index].get() == 0) {
       throwLumiMissing();
     }
-    return lumiPrincipal_;
+    return lumiPrincipals_[index];
+  }
+
+  unsigned int
+  PrincipalCache::numberOfLumiPrincipals() const {
+    unsigned int n = 0;
+    for(auto const& lbp : lumiPrincipals_) {
+      if(lbp) {
+        ++n;
+      }
+    }
+    return n;
+  }
+
+  bool
+  PrincipalCache::lumiSlotAvailable() const {
+    return nextLumiIndex() < lumiPrincipals_.size();
+  }
+
+  unsigned int
+  PrincipalCache::nextLumiIndex() const {
+    for(unsigned int i = 0; i < lumiPrincipals_.size(); ++i) {
+      if(!lumiPrincipals_[i]) {
+        return i;
+      }
+    }
+    return lumiPrincipals_.size();
   }
 
   void PrincipalCache::merge(std::shared_ptr<RunAuxiliary> aux, std::shared_ptr<ProductRegistry const> reg) {
@@ -127,7 +174,7 @@ namespace edm {
   }
 
   void PrincipalCache::merge(std::shared_ptr<LuminosityBlockAuxiliary> aux, std::shared_ptr<ProductRegistry const> reg) {
-    if (lumiPrincipal_.get() == 0) {
+    if (!hasLumiPrincipal()) {
       throw edm::Exception(edm::errors::LogicError)
         << "PrincipalCache::merge\n"
         << "Illegal attempt to merge luminosity block into cache\n"
@@ -145,16 +192,17 @@ namespace edm {
       inputProcessHistoryID_ = aux->processHistoryID();
     }
     if (aux->run() != run_ ||
-        aux->luminosityBlock() != lumi_) {
+        aux->luminosityBlock() != lumis_[currentLumi_]) {
       throw edm::Exception(edm::errors::LogicError)
         << "PrincipalCache::merge\n"
         << "Illegal attempt to merge lumi into cache\n"
         << "Run and lumi numbers are inconsistent with the ones already in the cache\n"
         << "Contact a Framework Developer\n";
     }
-    bool lumiOK = lumiPrincipal_->adjustToNewProductRegistry(*reg);
+    std::shared_ptr<LuminosityBlockPrincipal> const& lumiPrincipal = lumiPrincipals_[currentLumi_];
+    bool lumiOK = lumiPrincipal->adjustToNewProductRegistry(*reg);
     assert(lumiOK);
-    lumiPrincipal_->mergeAuxiliary(*aux);
+    lumiPrincipal->mergeAuxiliary(*aux);
   }
 
   void PrincipalCache::insert(std::shared_ptr<RunPrincipal> rp) {
@@ -173,7 +221,9 @@ namespace edm {
   }
 
   void PrincipalCache::insert(std::shared_ptr<LuminosityBlockPrincipal> lbp) {
-    if (lumiPrincipal_.get() != 0) {
+    unsigned int const index = lbp->index().value();
+    if (index >= lumiPrincipals_.size() ||
+        lumiPrincipals_[index].get() != 0) {
       throw edm::Exception(edm::errors::LogicError)
         << "PrincipalCache::insert\n"
         << "Illegal attempt to insert lumi into cache\n"
@@ -203,8 +253,9 @@ namespace edm {
         << "luminosity block inconsistent with run number of run in cache\n"
         << "Contact a Framework Developer\n";
     }
-    lumi_ = lbp->luminosityBlock();
-    lumiPrincipal_ = lbp; 
+    lumis_[index] = lbp->luminosityBlock();
+    lumiPrincipals_[index] = lbp;
+    currentLumi_ = index;
   }
 
   void PrincipalCache::insert(std::shared_ptr<EventPrincipal> ep) {
@@ -233,23 +284,22 @@ namespace edm {
   }
 
   void PrincipalCache::deleteLumi(ProcessHistoryID const& phid, RunNumber_t run, LuminosityBlockNumber_t lumi) {
-    if (lumiPrincipal_.get() == 0) {
+    if (numberOfLumiPrincipals() == 0U) {
       throw edm::Exception(edm::errors::LogicError)
         << "PrincipalCache::deleteLumi\n"
         << "Illegal attempt to delete luminosity block from cache\n"
         << "There is no luminosity block in the cache to delete\n"
         << "Contact a Framework Developer\n";
     }
-    if (reducedInputProcessHistoryID_ != phid ||
-        run != run_ ||
-        lumi != lumi_) {
+    unsigned int const index = findLumi(phid, run, lumi);
+    if (index == lumiPrincipals_.size()) {
       throw edm::Exception(edm::errors::LogicError)
         << "PrincipalCache::deleteLumi\n"
         << "Illegal attempt to delete luminosity block from cache\n"
         << "Run number, lumi numbers, or reduced ProcessHistoryID inconsistent with those in cache\n"
         << "Contact a Framework Developer\n";
     }
-    lumiPrincipal_.reset();
+    lumiPrincipals_[index].reset();
   }
 
   void PrincipalCache::adjustEventsToNewProductRegistry(std::shared_ptr<ProductRegistry const> reg) {
@@ -266,8 +316,10 @@ namespace edm {
     if (runPrincipal_) {
       runPrincipal_->adjustIndexesAfterProductRegistryAddition();
     }
-    if (lumiPrincipal_) {
-      lumiPrincipal_->adjustIndexesAfterProductRegistryAddition();
+    for(auto& lumiPrincipal : lumiPrincipals_) {
+      if (lumiPrincipal) {
+        lumiPrincipal->adjustIndexesAfterProductRegistryAddition();
+      }
     }
   }
 
@@ -17,6 +17,12 @@ The RunPrincipal and LuminosityBlockPrincipal is
 created by the InputSource each time a different
 run or luminosity block is encountered.
 
+Up to numberOfLuminosityBlocks() LuminosityBlockPrincipals
+(from the PreallocationConfiguration) can be held at once.
+Each one occupies the slot given by its LuminosityBlockIndex.
+The accessors without arguments refer to the most recently
+inserted luminosity block.
+
 Performs checks that process history IDs or runs and
 lumis, run numbers, and luminosity numbers are consistent.
 
@@ -27,6 +33,7 @@ Original Author: W. David Dagenhart
 #include "DataFormats/Provenance/interface/ProcessHistoryRegistry.h"
 #include "DataFormats/Provenance/interface/RunID.h"
 #include "DataFormats/Provenance/interface/LuminosityBlockID.h"
+#include "FWCore/Utilities/interface/LuminosityBlockIndex.h"
 
 #include <memory>
 #include <vector>
@@ -58,7 +65,15 @@ namespace edm {
     std::shared_ptr<LuminosityBlockPrincipal> const& lumiPrincipalPtr(ProcessHistoryID const& phid, RunNumber_t run, LuminosityBlockNumber_t lumi) const;
     LuminosityBlockPrincipal& lumiPrincipal() const;
     std::shared_ptr<LuminosityBlockPrincipal> const& lumiPrincipalPtr() const;
-    bool hasLumiPrincipal() const {return bool(lumiPrincipal_);}
+    bool hasLumiPrincipal() const {return currentLumi_ < lumiPrincipals_.size() and bool(lumiPrincipals_[currentLumi_]);}
+    std::shared_ptr<LuminosityBlockPrincipal> const& lumiPrincipalPtr(LuminosityBlockIndex const& iIndex) const;
+
+    // Number of LuminosityBlockPrincipals currently held
+    unsigned int numberOfLumiPrincipals() const;
+    // True if another LuminosityBlockPrincipal can be inserted
+    bool lumiSlotAvailable() const;
+    // Index to use for the next LuminosityBlockPrincipal to be inserted
+    unsigned int nextLumiIndex() const;
 
     EventPrincipal& eventPrincipal(unsigned int iStreamIndex) const { return *(eventPrincipals_[iStreamIndex]); }
 
@@ -83,11 +98,14 @@ namespace edm {
 
     void throwRunMissing() const;
     void throwLumiMissing() const;
+    unsigned int findLumi(ProcessHistoryID const& phid, RunNumber_t run, LuminosityBlockNumber_t lumi) const;
 
     // These are explicitly cleared when finished with the run,
     // lumi, or event
     std::shared_ptr<RunPrincipal> runPrincipal_;
-    std::shared_ptr<LuminosityBlockPrincipal> lumiPrincipal_;
+    std::vector<std::shared_ptr<LuminosityBlockPrincipal>> lumiPrincipals_;
+    // Index into lumiPrincipals_ of the most recently inserted lumi
+    unsigned int currentLumi_;
     std::vector<std::shared_ptr<EventPrincipal>> eventPrincipals_;
 
     // This is just an accessor to the registry owned by the input source. 
@@ -103,7 +121,8 @@ namespace edm {
     ProcessHistoryID inputProcessHistoryID_;
     ProcessHistoryID reducedInputProcessHistoryID_;
     RunNumber_t run_;
-    LuminosityBlockNumber_t lumi_;
+    // Luminosity block numbers of the principals in lumiPrincipals_
+    std::vector<LuminosityBlockNumber_t> lumis_;
   };
 }
 
@@ -42,7 +42,9 @@ namespace edm {
       throwProductDeletedException();
     }
     if(!productUnavailable()) {
-      principal_->readFromSource(*this, mcc);
+      if(!product()) {
+        principal_->readFromSource(*this, mcc);
+      }
       // If the product is a dummy filler, product holder will now be marked unavailable.
       if(product() && !productUnavailable()) {
         // Found the match
@@ -98,11 +100,18 @@ namespace edm {
         resolveStatus = ProductFound;
         return &productData_;
       }
+      // The module already ran for this event without putting the product
+      if(ranWithoutPut_.load(std::memory_order_acquire)) {
+        resolveStatus = ProductNotFound;
+        return nullptr;
+      }
       principal_->unscheduledFill(moduleLabel(), mcc);
       if(product() && product()->isPresent()) {
         resolveStatus = ProductFound;
         return &productData_;
       }
+      // Remember the module ran so later lookups need not look for it again
+      ranWithoutPut_.store(true, std::memory_order_release);
     }
     resolveStatus = ProductNotFound;
     return nullptr;
@@ -384,7 +393,8 @@ namespace edm {
                          Principal* principal) : 
     matchingHolders_(matchingHolders),
     ambiguous_(ambiguous),
-    principal_(principal) {
+    principal_(principal),
+    resolvedIndex_(ProductHolderIndexInvalid) {
     assert(ambiguous_.size() == matchingHolders_.size());
   }
 
@@ -403,7 +413,14 @@ namespace edm {
   ProductData const* NoProcessProductHolder::resolveProduct_(ResolveStatus& resolveStatus,
                                                              bool skipCurrentProcess,
                                                              ModuleCallingContext const* mcc) const {
+    if(!skipCurrentProcess) {
+      ProductHolderIndex resolved = resolvedIndex_.load(std::memory_order_acquire);
+      if(resolved != ProductHolderIndexInvalid) {
+        return principal_->getProductHolderByIndex(resolved)->resolveProduct(resolveStatus, false, mcc);
+      }
+    }
     std::vector<unsigned int> const& lookupProcessOrder = principal_->lookupProcessOrder();
+    bool firstMatch = true;
     for(unsigned int k : lookupProcessOrder) {
       assert(k < ambiguous_.size());
       if(k == 0) break; // Done
@@ -414,7 +431,16 @@ namespace edm {
       if (matchingHolders_[k] != ProductHolderIndexInvalid) {
         ProductHolderBase const* productHolder = principal_->getProductHolderByIndex(matchingHolders_[k]);
         ProductData const* pd =  productHolder->resolveProduct(resolveStatus, skipCurrentProcess, mcc);
-        if(pd != nullptr) return pd;
+        if(pd != nullptr) {
+          // Only the most recent process holding a match can never be
+          // superseded later in the event, so only that one is remembered.
+          // Concurrent first fetches all store the same value.
+          if(firstMatch && !skipCurrentProcess) {
+            resolvedIndex_.store(matchingHolders_[k], std::memory_order_release);
+          }
+          return pd;
+        }
+        firstMatch = false;
       }
     }
     resolveStatus = ProductNotFound;
@@ -452,9 +478,11 @@ namespace edm {
     ambiguous_.swap(other.ambiguous_);
     matchingHolders_.swap(other.matchingHolders_);
     std::swap(principal_, other.principal_);
+    resolvedIndex_.store(other.resolvedIndex_.exchange(resolvedIndex_.load()));
   }
 
   void NoProcessProductHolder::resetStatus_() {
+    resolvedIndex_.store(ProductHolderIndexInvalid);
   }
 
   void NoProcessProductHolder::setProvenance_(std::shared_ptr<ProductProvenanceRetriever> , ProcessHistory const& , ProductID const& ) {
@@ -468,6 +496,7 @@ namespace edm {
   }
 
   void NoProcessProductHolder::resetProductData_() {
+    resolvedIndex_.store(ProductHolderIndexInvalid);
   }
 
   bool NoProcessProductHolder::singleProduct_() const {
@@ -1035,6 +1035,12 @@ namespace edm {
   Schedule::endPathsEnabled() const {
     return endpathsAreActive_;
   }
+
+  bool
+  Schedule::endPathsCanRunConcurrently() const {
+    //all streams are configured the same way
+    return streamSchedules_[0]->endPathsCanRunConcurrently();
+  }
                           
   void
   Schedule::getTriggerReport(TriggerReport& rep) const {
@@ -0,0 +1,29 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     SerialPaths
+//
+
+// system include files
+#include <mutex>
+
+// user include files
+#include "FWCore/Framework/interface/SerialPaths.h"
+
+namespace {
+  std::mutex s_mutex;
+  std::vector<std::string> s_requesters;
+}
+
+namespace edm {
+
+  void requireSerialPaths(std::string const& iRequester) {
+    std::lock_guard<std::mutex> guard(s_mutex);
+    s_requesters.push_back(iRequester);
+  }
+
+  std::vector<std::string> serialPathsRequesters() {
+    std::lock_guard<std::mutex> guard(s_mutex);
+    return s_requesters;
+  }
+}
@@ -11,6 +11,7 @@
 //
 
 // system include files
+#include <chrono>
 
 // user include files
 #include "FWCore/Framework/interface/SharedResourcesAcquirer.h"
@@ -18,8 +19,24 @@
 
 namespace edm {
   void SharedResourcesAcquirer::lock() {
-    for(auto m : m_resources) {
-      m->lock();
+    if(m_waitTimes.empty()) {
+      for(auto m : m_resources) {
+        m->lock();
+      }
+      return;
+    }
+    for(size_t i = 0; i < m_resources.size(); ++i) {
+      auto m = m_resources[i];
+      SharedResourceWaitTime* waitTime = m_waitTimes[i];
+      // only time the lock when another module holds the resource
+      if(not m->try_lock()) {
+        auto const start = std::chrono::steady_clock::now();
+        m->lock();
+        waitTime->nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+                                        std::memory_order_relaxed);
+        waitTime->contended.fetch_add(1U, std::memory_order_relaxed);
+      }
+      waitTime->acquisitions.fetch_add(1U, std::memory_order_relaxed);
     }
   }
   
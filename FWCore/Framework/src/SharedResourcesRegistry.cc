@@ -17,6 +17,9 @@
 // user include files
 #include "SharedResourcesRegistry.h"
 #include "FWCore/Framework/interface/SharedResourcesAcquirer.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <tuple>
 
 namespace edm {
 
@@ -35,6 +38,10 @@ namespace edm {
   SharedResourcesRegistry::registerSharedResource(const std::string& resourceName){
 
     auto& mutexAndCounter = resourceMap_[resourceName];
+    auto& waitTime = waitTimes_[resourceName];
+    if(!waitTime) {
+      waitTime = std::make_shared<SharedResourceWaitTime>();
+    }
 
     if(resourceName == kLegacyModuleResourceName) {
       ++nLegacy_;
@@ -64,6 +71,26 @@ namespace edm {
     }
   }
 
+  void
+  SharedResourcesRegistry::setNumberOfReplicas(std::string const& resourceName, unsigned int nReplicas) {
+    if(resourceName == kLegacyModuleResourceName || nReplicas == 0U) {
+      throw Exception(errors::Configuration)
+        << "The shared resource '" << resourceName << "' cannot have " << nReplicas << " replicas.\n"
+        << "The legacy resource must have exactly one and other resources at least one.\n";
+    }
+    auto& replicas = extraReplicas_[resourceName];
+    replicas.clear();
+    for(unsigned int i = 1; i < nReplicas; ++i) {
+      replicas.push_back(std::make_shared<std::recursive_mutex>());
+    }
+  }
+
+  unsigned int
+  SharedResourcesRegistry::numberOfReplicas(std::string const& resourceName) const {
+    auto itFound = extraReplicas_.find(resourceName);
+    return itFound == extraReplicas_.end() ? 1U : itFound->second.size() + 1U;
+  }
+
   SharedResourcesAcquirer
   SharedResourcesRegistry::createAcquirerForSourceDelayedReader() {
     if(not resourceForDelayedReader_) {
@@ -88,9 +115,12 @@ namespace edm {
     // one modules that call usesResource with no argument in the
     // same way.
 
-    // Sort by how often used and then by name
+    // A resource with replicas is a set of independent mutexes. Each module
+    // is given one of them in turn while legacy modules take all of them.
+
+    // Sort by how often used, then by name and then by replica
     // Consistent sorting avoids deadlocks and this particular order optimizes performance
-    std::map<std::pair<unsigned int, std::string>, std::recursive_mutex*> sortedResources;
+    std::map<std::tuple<unsigned int, std::string, unsigned int>, std::pair<std::recursive_mutex*, SharedResourceWaitTime*>> sortedResources;
 
     // Is this acquirer for a module that depends on the legacy shared resource?
     if(std::find(resourceNames.begin(), resourceNames.end(), kLegacyModuleResourceName) != resourceNames.end()) {
@@ -102,7 +132,16 @@ namespace edm {
         if(resource.first == kLegacyModuleResourceName && resourceMap_.size() > 1) continue;
         //If only one module wants it, it really isn't shared
         if(resource.second.second > 1) {
-          sortedResources.insert(std::make_pair(std::make_pair(resource.second.second, resource.first),resource.second.first.get()));
+          SharedResourceWaitTime* waitTime = waitTimes_.at(resource.first).get();
+          sortedResources.insert(std::make_pair(std::make_tuple(resource.second.second, resource.first, 0U),
+                                                std::make_pair(resource.second.first.get(), waitTime)));
+          auto itReplicas = extraReplicas_.find(resource.first);
+          if(itReplicas != extraReplicas_.end()) {
+            for(unsigned int i = 0; i < itReplicas->second.size(); ++i) {
+              sortedResources.insert(std::make_pair(std::make_tuple(resource.second.second, resource.first, i+1),
+                                                    std::make_pair(itReplicas->second[i].get(), waitTime)));
+            }
+          }
         }
       }
     // Handle cases where the module does not declare the legacy resource
@@ -112,16 +151,30 @@ namespace edm {
         assert(resource != resourceMap_.end());
         //If only one module wants it, it really isn't shared
         if(resource->second.second > 1) {
-          sortedResources.insert(std::make_pair(std::make_pair(resource->second.second, resource->first),resource->second.first.get()));
+          SharedResourceWaitTime* waitTime = waitTimes_.at(resource->first).get();
+          unsigned int replica = 0;
+          std::recursive_mutex* mutex = resource->second.first.get();
+          auto itReplicas = extraReplicas_.find(name);
+          if(itReplicas != extraReplicas_.end() and not itReplicas->second.empty()) {
+            replica = nextReplica_[name]++ % (itReplicas->second.size() + 1);
+            if(replica != 0) {
+              mutex = itReplicas->second[replica-1].get();
+            }
+          }
+          sortedResources.insert(std::make_pair(std::make_tuple(resource->second.second, resource->first, replica),
+                                                std::make_pair(mutex, waitTime)));
         }
       }
     }
 
     std::vector<std::recursive_mutex*> mutexes;
+    std::vector<SharedResourceWaitTime*> waitTimes;
     mutexes.reserve(sortedResources.size());
+    waitTimes.reserve(sortedResources.size());
     for(auto const& resource: sortedResources) {
-      mutexes.push_back(resource.second);
+      mutexes.push_back(resource.second.first);
+      waitTimes.push_back(resource.second.second);
     }
-    return SharedResourcesAcquirer(std::move(mutexes));
+    return SharedResourcesAcquirer(std::move(mutexes), std::move(waitTimes));
   }
 }
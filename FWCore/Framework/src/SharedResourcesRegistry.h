@@ -32,6 +32,7 @@ class testSharedResourcesRegistry;
 
 namespace edm {
   class SharedResourcesAcquirer;
+  struct SharedResourceWaitTime;
   
   class SharedResourcesRegistry
   {
@@ -46,6 +47,9 @@ namespace edm {
     SharedResourcesAcquirer createAcquirerForSourceDelayedReader();
     // ---------- static member functions --------------------
     static SharedResourcesRegistry* instance();
+
+    ///True if any module has registered a shared resource (including legacy modules)
+    bool hasModuleSharedResources() const { return !resourceMap_.empty(); }
     
     ///All legacy modules share this resource
     static const std::string kLegacyModuleResourceName;
@@ -54,6 +58,16 @@ namespace edm {
     ///A resource name must be registered before it can be used in the createAcquirer call
     void registerSharedResource(const std::string&);
 
+    ///The modules using the resource are split between iNumberOfReplicas independent
+    /// copies of it, so up to that many of them can run at the same time.
+    /// Must be called before any acquirer is created.
+    void setNumberOfReplicas(std::string const& iResourceName, unsigned int iNumberOfReplicas);
+
+    unsigned int numberOfReplicas(std::string const& iResourceName) const;
+
+    ///The time spent waiting for each resource, summed over all its replicas
+    std::map<std::string, std::shared_ptr<SharedResourceWaitTime>> const& waitTimes() const { return waitTimes_; }
+
 #ifdef SHAREDRESOURCETESTACCESSORS
     // The next function is intended to be used only in a unit test
     std::map<std::string, std::pair<std::shared_ptr<std::recursive_mutex>,unsigned int>> const& resourceMap() const { return resourceMap_; }
@@ -72,6 +86,13 @@ namespace edm {
     
     std::shared_ptr<std::recursive_mutex> resourceForDelayedReader_;
 
+    //the replicas beyond the first, which is the mutex held in resourceMap_
+    std::map<std::string, std::vector<std::shared_ptr<std::recursive_mutex>>> extraReplicas_;
+    //the replica the next module using the resource is given
+    mutable std::map<std::string, unsigned int> nextReplica_;
+
+    std::map<std::string, std::shared_ptr<SharedResourceWaitTime>> waitTimes_;
+
     unsigned int nLegacy_;
   };
 }
@@ -4,6 +4,7 @@
 #include "DataFormats/Provenance/interface/ProcessConfiguration.h"
 #include "DataFormats/Provenance/interface/ProductRegistry.h"
 #include "FWCore/Framework/interface/OutputModuleDescription.h"
+#include "FWCore/Framework/interface/SerialPaths.h"
 #include "FWCore/Framework/interface/TriggerNamesService.h"
 #include "FWCore/Framework/interface/TriggerReport.h"
 #include "FWCore/Framework/interface/TriggerTimingReport.h"
@@ -14,28 +15,59 @@
 #include "FWCore/Framework/src/ModuleHolder.h"
 #include "FWCore/Framework/src/WorkerT.h"
 #include "FWCore/Framework/src/ModuleRegistry.h"
+#include "FWCore/Framework/src/SharedResourcesRegistry.h"
+#include "FWCore/Framework/src/TaskIsolation.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ParameterSet/interface/Registry.h"
 #include "FWCore/ServiceRegistry/interface/PathContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
 #include "FWCore/Utilities/interface/ConvertException.h"
 #include "FWCore/Utilities/interface/ExceptionCollector.h"
 #include "FWCore/Utilities/interface/DictionaryTools.h"
 
+#include "tbb/task.h"
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <functional>
 #include <iomanip>
 #include <list>
 #include <map>
+#include <set>
 #include <exception>
 
 namespace edm {
   namespace {
 
+    class ConcurrentWorkTask : public tbb::task {
+    public:
+      ConcurrentWorkTask(std::function<void()> const& iWork,
+                         ServiceToken const& iToken,
+                         std::exception_ptr* iException) :
+        work_(iWork),
+        token_(iToken),
+        exception_(iException) {}
+
+      tbb::task* execute() override {
+        try {
+          ServiceRegistry::Operate operate(token_);
+          work_();
+        } catch(...) {
+          *exception_ = std::current_exception();
+        }
+        return nullptr;
+      }
+    private:
+      std::function<void()> const& work_;
+      ServiceToken token_;
+      std::exception_ptr* exception_;
+    };
+
     // Function template to transform each element in the input range to
     // a value placed into the output range. The supplied function
     // should take a const_reference to the 'input', and write to a
@@ -78,10 +110,31 @@ namespace edm {
       return ptr;
     }
 
+    // Could a module consuming with iInfo get the product iDesc? When in doubt
+    // answer yes since that only keeps the product around longer.
+    bool
+    mightConsume(ConsumesInfo const& iInfo, BranchDescription const& iDesc) {
+      if(iInfo.kindOfType() == PRODUCT_TYPE and iInfo.type() != iDesc.unwrappedTypeID()) {
+        return false;
+      }
+      if(iInfo.skipCurrentProcess() and iDesc.produced()) {
+        return false;
+      }
+      if(iInfo.label().empty()) {
+        //consumesMany
+        return true;
+      }
+      return iInfo.label() == iDesc.moduleLabel() and
+             iInfo.instance() == iDesc.productInstanceName() and
+             (iInfo.process().empty() or iInfo.process() == iDesc.processName());
+    }
+
     void
     initializeBranchToReadingWorker(ParameterSet const& opts,
                                     ProductRegistry const& preg,
-                                    std::multimap<std::string,Worker*>& branchToReadingWorker)
+                                    std::multimap<std::string,Worker*>& branchToReadingWorker,
+                                    std::map<std::string, BranchDescription const*>& branchesFromConsumes,
+                                    std::set<std::string>& autoDeleteBranches)
     {
       // See if any data has been marked to be deleted early (removing any duplicates)
       auto vBranchesToDeleteEarly = opts.getUntrackedParameter<std::vector<std::string>>("canDeleteEarly",std::vector<std::string>());
@@ -121,6 +174,27 @@ namespace edm {
           branchToReadingWorker.insert(std::make_pair(branch, static_cast<Worker*>(nullptr)));
         }
       }
+
+      // With 'autoDeleteEarly' every event product made in this process is
+      // deleted once all the modules which consume it have run, and the
+      // consumes calls are used to find the readers of all the candidates.
+      if(opts.getUntrackedParameter<bool>("autoDeleteEarly",false)) {
+        for(auto const& prod: preg.productList()) {
+          BranchDescription const& desc = prod.second;
+          if(desc.branchType() != InEvent) {
+            continue;
+          }
+          std::string name = desc.branchName();
+          name.resize(name.size()-1);
+          if(desc.produced() and not desc.isAlias() and branchToReadingWorker.find(name) == branchToReadingWorker.end()) {
+            branchToReadingWorker.insert(std::make_pair(name, static_cast<Worker*>(nullptr)));
+            autoDeleteBranches.insert(name);
+          }
+          if(branchToReadingWorker.find(name) != branchToReadingWorker.end()) {
+            branchesFromConsumes.insert(std::make_pair(name, &desc));
+          }
+        }
+      }
     }
   }
 
@@ -154,6 +228,8 @@ namespace edm {
     total_events_(),
     total_passed_(),
     number_of_unscheduled_modules_(0),
+    endPathsCanRunConcurrently_(false),
+    concurrentPaths_(false),
     streamID_(streamID),
     streamContext_(streamID_, processContext),
     endpathsAreActive_(true) {
@@ -240,6 +316,59 @@ namespace edm {
 
 
     initializeEarlyDelete(*modReg, opts,preg,allowEarlyDelete);
+
+    if(opts.getUntrackedParameter<bool>("concurrentPrefetching", false)) {
+      // A module holding a shared resource could wait on an on-demand module
+      // being run by another prefetch task which needs that same resource
+      if(not taskIsolationAvailable()) {
+        LogInfo("ConcurrentPrefetching")
+          << "The options parameter 'concurrentPrefetching' is ignored because this TBB version cannot isolate the waits for the prefetch tasks.\n";
+      } else if(SharedResourcesRegistry::instance()->hasModuleSharedResources()) {
+        LogInfo("ConcurrentPrefetching")
+          << "The options parameter 'concurrentPrefetching' is ignored because some modules use shared resources (e.g. legacy modules).\n";
+      } else {
+        for (auto worker : allWorkers()) {
+          worker->setConcurrentPrefetching(true);
+        }
+      }
+    }
+
+    if(opts.getUntrackedParameter<bool>("concurrentPaths", false)) {
+      std::vector<std::string> const serialPathsServices = serialPathsRequesters();
+      // Deleting products early relies on the modules running in path order
+      if(not earlyDeleteHelpers_.empty()) {
+        LogInfo("ConcurrentPaths")
+          << "The options parameter 'concurrentPaths' is ignored because some products are deleted early.\n";
+      } else if(not taskIsolationAvailable()) {
+        LogInfo("ConcurrentPaths")
+          << "The options parameter 'concurrentPaths' is ignored because this TBB version cannot isolate the waits of the modules.\n";
+      } else if(SharedResourcesRegistry::instance()->hasModuleSharedResources()) {
+        // Two Paths could each hold one of the resources a module of the other needs
+        LogInfo("ConcurrentPaths")
+          << "The options parameter 'concurrentPaths' is ignored because some modules use shared resources (e.g. legacy modules).\n";
+      } else if(not serialPathsServices.empty()) {
+        LogInfo("ConcurrentPaths")
+          << "The options parameter 'concurrentPaths' is ignored because the Service " << serialPathsServices.front()
+          << " requires the Paths of an event to run one after the other.\n";
+      } else {
+        concurrentPaths_ = true;
+        for (auto worker : allWorkers()) {
+          worker->setConcurrentPaths(true);
+        }
+      }
+    }
+
+    // Data may only be read from the event while the end paths run if no
+    // module on them (or run on demand from them) can put anything into it
+    endPathsCanRunConcurrently_ = (number_of_unscheduled_modules_ == 0);
+    for (auto const& path : end_paths_) {
+      for (Path::size_type i = 0; i < path.size(); ++i) {
+        Worker::Types type = path.getWorker(i)->moduleType();
+        if (type == Worker::kProducer or type == Worker::kFilter) {
+          endPathsCanRunConcurrently_ = false;
+        }
+      }
+    }
     
   } // StreamSchedule::StreamSchedule
 
@@ -254,7 +383,9 @@ namespace edm {
     //see if 'canDeleteEarly' was set and if so setup the list with those products actually
     // registered for this job
     std::multimap<std::string,Worker*> branchToReadingWorker;
-    initializeBranchToReadingWorker(opts,preg,branchToReadingWorker);
+    std::map<std::string, BranchDescription const*> branchesFromConsumes;
+    std::set<std::string> autoDeleteBranches;
+    initializeBranchToReadingWorker(opts,preg,branchToReadingWorker,branchesFromConsumes,autoDeleteBranches);
     
     //If no delete early items have been specified we don't have to do anything
     if(branchToReadingWorker.size()==0) {
@@ -267,7 +398,7 @@ namespace edm {
     unsigned int nUniqueBranchesToDelete=branchToReadingWorker.size();
     
     //talk with output modules first
-    modReg.forAllModuleHolders([this, &branchToReadingWorker,&nUniqueBranchesToDelete](maker::ModuleHolder* iHolder){
+    modReg.forAllModuleHolders([this, &branchToReadingWorker,&branchesFromConsumes,&nUniqueBranchesToDelete](maker::ModuleHolder* iHolder){
       auto comm = iHolder->createOutputModuleCommunicator();
       if (comm) {
         if(branchToReadingWorker.size()>0) {
@@ -275,10 +406,14 @@ namespace edm {
           // so we should remove it from our list
           SelectedProductsForBranchType const&kept = comm->keptProducts();
           for( auto const& item: kept[InEvent]) {
-            auto found = branchToReadingWorker.equal_range(item->branchName());
+            //the branch names end with a period which is not in our list
+            std::string name = item->branchName();
+            name.resize(name.size()-1);
+            auto found = branchToReadingWorker.equal_range(name);
             if(found.first !=found.second) {
               --nUniqueBranchesToDelete;
               branchToReadingWorker.erase(found.first,found.second);
+              branchesFromConsumes.erase(name);
             }
           }
         }
@@ -293,7 +428,20 @@ namespace edm {
       //determine if this module could read a branch we want to delete early
       auto pset = pset::Registry::instance()->getMapped(w->description().parameterSetID());
       if(0!=pset) {
-        auto branches = pset->getUntrackedParameter<std::vector<std::string>>("mightGet",kEmpty);
+        auto const& mightGet = pset->getUntrackedParameter<std::vector<std::string>>("mightGet",kEmpty);
+        std::set<std::string> branches(mightGet.begin(),mightGet.end());
+        if(not branchesFromConsumes.empty()) {
+          for(auto const& info: w->consumesInfo()) {
+            if(info.branchType() != InEvent) {
+              continue;
+            }
+            for(auto const& candidate: branchesFromConsumes) {
+              if(mightConsume(info, *candidate.second)) {
+                branches.insert(candidate.first);
+              }
+            }
+          }
+        }
         if(not branches.empty()) {
           ++upperLimitOnReadingWorker;
         }
@@ -316,7 +464,10 @@ namespace edm {
       std::vector<std::string> unusedBranches;
       while(it !=branchToReadingWorker.end()) {
         if(it->second == nullptr) {
-          unusedBranches.push_back(it->first);
+          //products nobody consumes are only worth a warning if explicitly requested
+          if(autoDeleteBranches.find(it->first) == autoDeleteBranches.end()) {
+            unusedBranches.push_back(it->first);
+          }
           //erasing the object invalidates the iterator so must advance it first
           auto temp = it;
           ++it;
@@ -512,6 +663,33 @@ namespace edm {
     workerManager_.endStream(streamID_, streamContext_);
   }
 
+  void StreamSchedule::runConcurrently(std::vector<std::function<void()>> const& iWork) const {
+    std::vector<std::exception_ptr> exceptions(iWork.size());
+    ServiceToken token = ServiceRegistry::instance().presentToken();
+
+    tbb::task* waitTask{new (tbb::task::allocate_root()) tbb::empty_task{}};
+    waitTask->set_ref_count(iWork.size());
+    for(unsigned int i = 1; i < iWork.size(); ++i) {
+      tbb::task::spawn(*(new (waitTask->allocate_child()) ConcurrentWorkTask{iWork[i], token, &exceptions[i]}));
+    }
+    //the calling thread does the first one itself
+    try {
+      iWork[0]();
+    } catch(...) {
+      exceptions[0] = std::current_exception();
+    }
+    //always wait since the tasks refer to data owned by the caller
+    waitTask->wait_for_all();
+    tbb::task::destroy(*waitTask);
+
+    for(auto const& exception : exceptions) {
+      if(exception) {
+        std::rethrow_exception(exception);
+      }
+    }
+  }
+
+
   void StreamSchedule::replaceModule(maker::ModuleHolder* iMod,
                                     std::string const& iLabel) {
     Worker* found = nullptr;
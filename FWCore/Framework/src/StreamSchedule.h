@@ -82,6 +82,7 @@
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/StreamID.h"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -165,10 +166,16 @@ namespace edm {
     
     StreamSchedule(StreamSchedule const&) = delete;
 
+    /// If iBeforeEndPaths is set it is called on this thread once the
+    /// TriggerResults are in the event. If it returns true,
+    /// iConcurrentWithEndPaths is then called on another thread while the
+    /// end paths run, see endPathsCanRunConcurrently().
     template <typename T>
     void processOneEvent(typename T::MyPrincipal& principal,
                          EventSetup const& eventSetup,
-                         bool cleaningUpAfterException = false);
+                         bool cleaningUpAfterException = false,
+                         std::function<bool()> const& iBeforeEndPaths = std::function<bool()>(),
+                         std::function<void()> const& iConcurrentWithEndPaths = std::function<void()>());
 
     template <typename T>
     void processOneStream(typename T::MyPrincipal& principal,
@@ -256,6 +263,12 @@ namespace edm {
     unsigned int numberOfUnscheduledModules() const {
       return number_of_unscheduled_modules_;
     }
+
+    /// True if nothing on the end paths puts data into the event, so the
+    /// products can be read from another thread while the end paths run.
+    bool endPathsCanRunConcurrently() const {
+      return endPathsCanRunConcurrently_;
+    }
     
   private:
     //Sentry class to only send a signal if an
@@ -294,8 +307,15 @@ namespace edm {
     template <typename T>
     void runEndPaths(typename T::MyPrincipal&, EventSetup const&, typename T::Context const*);
 
+    template <typename T>
+    void runPathsConcurrently(TrigPaths&, typename T::MyPrincipal&, EventSetup const&, typename T::Context const*);
+
     void reportSkipped(EventPrincipal const& ep) const;
 
+    /// runs the first item on the calling thread and the others as separate tasks,
+    /// then rethrows the exception of the first item which failed
+    void runConcurrently(std::vector<std::function<void()>> const& iWork) const;
+
     void fillWorkers(ParameterSet& proc_pset,
                      ProductRegistry& preg,
                      PreallocationConfiguration const* prealloc,
@@ -354,6 +374,8 @@ namespace edm {
     int                            total_events_;
     int                            total_passed_;
     unsigned int                   number_of_unscheduled_modules_;
+    bool                           endPathsCanRunConcurrently_;
+    bool                           concurrentPaths_;
     
     StreamID                streamID_;
     StreamContext           streamContext_;
@@ -370,7 +392,9 @@ namespace edm {
   template <typename T>
   void StreamSchedule::processOneEvent(typename T::MyPrincipal& ep,
                                  EventSetup const& es,
-                                 bool cleaningUpAfterException) {
+                                 bool cleaningUpAfterException,
+                                 std::function<bool()> const& iBeforeEndPaths,
+                                 std::function<void()> const& iConcurrentWithEndPaths) {
     this->resetAll();
     for (int empty_trig_path : empty_trig_paths_) {
       results_->at(empty_trig_path) = HLTPathStatus(hlt::Pass, 0);
@@ -416,7 +440,12 @@ namespace edm {
           throw;
         }
 
-        if (endpathsAreActive_) runEndPaths<T>(ep, es, &streamContext_);
+        if (iBeforeEndPaths && iBeforeEndPaths()) {
+          runConcurrently({[&]() { if (endpathsAreActive_) runEndPaths<T>(ep, es, &streamContext_); },
+                           iConcurrentWithEndPaths});
+        } else if (endpathsAreActive_) {
+          runEndPaths<T>(ep, es, &streamContext_);
+        }
         resetEarlyDelete();
       });
     }
@@ -472,8 +501,12 @@ namespace edm {
   template <typename T>
   bool
   StreamSchedule::runTriggerPaths(typename T::MyPrincipal& ep, EventSetup const& es, typename T::Context const* context) {
-    for(auto& p : trig_paths_) {
-      p.processOneOccurrence<T>(ep, es, streamID_, context);
+    if (T::isEvent_ && concurrentPaths_ && trig_paths_.size() > 1) {
+      runPathsConcurrently<T>(trig_paths_, ep, es, context);
+    } else {
+      for(auto& p : trig_paths_) {
+        p.processOneOccurrence<T>(ep, es, streamID_, context);
+      }
     }
     return results_->accept();
   }
@@ -483,9 +516,24 @@ namespace edm {
   StreamSchedule::runEndPaths(typename T::MyPrincipal& ep, EventSetup const& es, typename T::Context const* context) {
     // Note there is no state-checking safety controlling the
     // activation/deactivation of endpaths.
-    for(auto& p : end_paths_) {
-      p.processOneOccurrence<T>(ep, es, streamID_, context);
+    if (T::isEvent_ && concurrentPaths_ && end_paths_.size() > 1) {
+      runPathsConcurrently<T>(end_paths_, ep, es, context);
+    } else {
+      for(auto& p : end_paths_) {
+        p.processOneOccurrence<T>(ep, es, streamID_, context);
+      }
+    }
+  }
+
+  template <typename T>
+  void
+  StreamSchedule::runPathsConcurrently(TrigPaths& iPaths, typename T::MyPrincipal& ep, EventSetup const& es, typename T::Context const* context) {
+    std::vector<std::function<void()>> work;
+    work.reserve(iPaths.size());
+    for(auto& p : iPaths) {
+      work.emplace_back([this, &p, &ep, &es, context]() { p.processOneOccurrence<T>(ep, es, streamID_, context); });
     }
+    runConcurrently(work);
   }
 }
 
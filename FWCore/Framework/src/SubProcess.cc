@@ -63,7 +63,8 @@ namespace edm {
       processParameterSet_(),
       productSelectorRules_(parameterSet, "outputCommands", "OutputModule"),
       productSelector_(),
-      wantAllEvents_(true) {
+      wantAllEvents_(true),
+      concurrentSubProcess_(false) {
   
     //Setup the event selection
     Service<service::TriggerNamesService> tns;
@@ -115,6 +116,7 @@ namespace edm {
 
     ParameterSet const& optionsPset(processParameterSet_->getUntrackedParameterSet("options", ParameterSet()));
     IllegalParameters::setThrowAnException(optionsPset.getUntrackedParameter<bool>("throwIfIllegalParameter", true));
+    concurrentSubProcess_ = optionsPset.getUntrackedParameter<bool>("concurrentSubProcess", false);
 
     //initialize the services
     ServiceToken iToken;
@@ -295,6 +297,30 @@ namespace edm {
   void
   SubProcess::doEvent(EventPrincipal const& ep) {
     ServiceRegistry::Operate operate(serviceToken_);
+    if(selectEvent(ep)) {
+      fillEvent(ep, false);
+      processFilledEvent(ep);
+    }
+  }
+
+  bool
+  SubProcess::prepareEvent(EventPrincipal const& ep) {
+    ServiceRegistry::Operate operate(serviceToken_);
+    if(!selectEvent(ep)) {
+      return false;
+    }
+    fillEvent(ep, true);
+    return true;
+  }
+
+  void
+  SubProcess::doPreparedEvent(EventPrincipal const& ep) {
+    ServiceRegistry::Operate operate(serviceToken_);
+    processFilledEvent(ep);
+  }
+
+  bool
+  SubProcess::selectEvent(EventPrincipal const& ep) {
     /* BEGIN relevant bits from OutputModule::doEvent */
     detail::TRBESSentry products_sentry(selectors_);
     
@@ -303,15 +329,15 @@ namespace edm {
       // use module description and const_cast unless interface to
       // event is changed to just take a const EventPrincipal
       if(!selectors_.wantEvent(ep, nullptr)) {
-        return;
+        return false;
       }
     }
-    process(ep);
+    return true;
     /* END relevant bits from OutputModule::doEvent */
   }
 
   void
-  SubProcess::process(EventPrincipal const& principal) {
+  SubProcess::fillEvent(EventPrincipal const& principal, bool iConcurrentWithParent) {
     EventAuxiliary aux(principal.aux());
     aux.setProcessHistoryID(principal.processHistoryID());
 
@@ -325,17 +351,43 @@ namespace edm {
     processHistoryRegistry.registerProcessHistory(principal.processHistory());
     BranchListIndexes bli(principal.branchListIndexes());
     branchIDListHelper_->fixBranchListIndexes(bli);
-    ep.fillEventPrincipal(aux,
-                          processHistoryRegistry,
-                          std::move(esids),
-                          std::move(bli),
-                          *(principal.productProvenanceRetrieverPtr()),//NOTE: this transfers the per product provenance
-                          principal.reader());
-    ep.setLuminosityBlockPrincipal(principalCache_.lumiPrincipalPtr());
+    if(iConcurrentWithParent) {
+      //the parent's end paths may still need the per product provenance so it is copied
+      ProductProvenanceRetriever const& provRetriever = *(principal.productProvenanceRetrieverPtr());
+      ep.fillEventPrincipal(aux,
+                            processHistoryRegistry,
+                            std::move(esids),
+                            std::move(bli),
+                            provRetriever,
+                            principal.reader());
+      //the parent's end paths may read delayed products into principal while
+      //this process runs, so read everything kept now and never touch the
+      //parent's product holders afterwards
+      resolveKeptProducts(principal);
+    } else {
+      ep.fillEventPrincipal(aux,
+                            processHistoryRegistry,
+                            std::move(esids),
+                            std::move(bli),
+                            *(principal.productProvenanceRetrieverPtr()),//NOTE: this transfers the per product provenance
+                            principal.reader());
+    }
+    ep.setLuminosityBlockPrincipal(principalCache_.lumiPrincipalPtr(principal.luminosityBlockPrincipal().index()));
     propagateProducts(InEvent, principal, ep);
+  }
+
+  void
+  SubProcess::processFilledEvent(EventPrincipal const& principal) {
+    EventPrincipal& ep = principalCache_.eventPrincipal(principal.streamID().value());
     typedef OccurrenceTraits<EventPrincipal, BranchActionStreamBegin> Traits;
-    schedule_->processOneEvent<Traits>(ep.streamID().value(),ep, esp_->eventSetup());
-    if(subProcess_.get()) subProcess_->doEvent(ep);
+    if(subProcess_.get() && concurrentSubProcess_ && schedule_->endPathsCanRunConcurrently()) {
+      schedule_->processOneEvent<Traits>(ep.streamID().value(),ep, esp_->eventSetup(), false,
+                                         [this, &ep]() { return subProcess_->prepareEvent(ep); },
+                                         [this, &ep]() { subProcess_->doPreparedEvent(ep); });
+    } else {
+      schedule_->processOneEvent<Traits>(ep.streamID().value(),ep, esp_->eventSetup());
+      if(subProcess_.get()) subProcess_->doEvent(ep);
+    }
     ep.clearEventPrincipal();
   }
 
@@ -415,7 +467,7 @@ namespace edm {
     lbpp->fillLuminosityBlockPrincipal(processHistoryRegistry, principal.reader());
     lbpp->setRunPrincipal(principalCache_.runPrincipalPtr());
     principalCache_.insert(lbpp);
-    LuminosityBlockPrincipal& lbp = *principalCache_.lumiPrincipalPtr();
+    LuminosityBlockPrincipal& lbp = *principalCache_.lumiPrincipalPtr(principal.index());
     propagateProducts(InLumi, principal, lbp);
     typedef OccurrenceTraits<LuminosityBlockPrincipal, BranchActionGlobalBegin> Traits;
     schedule_->processOneGlobal<Traits>(lbp, esp_->eventSetupForInstance(ts));
@@ -430,7 +482,7 @@ namespace edm {
 
   void
   SubProcess::endLuminosityBlock(LuminosityBlockPrincipal const& principal, IOVSyncValue const& ts, bool cleaningUpAfterException) {
-    LuminosityBlockPrincipal& lbp = *principalCache_.lumiPrincipalPtr();
+    LuminosityBlockPrincipal& lbp = *principalCache_.lumiPrincipalPtr(principal.index());
     propagateProducts(InLumi, principal, lbp);
     typedef OccurrenceTraits<LuminosityBlockPrincipal, BranchActionGlobalEnd> Traits;
     schedule_->processOneGlobal<Traits>(lbp, esp_->eventSetupForInstance(ts), cleaningUpAfterException);
@@ -494,7 +546,7 @@ namespace edm {
   SubProcess::doStreamBeginLuminosityBlock(unsigned int id, LuminosityBlockPrincipal const& principal, IOVSyncValue const& ts) {
     ServiceRegistry::Operate operate(serviceToken_);
     {
-      LuminosityBlockPrincipal& lbp = *principalCache_.lumiPrincipalPtr();
+      LuminosityBlockPrincipal& lbp = *principalCache_.lumiPrincipalPtr(principal.index());
       typedef OccurrenceTraits<LuminosityBlockPrincipal, BranchActionStreamBegin> Traits;
       schedule_->processOneStream<Traits>(id,lbp, esp_->eventSetupForInstance(ts));
       if(subProcess_.get()) subProcess_->doStreamBeginLuminosityBlock(id,lbp, ts);
@@ -505,7 +557,7 @@ namespace edm {
   SubProcess::doStreamEndLuminosityBlock(unsigned int id, LuminosityBlockPrincipal const& principal, IOVSyncValue const& ts, bool cleaningUpAfterException) {
     ServiceRegistry::Operate operate(serviceToken_);
     {
-      LuminosityBlockPrincipal& lbp = *principalCache_.lumiPrincipalPtr();
+      LuminosityBlockPrincipal& lbp = *principalCache_.lumiPrincipalPtr(principal.index());
       typedef OccurrenceTraits<LuminosityBlockPrincipal, BranchActionStreamEnd> Traits;
       schedule_->processOneStream<Traits>(id,lbp, esp_->eventSetupForInstance(ts),cleaningUpAfterException);
       if(subProcess_.get()) subProcess_->doStreamEndLuminosityBlock(id,lbp, ts,cleaningUpAfterException);
@@ -544,6 +596,17 @@ namespace edm {
     }
   }
 
+  void
+  SubProcess::resolveKeptProducts(EventPrincipal const& parentPrincipal) const {
+    for(auto const& item : keptProducts()[InEvent]) {
+      ProductHolderBase const* parentProductHolder = parentPrincipal.getProductHolder(item->branchID());
+      if(parentProductHolder != nullptr && !parentProductHolder->productWasDeleted()) {
+        ProductHolderBase::ResolveStatus resolveStatus;
+        (void)parentProductHolder->resolveProduct(resolveStatus, false, nullptr);
+      }
+    }
+  }
+
   void SubProcess::updateBranchIDListHelper(BranchIDLists const& branchIDLists) {
     branchIDListHelper_->updateFromParent(branchIDLists);
     if(subProcess_.get()) {
@@ -0,0 +1,48 @@
+#ifndef FWCore_Framework_TaskIsolation_h
+#define FWCore_Framework_TaskIsolation_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     TaskIsolation
+//
+/**\function edm::runIsolated TaskIsolation.h "FWCore/Framework/src/TaskIsolation.h"
+
+ Description: Runs a function so that the TBB waits inside it only run the tasks spawned inside it
+
+ Usage:
+    A thread waiting for TBB tasks may otherwise run any other task, e.g. the Path or
+    prefetch task of another module, while it holds the lock of the Worker it is running.
+    The concurrent Path and prefetching options are only allowed if taskIsolationAvailable().
+
+*/
+
+// system include files
+#include "tbb/tbb_stddef.h"
+#if TBB_INTERFACE_VERSION >= 10000
+#include "tbb/task_arena.h"
+#define FWCORE_FRAMEWORK_TASK_ISOLATION 1
+#endif
+
+// user include files
+
+namespace edm {
+
+  constexpr bool taskIsolationAvailable() {
+#ifdef FWCORE_FRAMEWORK_TASK_ISOLATION
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  template<typename F>
+  void runIsolated(F const& iFunc) {
+#ifdef FWCORE_FRAMEWORK_TASK_ISOLATION
+    tbb::this_task_arena::isolate(iFunc);
+#else
+    iFunc();
+#endif
+  }
+}
+
+#endif
@@ -4,8 +4,15 @@
 
 #include "FWCore/Framework/src/Worker.h"
 #include "FWCore/Framework/src/EarlyDeleteHelper.h"
+#include "FWCore/Framework/interface/Principal.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
 #include "FWCore/ServiceRegistry/interface/StreamContext.h"
 
+#include "tbb/task.h"
+
+#include <atomic>
+#include <exception>
+
 namespace edm {
   namespace {
     class ModuleBeginJobSignalSentry {
@@ -66,6 +73,41 @@ private:
       ModuleCallingContext const& mcc_;
     };
 
+    class PrefetchTask : public tbb::task {
+    public:
+      PrefetchTask(Principal const& iPrincipal,
+                   ProductHolderIndexAndSkipBit const& iItem,
+                   ModuleCallingContext const* iContext,
+                   ServiceToken const& iToken,
+                   std::atomic<bool>* iExceptionIsSet,
+                   std::exception_ptr* iException) :
+        principal_(iPrincipal),
+        item_(iItem),
+        context_(iContext),
+        token_(iToken),
+        exceptionIsSet_(iExceptionIsSet),
+        exception_(iException) {}
+
+      tbb::task* execute() override {
+        try {
+          ServiceRegistry::Operate operate(token_);
+          principal_.prefetch(item_.productHolderIndex(), item_.skipCurrentProcess(), context_);
+        } catch(...) {
+          bool expected = false;
+          if(exceptionIsSet_->compare_exchange_strong(expected, true)) {
+            *exception_ = std::current_exception();
+          }
+        }
+        return nullptr;
+      }
+    private:
+      Principal const& principal_;
+      ProductHolderIndexAndSkipBit item_;
+      ModuleCallingContext const* context_;
+      ServiceToken token_;
+      std::atomic<bool>* exceptionIsSet_;
+      std::exception_ptr* exception_;
+    };
   }
 
   Worker::Worker(ModuleDescription const& iMD, 
@@ -80,7 +122,10 @@ private:
     actions_(iActions),
     cached_exception_(),
     actReg_(),
-    earlyDeleteHelper_(nullptr)
+    earlyDeleteHelper_(nullptr),
+    concurrentPrefetching_(false),
+    concurrentPaths_(false),
+    eventMutexOwner_(std::thread::id())
   {
   }
 
@@ -95,6 +140,43 @@ private:
     earlyDeleteHelper_=iHelper;
   }
   
+  void Worker::prefetchConcurrently(Principal const& iPrincipal,
+                                    std::vector<ProductHolderIndexAndSkipBit> const& iItems) const {
+    std::vector<ProductHolderIndexAndSkipBit const*> toGet;
+    toGet.reserve(iItems.size());
+    for(auto const& item : iItems) {
+      if(item.productHolderIndex() != ProductHolderIndexAmbiguous) {
+        toGet.push_back(&item);
+      }
+    }
+    if(toGet.empty()) {
+      return;
+    }
+
+    std::atomic<bool> exceptionIsSet{false};
+    std::exception_ptr exception;
+    ServiceToken token = ServiceRegistry::instance().presentToken();
+
+    //This Worker is locked: while waiting, the thread must only run the prefetch tasks
+    //spawned here, not e.g. the task of another Path which needs this Worker or one
+    //locked by a thread waiting for us
+    runIsolated([&]() {
+      //To wait, the ref count has to be 1+#items
+      tbb::task* waitTask{new (tbb::task::allocate_root()) tbb::empty_task{}};
+      waitTask->set_ref_count(toGet.size()+1);
+      for(unsigned int i = 1; i < toGet.size(); ++i) {
+        tbb::task::spawn(*(new (waitTask->allocate_child()) PrefetchTask{iPrincipal, *toGet[i], &moduleCallingContext_, token, &exceptionIsSet, &exception}));
+      }
+      //the calling thread does the first one itself
+      waitTask->spawn_and_wait_for_all(*(new (waitTask->allocate_child()) PrefetchTask{iPrincipal, *toGet[0], &moduleCallingContext_, token, &exceptionIsSet, &exception}));
+      tbb::task::destroy(*waitTask);
+    });
+
+    if(exceptionIsSet) {
+      std::rethrow_exception(exception);
+    }
+  }
+
   void Worker::resetModuleDescription(ModuleDescription const* iDesc) {
     ModuleCallingContext temp(iDesc,moduleCallingContext_.state(),moduleCallingContext_.parent(),
                               moduleCallingContext_.previousModuleOnThread());
@@ -19,10 +19,18 @@ will be rethrown if the worker is entered again and the state is not Ready.
 In other words, execution results (status) are cached and reused until
 the worker is reset().
 
+If concurrent prefetching is enabled, the products a module declares it
+consumes are requested in parallel as TBB tasks before the module is
+run when the module is called directly from a path. Calls for the same
+worker from different threads are then serialized, and the TBB waits
+made while a worker is locked are isolated so the thread cannot be given
+a task which needs that worker again.
+
 ----------------------------------------------------------------------*/
 
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "FWCore/MessageLogger/interface/ExceptionMessages.h"
+#include "FWCore/Framework/src/TaskIsolation.h"
 #include "FWCore/Framework/src/WorkerParams.h"
 #include "FWCore/Framework/interface/ExceptionActions.h"
 #include "FWCore/Framework/interface/ModuleContextSentry.h"
@@ -44,10 +52,13 @@ the worker is reset().
 
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace edm {
@@ -104,6 +115,13 @@ namespace edm {
 
     void setEarlyDeleteHelper(EarlyDeleteHelper* iHelper);
 
+    ///Request the consumed event products concurrently before running the module
+    void setConcurrentPrefetching(bool iValue) { concurrentPrefetching_ = iValue; }
+    bool concurrentPrefetching() const { return concurrentPrefetching_; }
+
+    ///The module may be called from several Paths of the same event at once
+    void setConcurrentPaths(bool iValue) { concurrentPaths_ = iValue; }
+
     //Used to make EDGetToken work
     virtual void updateLookup(BranchType iBranchType,
                       ProductHolderIndexHelper const&) = 0;
@@ -163,6 +181,9 @@ namespace edm {
 
   private:
 
+    void prefetchConcurrently(Principal const& iPrincipal,
+                              std::vector<ProductHolderIndexAndSkipBit> const& iItems) const;
+
     virtual void itemsToGet(BranchType, std::vector<ProductHolderIndexAndSkipBit>&) const = 0;
     virtual void itemsMayGet(BranchType, std::vector<ProductHolderIndexAndSkipBit>&) const = 0;
 
@@ -191,9 +212,47 @@ namespace edm {
     std::shared_ptr<ActivityRegistry> actReg_;
 
     EarlyDeleteHelper* earlyDeleteHelper_;
+
+    bool concurrentPrefetching_;
+    bool concurrentPaths_;
+    // Serializes event calls when products are prefetched or Paths run from several threads
+    std::mutex eventMutex_;
+    std::atomic<std::thread::id> eventMutexOwner_;
   };
 
   namespace {
+    // The lock is not recursive: a thread coming back to the Worker it is running
+    // would run the module a second time, so this is reported instead
+    class EventLockSentry {
+    public:
+      EventLockSentry(std::mutex& iMutex, std::atomic<std::thread::id>& iOwner,
+                      ModuleDescription const& iDescription, bool iLock) :
+        mutex_(iLock ? &iMutex : nullptr), owner_(&iOwner) {
+        if(not mutex_) {
+          return;
+        }
+        if(iOwner.load() == std::this_thread::get_id()) {
+          throw cms::Exception("LogicError")
+            << "Module " << iDescription.moduleName() << "/'" << iDescription.moduleLabel()
+            << "' was called again by the thread which is running it.\n";
+        }
+        iMutex.lock();
+        iOwner.store(std::this_thread::get_id());
+      }
+      ~EventLockSentry() {
+        if(mutex_) {
+          owner_->store(std::thread::id());
+          mutex_->unlock();
+        }
+      }
+      EventLockSentry(EventLockSentry const&) = delete;
+      EventLockSentry& operator=(EventLockSentry const&) = delete;
+
+    private:
+      std::mutex* mutex_;
+      std::atomic<std::thread::id>* owner_;
+    };
+
     template <typename T>
     class ModuleSignalSentry {
     public:
@@ -402,6 +461,9 @@ namespace edm {
                       ParentContext const& parentContext,
                       typename T::Context const* context) {
 
+    bool const concurrentEvent = T::isEvent_ && (concurrentPrefetching_ || concurrentPaths_);
+    EventLockSentry eventGuard(eventMutex_, eventMutexOwner_, description(), concurrentEvent);
+
     if (T::isEvent_) {
       ++timesVisited_;
     }
@@ -426,17 +488,31 @@ namespace edm {
 
           // Prefetch products the module declares it consumes (not including the products it maybe consumes)
           std::vector<ProductHolderIndexAndSkipBit> const& items = itemsToGetFromEvent();
-          for(auto const& item : items) {
-            ProductHolderIndex productHolderIndex = item.productHolderIndex();
-            bool skipCurrentProcess = item.skipCurrentProcess();
-            if(productHolderIndex != ProductHolderIndexAmbiguous) {
-              ep.prefetch(productHolderIndex, skipCurrentProcess, &moduleCallingContext_);
+          // Only the module called from the path fans out, modules run on demand
+          // from within another module prefetch on their own thread
+          if(concurrentPrefetching_ && items.size() > 1 &&
+             moduleCallingContext_.type() == ParentContext::Type::kPlaceInPath) {
+            prefetchConcurrently(ep, items);
+          } else {
+            for(auto const& item : items) {
+              ProductHolderIndex productHolderIndex = item.productHolderIndex();
+              bool skipCurrentProcess = item.skipCurrentProcess();
+              if(productHolderIndex != ProductHolderIndexAmbiguous) {
+                ep.prefetch(productHolderIndex, skipCurrentProcess, &moduleCallingContext_);
+              }
             }
           }
         }
 
         moduleCallingContext_.setState(ModuleCallingContext::State::kRunning);
-        rc = workerhelper::CallImpl<T>::call(this,streamID,ep,es, actReg_.get(), &moduleCallingContext_, context);
+        if (concurrentEvent) {
+          // the waits inside the module must not run tasks which need this Worker
+          runIsolated([&]() {
+            rc = workerhelper::CallImpl<T>::call(this,streamID,ep,es, actReg_.get(), &moduleCallingContext_, context);
+          });
+        } else {
+          rc = workerhelper::CallImpl<T>::call(this,streamID,ep,es, actReg_.get(), &moduleCallingContext_, context);
+        }
 
         if (rc) {
           state_ = Pass;
@@ -34,6 +34,7 @@ CPPUNIT_TEST(dependsOnTest);
 CPPUNIT_TEST(labelTest);
 CPPUNIT_TEST_EXCEPTION(failMultipleRegistration,cms::Exception);
 CPPUNIT_TEST(forceCacheClearTest);
+CPPUNIT_TEST(prefetchTest);
    
 CPPUNIT_TEST_SUITE_END();
 public:
@@ -48,6 +49,7 @@ public:
   void labelTest();
   void failMultipleRegistration();
   void forceCacheClearTest();
+  void prefetchTest();
 
 private:
 class Test1Producer : public ESProducer {
@@ -65,6 +67,22 @@ private:
    DummyData data_;
 };
 
+class CountingProducer : public ESProducer {
+public:
+   explicit CountingProducer(int& iNProduced) : ESProducer(), data_(), nProduced_(&iNProduced) {
+      data_.value_ = 0;
+      setWhatProduced(this);
+   }
+   const DummyData* produce(const DummyRecord& /*iRecord*/) {
+      ++(*nProduced_);
+      data_.value_ = *nProduced_;
+      return &data_;
+   }
+private:
+   DummyData data_;
+   int* nProduced_;
+};
+
 class MultiRegisterProducer : public ESProducer {
 public:
    MultiRegisterProducer() : ESProducer(), data_() {
@@ -368,3 +386,39 @@ void testEsproducer::forceCacheClearTest()
    }
 }
 
+void testEsproducer::prefetchTest()
+{
+   EventSetupProvider provider;
+   provider.setPrefetchDataAtNewInterval(true);
+
+   int nProduced = 0;
+   boost::shared_ptr<DataProxyProvider> pProxyProv(new CountingProducer(nProduced));
+   provider.add(pProxyProv);
+
+   boost::shared_ptr<DummyFinder> pFinder(new DummyFinder);
+   provider.add(boost::shared_ptr<EventSetupRecordIntervalFinder>(pFinder));
+
+   const edm::Timestamp time1(1);
+   pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time1) , edm::IOVSyncValue(time1)));
+   const edm::EventSetup& eventSetup = provider.eventSetupForInstance(edm::IOVSyncValue(time1));
+   //nothing was gotten before so nothing is prefetched
+   CPPUNIT_ASSERT(0 == nProduced);
+   {
+      edm::ESHandle<DummyData> pDummy;
+      eventSetup.get<DummyRecord>().get(pDummy);
+      CPPUNIT_ASSERT(1 == pDummy->value_);
+   }
+
+   const edm::Timestamp time2(2);
+   pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time2) , edm::IOVSyncValue(time2)));
+   provider.eventSetupForInstance(edm::IOVSyncValue(time2));
+   //the data gotten in the previous IOV were produced for the new one
+   CPPUNIT_ASSERT(2 == nProduced);
+   {
+      edm::ESHandle<DummyData> pDummy;
+      eventSetup.get<DummyRecord>().get(pDummy);
+      CPPUNIT_ASSERT(2 == pDummy->value_);
+   }
+   CPPUNIT_ASSERT(2 == nProduced);
+}
+
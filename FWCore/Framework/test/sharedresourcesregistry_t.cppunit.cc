@@ -11,6 +11,7 @@
 #define SHAREDRESOURCETESTACCESSORS 1
 #include "FWCore/Framework/src/SharedResourcesRegistry.h"
 #include "FWCore/Framework/interface/SharedResourcesAcquirer.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 using namespace edm;
 
@@ -21,6 +22,7 @@ class testSharedResourcesRegistry: public CppUnit::TestFixture
    CPPUNIT_TEST(oneTest);
    CPPUNIT_TEST(legacyTest);
    CPPUNIT_TEST(multipleTest);
+   CPPUNIT_TEST(replicaTest);
   
    CPPUNIT_TEST_SUITE_END();
 public:
@@ -30,6 +32,7 @@ public:
    void oneTest();
    void legacyTest();
    void multipleTest();
+   void replicaTest();
 };
 
 ///registration of the test so that the runner can find it
@@ -159,3 +162,41 @@ void testSharedResourcesRegistry::multipleTest()
   }
 
 }
+
+void testSharedResourcesRegistry::replicaTest()
+{
+  edm::SharedResourcesRegistry reg;
+
+  reg.setNumberOfReplicas("foo", 2);
+  CPPUNIT_ASSERT(2 == reg.numberOfReplicas("foo"));
+  CPPUNIT_ASSERT(1 == reg.numberOfReplicas("bar"));
+
+  reg.registerSharedResource("foo");
+  reg.registerSharedResource("foo");
+  reg.registerSharedResource("foo");
+
+  std::vector<std::string> res{"foo"};
+  auto first = reg.createAcquirer(res);
+  auto second = reg.createAcquirer(res);
+  auto third = reg.createAcquirer(res);
+  CPPUNIT_ASSERT(1 == first.numberOfResources());
+
+  //the first two modules use different replicas and can run together
+  CPPUNIT_ASSERT(first.m_resources[0] != second.m_resources[0]);
+  CPPUNIT_ASSERT(first.m_resources[0] == third.m_resources[0]);
+
+  first.lock();
+  second.lock();
+  second.unlock();
+  first.unlock();
+  CPPUNIT_ASSERT(2 == reg.waitTimes().at("foo")->acquisitions);
+  CPPUNIT_ASSERT(0 == reg.waitTimes().at("foo")->contended);
+
+  //legacy modules take all the replicas
+  reg.registerSharedResource(edm::SharedResourcesRegistry::kLegacyModuleResourceName);
+  std::vector<std::string> legacy{edm::SharedResourcesRegistry::kLegacyModuleResourceName};
+  auto tester = reg.createAcquirer(legacy);
+  CPPUNIT_ASSERT(2 == tester.numberOfResources());
+
+  CPPUNIT_ASSERT_THROW(reg.setNumberOfReplicas(edm::SharedResourcesRegistry::kLegacyModuleResourceName, 2), cms::Exception);
+}
@@ -269,6 +269,42 @@ namespace edmtest {
     e.put(std::move(p));
   }
 
+  //
+  // Same as AddIntsProducer for the tests which must not use legacy modules,
+  // optionally checking the sum.
+  //
+
+  class StreamAddIntsProducer : public edm::stream::EDProducer<> {
+  public:
+    explicit StreamAddIntsProducer(edm::ParameterSet const& p) :
+        expectedSum_(p.getUntrackedParameter<int>("expectedSum", 0)) {
+      produces<IntProduct>();
+      for( auto const& label: p.getParameter<std::vector<std::string> >("labels")) {
+        tokens_.push_back(consumes<IntProduct>(edm::InputTag{label}));
+      }
+    }
+    virtual void produce(edm::Event& e, edm::EventSetup const& c) override;
+  private:
+    std::vector<edm::EDGetTokenT<IntProduct>> tokens_;
+    int expectedSum_;
+  };
+
+  void
+  StreamAddIntsProducer::produce(edm::Event& e, edm::EventSetup const&) {
+    // EventSetup is not used.
+    int value = 0;
+    for(auto const& token : tokens_) {
+      edm::Handle<IntProduct> anInt;
+      e.getByToken(token, anInt);
+      value += anInt->value;
+    }
+    if(expectedSum_ != 0 and value != expectedSum_) {
+      throw cms::Exception("ValueMismatch") << "The sum " << value << " is not the expected " << expectedSum_;
+    }
+    std::unique_ptr<IntProduct> p(new IntProduct(value));
+    e.put(std::move(p));
+  }
+
 }
 
 using edmtest::FailingProducer;
@@ -280,6 +316,7 @@ using edmtest::TransientIntProducer;
 using edmtest::IntProducerFromTransient;
 using edmtest::Int16_tProducer;
 using edmtest::AddIntsProducer;
+using edmtest::StreamAddIntsProducer;
 DEFINE_FWK_MODULE(FailingProducer);
 DEFINE_FWK_MODULE(NonProducer);
 DEFINE_FWK_MODULE(IntProducer);
@@ -289,3 +326,4 @@ DEFINE_FWK_MODULE(TransientIntProducer);
 DEFINE_FWK_MODULE(IntProducerFromTransient);
 DEFINE_FWK_MODULE(Int16_tProducer);
 DEFINE_FWK_MODULE(AddIntsProducer);
+DEFINE_FWK_MODULE(StreamAddIntsProducer);
@@ -0,0 +1,27 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(3))
+
+process.options = cms.untracked.PSet(
+        autoDeleteEarly = cms.untracked.bool(True))
+
+
+process.maker = cms.EDProducer("DeleteEarlyProducer")
+
+process.reader = cms.EDAnalyzer("DeleteEarlyReader",
+                                tag = cms.untracked.InputTag("maker"))
+
+process.tester = cms.EDAnalyzer("DeleteEarlyCheckDeleteAnalyzer",
+                                expectedValues = cms.untracked.vuint32(1,3,5))
+
+process.out = cms.OutputModule("SewerModule",
+                               shouldPass = cms.int32(3),
+                               name = cms.string('keepsMaker'),
+                               outputCommands = cms.untracked.vstring("drop *", "keep *_maker_*_*"))
+
+process.p = cms.Path(process.maker+process.reader+process.tester)
+process.o = cms.EndPath(process.out)
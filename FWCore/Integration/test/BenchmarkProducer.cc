@@ -0,0 +1,84 @@
+/*----------------------------------------------------------------------
+
+BenchmarkProducer: a module of a synthetic configuration used to measure
+the throughput of the framework itself. It reads the products of the
+modules it is configured to depend on, spins for a configurable amount
+of CPU time and puts a product of configurable size.
+
+----------------------------------------------------------------------*/
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace edmtest {
+
+  class BenchmarkProducer : public edm::global::EDProducer<> {
+  public:
+    explicit BenchmarkProducer(edm::ParameterSet const& p);
+
+    virtual void produce(edm::StreamID, edm::Event& e, edm::EventSetup const& c) const override;
+
+    static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+  private:
+    std::vector<edm::EDGetTokenT<std::vector<int>>> tokens_;
+    std::chrono::microseconds cpuTime_;
+    unsigned int productSize_;
+  };
+
+  BenchmarkProducer::BenchmarkProducer(edm::ParameterSet const& p) :
+    cpuTime_(p.getParameter<unsigned int>("cpuMicroseconds")),
+    productSize_(p.getParameter<unsigned int>("productSize")) {
+    for(auto const& tag : p.getParameter<std::vector<edm::InputTag>>("inputs")) {
+      tokens_.push_back(consumes<std::vector<int>>(tag));
+    }
+    produces<std::vector<int>>();
+  }
+
+  void
+  BenchmarkProducer::produce(edm::StreamID, edm::Event& e, edm::EventSetup const&) const {
+    int sum = 0;
+    for(auto const& token : tokens_) {
+      edm::Handle<std::vector<int>> h;
+      e.getByToken(token, h);
+      if(!h->empty()) {
+        sum += h->front();
+      }
+    }
+
+    // Busy wait rather than sleep so the thread is really kept occupied
+    auto const end = std::chrono::steady_clock::now() + cpuTime_;
+    while(std::chrono::steady_clock::now() < end) {
+      ++sum;
+    }
+
+    std::unique_ptr<std::vector<int>> product(new std::vector<int>(productSize_, sum));
+    e.put(std::move(product));
+  }
+
+  void
+  BenchmarkProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+    edm::ParameterSetDescription desc;
+    desc.add<std::vector<edm::InputTag>>("inputs", std::vector<edm::InputTag>())
+      ->setComment("Products of the modules this module depends on.");
+    desc.add<unsigned int>("cpuMicroseconds", 0U)
+      ->setComment("CPU time spent in each call to produce.");
+    desc.add<unsigned int>("productSize", 1U)
+      ->setComment("Number of ints in the product put into the event.");
+    descriptions.add("benchmarkProducer", desc);
+  }
+}
+
+using edmtest::BenchmarkProducer;
+DEFINE_FWK_MODULE(BenchmarkProducer);
@@ -0,0 +1,46 @@
+#!/usr/bin/env python
+# Runs benchmark_cfg.py for several numbers of threads and prints the
+# event throughput of each. The time of a short run is subtracted from
+# that of the full run so the job start up does not enter the result.
+#
+#   benchmarkFramework.py --threads 1,2,4,8 --events 2000 -- width=8 depth=4
+import argparse
+import os
+import subprocess
+import sys
+import time
+
+def runJob(config, nThreads, nStreams, nEvents, extra):
+    command = ["cmsRun", config, "nThreads=%d" % nThreads, "nStreams=%d" % nStreams, "nEvents=%d" % nEvents] + extra
+    start = time.time()
+    with open(os.devnull, "w") as devnull:
+        status = subprocess.call(command, stdout=devnull, stderr=subprocess.STDOUT)
+    if status != 0:
+        sys.exit("'%s' failed with status %d" % (" ".join(command), status))
+    return time.time() - start
+
+def main():
+    parser = argparse.ArgumentParser(description="Measures the event throughput of the framework")
+    parser.add_argument("--config", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "benchmark_cfg.py"))
+    parser.add_argument("--threads", default="1,2,4", help="comma separated numbers of threads")
+    parser.add_argument("--streams", default="", help="comma separated numbers of streams, default one per thread")
+    parser.add_argument("--events", type=int, default=1000)
+    parser.add_argument("--warmupEvents", type=int, default=10)
+    parser.add_argument("extra", nargs="*", help="further options for the configuration, e.g. width=8")
+    args = parser.parse_args()
+
+    threads = [int(t) for t in args.threads.split(",")]
+    streams = [int(s) for s in args.streams.split(",")] if args.streams else threads
+    if len(streams) != len(threads):
+        sys.exit("--streams must give one value per entry of --threads")
+
+    print("%8s %8s %12s" % ("threads", "streams", "events/s"))
+    for nThreads, nStreams in zip(threads, streams):
+        short = runJob(args.config, nThreads, nStreams, args.warmupEvents, args.extra)
+        full = runJob(args.config, nThreads, nStreams, args.events, args.extra)
+        rate = (args.events - args.warmupEvents) / max(full - short, 1e-6)
+        print("%8d %8d %12.1f" % (nThreads, nStreams, rate))
+        sys.stdout.flush()
+
+if __name__ == "__main__":
+    main()
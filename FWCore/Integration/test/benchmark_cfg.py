@@ -0,0 +1,59 @@
+# Synthetic configuration used to measure the event throughput of the
+# framework. The modules form 'depth' layers of 'width' BenchmarkProducers,
+# each reading the products of 'fanIn' modules of the layer before it.
+# Each layer is on its own Path unless 'onePath' is set.
+#
+#   cmsRun benchmark_cfg.py nThreads=4 nStreams=4 nEvents=1000 width=8 depth=4
+import FWCore.ParameterSet.Config as cms
+from FWCore.ParameterSet.VarParsing import VarParsing
+
+options = VarParsing()
+options.register("nThreads", 1, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of threads")
+options.register("nStreams", 0, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of streams, 0 means one per thread")
+options.register("nEvents", 100, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of events")
+options.register("width", 4, VarParsing.multiplicity.singleton, VarParsing.varType.int, "modules per layer")
+options.register("depth", 4, VarParsing.multiplicity.singleton, VarParsing.varType.int, "number of layers")
+options.register("fanIn", 2, VarParsing.multiplicity.singleton, VarParsing.varType.int, "inputs read by each module")
+options.register("cpuMicroseconds", 100, VarParsing.multiplicity.singleton, VarParsing.varType.int, "CPU time of each module")
+options.register("productSize", 10, VarParsing.multiplicity.singleton, VarParsing.varType.int, "ints in each product")
+options.register("onePath", False, VarParsing.multiplicity.singleton, VarParsing.varType.bool, "put all modules on one Path")
+options.parseArguments()
+
+process = cms.Process("BENCH")
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(options.nThreads),
+    numberOfStreams = cms.untracked.uint32(options.nStreams)
+)
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(options.nEvents)
+)
+
+def label(layer, index):
+    return "bench%dx%d" % (layer, index)
+
+paths = []
+for layer in range(options.depth):
+    modules = []
+    for index in range(options.width):
+        inputs = []
+        if layer > 0:
+            for k in range(min(options.fanIn, options.width)):
+                inputs.append(cms.InputTag(label(layer-1, (index+k) % options.width)))
+        module = cms.EDProducer("BenchmarkProducer",
+            inputs = cms.VInputTag(inputs),
+            cpuMicroseconds = cms.uint32(options.cpuMicroseconds),
+            productSize = cms.uint32(options.productSize)
+        )
+        setattr(process, label(layer, index), module)
+        modules.append(module)
+    paths.append(cms.Sequence(sum(modules[1:], modules[0])))
+
+if options.onePath:
+    process.p = cms.Path(sum(paths[1:], paths[0]))
+else:
+    for layer, sequence in enumerate(paths):
+        # a layer needs the one before it, so each path runs all earlier layers
+        setattr(process, "p%d" % layer, cms.Path(sum(paths[1:layer+1], paths[0])))
@@ -34,6 +34,15 @@ pushd ${LOCAL_TMP_DIR}
   grep "Sharing" testSubProcessEventSetup1.log >> testSubProcessEventSetup1.grep.txt
   diff ${LOCAL_TEST_DIR}/unit_test_outputs/testSubProcessEventSetup1.grep.txt  testSubProcessEventSetup1.grep.txt || die "comparing testSubProcessEventSetup1.grep.txt" $?
 
+  echo cmsRun testConcurrentSubProcess_cfg.py concurrent=0
+  cmsRun -p ${LOCAL_TEST_DIR}/testConcurrentSubProcess_cfg.py concurrent=0 > testSerialSubProcess.log 2>&1 || die "cmsRun testConcurrentSubProcess_cfg.py concurrent=0" $?
+  grep "READ++" testSerialSubProcess.log > testSerialSubProcess.grep.txt
+
+  echo cmsRun testConcurrentSubProcess_cfg.py concurrent=1
+  cmsRun -p ${LOCAL_TEST_DIR}/testConcurrentSubProcess_cfg.py concurrent=1 > testConcurrentSubProcess.log 2>&1 || die "cmsRun testConcurrentSubProcess_cfg.py concurrent=1" $?
+  grep "READ++" testConcurrentSubProcess.log > testConcurrentSubProcess.grep.txt
+  diff testSerialSubProcess.grep.txt testConcurrentSubProcess.grep.txt || die "comparing the SubProcess content with serial mode" $?
+
 popd
 
 exit 0
@@ -18,6 +18,12 @@ pushd ${LOCAL_TMP_DIR}
   echo "testGetBy3"
   cmsRun -p ${LOCAL_TEST_DIR}/${test}3_cfg.py || die "cmsRun ${test}3_cfg.py" $?
 
+  echo "testConcurrentPaths"
+  cmsRun -p ${LOCAL_TEST_DIR}/testConcurrentPaths_cfg.py || die "cmsRun testConcurrentPaths_cfg.py" $?
+
+  echo "testConcurrentPrefetching"
+  cmsRun -p ${LOCAL_TEST_DIR}/testConcurrentPrefetching_cfg.py || die "cmsRun testConcurrentPrefetching_cfg.py" $?
+
   echo "testConsumesInfo"
   cmsRun -p ${LOCAL_TEST_DIR}/testConsumesInfo_cfg.py > testConsumesInfo.log 2>/dev/null || die "cmsRun testConsumesInfo_cfg.py" $?
   grep -v "++" testConsumesInfo.log > testConsumesInfo_1.log
@@ -0,0 +1,20 @@
+#!/bin/bash
+
+# Only checks that the benchmark configuration runs, the throughput
+# itself is measured with benchmarkFramework.py
+
+function die { echo Failure $1: status $2 ; exit $2 ; }
+
+pushd ${LOCAL_TMP_DIR}
+
+  for threads in 1 4; do
+    echo "benchmark_cfg.py nThreads=${threads}"
+    cmsRun -p ${LOCAL_TEST_DIR}/benchmark_cfg.py nThreads=${threads} nEvents=20 cpuMicroseconds=10 || die "cmsRun benchmark_cfg.py nThreads=${threads}" $?
+  done
+
+  echo "benchmark_cfg.py onePath=True"
+  cmsRun -p ${LOCAL_TEST_DIR}/benchmark_cfg.py nThreads=2 nEvents=20 onePath=True || die "cmsRun benchmark_cfg.py onePath=True" $?
+
+popd
+
+exit 0
@@ -0,0 +1,37 @@
+# Runs the Paths of each event as separate tasks. The modules shared
+# between the Paths and the unscheduled producer must still run once.
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("PROD")
+
+process.options = cms.untracked.PSet(
+    allowUnscheduled = cms.untracked.bool(True),
+    numberOfThreads = cms.untracked.uint32(4),
+    concurrentPaths = cms.untracked.bool(True)
+)
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(10)
+)
+
+process.intProducer = cms.EDProducer("IntProducer", ivalue = cms.int32(1))
+
+process.intProducerU = cms.EDProducer("IntProducer", ivalue = cms.int32(2))
+
+# legacy modules would turn the option off
+def finder():
+    return cms.EDProducer("StreamAddIntsProducer",
+        labels = cms.vstring("intProducer", "intProducerU"),
+        expectedSum = cms.untracked.int32(3)
+    )
+
+process.a1 = finder()
+process.a2 = finder()
+process.a3 = finder()
+process.a4 = finder()
+
+process.p1 = cms.Path(process.intProducer * process.a1)
+process.p2 = cms.Path(process.intProducer * process.a2)
+process.p3 = cms.Path(process.intProducer * process.a3)
+process.p4 = cms.Path(process.intProducer * process.a4)
@@ -0,0 +1,41 @@
+# Prefetches the products of each module in parallel while its Paths run as
+# separate tasks. The two unscheduled producers depend on each other, and the
+# two consumers ask for them in opposite orders, so a thread waiting for one
+# of them must not be given the prefetch of the other consumer.
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("PROD")
+
+process.options = cms.untracked.PSet(
+    allowUnscheduled = cms.untracked.bool(True),
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(1),
+    concurrentPrefetching = cms.untracked.bool(True),
+    concurrentPaths = cms.untracked.bool(True)
+)
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(100)
+)
+
+process.intProducerA = cms.EDProducer("IntProducer", ivalue = cms.int32(1))
+
+# legacy modules would turn both options off
+process.intProducerB = cms.EDProducer("StreamAddIntsProducer",
+    labels = cms.vstring("intProducerA"),
+    expectedSum = cms.untracked.int32(1)
+)
+
+process.consumerAB = cms.EDProducer("StreamAddIntsProducer",
+    labels = cms.vstring("intProducerA", "intProducerB"),
+    expectedSum = cms.untracked.int32(2)
+)
+
+process.consumerBA = cms.EDProducer("StreamAddIntsProducer",
+    labels = cms.vstring("intProducerB", "intProducerA"),
+    expectedSum = cms.untracked.int32(2)
+)
+
+process.p1 = cms.Path(process.consumerAB)
+process.p2 = cms.Path(process.consumerBA)
@@ -0,0 +1,82 @@
+# Runs each SubProcess while the end paths of its parent are still running.
+# run_SubProcess.sh runs this with concurrent=0 and concurrent=1 and compares
+# what the SubProcesses see.
+import FWCore.ParameterSet.Config as cms
+from FWCore.ParameterSet.VarParsing import VarParsing
+
+options = VarParsing()
+options.register("concurrent", True, VarParsing.multiplicity.singleton, VarParsing.varType.bool, "run the SubProcesses concurrently with the end paths")
+options.parseArguments()
+
+process = cms.Process("CFIRST")
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(2),
+    concurrentSubProcess = cms.untracked.bool(options.concurrent)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(3)
+)
+
+# products read from a file are only read when first asked for, so the end
+# paths below do delayed reads while the SubProcess runs
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring('file:testSubProcess.root')
+)
+
+process.intProducer = cms.EDProducer("IntProducer", ivalue = cms.int32(1))
+
+process.a1 = cms.EDAnalyzer("TestFindProduct",
+  inputTags = cms.untracked.VInputTag( cms.InputTag("intProducer") ),
+  expectedSum = cms.untracked.int32(3)
+)
+
+process.dump = cms.EDAnalyzer("EventContentAnalyzer",
+    getData = cms.untracked.bool(True)
+)
+
+process.out = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('testConcurrentSubProcess.root')
+)
+
+process.p = cms.Path(process.intProducer)
+process.e = cms.EndPath(process.a1+process.dump+process.out)
+
+# ---------------------------------------------------------------
+
+copyProcess = cms.Process("CCOPY")
+process.subProcess = cms.SubProcess(copyProcess)
+
+copyProcess.options = cms.untracked.PSet(
+    concurrentSubProcess = cms.untracked.bool(options.concurrent)
+)
+
+copyProcess.intProducer = cms.EDProducer("IntProducer", ivalue = cms.int32(10))
+
+copyProcess.a2 = cms.EDAnalyzer("TestFindProduct",
+  inputTags = cms.untracked.VInputTag( cms.InputTag("intProducer", "", "CFIRST") ),
+  expectedSum = cms.untracked.int32(3)
+)
+
+copyProcess.p = cms.Path(copyProcess.intProducer)
+copyProcess.e = cms.EndPath(copyProcess.a2)
+
+# ---------------------------------------------------------------
+
+readProcess = cms.Process("CREAD")
+copyProcess.subProcess = cms.SubProcess(readProcess)
+
+readProcess.a3 = cms.EDAnalyzer("TestFindProduct",
+  inputTags = cms.untracked.VInputTag( cms.InputTag("intProducer", "", "CFIRST"),
+                                       cms.InputTag("intProducer", "", "CCOPY") ),
+  expectedSum = cms.untracked.int32(33)
+)
+
+readProcess.dump = cms.EDAnalyzer("EventContentAnalyzer",
+    indentation = cms.untracked.string('READ++'),
+    getData = cms.untracked.bool(True),
+    verboseForModuleLabels = cms.untracked.vstring('intProducer')
+)
+
+readProcess.e = cms.EndPath(readProcess.a3+readProcess.dump)
@@ -132,6 +132,14 @@ CacheParser::read(std::istream& iIn,
   
   PluginInfo info;
 
+  //the number of entries of each category before this file
+  std::map<std::string, size_t> previousSizes;
+  for(CacheParser::CategoryToInfos::const_iterator it = iOut.begin(), itEnd=iOut.end();
+      it != itEnd;
+      ++it) {
+    previousSizes[it->first] = it->second.size();
+  }
+
   while(iIn) {
     ++recordNumber;
     if( not readline(iIn,iDirectory,recordNumber,info,pluginType) ) {
@@ -140,10 +148,20 @@ CacheParser::read(std::istream& iIn,
     iOut[pluginType].push_back(info);
   }
   //now do a sort which preserves any previous order for files
+  // the entries from the previous files are usually already sorted, so only the new ones
+  // are sorted and merged after them
   for(CacheParser::CategoryToInfos::iterator it = iOut.begin(), itEnd=iOut.end();
       it != itEnd;
       ++it) {
-    std::stable_sort(it->second.begin(),it->second.end(), CompPluginInfos());
+    std::vector<PluginInfo>& infos = it->second;
+    std::map<std::string, size_t>::const_iterator itSize = previousSizes.find(it->first);
+    std::vector<PluginInfo>::iterator middle = infos.begin() + (itSize == previousSizes.end() ? 0 : itSize->second);
+    if(not std::is_sorted(infos.begin(), middle, CompPluginInfos())) {
+      std::stable_sort(infos.begin(), infos.end(), CompPluginInfos());
+      continue;
+    }
+    std::stable_sort(middle, infos.end(), CompPluginInfos());
+    std::inplace_merge(infos.begin(), middle, infos.end(), CompPluginInfos());
   }
 }
 
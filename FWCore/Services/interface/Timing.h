@@ -42,6 +42,9 @@ namespace edm {
       void preModule(StreamContext const&, ModuleCallingContext const&);
       void postModule(StreamContext const&, ModuleCallingContext const&);
 
+      void preModuleConstruction(ModuleDescription const&);
+      void postModuleConstruction(ModuleDescription const&);
+
       double curr_job_time_;    // seconds
       double curr_job_cpu_;     // seconds
       //use last run time for determining end of processing
@@ -50,6 +53,9 @@ namespace edm {
       std::vector<double> curr_events_time_;  // seconds
       bool summary_only_;
       bool report_summary_;
+      bool report_module_construction_;
+      double curr_module_construction_time_;  // seconds
+      double sum_module_construction_time_;   // seconds
 
       //
       // Min Max and total event times for each Stream.
@@ -0,0 +1,180 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Services
+// Class  :     ModuleAllocationMonitor
+//
+// Implementation:
+//     The allocator interposer preloaded with
+//     libFWCoreServicesAllocationInterposer.so adds the size of each block
+//     allocated or freed to the counters of the module call running on the
+//     thread. The counters are pushed on a per thread stack so unscheduled
+//     modules run from inside another module are accounted for separately.
+//
+
+// system include files
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+#include <dlfcn.h>
+
+// user include files
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/Services/plugins/preload/ModuleAllocationInterposer.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+
+namespace {
+  typedef ModuleAllocationCounts AllocationCounts;
+
+  thread_local std::deque<AllocationCounts> t_moduleCalls;
+
+  template<typename T>
+  void atomicMax(std::atomic<T>& ioMax, T iValue) {
+    T old = ioMax.load();
+    while(old < iValue and not ioMax.compare_exchange_weak(old, iValue)) {}
+  }
+}
+
+namespace edm {
+  namespace service {
+    class ModuleAllocationMonitor {
+    public:
+      ModuleAllocationMonitor(ParameterSet const& iConfig, ActivityRegistry& iRegistry);
+      ~ModuleAllocationMonitor();
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+      struct ModuleStats {
+        std::string label_;
+        std::string type_;
+        std::atomic<unsigned long long> nCalls_{0};
+        std::atomic<unsigned long long> nAllocations_{0};
+        std::atomic<unsigned long long> bytes_{0};
+        std::atomic<long long> maxBytes_{0};
+        std::atomic<long long> maxPeakLive_{0};
+      };
+
+      void postModuleConstruction(ModuleDescription const&);
+      void preModuleEvent(StreamContext const&, ModuleCallingContext const&);
+      void postModuleEvent(StreamContext const&, ModuleCallingContext const&);
+      void postEndJob();
+
+      long long const reportThreshold_;
+      std::vector<std::unique_ptr<ModuleStats>> modules_;
+      ModuleAllocationInterposerSetThreadCounts setThreadCounts_;
+    };
+
+    ModuleAllocationMonitor::ModuleAllocationMonitor(ParameterSet const& iConfig, ActivityRegistry& iRegistry) :
+      reportThreshold_(static_cast<long long>(iConfig.getUntrackedParameter<unsigned int>("reportThresholdKB")) * 1024),
+      modules_(),
+      setThreadCounts_(reinterpret_cast<ModuleAllocationInterposerSetThreadCounts>(dlsym(RTLD_DEFAULT, MODULE_ALLOCATION_INTERPOSER_SET_THREAD_COUNTS))) {
+      if(not setThreadCounts_) {
+        LogWarning("ModuleAllocationMonitor") << "The allocator interposer is not loaded, no allocations will be recorded.\n"
+                                              << "Run the job with LD_PRELOAD=libFWCoreServicesAllocationInterposer.so, e.g. through RunAllocationMonitor.sh.";
+        return;
+      }
+      iRegistry.watchPostModuleConstruction(this, &ModuleAllocationMonitor::postModuleConstruction);
+      iRegistry.watchPreModuleEvent(this, &ModuleAllocationMonitor::preModuleEvent);
+      iRegistry.watchPostModuleEvent(this, &ModuleAllocationMonitor::postModuleEvent);
+      iRegistry.watchPostEndJob(this, &ModuleAllocationMonitor::postEndJob);
+    }
+
+    ModuleAllocationMonitor::~ModuleAllocationMonitor() {
+    }
+
+    void
+    ModuleAllocationMonitor::postModuleConstruction(ModuleDescription const& iDesc) {
+      //modules are constructed one at a time before any event is processed
+      if(iDesc.id() >= modules_.size()) {
+        modules_.resize(iDesc.id() + 1);
+      }
+      std::unique_ptr<ModuleStats> stats(new ModuleStats);
+      stats->label_ = iDesc.moduleLabel();
+      stats->type_ = iDesc.moduleName();
+      modules_[iDesc.id()] = std::move(stats);
+    }
+
+    void
+    ModuleAllocationMonitor::preModuleEvent(StreamContext const&, ModuleCallingContext const&) {
+      //the allocations of the stack itself are not counted
+      setThreadCounts_(nullptr);
+      t_moduleCalls.emplace_back();
+      setThreadCounts_(&t_moduleCalls.back());
+    }
+
+    void
+    ModuleAllocationMonitor::postModuleEvent(StreamContext const& iStream, ModuleCallingContext const& iModule) {
+      setThreadCounts_(nullptr);
+      if(t_moduleCalls.empty()) {
+        return;
+      }
+      AllocationCounts const counts = t_moduleCalls.back();
+      t_moduleCalls.pop_back();
+
+      unsigned int const id = iModule.moduleDescription()->id();
+      if(id < modules_.size() and modules_[id]) {
+        ModuleStats& stats = *modules_[id];
+        ++stats.nCalls_;
+        stats.nAllocations_ += counts.nAllocations;
+        stats.bytes_ += counts.allocated;
+        atomicMax(stats.maxBytes_, counts.allocated);
+        atomicMax(stats.maxPeakLive_, counts.peakLive);
+        if(reportThreshold_ > 0 and counts.peakLive >= reportThreshold_) {
+          LogWarning("ModuleAllocationMonitor") << "Module " << stats.label_ << " (" << stats.type_ << ") in event "
+                                                << iStream.eventID() << " reached " << counts.peakLive / 1024
+                                                << " kB of live allocations, " << counts.allocated / 1024 << " kB allocated in "
+                                                << counts.nAllocations << " allocations";
+        }
+      }
+      setThreadCounts_(t_moduleCalls.empty() ? nullptr : &t_moduleCalls.back());
+    }
+
+    void
+    ModuleAllocationMonitor::postEndJob() {
+      LogAbsolute report("ModuleAllocationReport");
+      report << "ModuleAllocationReport> per module allocations during events\n"
+             << std::setw(12) << "events" << std::setw(16) << "allocs/event" << std::setw(16) << "kB/event"
+             << std::setw(16) << "max kB/event" << std::setw(16) << "max peak kB" << "  module\n";
+      for(auto const& module : modules_) {
+        if(not module or module->nCalls_ == 0) {
+          continue;
+        }
+        double const nCalls = module->nCalls_;
+        report << std::setw(12) << module->nCalls_
+               << std::setw(16) << std::fixed << std::setprecision(1) << module->nAllocations_ / nCalls
+               << std::setw(16) << module->bytes_ / nCalls / 1024.
+               << std::setw(16) << module->maxBytes_ / 1024.
+               << std::setw(16) << module->maxPeakLive_ / 1024.
+               << "  " << module->label_ << " (" << module->type_ << ")\n";
+      }
+    }
+
+    void
+    ModuleAllocationMonitor::fillDescriptions(ConfigurationDescriptions& descriptions) {
+      ParameterSetDescription desc;
+      desc.addUntracked<unsigned int>("reportThresholdKB", 0)->setComment("If non-zero, report each module call whose live allocations reach this many kB during an event.");
+      descriptions.add("ModuleAllocationMonitor", desc);
+    }
+  }
+}
+
+using edm::service::ModuleAllocationMonitor;
+
+//the allocator interposer is global to the process
+inline
+bool isProcessWideService(ModuleAllocationMonitor const*) {
+  return true;
+}
+
+DEFINE_FWK_SERVICE(ModuleAllocationMonitor);
@@ -0,0 +1,238 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Services
+// Class  :     ModuleEventTrace
+//
+// Implementation:
+//     The begin and end of the source, event and module calls are appended
+//     with a steady_clock time stamp to a buffer of the thread running them,
+//     no message is formatted during the job. A buffer is appended to a
+//     binary file each time it holds bufferSize records, and at the end of
+//     the job. The file can be turned into a per thread timeline to look at
+//     the scheduling of the modules and the idle threads:
+//
+//       char[8]   "EDMTRACE"
+//       uint32    version (2)
+//       uint32    number of modules, followed for each of them by
+//                   uint32 id, uint16 label size, label
+//       blocks of
+//         uint32  number of records, followed by records of
+//                   uint64 nanoseconds since the begin of the job
+//                   uint32 module id (0xffffffff for the source and events)
+//                   uint32 stream
+//                   uint32 thread
+//                   uint8  kind (see Kind)
+//       uint32    0, which ends the file
+//
+//     The blocks of the different threads are interleaved. All the numbers
+//     are in the byte order of the machine which wrote them.
+//
+
+// system include files
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// user include files
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/Utilities/interface/StreamID.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+
+namespace edm {
+  namespace service {
+    class ModuleEventTrace {
+    public:
+      ModuleEventTrace(ParameterSet const& iConfig, ActivityRegistry& iRegistry);
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+      enum Kind : uint8_t { kPreSource, kPostSource, kPreEvent, kPostEvent, kPreModule, kPostModule };
+
+      struct Record {
+        uint64_t time_;
+        uint32_t module_;
+        uint32_t stream_;
+        uint32_t thread_;
+        Kind kind_;
+      };
+
+      // one per thread; only ever filled and written by its thread until the end of the job
+      struct Buffer {
+        std::vector<Record> records_;
+        uint32_t thread_;
+      };
+
+      void record(Kind iKind, unsigned int iStream, uint32_t iModule);
+      Buffer& threadBuffer();
+      void write(Buffer& iBuffer);
+
+      void postModuleConstruction(ModuleDescription const&);
+      void postBeginJob();
+      void postEndJob();
+
+      std::string const fileName_;
+      std::size_t const bufferSize_;
+      std::chrono::steady_clock::time_point const begin_;
+      std::vector<std::pair<uint32_t, std::string>> modules_;
+      std::mutex buffersMutex_;
+      std::vector<std::unique_ptr<Buffer>> buffers_;
+      std::mutex fileMutex_;
+      std::ofstream file_;
+      uint64_t nRecords_;
+    };
+
+    namespace {
+      struct ThreadBuffer {
+        void const* owner_ = nullptr;
+        void* buffer_ = nullptr;
+      };
+      thread_local ThreadBuffer t_buffer;
+
+      uint32_t const kNoModule = 0xffffffff;
+    }
+
+    ModuleEventTrace::ModuleEventTrace(ParameterSet const& iConfig, ActivityRegistry& iRegistry) :
+      fileName_(iConfig.getUntrackedParameter<std::string>("fileName")),
+      bufferSize_(iConfig.getUntrackedParameter<unsigned int>("bufferSize")),
+      begin_(std::chrono::steady_clock::now()),
+      nRecords_(0) {
+      iRegistry.watchPostModuleConstruction(this, &ModuleEventTrace::postModuleConstruction);
+      iRegistry.watchPostBeginJob(this, &ModuleEventTrace::postBeginJob);
+      iRegistry.watchPostEndJob(this, &ModuleEventTrace::postEndJob);
+
+      iRegistry.watchPreSourceEvent([this](StreamID iStream) { record(kPreSource, iStream.value(), kNoModule); });
+      iRegistry.watchPostSourceEvent([this](StreamID iStream) { record(kPostSource, iStream.value(), kNoModule); });
+      iRegistry.watchPreEvent([this](StreamContext const& iStream) {
+        record(kPreEvent, iStream.streamID().value(), kNoModule);
+      });
+      iRegistry.watchPostEvent([this](StreamContext const& iStream) {
+        record(kPostEvent, iStream.streamID().value(), kNoModule);
+      });
+      iRegistry.watchPreModuleEvent([this](StreamContext const& iStream, ModuleCallingContext const& iModule) {
+        record(kPreModule, iStream.streamID().value(), iModule.moduleDescription()->id());
+      });
+      iRegistry.watchPostModuleEvent([this](StreamContext const& iStream, ModuleCallingContext const& iModule) {
+        record(kPostModule, iStream.streamID().value(), iModule.moduleDescription()->id());
+      });
+    }
+
+    ModuleEventTrace::Buffer&
+    ModuleEventTrace::threadBuffer() {
+      if(t_buffer.owner_ != this) {
+        std::unique_ptr<Buffer> buffer(new Buffer);
+        buffer->records_.reserve(bufferSize_);
+        std::lock_guard<std::mutex> guard(buffersMutex_);
+        buffer->thread_ = buffers_.size();
+        t_buffer.buffer_ = buffer.get();
+        t_buffer.owner_ = this;
+        buffers_.push_back(std::move(buffer));
+      }
+      return *static_cast<Buffer*>(t_buffer.buffer_);
+    }
+
+    void
+    ModuleEventTrace::record(Kind iKind, unsigned int iStream, uint32_t iModule) {
+      auto const time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin_).count();
+      Buffer& buffer = threadBuffer();
+      buffer.records_.push_back(Record{static_cast<uint64_t>(time), iModule, iStream, buffer.thread_, iKind});
+      if(buffer.records_.size() >= bufferSize_) {
+        write(buffer);
+      }
+    }
+
+    void
+    ModuleEventTrace::write(Buffer& iBuffer) {
+      if(iBuffer.records_.empty()) {
+        return;
+      }
+      std::lock_guard<std::mutex> guard(fileMutex_);
+      //records from before the begin of the job are kept until the file is open
+      if(not file_.is_open()) {
+        return;
+      }
+      auto write = [this](void const* iData, std::size_t iSize) {
+        file_.write(static_cast<char const*>(iData), iSize);
+      };
+      uint32_t const nRecords = iBuffer.records_.size();
+      write(&nRecords, sizeof(nRecords));
+      for(auto const& r : iBuffer.records_) {
+        write(&r.time_, sizeof(r.time_));
+        write(&r.module_, sizeof(r.module_));
+        write(&r.stream_, sizeof(r.stream_));
+        write(&r.thread_, sizeof(r.thread_));
+        write(&r.kind_, sizeof(r.kind_));
+      }
+      nRecords_ += nRecords;
+      iBuffer.records_.clear();
+    }
+
+    void
+    ModuleEventTrace::postModuleConstruction(ModuleDescription const& iDesc) {
+      //modules are constructed one at a time before any event is processed
+      modules_.emplace_back(iDesc.id(), iDesc.moduleLabel());
+    }
+
+    void
+    ModuleEventTrace::postBeginJob() {
+      //all the modules have been constructed
+      std::lock_guard<std::mutex> guard(fileMutex_);
+      file_.open(fileName_, std::ios::binary);
+      auto write = [this](void const* iData, std::size_t iSize) {
+        file_.write(static_cast<char const*>(iData), iSize);
+      };
+      uint32_t const version = 2;
+      uint32_t const nModules = modules_.size();
+      write("EDMTRACE", 8);
+      write(&version, sizeof(version));
+      write(&nModules, sizeof(nModules));
+      for(auto const& module : modules_) {
+        uint16_t const size = module.second.size();
+        write(&module.first, sizeof(module.first));
+        write(&size, sizeof(size));
+        write(module.second.data(), size);
+      }
+    }
+
+    void
+    ModuleEventTrace::postEndJob() {
+      //no other thread records anything anymore
+      std::lock_guard<std::mutex> guard(buffersMutex_);
+      for(auto& buffer : buffers_) {
+        write(*buffer);
+      }
+      uint32_t const end = 0;
+      file_.write(reinterpret_cast<char const*>(&end), sizeof(end));
+      file_.close();
+      if(not file_) {
+        LogError("ModuleEventTrace") << "Could not write the trace file " << fileName_;
+        return;
+      }
+      LogInfo("ModuleEventTrace") << "Wrote " << nRecords_ << " records from " << buffers_.size()
+                                  << " threads to " << fileName_;
+    }
+
+    void
+    ModuleEventTrace::fillDescriptions(ConfigurationDescriptions& descriptions) {
+      ParameterSetDescription desc;
+      desc.addUntracked<std::string>("fileName", "moduleEventTrace.bin")->setComment("Name of the binary trace file.");
+      desc.addUntracked<unsigned int>("bufferSize", 1 << 16)->setComment("Number of records each thread keeps in memory before appending them to the file.");
+      descriptions.add("ModuleEventTrace", desc);
+    }
+  }
+}
+
+using edm::service::ModuleEventTrace;
+
+DEFINE_FWK_SERVICE(ModuleEventTrace);
@@ -0,0 +1,123 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Services
+// Class  :     ModuleAllocationInterposer
+//
+// Implementation:
+//     Replaces the C allocation functions when preloaded with LD_PRELOAD and
+//     forwards them to the glibc implementations. The size of a block is only
+//     looked up when the thread has counters set, so threads outside of a
+//     monitored module call only pay for one thread local load.
+//
+
+// system include files
+#include <cerrno>
+#include <cstddef>
+#include <malloc.h>
+
+// user include files
+#include "FWCore/Services/plugins/preload/ModuleAllocationInterposer.h"
+
+extern "C" {
+  void* __libc_malloc(size_t);
+  void* __libc_calloc(size_t, size_t);
+  void* __libc_realloc(void*, size_t);
+  void* __libc_memalign(size_t, size_t);
+  void* __libc_valloc(size_t);
+  void* __libc_pvalloc(size_t);
+  void __libc_free(void*);
+}
+
+namespace {
+  // initial-exec so that the allocation functions never need the dynamic TLS allocator
+  __thread ModuleAllocationCounts* t_counts __attribute__((tls_model("initial-exec"))) = nullptr;
+
+  inline void addAllocation(void* iPtr) {
+    ModuleAllocationCounts* counts = t_counts;
+    if(counts and iPtr) {
+      long long size = malloc_usable_size(iPtr);
+      counts->allocated += size;
+      counts->live += size;
+      ++counts->nAllocations;
+      if(counts->live > counts->peakLive) {
+        counts->peakLive = counts->live;
+      }
+    }
+  }
+
+  inline void removeAllocation(void* iPtr) {
+    ModuleAllocationCounts* counts = t_counts;
+    if(counts and iPtr) {
+      counts->live -= static_cast<long long>(malloc_usable_size(iPtr));
+    }
+  }
+}
+
+extern "C" {
+  void moduleAllocationInterposer_setThreadCounts(ModuleAllocationCounts* iCounts) {
+    t_counts = iCounts;
+  }
+
+  void* malloc(size_t iSize) {
+    void* ptr = __libc_malloc(iSize);
+    addAllocation(ptr);
+    return ptr;
+  }
+
+  void* calloc(size_t iN, size_t iSize) {
+    void* ptr = __libc_calloc(iN, iSize);
+    addAllocation(ptr);
+    return ptr;
+  }
+
+  void* realloc(void* iOld, size_t iSize) {
+    ModuleAllocationCounts* counts = t_counts;
+    long long oldSize = (counts and iOld) ? malloc_usable_size(iOld) : 0;
+    void* ptr = __libc_realloc(iOld, iSize);
+    //a failed realloc leaves the old block allocated
+    if(counts and (ptr or iSize == 0)) {
+      counts->live -= oldSize;
+    }
+    addAllocation(ptr);
+    return ptr;
+  }
+
+  void* memalign(size_t iAlignment, size_t iSize) {
+    void* ptr = __libc_memalign(iAlignment, iSize);
+    addAllocation(ptr);
+    return ptr;
+  }
+
+  void* aligned_alloc(size_t iAlignment, size_t iSize) {
+    return memalign(iAlignment, iSize);
+  }
+
+  int posix_memalign(void** oPtr, size_t iAlignment, size_t iSize) {
+    if(iAlignment % sizeof(void*) != 0 or (iAlignment & (iAlignment - 1)) != 0) {
+      return EINVAL;
+    }
+    void* ptr = memalign(iAlignment, iSize);
+    if(not ptr) {
+      return ENOMEM;
+    }
+    *oPtr = ptr;
+    return 0;
+  }
+
+  void* valloc(size_t iSize) {
+    void* ptr = __libc_valloc(iSize);
+    addAllocation(ptr);
+    return ptr;
+  }
+
+  void* pvalloc(size_t iSize) {
+    void* ptr = __libc_pvalloc(iSize);
+    addAllocation(ptr);
+    return ptr;
+  }
+
+  void free(void* iPtr) {
+    removeAllocation(iPtr);
+    __libc_free(iPtr);
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef FWCore_Services_ModuleAllocationInterposer_h
+#define FWCore_Services_ModuleAllocationInterposer_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Services
+// Class  :     ModuleAllocationInterposer
+//
+/**\class ModuleAllocationInterposer ModuleAllocationInterposer.h "FWCore/Services/plugins/preload/ModuleAllocationInterposer.h"
+
+ Description: Interface between the allocator interposer preloaded with
+ libFWCoreServicesAllocationInterposer.so and the ModuleAllocationMonitor
+ service.
+
+ Usage:
+    The service looks up moduleAllocationInterposer_setThreadCounts with
+    dlsym. Each allocation and free made on a thread is added to the
+    counters last set for that thread; nothing is recorded while they are
+    null.
+
+*/
+
+extern "C" {
+  struct ModuleAllocationCounts {
+    long long allocated;
+    long long live;
+    long long peakLive;
+    unsigned long long nAllocations;
+  };
+
+  typedef void (*ModuleAllocationInterposerSetThreadCounts)(ModuleAllocationCounts*);
+
+  void moduleAllocationInterposer_setThreadCounts(ModuleAllocationCounts*);
+}
+
+#define MODULE_ALLOCATION_INTERPOSER_SET_THREAD_COUNTS "moduleAllocationInterposer_setThreadCounts"
+
+#endif
@@ -116,6 +116,10 @@ namespace edm {
           m_cacheTempDirPtr(nullptr),
           m_cacheMinFree(),
           m_cacheMinFreePtr(nullptr),
+          m_blockCacheDir(),
+          m_blockCacheDirPtr(nullptr),
+          m_blockCacheMaxSize(),
+          m_blockCacheMaxSizePtr(nullptr),
           m_cacheHint(),
           m_cacheHintPtr(nullptr),
           m_cloneCacheHint(),
@@ -147,6 +151,8 @@ namespace edm {
         //apply overrides
         overrideFromPSet("overrideSourceCacheTempDir", pset, m_cacheTempDir, m_cacheTempDirPtr);
         overrideFromPSet("overrideSourceCacheMinFree", pset, m_cacheMinFree, m_cacheMinFreePtr);
+        overrideFromPSet("overrideSourceBlockCacheDir", pset, m_blockCacheDir, m_blockCacheDirPtr);
+        overrideFromPSet("overrideSourceBlockCacheMaxSize", pset, m_blockCacheMaxSize, m_blockCacheMaxSizePtr);
         overrideFromPSet("overrideSourceCacheHintDir", pset, m_cacheHint, m_cacheHintPtr);
         overrideFromPSet("overrideSourceCloneCacheHintDir", pset, m_cloneCacheHint, m_cloneCacheHintPtr);
         overrideFromPSet("overrideSourceReadHint", pset, m_readHint, m_readHintPtr);
@@ -293,6 +299,16 @@ namespace edm {
        return m_cacheMinFreePtr;
     }
 
+    std::string const*
+    SiteLocalConfigService::sourceBlockCacheDir() const {
+       return m_blockCacheDirPtr;
+    }
+
+    double const*
+    SiteLocalConfigService::sourceBlockCacheMaxSize() const {
+       return m_blockCacheMaxSizePtr;
+    }
+
     std::string const*
     SiteLocalConfigService::sourceCacheHint() const {
        return m_cacheHintPtr;
@@ -377,6 +393,7 @@ namespace edm {
         //   </calib-data>
             //   <source-config>
             //     <cache-temp-dir name="/a/b/c"/>
+            //     <block-cache dir="/a/b/c" max-size="100"/>
             //     <cache-hint value="..."/>
             //     <read-hint value="..."/>
             //     <ttree-cache-size value="0"/>
@@ -461,6 +478,19 @@ namespace edm {
                 m_cacheMinFreePtr = &m_cacheMinFree;
               }
 
+              DOMNodeList *blockCacheList = sourceConfig->getElementsByTagName(_toDOMS("block-cache"));
+
+              if (blockCacheList->getLength() > 0) {
+                DOMElement *blockCache = static_cast<DOMElement *>(blockCacheList->item(0));
+                m_blockCacheDir = _toString(blockCache->getAttribute(_toDOMS("dir")));
+                m_blockCacheDirPtr = &m_blockCacheDir;
+                std::string maxSize = _toString(blockCache->getAttribute(_toDOMS("max-size")));
+                if (!maxSize.empty()) {
+                  m_blockCacheMaxSize = _toDouble(blockCache->getAttribute(_toDOMS("max-size")));
+                  m_blockCacheMaxSizePtr = &m_blockCacheMaxSize;
+                }
+              }
+
               DOMNodeList *cacheHintList = sourceConfig->getElementsByTagName(_toDOMS("cache-hint"));
 
               if (cacheHintList->getLength() > 0) {
@@ -576,6 +606,10 @@ namespace edm {
 
       desc.addOptionalUntracked<std::string>("overrideSourceCacheTempDir");
       desc.addOptionalUntracked<double>("overrideSourceCacheMinFree");
+      desc.addOptionalUntracked<std::string>("overrideSourceBlockCacheDir")
+        ->setComment("Directory of the node-wide block cache shared by all jobs reading remote files.");
+      desc.addOptionalUntracked<double>("overrideSourceBlockCacheMaxSize")
+        ->setComment("Size limit in GB of the node-wide block cache.");
       desc.addOptionalUntracked<std::string>("overrideSourceCacheHintDir");
       desc.addOptionalUntracked<std::string>("overrideSourceCloneCacheHintDir")
         ->setComment("Provide an alternate cache hint for fast cloning.");
@@ -31,6 +31,8 @@ namespace edm {
 
             std::string const* sourceCacheTempDir() const override;
             double const* sourceCacheMinFree() const override;
+            std::string const* sourceBlockCacheDir() const override;
+            double const* sourceBlockCacheMaxSize() const override;
             std::string const* sourceCacheHint() const override;
             std::string const* sourceCloneCacheHint() const override;
             std::string const* sourceReadHint() const override;
@@ -63,6 +65,10 @@ namespace edm {
             std::string const*  m_cacheTempDirPtr;
             double              m_cacheMinFree;
             double const*       m_cacheMinFreePtr;
+            std::string         m_blockCacheDir;
+            std::string const*  m_blockCacheDirPtr;
+            double              m_blockCacheMaxSize;
+            double const*       m_blockCacheMaxSizePtr;
             std::string         m_cacheHint;
             std::string const*  m_cacheHintPtr;
             std::string         m_cloneCacheHint;
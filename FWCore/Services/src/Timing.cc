@@ -71,6 +71,9 @@ namespace edm {
         curr_events_time_(),
         summary_only_(iPS.getUntrackedParameter<bool>("summaryOnly")),
         report_summary_(iPS.getUntrackedParameter<bool>("useJobReport")),
+        report_module_construction_(iPS.getUntrackedParameter<bool>("reportModuleConstruction")),
+        curr_module_construction_time_(0.),
+        sum_module_construction_time_(0.),
         max_events_time_(),
         min_events_time_(),
         total_event_count_(0) {
@@ -84,6 +87,11 @@ namespace edm {
         iRegistry.watchPreModuleEvent(this, &Timing::preModule);
         iRegistry.watchPostModuleEvent(this, &Timing::postModule);
       }
+
+      if(report_module_construction_) {
+        iRegistry.watchPreModuleConstruction(this, &Timing::preModuleConstruction);
+        iRegistry.watchPostModuleConstruction(this, &Timing::postModuleConstruction);
+      }
           
       iRegistry.preallocateSignal_.connect([this](service::SystemBounds const& iBounds){
         auto nStreams = iBounds.maxNumberOfStreams();
@@ -114,6 +122,8 @@ namespace edm {
       "If 'true' do not report timing for each event");
       desc.addUntracked<bool>("useJobReport", true)->setComment(
        "If 'true' write summary information to JobReport");
+      desc.addUntracked<bool>("reportModuleConstruction", false)->setComment(
+       "If 'true' report the time it takes to construct each module");
       descriptions.add("Timing", desc);
       descriptions.setComment(
        "This service reports the time it takes to run each module in a job.");
@@ -132,6 +142,10 @@ namespace edm {
         << "eventnum runnum modulelabel modulename timetakeni\n"
         << "TimeReport> JobTime=" << curr_job_time_  << " JobCPU=" << curr_job_cpu_  << "\n";
       }
+      if(report_module_construction_) {
+        LogImportant("TimeReport")
+        << "TimeReport> Module construction took " << sum_module_construction_time_ << " seconds\n";
+      }
     }
 
     void Timing::postEndJob() {
@@ -232,6 +246,20 @@ namespace edm {
       << desc.moduleName() << " "
       << t;
     }
+
+    // the modules are constructed one at a time, before the job starts
+    void Timing::preModuleConstruction(ModuleDescription const&) {
+      curr_module_construction_time_ = getTime();
+    }
+
+    void Timing::postModuleConstruction(ModuleDescription const& iDescription) {
+      double t = getTime() - curr_module_construction_time_;
+      sum_module_construction_time_ += t;
+      LogPrint("TimeModuleConstruction") << "TimeModuleConstruction> "
+      << iDescription.moduleLabel() << " "
+      << iDescription.moduleName() << " "
+      << t;
+    }
   }
 }
 
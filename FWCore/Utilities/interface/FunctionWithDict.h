@@ -27,6 +27,9 @@ class FunctionWithDict {
 private:
   TMethod* function_;
 public:
+  /// the compiled wrapper used by invoke(): wrapper(object address, number of arguments, arguments, return value address)
+  typedef void (*Wrapper)(void*, int, void**, void*);
+
   FunctionWithDict();
   explicit FunctionWithDict(TMethod*);
   explicit operator bool() const;
@@ -44,6 +47,8 @@ public:
   size_t size() const;
   void invoke(ObjectWithDict const& obj, ObjectWithDict* ret = nullptr, std::vector<void*> const& values = std::vector<void*>()) const;
   void invoke(ObjectWithDict* ret = nullptr, std::vector<void*> const& values = std::vector<void*>()) const;
+  /// nullptr if the interpreter cannot provide it
+  Wrapper wrapper() const;
   IterWithDict<TMethodArg> begin() const;
   IterWithDict<TMethodArg> end() const;
 };
@@ -0,0 +1,17 @@
+#ifndef FWCore_Utilities_NumaTopology_h
+#define FWCore_Utilities_NumaTopology_h
+
+// NUMA topology of the machine, as reported by the kernel in /sys/devices/system/node.
+// Without NUMA support (or outside of linux) there is a single node, numbered 0.
+
+namespace edm {
+  namespace numa {
+    unsigned int numberOfNodes();
+    int nodeOfCpu(int cpu);
+    int currentNode();
+    // bind the calling thread to all the CPUs of the given node
+    bool bindToNode(unsigned int node);
+  }
+}
+
+#endif
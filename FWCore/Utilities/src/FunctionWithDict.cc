@@ -121,6 +121,14 @@ namespace edm {
     gInterpreter->ExecuteWithArgsAndReturn(function_, nullptr, data, values.size(), ret->address());
   }
 
+  FunctionWithDict::Wrapper
+  FunctionWithDict::wrapper() const {
+    if (function_ == nullptr) {
+      return nullptr;
+    }
+    return reinterpret_cast<Wrapper>(function_->InterfaceMethod());
+  }
+
   IterWithDict<TMethodArg>
   FunctionWithDict::begin() const {
     if (function_ == nullptr) {
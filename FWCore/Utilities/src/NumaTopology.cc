@@ -0,0 +1,89 @@
+#include "FWCore/Utilities/interface/NumaTopology.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux
+#include <sched.h>
+
+namespace {
+  struct Topology {
+    Topology();
+    unsigned int nodes_;
+    std::vector<int> cpuNode_;   // -1 for the CPUs not listed under any node
+  };
+
+  Topology::Topology() : nodes_(0), cpuNode_(CPU_SETSIZE, -1) {
+    while (true) {
+      std::ostringstream name;
+      name << "/sys/devices/system/node/node" << nodes_ << "/cpulist";
+      std::ifstream cpulist(name.str().c_str());
+      if (not cpulist) break;
+      // the list has the format "0-7,16-23"
+      std::string range;
+      while (std::getline(cpulist, range, ',')) {
+        int first = 0, last = 0;
+        char dash = 0;
+        std::istringstream parse(range);
+        if (not (parse >> first)) continue;
+        if (not (parse >> dash >> last)) last = first;
+        for (int cpu = first; cpu <= last and cpu < CPU_SETSIZE; ++cpu) cpuNode_[cpu] = nodes_;
+      }
+      ++nodes_;
+    }
+    if (nodes_ == 0) nodes_ = 1;
+  }
+
+  Topology const& topology() {
+    static const Topology topology;
+    return topology;
+  }
+}
+#endif
+
+namespace edm {
+  namespace numa {
+    unsigned int numberOfNodes() {
+#ifdef __linux
+      return topology().nodes_;
+#else
+      return 1;
+#endif
+    }
+
+    int nodeOfCpu(int cpu) {
+#ifdef __linux
+      Topology const& t = topology();
+      if (cpu < 0 or cpu >= (int) t.cpuNode_.size() or t.cpuNode_[cpu] < 0) return 0;
+      return t.cpuNode_[cpu];
+#else
+      return 0;
+#endif
+    }
+
+    int currentNode() {
+#ifdef __linux
+      return nodeOfCpu(sched_getcpu());
+#else
+      return 0;
+#endif
+    }
+
+    bool bindToNode(unsigned int node) {
+#ifdef __linux
+      Topology const& t = topology();
+      if (node >= t.nodes_) return false;
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      for (unsigned int cpu = 0; cpu < t.cpuNode_.size(); ++cpu)
+        if (t.cpuNode_[cpu] == (int) node) CPU_SET(cpu, &cpuSet);
+      if (CPU_COUNT(&cpuSet) == 0) return false;
+      return sched_setaffinity(0, sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+      return false;
+#endif
+    }
+  }
+}
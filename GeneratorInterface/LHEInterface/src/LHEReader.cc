@@ -256,12 +256,12 @@ void LHEReader::XMLHandler::startElement(const XMLCh *const uri,
     
     npLO = -99;
     npNLO = -99;
-    const XMLCh *npLOval = attributes.getValue(XMLString::transcode("npLO"));
+    const XMLCh *npLOval = attributes.getValue(XMLUniStr("npLO"));
     if (npLOval) {
       const char *npLOs = XMLSimpleStr(npLOval);      
       sscanf(npLOs,"%d",&npLO);
     }
-    const XMLCh *npNLOval = attributes.getValue(XMLString::transcode("npNLO"));
+    const XMLCh *npNLOval = attributes.getValue(XMLUniStr("npNLO"));
     if (npNLOval) {
       const char *npNLOs = XMLSimpleStr(npNLOval);      
       sscanf(npNLOs,"%d",&npNLO);
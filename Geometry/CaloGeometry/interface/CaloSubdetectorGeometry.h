@@ -69,7 +69,8 @@ class CaloSubdetectorGeometry {
 
       /** \brief Get a list of all cells within a dR of the given cell
 	  
-      The default implementation makes a loop over all cell geometries.
+      The default implementation makes a loop over the cells of an eta-phi grid
+      of the cell positions, built at the first call, around the point.
       Cleverer implementations are suggested to use rough conversions between
       eta/phi and ieta/iphi and test on the boundaries.
       */
@@ -132,12 +133,18 @@ class CaloSubdetectorGeometry {
 
       std::vector<DetId> m_validIds ;
 
+      /// eta-phi grid of the valid cells, for the default getClosestCell and getCells
+      struct CellGrid ;
+      const CellGrid& cellGrid() const ;
+
 #if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__REFLEX__)
       mutable std::atomic<std::vector<CCGFloat>*>  m_deltaPhi ;
       mutable std::atomic<std::vector<CCGFloat>*>  m_deltaEta ;
+      mutable std::atomic<CellGrid*>               m_cellGrid ;
 #else
       mutable std::vector<CCGFloat>*  m_deltaPhi ;
       mutable std::vector<CCGFloat>*  m_deltaEta ;
+      mutable CellGrid*               m_cellGrid ;
 #endif
 };
 
@@ -4,6 +4,9 @@
 #include <Math/Transform3D.h>
 #include <Math/EulerAngles.h>
 
+#include <algorithm>
+#include <cmath>
+
 typedef CaloCellGeometry::Pt3D     Pt3D     ;
 typedef CaloCellGeometry::Pt3DVec  Pt3DVec  ;
 typedef CaloCellGeometry::Tr3D     Tr3D     ;
@@ -14,7 +17,8 @@ CaloSubdetectorGeometry::CaloSubdetectorGeometry() :
    m_parMgr ( 0 ) ,
    m_cmgr   ( 0 ) ,
    m_deltaPhi  (nullptr) ,
-   m_deltaEta  (nullptr)
+   m_deltaEta  (nullptr) ,
+   m_cellGrid  (nullptr)
 {}
 
 
@@ -24,6 +28,7 @@ CaloSubdetectorGeometry::~CaloSubdetectorGeometry()
    delete m_parMgr ; 
    if (m_deltaPhi) delete m_deltaPhi.load() ;
    if (m_deltaEta) delete m_deltaEta.load() ;
+   if (m_cellGrid) delete m_cellGrid.load() ;
 }
 
 void
@@ -52,6 +57,106 @@ CaloSubdetectorGeometry::present( const DetId& id ) const
    return ( 0 != getGeometry( id ) ) ;
 }
 
+// The valid cells with a geometry, by bin of a grid in the eta and phi of
+// their positions; the bins are about square, with a few cells each.
+// A query looks at the bins of the eta-phi box around the point, with one
+// more bin on each side against the rounding: the cells found are the same
+// as with a loop over all the cells.
+struct CaloSubdetectorGeometry::CellGrid
+{
+      CCGFloat etaMin, etaStep, phiStep ;
+      int nEta, nPhi ;
+      std::vector<uint32_t> first ; // of the cells of each bin in cells
+      std::vector<uint32_t> cells ; // index in m_validIds, by bin
+      std::vector<CCGFloat> eta, phi ; // by index in m_validIds
+
+      int etaBin( double x ) const {
+	 const double b ( std::floor( ( x - etaMin )/etaStep ) ) ;
+	 return b < 0 ? 0 : ( b >= nEta ? nEta - 1 : int( b ) ) ;
+      }
+      // not folded into [0,nPhi)
+      int phiBin( double x ) const {
+	 const double b ( std::floor( ( x + M_PI )/phiStep ) ) ;
+	 return b < -nPhi ? -nPhi : ( b > 2*nPhi ? 2*nPhi : int( b ) ) ;
+      }
+      // call f(i) for the cells of the bins around eta and phi
+      template <typename F>
+      void forEachCell( double eta, double phi, double dEta, double dPhi, F f ) const {
+	 const int e0 ( std::max( etaBin( eta - dEta ) - 1, 0 ) ) ;
+	 const int e1 ( std::min( etaBin( eta + dEta ) + 1, nEta - 1 ) ) ;
+	 int p0 ( phiBin( phi - dPhi ) - 1 ) ;
+	 int p1 ( phiBin( phi + dPhi ) + 1 ) ;
+	 if( p1 - p0 + 1 >= nPhi || dPhi >= M_PI )
+	 {
+	    p0 = 0 ;
+	    p1 = nPhi - 1 ;
+	 }
+	 for( int ie ( e0 ) ; ie <= e1 ; ++ie )
+	 {
+	    for( int ip ( p0 ) ; ip <= p1 ; ++ip )
+	    {
+	       const int bin ( ie*nPhi + ( ip%nPhi + nPhi )%nPhi ) ;
+	       for( uint32_t k ( first[bin] ) ; k != first[bin+1] ; ++k ) f( cells[k] ) ;
+	    }
+	 }
+      }
+} ;
+
+const CaloSubdetectorGeometry::CellGrid&
+CaloSubdetectorGeometry::cellGrid() const
+{
+   if( !m_cellGrid.load( std::memory_order_acquire ) )
+   {
+      auto ptr = new CellGrid ;
+      CellGrid& grid ( *ptr ) ;
+      const uint32_t n ( m_validIds.size() ) ;
+      grid.eta.assign( n, 0 ) ;
+      grid.phi.assign( n, 0 ) ;
+      std::vector<uint32_t> found ;
+      found.reserve( n ) ;
+      CCGFloat etaMin ( 0 ), etaMax ( 0 ) ;
+      for( uint32_t i ( 0 ); i != n ; ++i )
+      {
+	 const CaloCellGeometry* cell ( getGeometry( m_validIds[i] ) ) ;
+	 if( 0 != cell )
+	 {
+	    const GlobalPoint& p ( cell->getPosition() ) ;
+	    grid.eta[i] = p.eta() ;
+	    grid.phi[i] = p.phi() ;
+	    if( found.empty() || grid.eta[i] < etaMin ) etaMin = grid.eta[i] ;
+	    if( found.empty() || grid.eta[i] > etaMax ) etaMax = grid.eta[i] ;
+	    found.push_back( i ) ;
+	 }
+      }
+      // about 4 cells per bin
+      const double etaRange ( std::max( double( etaMax - etaMin ), 1.e-3 ) ) ;
+      const double step ( std::sqrt( etaRange*2*M_PI*4/std::max( found.size(), size_t( 1 ) ) ) ) ;
+      grid.etaMin  = etaMin ;
+      grid.nEta    = std::max( 1, std::min( 1000, int( std::ceil( etaRange/step ) ) ) ) ;
+      grid.etaStep = etaRange/grid.nEta ;
+      grid.nPhi    = std::max( 1, std::min( 1000, int( std::ceil( 2*M_PI/step ) ) ) ) ;
+      grid.phiStep = 2*M_PI/grid.nPhi ;
+
+      std::vector<int> bins ( found.size() ) ;
+      grid.first.assign( grid.nEta*grid.nPhi + 1, 0 ) ;
+      for( uint32_t k ( 0 ) ; k != found.size() ; ++k )
+      {
+	 const uint32_t i ( found[k] ) ;
+	 bins[k] = grid.etaBin( grid.eta[i] )*grid.nPhi + std::min( std::max( grid.phiBin( grid.phi[i] ), 0 ), grid.nPhi - 1 ) ;
+	 ++grid.first[ bins[k] + 1 ] ;
+      }
+      for( unsigned int b ( 0 ) ; b + 1 < grid.first.size() ; ++b ) grid.first[b+1] += grid.first[b] ;
+      grid.cells.resize( found.size() ) ;
+      std::vector<uint32_t> next ( grid.first.begin(), grid.first.end() - 1 ) ;
+      for( uint32_t k ( 0 ) ; k != found.size() ; ++k ) grid.cells[ next[ bins[k] ]++ ] = found[k] ;
+
+      CellGrid* expect = nullptr;
+      bool exchanged = m_cellGrid.compare_exchange_strong(expect, ptr, std::memory_order_acq_rel);
+      if (!exchanged) delete ptr;
+   }
+   return *m_cellGrid.load( std::memory_order_acquire ) ;
+}
+
 DetId 
 CaloSubdetectorGeometry::getClosestCell( const GlobalPoint& r ) const 
 {
@@ -60,22 +165,26 @@ CaloSubdetectorGeometry::getClosestCell( const GlobalPoint& r ) const
    uint32_t index ( ~0 ) ;
    CCGFloat closest ( 1e9 ) ;
 
-   for( uint32_t i ( 0 ); i != m_validIds.size() ; ++i ) 
-   {
-      const CaloCellGeometry* cell ( getGeometry( m_validIds[ i ] ) ) ;
-      if( 0 != cell )
+   const CellGrid& grid ( cellGrid() ) ;
+   if( grid.cells.empty() ) return DetId(0) ;
+
+   // the closest cell is at most as far as one in the nearest bins with
+   // cells; among the cells as close, the first of m_validIds is chosen
+   auto closer = [&]( uint32_t i ) {
+      const CCGFloat dR2 ( reco::deltaR2( grid.eta[i], grid.phi[i], eta, phi ) ) ;
+      if( dR2 < closest || ( dR2 == closest && i < index ) )
       {
-	 const GlobalPoint& p ( cell->getPosition() ) ;
-	 const CCGFloat eta0 ( p.eta() ) ;
-	 const CCGFloat phi0 ( p.phi() ) ;
-	 const CCGFloat dR2 ( reco::deltaR2( eta0, phi0, eta, phi ) ) ;
-	 if( dR2 < closest ) 
-	 {
-	    closest = dR2 ;
-	    index   = i   ;
-	 }
+	 closest = dR2 ;
+	 index   = i   ;
       }
+   } ;
+   for( int k ( 0 ) ; (uint32_t)(~0) == index ; k = ( 0 == k ? 1 : 2*k ) )
+   {
+      grid.forEachCell( eta, phi, k*grid.etaStep, k*grid.phiStep, closer ) ;
    }
+   const double dist ( std::sqrt( closest ) ) ;
+   grid.forEachCell( eta, phi, dist, dist, closer ) ;
+
    return ( closest > 0.9e9 ||
 	    (uint32_t)(~0) == index       ? DetId(0) :
 	    m_validIds[index] ) ;
@@ -93,16 +202,12 @@ CaloSubdetectorGeometry::getCells( const GlobalPoint& r,
    
    if( 0.000001 < dR )
    {
-      for( uint32_t i ( 0 ); i != m_validIds.size() ; ++i ) 
-      {
-	 const CaloCellGeometry* cell ( getGeometry( m_validIds[i] ) ) ;
-	 if( 0 != cell )
-	 {
-	    const GlobalPoint& p ( cell->getPosition() ) ;
-	    const CCGFloat eta0 ( p.eta() ) ;
+      const CellGrid& grid ( cellGrid() ) ;
+      grid.forEachCell( eta, phi, dR, dR, [&]( uint32_t i ) {
+	    const CCGFloat eta0 ( grid.eta[i] ) ;
 	    if( fabs( eta - eta0 ) < dR )
 	    {
-	       const CCGFloat phi0 ( p.phi() ) ;
+	       const CCGFloat phi0 ( grid.phi[i] ) ;
 	       CCGFloat delp ( fabs( phi - phi0 ) ) ;
 	       if( delp > M_PI ) delp = 2*M_PI - delp ;
 	       if( delp < dR )
@@ -111,8 +216,7 @@ CaloSubdetectorGeometry::getCells( const GlobalPoint& r,
 		  if( dist2 < dR2 ) dss.insert( m_validIds[i] ) ;
 	       }
 	    }
-	 }
-      }   
+	 } ) ;
    }
    return dss;
 }
@@ -4,6 +4,7 @@
 #include <vector>
 #include <algorithm>
 #include <iterator>
+#include <utility>
 
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
@@ -80,9 +81,9 @@ void GeometryAligner::applyAlignments( C* geometry,
   std::vector<AlignTransform>::const_iterator iAlign = alignments->m_align.begin();
   std::vector<AlignTransformErrorExtended>::const_iterator 
 	iAlignError = alignmentErrors->m_alignError.begin();
-  //copy  geometry->theMap to a real map to order it....
-  std::map<unsigned int, GeomDet const *> theMap;
-  std::copy(geometry->theMap.begin(), geometry->theMap.end(), std::inserter(theMap,theMap.begin()));
+  //copy  geometry->theMap to a vector and sort it by DetId (they are unique)....
+  std::vector<std::pair<unsigned int, GeomDet const *> > theMap(geometry->theMap.begin(), geometry->theMap.end());
+  std::sort(theMap.begin(), theMap.end());
   unsigned int nAPE = 0;
   for ( auto iPair = theMap.begin(); 
 	iPair != theMap.end(); ++iPair, ++iAlign, ++iAlignError )
@@ -132,9 +133,9 @@ void GeometryAligner::attachSurfaceDeformations( C* geometry,
   edm::LogInfo("Alignment") << "@SUB=GeometryAligner::attachSurfaceDeformations" 
 			    << "Starting to attach surface deformations.";
 
-  //copy geometry->theMapUnit to a real map to order it....
-  std::map<unsigned int, GeomDetUnit const*> theMap;
-  std::copy(geometry->theMapUnit.begin(), geometry->theMapUnit.end(), std::inserter(theMap, theMap.begin()));
+  //copy geometry->theMapUnit to a vector and sort it by DetId (they are unique)....
+  std::vector<std::pair<unsigned int, GeomDetUnit const*> > theMap(geometry->theMapUnit.begin(), geometry->theMapUnit.end());
+  std::sort(theMap.begin(), theMap.end());
   
   unsigned int nSurfDef = 0;
   unsigned int itemIndex = 0;
@@ -445,7 +445,8 @@ void TriggerSummaryProducerAOD::fillFilterObjectMembers(const edm::Event& iEvent
   const unsigned int n(min(ids.size(),refs.size()));
   for (unsigned int i=0; i!=n; ++i) {
     const ProductID pid(refs[i].id());
-    if (offset_.find(pid)==offset_.end()) {
+    const std::map<ProductID,unsigned int>::const_iterator offset(offset_.find(pid));
+    if (offset==offset_.end()) {
       const string&    label(iEvent.getProvenance(pid).moduleLabel());
       const string& instance(iEvent.getProvenance(pid).productInstanceName());
       const string&  process(iEvent.getProvenance(pid).processName());
@@ -458,7 +459,7 @@ void TriggerSummaryProducerAOD::fillFilterObjectMembers(const edm::Event& iEvent
 	<< "/" << refs[i].key()
 	<< " CollectionType: " << typeid(C).name();
     } else {
-      fillFilterObjectMember(offset_[pid],ids[i],refs[i]);
+      fillFilterObjectMember(offset->second,ids[i],refs[i]);
     }
   }
   return;
@@ -0,0 +1,100 @@
+#ifndef FastTimerSampler_h
+#define FastTimerSampler_h
+
+// C++ headers
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <signal.h>
+
+/*
+Statistical profiler used by the FastTimerService to look below module granularity.
+
+The process is interrupted by SIGPROF at a fixed period of consumed CPU time; the signal handler
+records the call stack of the interrupted thread together with the module and stream it was
+running at that moment. Samples are kept in a preallocated per-thread buffer, which is folded into
+a per-thread histogram of call stacks outside of the signal handler, when a module finishes running.
+At the end of the job the call stacks are symbolised and written in the "folded" format understood
+by flamegraph.pl, with one root frame per module.
+*/
+
+class FastTimerSampler {
+public:
+  static constexpr int          kNoModule   = -1;       // samples taken outside of any module
+  static constexpr unsigned int kMaxDepth   = 64;       // maximum number of frames recorded per sample
+  static constexpr unsigned int kBufferSize = 4096;     // number of samples buffered per thread
+
+  FastTimerSampler();
+  ~FastTimerSampler();
+
+  // record the label and type of a module, used when writing the summary
+  void describeModule(unsigned int id, std::string const & label, std::string const & type);
+
+  // start and stop the sampling; start() returns false if the sampling could not be enabled
+  bool start(std::chrono::microseconds period);
+  void stop();
+
+  // keep track of the module running on the current thread; the calls can be nested,
+  // e.g. when a module triggers the execution of an unscheduled producer
+  void enterModule(unsigned int id, unsigned int stream);
+  void leaveModule();
+
+  // fold the remaining samples and write them as "module;outer frame;...;inner frame count" lines;
+  // to be called after stop(), once no more modules are running
+  void write(std::ostream & out, bool by_stream);
+
+  // number of samples per module, and number of samples dropped because a buffer was full;
+  // valid after write()
+  std::vector<std::pair<std::string, unsigned long>> moduleSummary() const;
+  unsigned long dropped() const;
+
+private:
+  struct Sample {
+    int                         module;
+    unsigned int                stream;
+    int                         depth;
+    void *                      frames[kMaxDepth];
+  };
+
+  // (module, stream, call stack from the innermost frame)
+  typedef std::tuple<int, unsigned int, std::vector<void *>> StackKey;
+
+  struct ThreadData {
+    std::unique_ptr<Sample[]>   samples;            // written only by the signal handler
+    std::atomic<unsigned int>   size;               // number of valid entries in samples
+    volatile sig_atomic_t       draining;           // the samples are being folded, the handler drops new ones
+    volatile sig_atomic_t       module;             // module currently running on this thread
+    volatile sig_atomic_t       stream;             // stream of the module currently running on this thread
+    unsigned long               dropped;
+    std::vector<std::pair<int, unsigned int>> stack;    // modules whose execution was interrupted by the current one
+    std::map<StackKey, unsigned long>         stacks;   // folded samples
+
+    ThreadData();
+  };
+
+  static void handler(int, siginfo_t *, void *);
+
+  ThreadData & threadData();
+  void fold(ThreadData & data);
+  std::string const & moduleName(int id) const;
+  std::string const & symbol(void * address);
+
+  std::mutex                                    m_mutex;            // protects m_threads and m_modules
+  std::vector<std::unique_ptr<ThreadData>>      m_threads;
+  std::vector<std::string>                      m_modules;
+  std::map<void *, std::string>                 m_symbols;
+  std::map<int, unsigned long>                  m_module_samples;
+  unsigned long                                 m_dropped;
+  unsigned int                                  m_generation;       // distinguishes the per-thread data of different samplers
+  bool                                          m_running;
+  struct sigaction                              m_previous_action;
+};
+
+#endif // ! FastTimerSampler_h
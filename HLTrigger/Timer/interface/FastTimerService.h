@@ -7,6 +7,7 @@
 #include <map>
 #include <unordered_map>
 #include <chrono>
+#include <memory>
 #include <mutex>
 #include <unistd.h>
 
@@ -29,6 +30,7 @@
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
 #include "HLTrigger/Timer/interface/FastTimer.h"
+#include "HLTrigger/Timer/interface/FastTimerSampler.h"
 
 
 /*
@@ -131,6 +133,7 @@ public:
 
 private:
   void preallocate(edm::service::SystemBounds const &);
+  void postBeginJob();
   void postEndJob();
   void preGlobalBeginRun(edm::GlobalContext const &);
   void preStreamBeginRun(edm::StreamContext const &);
@@ -150,6 +153,8 @@ private:
   void postModuleEvent(edm::StreamContext const &, edm::ModuleCallingContext const &);
   void preModuleEventDelayedGet(edm::StreamContext const &, edm::ModuleCallingContext const &);
   void postModuleEventDelayedGet(edm::StreamContext const &, edm::ModuleCallingContext const &);
+  void preModuleEventSampling(edm::StreamContext const &, edm::ModuleCallingContext const &);
+  void postModuleEventSampling(edm::StreamContext const &, edm::ModuleCallingContext const &);
 
 public:
   static void fillDescriptions(edm::ConfigurationDescriptions & descriptions);
@@ -234,6 +239,7 @@ private:
     double                      summary_postmodules;
     double                      summary_overhead;
     double                      summary_total;
+    uint32_t                    summary_slow;       // number of events in which time_active was above the threshold
     uint32_t                    last_run;           // index of the last module run in this path, plus one
     uint32_t                    index;              // index of the Path or EndPath in the "schedule"
     bool                        accept;             // flag indicating if the path acepted the event
@@ -266,6 +272,7 @@ private:
       summary_postmodules(0.),
       summary_overhead(0.),
       summary_total(0.),
+      summary_slow(0),
       last_run(0),
       index(0),
       accept(false),
@@ -302,6 +309,7 @@ private:
       summary_postmodules = 0.;
       summary_overhead = 0.;
       summary_total = 0.;
+      summary_slow = 0;
       last_run = 0;
       index = 0;
       accept = false;
@@ -334,6 +342,7 @@ private:
   bool                                          m_enable_timing_exclusive;
   const bool                                    m_enable_timing_summary;
   const bool                                    m_skip_first_path;
+  const double                                  m_path_time_threshold;          // ms, count the events above it in each path; 0 to disable
 
   // dqm configuration
   bool                                          m_enable_dqm;                   // non const because the availability of the DQMStore can only be checked during the begin job
@@ -362,6 +371,13 @@ private:
   const double                                  m_dqm_moduletime_resolution;
   std::string                                   m_dqm_path;
 
+  // sampling profiler configuration
+  const bool                                    m_enable_sampling;
+  const bool                                    m_sampling_by_stream;           // add the stream as the outermost frame of each sample
+  const unsigned int                            m_sampling_period;              // us of CPU time between samples
+  const std::string                             m_sampling_output;              // file with the samples in the "folded" flame graph format
+  std::unique_ptr<FastTimerSampler>             m_sampler;
+
   struct ProcessDescription {
     std::string         name;
     std::string         first_path;             // the framework does not provide a pre/postPaths or pre/postEndPaths signal,
@@ -748,6 +764,7 @@ private:
   Timing                                        m_job_summary;                  // whole event time accounting per-run
   std::vector<std::vector<TimingPerProcess>>    m_run_summary_perprocess;       // per-process time accounting per-job
   std::vector<TimingPerProcess>                 m_job_summary_perprocess;       // per-process time accounting per-job
+  PathMap<uint64_t>                             m_job_summary_slow;             // per-path number of events above m_path_time_threshold per-job
   std::mutex                                    m_summary_mutex;                // synchronise access to the summary objects across different threads
 
   static
@@ -762,6 +779,10 @@ private:
   // print a timing summary for the run or job
   void printSummary(Timing const & summary, std::string const & label) const;
   void printProcessSummary(Timing const & total, TimingPerProcess const & summary, std::string const & label, std::string const & process) const;
+  void printSlowPathsSummary() const;
+
+  // write the samples collected by the sampling profiler, and print the number of samples per module
+  void writeSamplingSummary();
 
   // assign a "process id" to a process, given its ProcessContext
   static
@@ -0,0 +1,310 @@
+// C++ headers
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+// system headers
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/time.h>
+
+// CMSSW headers
+#include "HLTrigger/Timer/interface/FastTimerSampler.h"
+
+namespace {
+  // frames recorded by backtrace() for the signal handler itself and for the signal trampoline
+  constexpr int kSkipFrames = 2;
+
+  // generation of the sampler currently running, 0 if none
+  std::atomic<unsigned int> s_active_generation(0);
+  std::atomic<unsigned int> s_last_generation(0);
+
+  // the per-thread data is accessed from the signal handler, so it must not require a dynamic
+  // allocation on first access, as the general dynamic TLS model may do
+  thread_local void *       t_data       __attribute__((tls_model("initial-exec"))) = nullptr;
+  thread_local unsigned int t_generation __attribute__((tls_model("initial-exec"))) = 0;
+
+  const std::string s_framework = "(framework)";
+  const std::string s_unknown   = "(unknown module)";
+}
+
+constexpr int          FastTimerSampler::kNoModule;
+constexpr unsigned int FastTimerSampler::kMaxDepth;
+constexpr unsigned int FastTimerSampler::kBufferSize;
+
+FastTimerSampler::ThreadData::ThreadData() :
+  samples(new Sample[kBufferSize]),
+  size(0),
+  draining(0),
+  module(kNoModule),
+  stream(0),
+  dropped(0),
+  stack(),
+  stacks()
+{ }
+
+FastTimerSampler::FastTimerSampler() :
+  m_mutex(),
+  m_threads(),
+  m_modules(),
+  m_symbols(),
+  m_module_samples(),
+  m_dropped(0),
+  m_generation(++s_last_generation),
+  m_running(false),
+  m_previous_action()
+{ }
+
+FastTimerSampler::~FastTimerSampler()
+{
+  stop();
+}
+
+void FastTimerSampler::describeModule(unsigned int id, std::string const & label, std::string const & type)
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (id >= m_modules.size())
+    m_modules.resize(id + 1);
+  m_modules[id] = label + " [" + type + "]";
+}
+
+bool FastTimerSampler::start(std::chrono::microseconds period)
+{
+  if (m_running or period.count() <= 0)
+    return false;
+
+  // do not interfere with an external profiler (e.g. IgProf) that already uses SIGPROF
+  struct sigaction current;
+  if (sigaction(SIGPROF, nullptr, & current) != 0)
+    return false;
+  if (current.sa_handler != SIG_DFL and current.sa_handler != SIG_IGN)
+    return false;
+
+  unsigned int expected = 0;
+  if (not s_active_generation.compare_exchange_strong(expected, m_generation))
+    return false;
+
+  // the first call to backtrace() may load the unwinder library, make sure that happens here
+  // rather than inside the signal handler
+  void * frames[1];
+  backtrace(frames, 1);
+
+  struct sigaction action;
+  std::memset(& action, 0, sizeof(action));
+  action.sa_sigaction = & FastTimerSampler::handler;
+  action.sa_flags     = SA_SIGINFO | SA_RESTART;
+  sigemptyset(& action.sa_mask);
+  if (sigaction(SIGPROF, & action, & m_previous_action) != 0) {
+    s_active_generation = 0;
+    return false;
+  }
+
+  // ITIMER_PROF counts the CPU time used by all threads; the kernel delivers the signal to the
+  // thread that was running when the timer expired, so each thread is sampled according to its
+  // own CPU usage
+  struct itimerval timer;
+  timer.it_interval.tv_sec  = period.count() / 1000000;
+  timer.it_interval.tv_usec = period.count() % 1000000;
+  timer.it_value            = timer.it_interval;
+  if (setitimer(ITIMER_PROF, & timer, nullptr) != 0) {
+    sigaction(SIGPROF, & m_previous_action, nullptr);
+    s_active_generation = 0;
+    return false;
+  }
+
+  m_running = true;
+  return true;
+}
+
+void FastTimerSampler::stop()
+{
+  if (not m_running)
+    return;
+
+  struct itimerval timer;
+  std::memset(& timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, & timer, nullptr);
+  s_active_generation = 0;
+  sigaction(SIGPROF, & m_previous_action, nullptr);
+  m_running = false;
+}
+
+void FastTimerSampler::handler(int, siginfo_t *, void *)
+{
+  if (t_generation == 0 or t_generation != s_active_generation.load(std::memory_order_relaxed))
+    return;
+  ThreadData * data = static_cast<ThreadData *>(t_data);
+  if (data == nullptr)
+    return;
+
+  if (data->draining) {
+    ++data->dropped;
+    return;
+  }
+  unsigned int index = data->size.load(std::memory_order_relaxed);
+  if (index >= kBufferSize) {
+    ++data->dropped;
+    return;
+  }
+
+  int saved_errno = errno;
+  Sample & sample = data->samples[index];
+  sample.module = data->module;
+  sample.stream = data->stream;
+  sample.depth  = backtrace(sample.frames, kMaxDepth);
+  data->size.store(index + 1, std::memory_order_release);
+  errno = saved_errno;
+}
+
+FastTimerSampler::ThreadData & FastTimerSampler::threadData()
+{
+  if (t_data != nullptr and t_generation == m_generation)
+    return * static_cast<ThreadData *>(t_data);
+
+  ThreadData * data = new ThreadData();
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_threads.emplace_back(data);
+  }
+  t_data = data;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  t_generation = m_generation;
+  return * data;
+}
+
+void FastTimerSampler::enterModule(unsigned int id, unsigned int stream)
+{
+  ThreadData & data = threadData();
+  data.stack.emplace_back(data.module, data.stream);
+  data.module = id;
+  data.stream = stream;
+}
+
+void FastTimerSampler::leaveModule()
+{
+  ThreadData & data = threadData();
+  if (data.stack.empty())
+    return;
+  data.module = data.stack.back().first;
+  data.stream = data.stack.back().second;
+  data.stack.pop_back();
+
+  // fold the samples before the buffer fills up
+  if (data.size.load(std::memory_order_acquire) > kBufferSize / 2)
+    fold(data);
+}
+
+void FastTimerSampler::fold(ThreadData & data)
+{
+  data.draining = 1;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+
+  unsigned int size = data.size.load(std::memory_order_acquire);
+  for (unsigned int i = 0; i < size; ++i) {
+    Sample const & sample = data.samples[i];
+    std::vector<void *> frames;
+    if (sample.depth > kSkipFrames)
+      frames.reserve(sample.depth - kSkipFrames);
+    for (int f = kSkipFrames; f < sample.depth; ++f) {
+      // all frames but the innermost one hold a return address, which may already belong to the
+      // next function: look up the address of the call instruction instead
+      char * address = static_cast<char *>(sample.frames[f]);
+      frames.push_back(f == kSkipFrames ? address : address - 1);
+    }
+    ++data.stacks[StackKey(sample.module, sample.stream, std::move(frames))];
+  }
+  data.size.store(0, std::memory_order_release);
+
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  data.draining = 0;
+}
+
+std::string const & FastTimerSampler::moduleName(int id) const
+{
+  if (id == kNoModule)
+    return s_framework;
+  if (id < 0 or (unsigned int) id >= m_modules.size() or m_modules[id].empty())
+    return s_unknown;
+  return m_modules[id];
+}
+
+std::string const & FastTimerSampler::symbol(void * address)
+{
+  auto found = m_symbols.find(address);
+  if (found != m_symbols.end())
+    return found->second;
+
+  std::ostringstream out;
+  Dl_info info;
+  bool resolved = (dladdr(address, & info) != 0);
+  if (resolved and info.dli_sname != nullptr) {
+    int status = 0;
+    char * demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, & status);
+    out << (status == 0 and demangled != nullptr ? demangled : info.dli_sname);
+    std::free(demangled);
+  } else if (resolved and info.dli_fname != nullptr) {
+    char const * name = std::strrchr(info.dli_fname, '/');
+    out << (name ? name + 1 : info.dli_fname) << "+0x" << std::hex
+        << (static_cast<char *>(address) - static_cast<char *>(info.dli_fbase));
+  } else {
+    out << address;
+  }
+
+  // ';' separates the frames in the folded format
+  std::string name = out.str();
+  std::replace(name.begin(), name.end(), ';', ':');
+  return m_symbols.emplace(address, std::move(name)).first->second;
+}
+
+void FastTimerSampler::write(std::ostream & out, bool by_stream)
+{
+  std::lock_guard<std::mutex> guard(m_mutex);
+
+  // merge the call stacks of all threads, keyed by their symbolic representation
+  std::map<std::string, unsigned long> lines;
+  m_module_samples.clear();
+  m_dropped = 0;
+  for (auto & data: m_threads) {
+    fold(* data);
+    for (auto const & keyval: data->stacks) {
+      int module                        = std::get<0>(keyval.first);
+      unsigned int stream               = std::get<1>(keyval.first);
+      std::vector<void *> const & stack = std::get<2>(keyval.first);
+
+      std::string line;
+      if (by_stream)
+        line = "stream " + std::to_string(stream) + ';';
+      line += moduleName(module);
+      for (auto frame = stack.rbegin(); frame != stack.rend(); ++frame) {
+        line += ';';
+        line += symbol(* frame);
+      }
+      lines[line] += keyval.second;
+      m_module_samples[module] += keyval.second;
+    }
+    m_dropped += data->dropped;
+  }
+
+  for (auto const & keyval: lines)
+    out << keyval.first << ' ' << keyval.second << '\n';
+}
+
+std::vector<std::pair<std::string, unsigned long>> FastTimerSampler::moduleSummary() const
+{
+  std::vector<std::pair<std::string, unsigned long>> summary;
+  summary.reserve(m_module_samples.size());
+  for (auto const & keyval: m_module_samples)
+    summary.emplace_back(moduleName(keyval.first), keyval.second);
+  std::sort(summary.begin(), summary.end(), [](std::pair<std::string, unsigned long> const & a, std::pair<std::string, unsigned long> const & b) {
+    return a.second > b.second;
+  });
+  return summary;
+}
+
+unsigned long FastTimerSampler::dropped() const
+{
+  return m_dropped;
+}
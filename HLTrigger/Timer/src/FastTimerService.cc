@@ -7,6 +7,7 @@
 #include <limits>
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 #include <mutex>
 #include <string>
 #include <sstream>
@@ -25,6 +26,7 @@
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/Framework/interface/SerialPaths.h"
 #include "FWCore/Framework/interface/TriggerNamesService.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/StreamID.h"
@@ -47,6 +49,7 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
   m_enable_timing_exclusive(     config.getUntrackedParameter<bool>(     "enableTimingExclusive"    ) ),
   m_enable_timing_summary(       config.getUntrackedParameter<bool>(     "enableTimingSummary"      ) ),
   m_skip_first_path(             config.getUntrackedParameter<bool>(     "skipFirstPath"            ) ),
+  m_path_time_threshold(         config.getUntrackedParameter<double>(   "pathTimeThreshold"        ) ),            // ms
   // dqm configuration
   m_enable_dqm(                  config.getUntrackedParameter<bool>(     "enableDQM"                ) ),
   m_enable_dqm_bypath_active(    config.getUntrackedParameter<bool>(     "enableDQMbyPathActive"    ) ),
@@ -72,6 +75,12 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
   m_dqm_moduletime_range(        config.getUntrackedParameter<double>(   "dqmModuleTimeRange"       ) ),            // ms
   m_dqm_moduletime_resolution(   config.getUntrackedParameter<double>(   "dqmModuleTimeResolution"  ) ),            // ms
   m_dqm_path(                    config.getUntrackedParameter<std::string>("dqmPath" ) ),
+  // sampling profiler configuration
+  m_enable_sampling(             config.getUntrackedParameter<bool>(     "enableSampling"           ) ),
+  m_sampling_by_stream(          config.getUntrackedParameter<bool>(     "samplingByStream"         ) ),
+  m_sampling_period(             config.getUntrackedParameter<uint32_t>( "samplingPeriod"           ) ),            // us
+  m_sampling_output(             config.getUntrackedParameter<std::string>("samplingOutput" ) ),
+  m_sampler(                     m_enable_sampling ? new FastTimerSampler() : nullptr ),
   // description of the process(es)
   m_process(),
   // description of the luminosity axes
@@ -82,10 +91,12 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
   m_run_summary(),
   m_job_summary(),
   m_run_summary_perprocess(),
-  m_job_summary_perprocess()
+  m_job_summary_perprocess(),
+  m_job_summary_slow()
 {
-  // enable timers if required by DQM plots
+  // enable timers if required by DQM plots or by the slow paths summary
   m_enable_timing_paths     = m_enable_timing_paths         or
+                              m_path_time_threshold > 0.    or
                               m_enable_dqm_bypath_active    or
                               m_enable_dqm_bypath_total     or
                               m_enable_dqm_bypath_overhead  or
@@ -108,6 +119,7 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
 
   registry.watchPreallocate(        this, & FastTimerService::preallocate );
   registry.watchPreModuleBeginJob(  this, & FastTimerService::preModuleBeginJob );
+  registry.watchPostBeginJob(       this, & FastTimerService::postBeginJob );
   registry.watchPreGlobalBeginRun(  this, & FastTimerService::preGlobalBeginRun );
   registry.watchPreStreamBeginRun(  this, & FastTimerService::preStreamBeginRun );
   registry.watchPostStreamBeginRun( this, & FastTimerService::postStreamBeginRun );
@@ -121,6 +133,8 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
   registry.watchPreEvent(           this, & FastTimerService::preEvent );
   registry.watchPostEvent(          this, & FastTimerService::postEvent );
   // watch per-path events
+  // the current path and module, and the time between paths, are kept per stream
+  edm::requireSerialPaths("FastTimerService");
   registry.watchPrePathEvent(       this, & FastTimerService::prePathEvent );
   registry.watchPostPathEvent(      this, & FastTimerService::postPathEvent );
   // watch per-module events if enabled
@@ -130,6 +144,11 @@ FastTimerService::FastTimerService(const edm::ParameterSet & config, edm::Activi
     registry.watchPreModuleEventDelayedGet(  this, & FastTimerService::preModuleEventDelayedGet );
     registry.watchPostModuleEventDelayedGet( this, & FastTimerService::postModuleEventDelayedGet );
   }
+  // attribute the samples of the sampling profiler to the running module, if enabled
+  if (m_enable_sampling) {
+    registry.watchPreModuleEvent(            this, & FastTimerService::preModuleEventSampling );
+    registry.watchPostModuleEvent(           this, & FastTimerService::postModuleEventSampling );
+  }
 
   // if requested, reserve plots for timing vs. lumisection
   // there is no need to store the id, as it wil always be 0
@@ -594,6 +613,18 @@ FastTimerService::postStreamEndRun(edm::StreamContext const & sc)
     store->mergeAndResetMEsRunSummaryCache(sc.eventID().run(), sid, m_module_id);
   }
 
+  if (m_path_time_threshold > 0.) {
+    // prevent different threads from updating the summary information at the same time
+    std::lock_guard<std::mutex> lock_summary(m_summary_mutex);
+
+    if (m_job_summary_slow.size() < stream.paths.size())
+      m_job_summary_slow.resize(stream.paths.size());
+    for (unsigned int pid = 0; pid < stream.paths.size(); ++pid)
+      for (auto const & keyval: stream.paths[pid])
+        if (keyval.second.summary_slow)
+          m_job_summary_slow[pid][keyval.first] += keyval.second.summary_slow;
+  }
+
   stream.reset();
   stream.timer_last_transition = FastTimer::Clock::now();
 }
@@ -635,9 +666,20 @@ FastTimerService::postGlobalEndRun(edm::GlobalContext const & gc)
   }
 }
 
+void
+FastTimerService::postBeginJob()
+{
+  if (m_enable_sampling and not m_sampler->start(std::chrono::microseconds(m_sampling_period))) {
+    edm::LogWarning("FastTimerService") << "the sampling profiler could not be started, SIGPROF may already be in use by another profiler";
+  }
+}
+
 void
 FastTimerService::postEndJob()
 {
+  if (m_enable_sampling)
+    writeSamplingSummary();
+
   if (m_enable_timing_summary) {
     const std::string label = "the whole job";
     for (unsigned int pid = 0; pid < m_process.size(); ++pid)
@@ -645,6 +687,21 @@ FastTimerService::postEndJob()
 
     printSummary(m_job_summary, label);
   }
+
+  if (m_path_time_threshold > 0.)
+    printSlowPathsSummary();
+}
+
+void
+FastTimerService::printSlowPathsSummary() const
+{
+  // print the number of events in which each path was above the time threshold
+  std::ostringstream out;
+  out << "FastReport for the whole job, events with a path above " << m_path_time_threshold << " ms" << '\n';
+  for (unsigned int pid = 0; pid < m_job_summary_slow.size() and pid < m_process.size(); ++pid)
+    for (auto const & keyval: m_job_summary_slow[pid])
+      out << "FastReport              " << std::right << std::setw(10) << keyval.second << "  " << m_process[pid].name << " " << keyval.first << '\n';
+  edm::LogVerbatim("FastReport") << out.str();
 }
 
 void
@@ -663,6 +720,28 @@ FastTimerService::printProcessSummary(Timing const & total, TimingPerProcess con
   edm::LogVerbatim("FastReport") << out.str();
 }
 
+void
+FastTimerService::writeSamplingSummary()
+{
+  m_sampler->stop();
+
+  std::ofstream file(m_sampling_output);
+  if (not file) {
+    edm::LogWarning("FastTimerService") << "cannot open the sampling profiler output file " << m_sampling_output;
+    return;
+  }
+  m_sampler->write(file, m_sampling_by_stream);
+
+  // print the number of samples attributed to each module, in decreasing order
+  std::ostringstream out;
+  out << "FastReport sampling profile, " << m_sampling_period << " us of CPU time per sample, written to " << m_sampling_output << '\n';
+  for (auto const & keyval: m_sampler->moduleSummary())
+    out << "FastReport              " << std::right << std::setw(10) << keyval.second << "  " << keyval.first << '\n';
+  if (m_sampler->dropped() > 0)
+    out << "FastReport              " << std::right << std::setw(10) << m_sampler->dropped() << "  samples dropped" << '\n';
+  edm::LogVerbatim("FastReport") << out.str();
+}
+
 void
 FastTimerService::printSummary(Timing const & summary, std::string const & label) const
 {
@@ -756,6 +835,9 @@ void FastTimerService::preModuleBeginJob(edm::ModuleDescription const & module)
     stream.fast_modules[module.id()]     = & stream.modules[module.moduleLabel()];;
     stream.fast_moduletypes[module.id()] = & stream.moduletypes[module.moduleName()];
   }
+
+  if (m_enable_sampling)
+    m_sampler->describeModule(module.id(), module.moduleLabel(), module.moduleName());
 }
 
 void FastTimerService::preEvent(edm::StreamContext const & sc) {
@@ -1057,6 +1139,8 @@ void FastTimerService::postPathEvent(edm::StreamContext const & sc, edm::PathCon
 
     PathInfo & pathinfo = * stream.current_path;
     pathinfo.summary_active += active;
+    if (m_path_time_threshold > 0. and active * 1000. > m_path_time_threshold)
+      ++pathinfo.summary_slow;
 
     // measure the time spent between the execution of the last module and the end of the path
     if (m_enable_timing_modules) {
@@ -1257,6 +1341,30 @@ void FastTimerService::postModuleEventDelayedGet(edm::StreamContext const & sc,
 
 }
 
+void FastTimerService::preModuleEventSampling(edm::StreamContext const & sc, edm::ModuleCallingContext const & mcc) {
+  // this is ever called only if m_enable_sampling = true
+  assert(m_enable_sampling);
+
+  if (mcc.moduleDescription() == nullptr) {
+    edm::LogError("FastTimerService") << "FastTimerService::preModuleEventSampling: invalid module";
+    return;
+  }
+
+  m_sampler->enterModule(mcc.moduleDescription()->id(), sc.streamID().value());
+}
+
+void FastTimerService::postModuleEventSampling(edm::StreamContext const & sc, edm::ModuleCallingContext const & mcc) {
+  // this is ever called only if m_enable_sampling = true
+  assert(m_enable_sampling);
+
+  if (mcc.moduleDescription() == nullptr) {
+    edm::LogError("FastTimerService") << "FastTimerService::postModuleEventSampling: invalid module";
+    return;
+  }
+
+  m_sampler->leaveModule();
+}
+
 // associate to a path all the modules it contains
 void FastTimerService::fillPathMap(unsigned int pid, std::string const & name, std::vector<std::string> const & modules) {
   for (auto & stream: m_stream) {
@@ -1414,6 +1522,8 @@ void FastTimerService::fillDescriptions(edm::ConfigurationDescriptions & descrip
   desc.addUntracked<bool>(   "enableTimingExclusive",    false);
   desc.addUntracked<bool>(   "enableTimingSummary",      false);
   desc.addUntracked<bool>(   "skipFirstPath",            false),
+  desc.addUntracked<double>( "pathTimeThreshold",        0.    )    // ms
+    ->setComment("Count the events in which each path takes longer than this time, in milliseconds, and report them at the end of the job; 0 to disable.");
   desc.addUntracked<bool>(   "enableDQM",                true);
   desc.addUntracked<bool>(   "enableDQMbyPathActive",    false);
   desc.addUntracked<bool>(   "enableDQMbyPathTotal",     true);
@@ -1434,6 +1544,14 @@ void FastTimerService::fillDescriptions(edm::ConfigurationDescriptions & descrip
   desc.addUntracked<double>( "dqmModuleTimeResolution",     0.2);   // ms
   desc.addUntracked<uint32_t>( "dqmLumiSectionsRange",   2500  );   // ~ 16 hours
   desc.addUntracked<std::string>(   "dqmPath",           "HLT/TimerService");
+  desc.addUntracked<bool>(   "enableSampling",           false)
+    ->setComment("Run a sampling profiler, and write the call stacks attributed to each module in the \"folded\" flame graph format.");
+  desc.addUntracked<uint32_t>( "samplingPeriod",         1000  )    // us
+    ->setComment("CPU time between two samples, in microseconds.");
+  desc.addUntracked<bool>(   "samplingByStream",         false)
+    ->setComment("Split the samples of each module by stream.");
+  desc.addUntracked<std::string>(   "samplingOutput",    "FastTimerServiceSamples.txt")
+    ->setComment("Output file for the sampling profiler, to be processed with flamegraph.pl .");
   descriptions.add("FastTimerService", desc);
 }
 
@@ -41,3 +41,7 @@ process.FastTimerService.enableDQMbyModuleType    = True
 process.FastTimerService.enableDQMSummary         = True
 process.FastTimerService.enableDQMbyLumiSection   = True
 process.FastTimerService.enableDQMbyProcesses     = True
+process.FastTimerService.enableSampling           = True
+process.FastTimerService.samplingPeriod           = 1000     # us
+process.FastTimerService.samplingByStream         = False
+process.FastTimerService.samplingOutput           = 'FastTimerServiceSamples.txt'
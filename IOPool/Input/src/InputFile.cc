@@ -11,15 +11,23 @@ Holder for an input TFile.
 #include "FWCore/Utilities/interface/ExceptionPropagate.h"
 #include "FWCore/Utilities/interface/TimeOfDay.h"
 
+#include <atomic>
 #include <exception>
 #include <iomanip>
+#include <map>
+#include <sstream>
 
 namespace edm {
-  InputFile::InputFile(char const* fileName, char const* msg, InputType inputType) :
+  namespace {
+    std::atomic<unsigned long long> s_inputLockWaitNanoseconds{0};
+    std::atomic<unsigned long long> s_inputLockAcquisitions{0};
+  }
+
+  InputFile::InputFile(char const* fileName, char const* msg, InputType inputType, TFileOpenHandle* asyncHandle) :
     file_(), fileName_(fileName), reportToken_(0), inputType_(inputType) {
 
     logFileAction(msg, fileName);
-    file_.reset(TFile::Open(fileName));
+    file_.reset(asyncHandle != nullptr ? TFile::Open(asyncHandle) : TFile::Open(fileName));
     std::exception_ptr e = edm::threadLocalException::getException();
     if(e != std::exception_ptr()) {
       edm::threadLocalException::setException(std::exception_ptr());
@@ -120,4 +128,27 @@ namespace edm {
     Service<JobReport> reportSvc;
     reportSvc->reportReadBranch(inputType, branchName);
   }
+
+  void
+  InputFile::addInputLockWait(unsigned long long nanoseconds) {
+    s_inputLockWaitNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    s_inputLockAcquisitions.fetch_add(1U, std::memory_order_relaxed);
+  }
+
+  void
+  InputFile::reportInputLockWait() {
+    unsigned long long const acquisitions = s_inputLockAcquisitions.load();
+    if(acquisitions == 0U) {
+      return;
+    }
+    std::map<std::string, std::string> data;
+    std::ostringstream waitTime;
+    waitTime << s_inputLockWaitNanoseconds.load() * 1.0e-9;
+    data.insert(std::make_pair("TotalInputLockWaitSecs", waitTime.str()));
+    std::ostringstream count;
+    count << acquisitions;
+    data.insert(std::make_pair("InputLockAcquisitions", count.str()));
+    Service<JobReport> reportSvc;
+    reportSvc->reportPerformanceSummary("InputLock", data);
+  }
 }
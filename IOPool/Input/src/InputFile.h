@@ -15,11 +15,13 @@ Holder for an input TFile.
 #include <vector>
 
 class TObject;
+class TFileOpenHandle;
 
 namespace edm {
   class InputFile {
   public:  
-    explicit InputFile(char const* fileName, char const* msg, InputType inputType);
+    // If asyncHandle is given, the file is taken from a previous TFile::AsyncOpen request
+    explicit InputFile(char const* fileName, char const* msg, InputType inputType, TFileOpenHandle* asyncHandle = nullptr);
     ~InputFile();
 
     InputFile(InputFile const&) = delete; // Disallow copying and moving
@@ -41,6 +43,10 @@ namespace edm {
     // Nevertheless, it is defined here for convenience.
     static void reportReadBranches();
     static void reportReadBranch(InputType inputType, std::string const& branchname);
+    // Accumulates the time spent waiting for the lock protecting the primary input.
+    // reportInputLockWait writes the totals to the job report once per job.
+    static void addInputLockWait(unsigned long long nanoseconds);
+    static void reportInputLockWait();
 
     TObject* Get(char const* name) {return file_->Get(name);}
     TFileCacheRead* GetCacheRead() const {return file_->GetCacheRead();}
@@ -5,6 +5,7 @@
 #include "RootInputFileSequence.h"
 #include "DataFormats/Common/interface/ThinnedAssociation.h"
 #include "DataFormats/Provenance/interface/BranchDescription.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "DataFormats/Provenance/interface/ProductRegistry.h"
 #include "DataFormats/Provenance/interface/ThinnedAssociationsHelper.h"
 #include "FWCore/Framework/interface/EventPrincipal.h"
@@ -17,6 +18,9 @@
 #include "FWCore/Framework/interface/RunPrincipal.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ConsumesInfo.h"
+#include "FWCore/ServiceRegistry/interface/PathsAndConsumesOfModulesBase.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/InputType.h"
@@ -129,6 +133,40 @@ namespace edm {
       }
       secondaryFileSequence_->initAssociationsFromSecondary(associationsFromSecondary);
     }
+    if(primary() && pset.getUntrackedParameter<bool>("trainCacheFromConsumes", false)) {
+      actReg()->watchPreBeginJob(this, &PoolSource::preBeginJob);
+    }
+  }
+
+  void
+  PoolSource::preBeginJob(PathsAndConsumesOfModulesBase const& pathsAndConsumes, ProcessContext const&) {
+    std::set<BranchID> consumed;
+    ProductRegistry::ProductList const& products = productRegistry()->productList();
+    for(auto const* module : pathsAndConsumes.allModules()) {
+      for(auto const& info : pathsAndConsumes.consumesInfo(module->id())) {
+        if(info.branchType() != InEvent) {
+          continue;
+        }
+        for(auto const& product : products) {
+          BranchDescription const& desc = product.second;
+          if(desc.branchType() != InEvent || desc.produced() || !desc.present()) {
+            continue;
+          }
+          // An empty label comes from consumesMany, which only selects on type
+          if(!info.label().empty() &&
+             (info.label() != desc.moduleLabel() ||
+              info.instance() != desc.productInstanceName() ||
+              (!info.process().empty() && info.process() != desc.processName()))) {
+            continue;
+          }
+          if(info.kindOfType() == PRODUCT_TYPE && info.type() != desc.unwrappedTypeID()) {
+            continue;
+          }
+          consumed.insert(desc.branchID());
+        }
+      }
+    }
+    primaryFileSequence_->setConsumedBranchIDs(consumed);
   }
 
   PoolSource::~PoolSource() {}
@@ -138,6 +176,7 @@ namespace edm {
     if(secondaryFileSequence_) secondaryFileSequence_->endJob();
     primaryFileSequence_->endJob();
     InputFile::reportReadBranches();
+    InputFile::reportInputLockWait();
   }
 
   std::unique_ptr<FileBlock>
@@ -26,6 +26,8 @@ namespace edm {
 
   class ConfigurationDescriptions;
   class FileCatalogItem;
+  class PathsAndConsumesOfModulesBase;
+  class ProcessContext;
   class RootInputFileSequence;
 
   class PoolSource : public VectorInputSource {
@@ -38,6 +40,7 @@ namespace edm {
     static void fillDescriptions(ConfigurationDescriptions & descriptions);
 
   private:
+    void preBeginJob(PathsAndConsumesOfModulesBase const&, ProcessContext const&);
     virtual void readEvent_(EventPrincipal& eventPrincipal);
     virtual std::shared_ptr<LuminosityBlockAuxiliary> readLuminosityBlockAuxiliary_();
     virtual void readLuminosityBlock_(LuminosityBlockPrincipal& lumiPrincipal);
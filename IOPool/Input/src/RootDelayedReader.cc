@@ -15,6 +15,8 @@
 #include "TClass.h"
 
 #include <cassert>
+#include <chrono>
+#include <mutex>
 
 namespace edm {
 
@@ -38,6 +40,17 @@ namespace edm {
     return resourceAcquirer_.get();
   }
 
+  std::unique_ptr<WrapperBase>
+  RootDelayedReader::getProduct(BranchKey const& k, EDProductGetter const* ep) {
+    if(!resourceAcquirer_) {
+      return DelayedReader::getProduct(k, ep);
+    }
+    auto const start = std::chrono::steady_clock::now();
+    std::lock_guard<SharedResourcesAcquirer> guard(*resourceAcquirer_);
+    InputFile::addInputLockWait(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    return getProduct_(k, ep);
+  }
+
   std::unique_ptr<WrapperBase>
   RootDelayedReader::getProduct_(BranchKey const& k, EDProductGetter const* ep) const {
     iterator iter = branchIter(k);
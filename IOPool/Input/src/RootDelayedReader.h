@@ -42,6 +42,9 @@ namespace edm {
     RootDelayedReader(RootDelayedReader const&) = delete; // Disallow copying and moving
     RootDelayedReader& operator=(RootDelayedReader const&) = delete; // Disallow copying and moving
 
+    // Times the wait for the shared input resource before reading
+    virtual std::unique_ptr<WrapperBase> getProduct(BranchKey const& k, EDProductGetter const* ep) override;
+
   private:
     virtual std::unique_ptr<WrapperBase> getProduct_(BranchKey const& k, EDProductGetter const* ep) const override;
     virtual void mergeReaders_(DelayedReader* other) override {nextReader_ = other;}
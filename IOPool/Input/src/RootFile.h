@@ -110,6 +110,7 @@ namespace edm {
     // RunNumber_t const& runNumber() const {return indexIntoFileIter().run();}
     EventID const& eventID() const {return eventAux().id();}
     RootTree const& eventTree() const {return eventTree_;}
+    void trainEventCacheFromBranchIDs(std::set<BranchID> const& branchIDs) {eventTree_.trainCacheFromBranchIDs(branchIDs);}
     RootTree const& lumiTree() const {return lumiTree_;}
     RootTree const& runTree() const {return runTree_;}
     FileFormatVersion fileFormatVersion() const {return fileFormatVersion_;}
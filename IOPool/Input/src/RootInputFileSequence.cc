@@ -18,11 +18,13 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/Utilities/interface/ExceptionPropagate.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 
 #include "CLHEP/Random/RandFlat.h"
 #include "InputFile.h"
 #include "TSystem.h"
+#include "TTreeCacheUnzip.h"
 
 namespace edm {
   RootInputFileSequence::RootInputFileSequence(
@@ -69,7 +71,16 @@ namespace edm {
     labelRawDataLikeMC_(pset.getUntrackedParameter<bool>("labelRawDataLikeMC", true)),
     usingGoToEvent_(false),
     enablePrefetching_(false),
-    usedFallback_(false) {
+    usedFallback_(false),
+    filesToOpenAhead_(inputType == InputType::Primary ? pset.getUntrackedParameter<unsigned int>("filesToOpenAhead", 0U) : 0U),
+    consumedBranchIDs_(),
+    asyncOpenHandles_() {
+
+    // Let ROOT decompress the baskets held in the TTreeCache in a helper thread
+    // so that the unzipping is mostly done outside the input lock.
+    if(inputType == InputType::Primary && pset.getUntrackedParameter<bool>("enableParallelUnzip", false)) {
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+    }
 
     // The SiteLocalConfig controls the TTreeCache size and the prefetching settings.
     Service<SiteLocalConfig> pSLC;
@@ -115,6 +126,7 @@ namespace edm {
   void
   RootInputFileSequence::endJob() {
     closeFile_();
+    asyncOpenHandles_.clear();
   }
 
   std::unique_ptr<FileBlock>
@@ -170,6 +182,7 @@ namespace edm {
       fileIterLastOpened_ = fileIterEnd_;
     }
     closeFile_();
+    discardFilesOpenedAhead();
 
     if(fileIter_ == fileIterEnd_) {
       // No files specified
@@ -204,7 +217,14 @@ namespace edm {
     try {
       std::unique_ptr<InputSource::FileOpenSentry>
         sentry(inputType_ == InputType::Primary ? new InputSource::FileOpenSentry(input_, lfn_, usedFallback_) : 0);
-      filePtr.reset(new InputFile(gSystem->ExpandPathName(fileIter_->fileName().c_str()), "  Initiating request to open file ", inputType_));
+      std::unique_ptr<TFileOpenHandle, AsyncOpenHandleDiscarder> asyncHandle;
+      auto itHandle = asyncOpenHandles_.find(fileIter_->fileName());
+      if(itHandle != asyncOpenHandles_.end()) {
+        asyncHandle = std::move(itHandle->second);
+        asyncOpenHandles_.erase(itHandle);
+      }
+      // The InputFile takes the handle over
+      filePtr.reset(new InputFile(gSystem->ExpandPathName(fileIter_->fileName().c_str()), "  Initiating request to open file ", inputType_, asyncHandle.release()));
     }
     catch (cms::Exception const& e) {
       if(!skipBadFiles) {
@@ -299,6 +319,10 @@ namespace edm {
       case InputType::SecondarySource: inputType = "mixingFiles"; break;
       }
       rootFile_->reportOpened(inputType);
+      if(!consumedBranchIDs_.empty()) {
+        rootFile_->trainEventCacheFromBranchIDs(consumedBranchIDs_);
+      }
+      openFilesAhead();
     } else {
       InputFile::reportSkippedFile(fileIter_->fileName(), fileIter_->logicalFileName());
       if(!skipBadFiles) {
@@ -309,6 +333,64 @@ namespace edm {
     }
   }
 
+  void RootInputFileSequence::setConsumedBranchIDs(std::set<BranchID> const& branchIDs) {
+    consumedBranchIDs_ = branchIDs;
+    if(rootFile_ && !consumedBranchIDs_.empty()) {
+      rootFile_->trainEventCacheFromBranchIDs(consumedBranchIDs_);
+    }
+  }
+
+  void RootInputFileSequence::openFilesAhead() {
+    // Start opening the next files in the background so the open and the
+    // metadata transfer overlap with the processing of the current file.
+    std::vector<FileCatalogItem>::const_iterator it = fileIter_;
+    for(unsigned int i = 0; i < filesToOpenAhead_ && it != fileIterEnd_; ++i) {
+      ++it;
+      if(it == fileIterEnd_) {
+        break;
+      }
+      std::string const& fileName = it->fileName();
+      if(fileName.empty() || asyncOpenHandles_.find(fileName) != asyncOpenHandles_.end()) {
+        continue;
+      }
+      TString fullName(fileName.c_str());
+      gSystem->ExpandPathName(fullName);
+      TFileOpenHandle* handle = TFile::AsyncOpen(fullName.Data());
+      if(handle != nullptr) {
+        asyncOpenHandles_[fileName].reset(handle);
+      }
+    }
+  }
+
+  void RootInputFileSequence::discardFilesOpenedAhead() {
+    // Called when the sequence moves to another file. Only the opens for the
+    // files that openFilesAhead() would start from here on are still wanted,
+    // the others are left over from before a skip, a rewind or a failed open.
+    if(asyncOpenHandles_.empty()) {
+      return;
+    }
+    std::set<std::string> wanted;
+    std::vector<FileCatalogItem>::const_iterator it = fileIter_;
+    for(unsigned int i = 0; i <= filesToOpenAhead_ && it != fileIterEnd_; ++i, ++it) {
+      wanted.insert(it->fileName());
+    }
+    for(auto itHandle = asyncOpenHandles_.begin(); itHandle != asyncOpenHandles_.end();) {
+      if(wanted.find(itHandle->first) == wanted.end()) {
+        itHandle = asyncOpenHandles_.erase(itHandle);
+      } else {
+        ++itHandle;
+      }
+    }
+  }
+
+  void RootInputFileSequence::AsyncOpenHandleDiscarder::operator()(TFileOpenHandle* iHandle) const {
+    // TFile::Open takes the handle over and waits for the open to finish.
+    // Any exception the storage layer recorded for the file is dropped too
+    // since nobody is going to read it.
+    delete TFile::Open(iHandle);
+    edm::threadLocalException::setException(std::exception_ptr());
+  }
+
   std::shared_ptr<ProductRegistry const>
   RootInputFileSequence::fileProductRegistry() const {
     assert(rootFile_);
@@ -857,6 +939,15 @@ namespace edm {
         ->setComment("Size of ROOT TTree prefetch cache.  Affects performance.");
     desc.addUntracked<int>("treeMaxVirtualSize", -1)
         ->setComment("Size of ROOT TTree TBasket cache.  Affects performance.");
+    desc.addUntracked<unsigned int>("filesToOpenAhead", 0U)
+        ->setComment("Number of following input files to open asynchronously while the current file is read (primary input only).");
+    desc.addUntracked<bool>("trainCacheFromConsumes", false)
+        ->setComment("True:  Fill the TTree cache with the event branches declared as consumed by the modules of the job.\n"
+                     "       Branches read without a consumes declaration (e.g. by output modules) are read outside the cache.\n"
+                     "False: Train the cache on the first events of each file.");
+    desc.addUntracked<bool>("enableParallelUnzip", false)
+        ->setComment("True:  Decompress baskets read into the TTree cache in a separate thread (primary input only).\n"
+                     "False: Decompress baskets when the branch is read.");
     desc.addUntracked<unsigned int>("setRunNumber", 0U)
         ->setComment("If non-zero, change number of first run to this number. Apply same offset to all runs.  Allowed only for simulation.");
     desc.addUntracked<bool>("dropDescendantsOfDroppedBranches", true)
@@ -17,6 +17,7 @@ RootInputFileSequence: This is an InputSource
 #include "DataFormats/Provenance/interface/IndexIntoFile.h"
 #include "DataFormats/Provenance/interface/ProcessHistoryID.h"
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -27,6 +28,8 @@ namespace CLHEP {
   class HepRandomEngine;
 }
 
+class TFileOpenHandle;
+
 namespace edm {
 
   class BranchID;
@@ -81,8 +84,13 @@ namespace edm {
     ProcessingController::ForwardState forwardState() const;
     ProcessingController::ReverseState reverseState() const;
     void initAssociationsFromSecondary(std::set<BranchID> const&);
+    // Event branches that modules declared they consume. Used to fill the TTreeCache
+    // of each file up front instead of training it on the first events.
+    void setConsumedBranchIDs(std::set<BranchID> const&);
   private:
     void initFile(bool skipBadFiles);
+    void openFilesAhead();
+    void discardFilesOpenedAhead();
     bool nextFile();
     bool previousFile();
     void rewindFile();
@@ -129,6 +137,14 @@ namespace edm {
     bool usingGoToEvent_;
     bool enablePrefetching_;
     bool usedFallback_;
+    unsigned int filesToOpenAhead_;
+    std::set<BranchID> consumedBranchIDs_;
+    // An asynchronous open that is never used must still be completed and
+    // the resulting file deleted, see discardFilesOpenedAhead().
+    struct AsyncOpenHandleDiscarder {
+      void operator()(TFileOpenHandle* iHandle) const;
+    };
+    std::map<std::string, std::unique_ptr<TFileOpenHandle, AsyncOpenHandleDiscarder> > asyncOpenHandles_;
   }; // class RootInputFileSequence
 }
 #endif
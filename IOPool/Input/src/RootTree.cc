@@ -456,6 +456,40 @@ namespace edm {
  
   }
 
+  void
+  RootTree::trainCacheFromBranchIDs(std::set<BranchID> const& branchIDs) {
+    if (cacheSize_ == 0 || !treeCache_) {
+      return;
+    }
+    assert(branchType_ == InEvent);
+    EntryNumber const firstEntry = (entryNumber_ < 0 ? 0 : entryNumber_);
+    rawTreeCache_.reset();
+    filePtr_->SetCacheRead(treeCache_.get());
+    treeCache_->StartLearningPhase();
+    treeCache_->SetEntryRange(firstEntry, tree_->GetEntries());
+    treeCache_->AddBranch(poolNames::branchListIndexesBranchName().c_str(), kTRUE);
+    treeCache_->AddBranch(BranchTypeToAuxiliaryBranchName(branchType_).c_str(), kTRUE);
+    trainedSet_.clear();
+    triggerSet_.clear();
+    for(auto const& branch : *branches_) {
+      TBranch* productBranch = branch.second.productBranch_;
+      if(productBranch != nullptr && branchIDs.find(branch.second.branchDescription_.branchID()) != branchIDs.end()) {
+        treeCache_->AddBranch(productBranch, kTRUE);
+        trainedSet_.insert(productBranch);
+      }
+    }
+    treeCache_->StopLearningPhase();
+    assert(treeCache_->GetTree() == tree_);
+    // We own the treeCache_.
+    // We make sure the treeCache_ is detached from the file,
+    // so that ROOT does not also delete it.
+    filePtr_->SetCacheRead(0);
+
+    // The branches are known, so no training is needed at the next read.
+    trainNow_ = false;
+    switchOverEntry_ = firstEntry;
+  }
+
   namespace roottree {
     Int_t
     getEntry(TBranch* branch, EntryNumber entryNumber) {
@@ -18,6 +18,7 @@ RootTree.h // used by ROOT input sources
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -148,6 +149,8 @@ namespace edm {
     TTreeCache* checkTriggerCacheImpl(TBranch* branch, EntryNumber entryNumber) const;
     inline TTreeCache* selectCache(TBranch* branch, EntryNumber entryNumber) const;
     void trainCache(char const* branchNames);
+    // Fill the cache with exactly the given branches, skipping the learning phase
+    void trainCacheFromBranchIDs(std::set<BranchID> const& branchIDs);
     void resetTraining() {trainNow_ = true;}
 
     BranchType branchType() const {return branchType_;}
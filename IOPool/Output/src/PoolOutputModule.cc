@@ -6,6 +6,7 @@
 #include "FWCore/Framework/interface/LuminosityBlockPrincipal.h"
 #include "FWCore/Framework/interface/RunPrincipal.h"
 #include "FWCore/Framework/interface/FileBlock.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
@@ -17,6 +18,7 @@
 #include "FWCore/Utilities/interface/TimeOfDay.h"
 #include "FWCore/Utilities/interface/WrappedClassName.h"
 
+#include "TROOT.h"
 #include "TTree.h"
 #include "TBranchElement.h"
 #include "TObjArray.h"
@@ -82,6 +84,26 @@ namespace edm {
       whyNotFastClonable_+= FileBlock::EventSelectionUsed;
     }
 
+    // With implicit multithreading ROOT compresses the baskets of the
+    // different branches concurrently when TTree::Fill flushes them and
+    // only serializes the writes to the file. The setting is global to the
+    // process, so only the first module asking for it sizes the thread pool.
+    unsigned int nCompressionThreads = pset.getUntrackedParameter<unsigned int>("numberOfCompressionThreads");
+    if (nCompressionThreads > 0U) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+      if (!ROOT::IsImplicitMTEnabled()) {
+        ROOT::EnableImplicitMT(nCompressionThreads);
+      } else {
+        LogWarning("PoolOutputModule") << "ROOT implicit multithreading is already enabled for this process with "
+                                       << ROOT::GetImplicitMTPoolSize() << " threads.\n"
+                                       << "The value " << nCompressionThreads << " of 'numberOfCompressionThreads' of module '"
+                                       << moduleLabel_ << "' is ignored and the existing thread pool is used.\n";
+      }
+#else
+      LogWarning("PoolOutputModule") << "The parameter 'numberOfCompressionThreads' requires ROOT 6.10 or later and is ignored.\n";
+#endif
+    }
+
     // We don't use this next parameter, but we read it anyway because it is part
     // of the configuration of this module.  An external parser creates the
     // configuration by reading this source code.
@@ -349,6 +371,9 @@ namespace edm {
     desc.addUntracked<std::string>("compressionAlgorithm", "ZLIB")
         ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB and LZMA");
 #endif
+    desc.addUntracked<unsigned int>("numberOfCompressionThreads", 0U)
+        ->setComment("If non-zero, enable ROOT implicit multithreading with this many threads so branch baskets are compressed concurrently.\n"
+                     "ROOT implicit multithreading is global to the process: if it is already enabled, e.g. by another output module, its thread pool is used and this value is ignored.");
     desc.addUntracked<int>("basketSize", 16384)
         ->setComment("Default ROOT basket size in output file.");
     desc.addUntracked<int>("eventAutoFlushCompressedSize",-1)->setComment("Set ROOT auto flush stored data size (in bytes) for event TTree. The value sets how large the compressed buffer is allowed to get. The uncompressed buffer can be quite a bit larger than this depending on the average compression ratio. The value of -1 just uses ROOT's default value. The value of 0 turns off this feature.");
@@ -28,9 +28,12 @@
 #include "IOPool/Streamer/interface/InitMessage.h"
 #include "IOPool/Streamer/interface/MsgTools.h"
 #include "IOPool/Streamer/interface/StreamerInputFile.h"
+#include "IOPool/Streamer/interface/StreamerInputSource.h"
+#include "IOPool/Streamer/interface/StreamSerializer.h"
 #include "IOPool/Streamer/interface/StreamerOutputFile.h"
 
 #include "zlib.h"
+#include "zstd.h"
 
 #include <iostream>
 #include <map>
@@ -272,8 +275,28 @@ bool test_uncompress(EventMsgView const* eview, std::vector<unsigned char> &dest
   if(origsize != 0 && origsize != 78)
   {
     // compressed
-    success = uncompressBuffer(const_cast<unsigned char*>((unsigned char const*)eview->eventData()),
-                                   eview->eventLength(), dest, origsize);
+    unsigned char* data = const_cast<unsigned char*>((unsigned char const*)eview->eventData());
+    if(eview->compressionAlgorithm() == edm::ZLIB) {
+      success = uncompressBuffer(data, eview->eventLength(), dest, origsize);
+    } else if(eview->compressionAlgorithm() == edm::ZSTD &&
+              ZSTD_getDictID_fromFrame(data, eview->eventLength()) != 0) {
+      // the dictionary lives in the INIT message, only the checksum is tested
+      success = true;
+    } else if(eview->compressionAlgorithm() == edm::LZ4 || eview->compressionAlgorithm() == edm::ZSTD) {
+      try {
+        if(eview->compressionAlgorithm() == edm::LZ4) {
+          edm::StreamerInputSource::uncompressBufferLZ4(data, eview->eventLength(), dest, origsize);
+        } else {
+          std::shared_ptr<ZSTD_DCtx> context(ZSTD_createDCtx(), [](ZSTD_DCtx* iContext) { ZSTD_freeDCtx(iContext); });
+          edm::StreamerInputSource::uncompressBufferZSTD(data, eview->eventLength(), dest, origsize, context.get(), nullptr);
+        }
+        success = true;
+      } catch(cms::Exception const& e) {
+        std::cout << "Problem with uncompress: " << e.explainSelf() << std::endl;
+      }
+    } else {
+      std::cout << "Unknown compression algorithm " << eview->compressionAlgorithm() << std::endl;
+    }
   } else {
     // uncompressed anyway
     success = true;
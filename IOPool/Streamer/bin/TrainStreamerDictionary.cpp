@@ -0,0 +1,117 @@
+/** Trains a zstd dictionary on the event data blobs of streamer files.
+
+  The dictionary written can be given to the compression_dictionary
+  parameter of the streamer output modules together with
+  compression_algorithm = "ZSTD". It is stored in the INIT message of
+  the files written so readers need no extra configuration.
+
+  main():
+      trainStreamerDictionary dictionary_file_name [max_dictionary_size] streamer_file_name ...
+
+*/
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "IOPool/Streamer/interface/EventMessage.h"
+#include "IOPool/Streamer/interface/InitMessage.h"
+#include "IOPool/Streamer/interface/StreamerInputFile.h"
+#include "IOPool/Streamer/interface/StreamerInputSource.h"
+#include "IOPool/Streamer/interface/StreamSerializer.h"
+
+#include "zstd.h"
+#include "zdict.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+  // appends the uncompressed data blob of the event, returns false if it could not be read
+  bool appendSample(EventMsgView const* eview, ZSTD_DCtx* context,
+                    std::vector<unsigned char>& buffer, std::vector<unsigned char>& samples) {
+    unsigned char* data = const_cast<unsigned char*>((unsigned char const*)eview->eventData());
+    unsigned int origsize = eview->origDataSize();
+    if(origsize == 0 || origsize == 78) {
+      samples.insert(samples.end(), data, data + eview->eventLength());
+      return true;
+    }
+    switch(eview->compressionAlgorithm()) {
+      case edm::ZLIB:
+        edm::StreamerInputSource::uncompressBuffer(data, eview->eventLength(), buffer, origsize);
+        break;
+      case edm::LZ4:
+        edm::StreamerInputSource::uncompressBufferLZ4(data, eview->eventLength(), buffer, origsize);
+        break;
+      case edm::ZSTD:
+        // events already compressed with a dictionary are not used
+        if(ZSTD_getDictID_fromFrame(data, eview->eventLength()) != 0) return false;
+        edm::StreamerInputSource::uncompressBufferZSTD(data, eview->eventLength(), buffer, origsize, context, nullptr);
+        break;
+      default:
+        return false;
+    }
+    samples.insert(samples.end(), buffer.begin(), buffer.begin() + origsize);
+    return true;
+  }
+}
+
+int main(int argc, char* argv[]) try {
+  if(argc < 3) {
+    std::cout << "Usage: trainStreamerDictionary dictionary_file_name [max_dictionary_size] streamer_file_name ..."
+              << std::endl;
+    return 1;
+  }
+
+  std::string const dictionaryFile(argv[1]);
+  int firstFile = 2;
+  size_t maxDictionarySize = 112640; // zstd default
+  char* end = nullptr;
+  unsigned long requestedSize = strtoul(argv[2], &end, 10);
+  if(end != argv[2] && *end == '\0') {
+    maxDictionarySize = requestedSize;
+    ++firstFile;
+  }
+
+  std::vector<unsigned char> samples;
+  std::vector<size_t> sampleSizes;
+  std::vector<unsigned char> buffer;
+  std::shared_ptr<ZSTD_DCtx> context(ZSTD_createDCtx(), [](ZSTD_DCtx* iContext) { ZSTD_freeDCtx(iContext); });
+
+  for(int i = firstFile; i < argc; ++i) {
+    edm::StreamerInputFile stream_reader(argv[i]);
+    while(stream_reader.next()) {
+      size_t const before = samples.size();
+      if(appendSample(stream_reader.currentRecord(), context.get(), buffer, samples)) {
+        sampleSizes.push_back(samples.size() - before);
+      }
+    }
+  }
+  if(sampleSizes.empty()) {
+    std::cout << "No usable events were found" << std::endl;
+    return 1;
+  }
+
+  std::vector<unsigned char> dictionary(maxDictionarySize);
+  size_t const dictionarySize = ZDICT_trainFromBuffer(&dictionary[0], dictionary.size(),
+                                                      &samples[0], &sampleSizes[0], sampleSizes.size());
+  if(ZDICT_isError(dictionarySize)) {
+    std::cout << "Dictionary training failed: " << ZDICT_getErrorName(dictionarySize) << std::endl;
+    return 1;
+  }
+
+  std::ofstream output(dictionaryFile.c_str(), std::ios::binary);
+  output.write((char const*)&dictionary[0], dictionarySize);
+  if(!output) {
+    std::cout << "Could not write dictionary file " << dictionaryFile << std::endl;
+    return 1;
+  }
+  std::cout << "Wrote dictionary of " << dictionarySize << " bytes trained on "
+            << sampleSizes.size() << " events (" << samples.size() << " bytes) to "
+            << dictionaryFile << std::endl;
+  return 0;
+} catch(cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return 1;
+}
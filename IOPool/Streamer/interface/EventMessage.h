@@ -48,6 +48,15 @@ Protocol Version 10: identical to version 9, but incremented to keep in sync wit
 
 Protocol Version 11: identical to version 10, except event changed from 4 bytes to 8 bytes
 
+Protocol Version 12:  // add compression algorithm of data blob
+code 1 | size 4 | protocol version 1 |
+run 4 | event 8 | lumi 4 | origDataSize 4 | outModId 4 |
+droppedEventsCount 4 | compressionAlgorithm 1 |
+l1_count 4 | l1bits l1_count/8 | 
+hlt_count 4 | hltbits hlt_count/4 |
+adler32_chksum 4 | host name length 1 | host name {Fixed size}
+eventdatalength 4 | eventdata blob {variable} 
+
 */
 
 #ifndef IOPool_Streamer_EventMessage_h
@@ -68,6 +77,7 @@ struct EventHeader
   char_uint32 origDataSize_;
   char_uint32 outModId_;
   char_uint32 droppedEventsCount_;
+  uint8 compressionAlgorithm_;
 };
 
 class EventMsgView
@@ -90,6 +100,7 @@ public:
   uint32 origDataSize() const;
   uint32 outModId() const;
   uint32 droppedEventsCount() const;
+  uint32 compressionAlgorithm() const;
 
   void l1TriggerBits(std::vector<bool>& put_here) const;
   void hltTriggerBits(uint8* put_here) const;
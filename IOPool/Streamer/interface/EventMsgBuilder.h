@@ -16,6 +16,7 @@ public:
                   uint32 adler32_chksum, const char* host_name);
 
   void setOrigDataSize(uint32);
+  void setCompressionAlgorithm(uint8);
   uint8* startAddress() const { return buf_; }
   void setEventLength(uint32 len);
   uint8* eventAddr() const { return event_addr_; }
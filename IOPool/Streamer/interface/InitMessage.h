@@ -28,6 +28,9 @@ code 1 | size 4 | protocol version 1 | pset 16 | run 4 | Init Header Size 4| Eve
 
 Protocol Version 11: identical to version 10, but incremented to keep in sync with event msg protocol version
 
+Protocol Version 12: added compression dictionary used for the event data blobs
+code 1 | size 4 | protocol version 1 | pset 16 | run 4 | Init Header Size 4| Event Header Size 4| releaseTagLength 1 | ReleaseTag var| processNameLength 1 | processName var| outputModuleLabelLength 1 | outputModuleLabel var | outputModuleId 4 | HLT Trig count 4| HLT Trig Length 4 | HLT Trig names var | HLT Selection count 4| HLT Selection Length 4 | HLT Selection names var | L1 Trig Count 4| L1 TrigName len 4| L1 Trig Names var | adler32 chksum 4| compression dictionary length 4 | compression dictionary var | desc legth 4 | description blob var
+
 */
 
 #ifndef IOPool_Streamer_InitMessage_h
@@ -38,7 +41,7 @@ Protocol Version 11: identical to version 10, but incremented to keep in sync wi
 
 struct Version
 {
-  Version(const uint8* pset):protocol_(11)
+  Version(const uint8* pset):protocol_(12)
   { std::copy(pset,pset+sizeof(pset_id_),&pset_id_[0]); }
 
   uint8 protocol_; // version of the protocol
@@ -97,6 +100,10 @@ public:
   std::string hostName() const;
   uint32 hostName_len() const {return host_name_len_;}
 
+  // empty unless the event data blobs were compressed with a dictionary
+  const uint8* compressionDictionary() const { return dictionary_start_; }
+  uint32 compressionDictionaryLength() const { return dictionary_len_; }
+
 private:
   uint8* buf_;
   HeaderView head_;
@@ -123,6 +130,8 @@ private:
   uint32 adler32_chksum_;
   uint8* host_name_start_;
   uint32 host_name_len_;
+  uint8* dictionary_start_;
+  uint32 dictionary_len_;
 
   // does not need to be present in the message sent over the network,
   // but is needed for the index file
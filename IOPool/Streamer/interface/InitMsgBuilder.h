@@ -18,7 +18,8 @@ public:
                  const Strings& hlt_names,
                  const Strings& hlt_selections,
                  const Strings& l1_names,
-                 uint32 adler32_chksum);
+                 uint32 adler32_chksum,
+                 const std::vector<uint8>& compression_dictionary = std::vector<uint8>());
 
   uint8* startAddress() const { return buf_; }
   void setDataLength(uint32 registry_length);
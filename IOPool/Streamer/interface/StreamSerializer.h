@@ -11,6 +11,7 @@
 #include "TBufferFile.h"
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "DataFormats/Provenance/interface/BranchIDList.h"
@@ -56,9 +57,19 @@ struct SerializeDataBuffer
 
 class EventMsgBuilder;
 class InitMsgBuilder;
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
 namespace edm
 {
-  
+
+  // recorded in the event message header, do not renumber
+  enum StreamerCompressionAlgo {
+    UNCOMPRESSED = 0,
+    ZLIB = 1,
+    LZ4 = 2,
+    ZSTD = 3
+  };
+
   class EventPrincipal;
   class ModuleCallingContext;
   class ThinnedAssociationsHelper;
@@ -78,7 +89,15 @@ namespace edm
                        ParameterSetID const& selectorConfig,
                        bool use_compression, int compression_level,
                        SerializeDataBuffer &data_buffer,
-                       ModuleCallingContext const* mcc);
+                       ModuleCallingContext const* mcc,
+                       StreamerCompressionAlgo compression_algo = ZLIB);
+
+    /**
+     * Use the specified zstd dictionary for all following ZSTD compressed
+     * events. The same dictionary must be given to the reader, so it is
+     * also stored in the INIT message.
+     */
+    void setZstdDictionary(std::vector<unsigned char> const& dictionary, int compressionLevel);
 
     /**
      * Compresses the data in the specified input buffer into the
@@ -90,10 +109,29 @@ namespace edm
                                        std::vector<unsigned char> &outputBuffer,
                                        int compressionLevel);
 
+    static unsigned int compressBufferLZ4(unsigned char *inputBuffer,
+                                          unsigned int inputSize,
+                                          std::vector<unsigned char> &outputBuffer,
+                                          int compressionLevel);
+
+    /**
+     * The context is reused between calls to avoid reallocating the
+     * compression state for every event. If a dictionary is given
+     * the compression level it was digested with is used.
+     */
+    static unsigned int compressBufferZSTD(unsigned char *inputBuffer,
+                                           unsigned int inputSize,
+                                           std::vector<unsigned char> &outputBuffer,
+                                           int compressionLevel,
+                                           ZSTD_CCtx_s* context,
+                                           ZSTD_CDict_s const* dictionary);
+
   private:
 
     SelectedProducts const* selections_;
     TClass* tc_;
+    std::shared_ptr<ZSTD_CCtx_s> zstdContext_;
+    std::shared_ptr<ZSTD_CDict_s> zstdDictionary_;
   };
 
 }
@@ -22,6 +22,8 @@
 
 class InitMsgView;
 class EventMsgView;
+struct ZSTD_DCtx_s;
+struct ZSTD_DDict_s;
 
 namespace edm {
   class BranchIDListHelper;
@@ -60,6 +62,22 @@ namespace edm {
                                          unsigned int inputSize,
                                          std::vector<unsigned char>& outputBuffer,
                                          unsigned int expectedFullSize);
+
+    static unsigned int uncompressBufferLZ4(unsigned char* inputBuffer,
+                                            unsigned int inputSize,
+                                            std::vector<unsigned char>& outputBuffer,
+                                            unsigned int expectedFullSize);
+
+    /**
+     * The dictionary must be the one the data was compressed with,
+     * or null if no dictionary was used.
+     */
+    static unsigned int uncompressBufferZSTD(unsigned char* inputBuffer,
+                                             unsigned int inputSize,
+                                             std::vector<unsigned char>& outputBuffer,
+                                             unsigned int expectedFullSize,
+                                             ZSTD_DCtx_s* context,
+                                             ZSTD_DDict_s const* dictionary);
   protected:
     static void declareStreamers(SendDescs const& descs);
     static void buildClassCache(SendDescs const& descs);
@@ -103,6 +121,9 @@ namespace edm {
 
     std::string processName_;
     unsigned int protocolVersion_;
+
+    std::shared_ptr<ZSTD_DCtx_s> zstdContext_;
+    std::shared_ptr<ZSTD_DDict_s> zstdDictionary_;
   }; //end-of-class-def
 } // end of namespace-edm
   
@@ -44,6 +44,8 @@ namespace edm {
     int maxEventSize_;
     bool useCompression_;
     int compressionLevel_;
+    StreamerCompressionAlgo compressionAlgorithm_;
+    std::vector<uint8> compressionDictionary_;
 
     // test luminosity sections
     int lumiSectionInterval_;  
@@ -15,9 +15,9 @@ EventMsgView::EventMsgView(void* buf):
 
   // 18-Jul-2008, wmtan - payload changed for version 7.
   // So we no longer support previous formats.
-  if (protocolVersion() != 11) {
+  if (protocolVersion() != 12) {
     throw cms::Exception("EventMsgView", "Invalid Message Version:")
-      << "Only message version 10 is currently supported \n"
+      << "Only message version 12 is currently supported \n"
       << "(invalid value = " << protocolVersion() << ").\n"
       << "We support only reading and converting streamer files\n"
       << "using the same version of CMSSW used to created the\n"
@@ -107,6 +107,12 @@ uint32 EventMsgView::droppedEventsCount() const
   return 0;
 }
 
+uint32 EventMsgView::compressionAlgorithm() const
+{
+  EventHeader* h = (EventHeader*)buf_;
+  return h->compressionAlgorithm_;
+}
+
 void EventMsgView::l1TriggerBits(std::vector<bool>& put_here) const
 {
   put_here.clear();
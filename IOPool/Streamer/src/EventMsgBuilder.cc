@@ -15,12 +15,14 @@ EventMsgBuilder::EventMsgBuilder(void* buf, uint32 size,
   buf_((uint8*)buf),size_(size)
 {
   EventHeader* h = (EventHeader*)buf_;
-  h->protocolVersion_ = 11;
+  h->protocolVersion_ = 12;
   convert(run,h->run_);
   convert(event,h->event_);
   convert(lumi,h->lumi_);
   convert(outModId,h->outModId_);
   convert(droppedEventsCount,h->droppedEventsCount_);
+  // zlib unless told otherwise, only looked at when origDataSize is set
+  h->compressionAlgorithm_ = 1;
   uint8* pos = buf_ + sizeof(EventHeader);
 
   // l1 count
@@ -86,6 +88,12 @@ void EventMsgBuilder::setOrigDataSize(uint32 value)
   convert(value,h->origDataSize_);
 }
 
+void EventMsgBuilder::setCompressionAlgorithm(uint8 value)
+{
+  EventHeader* h = (EventHeader*)buf_;
+  h->compressionAlgorithm_ = value;
+}
+
 void EventMsgBuilder::setEventLength(uint32 len)
 {
   convert(len,event_addr_-sizeof(char_uint32));
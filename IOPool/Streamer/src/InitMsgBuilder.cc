@@ -1,6 +1,7 @@
 #include "IOPool/Streamer/interface/InitMsgBuilder.h"
 #include "IOPool/Streamer/interface/EventMsgBuilder.h"
 #include "IOPool/Streamer/interface/MsgHeader.h"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <cstdint>
@@ -15,7 +16,8 @@ InitMsgBuilder::InitMsgBuilder(void* buf, uint32 size,
                                const Strings& hlt_names,
                                const Strings& hlt_selections,
                                const Strings& l1_names,
-                               uint32 adler_chksum):
+                               uint32 adler_chksum,
+                               const std::vector<uint8>& compression_dictionary):
   buf_((uint8*)buf),size_(size)
 {
   InitHeader* h = (InitHeader*)buf_;
@@ -59,6 +61,11 @@ InitMsgBuilder::InitMsgBuilder(void* buf, uint32 size,
   convert(adler_chksum, pos);
   pos = pos + sizeof(uint32);
 
+  // compression dictionary (Length and then the dictionary)
+  convert((uint32)compression_dictionary.size(), pos);
+  pos = pos + sizeof(char_uint32);
+  pos = std::copy(compression_dictionary.begin(), compression_dictionary.end(), pos);
+
   data_addr_ = pos + sizeof(char_uint32);
   setDataLength(0);
 
@@ -23,6 +23,9 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 
 #include "zlib.h"
+#include "lz4.h"
+#include "lz4hc.h"
+#include "zstd.h"
 #include <algorithm>
 #include <cstdlib>
 #include <iostream>
@@ -130,7 +133,8 @@ namespace edm {
                                        ParameterSetID const& selectorConfig,
                                        bool use_compression, int compression_level,
                                        SerializeDataBuffer &data_buffer,
-                                       ModuleCallingContext const* mcc) {
+                                       ModuleCallingContext const* mcc,
+                                       StreamerCompressionAlgo compression_algo) {
     Parentage parentage;
 
     EventSelectionIDVector selectionIDs = eventPrincipal.eventSelectionIDs();
@@ -208,8 +212,22 @@ namespace edm {
     // should test if compressed already - should never be?
     //   as double compression can have problems
     if(use_compression) {
-      unsigned int dest_size =
-        compressBuffer(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level);
+      unsigned int dest_size = 0;
+      switch(compression_algo) {
+        case LZ4:
+          dest_size = compressBufferLZ4(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level);
+          break;
+        case ZSTD:
+          if(!zstdContext_) {
+            zstdContext_.reset(ZSTD_createCCtx(), [](ZSTD_CCtx* iContext) { ZSTD_freeCCtx(iContext); });
+          }
+          dest_size = compressBufferZSTD(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level,
+                                         zstdContext_.get(), zstdDictionary_.get());
+          break;
+        default:
+          dest_size = compressBuffer(data_buffer.ptr_, data_buffer.curr_event_size_, data_buffer.comp_buf_, compression_level);
+          break;
+      }
       if(dest_size != 0) {
         data_buffer.ptr_ = &data_buffer.comp_buf_[0]; // reset to point at compressed area
         data_buffer.curr_space_used_ = dest_size;
@@ -263,4 +281,72 @@ namespace edm {
 
     return resultSize;
   }
+
+  unsigned int
+  StreamSerializer::compressBufferLZ4(unsigned char *inputBuffer,
+                                      unsigned int inputSize,
+                                      std::vector<unsigned char> &outputBuffer,
+                                      int compressionLevel) {
+    unsigned int dest_size = LZ4_compressBound(inputSize);
+    if(outputBuffer.size() < dest_size) outputBuffer.resize(dest_size);
+
+    // levels below the HC minimum use the fast compressor
+    int ret = 0;
+    if(compressionLevel < LZ4HC_CLEVEL_MIN) {
+      ret = LZ4_compress_default((char const*)inputBuffer, (char*)&outputBuffer[0], inputSize, dest_size);
+    } else {
+      ret = LZ4_compress_HC((char const*)inputBuffer, (char*)&outputBuffer[0], inputSize, dest_size, compressionLevel);
+    }
+    if(ret <= 0) {
+      std::cerr << "LZ4 compression failed for buffer of size " << inputSize << std::endl;
+      return 0;
+    }
+    FDEBUG(1) << " original size = " << inputSize
+              << " final size = " << ret
+              << " ratio = " << double(ret)/double(inputSize)
+              << std::endl;
+    return ret;
+  }
+
+  unsigned int
+  StreamSerializer::compressBufferZSTD(unsigned char *inputBuffer,
+                                       unsigned int inputSize,
+                                       std::vector<unsigned char> &outputBuffer,
+                                       int compressionLevel,
+                                       ZSTD_CCtx_s* context,
+                                       ZSTD_CDict_s const* dictionary) {
+    size_t dest_size = ZSTD_compressBound(inputSize);
+    if(outputBuffer.size() < dest_size) outputBuffer.resize(dest_size);
+
+    size_t ret = 0;
+    if(dictionary) {
+      ret = ZSTD_compress_usingCDict(context, &outputBuffer[0], dest_size, inputBuffer, inputSize, dictionary);
+    } else {
+      ret = ZSTD_compressCCtx(context, &outputBuffer[0], dest_size, inputBuffer, inputSize, compressionLevel);
+    }
+    if(ZSTD_isError(ret)) {
+      std::cerr << "ZSTD compression failed: " << ZSTD_getErrorName(ret) << std::endl;
+      return 0;
+    }
+    FDEBUG(1) << " original size = " << inputSize
+              << " final size = " << ret
+              << " ratio = " << double(ret)/double(inputSize)
+              << std::endl;
+    return ret;
+  }
+
+  void
+  StreamSerializer::setZstdDictionary(std::vector<unsigned char> const& dictionary, int compressionLevel) {
+    if(dictionary.empty()) {
+      zstdDictionary_.reset();
+      return;
+    }
+    ZSTD_CDict* dict = ZSTD_createCDict(&dictionary[0], dictionary.size(), compressionLevel);
+    if(dict == nullptr) {
+      throw cms::Exception("StreamTranslation","Invalid compression dictionary")
+        << "StreamSerializer could not create a ZSTD dictionary from "
+        << dictionary.size() << " bytes\n";
+    }
+    zstdDictionary_.reset(dict, [](ZSTD_CDict* iDict) { ZSTD_freeCDict(iDict); });
+  }
 }
@@ -3,6 +3,7 @@
 #include "IOPool/Streamer/interface/EventMessage.h"
 #include "IOPool/Streamer/interface/InitMessage.h"
 #include "IOPool/Streamer/interface/ClassFiller.h"
+#include "IOPool/Streamer/interface/StreamSerializer.h"
 
 #include "FWCore/Framework/interface/EventPrincipal.h"
 #include "FWCore/Framework/interface/FileBlock.h"
@@ -17,6 +18,8 @@
 #include "DataFormats/Provenance/interface/ThinnedAssociationsHelper.h"
 
 #include "zlib.h"
+#include "lz4.h"
+#include "zstd.h"
 
 #include "DataFormats/Common/interface/RefCoreStreamer.h"
 #include "FWCore/Utilities/interface/WrappedClassName.h"
@@ -50,7 +53,9 @@ namespace edm {
     eventPrincipalHolder_(),
     adjustEventToNewProductRegistry_(false),
     processName_(),
-    protocolVersion_(0U) {
+    protocolVersion_(0U),
+    zstdContext_(),
+    zstdDictionary_() {
   }
 
   StreamerInputSource::~StreamerInputSource() {}
@@ -147,6 +152,17 @@ namespace edm {
       // skip event (based on option?) or throw exception?
     }
 
+    // each INIT message carries the dictionary, if any, of the events which follow it
+    zstdDictionary_.reset();
+    if(initView.compressionDictionaryLength() > 0) {
+      ZSTD_DDict* dict = ZSTD_createDDict(initView.compressionDictionary(), initView.compressionDictionaryLength());
+      if(dict == nullptr) {
+        throw cms::Exception("StreamTranslation","Registry deserialization error")
+          << "Could not create the ZSTD dictionary stored in the INIT message\n";
+      }
+      zstdDictionary_.reset(dict, [](ZSTD_DDict* iDict) { ZSTD_freeDDict(iDict); });
+    }
+
     TClass* desc = getTClass(typeid(SendJobHeader));
 
     TBufferFile xbuf(TBuffer::kRead, initView.descLength(),
@@ -218,8 +234,25 @@ namespace edm {
     }
     if(origsize != 78 && origsize != 0) {
       // compressed
-      dest_size = uncompressBuffer(const_cast<unsigned char*>((unsigned char const*)eventView.eventData()),
-                                   eventView.eventLength(), dest_, origsize);
+      unsigned char* data = const_cast<unsigned char*>((unsigned char const*)eventView.eventData());
+      switch(eventView.compressionAlgorithm()) {
+        case ZLIB:
+          dest_size = uncompressBuffer(data, eventView.eventLength(), dest_, origsize);
+          break;
+        case LZ4:
+          dest_size = uncompressBufferLZ4(data, eventView.eventLength(), dest_, origsize);
+          break;
+        case ZSTD:
+          if(!zstdContext_) {
+            zstdContext_.reset(ZSTD_createDCtx(), [](ZSTD_DCtx* iContext) { ZSTD_freeDCtx(iContext); });
+          }
+          dest_size = uncompressBufferZSTD(data, eventView.eventLength(), dest_, origsize,
+                                           zstdContext_.get(), zstdDictionary_.get());
+          break;
+        default:
+          throw cms::Exception("StreamTranslation","Event deserialization error")
+            << "unknown compression algorithm " << eventView.compressionAlgorithm() << "\n";
+      }
     } else { // not compressed
       // we need to copy anyway the buffer as we are using dest in xbuf
       dest_size = eventView.eventLength();
@@ -352,6 +385,47 @@ namespace edm {
     return (unsigned int) uncompressedSize;
   }
 
+  unsigned int
+  StreamerInputSource::uncompressBufferLZ4(unsigned char* inputBuffer,
+                                           unsigned int inputSize,
+                                           std::vector<unsigned char>& outputBuffer,
+                                           unsigned int expectedFullSize) {
+    outputBuffer.resize(expectedFullSize);
+    int ret = LZ4_decompress_safe((char const*)inputBuffer, (char*)&outputBuffer[0], inputSize, expectedFullSize);
+    if(ret < 0 || (unsigned int)ret != expectedFullSize) {
+      throw cms::Exception("StreamDeserialization","Uncompression error")
+        << "LZ4 uncompression of " << inputSize << " bytes failed, expected "
+        << expectedFullSize << " bytes, return value = " << ret << "\n";
+    }
+    return expectedFullSize;
+  }
+
+  unsigned int
+  StreamerInputSource::uncompressBufferZSTD(unsigned char* inputBuffer,
+                                            unsigned int inputSize,
+                                            std::vector<unsigned char>& outputBuffer,
+                                            unsigned int expectedFullSize,
+                                            ZSTD_DCtx_s* context,
+                                            ZSTD_DDict_s const* dictionary) {
+    outputBuffer.resize(expectedFullSize);
+    size_t ret = 0;
+    if(dictionary) {
+      ret = ZSTD_decompress_usingDDict(context, &outputBuffer[0], expectedFullSize, inputBuffer, inputSize, dictionary);
+    } else {
+      ret = ZSTD_decompressDCtx(context, &outputBuffer[0], expectedFullSize, inputBuffer, inputSize);
+    }
+    if(ZSTD_isError(ret)) {
+      throw cms::Exception("StreamDeserialization","Uncompression error")
+        << "ZSTD uncompression failed: " << ZSTD_getErrorName(ret) << "\n";
+    }
+    if(ret != expectedFullSize) {
+      throw cms::Exception("StreamDeserialization","Uncompression error")
+        << "mismatch event lengths should be" << expectedFullSize << " got "
+        << ret << "\n";
+    }
+    return ret;
+  }
+
   void StreamerInputSource::resetAfterEndRun() {
      // called from an online streamer source to reset after a stop command
      // so an enable command will work
@@ -9,18 +9,22 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/Utilities/interface/DebugMacros.h"
+#include "FWCore/Utilities/interface/EDMException.h"
 //#include "FWCore/Utilities/interface/Digest.h"
 #include "FWCore/Version/interface/GetReleaseVersion.h"
 #include "DataFormats/Common/interface/TriggerResults.h"
 #include "DataFormats/Provenance/interface/ParameterSetID.h"
 
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <sys/time.h>
 #include <unistd.h>
 #include <vector>
 #include "zlib.h"
+#include "zstd.h"
 
 namespace {
   //A utility function that packs bits from source into bytes, with
@@ -60,6 +64,8 @@ namespace edm {
     maxEventSize_(ps.getUntrackedParameter<int>("max_event_size")),
     useCompression_(ps.getUntrackedParameter<bool>("use_compression")),
     compressionLevel_(ps.getUntrackedParameter<int>("compression_level")),
+    compressionAlgorithm_(ZLIB),
+    compressionDictionary_(),
     lumiSectionInterval_(ps.getUntrackedParameter<int>("lumiSection_interval")),
     serializer_(selections_),
     serializeDataBuffer_(),
@@ -79,18 +85,48 @@ namespace edm {
     gettimeofday(&now, &dummyTZ);
     timeInSecSinceUTC = static_cast<double>(now.tv_sec) + (static_cast<double>(now.tv_usec)/1000000.0);
 
+    std::string const algorithm = ps.getUntrackedParameter<std::string>("compression_algorithm");
+    int maxCompressionLevel = 9;
+    if(algorithm == "ZLIB") {
+      compressionAlgorithm_ = ZLIB;
+    } else if(algorithm == "LZ4") {
+      compressionAlgorithm_ = LZ4;
+    } else if(algorithm == "ZSTD") {
+      compressionAlgorithm_ = ZSTD;
+      maxCompressionLevel = ZSTD_maxCLevel();
+    } else {
+      throw Exception(errors::Configuration)
+        << "StreamerOutputModuleBase: unknown compression_algorithm '" << algorithm << "'\n"
+        << "Allowed values are ZLIB, LZ4 and ZSTD.\n";
+    }
+
     if(useCompression_ == true) {
       if(compressionLevel_ <= 0) {
         FDEBUG(9) << "Compression Level = " << compressionLevel_
                   << " no compression" << std::endl;
         compressionLevel_ = 0;
         useCompression_ = false;
-      } else if(compressionLevel_ > 9) {
+      } else if(compressionLevel_ > maxCompressionLevel) {
         FDEBUG(9) << "Compression Level = " << compressionLevel_
-                  << " using max compression level 9" << std::endl;
-        compressionLevel_ = 9;
+                  << " using max compression level " << maxCompressionLevel << std::endl;
+        compressionLevel_ = maxCompressionLevel;
       }
     }
+
+    std::string const dictionaryFile = ps.getUntrackedParameter<std::string>("compression_dictionary");
+    if(!dictionaryFile.empty()) {
+      if(compressionAlgorithm_ != ZSTD) {
+        throw Exception(errors::Configuration)
+          << "StreamerOutputModuleBase: compression_dictionary can only be used with the ZSTD compression_algorithm\n";
+      }
+      std::ifstream dictionary(dictionaryFile.c_str(), std::ios::binary);
+      if(!dictionary) {
+        throw Exception(errors::Configuration)
+          << "StreamerOutputModuleBase: could not open compression_dictionary '" << dictionaryFile << "'\n";
+      }
+      compressionDictionary_.assign(std::istreambuf_iterator<char>(dictionary), std::istreambuf_iterator<char>());
+      if(useCompression_) serializer_.setZstdDictionary(compressionDictionary_, compressionLevel_);
+    }
     serializeDataBuffer_.bufs_.resize(maxEventSize_);
     int got_host = gethostname(host_name_, 255);
     if(got_host != 0) strncpy(host_name_, "noHostNameFoundOrTooLong", sizeof(host_name_));
@@ -143,7 +179,7 @@ namespace edm {
     // resize bufs_ to reflect space used in serializer_ + header
     // I just added an overhead for header of 50000 for now
     unsigned int src_size = serializeDataBuffer_.currentSpaceUsed();
-    unsigned int new_size = src_size + 50000;
+    unsigned int new_size = src_size + 50000 + compressionDictionary_.size();
     if(serializeDataBuffer_.header_buf_.size() < new_size) serializeDataBuffer_.header_buf_.resize(new_size);
 
     //Build the INIT Message
@@ -184,7 +220,8 @@ namespace edm {
                            getReleaseVersion().c_str() , processName.c_str(),
                            moduleLabel.c_str(), outputModuleId_,
                            hltTriggerNames, hltTriggerSelections_, l1_names,
-                           (uint32)serializeDataBuffer_.adler32_chksum()));
+                           (uint32)serializeDataBuffer_.adler32_chksum(),
+                           useCompression_ ? compressionDictionary_ : std::vector<uint8>()));
 
     // copy data into the destination message
     unsigned char* src = serializeDataBuffer_.bufferPointer();
@@ -253,7 +290,8 @@ namespace edm {
       setLumiSection();
     }
 
-    serializer_.serializeEvent(e, selectorConfig(), useCompression_, compressionLevel_, serializeDataBuffer_, mcc);
+    serializer_.serializeEvent(e, selectorConfig(), useCompression_, compressionLevel_, serializeDataBuffer_, mcc,
+                               compressionAlgorithm_);
 
     // resize bufs_ to reflect space used in serializer_ + header
     // I just added an overhead for header of 50000 for now
@@ -280,7 +318,10 @@ namespace edm {
     unsigned char* src = serializeDataBuffer_.bufferPointer();
     std::copy(src,src + src_size, msg->eventAddr());
     msg->setEventLength(src_size);
-    if(useCompression_) msg->setOrigDataSize(serializeDataBuffer_.currentEventSize());
+    if(useCompression_) {
+      msg->setOrigDataSize(serializeDataBuffer_.currentEventSize());
+      msg->setCompressionAlgorithm(compressionAlgorithm_);
+    }
 
     l1bit_.clear();  //Clear up for the next event to come.
     return msg;
@@ -293,7 +334,13 @@ namespace edm {
     desc.addUntracked<bool>("use_compression", true)
         ->setComment("If True, compression will be used to write streamer file.");
     desc.addUntracked<int>("compression_level", 1)
-        ->setComment("ROOT compression level to use.");
+        ->setComment("Compression level to use, the allowed range depends on compression_algorithm.");
+    desc.addUntracked<std::string>("compression_algorithm", "ZLIB")
+        ->setComment("Algorithm used to compress the event data: ZLIB, LZ4 or ZSTD.");
+    desc.addUntracked<std::string>("compression_dictionary", "")
+        ->setComment("If not empty, a file holding a zstd dictionary (e.g. made by trainStreamerDictionary)\n"
+                     "which is used to compress the events and is stored in the INIT message.\n"
+                     "Only allowed with the ZSTD compression_algorithm.");
     desc.addUntracked<int>("lumiSection_interval", 0)
         ->setComment("If 0, use lumi section number from event.\n"
                      "If not 0, the interval in seconds between fake lumi sections.");
@@ -62,7 +62,7 @@ int main() try {
                       Version((const uint8*)psetid),(const char*)reltag,
 		      processName.c_str(),outputModuleLabel.c_str(), crc,
                       hlt_names,hlt_names,l1_names,
-                      adler32_chksum);
+                      adler32_chksum, std::vector<uint8>(16, 0xab));
 
 
   init.setDataLength(sizeof(test_value));
@@ -78,6 +78,8 @@ int main() try {
   view.l1TriggerNames(l12);
 
   uint32 adler32_2 = view.adler32_chksum();
+  std::vector<uint8> dictionary(view.compressionDictionary(),
+                                view.compressionDictionary()+view.compressionDictionaryLength());
 
 
   InitMsgBuilder init2(&buf2[0],buf2.size(),
@@ -86,7 +88,7 @@ int main() try {
                        view.releaseTag().c_str(),
                        processName.c_str(),outputModuleLabel.c_str(), crc,
                        hlt2,hlt2,l12,
-                       adler32_2);
+                       adler32_2, dictionary);
 
   init2.setDataLength(view.descLength());
   std::copy(view.descData(),view.descData()+view.size(),
@@ -118,6 +120,7 @@ int main() try {
                       l1bit,hltbits,hltsize, adler32_chksum, host_name.c_str());
 
   emb.setOrigDataSize(78);
+  emb.setCompressionAlgorithm(3);
   emb.setEventLength(sizeof(test_value));
   std::copy(&test_value[0],&test_value[0]+sizeof(test_value),
             emb.eventAddr());
@@ -146,6 +149,7 @@ int main() try {
                        host_name2.c_str());
 
   emb2.setOrigDataSize(eview.origDataSize());
+  emb2.setCompressionAlgorithm(eview.compressionAlgorithm());
   emb2.setEventLength(eview.eventLength());
   std::copy(eview.eventData(),eview.eventData()+eview.eventLength(),
             emb2.eventAddr());
@@ -86,6 +86,8 @@
       readHint_("auto-detect"),
       tempDir_(),
       minFree_(0),
+      blockCacheDir_(),
+      blockCacheMaxSize_(0),
       timeout_(0U),
       debugLevel_(0U),
       native_() {
@@ -103,6 +105,7 @@
     readHint_ = pset.getUntrackedParameter<std::string> ("readHint", readHint_);
     tempDir_ = pset.getUntrackedParameter<std::string> ("tempDir", f->tempPath());
     minFree_ = pset.getUntrackedParameter<double> ("tempMinFree", f->tempMinFree());
+    blockCacheMaxSize_ = f->blockCacheMaxSize();
     native_ = pset.getUntrackedParameter<std::vector<std::string> >("native", native_);
 
     ar.watchPostEndJob(this, &TFileAdaptor::termination);
@@ -117,6 +120,12 @@
       if (double const* p = pSLC->sourceCacheMinFree()) {
         minFree_ = *p;
       }
+      if (std::string const* p = pSLC->sourceBlockCacheDir()) {
+        blockCacheDir_ = *p;
+      }
+      if (double const* p = pSLC->sourceBlockCacheMaxSize()) {
+        blockCacheMaxSize_ = *p;
+      }
       if (std::string const* p = pSLC->sourceCacheHint()) {
         cacheHint_ = *p;
       }
@@ -173,6 +182,11 @@
     // tell where to save files.
     f->setTempDir(tempDir_, minFree_);
 
+    // share blocks of remote files with the other jobs on the node.
+    if (!blockCacheDir_.empty()) {
+      f->setBlockCache(blockCacheDir_, blockCacheMaxSize_);
+    }
+
     // set our own root plugins
     TPluginManager* mgr = gROOT->GetPluginManager();
 
@@ -229,6 +243,7 @@
       << " Prefetching:" << (enablePrefetching_ ? "true" : "false") << '\n'
       << " Cache hint:" << cacheHint_ << '\n'
       << " Read hint:" << readHint_ << '\n'
+      << " Block cache:" << (blockCacheDir_.empty() ? "none" : blockCacheDir_) << '\n'
       << "Storage statistics: "
       << StorageAccount::summaryText()
       << "; tfile/read=?/?/" << (TFile::GetFileBytesRead() / oneMeg) << "MB/?ms/?ms/?ms"
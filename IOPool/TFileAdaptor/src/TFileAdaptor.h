@@ -42,6 +42,8 @@ private:
   std::string readHint_;
   std::string tempDir_;
   double minFree_;
+  std::string blockCacheDir_;
+  double blockCacheMaxSize_;
   unsigned int timeout_;
   unsigned int debugLevel_;
   std::vector<std::string> native_;
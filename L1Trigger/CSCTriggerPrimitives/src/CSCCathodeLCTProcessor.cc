@@ -30,6 +30,7 @@
 
 #include <FWCore/MessageLogger/interface/MessageLogger.h>
 #include <algorithm>
+#include <bitset>
 #include <iomanip>
 #include <iostream>
 #include <set>
@@ -2359,15 +2360,28 @@ bool CSCCathodeLCTProcessor::ptnFinding(
   }
 
   // Loop over candidate key strips.
-  bool hit_layer[CSCConstants::NUM_LAYERS];
   for (int key_hstrip = stagger[CSCConstants::KEY_CLCT_LAYER - 1]; key_hstrip < nStrips; key_hstrip++)
   {
     // Loop over patterns and look for hits matching each pattern.
     for (unsigned int pid = CSCConstants::NUM_CLCT_PATTERNS - 1; pid >= pid_thresh_pretrig; pid--)
     {
-      layers_hit = 0;
-      for (int ilayer = 0; ilayer < CSCConstants::NUM_LAYERS; ilayer++)
-	hit_layer[ilayer] = false;
+      // Count the layers hit in the pattern, as bits of a layer mask. The
+      // hit times are only needed for the patterns better than the ones
+      // already tried for this key, or for the debug printout.
+      unsigned int layer_bits = 0;
+      for (int strip_num = 0; strip_num < NUM_PATTERN_HALFSTRIPS; strip_num++)
+      {
+	int this_layer = pattern2007[pid][strip_num];
+        if (this_layer >= 0 && this_layer < CSCConstants::NUM_LAYERS)
+        {
+	  int this_strip = pattern2007_offset[strip_num] + key_hstrip;
+	  if (this_strip >= 0 && this_strip < nStrips &&
+	      ((pulse[this_layer][this_strip] >> bx_time) & 1) == 1)
+	    layer_bits |= 1 << this_layer;
+	}
+      }
+      layers_hit = std::bitset<CSCConstants::NUM_LAYERS>(layer_bits).count();
+      if (layers_hit <= nhits[key_hstrip] && infoV <= 2) continue;
 
       double num_pattern_hits=0., times_sum=0.;
       std::multiset<int> mset_for_median;
@@ -2389,12 +2403,6 @@ bool CSCCathodeLCTProcessor::ptnFinding(
 	    // Determine if "one shot" is high at this bx_time
             if (((pulse[this_layer][this_strip] >> bx_time) & 1) == 1)
             {
-              if (hit_layer[this_layer] == false)
-              {
-		hit_layer[this_layer] = true;
-		layers_hit++;     // determines number of layers hit
-	      }
-
               // find at what bx did pulse on this halsfstrip&layer have started
               // use hit_pesrist constraint on how far back we can go
               int first_bx_layer = bx_time;
@@ -0,0 +1,142 @@
+///
+/// \class l1t::GtMenuRates.cc
+///
+/// Description: rates of several L1 menu variants from a single GT emulation.
+///
+/// Implementation:
+///    Each menu variant is a list of algorithm bits with their prescales; it
+///    accepts an event if one of its algorithms passes, after its prescale,
+///    in the initial (unprescaled) decision word of the bx 0 GlobalAlgBlk.
+///    The prescales are applied with one counter per algorithm and menu, as
+///    in the GT. The number of accepted events, and of the ones accepted by
+///    no other menu, are printed at the end of the job.
+///
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+// system include files
+#include <string>
+#include <vector>
+
+// user include files
+//   base class
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+
+#include "DataFormats/L1TGlobal/interface/GlobalAlgBlk.h"
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+using namespace edm;
+using namespace std;
+
+namespace l1t {
+
+  // class declaration
+  class GtMenuRates : public edm::EDAnalyzer {
+  public:
+    explicit GtMenuRates(const edm::ParameterSet&);
+    virtual ~GtMenuRates(){};
+    virtual void analyze(const edm::Event&, const edm::EventSetup&);
+    virtual void endJob();
+
+  private:
+    struct Menu {
+      std::string name;
+      std::vector<unsigned int> algoBits;
+      std::vector<unsigned int> prescales;   // 0: algorithm disabled
+      std::vector<unsigned int> counters;
+      unsigned long long nAccepted;
+      unsigned long long nPure;
+    };
+
+    EDGetToken uGtAlgToken;
+
+    std::vector<Menu> m_menus;
+    std::vector<bool> m_accepted;            // by menu, for the current event
+    unsigned long long m_nEvents;
+  };
+
+  GtMenuRates::GtMenuRates(const edm::ParameterSet& iConfig) : m_nEvents(0)
+  {
+      uGtAlgToken = consumes<BXVector<GlobalAlgBlk>>(iConfig.getParameter<InputTag>("uGtAlgInputTag"));
+
+      const std::vector<edm::ParameterSet>& menus = iConfig.getParameter<std::vector<edm::ParameterSet> >("menus");
+      for (std::vector<edm::ParameterSet>::const_iterator pset = menus.begin(); pset != menus.end(); ++pset) {
+        Menu menu;
+        menu.name      = pset->getParameter<std::string>("name");
+        menu.algoBits  = pset->getParameter<std::vector<unsigned int> >("algoBits");
+        // unprescaled by default
+        menu.prescales = pset->existsAs<std::vector<unsigned int> >("prescales") ?
+          pset->getParameter<std::vector<unsigned int> >("prescales") : std::vector<unsigned int>(menu.algoBits.size(), 1);
+        if (menu.prescales.size() != menu.algoBits.size())
+          throw cms::Exception("Configuration")
+            << "GtMenuRates: menu " << menu.name << " has " << menu.algoBits.size()
+            << " algorithm bits and " << menu.prescales.size() << " prescales";
+        for (unsigned int i = 0; i < menu.algoBits.size(); ++i)
+          if (menu.algoBits[i] >= L1GlobalTriggerReadoutSetup::NumberPhysTriggers)
+            throw cms::Exception("Configuration")
+              << "GtMenuRates: menu " << menu.name << " has the algorithm bit " << menu.algoBits[i]
+              << ", beyond the " << L1GlobalTriggerReadoutSetup::NumberPhysTriggers << " physics triggers";
+        menu.counters.assign(menu.algoBits.size(), 0);
+        menu.nAccepted = 0;
+        menu.nPure     = 0;
+        m_menus.push_back(menu);
+      }
+      m_accepted.assign(m_menus.size(), false);
+  }
+
+  // loop over events
+  void GtMenuRates::analyze(const edm::Event& iEvent, const edm::EventSetup& evSetup){
+
+    Handle<BXVector<GlobalAlgBlk>> uGtAlg;
+    iEvent.getByToken(uGtAlgToken,uGtAlg);
+    if (!uGtAlg.isValid() || 0 < uGtAlg->getFirstBX() || 0 > uGtAlg->getLastBX() || uGtAlg->begin(0) == uGtAlg->end(0)) {
+      edm::LogWarning("GtMenuRates") << "No uGtAlg data for bx 0 in this event, skipped";
+      return;
+    }
+    const GlobalAlgBlk& algBlk = *uGtAlg->begin(0);
+
+    ++m_nEvents;
+    unsigned int nAccepted = 0;
+    for (unsigned int iMenu = 0; iMenu < m_menus.size(); ++iMenu) {
+      Menu& menu = m_menus[iMenu];
+      bool accept = false;
+      // all the algorithms are looked at, so that their prescale counters are the same as in the GT
+      for (unsigned int i = 0; i < menu.algoBits.size(); ++i) {
+        if (menu.prescales[i] == 0 || !algBlk.getAlgoDecisionInitial(menu.algoBits[i])) continue;
+        if (++menu.counters[i] == menu.prescales[i]) {
+          menu.counters[i] = 0;
+          accept = true;
+        }
+      }
+      m_accepted[iMenu] = accept;
+      if (accept) {
+        ++menu.nAccepted;
+        ++nAccepted;
+      }
+    }
+    if (nAccepted == 1)
+      for (unsigned int iMenu = 0; iMenu < m_menus.size(); ++iMenu)
+        if (m_accepted[iMenu]) ++m_menus[iMenu].nPure;
+  }
+
+  void GtMenuRates::endJob(){
+
+    edm::LogVerbatim out("GtMenuRates");
+    out << "L1 menu rates for " << m_nEvents << " events (accepted, fraction, accepted by no other menu):\n";
+    for (std::vector<Menu>::const_iterator menu = m_menus.begin(); menu != m_menus.end(); ++menu)
+      out << "  " << menu->name << " " << menu->nAccepted << " "
+          << (m_nEvents ? double(menu->nAccepted)/m_nEvents : 0.) << " " << menu->nPure << "\n";
+  }
+
+}
+
+DEFINE_FWK_MODULE(l1t::GtMenuRates);
@@ -1,6 +1,8 @@
 #ifndef L1RCTLookupTables_h
 #define L1RCTLookupTables_h
 
+#include <vector>
+
 class L1RCTParameters;
 struct L1RCTChannelMask;
 struct L1RCTNoisyChannelMask;
@@ -22,21 +24,25 @@ class L1RCTLookupTables {
   void setRCTParameters(const L1RCTParameters* rctParameters)
     {
       rctParameters_ = rctParameters;
+      emptyTowerLookup_.clear();
     }
   // ditto for channel mask
   void setChannelMask(const L1RCTChannelMask* channelMask)
     {
       channelMask_ = channelMask;
+      emptyTowerLookup_.clear();
     }
   void setNoisyChannelMask(const L1RCTNoisyChannelMask* channelMask)
     {
       noisyChannelMask_ = channelMask;
+      emptyTowerLookup_.clear();
     }
 
   // ditto for hcal TPG scale
   void setHcalScale(const L1CaloHcalScale* hcalScale)
     {
       hcalScale_ = hcalScale;
+      emptyTowerLookup_.clear();
     }
   // ditto for caloEtScale
   void setL1CaloEtScale(const L1CaloEtScale* etScale)
@@ -47,6 +53,7 @@ class L1RCTLookupTables {
   void setEcalScale(const L1CaloEcalScale* ecalScale)
     {
       ecalScale_ = ecalScale;
+      emptyTowerLookup_.clear();
     }
 
   const L1RCTParameters* rctParameters() const {return rctParameters_;}
@@ -86,5 +93,10 @@ class L1RCTLookupTables {
   const L1CaloHcalScale* hcalScale_;
   const L1CaloEtScale* etScale_;
 
+  // lookup of the towers with no ecal and hcal energy (most of them), by
+  // crate, card, tower and fg bit, -1 if not computed yet; cleared when the
+  // configuration is set
+  mutable std::vector<int> emptyTowerLookup_;
+
 };
 #endif
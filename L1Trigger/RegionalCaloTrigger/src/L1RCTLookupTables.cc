@@ -43,6 +43,14 @@ unsigned int L1RCTLookupTables::lookup(unsigned short ecalInput,
   if(fgbit > 1) 
     throw cms::Exception("Invalid Data") 
       << "ECAL finegrain should be a single bit, is " << fgbit;
+  // the lookup of an empty tower only depends on the configuration
+  int* emptyTower = 0;
+  if(ecalInput == 0 && hcalInput == 0 && crtNo < 18 && crdNo < 7 && twrNo < 32)
+    {
+      if(emptyTowerLookup_.empty()) emptyTowerLookup_.assign(18*7*32*2, -1);
+      emptyTower = &emptyTowerLookup_[((crtNo*7 + crdNo)*32 + twrNo)*2 + fgbit];
+      if(*emptyTower >= 0) return *emptyTower;
+    }
   short iEta = (short) rctParameters_->calcIEta(crtNo, crdNo, twrNo);
   unsigned short iAbsEta = (unsigned short) abs(iEta);
   short sign = iEta/iAbsEta;
@@ -157,6 +165,7 @@ unsigned int L1RCTLookupTables::lookup(unsigned short ecalInput,
       shiftActivityBit = activityBit(ecal, hcal)<<17;
     }
   unsigned long output=etIn7Bits+shiftHE_FGBit+shiftEtIn9Bits+shiftActivityBit;
+  if(emptyTower) *emptyTower = output;
   return output;
 }
 
@@ -0,0 +1,55 @@
+/** \file
+ *
+ */
+
+#include "MagneticField/SampledEngine/plugins/GridSampledMagneticFieldESProducer.h"
+#include "MagneticField/SampledEngine/src/GridSampledMagneticField.h"
+
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/ModuleFactory.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+using namespace magneticfield;
+
+namespace {
+  // by default the tracker volume
+  const std::vector<double> defaultMin = {-120., -120., -300.};
+  const std::vector<double> defaultMax = { 120.,  120.,  300.};
+}
+
+GridSampledMagneticFieldESProducer::GridSampledMagneticFieldESProducer(const edm::ParameterSet& pset) :
+  referenceLabel(pset.getParameter<std::string>("referenceLabel")),
+  gridMin(pset.existsAs<std::vector<double> >("gridMin") ? pset.getParameter<std::vector<double> >("gridMin") : defaultMin),
+  gridMax(pset.existsAs<std::vector<double> >("gridMax") ? pset.getParameter<std::vector<double> >("gridMax") : defaultMax),
+  spacing(pset.existsAs<double>("spacing") ? pset.getParameter<double>("spacing") : 5.),
+  tolerance(pset.existsAs<double>("tolerance") ? pset.getParameter<double>("tolerance") : 0.001)
+{
+  std::string label = pset.getUntrackedParameter<std::string>("label","");
+  if (label == referenceLabel)
+    throw cms::Exception("Configuration") << "GridSampledMagneticFieldESProducer: the label and the referenceLabel must differ";
+  if (gridMin.size()!=3 || gridMax.size()!=3)
+    throw cms::Exception("Configuration") << "GridSampledMagneticFieldESProducer: gridMin and gridMax must have 3 elements";
+  setWhatProduced(this, label);
+}
+
+
+std::auto_ptr<MagneticField> GridSampledMagneticFieldESProducer::produce(const IdealMagneticFieldRecord & iRecord)
+{
+  edm::ESHandle<MagneticField> reference;
+  iRecord.get(referenceLabel, reference);
+
+  GridSampledMagneticField * field = new GridSampledMagneticField(reference.product(),
+								   GlobalPoint(gridMin[0], gridMin[1], gridMin[2]),
+								   GlobalPoint(gridMax[0], gridMax[1], gridMax[2]),
+								   spacing, tolerance);
+  edm::LogInfo("GridSampledMagneticField") << "sampled the field " << referenceLabel << " every " << spacing << " cm: "
+					   << 100.f*field->interpolatedFraction() << "% of the cells interpolated, with a maximum error of "
+					   << field->maxError() << " T at the cell centres";
+  std::auto_ptr<MagneticField> s(field);
+  return s;
+}
+
+DEFINE_FWK_EVENTSETUP_MODULE(GridSampledMagneticFieldESProducer);
@@ -0,0 +1,43 @@
+#ifndef GridSampledMagneticFieldESProducer_h
+#define GridSampledMagneticFieldESProducer_h
+
+/** \class GridSampledMagneticFieldESProducer
+ *
+ *  Producer for the GridSampledMagneticField, sampling the field with
+ *  label referenceLabel of the same record.
+ *
+ */
+
+#include "FWCore/Framework/interface/EventSetupRecordIntervalFinder.h"
+#include "FWCore/Framework/interface/ESProducer.h"
+
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include <string>
+#include <vector>
+
+class IdealMagneticFieldRecord;
+
+namespace magneticfield {
+  class GridSampledMagneticFieldESProducer : public edm::ESProducer {
+  public:
+    GridSampledMagneticFieldESProducer(const edm::ParameterSet& pset);
+  
+    std::auto_ptr<MagneticField> produce(const IdealMagneticFieldRecord &);
+
+  private:
+    // forbid copy ctor and assignment op.
+    GridSampledMagneticFieldESProducer(const GridSampledMagneticFieldESProducer&);
+    const GridSampledMagneticFieldESProducer& operator=(const GridSampledMagneticFieldESProducer&);
+
+    std::string referenceLabel;
+    std::vector<double> gridMin;   // x, y, z [cm]
+    std::vector<double> gridMax;
+    double spacing;                // [cm]
+    double tolerance;              // [T]
+  };
+}
+
+
+#endif
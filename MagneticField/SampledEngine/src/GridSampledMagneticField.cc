@@ -0,0 +1,108 @@
+/** \file
+ *
+ */
+
+#include "MagneticField/SampledEngine/src/GridSampledMagneticField.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+
+GridSampledMagneticField::GridSampledMagneticField(const MagneticField* reference,
+						   const GlobalPoint& min, const GlobalPoint& max,
+						   float spacing, float tolerance) :
+  theReference(reference), theSpacing(spacing), theInvSpacing(1.f/spacing), theMaxError(0)
+{
+  if (reference==0) throw cms::Exception("Configuration") << "GridSampledMagneticField: no reference field";
+  if (!(spacing>0)) throw cms::Exception("Configuration") << "GridSampledMagneticField: invalid spacing " << spacing;
+
+  float lo[3] = {min.x(), min.y(), min.z()};
+  float hi[3] = {max.x(), max.y(), max.z()};
+  for (int a=0; a!=3; ++a) {
+    if (!(hi[a]>lo[a])) throw cms::Exception("Configuration") << "GridSampledMagneticField: empty grid along axis " << a;
+    theMin[a] = lo[a];
+    theN[a] = int(std::ceil((hi[a]-lo[a])*theInvSpacing)) + 1;
+  }
+
+  // sample the reference at the nodes
+  theField.resize(theN[0]*theN[1]*theN[2]);
+  std::vector<bool> undefined(theField.size(), false);
+  for (int i=0; i!=theN[0]; ++i)
+    for (int j=0; j!=theN[1]; ++j)
+      for (int k=0; k!=theN[2]; ++k) {
+	GlobalPoint gp(theMin[0]+i*theSpacing, theMin[1]+j*theSpacing, theMin[2]+k*theSpacing);
+	int n = node(i,j,k);
+	if (theReference->isDefined(gp)) {
+	  theField[n] = theReference->inTesla(gp).basicVector().mathVector();
+	} else {
+	  theField[n] = Vec4<float>{0,0,0,0};
+	  undefined[n] = true;
+	}
+      }
+
+  // check the interpolation at the centre of each cell
+  theDelegated.assign(theField.size(), true);
+  const float centre[3] = {0.5f, 0.5f, 0.5f};
+  for (int i=0; i+1<theN[0]; ++i)
+    for (int j=0; j+1<theN[1]; ++j)
+      for (int k=0; k+1<theN[2]; ++k) {
+	int cell = node(i,j,k);
+	bool defined = true;
+	for (int c=0; c!=8; ++c) defined &= !undefined[node(i+(c>>2), j+((c>>1)&1), k+(c&1))];
+	GlobalPoint gp(theMin[0]+(i+0.5f)*theSpacing, theMin[1]+(j+0.5f)*theSpacing, theMin[2]+(k+0.5f)*theSpacing);
+	if (!defined || !theReference->isDefined(gp)) continue;
+	Vec4<float> d = interpolate(cell, centre) - theReference->inTesla(gp).basicVector().mathVector();
+	float error = std::sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+	if (error > tolerance) continue;
+	theDelegated[cell] = false;
+	theMaxError = std::max(theMaxError, error);
+      }
+}
+
+float GridSampledMagneticField::interpolatedFraction() const {
+  long cells = long(theN[0]-1)*(theN[1]-1)*(theN[2]-1);
+  long interpolated = 0;
+  for (int i=0; i+1<theN[0]; ++i)
+    for (int j=0; j+1<theN[1]; ++j)
+      for (int k=0; k+1<theN[2]; ++k) interpolated += !theDelegated[node(i,j,k)];
+  return cells>0 ? float(interpolated)/cells : 0.f;
+}
+
+bool GridSampledMagneticField::findCell(const GlobalPoint& gp, int& cell, float* f) const {
+  float u[3] = {gp.x(), gp.y(), gp.z()};
+  int index[3];
+  for (int a=0; a!=3; ++a) {
+    float t = (u[a]-theMin[a])*theInvSpacing;
+    if (!(t>=0.f && t<float(theN[a]-1))) return false;   // also false for nan
+    index[a] = int(t);
+    f[a] = t - index[a];
+  }
+  cell = node(index[0], index[1], index[2]);
+  return !theDelegated[cell];
+}
+
+Vec4<float> GridSampledMagneticField::interpolate(int cell, const float* f) const {
+  // the three components (and the padding) of the eight corners are combined with 4-wide operations
+  const int dk = 1, dj = theN[2], di = theN[1]*theN[2];
+  Vec4<float> const * b = &theField[cell];
+  Vec4<float> c00 = b[0]      + f[2]*(b[dk]      - b[0]);
+  Vec4<float> c01 = b[dj]     + f[2]*(b[dj+dk]    - b[dj]);
+  Vec4<float> c10 = b[di]     + f[2]*(b[di+dk]    - b[di]);
+  Vec4<float> c11 = b[di+dj]  + f[2]*(b[di+dj+dk] - b[di+dj]);
+  Vec4<float> c0 = c00 + f[1]*(c01-c00);
+  Vec4<float> c1 = c10 + f[1]*(c11-c10);
+  return c0 + f[0]*(c1-c0);
+}
+
+GlobalVector GridSampledMagneticField::inTesla(const GlobalPoint& gp) const {
+  int cell; float f[3];
+  if likely(findCell(gp, cell, f)) return GlobalVector(Basic3DVector<float>(interpolate(cell, f)));
+  return theReference->inTesla(gp);
+}
+
+GlobalVector GridSampledMagneticField::inTeslaUnchecked(const GlobalPoint& gp) const {
+  int cell; float f[3];
+  if likely(findCell(gp, cell, f)) return GlobalVector(Basic3DVector<float>(interpolate(cell, f)));
+  return theReference->inTeslaUnchecked(gp);
+}
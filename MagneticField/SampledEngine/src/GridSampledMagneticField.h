@@ -0,0 +1,64 @@
+#ifndef MagneticField_GridSampledMagneticField_h
+#define MagneticField_GridSampledMagneticField_h
+
+/** \class GridSampledMagneticField
+ *
+ *  A MagneticField engine that samples a reference field (usually the
+ *  volume-based map) on a regular cartesian grid at construction, and
+ *  returns the trilinear interpolation of the grid, so that a query needs
+ *  no volume lookup.
+ *  The interpolation of each cell is compared to the reference at the centre
+ *  of the cell; the cells where the difference exceeds the tolerance, or where
+ *  the reference is not defined, and the points outside the grid are
+ *  delegated to the reference field.
+ *  The reference field is not owned and must outlive this one.
+ */
+
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "DataFormats/Math/interface/ExtVec.h"
+
+#include <vector>
+
+class GridSampledMagneticField final : public MagneticField {
+ public:
+
+  /// Sample the reference in the box [min,max] with the given spacing [cm];
+  /// tolerance is the maximum difference to the reference in the interpolated cells [T]
+  GridSampledMagneticField(const MagneticField* reference,
+			   const GlobalPoint& min, const GlobalPoint& max,
+			   float spacing, float tolerance);
+
+  virtual ~GridSampledMagneticField() {}
+
+  GlobalVector inTesla (const GlobalPoint& gp) const override;
+
+  GlobalVector inTeslaUnchecked (const GlobalPoint& gp) const override;
+
+  bool isDefined(const GlobalPoint& gp) const override {return theReference->isDefined(gp);}
+
+  /// the largest difference to the reference found in the interpolated cells [T]
+  float maxError() const {return theMaxError;}
+
+  /// the fraction of the cells that are interpolated
+  float interpolatedFraction() const;
+
+ private:
+  // the index of the cell containing gp and the position in it, in units of the spacing;
+  // false if gp is outside the grid or the cell is delegated to the reference
+  bool findCell(const GlobalPoint& gp, int& cell, float* f) const;
+  Vec4<float> interpolate(int cell, const float* f) const;
+
+  int node(int i, int j, int k) const {return (i*theN[1] + j)*theN[2] + k;}
+
+  const MagneticField* theReference;
+  float theMin[3];
+  float theSpacing;
+  float theInvSpacing;
+  int   theN[3];                        // number of nodes along x, y and z
+
+  std::vector<Vec4<float> > theField;   // at the nodes
+  std::vector<bool> theDelegated;       // per cell, indexed as its lowest node
+  float theMaxError;
+};
+
+#endif
@@ -13,6 +13,9 @@
 
 #include <vector>
 #include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
 
 class MagBLayer;
 class MagESector;
@@ -45,6 +48,16 @@ public:
   /// Find a volume
   MagVolume const * findVolume(const GlobalPoint & gp, double tolerance=0.) const;
 
+  /// Hits and misses of the volume cache of findVolume()
+  struct CacheCounts {
+    unsigned long hits = 0;
+    unsigned long misses = 0;
+  };
+
+  /// The counts of the threads that used this geometry; the counts of a thread
+  /// are collected every few thousand lookups, so the last ones may be missing
+  std::map<std::thread::id, CacheCounts> cacheCounts() const;
+
   // Deprecated, will be removed
   bool isZSymmetric() const {return false;}
 
@@ -62,7 +75,13 @@ private:
 
   bool inBarrel(const GlobalPoint& gp) const;
 
-  mutable std::atomic<MagVolume const*> lastVolume; // Cache last volume found
+  // Hierarchical search, without the cache
+  MagVolume const* searchVolume(const GlobalPoint & gp, double tolerance) const;
+
+  // The last volumes found are cached per thread, tagged with the id of the geometry
+  unsigned int theId;
+  mutable std::mutex theCountsMutex;
+  mutable std::map<std::thread::id, CacheCounts> theCacheCounts;
 
   std::vector<MagBLayer const*> theBLayers;
   std::vector<MagESector const*> theESectors;
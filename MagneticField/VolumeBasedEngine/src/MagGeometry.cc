@@ -13,6 +13,7 @@
 #include "Utilities/BinningTools/interface/PeriodicBinFinderInPhi.h"
 
 #include "FWCore/Utilities/interface/isFinite.h"
+#include "FWCore/Utilities/interface/Likely.h"
 
 #include "MagneticField/Layers/interface/MagVerbosity.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
@@ -20,6 +21,23 @@
 using namespace std;
 using namespace edm;
 
+namespace {
+  // The volumes last found by a thread in one MagGeometry, most recent first.
+  // Each thread has its own, so that threads propagating different tracks do not
+  // evict each other's volume; the owner is the id of the geometry, as a new
+  // geometry could reuse the address of a deleted one.
+  struct VolumeCache {
+    static constexpr int size = 4;
+    static constexpr unsigned long flushEvery = 4096;
+    unsigned int owner = 0;
+    MagVolume const* volumes[size] = {};
+    MagGeometry::CacheCounts counts;
+  };
+  thread_local VolumeCache volumeCache;
+
+  std::atomic<unsigned int> nextGeometryId(1);
+}
+
 MagGeometry::MagGeometry(int geomVersion, const std::vector<MagBLayer *>& tbl,
 			 const std::vector<MagESector *>& tes,
 			 const std::vector<MagVolume6Faces*>& tbv,
@@ -31,7 +49,7 @@ MagGeometry::MagGeometry(int geomVersion, const std::vector<MagBLayer const*>& t
 			 const std::vector<MagESector const*>& tes,
 			 const std::vector<MagVolume6Faces const*>& tbv,
 			 const std::vector<MagVolume6Faces const*>& tev) : 
-  lastVolume(0), theBLayers(tbl), theESectors(tes), theBVolumes(tbv), theEVolumes(tev), cacheLastVolume(true), geometryVersion(geomVersion)
+  theId(nextGeometryId++), theBLayers(tbl), theESectors(tes), theBVolumes(tbv), theEVolumes(tev), cacheLastVolume(true), geometryVersion(geomVersion)
 {
   vector<double> rBorders;
 
@@ -59,6 +77,12 @@ MagGeometry::MagGeometry(int geomVersion, const std::vector<MagBLayer const*>& t
 }
 
 MagGeometry::~MagGeometry(){
+  for (auto const & c : cacheCounts()) {
+    unsigned long n = c.second.hits + c.second.misses;
+    LogInfo("MagGeometry") << "findVolume cache of thread " << c.first << ": " << n << " lookups, hit rate "
+			   << (n>0 ? double(c.second.hits)/n : 0.);
+  }
+
   delete theBarrelBinFinder;
   delete theEndcapBinFinder;
 
@@ -135,12 +159,53 @@ MagGeometry::findVolume1(const GlobalPoint & gp, double tolerance) const {
 // Use hierarchical structure for fast lookup.
 MagVolume const* 
 MagGeometry::findVolume(const GlobalPoint & gp, double tolerance) const{
-  // Check volume cache
-  auto lastVolumeCheck = lastVolume.load(std::memory_order_acquire);
-  if (lastVolumeCheck!=nullptr && lastVolumeCheck->inside(gp)){
-    return lastVolumeCheck;
+  if (!cacheLastVolume) return searchVolume(gp, tolerance);
+
+  VolumeCache & cache = volumeCache;
+  if (cache.owner != theId) {
+    // counts not yet collected for the previous geometry are lost
+    cache = VolumeCache();
+    cache.owner = theId;
   }
 
+  // Check volume cache, and move the volume found to the front
+  MagVolume const* result = nullptr;
+  for (int i=0; i!=VolumeCache::size && cache.volumes[i]!=nullptr; ++i) {
+    if (cache.volumes[i]->inside(gp)) {
+      result = cache.volumes[i];
+      for (int j=i; j>0; --j) cache.volumes[j] = cache.volumes[j-1];
+      break;
+    }
+  }
+
+  if (result!=nullptr) {
+    ++cache.counts.hits;
+  } else {
+    ++cache.counts.misses;
+    result = searchVolume(gp, tolerance);
+    if (result!=nullptr)
+      for (int j=VolumeCache::size-1; j>0; --j) cache.volumes[j] = cache.volumes[j-1];
+  }
+  if (result!=nullptr) cache.volumes[0] = result;
+
+  if unlikely(cache.counts.hits + cache.counts.misses == VolumeCache::flushEvery) {
+    std::lock_guard<std::mutex> guard(theCountsMutex);
+    CacheCounts & total = theCacheCounts[std::this_thread::get_id()];
+    total.hits += cache.counts.hits;
+    total.misses += cache.counts.misses;
+    cache.counts = CacheCounts();
+  }
+
+  return result;
+}
+
+std::map<std::thread::id, MagGeometry::CacheCounts> MagGeometry::cacheCounts() const {
+  std::lock_guard<std::mutex> guard(theCountsMutex);
+  return theCacheCounts;
+}
+
+MagVolume const* 
+MagGeometry::searchVolume(const GlobalPoint & gp, double tolerance) const{
   MagVolume const* result=0;
   if (inBarrel(gp)) { // Barrel
     double R = gp.perp();
@@ -172,11 +237,9 @@ MagGeometry::findVolume(const GlobalPoint & gp, double tolerance) const{
     // This is a hack for thin gaps on air-iron boundaries,
     // which will not be present anymore once surfaces are matched.
     if (verbose::debugOut) cout << "Increasing the tolerance to 0.03" <<endl;
-    result = findVolume(gp, 0.03);
+    result = searchVolume(gp, 0.03);
   }
 
-  if (cacheLastVolume) lastVolume.store(result,std::memory_order_release);
-
   return result;
 }
 
@@ -18,6 +18,8 @@ namespace perftools {
    *  all its baskets
    *  Estimate the "size in memory" multipling the actual branch size 
    *  by its compression factor
+   *  Optionally measure the time to read each branch (I/O, decompression
+   *  and streaming) by reading it alone for the first events
    *
    *  \author Vincenzo Innocente
    */
@@ -36,15 +38,20 @@ namespace perftools {
     struct BranchRecord {
       BranchRecord() : 
 	compr_size(0.),  
-	uncompr_size(0.) {}
+	uncompr_size(0.),
+	n_baskets(0),
+	read_time(0.) {}
       BranchRecord(std::string const & iname,
-		   double compr,  double uncompr) : 
+		   double compr,  double uncompr, int nbaskets) : 
 	fullName(iname), name(iname), 
-	compr_size(compr), uncompr_size(uncompr){}
+	compr_size(compr), uncompr_size(uncompr),
+	n_baskets(nbaskets), read_time(0.) {}
       std::string fullName;
       std::string name;
       double compr_size;
       double uncompr_size;
+      int n_baskets;   // including the ones of the sub-branches
+      double read_time; // seconds/event, 0 if not measured
     };
 
     typedef std::vector<BranchRecord> Branches;
@@ -57,8 +64,17 @@ namespace perftools {
     /// read file, compute branch size, sort by size
     void parseFile(std::string const & fileName, std::string const & treeName="Events");
 
+    /// read each branch alone for the first maxEvents events (all if negative) and record the time per event
+    void measureReadTime(int maxEvents=-1);
+
+    /// sort by compressed size
+    void sortSize();
+
     /// sort by name
     void sortAlpha();
+
+    /// sort by read time
+    void sortReadTime();
     
     /// transform Branch names in "formatted" prodcut identifiers
     void formatNames();
@@ -71,7 +87,9 @@ namespace perftools {
 
   private:
     std::string m_fileName;
+    std::string m_treeName;
     int m_nEvents;
+    int m_nTimedEvents;
     Branches m_branches;
 
   };
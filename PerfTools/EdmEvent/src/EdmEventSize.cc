@@ -24,6 +24,7 @@
 // #include "FWCore/FWLite/src/AutoLibraryLoader.h"
 
 #include "TBufferFile.h"
+#include "TStopwatch.h"
 
 namespace {
 
@@ -58,6 +59,14 @@ namespace {
   }
 
 
+  int getBasketCount( TBranch * b) {
+    int n = b->GetWriteBasket();
+    TObjArray * branches = b->GetListOfBranches();
+    for( int i = 0; i < branches->GetEntries(); ++ i )
+      n += getBasketCount( dynamic_cast<TBranch*>( branches->At( i ) ) );
+    return n;
+  }
+
   size_type getTotalSize( TBranch * br) {
     TBufferFile buf( TBuffer::kWrite, 10000 );
     TBranch::Class()->WriteBuffer( buf, br );
@@ -71,15 +80,17 @@ namespace {
 namespace perftools {
 
   EdmEventSize::EdmEventSize() : 
-    m_nEvents(0) {}
+    m_nEvents(0), m_nTimedEvents(0) {}
   
   EdmEventSize::EdmEventSize(std::string const & fileName, std::string const & treeName ) : 
-    m_nEvents(0) {
+    m_nEvents(0), m_nTimedEvents(0) {
     parseFile(fileName);
   }
   
   void EdmEventSize::parseFile(std::string const & fileName, std::string const & treeName) {
     m_fileName = fileName;
+    m_treeName = treeName;
+    m_nTimedEvents = 0;
     m_branches.clear();
 
     TFile * file = TFile::Open( fileName.c_str() );
@@ -111,16 +122,55 @@ namespace perftools {
       std::string const name( b->GetName() );
       if ( name == "EventAux" ) continue;
       size_type s = getTotalSize(b);
-      m_branches.push_back( BranchRecord(name, double(s[kCompressed])/double(m_nEvents), double(s[kUncompressed])/double(m_nEvents)) );
+      m_branches.push_back( BranchRecord(name, double(s[kCompressed])/double(m_nEvents), double(s[kUncompressed])/double(m_nEvents), getBasketCount(b)) );
     }
+    sortSize();
+
+  }
+  
+  void EdmEventSize::measureReadTime(int maxEvents) {
+    TFile * file = TFile::Open( m_fileName.c_str() );
+    if( file==0  || ( !(*file).IsOpen() ) )
+      throw Error( "unable to open data file " + m_fileName, 7002);
+    TTree * events = dynamic_cast<TTree*> (file->Get(m_treeName.c_str()));
+    if ( events == 0 )
+      throw Error("object \"" + m_treeName + "\" is not a TTree in file: " + m_fileName, 7004);
+
+    m_nTimedEvents = ( maxEvents < 0 || maxEvents > m_nEvents ) ? m_nEvents : maxEvents;
+    // no cache, so that each branch pays for its own reads
+    events->SetCacheSize(0);
+    TStopwatch watch;
+    for( Branches::iterator br = m_branches.begin(); br != m_branches.end(); ++br ) {
+      TBranch * b = events->GetBranch( br->fullName.c_str() );
+      if ( b == 0 || m_nTimedEvents == 0 ) continue;
+      watch.Start();
+      for( Long64_t i = 0; i < m_nTimedEvents; ++i ) b->GetEntry(i);
+      watch.Stop();
+      br->read_time = watch.RealTime()/m_nTimedEvents;
+      // release the baskets and the object read
+      b->DropBaskets("all");
+      b->ResetAddress();
+    }
+    file->Close();
+    delete file;
+  }
+
+  void EdmEventSize::sortSize() {
     std::sort(m_branches.begin(),m_branches.end(), 
 	      boost::bind(std::greater<double>(),
 			  boost::bind(&BranchRecord::compr_size,_1),
 			  boost::bind(&BranchRecord::compr_size,_2))
 	      );
+  }
 
+  void EdmEventSize::sortReadTime() {
+    std::sort(m_branches.begin(),m_branches.end(), 
+	      boost::bind(std::greater<double>(),
+			  boost::bind(&BranchRecord::read_time,_1),
+			  boost::bind(&BranchRecord::read_time,_2))
+	      );
   }
-  
+
   void EdmEventSize::sortAlpha() {
     std::sort(m_branches.begin(),m_branches.end(), 
 	      boost::bind(std::less<std::string>(),
@@ -161,10 +211,25 @@ namespace perftools {
     void dump(std::ostream& co, EdmEventSize::BranchRecord const & br) {
       co << br.name << " " <<  br.uncompr_size <<  " " << br.compr_size << "\n"; 
     }
+
+    void dumpReadTime(std::ostream& co, EdmEventSize::BranchRecord const & br) {
+      co << br.name << " " <<  br.uncompr_size <<  " " << br.compr_size << " " << br.n_baskets
+	 << " " << 1.e6*br.read_time << " " << (br.compr_size > 0 ? 1.e9*br.read_time/br.compr_size : 0.) << "\n"; 
+    }
   }
 
   
   void EdmEventSize::dump(std::ostream & co, bool header) const {
+    if ( m_nTimedEvents > 0 ) {
+      if (header) {
+	co << "File " << m_fileName << " Events " << m_nEvents << " Timed Events " << m_nTimedEvents << "\n";
+	co <<"Branch Name | Average Uncompressed Size (Bytes/Event) | Average Compressed Size (Bytes/Event) | Baskets"
+	   << " | Read Time (us/Event) | Read Time per Compressed Byte (ns) \n";
+      }
+      std::for_each(m_branches.begin(),m_branches.end(),
+		    boost::bind(detail::dumpReadTime,boost::ref(co),_1));
+      return;
+    }
     if (header) {
       co << "File " << m_fileName << " Events " << m_nEvents << "\n";
       co <<"Branch Name | Average Uncompressed Size (Bytes/Event) | Average Compressed Size (Bytes/Event) \n";
@@ -49,11 +49,17 @@ class ProcMLP : public VarProcessor {
 		Layer(const Calibration::ProcMLP::Layer &calib);
 		Layer(const Layer &orig) :
 			inputs(orig.inputs), neurons(orig.neurons),
-			coeffs(orig.coeffs), sigmoid(orig.sigmoid) {}
+			coeffs(orig.coeffs), bias(orig.bias),
+			weights(orig.weights), sigmoid(orig.sigmoid) {}
 
 		unsigned int		inputs;
 		unsigned int		neurons;
 		std::vector<double>	coeffs;
+		// the same as coeffs, but the biases and then the weights
+		// of the inputs in turn to all the neurons, so that eval()
+		// loops over the neurons in the inner loop
+		std::vector<double>	bias;
+		std::vector<double>	weights;
 		bool			sigmoid;
 	};
 
@@ -85,6 +91,15 @@ ProcMLP::Layer::Layer(const Calibration::ProcMLP::Layer &calib) :
 		inserter = std::copy(iter->second.begin(), iter->second.end(),
 		                     inserter);
 	}
+
+	bias.resize(neurons);
+	weights.resize(neurons * inputs);
+	for(unsigned int i = 0; i < neurons; i++) {
+		bias[i] = coeffs[i * (inputs + 1)];
+		for(unsigned int j = 0; j < inputs; j++)
+			weights[j * neurons + i] =
+					coeffs[i * (inputs + 1) + 1 + j];
+	}
 }
 
 ProcMLP::ProcMLP(const char *name,
@@ -130,16 +145,21 @@ void ProcMLP::eval(ValueIterator iter, unsigned int n) const
 	    layer != layers.end(); layer++, flip = !flip) {
 		const double *input = &tmp[flip ? maxTmp : 0];
 		output = &tmp[flip ? 0 : maxTmp];
-		std::vector<double>::const_iterator coeff =
-							layer->coeffs.begin();
-		for(unsigned int i = 0; i < layer->neurons; i++) {
-			double sum = *coeff++;
-			for(unsigned int j = 0; j < layer->inputs; j++)
-				sum += input[j] * *coeff++;
-			if (layer->sigmoid)
-				sum = 1.0 / (std::exp(-sum) + 1.0);
-			*output++ = sum;
+		const unsigned int neurons = layer->neurons;
+		// the sum of each neuron is done in the same order as
+		// bias + input[0] * w[0] + input[1] * w[1] + ...
+		std::copy(layer->bias.begin(), layer->bias.end(), output);
+		const double *weight = layer->weights.data();
+		for(unsigned int j = 0; j < layer->inputs;
+		    j++, weight += neurons) {
+			const double x = input[j];
+			for(unsigned int i = 0; i < neurons; i++)
+				output[i] += x * weight[i];
 		}
+		if (layer->sigmoid)
+			for(unsigned int i = 0; i < neurons; i++)
+				output[i] = 1.0 / (std::exp(-output[i]) + 1.0);
+		output += neurons;
 	}
 
 	for(const double *pos = &tmp[flip ? maxTmp : 0]; pos < output; pos++)
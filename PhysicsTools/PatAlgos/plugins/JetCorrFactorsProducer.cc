@@ -147,6 +147,11 @@ JetCorrFactorsProducer::params(const JetCorrectorParametersCollection& parameter
 float
 JetCorrFactorsProducer::evaluate(edm::View<reco::Jet>::const_iterator& jet, const JetCorrFactors::Flavor& flavor, int level)
 {
+  // the sub-corrections of all levels are computed once per jet and flavor
+  std::map<JetCorrFactors::Flavor, std::vector<float> >::const_iterator cached = subCorrections_.find(flavor);
+  if( cached!=subCorrections_.end() ){
+    return cached->second[level];
+  }
   std::shared_ptr<FactorizedJetCorrector>& corrector = correctors_.find(flavor)->second;
   // add parameters for JPT corrections
   const reco::JPTJet* jpt = dynamic_cast<reco::JPTJet const *>( &*jet );
@@ -162,7 +167,9 @@ JetCorrFactorsProducer::evaluate(edm::View<reco::Jet>::const_iterator& jet, cons
   if( emf_ && dynamic_cast<const reco::CaloJet*>(&*jet)){
     corrector->setJetEMF(dynamic_cast<const reco::CaloJet*>(&*jet)->emEnergyFraction());
   }
-  return corrector->getSubCorrections()[level];
+  std::vector<float>& subCorrections = subCorrections_[flavor];
+  subCorrections = corrector->getSubCorrections();
+  return subCorrections[level];
 }
 
 std::string
@@ -205,6 +212,7 @@ JetCorrFactorsProducer::produce(edm::Event& event, const edm::EventSetup& setup)
   // fill the jetCorrFactors
   std::vector<JetCorrFactors> jcfs;
   for(edm::View<reco::Jet>::const_iterator jet = jets->begin(); jet!=jets->end(); ++jet){
+    subCorrections_.clear();
     // the JetCorrFactors::CorrectionFactor is a std::pair<std::string, std::vector<float> >
     // the string corresponds to the label of the correction level, the vector contains four
     // floats if flavor dependent and one float else. Per construction jet energy corrections
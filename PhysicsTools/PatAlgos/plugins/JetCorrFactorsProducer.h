@@ -129,6 +129,8 @@ namespace pat {
     std::map<JetCorrFactors::Flavor, std::shared_ptr<FactorizedJetCorrector> > correctors_;
     /// cache container for JPTOffset jet corrections
     std::shared_ptr<FactorizedJetCorrector> extraJPTOffsetCorrector_;
+    /// sub-corrections of the current jet for the flavors evaluated so far
+    std::map<JetCorrFactors::Flavor, std::vector<float> > subCorrections_;
   };
 
   inline int
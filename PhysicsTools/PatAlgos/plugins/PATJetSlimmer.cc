@@ -20,6 +20,9 @@
 
 #include "DataFormats/PatCandidates/interface/Jet.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace pat {
 
   class PATJetSlimmer : public edm::EDProducer {
@@ -88,15 +91,19 @@ pat::PATJetSlimmer::produce(edm::Event & iEvent, const edm::EventSetup & iSetup)
 		    //copy old 
 		    reco::CompositePtrCandidate::daughters old = jet.daughterPtrVector();
 		    jet.clearDaughters();
-		    std::map<unsigned int,reco::CandidatePtr> ptrs;	    
+		    std::vector<reco::CandidatePtr> ptrs;
+		    ptrs.reserve(old.size());
 		    for(unsigned int  i=0;i<old.size();i++)
 		    {
 			    //	jet.addDaughter(refToPtr((*pf2pc)[old[i]]));
-			    ptrs[((*pf2pc)[old[i]]).key()]=refToPtr((*pf2pc)[old[i]]);
+			    ptrs.push_back(refToPtr((*pf2pc)[old[i]]));
 		    }
-		    for(std::map<unsigned int,reco::CandidatePtr>::iterator itp=ptrs.begin();itp!=ptrs.end();itp++) //iterate on sorted items
+		    // add them sorted by key, once each (the last one, as the std::map used before)
+		    std::stable_sort(ptrs.begin(),ptrs.end(),[](const reco::CandidatePtr &a, const reco::CandidatePtr &b){ return a.key() < b.key(); });
+		    for(unsigned int i=0;i<ptrs.size();i++)
 		    {
-			    jet.addDaughter(itp->second);
+			    if (i+1<ptrs.size() && ptrs[i+1].key()==ptrs[i].key()) continue;
+			    jet.addDaughter(ptrs[i]);
 		    }
 
 
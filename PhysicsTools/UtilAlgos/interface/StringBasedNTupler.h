@@ -32,6 +32,7 @@
 
 //#define StringBasedNTuplerPrecision float;
 
+#include <map>
 #include <memory>
 #include <string>
 #include <sstream>
@@ -89,6 +90,15 @@ class TreeBranch {
 };
 
 
+// the parsed expressions and selections, by string, so that they are parsed once per thread instead of for each event
+template <typename Function>
+Function & cachedStringFunction(const std::string & expr) {
+  thread_local static std::map<std::string, std::shared_ptr<Function> > cache;
+  std::shared_ptr<Function> & f = cache[expr];
+  if (!f) f.reset(new Function(expr));
+  return *f;
+}
+
 template <typename Object>
 class StringLeaveHelper {
  public:
@@ -108,7 +118,7 @@ class StringLeaveHelper {
       }
       else{
 	//parser for the object expression
-	StringObjectFunction<Object> expr(B.expr());
+	StringObjectFunction<Object> & expr = cachedStringFunction<StringObjectFunction<Object> >(B.expr());
 	//allocate enough memory for the data holder
 	value_.reset(new std::vector<float>(1));
 	try{
@@ -147,7 +157,7 @@ public:
       }
       else{
 	//parser for the object expression
-	StringObjectFunction<Object> expr(B.expr());
+	StringObjectFunction<Object> & expr = cachedStringFunction<StringObjectFunction<Object> >(B.expr());
 	//allocate enough memory for the data holder
         value_.reset(new std::vector<float>());
         value_->reserve(oH->size());
@@ -155,13 +165,13 @@ public:
 	StringCutObjectSelector<Object> * selection=0;
 	if (B.selection()!=""){
 	  //std::cout<<"trying to get to a selection"<<std::endl;
-	  selection = new StringCutObjectSelector<Object>(B.selection());
+	  selection = &cachedStringFunction<StringCutObjectSelector<Object> >(B.selection());
 	  //std::cout<<"got the objet"<<std::endl;
 	}
 	uint i_end=oH->size();
 	//sort things first if requested
 	if (B.order()!=""){
-	  StringObjectFunction<Object> order(B.order());
+	  StringObjectFunction<Object> & order = cachedStringFunction<StringObjectFunction<Object> >(B.order());
 	  // allocate a vector of pointers (we are using view) to be sorted
 	  std::vector<const Object*> copyToSort(oH->size());
 	  for (uint i=0;i!=i_end;++i)  copyToSort[i]= &(*oH)[i];
@@ -191,7 +201,6 @@ public:
 	    }
 	  }
 	}
-	if (selection) delete selection;
       }
     }
  private:
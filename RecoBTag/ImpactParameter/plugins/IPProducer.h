@@ -165,6 +165,7 @@ class IPProducer : public edm::stream::EDProducer<> {
     bool  m_directionWithTracks;
     bool  m_directionWithGhostTrack;
     bool  m_useTrackQuality;
+    double  m_minJetPt;
     Helper m_helper;
 };
 
@@ -213,6 +214,7 @@ template <class Container, class Base, class Helper> IPProducer<Container,Base,H
   m_directionWithTracks     = m_config.getParameter<bool>("jetDirectionUsingTracks");
   m_directionWithGhostTrack = m_config.getParameter<bool>("jetDirectionUsingGhostTrack");
   m_useTrackQuality         = m_config.getParameter<bool>("useTrackQuality");
+  m_minJetPt                = m_config.existsAs<double>("minimumJetPt") ? m_config.getParameter<double>("minimumJetPt") : 0.;
 
   if (m_computeGhostTrack)
     produces<reco::TrackCollection>("ghostTracks");
@@ -271,9 +273,19 @@ IPProducer<Container,Base,Helper>::produce(edm::Event& iEvent, const edm::EventS
 
    std::vector<Base> baseTagInfos = m_helper.makeBaseVector(iEvent);
    for(typename std::vector<Base>::const_iterator it = baseTagInfos.begin();  it != baseTagInfos.end(); it++) {
-     Container tracks = m_helper.tracks(*it);
      math::XYZVector jetMomentum = it->jet()->momentum();
 
+     // the jets below the pt threshold get a tag info without tracks
+     if (m_minJetPt > 0 && it->jet()->pt() < m_minJetPt) {
+       result->push_back(typename Product::value_type(std::vector<reco::btag::TrackIPData>(), std::vector<float>(), std::vector<float>(),
+                                                      Container(), *it, pvRef,
+                                                      GlobalVector(jetMomentum.x(), jetMomentum.y(), jetMomentum.z()),
+                                                      reco::TrackRef()));
+       continue;
+     }
+
+     Container tracks = m_helper.tracks(*it);
+
      if (m_directionWithTracks) {
        jetMomentum *= 0.5;
        for(typename Container::const_iterator itTrack = tracks.begin();
@@ -287,8 +299,8 @@ IPProducer<Container,Base,Helper>::produce(edm::Event& iEvent, const edm::EventS
 
      for(typename Container::const_iterator itTrack = tracks.begin();
          itTrack != tracks.end(); ++itTrack) {
-       reco::TransientTrack transientTrack = builder->build(*itTrack);
-       const reco::Track & track = transientTrack.track(); //**itTrack;
+       // the transient track is only built for the selected tracks
+       const reco::Track & track = *reco::btag::toTrack(*itTrack);
  /*    cout << " pt " <<  track.pt() <<
                " d0 " <<  fabs(track.d0()) <<
                " #hit " <<    track.hitPattern().numberOfValidHits()<<
@@ -304,7 +316,7 @@ IPProducer<Container,Base,Helper>::produce(edm::Event& iEvent, const edm::EventS
            std::abs(track.dz(pv->position())) < m_cutMaxLIP) {
 //	 std::cout << "selected" << std::endl; 	
          selectedTracks.push_back(*itTrack);
-         transientTracks.push_back(transientTrack);
+         transientTracks.push_back(builder->build(*itTrack));
        }
      }
 //	std::cout <<"SIZE: " << transientTracks.size() << std::endl;
@@ -477,6 +489,7 @@ void IPProducer<reco::TrackRefVector, reco::JTATagInfo, IPProducerHelpers::FromJ
   desc.add<bool>("computeProbabilities",true);
   desc.add<bool>("useTrackQuality",false);
   desc.add<double>("maximumChiSquared",5.0);
+  desc.addOptional<double>("minimumJetPt",0.);
   descriptions.addDefault(desc);
 }
 
@@ -501,6 +514,7 @@ void IPProducer<std::vector<reco::CandidatePtr>,reco::JetTagInfo,  IPProducerHel
   desc.add<double>("ghostTrackPriorDeltaR",0.03);
   desc.add<double>("maximumChiSquared",5.0);
   desc.addOptional<bool>("explicitJTA",false);
+  desc.addOptional<double>("minimumJetPt",0.);
   descriptions.addDefault(desc);
 }
 
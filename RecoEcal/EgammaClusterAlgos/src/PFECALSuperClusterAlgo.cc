@@ -130,6 +130,7 @@ namespace {
     PFECALSuperClusterAlgo::clustering_type _type;
     bool dynamic_dphi;
     double etawidthSuperCluster_ = .0 , phiwidthSuperCluster_ = .0;
+    static constexpr double maxDynamicDPhi = 0.6 + 1.e-3;
     IsClustered(const CalibClusterPtr s, 
 		PFECALSuperClusterAlgo::clustering_type ct,
 		const bool dyn_dphi) : 
@@ -137,6 +138,10 @@ namespace {
     bool operator()(const CalibClusterPtr& x) { 
       const double dphi = 
 	std::abs(TVector2::Phi_mpi_pi(the_seed->phi() - x->phi()));        
+      // the dynamic window is never wider than its largest cutoff, 0.6:
+      // skip the window (and mustache) evaluation for the clusters far
+      // away in phi, with a margin for the float arguments of the kernels
+      if( dynamic_dphi && dphi > maxDynamicDPhi ) return false;
       const bool passes_dphi = 
 	( (!dynamic_dphi && dphi < phiwidthSuperCluster_ ) || 
 	  (dynamic_dphi && MK::inDynamicDPhiWindow(the_seed->eta(),
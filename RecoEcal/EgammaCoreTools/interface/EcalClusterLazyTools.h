@@ -26,6 +26,8 @@
 #include "RecoLocalCalo/EcalRecAlgos/interface/EcalSeverityLevelAlgo.h"
 #include "RecoEcal/EgammaCoreTools/interface/EcalClusterTools.h"
 
+#include <unordered_map>
+
 
 class CaloTopology;
 class CaloGeometry;
@@ -196,9 +198,44 @@ class EcalClusterLazyToolsT : public EcalClusterLazyToolsBase {
         // get the energy deposited in a matrix centered in the maximum energy crystal = (0,0)
         // the size is specified by ixMin, ixMax, iyMin, iyMax in unit of crystals
         float matrixEnergy( const reco::BasicCluster &cluster, DetId id, int ixMin, int ixMax, int iyMin, int iyMax );
+
+    private:
+        // shapes already computed for a cluster, as the producers ask for
+        // the same ones several times (e.g. directly and through the IDs);
+        // a cluster is known by its seed and its crystals and fractions;
+        // the entries are keyed on the raw id of the seed
+        struct ShapeCache {
+          std::vector<std::pair<DetId, float> > hitsAndFractions;
+          bool hasE3x3, hasE5x5;
+          float e3x3, e5x5;
+          float covW0, localCovW0;   // of the covariances, if not empty
+          std::vector<float> cov, localCov;
+        };
+        ShapeCache & shapeCache( const reco::BasicCluster &cluster );
+
+        // the cache is emptied when it holds this many clusters
+        static const size_t maxShapeCacheSize_ = 1024;
+        std::unordered_multimap<uint32_t, ShapeCache> shapeCache_;
   
 }; // class EcalClusterLazyToolsT
 
+template<class EcalClusterToolsImpl>
+typename EcalClusterLazyToolsT<EcalClusterToolsImpl>::ShapeCache & EcalClusterLazyToolsT<EcalClusterToolsImpl>::shapeCache( const reco::BasicCluster &cluster )
+{
+        const uint32_t seed = cluster.seed().rawId();
+        auto range = shapeCache_.equal_range( seed );
+        for ( auto it = range.first; it != range.second; ++it ) {
+                if ( it->second.hitsAndFractions == cluster.hitsAndFractions() ) return it->second;
+        }
+        if ( shapeCache_.size() >= maxShapeCacheSize_ ) shapeCache_.clear();
+        ShapeCache & cache = shapeCache_.emplace( seed, ShapeCache() )->second;
+        cache.hitsAndFractions = cluster.hitsAndFractions();
+        cache.hasE3x3 = cache.hasE5x5 = false;
+        cache.e3x3 = cache.e5x5 = 0.f;
+        cache.covW0 = cache.localCovW0 = 0.f;
+        return cache;
+}
+
 template<class EcalClusterToolsImpl>
 float EcalClusterLazyToolsT<EcalClusterToolsImpl>::e1x3( const reco::BasicCluster &cluster )
 {
@@ -240,7 +277,12 @@ float EcalClusterLazyToolsT<EcalClusterToolsImpl>::e3x2( const reco::BasicCluste
 template<class EcalClusterToolsImpl>
 float EcalClusterLazyToolsT<EcalClusterToolsImpl>::e3x3( const reco::BasicCluster &cluster )
 {
-        return EcalClusterToolsImpl::e3x3( cluster, getEcalRecHitCollection(cluster), topology_ );
+        ShapeCache & cache = shapeCache( cluster );
+        if ( !cache.hasE3x3 ) {
+                cache.e3x3 = EcalClusterToolsImpl::e3x3( cluster, getEcalRecHitCollection(cluster), topology_ );
+                cache.hasE3x3 = true;
+        }
+        return cache.e3x3;
 }
 
 template<class EcalClusterToolsImpl>
@@ -252,7 +294,12 @@ float EcalClusterLazyToolsT<EcalClusterToolsImpl>::e4x4( const reco::BasicCluste
 template<class EcalClusterToolsImpl>
 float EcalClusterLazyToolsT<EcalClusterToolsImpl>::e5x5( const reco::BasicCluster &cluster )
 {
-        return EcalClusterToolsImpl::e5x5( cluster, getEcalRecHitCollection(cluster), topology_ );
+        ShapeCache & cache = shapeCache( cluster );
+        if ( !cache.hasE5x5 ) {
+                cache.e5x5 = EcalClusterToolsImpl::e5x5( cluster, getEcalRecHitCollection(cluster), topology_ );
+                cache.hasE5x5 = true;
+        }
+        return cache.e5x5;
 }
 
 template<class EcalClusterToolsImpl>
@@ -354,13 +401,23 @@ std::vector<float> EcalClusterLazyToolsT<EcalClusterToolsImpl>::lat( const reco:
 template<class EcalClusterToolsImpl>
 std::vector<float> EcalClusterLazyToolsT<EcalClusterToolsImpl>::covariances(const reco::BasicCluster &cluster, float w0 )
 {
-        return EcalClusterToolsImpl::covariances( cluster, getEcalRecHitCollection(cluster), topology_, geometry_, w0 );
+        ShapeCache & cache = shapeCache( cluster );
+        if ( cache.cov.empty() || cache.covW0 != w0 ) {
+                cache.cov = EcalClusterToolsImpl::covariances( cluster, getEcalRecHitCollection(cluster), topology_, geometry_, w0 );
+                cache.covW0 = w0;
+        }
+        return cache.cov;
 }
 
 template<class EcalClusterToolsImpl>
 std::vector<float> EcalClusterLazyToolsT<EcalClusterToolsImpl>::localCovariances(const reco::BasicCluster &cluster, float w0 )
 {
-        return EcalClusterToolsImpl::localCovariances( cluster, getEcalRecHitCollection(cluster), topology_, w0 );
+        ShapeCache & cache = shapeCache( cluster );
+        if ( cache.localCov.empty() || cache.localCovW0 != w0 ) {
+                cache.localCov = EcalClusterToolsImpl::localCovariances( cluster, getEcalRecHitCollection(cluster), topology_, w0 );
+                cache.localCovW0 = w0;
+        }
+        return cache.localCov;
 }
 
 template<class EcalClusterToolsImpl>
@@ -238,7 +238,11 @@ class PixelHitMatcher
     bool useRecoVertex_ ;
     std::unordered_map<const GeomDet*, TrajectoryStateOnSurface> mapTsos_fast_;
     std::unordered_map<std::pair<const GeomDet*,GlobalPoint>, TrajectoryStateOnSurface> mapTsos2_fast_;    
-    std::vector<GlobalPoint> hit_gp_map_;    
+    // global positions of the hits of the seeds, computed once per event for
+    // all the clusters: those of seed i start at seedHitBegin_[i]
+    const TrajectorySeedCollection * seedHitPositionsOf_ ;
+    std::vector<unsigned int> seedHitBegin_ ;
+    std::vector<GlobalPoint> seedHitPositions_ ;
 } ;
 
 #endif
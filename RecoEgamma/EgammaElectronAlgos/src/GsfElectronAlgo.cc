@@ -212,12 +212,14 @@ struct GsfElectronAlgo::EventData
 
   // isolation helpers
   ElectronTkIsolation * tkIsolation03, * tkIsolation04 ;
+  EgammaTrackEtaIndex ctfTrackIndex ; // shared by the two cones
   EgammaTowerIsolation * hadDepth1Isolation03, * hadDepth1Isolation04 ;
   EgammaTowerIsolation * hadDepth2Isolation03, * hadDepth2Isolation04 ;
   EgammaTowerIsolation * hadDepth1Isolation03Bc, * hadDepth1Isolation04Bc ;
   EgammaTowerIsolation * hadDepth2Isolation03Bc, * hadDepth2Isolation04Bc ;
   EgammaRecHitIsolation * ecalBarrelIsol03, * ecalBarrelIsol04 ;
   EgammaRecHitIsolation * ecalEndcapIsol03, * ecalEndcapIsol04 ;
+  EcalRecHitDenseIndex barrelRecHitIndex, endcapRecHitIndex ; // shared by the two cones
 
   //Isolation Value Maps for PF and EcalDriven electrons
   typedef std::vector< edm::Handle< edm::ValueMap<double> > > IsolationValueMaps;
@@ -780,6 +782,9 @@ void GsfElectronAlgo::beginEvent( edm::Event & event )
   float ptMin=generalData_->isoCfg.ptMinTk, maxVtxDist=generalData_->isoCfg.maxVtxDistTk, drb=generalData_->isoCfg.maxDrbTk;
   eventData_->tkIsolation03 = new ElectronTkIsolation(extRadiusSmall,intRadiusBarrel,intRadiusEndcap,stripBarrel,stripEndcap,ptMin,maxVtxDist,drb,eventData_->currentCtfTracks.product(),eventData_->beamspot->position()) ;
   eventData_->tkIsolation04 = new ElectronTkIsolation(extRadiusLarge,intRadiusBarrel,intRadiusEndcap,stripBarrel,stripEndcap,ptMin,maxVtxDist,drb,eventData_->currentCtfTracks.product(),eventData_->beamspot->position()) ;
+  eventData_->ctfTrackIndex.reset(*(eventData_->currentCtfTracks));
+  eventData_->tkIsolation03->setTrackIndex(&eventData_->ctfTrackIndex);
+  eventData_->tkIsolation04->setTrackIndex(&eventData_->ctfTrackIndex);
 
   float egHcalIsoConeSizeOutSmall=0.3, egHcalIsoConeSizeOutLarge=0.4;
   float egHcalIsoConeSizeIn=generalData_->isoCfg.intRadiusHcal,egHcalIsoPtMin=generalData_->isoCfg.etMinHcal;
@@ -800,6 +805,12 @@ void GsfElectronAlgo::beginEvent( edm::Event & event )
   eventData_->ecalBarrelIsol04 = new EgammaRecHitIsolation(egIsoConeSizeOutLarge,egIsoConeSizeInBarrel,egIsoJurassicWidth,egIsoPtMinBarrel,egIsoEMinBarrel,eventSetupData_->caloGeom,*(eventData_->barrelRecHits),eventSetupData_->sevLevel.product(),DetId::Ecal);
   eventData_->ecalEndcapIsol03 = new EgammaRecHitIsolation(egIsoConeSizeOutSmall,egIsoConeSizeInEndcap,egIsoJurassicWidth,egIsoPtMinEndcap,egIsoEMinEndcap,eventSetupData_->caloGeom,*(eventData_->endcapRecHits),eventSetupData_->sevLevel.product(),DetId::Ecal);
   eventData_->ecalEndcapIsol04 = new EgammaRecHitIsolation(egIsoConeSizeOutLarge,egIsoConeSizeInEndcap,egIsoJurassicWidth,egIsoPtMinEndcap,egIsoEMinEndcap,eventSetupData_->caloGeom,*(eventData_->endcapRecHits),eventSetupData_->sevLevel.product(),DetId::Ecal);
+  eventData_->barrelRecHitIndex.reset(*(eventData_->barrelRecHits));
+  eventData_->endcapRecHitIndex.reset(*(eventData_->endcapRecHits));
+  eventData_->ecalBarrelIsol03->setRecHitIndex(&eventData_->barrelRecHitIndex);
+  eventData_->ecalBarrelIsol04->setRecHitIndex(&eventData_->barrelRecHitIndex);
+  eventData_->ecalEndcapIsol03->setRecHitIndex(&eventData_->endcapRecHitIndex);
+  eventData_->ecalEndcapIsol04->setRecHitIndex(&eventData_->endcapRecHitIndex);
   eventData_->ecalBarrelIsol03->setUseNumCrystals(generalData_->isoCfg.useNumCrystals);
   eventData_->ecalBarrelIsol03->setVetoClustered(generalData_->isoCfg.vetoClustered);
   eventData_->ecalBarrelIsol03->doSeverityChecks(eventData_->barrelRecHits.product(),generalData_->recHitsCfg.recHitSeverityToBeExcludedBarrel);
@@ -26,7 +26,7 @@ PixelHitMatcher::PixelHitMatcher
    meas1stFLayer(phi1min,phi1max,0.,0.), meas2ndFLayer(phi2minF,phi2maxF,r2minF,r2maxF),
    startLayers(),
    prop1stLayer(0), prop2ndLayer(0),theGeometricSearchTracker(0),theTrackerEvent(0),theTracker(0),vertex_(0.),
-   searchInTIDTEC_(searchInTIDTEC), useRecoVertex_(false)
+   searchInTIDTEC_(searchInTIDTEC), useRecoVertex_(false), seedHitPositionsOf_(0)
  {
   meas1stFLayer.setRRangeI(rMinI,rMaxI) ;
   meas2ndFLayer.setRRangeI(rMinI,rMaxI) ;
@@ -63,6 +63,7 @@ void PixelHitMatcher::setEvent( const MeasurementTrackerEvent & trackerData )
  {
     theTrackerEvent = & trackerData;
     theLayerMeasurements = LayerMeasurements(*theTracker,*theTrackerEvent);
+    seedHitPositionsOf_ = 0 ;
  }
 void PixelHitMatcher::setES
  ( const MagneticField * magField,
@@ -118,24 +119,38 @@ PixelHitMatcher::compatibleSeeds
   mapTsos_fast_.reserve(seeds->size()) ;
   mapTsos2_fast_.reserve(seeds->size()) ;
 
-  for(const auto& seed : *seeds) {
-    hit_gp_map_.clear();
+  // cache the global points of the hits, the same for all the clusters
+  if( seeds != seedHitPositionsOf_ ) {
+    seedHitBegin_.clear();
+    seedHitPositions_.clear();
+    for(const auto& seed : *seeds) {
+      seedHitBegin_.push_back(seedHitPositions_.size());
+      if( seed.nHits() > 9 ) continue;
+      const TrajectorySeed::range& hits = seed.recHits();
+      for( auto it = hits.first; it != hits.second; ++it ) {
+	seedHitPositions_.emplace_back(it->globalPosition());
+      }
+    }
+    seedHitPositionsOf_ = seeds;
+  }
+
+  for(unsigned int iSeed = 0; iSeed < seeds->size(); ++iSeed) {
+    const TrajectorySeed& seed = (*seeds)[iSeed];
     if( seed.nHits() > 9 ) {
       edm::LogWarning("GsfElectronAlgo|UnexpectedSeed") <<"We cannot deal with seeds having more than 9 hits." ;
       continue;
     }
     const TrajectorySeed::range& hits = seed.recHits();
-    // cache the global points
-    for( auto it = hits.first; it != hits.second; ++it ) {
-      hit_gp_map_.emplace_back(it->globalPosition());      
-    }
+    const GlobalPoint* hit_gp_map = seedHitPositions_.data() + seedHitBegin_[iSeed];
     //iterate on the hits    
     for( auto it1 = hits.first; it1 != hits.second; ++it1 ) {
       if( !it1->isValid() ) continue;
       const unsigned idx1 = std::distance(hits.first,it1);
       const DetId id1 = it1->geographicalId();
       const GeomDet *geomdet1 = it1->det();      
-      const GlobalPoint& hit1Pos = hit_gp_map_[idx1];
+      const GlobalPoint& hit1Pos = hit_gp_map[idx1];
+      // the hits far in phi are rejected below in any case, without propagation
+      if( std::abs(normalized_phi(hit1Pos.phi()-xmeas_phi))>2.5 ) continue;
 
       const TrajectoryStateOnSurface* tsos1;      
       DetTsosAssoc::iterator tsos1_itr = mapTsos_fast_.find(geomdet1);
@@ -151,7 +166,6 @@ PixelHitMatcher::compatibleSeeds
 				      meas1stBLayer.estimate(vprim, *tsos1, hit1Pos) :
 				      meas1stFLayer.estimate(vprim, *tsos1, hit1Pos)  );
       if( !est.first ) continue;
-      if( std::abs(normalized_phi(hit1Pos.phi()-xmeas_phi))>2.5 ) continue;
       EleRelPointPair pp1(hit1Pos,tsos1->globalParameters().position(),vprim);
       const math::XYZPoint relHit1Pos(hit1Pos-vprim), relTSOSPos(tsos1->globalParameters().position() - vprim);
       const int subDet1 = id1.subdetId();
@@ -193,7 +207,7 @@ PixelHitMatcher::compatibleSeeds
 	  tsos2 = &(empl_result.first->second);
 	}
 	if( !tsos2->isValid() ) continue;
-	const GlobalPoint& hit2Pos = hit_gp_map_[idx2];
+	const GlobalPoint& hit2Pos = hit_gp_map[idx2];
 	std::pair<bool,double> est2  = ( id2.subdetId()%2 ? 
 					 meas2ndBLayer.estimate(vertex, *tsos2,hit2Pos) :
 					 meas2ndFLayer.estimate(vertex, *tsos2,hit2Pos)   );
@@ -24,6 +24,7 @@
 #include "CondFormats/DataRecord/interface/EcalChannelStatusRcd.h"
 
 #include "DataFormats/EcalRecHit/interface/EcalRecHitCollections.h"
+#include "DataFormats/EcalRecHit/interface/EcalRecHitDenseIndex.h"
 
 class EgammaRecHitIsolation {
  public:
@@ -47,6 +48,9 @@ class EgammaRecHitIsolation {
 
   void setUseNumCrystals(bool b=true) { useNumCrystals_ = b; }
   void setVetoClustered(bool b=true) { vetoClustered_ = b; }
+  /// find the rechits of the cells in the cones with an index of the rechit
+  /// collection, worth it when it is shared by many cones
+  void setRecHitIndex(const EcalRecHitDenseIndex* index) { caloHitsIndex_ = index; }
   void doSeverityChecks(const EcalRecHitCollection *const recHits,
 			const std::vector<int>& v) { 
     ecalBarHits_ = recHits; 
@@ -77,6 +81,7 @@ class EgammaRecHitIsolation {
   
   edm::ESHandle<CaloGeometry>  theCaloGeom_ ;
   const EcalRecHitCollection&  caloHits_ ;
+  const EcalRecHitDenseIndex* caloHitsIndex_;
   const EcalSeverityLevelAlgo* sevLevel_;
 
   bool useNumCrystals_;
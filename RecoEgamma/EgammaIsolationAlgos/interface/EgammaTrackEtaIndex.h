@@ -0,0 +1,59 @@
+#ifndef EgammaIsolationAlgos_EgammaTrackEtaIndex_h
+#define EgammaIsolationAlgos_EgammaTrackEtaIndex_h
+
+/** \class EgammaTrackEtaIndex
+ *
+ * Index of the tracks of a collection sorted by eta, so that the track
+ * isolations of all the candidates of an event only loop over the tracks
+ * of the eta window of their cone instead of over the whole collection.
+ * The tracks of a window are given in the order of the collection, so the
+ * isolation sums are the same as without the index.
+ *
+ * The collection must not change while the index is used; an index can be
+ * shared by the isolations of several cone sizes.
+ */
+
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+class EgammaTrackEtaIndex {
+ public:
+  EgammaTrackEtaIndex() : tracks_(0) {}
+  explicit EgammaTrackEtaIndex(const reco::TrackCollection& tracks) : tracks_(0) { reset(tracks); }
+
+  void reset(const reco::TrackCollection& tracks) {
+    tracks_ = &tracks;
+    std::vector<std::pair<double, unsigned int> > sorted;
+    sorted.reserve(tracks.size());
+    for (unsigned int i = 0; i < tracks.size(); ++i) sorted.push_back(std::make_pair(tracks[i].eta(), i));
+    std::sort(sorted.begin(), sorted.end());
+    eta_.resize(sorted.size());
+    index_.resize(sorted.size());
+    for (unsigned int i = 0; i < sorted.size(); ++i) {
+      eta_[i] = sorted[i].first;
+      index_[i] = sorted[i].second;
+    }
+  }
+
+  /// the indices in the collection of the tracks with etaMin <= eta <= etaMax, increasing
+  void tracksInEtaRange(double etaMin, double etaMax, std::vector<unsigned int>& indices) const {
+    indices.clear();
+    std::vector<double>::const_iterator first = std::lower_bound(eta_.begin(), eta_.end(), etaMin);
+    std::vector<double>::const_iterator last = std::upper_bound(first, eta_.end(), etaMax);
+    indices.assign(index_.begin() + (first - eta_.begin()), index_.begin() + (last - eta_.begin()));
+    std::sort(indices.begin(), indices.end());
+  }
+
+  const reco::TrackCollection& collection() const { return *tracks_; }
+
+ private:
+  const reco::TrackCollection* tracks_;
+  std::vector<double> eta_;          // sorted
+  std::vector<unsigned int> index_;  // of the tracks, in the order of eta_
+};
+
+#endif
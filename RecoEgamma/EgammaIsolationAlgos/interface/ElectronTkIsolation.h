@@ -20,6 +20,7 @@
 #include "DataFormats/EgammaCandidates/interface/GsfElectron.h"
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "RecoEgamma/EgammaIsolationAlgos/interface/EgammaTrackSelector.h"
+#include "RecoEgamma/EgammaIsolationAlgos/interface/EgammaTrackEtaIndex.h"
 
 #include<string>
 
@@ -44,7 +45,8 @@ class ElectronTkIsolation {
   lip_(lip),
   drb_(drb),
   trackCollection_(trackCollection),
-  beamPoint_(beamPoint) {
+  beamPoint_(beamPoint),
+  trackIndex_(0) {
 
         setDzOption("vz");
 
@@ -69,7 +71,8 @@ class ElectronTkIsolation {
   lip_(lip),
   drb_(drb),
   trackCollection_(trackCollection),
-  beamPoint_(beamPoint) {
+  beamPoint_(beamPoint),
+  trackIndex_(0) {
 
         setDzOption("vz");
 
@@ -100,6 +103,9 @@ class ElectronTkIsolation {
         else                         dzOption_ = egammaisolation::EgammaTrackSelector::dz;
     }
 
+  /// optional eta index of the track collection, to loop only over the tracks of the cone
+  void setTrackIndex(const EgammaTrackEtaIndex* index) { trackIndex_ = index; }
+
   int getNumberTracks(const reco::GsfElectron*) const ;
   double getPtTracks (const reco::GsfElectron*) const ;
   std::pair<int,double>getIso(const reco::GsfElectron*) const;
@@ -117,6 +123,7 @@ class ElectronTkIsolation {
   double drb_;
   const reco::TrackCollection *trackCollection_ ;
   reco::TrackBase::Point beamPoint_;
+  const EgammaTrackEtaIndex* trackIndex_;
 
   int dzOption_;
 
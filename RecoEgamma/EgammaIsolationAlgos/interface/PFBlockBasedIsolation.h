@@ -32,6 +32,7 @@
 namespace reco{
   class PFBlockElementCluster;
 }
+class PFCandidateEtaPhiIndex;
 
 class PFBlockBasedIsolation{
  public:
@@ -54,6 +55,10 @@ class PFBlockBasedIsolation{
 		 const reco::PFCandidateRef pfEGCand,
 		 const edm::Handle<reco::PFCandidateCollection> pfCandidateHandle);
 
+    /// index of the candidates of pfCandidateHandle, to only loop over those of the cone;
+    /// 0 (the default) loops over all of them
+    void setCandidateIndex(const PFCandidateEtaPhiIndex* index) { candidateIndex_ = index; }
+
 
 private:  
   const reco::PFBlockElementCluster* getHighestEtECALCluster(const reco::PFCandidate& pfCand);
@@ -66,6 +71,7 @@ private:
  private:
 
  double coneSize_;
+ const PFCandidateEtaPhiIndex* candidateIndex_;
      
 
 };
@@ -18,6 +18,7 @@
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
 #include "RecoEgamma/EgammaIsolationAlgos/interface/EgammaTrackSelector.h"
+#include "RecoEgamma/EgammaIsolationAlgos/interface/EgammaTrackEtaIndex.h"
 
 
 
@@ -42,7 +43,8 @@ class PhotonTkIsolation {
     lip_(lip),
     drb_(drb),
     trackCollection_(trackCollection),
-    beamPoint_(beamPoint) {
+    beamPoint_(beamPoint),
+    trackIndex_(0) {
     
     setDzOption("vz");
 
@@ -65,7 +67,8 @@ class PhotonTkIsolation {
     lip_(lip),
     drb_(drb),
     trackCollection_(trackCollection),
-    beamPoint_(beamPoint) {
+    beamPoint_(beamPoint),
+    trackIndex_(0) {
     
     setDzOption("vz");
     
@@ -91,7 +94,8 @@ class PhotonTkIsolation {
     lip_(lip),
     drb_(drb),
     trackCollection_(trackCollection),
-    beamPoint_(beamPoint) {
+    beamPoint_(beamPoint),
+    trackIndex_(0) {
     
     setDzOption("vz");
     
@@ -119,6 +123,9 @@ class PhotonTkIsolation {
   
 
   void setDzOption(const std::string &s);
+
+  /// optional eta index of the track collection, to loop only over the tracks of the cone
+  void setTrackIndex(const EgammaTrackEtaIndex* index) { trackIndex_ = index; }
 private:
   
   float extRadius2_ ;
@@ -132,6 +139,7 @@ private:
 
   const reco::TrackCollection *trackCollection_ ;
   reco::TrackBase::Point beamPoint_;
+  const EgammaTrackEtaIndex* trackIndex_;
 
   int dzOption_;
 
@@ -104,10 +104,14 @@ EgammaEcalRecHitIsolationProducer::produce(edm::Event& iEvent, const edm::EventS
   EgammaRecHitIsolation ecalBarrelIsol(egIsoConeSizeOut_,egIsoConeSizeInBarrel_,egIsoJurassicWidth_,egIsoPtMinBarrel_,egIsoEMinBarrel_,caloGeom,*ecalBarrelRecHitHandle,sevLevel,DetId::Ecal);
   ecalBarrelIsol.setUseNumCrystals(useNumCrystals_);
   ecalBarrelIsol.setVetoClustered(vetoClustered_);
+  EcalRecHitDenseIndex ecalBarrelRecHitIndex(*ecalBarrelRecHitHandle);
+  ecalBarrelIsol.setRecHitIndex(&ecalBarrelRecHitIndex);
 
   EgammaRecHitIsolation ecalEndcapIsol(egIsoConeSizeOut_,egIsoConeSizeInEndcap_,egIsoJurassicWidth_,egIsoPtMinEndcap_,egIsoEMinEndcap_,caloGeom,*ecalEndcapRecHitHandle,sevLevel,DetId::Ecal);
   ecalEndcapIsol.setUseNumCrystals(useNumCrystals_);
   ecalEndcapIsol.setVetoClustered(vetoClustered_);
+  EcalRecHitDenseIndex ecalEndcapRecHitIndex(*ecalEndcapRecHitHandle);
+  ecalEndcapIsol.setRecHitIndex(&ecalEndcapRecHitIndex);
   
   
   for( size_t i = 0 ; i < emObjectHandle->size(); ++i) {
@@ -71,6 +71,8 @@ void EgammaElectronTkIsolationProducer::produce(edm::Event& iEvent, const edm::E
   reco::TrackBase::Point beamspot = beamSpotH->position();
  
   ElectronTkIsolation myTkIsolation (extRadius_,intRadiusBarrel_,intRadiusEndcap_,stripBarrel_,stripEndcap_,ptMin_,maxVtxDist_,drb_,trackCollection,beamspot) ;
+  EgammaTrackEtaIndex trackIndex(*trackCollection) ;
+  myTkIsolation.setTrackIndex(&trackIndex) ;
   
   for(unsigned int i = 0 ; i < electronHandle->size(); ++i ){
     double isoValue = myTkIsolation.getPtTracks(&(electronHandle->at(i)));
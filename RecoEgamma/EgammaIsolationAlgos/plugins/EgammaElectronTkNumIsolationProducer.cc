@@ -72,6 +72,8 @@ void EgammaElectronTkNumIsolationProducer::produce(edm::Event& iEvent, const edm
   reco::TrackBase::Point beamspot = beamSpotH->position();
   
   ElectronTkIsolation myTkIsolation (extRadius_,intRadiusBarrel_,intRadiusEndcap_,stripBarrel_,stripEndcap_,ptMin_,maxVtxDist_,drb_,trackCollection,beamspot) ;
+  EgammaTrackEtaIndex trackIndex(*trackCollection) ;
+  myTkIsolation.setTrackIndex(&trackIndex) ;
   
   for(unsigned int i = 0 ; i < electronHandle->size(); ++i ){
     int isoValue = myTkIsolation.getNumberTracks(&(electronHandle->at(i)));
@@ -76,6 +76,8 @@ EgammaPhotonTkIsolationProducer::produce(edm::Event& iEvent, const edm::EventSet
   std::vector<double> retV(photonHandle->size(),0);
 
   PhotonTkIsolation myTkIsolation (extRadius_,intRadiusBarrel_,intRadiusEndcap_,stripBarrel_,stripEndcap_,ptMin_,maxVtxDist_,drb_,trackCollection,beamspot) ;
+  EgammaTrackEtaIndex trackIndex(*trackCollection) ;
+  myTkIsolation.setTrackIndex(&trackIndex) ;
 
   for(unsigned int i = 0 ; i < photonHandle->size(); ++i ){
     double isoValue = myTkIsolation.getIso(&(photonHandle->at(i))).second;
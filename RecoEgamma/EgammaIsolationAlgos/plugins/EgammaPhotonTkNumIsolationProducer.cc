@@ -74,6 +74,8 @@ EgammaPhotonTkNumIsolationProducer::produce(edm::Event& iEvent, const edm::Event
   std::vector<int> retV(photonHandle->size(),0);
 
   PhotonTkIsolation myTkIsolation(extRadius_,intRadiusBarrel_,intRadiusEndcap_,stripBarrel_,stripEndcap_,ptMin_,maxVtxDist_,drb_,trackCollection,beamspot) ;
+  EgammaTrackEtaIndex trackIndex(*trackCollection) ;
+  myTkIsolation.setTrackIndex(&trackIndex) ;
 
   for(unsigned int i = 0 ; i < photonHandle->size(); ++i ){
     int isoValue = myTkIsolation.getIso(&(photonHandle->at(i))).first;
@@ -95,6 +95,9 @@ void ParticleBasedIsoProducer::produce(edm::Event& theEvent, const edm::EventSet
   edm::Handle<reco::PFCandidateCollection> pfCandidateHandle;
   // Get the  PF candidates collection
   theEvent.getByToken(pfCandidates_,pfCandidateHandle);
+  // shared by the cones of all the photons and electrons
+  pfCandidateIndex_.reset(*pfCandidateHandle);
+  thePFBlockBasedIsolation_->setCandidateIndex(&pfCandidateIndex_);
   
   edm::ValueMap<reco::PhotonRef> pfEGCandToPhotonMap;
   edm::Handle<edm::ValueMap<reco::PhotonRef> > pfEGCandToPhotonMapHandle;
@@ -11,6 +11,7 @@
 #include "DataFormats/EgammaCandidates/interface/PhotonFwd.h"
 #include "DataFormats/EgammaCandidates/interface/GsfElectronFwd.h"
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateEtaPhiIndex.h"
 
 #include "DataFormats/Common/interface/ValueMap.h"
 
@@ -53,6 +54,7 @@ class ParticleBasedIsoProducer : public edm::stream::EDProducer<>
  std::string valueMapElePFCandIso_;
 
  PFBlockBasedIsolation* thePFBlockBasedIsolation_;
+ PFCandidateEtaPhiIndex pfCandidateIndex_;
 
 };
 
@@ -45,6 +45,7 @@ EgammaRecHitIsolation::EgammaRecHitIsolation (double extRadius,
     eLow_(eLow),
     theCaloGeom_(theCaloGeom) ,  
     caloHits_(caloHits),
+    caloHitsIndex_(0),
     sevLevel_(sl),
     useNumCrystals_(false),
     vetoClustered_(false),
@@ -87,7 +88,7 @@ double EgammaRecHitIsolation::getSum_(const reco::Candidate* emObject,bool retur
       EcalRecHitCollection::const_iterator j = caloHits_.end();
 
       for (CaloSubdetectorGeometry::DetIdSet::const_iterator  i = chosen.begin ();i != chosen.end (); ++i){ //loop selected cells
-	j = caloHits_.find(*i); // find selected cell among rechits
+	j = caloHitsIndex_ ? caloHitsIndex_->find(*i) : caloHits_.find(*i); // find selected cell among rechits
 	if(j != caloHits_.end()) { // add rechit only if available 
 	  auto const cell  = theCaloGeom_.product()->getGeometry(*i);
 	  float eta = cell->etaPos();
@@ -203,7 +204,7 @@ double EgammaRecHitIsolation::getSum_(const reco::SuperCluster* sc, bool returnE
       EcalRecHitCollection::const_iterator j=caloHits_.end();
       for (CaloSubdetectorGeometry::DetIdSet::const_iterator  i = chosen.begin ();i!= chosen.end ();++i){//loop selected cells
 	
-	j=caloHits_.find(*i); // find selected cell among rechits
+	j = caloHitsIndex_ ? caloHitsIndex_->find(*i) : caloHits_.find(*i); // find selected cell among rechits
 	if( j!=caloHits_.end()){ // add rechit only if available 
 	  const  GlobalPoint & position = theCaloGeom_.product()->getPosition(*i);
 	  double eta = position.eta();
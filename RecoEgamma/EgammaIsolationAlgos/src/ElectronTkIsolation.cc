@@ -43,7 +43,8 @@ ElectronTkIsolation::ElectronTkIsolation (double extRadius,
   lip_(lip),
   drb_(drb),
   trackCollection_(trackCollection),
-  beamPoint_(beamPoint)
+  beamPoint_(beamPoint),
+  trackIndex_(0)
 {
     setDzOption(dzOptionString);
 }
@@ -66,12 +67,11 @@ std::pair<int,double> ElectronTkIsolation::getIso(const reco::Track* tmpTrack) c
   double tmpElectronEtaAtVertex = (*tmpTrack).eta();
 
 
-  for ( reco::TrackCollection::const_iterator itrTr  = (*trackCollection_).begin() ; 
-	itrTr != (*trackCollection_).end()   ; 
-	++itrTr ) {
+  auto addTrack = [&](const reco::Track& track) {
+    const reco::Track* itrTr = &track;
 
     double this_pt  = (*itrTr).pt();
-    if ( this_pt < ptLow_ ) continue;
+    if ( this_pt < ptLow_ ) return;
 
 
     double dzCut = 0;
@@ -82,8 +82,8 @@ std::pair<int,double> ElectronTkIsolation::getIso(const reco::Track* tmpTrack) c
         case egammaisolation::EgammaTrackSelector::vtx: dzCut = fabs( (*itrTr).dz(tmpTrack->vertex()) ); break;
         default : dzCut = fabs( (*itrTr).vz() - (*tmpTrack).vz() ); break;
     }
-    if (dzCut > lip_ ) continue;
-    if (fabs( (*itrTr).dxy(beamPoint_) ) > drb_   ) continue;
+    if (dzCut > lip_ ) return;
+    if (fabs( (*itrTr).dxy(beamPoint_) ) > drb_   ) return;
     double dr = ROOT::Math::VectorUtil::DeltaR(itrTr->momentum(),tmpElectronMomentumAtVtx) ;
     double deta = (*itrTr).eta() - tmpElectronEtaAtVertex;
     if (fabs(tmpElectronEtaAtVertex) < 1.479) { 
@@ -100,6 +100,23 @@ std::pair<int,double> ElectronTkIsolation::getIso(const reco::Track* tmpTrack) c
             ptSum += this_pt;
         }
     }
+  };
+
+  if ( trackIndex_ && &trackIndex_->collection() == trackCollection_ ) {
+    // the tracks of the cone are within extRadius_ in eta
+    std::vector<unsigned int> tracksInCone;
+    double etaWindow = extRadius_ + 1.e-6;
+    trackIndex_->tracksInEtaRange(tmpElectronEtaAtVertex - etaWindow, tmpElectronEtaAtVertex + etaWindow, tracksInCone);
+    for ( std::vector<unsigned int>::const_iterator i = tracksInCone.begin(); i != tracksInCone.end(); ++i )
+      addTrack((*trackCollection_)[*i]);
+    return std::pair<int,double>(counter, ptSum);
+  }
+
+  for ( reco::TrackCollection::const_iterator itrTr  = (*trackCollection_).begin() ; 
+	itrTr != (*trackCollection_).end()   ; 
+	++itrTr ) {
+
+    addTrack(*itrTr);
 
   }//end loop over tracks                 
   
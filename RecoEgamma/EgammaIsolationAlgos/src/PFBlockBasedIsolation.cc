@@ -8,6 +8,7 @@
 #include "DataFormats/TrackReco/interface/TrackFwd.h"
 #include "DataFormats/EgammaReco/interface/SuperCluster.h"
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateEtaPhiIndex.h"
 #include "DataFormats/Common/interface/RefToPtr.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
 #include "RecoEcal/EgammaCoreTools/interface/EcalClusterLazyTools.h"
@@ -21,7 +22,7 @@
 
 //--------------------------------------------------------------------------------------------------
 
-PFBlockBasedIsolation::PFBlockBasedIsolation() {
+PFBlockBasedIsolation::PFBlockBasedIsolation() : candidateIndex_(0) {
   // Default Constructor.
 }
 
@@ -54,10 +55,15 @@ std::vector<reco::PFCandidateRef>  PFBlockBasedIsolation::calculate(math::XYZTLo
   const reco::PFBlockRef egblock = ieg->first;
 
 
-  unsigned nObj = pfCandidateHandle->size();
+  // the candidates of the cone come in the order of the collection
+  std::vector<unsigned int> candsInCone;
+  const bool useIndex = candidateIndex_ && coneSize_ < 10.0;
+  if ( useIndex ) candidateIndex_->candidatesInCone(candidateDirection.Eta(), candidateDirection.Phi(), coneSize_, candsInCone);
+
+  unsigned nObj = useIndex ? candsInCone.size() : pfCandidateHandle->size();
   for(unsigned int lCand=0; lCand < nObj; lCand++) {
 
-    reco::PFCandidateRef pfCandRef(reco::PFCandidateRef(pfCandidateHandle,lCand));
+    reco::PFCandidateRef pfCandRef(reco::PFCandidateRef(pfCandidateHandle, useIndex ? candsInCone[lCand] : lCand));
 
     float dR = 0.0;
     if( coneSize_ < 10.0 ) {
@@ -8,6 +8,7 @@
 //C++ includes
 #include <vector>
 #include <functional>
+#include <cmath>
 
 //ROOT includes
 #include <Math/VectorUtil.h>
@@ -47,7 +48,8 @@ PhotonTkIsolation::PhotonTkIsolation (float extRadius,
   lip_(lip),
   drb_(drb),
   trackCollection_(trackCollection),
-  beamPoint_(beamPoint)
+  beamPoint_(beamPoint),
+  trackIndex_(0)
 {
     setDzOption(dzOptionString);
 }
@@ -78,8 +80,8 @@ std::pair<int,float> PhotonTkIsolation::getIso(const reco::Candidate* photon ) c
   //Take the photon position
   float photonEta = photon->eta();
 
-  //loop over tracks
-  for(reco::TrackCollection::const_iterator trItr = trackCollection_->begin(); trItr != trackCollection_->end(); ++trItr){
+  auto addTrack = [&](const reco::Track& track) {
+    const reco::Track* trItr = &track;
 
     //check z-distance of vertex 
     float dzCut = 0;
@@ -90,11 +92,11 @@ std::pair<int,float> PhotonTkIsolation::getIso(const reco::Candidate* photon ) c
         case egammaisolation::EgammaTrackSelector::vtx: dzCut = fabs( (*trItr).dz(photon->vertex())); break;
         default : dzCut = fabs( (*trItr).vz() - photon->vertex().z() ); break;
     }
-    if (dzCut > lip_ ) continue;
+    if (dzCut > lip_ ) return;
 
     float this_pt  = (*trItr).pt();
-    if ( this_pt < etLow_ ) continue ;  
-    if (fabs( (*trItr).dxy(beamPoint_) ) > drb_   ) continue;// only consider tracks from the main vertex 
+    if ( this_pt < etLow_ ) return ;  
+    if (fabs( (*trItr).dxy(beamPoint_) ) > drb_   ) return;// only consider tracks from the main vertex 
     float dr2 = reco::deltaR2(*trItr,*photon) ;
     float deta = (*trItr).eta() - photonEta ;
     if (fabs(photonEta) < 1.479) {
@@ -112,6 +114,23 @@ std::pair<int,float> PhotonTkIsolation::getIso(const reco::Candidate* photon ) c
         }
     }
 
+  };
+
+  if ( trackIndex_ && &trackIndex_->collection() == trackCollection_ ) {
+    // the tracks of the cone are within the outer radius in eta
+    std::vector<unsigned int> tracksInCone;
+    double etaWindow = std::sqrt(double(extRadius2_))*(1.+1.e-5) + 1.e-6;
+    trackIndex_->tracksInEtaRange(photon->eta() - etaWindow, photon->eta() + etaWindow, tracksInCone);
+    for ( std::vector<unsigned int>::const_iterator i = tracksInCone.begin(); i != tracksInCone.end(); ++i )
+      addTrack((*trackCollection_)[*i]);
+    return std::pair<int,float>(counter, ptSum);
+  }
+
+  //loop over tracks
+  for(reco::TrackCollection::const_iterator trItr = trackCollection_->begin(); trItr != trackCollection_->end(); ++trItr){
+
+    addTrack(*trItr);
+
   }//end loop over tracks
 
   std::pair<int,float> retval;
@@ -230,6 +230,9 @@ EvtPlaneProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
 	tower_energyet_e   = j->emEt();
 	tower_energyet_h   = j->hadEt();
 	tower_energyet     = tower_energyet_e + tower_energyet_h;
+
+	if(tower_energyet<minet_) continue;
+	if(tower_energyet>maxet_) continue;
 	
 	s1 = sin(2.*tower_phi);
 	s2 = cos(2.*tower_phi);    
@@ -241,9 +244,6 @@ EvtPlaneProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
 	s25 = cos(5.*tower_phi);
 	s16 = sin(6.*tower_phi);
 	s26 = cos(6.*tower_phi);
-	
-	if(tower_energyet<minet_) continue;
-	if(tower_energyet>maxet_) continue;;
 
 	rp[etEcal    ]->addParticle (tower_energyet_e, s1,    s2,    tower_eta);
 	rp[etEcalP   ]->addParticle (tower_energyet_e, s1,    s2,    tower_eta);
@@ -284,23 +284,17 @@ EvtPlaneProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
     iEvent.getByToken(trackCollection_, tracks);
     
     if(tracks.isValid()){
+      // find the vertex point and error, the same for all the tracks
+      math::XYZPoint vtxPoint(0.0,0.0,0.0);
+      double vzErr =0.0, vxErr=0.0, vyErr=0.0;
+      if(vertices3->size()>0) {
+	vtxPoint=vertices3->begin()->position();
+	vzErr=vertices3->begin()->zError();
+	vxErr=vertices3->begin()->xError();
+	vyErr=vertices3->begin()->yError();
+      }
+
       for(reco::TrackCollection::const_iterator j = tracks->begin(); j != tracks->end(); j++){
-	
-	//Find possible collections with command line: edmDumpEventContent *.root
-	
-	edm::Handle<reco::VertexCollection> vertex;
-	iEvent.getByToken(vtxCollection_, vertex);
-	
-	// find the vertex point and error
-
-	math::XYZPoint vtxPoint(0.0,0.0,0.0);
-	double vzErr =0.0, vxErr=0.0, vyErr=0.0;
-	if(vertex->size()>0) {
-	  vtxPoint=vertex->begin()->position();
-	  vzErr=vertex->begin()->zError();
-	  vxErr=vertex->begin()->xError();
-	  vyErr=vertex->begin()->yError();
-	}
 	bool accepted = true;
 	bool isPixel = false;
 	// determine if the track is a pixel track
@@ -340,6 +334,8 @@ EvtPlaneProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
 	  track_eta = j->eta();
 	  track_phi = j->phi();
 	  track_pt = j->pt();
+	  if(track_pt<minpt_) continue;
+	  if(track_pt>maxpt_) continue;
 	  double s =sin(2*track_phi);
 	  double c =cos(2*track_phi);
 	  double s3 =sin(3*track_phi);
@@ -355,8 +351,6 @@ EvtPlaneProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
 	    w = track_pt;
 	    if(w>2.5) w=2.0;   //v2 starts decreasing above ~2.5 GeV/c
 	  }
-	  if(track_pt<minpt_) continue;
-	  if(track_pt>maxpt_) continue;
 	  rp[EvtPlaneFromTracksMidEta]->addParticle(w,s,c,track_eta);
 	  rp[EvtPTracksPosEtaGap]->addParticle(w,s,c,track_eta);
 	  rp[EvtPTracksNegEtaGap]->addParticle(w,s,c,track_eta);
@@ -13,6 +13,7 @@
 #include "Geometry/Records/interface/CaloGeometryRecord.h"
 
 #include <map>
+#include <set>
 using namespace std;
 
 PileUpSubtractor::PileUpSubtractor(const edm::ParameterSet& iConfig, edm::ConsumesCollector && iC) :
@@ -209,8 +210,13 @@ void PileUpSubtractor::calculateOrphanInput(vector<fastjet::PseudoJet> & orphanI
 
   (*fjInputs_) = fjOriginalInputs_;
 
-  vector<int> jettowers; // vector of towers indexed by "user_index"
-  vector<pair<int,int> >  excludedTowers; // vector of excluded ieta, iphi values
+  set<pair<int,int> >  excludedTowers; // excluded ieta, iphi values
+
+  // positions of the towers, the same for all the jets
+  vector<GlobalPoint> geomPositions;
+  geomPositions.reserve(allgeomid_.size());
+  for(vector<HcalDetId>::const_iterator im = allgeomid_.begin(); im != allgeomid_.end(); im++)
+    geomPositions.push_back(geo_->getPosition((DetId)(*im)));
 
   vector <fastjet::PseudoJet>::iterator pseudojetTMP = fjJets_->begin (),
     fjJetsEnd = fjJets_->end();
@@ -218,27 +224,14 @@ void PileUpSubtractor::calculateOrphanInput(vector<fastjet::PseudoJet> & orphanI
     if(pseudojetTMP->perp() < puPtMin_) continue;
 
     // find towers within radiusPU_ of this jet
-    for(vector<HcalDetId>::const_iterator im = allgeomid_.begin(); im != allgeomid_.end(); im++)
+    for(size_t ig = 0; ig < allgeomid_.size(); ++ig)
       {
-	double dr = reco::deltaR(geo_->getPosition((DetId)(*im)),(*pseudojetTMP));
-	vector<pair<int,int> >::const_iterator exclude = find(excludedTowers.begin(),excludedTowers.end(),pair<int,int>(im->ieta(),im->iphi()));
-	if( dr < radiusPU_ && exclude == excludedTowers.end()) {
-	  ntowersWithJets_[(*im).ieta()]++;     
-	  excludedTowers.push_back(pair<int,int>(im->ieta(),im->iphi()));
+	const HcalDetId& im = allgeomid_[ig];
+	double dr = reco::deltaR(geomPositions[ig],(*pseudojetTMP));
+	if( dr < radiusPU_ && excludedTowers.insert(pair<int,int>(im.ieta(),im.iphi())).second) {
+	  ntowersWithJets_[im.ieta()]++;     
 	}
       }
-    vector<fastjet::PseudoJet>::const_iterator it = fjInputs_->begin(),
-      fjInputsEnd = fjInputs_->end();
-      
-    for (; it != fjInputsEnd; ++it ) {
-      int index = it->user_index();
-      int ie = ieta((*inputs_)[index]);
-      int ip = iphi((*inputs_)[index]);
-      vector<pair<int,int> >::const_iterator exclude = find(excludedTowers.begin(),excludedTowers.end(),pair<int,int>(ie,ip));
-      if(exclude != excludedTowers.end()) {
-	jettowers.push_back(index);
-      } //dr < radiusPU_
-    } // initial input collection  
   } // pseudojets
   
   //
@@ -247,8 +240,7 @@ void PileUpSubtractor::calculateOrphanInput(vector<fastjet::PseudoJet> & orphanI
   for(vector<fastjet::PseudoJet>::const_iterator it = fjInputs_->begin(),
 	fjInputsEnd = fjInputs_->end(); it != fjInputsEnd; ++it ) {
     int index = it->user_index();
-    vector<int>::const_iterator itjet = find(jettowers.begin(),jettowers.end(),index);
-    if( itjet == jettowers.end() ){
+    if( excludedTowers.find(pair<int,int>(ieta((*inputs_)[index]),iphi((*inputs_)[index]))) == excludedTowers.end() ){
       const reco::CandidatePtr& originalTower = (*inputs_)[index];
       fastjet::PseudoJet orphan(originalTower->px(),originalTower->py(),originalTower->pz(),originalTower->energy());
       orphan.set_user_index(index);
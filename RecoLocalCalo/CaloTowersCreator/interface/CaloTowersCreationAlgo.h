@@ -105,6 +105,8 @@ public:
 );
   
   void setGeometry(const CaloTowerConstituentsMap* cttopo, const HcalTopology* htopo, const CaloGeometry* geo);
+  /// to be called when the geometry changes: clears the towers of the rechits cached
+  void resetTowerOfCache() { theTowerOfCache.clear(); }
 
   // pass the containers of channels status from the event record (stored in DB)
   // these are called in  CaloTowersCreator
@@ -236,6 +238,9 @@ private:
 
   /// looks for a given tower in the internal cache.  If it can't find it, it makes it.
   MetaTower & find(const CaloTowerDetId & id);
+
+  /// tower of a rechit from the constituents map, cached for the HCAL and ECAL cells
+  CaloTowerDetId towerOf(const DetId & id);
   
   /// helper method to look up the appropriate threshold & weight
   void getThresholdAndWeight(const DetId & detId, double & threshold, double & weight) const;
@@ -328,6 +333,9 @@ private:
   MetaTowerMap theTowerMap;
   unsigned int theTowerMapSize=0;
 
+  // raw ids of the towers of the HCAL, EB and EE cells, by dense index (~0U: not looked up yet)
+  std::vector<uint32_t> theTowerOfCache;
+
   // Number of channels in the tower that were not used in RecHit production (dead/off,...).
   // These channels are added to the other "bad" channels found in the recHit collection. 
   typedef std::map<CaloTowerDetId, int> HcalDropChMap;
@@ -1,6 +1,9 @@
 #include "RecoLocalCalo/CaloTowersCreator/interface/CaloTowersCreationAlgo.h"
 #include "Geometry/CaloTopology/interface/HcalTopology.h"
 #include "Geometry/CaloTopology/interface/CaloTowerConstituentsMap.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/HcalDetId/interface/HcalDetId.h"
 #include "Geometry/CaloGeometry/interface/CaloCellGeometry.h"
 #include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
 #include "Geometry/CaloGeometry/interface/CaloGeometry.h"
@@ -242,6 +245,7 @@ CaloTowersCreationAlgo::CaloTowersCreationAlgo(double EBthreshold, double EEthre
 
 
 void CaloTowersCreationAlgo::setGeometry(const CaloTowerConstituentsMap* ctt, const HcalTopology* topo, const CaloGeometry* geo) {
+  if (ctt!=theTowerConstituentsMap || topo!=theHcalTopology) resetTowerOfCache();
   theTowerConstituentsMap=ctt;
   theHcalTopology = topo;
   theGeometry = geo;
@@ -440,7 +444,7 @@ void CaloTowersCreationAlgo::assignHitHcal(const CaloRecHit * recHit) {
     // bad channels are counted regardless of energy threshold
 
     if (chStatusForCT == CaloTowersCreationAlgo::BadChan) {
-      CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+      CaloTowerDetId towerDetId = towerOf(detId);
       if (towerDetId.null()) return;
       MetaTower & tower28 = find(towerDetId);
       CaloTowerDetId towerDetId29(towerDetId.ieta()+towerDetId.zside(),
@@ -452,7 +456,7 @@ void CaloTowersCreationAlgo::assignHitHcal(const CaloRecHit * recHit) {
 
     else if (0.5*energy >= threshold) {  // not bad channel: use energy if above threshold
       
-      CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+      CaloTowerDetId towerDetId = towerOf(detId);
       if (towerDetId.null()) return;
       MetaTower & tower28 = find(towerDetId);
       CaloTowerDetId towerDetId29(towerDetId.ieta()+towerDetId.zside(),
@@ -505,7 +509,7 @@ void CaloTowersCreationAlgo::assignHitHcal(const CaloRecHit * recHit) {
 
     if(hcalDetId.subdet() == HcalOuter) {
 
-      CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+      CaloTowerDetId towerDetId = towerOf(detId);
       if (towerDetId.null()) return;
       MetaTower & tower = find(towerDetId);
 
@@ -540,14 +544,14 @@ void CaloTowersCreationAlgo::assignHitHcal(const CaloRecHit * recHit) {
     else if(hcalDetId.subdet() == HcalForward) {
 
       if (chStatusForCT == CaloTowersCreationAlgo::BadChan) {
-        CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+        CaloTowerDetId towerDetId = towerOf(detId);
         if (towerDetId.null()) return;
         MetaTower & tower = find(towerDetId);
         tower.numBadHcalCells += 1;
       }
       
       else if (energy >= threshold)  {
-        CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+        CaloTowerDetId towerDetId = towerOf(detId);
         if (towerDetId.null()) return;
         MetaTower & tower = find(towerDetId);
 
@@ -585,13 +589,13 @@ void CaloTowersCreationAlgo::assignHitHcal(const CaloRecHit * recHit) {
     else {
       // HCAL situation normal in HB/HE
       if (chStatusForCT == CaloTowersCreationAlgo::BadChan) {
-        CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+        CaloTowerDetId towerDetId = towerOf(detId);
         if (towerDetId.null()) return;
         MetaTower & tower = find(towerDetId);
         tower.numBadHcalCells += 1;
       }
       else if (energy >= threshold) {
-        CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+        CaloTowerDetId towerDetId = towerOf(detId);
         if (towerDetId.null()) return;
         MetaTower & tower = find(towerDetId);
         tower.E_had += e;
@@ -669,7 +673,7 @@ void CaloTowersCreationAlgo::assignHitEcal(const EcalRecHit * recHit) {
     else  passEmThreshold = (energy >= threshold);
   }
 
-  CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(detId);
+  CaloTowerDetId towerDetId = towerOf(detId);
   if (towerDetId.null()) return;
   MetaTower & tower = find(towerDetId);
 
@@ -726,7 +730,7 @@ void CaloTowersCreationAlgo::assignHitEcal(const EcalRecHit * recHit) {
 // Must be rewritten for full functionality.
 void CaloTowersCreationAlgo::rescale(const CaloTower * ct) {
   double threshold, weight;
-  CaloTowerDetId towerDetId = theTowerConstituentsMap->towerOf(ct->id());
+  CaloTowerDetId towerDetId = towerOf(ct->id());
   if (towerDetId.null()) return;
   MetaTower & tower = find(towerDetId);
 
@@ -786,6 +790,29 @@ CaloTowersCreationAlgo::MetaTower & CaloTowersCreationAlgo::find(const CaloTower
 }
 
 
+CaloTowerDetId CaloTowersCreationAlgo::towerOf(const DetId & detId) {
+  const unsigned int nHcal = theHcalTopology->ncells();
+  unsigned int index;
+  if (detId.det()==DetId::Hcal && HcalDetId(detId).subdet()>=HcalBarrel && HcalDetId(detId).subdet()<=HcalForward) {
+    index = theHcalTopology->detId2denseId(detId);
+    if (index>=nHcal) return theTowerConstituentsMap->towerOf(detId);
+  } else if (detId.det()==DetId::Ecal && detId.subdetId()==EcalBarrel) {
+    index = nHcal + EBDetId(detId).hashedIndex();
+  } else if (detId.det()==DetId::Ecal && detId.subdetId()==EcalEndcap) {
+    index = nHcal + EBDetId::kSizeForDenseIndexing + EEDetId(detId).hashedIndex();
+  } else {
+    return theTowerConstituentsMap->towerOf(detId);
+  }
+
+  if (theTowerOfCache.empty()) {
+    theTowerOfCache.assign(nHcal + EBDetId::kSizeForDenseIndexing + EEDetId::kSizeForDenseIndexing, ~0U);
+  }
+  uint32_t & tower = theTowerOfCache[index];
+  if (tower==~0U) tower = theTowerConstituentsMap->towerOf(detId).rawId();
+  return CaloTowerDetId(tower);
+}
+
+
 void CaloTowersCreationAlgo::convert(const CaloTowerDetId& id, const MetaTower& mt,
                                      CaloTowerCollection & collection) 
 {
@@ -1467,7 +1494,7 @@ void CaloTowersCreationAlgo::makeHcalDropChMap() {
 
     if (theHcalSevLvlComputer->dropChannel(dbStatusFlag)) {
 
-      CaloTowerDetId twrId = theTowerConstituentsMap->towerOf(*it);
+      CaloTowerDetId twrId = towerOf(*it);
       
       hcalDropChMap[twrId] +=1;
       
@@ -209,6 +209,7 @@ void CaloTowersCreator::produce(edm::Event& e, const edm::EventSetup& c) {
   bool check1 = hcalSevLevelWatcher_.check(c);
   bool check2 = hcalChStatusWatcher_.check(c);
   bool check3 = caloTowerConstituentsWatcher_.check(c);
+  if(check3) algo_.resetTowerOfCache();
   if(check1 || check2 || check3)
   {
     algo_.makeHcalDropChMap();
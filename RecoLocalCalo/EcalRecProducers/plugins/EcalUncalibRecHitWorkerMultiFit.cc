@@ -109,6 +109,19 @@ EcalUncalibRecHitWorkerMultiFit::set(const edm::EventSetup& es)
         es.get<EcalPulseShapesRcd>().get(pulseshapes);
         es.get<EcalPulseCovariancesRcd>().get(pulsecovariances);
 
+        int nnoise = noisecovariances->EBG12SamplesCorrelation.size();
+        for (int i=0; i<nnoise; ++i) {
+          for (int j=0; j<nnoise; ++j) {
+            int vidx = std::abs(j-i);
+            noisecorEBg12(i,j) = noisecovariances->EBG12SamplesCorrelation[vidx];
+            noisecorEEg12(i,j) = noisecovariances->EEG12SamplesCorrelation[vidx];
+            noisecorEBg6(i,j)  = noisecovariances->EBG6SamplesCorrelation[vidx];
+            noisecorEEg6(i,j)  = noisecovariances->EEG6SamplesCorrelation[vidx];
+            noisecorEBg1(i,j)  = noisecovariances->EBG1SamplesCorrelation[vidx];
+            noisecorEEg1(i,j)  = noisecovariances->EEG1SamplesCorrelation[vidx];        
+          }
+        }
+
         // weights parameters for the time
         es.get<EcalWeightXtalGroupsRcd>().get(grps);
         es.get<EcalTBWeightsRcd>().get(wgts);
@@ -285,29 +298,18 @@ EcalUncalibRecHitWorkerMultiFit::run( const edm::Event & evt,
         gainRatios[1] = aGain->gain12Over6();
         gainRatios[2] = aGain->gain6Over1()*aGain->gain12Over6();
 
-        int nnoise = noisecovariances->EBG12SamplesCorrelation.size();
-        for (int i=0; i<nnoise; ++i) {
-          for (int j=0; j<nnoise; ++j) {
-            int vidx = std::abs(j-i);
-            noisecorEBg12(i,j) = noisecovariances->EBG12SamplesCorrelation[vidx];
-            noisecorEEg12(i,j) = noisecovariances->EEG12SamplesCorrelation[vidx];
-            noisecorEBg6(i,j)  = noisecovariances->EBG6SamplesCorrelation[vidx];
-            noisecorEEg6(i,j)  = noisecovariances->EEG6SamplesCorrelation[vidx];
-            noisecorEBg1(i,j)  = noisecovariances->EBG1SamplesCorrelation[vidx];
-            noisecorEEg1(i,j)  = noisecovariances->EEG1SamplesCorrelation[vidx];        
-          }
-        }
-        
+        // the sample correlations are filled once per event in set(), and
+        // only the pulse shape of the subdetector of the crystal is used
+        FullSampleVector &xtalpulse = detid.subdetId()==EcalEndcap ? fullpulseEE : fullpulseEB;
+        FullSampleMatrix &xtalpulsecov = detid.subdetId()==EcalEndcap ? fullpulsecovEE : fullpulsecovEB;
         for (int i=0; i<EcalPulseShape::TEMPLATESAMPLES; ++i) {
-          fullpulseEB(i+7) = aPulse->pdfval[i];
-          fullpulseEE(i+7) = aPulse->pdfval[i];
+          xtalpulse(i+7) = aPulse->pdfval[i];
         }
 
-        for(int k=0; k<std::pow(EcalPulseShape::TEMPLATESAMPLES,2); ++k) {
-          int i = k/EcalPulseShape::TEMPLATESAMPLES;
-          int j = k%EcalPulseShape::TEMPLATESAMPLES;
-          fullpulsecovEB(i+7,j+7) = aPulseCov->covval[i][j];
-          fullpulsecovEE(i+7,j+7) = aPulseCov->covval[i][j];
+        for (int i=0; i<EcalPulseShape::TEMPLATESAMPLES; ++i) {
+          for (int j=0; j<EcalPulseShape::TEMPLATESAMPLES; ++j) {
+            xtalpulsecov(i+7,j+7) = aPulseCov->covval[i][j];
+          }
         }
         
 	// compute the right bin of the pulse shape using time calibration constants
@@ -81,6 +81,7 @@ public:
 		       double iTS4Min, double iTS4Max, double iPulseJitter,double iTimeMean,double iTimeSig,double iPedMean,double iPedSig,
 		       double iNoise,double iTMin,double iTMax,
 		       double its3Chi2,double its4Chi2,double its345Chi2,double iChargeThreshold, int iFitTimes); 
+  void setpuCorrFastFit(bool iApplyFastFit){ if( psFitOOTpuCorr_.get() ) psFitOOTpuCorr_->setApplyFastFit(iApplyFastFit); }
   
 private:
   bool correctForTimeslew_;
@@ -47,6 +47,9 @@ namespace FitterFuncs{
      void setpsFiterry (double *erry  ){ for(int i=0; i<HcalConst::maxSamples; ++i) psFit_erry  [i] = erry [i]; }
      void setpsFiterry2(double *erry2 ){ for(int i=0; i<HcalConst::maxSamples; ++i) psFit_erry2 [i] = erry2[i]; }
      void setpsFitslew (double *slew  ){ for(int i=0; i<HcalConst::maxSamples; ++i) {psFit_slew [i] = slew [i]; } }
+     double getpsFiterry2(int i) const { return psFit_erry2[i]; }
+     // pulse of unit height at pulseTime, with the time slew of its time slice
+     void unitPulseShape(std::array<float,HcalConst::maxSamples> & shape, double pulseTime);
      double sigma(double ifC);
      double singlePulseShapeFunc( const double *x );
      double doublePulseShapeFunc( const double *x );
@@ -95,6 +98,9 @@ public:
 		     double iNoise,double iTMin,double iTMax,
 		     double its3Chi2,double its4Chi2,double its345Chi2,double iChargeThreshold,HcalTimeSlew::BiasSetting slewFlavor, int iFitTimes);
     
+    // fixed-iteration fit instead of Minuit (not used with the pulse jitter)
+    void setApplyFastFit(bool b) { applyFastFit_ = b; }
+
     void setPulseShapeTemplate  (const HcalPulseShapes::Shape& ps);
     void resetPulseShapeTemplate(const HcalPulseShapes::Shape& ps);
 
@@ -103,12 +109,15 @@ private:
 		      const double *pedArr, const double *gainArr, const double tsTOTen, std::vector<double> &fitParsVec) const;
     void fit(int iFit,float &timevalfit,float &chargevalfit,float &pedvalfit,float &chi2,bool &fitStatus,double &iTSMax,
 	     const double  &iTSTOTen,double *iEnArr,int (&iBX)[3]) const;
+    void fastFit(int n,const double *vstart,const double *tLow,const double *tHigh,double ampMax,double pedMax,
+		 const double *iEnArr,double *results,float &chi2) const;
 
     PSFitter::HybridMinimizer * hybridfitter;
     int cntsetPulseShape;
     std::array<double,HcalConst::maxSamples> iniTimesArr;
     double chargeThreshold_;
     int fitTimes_;
+    bool applyFastFit_;
 
     std::auto_ptr<FitterFuncs::PulseShapeFunctor> psfPtr_;
     ROOT::Math::Functor *spfunctor_;
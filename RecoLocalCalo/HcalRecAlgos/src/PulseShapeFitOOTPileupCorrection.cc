@@ -103,6 +103,11 @@ namespace FitterFuncs{
     return;
   }
 
+  void PulseShapeFunctor::unitPulseShape(std::array<float,HcalConst::maxSamples> & shape, double pulseTime) {
+    int time = (pulseTime+timeShift_-timeMean_)*HcalConst::invertnsPerBx;
+    funcHPDShape(shape, pulseTime, 1., psFit_slew[time]);
+  }
+
   PulseShapeFunctor::~PulseShapeFunctor() {
   }
 
@@ -196,7 +201,7 @@ namespace FitterFuncs{
   
 }
 
-PulseShapeFitOOTPileupCorrection::PulseShapeFitOOTPileupCorrection() : cntsetPulseShape(0), chargeThreshold_(6.),
+PulseShapeFitOOTPileupCorrection::PulseShapeFitOOTPileupCorrection() : cntsetPulseShape(0), chargeThreshold_(6.), applyFastFit_(false),
 								       psfPtr_(nullptr), spfunctor_(nullptr), dpfunctor_(nullptr), tpfunctor_(nullptr),
 								       TSMin_(0), TSMax_(0), ts4Chi2_(0), ts3Chi2_(0), ts345Chi2_(0), pedestalConstraint_(0),
 								       timeConstraint_(0), addPulseJitter_(0), unConstrainedFit_(0), applyTimeSlew_(0),
@@ -392,6 +397,22 @@ void PulseShapeFitOOTPileupCorrection::fit(int iFit,float &timevalfit,float &cha
    }
    vstart[n-1] = pedMean_;
 
+   //a special number to label the initial condition
+   chi2=-1;
+   const double *results = 0;
+   double fastResults[7];
+   if(applyFastFit_ && !addPulseJitter_) {
+     double tLow[3], tHigh[3];
+     for(int i = 0; i < int((n-1)/2); i++) {
+       tLow [i] = iniTimesArr[iBX[i]]+tMin;
+       tHigh[i] = iniTimesArr[iBX[i]]+tMax;
+     }
+     if(vstart[n-1] > std::abs(pedMax)) vstart[n-1] = pedMax;
+     fastFit(n,vstart,tLow,tHigh,iTSTOTEn,pedMax,iEnArr,fastResults,chi2);
+     fitStatus = true;
+     results = fastResults;
+   } else {
+
    double step[n];
    for(int i = 0; i < n; i++) step[i] = 0.1;
       
@@ -411,10 +432,7 @@ void PulseShapeFitOOTPileupCorrection::fit(int iFit,float &timevalfit,float &cha
    hybridfitter->SetLimitedVariable(n-1, varNames[n-1], vstart[n-1], step[n-1],-pedMax,pedMax);
    //Secret Option to fix the pedestal
    if(pedSig_ < 0) hybridfitter->SetFixedVariable(n-1,varNames[n-1],vstart[n-1]);
-   //a special number to label the initial condition
-   chi2=-1;
    //3 fits why?!
-   const double *results = 0;
    for(int tries=0; tries<=3;++tries){
      if( fitTimes_ != 2 || tries !=1 ){
         hybridfitter->SetMinimizerType(PSFitter::HybridMinimizer::kMigrad);
@@ -443,6 +461,8 @@ void PulseShapeFitOOTPileupCorrection::fit(int iFit,float &timevalfit,float &cha
        break;
      }
    }
+
+   }
    assert(results);
 
    timevalfit   = results[0];
@@ -463,3 +483,112 @@ void PulseShapeFitOOTPileupCorrection::fit(int iFit,float &timevalfit,float &cha
      chargevalfit=-999.;
    }
 }
+
+void PulseShapeFitOOTPileupCorrection::fastFit(int n,const double *vstart,const double *tLow,const double *tHigh,double ampMax,double pedMax,
+					       const double *iEnArr,double *results,float &chi2) const {
+  // The times of the pulses are scanned in 1 ns steps, one pulse after the other,
+  // and refined with a parabola through the best point. For given times the chi2
+  // is quadratic in the amplitudes and the pedestal, which are found by a bounded
+  // coordinate descent on the normal equations. The chi2 is the one of Minuit.
+  // Both stop once they no longer improve by more than their tolerance.
+  constexpr int nbins = HcalConst::maxSamples;
+  constexpr int maxSweeps = 2;
+  constexpr int maxLinearIters = 100;
+  constexpr double linearTolerance = 1e-6; // relative change of the amplitudes and pedestal
+  constexpr double sweepTolerance = 1e-3;  // chi2
+  const int npulse = (n-1)/2;
+  const double pedLow  = pedSig_ < 0 ? vstart[n-1] : -pedMax;
+  const double pedHigh = pedSig_ < 0 ? vstart[n-1] :  pedMax;
+
+  double pars[7];
+  for(int i = 0; i < n; ++i) pars[i] = vstart[i];
+  std::array<float,HcalConst::maxSamples> shapes[3];
+  for(int k = 0; k < npulse; ++k) psfPtr_->unitPulseShape(shapes[k],pars[2*k]);
+
+  double w[nbins];
+  for(int j = 0; j < nbins; ++j) {
+    double erry2 = psfPtr_->getpsFiterry2(j);
+    w[j] = erry2 > 0 ? 1./erry2 : 0.;
+  }
+
+  // amplitudes and pedestal for the current times, returns the chi2
+  auto solveLinear = [&]() {
+    double m[4][4] = {}, b[4] = {}, u[4];
+    for(int j = 0; j < nbins; ++j) {
+      double s[4];
+      for(int k = 0; k < npulse; ++k) s[k] = shapes[k][j];
+      s[npulse] = 1.;
+      for(int a = 0; a <= npulse; ++a) {
+	b[a] += w[j]*s[a]*iEnArr[j];
+	for(int c = 0; c <= npulse; ++c) m[a][c] += w[j]*s[a]*s[c];
+      }
+    }
+    if(pedestalConstraint_) {
+      m[npulse][npulse] += 1./(pedSig_*pedSig_);
+      b[npulse] += pedMean_/(pedSig_*pedSig_);
+    }
+    for(int k = 0; k < npulse; ++k) u[k] = pars[2*k+1];
+    u[npulse] = pars[n-1];
+    double scale = pedMax;
+    for(int k = 0; k < npulse; ++k) scale = std::max(scale,pars[2*k+1]);
+    for(int iter = 0; iter < maxLinearIters; ++iter) {
+      double change = 0;
+      for(int a = 0; a <= npulse; ++a) {
+	if(m[a][a] <= 0) continue;
+	double r = b[a];
+	for(int c = 0; c <= npulse; ++c) if(c != a) r -= m[a][c]*u[c];
+	const double low  = a < npulse ? 0.     : pedLow;
+	const double high = a < npulse ? ampMax : pedHigh;
+	const double ua = std::min(high,std::max(low,r/m[a][a]));
+	change = std::max(change,std::abs(ua-u[a]));
+	u[a] = ua;
+      }
+      if(change <= linearTolerance*scale) break;
+    }
+    for(int k = 0; k < npulse; ++k) pars[2*k+1] = u[k];
+    pars[n-1] = u[npulse];
+    return psfPtr_->EvalPulse(pars,n);
+  };
+
+  double best = solveLinear();
+  double bestPars[7];
+  for(int i = 0; i < n; ++i) bestPars[i] = pars[i];
+  for(int sweep = 0; sweep < maxSweeps && timeSig_ >= 0; ++sweep) {
+    const double sweepStart = best;
+    for(int k = 0; k < npulse; ++k) {
+      // chi2 of the neighbours of the best point of the scan
+      double prev = -1, bestPrev = -1, bestNext = -1, bestT = pars[2*k];
+      bool next = false, improved = false;
+      for(double t = tLow[k]; t <= tHigh[k]; t += 1.) {
+	pars[2*k] = t;
+	psfPtr_->unitPulseShape(shapes[k],t);
+	double c = solveLinear();
+	if(next) { bestNext = c; next = false; }
+	if(c < best) {
+	  best = c; bestT = t; bestPrev = prev; bestNext = -1; next = true; improved = true;
+	  for(int i = 0; i < n; ++i) bestPars[i] = pars[i];
+	}
+	prev = c;
+      }
+      if(improved && bestPrev >= 0 && bestNext >= 0) {
+	double denom = bestPrev - 2*best + bestNext;
+	if(denom > 0) {
+	  for(int i = 0; i < n; ++i) pars[i] = bestPars[i];
+	  pars[2*k] = bestT + 0.5*(bestPrev - bestNext)/denom;
+	  psfPtr_->unitPulseShape(shapes[k],pars[2*k]);
+	  double c = solveLinear();
+	  if(c < best) {
+	    best = c;
+	    for(int i = 0; i < n; ++i) bestPars[i] = pars[i];
+	  }
+	}
+      }
+      for(int i = 0; i < n; ++i) pars[i] = bestPars[i];
+      psfPtr_->unitPulseShape(shapes[k],pars[2*k]);
+    }
+    // a single pulse has no other time to adjust to the new one
+    if(npulse == 1 || sweepStart - best <= sweepTolerance) break;
+  }
+  for(int i = 0; i < n; ++i) results[i] = bestPars[i];
+  chi2 = best;
+}
@@ -0,0 +1,86 @@
+// compare the fast fit of PulseShapeFitOOTPileupCorrection with the Minuit fit
+// on HB pulses with out-of-time pileup in the previous and next bunch crossings
+
+#include "RecoLocalCalo/HcalRecAlgos/interface/PulseShapeFitOOTPileupCorrection.h"
+#include "CalibCalorimetry/HcalAlgos/interface/HcalPulseShapes.h"
+#include "CalibFormats/CaloObjects/interface/CaloSamples.h"
+#include "CalibFormats/HcalObjects/interface/HcalCalibrations.h"
+#include "DataFormats/HcalDetId/interface/HcalDetId.h"
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+  // the HBHE parameters of the reconstruction with puCorrMethod = 2
+  void configure(PulseShapeFitOOTPileupCorrection & fitter, HcalPulseShapes const & shapes, bool fast) {
+    fitter.setPUParams(true, true, false, false, true,   // pedestal and time constraints, time slew
+                       5., 500., 1., -2.5, 5., 0., 0.5,  // ts4Min, ts4Max, pulseJitter, meanTime, timeSigma, meanPed, pedSigma
+                       1., -12.5, 12.5,                  // noise, timeMin, timeMax
+                       5., 15., 100., 6.,                // ts3chi2, ts4chi2, ts345chi2, chargeMax
+                       HcalTimeSlew::Medium, 1);
+    fitter.setPulseShapeTemplate(shapes.hbShape());
+    fitter.setApplyFastFit(fast);
+  }
+
+}
+
+int main() {
+
+  HcalPulseShapes shapes;
+  PulseShapeFitOOTPileupCorrection minuit, fast;
+  configure(minuit, shapes, false);
+  configure(fast, shapes, true);
+
+  // unit pulses to build the samples from
+  FitterFuncs::PulseShapeFunctor pulses(shapes.hbShape(), false, false, false, false, 0., 0., 1., 0., 1., 0.);
+
+  const float gain[4] = {0.1f, 0.1f, 0.1f, 0.1f};
+  const float pedestal[4] = {3.f, 3.f, 3.f, 3.f};
+  const HcalCalibrations calibs(gain, pedestal, 1.f, 0.f, 1.f);
+  const std::vector<int> capid = {0, 1, 2, 3, 0, 1, 2, 3, 0, 1};
+  const HcalDetId id(HcalBarrel, 1, 1, 1);
+
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<double> energy(2., 500.);      // GeV in the triggered bunch crossing
+  std::uniform_real_distribution<double> time(-5., 5.);         // ns
+  std::exponential_distribution<double> pileup(1./5.);          // GeV in the neighbouring bunch crossings
+  std::normal_distribution<double> noise(0., 1.);               // fC
+
+  constexpr int nPulses = 2000;
+  int nFitted = 0, nEnergy = 0, nChi2 = 0;
+  for (int ipulse = 0; ipulse < nPulses; ++ipulse) {
+    const double bx[3] = {energy(rng), pileup(rng), pileup(rng)};
+    const double t[3] = {time(rng), time(rng) - 25., time(rng) + 25.};
+
+    CaloSamples cs(id, HcalConst::maxSamples);
+    for (int i = 0; i < HcalConst::maxSamples; ++i) cs[i] = pedestal[capid[i]] + noise(rng);
+    for (int k = 0; k < 3; ++k) {
+      std::array<float, HcalConst::maxSamples> shape;
+      pulses.unitPulseShape(shape, t[k]);
+      for (int i = 0; i < HcalConst::maxSamples; ++i) cs[i] += bx[k]/gain[0]*shape[i];
+    }
+
+    std::vector<double> resMinuit, resFast;
+    minuit.apply(cs, capid, calibs, resMinuit);
+    fast.apply(cs, capid, calibs, resFast);
+    if (resMinuit.size() != resFast.size()) {
+      std::printf("pulse %d: the fits disagree on whether to fit\n", ipulse);
+      return 1;
+    }
+    // the output is energy, time, pedestal, chi2 and the NaN count, or only the NaN count without a fit
+    if (resMinuit.size() < 4) continue;
+    ++nFitted;
+
+    if (std::abs(resFast[0] - resMinuit[0]) <= 0.02*resMinuit[0] + 0.5) ++nEnergy;
+    if (resFast[3] <= 1.05*resMinuit[3] + 0.5) ++nChi2;
+  }
+
+  std::printf("%d pulses fitted: energy agrees in %d, chi2 within 5%% in %d\n", nFitted, nEnergy, nChi2);
+  if (nFitted < nPulses/2) return 1;
+  if (nEnergy < 0.95*nFitted || nChi2 < 0.95*nFitted) return 1;
+  return 0;
+}
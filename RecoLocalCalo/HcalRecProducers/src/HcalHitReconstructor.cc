@@ -282,6 +282,7 @@ HcalHitReconstructor::HcalHitReconstructor(edm::ParameterSet const& conf):
 			  conf.getParameter<double>("chargeMax"), //For the unconstrained Fit
                           conf.getParameter<int>   ("fitTimes")
 			  );
+    reco_.setpuCorrFastFit(conf.existsAs<bool>("applyFastFit") ? conf.getParameter<bool>("applyFastFit") : false);
   }
 }
 
@@ -18,6 +18,11 @@
 #include <FWCore/Utilities/interface/Exception.h>
 #include <FWCore/MessageLogger/interface/MessageLogger.h> 
 
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+
 CSCSegmentBuilder::CSCSegmentBuilder(const edm::ParameterSet& ps) : geom_(0) {
     
     // The algo chosen for the segment building
@@ -48,12 +53,19 @@ CSCSegmentBuilder::CSCSegmentBuilder(const edm::ParameterSet& ps) : geom_(0) {
 	  "#dim algosToType=" << algoToType.size() << ", #dim chType=" << chType.size() << std::endl;
     }
 
+    // Number of chambers built concurrently, each with its own algorithms
+    unsigned int parallelChambers = ps.getUntrackedParameter<unsigned int>("parallelChambers", 0);
+    algoMaps.resize(std::max(1U, parallelChambers));
+
     // Ask factory to build this algorithm, giving it appropriate ParameterSet
             
-    for (size_t j=0; j<chType.size(); ++j) {
-        algoMap[chType[j]] = CSCSegmentBuilderPluginFactory::get()->
-                create(algoName, segAlgoPSet[algoToType[j]-1]);
-	edm::LogVerbatim("CSCSegment|CSC")<< "using algorithm #" << algoToType[j] << " for chamber type " << chType[j];
+    for (size_t i=0; i<algoMaps.size(); ++i) {
+        for (size_t j=0; j<chType.size(); ++j) {
+            algoMaps[i][chType[j]] = CSCSegmentBuilderPluginFactory::get()->
+                    create(algoName, segAlgoPSet[algoToType[j]-1]);
+	    if (i == 0)
+	        edm::LogVerbatim("CSCSegment|CSC")<< "using algorithm #" << algoToType[j] << " for chamber type " << chType[j];
+        }
     }
 }
 
@@ -61,8 +73,10 @@ CSCSegmentBuilder::~CSCSegmentBuilder() {
   //
   // loop on algomap and delete them
   //
-  for (std::map<std::string, CSCSegmentAlgorithm*>::iterator it = algoMap.begin();it != algoMap.end(); it++){
-    delete ((*it).second);
+  for (std::vector<AlgoMap>::iterator algoMap = algoMaps.begin(); algoMap != algoMaps.end(); ++algoMap) {
+    for (AlgoMap::iterator it = algoMap->begin();it != algoMap->end(); it++){
+      delete ((*it).second);
+    }
   }
 }
 
@@ -87,31 +101,53 @@ void CSCSegmentBuilder::build(const CSCRecHit2DCollection* recHits, CSCSegmentCo
             chambers.push_back((*it2).cscDetId().chamberId());
     }
 
+    if (algoMaps.size() > 1) {
+        // each task takes the next chamber, with its own algorithms
+        std::vector<std::vector<CSCSegment> > segments(chambers.size());
+        std::atomic<unsigned int> next(0);
+        tbb::parallel_for(size_t(0), algoMaps.size(), [&](size_t i) {
+            for (unsigned int ich = next++; ich < chambers.size(); ich = next++)
+                segments[ich] = buildChamber(recHits, chambers[ich], algoMaps[i]);
+        });
+        // Add the segments to master collection, in the order of the chambers
+        for (unsigned int ich = 0; ich < chambers.size(); ++ich)
+            oc.put(chambers[ich], segments[ich].begin(), segments[ich].end());
+        return;
+    }
+
     for(chIt=chambers.begin(); chIt != chambers.end(); ++chIt) {
 
-        std::vector<const CSCRecHit2D*> cscRecHits;
-        const CSCChamber* chamber = geom_->chamber(*chIt);
+        std::vector<CSCSegment> segv = buildChamber(recHits, *chIt, algoMaps[0]);
+
+        // Add the segments to master collection
+        oc.put((*chIt), segv.begin(), segv.end());
+    }
+}
+
+std::vector<CSCSegment> CSCSegmentBuilder::buildChamber(const CSCRecHit2DCollection* recHits, const CSCDetId& id,
+							AlgoMap& algos) const {
+
+    std::vector<const CSCRecHit2D*> cscRecHits;
+    const CSCChamber* chamber = geom_->chamber(id);
         
-        CSCRangeMapAccessor acc;
-        CSCRecHit2DCollection::range range = recHits->get(acc.cscChamber(*chIt));
+    CSCRangeMapAccessor acc;
+    CSCRecHit2DCollection::range range = recHits->get(acc.cscChamber(id));
         
-        std::vector<int> hitPerLayer(6);
-        for(CSCRecHit2DCollection::const_iterator rechit = range.first; rechit != range.second; rechit++) {
+    std::vector<int> hitPerLayer(6);
+    for(CSCRecHit2DCollection::const_iterator rechit = range.first; rechit != range.second; rechit++) {
             
-            hitPerLayer[(*rechit).cscDetId().layer()-1]++;
-            cscRecHits.push_back(&(*rechit));
-        }    
+        hitPerLayer[(*rechit).cscDetId().layer()-1]++;
+        cscRecHits.push_back(&(*rechit));
+    }    
         
-        LogDebug("CSCSegment|CSC") << "found " << cscRecHits.size() << " rechits in chamber " << *chIt;
+    LogDebug("CSCSegment|CSC") << "found " << cscRecHits.size() << " rechits in chamber " << id;
             
-        // given the chamber select the appropriate algo... and run it
-        std::vector<CSCSegment> segv = algoMap[chamber->specs()->chamberTypeName()]->run(chamber, cscRecHits);
+    // given the chamber select the appropriate algo... and run it
+    std::vector<CSCSegment> segv = algos[chamber->specs()->chamberTypeName()]->run(chamber, cscRecHits);
 
-        LogDebug("CSCSegment|CSC") << "found " << segv.size() << " segments in chamber " << *chIt;
+    LogDebug("CSCSegment|CSC") << "found " << segv.size() << " segments in chamber " << id;
 
-        // Add the segments to master collection
-        oc.put((*chIt), segv.begin(), segv.end());
-    }
+    return segv;
 }
 
 void CSCSegmentBuilder::setGeometry(const CSCGeometry* geom) {
@@ -16,9 +16,14 @@
 
 #include <DataFormats/CSCRecHit/interface/CSCRecHit2DCollection.h>
 #include <DataFormats/CSCRecHit/interface/CSCSegmentCollection.h>
+#include <DataFormats/MuonDetId/interface/CSCDetId.h>
 
 #include <FWCore/ParameterSet/interface/ParameterSet.h>
 
+#include <map>
+#include <string>
+#include <vector>
+
 class CSCGeometry;
 class CSCSegmentAlgorithm;
 
@@ -35,6 +40,8 @@ public:
 
     /** Find rechits in each CSCChamber, build CSCSegment's in each chamber,
      *  and fill into output collection.
+     *  With parallelChambers > 1, up to that many chambers are built
+     *  concurrently; the collection is filled in the same order.
      */
     void build(const CSCRecHit2DCollection* rechits, CSCSegmentCollection& oc);
 
@@ -44,8 +51,15 @@ public:
 
 private:
 
+    typedef std::map<std::string, CSCSegmentAlgorithm*> AlgoMap;
+
+    /// build the segments of a chamber with the algorithms of a map
+    std::vector<CSCSegment> buildChamber(const CSCRecHit2DCollection* rechits, const CSCDetId& id, AlgoMap& algos) const;
+
     const CSCGeometry* geom_;
-    std::map<std::string, CSCSegmentAlgorithm*> algoMap;
+    // the algorithms by chamber type: more than one set of them if several
+    // chambers are built concurrently, as the algorithms have a state
+    std::vector<AlgoMap> algoMaps;
 };
 
 #endif
@@ -20,6 +20,10 @@
 
 #include "Geometry/Records/interface/MuonGeometryRecord.h"
 
+#include "tbb/parallel_for.h"
+
+#include <atomic>
+
 using namespace edm;
 using namespace std;
 
@@ -43,6 +47,12 @@ DTRecSegment4DProducer::DTRecSegment4DProducer(const ParameterSet& pset){
   if(debug) cout << "the Reco4D AlgoName is " << theReco4DAlgoName << endl;
   the4DAlgo = DTRecSegment4DAlgoFactory::get()->create(theReco4DAlgoName,
 						       pset.getParameter<ParameterSet>("Reco4DAlgoConfig"));
+
+  // Number of chambers reconstructed concurrently, each with its own algo
+  unsigned int parallelChambers = pset.getUntrackedParameter<unsigned int>("parallelChambers", 0);
+  for(unsigned int i = 1; i < parallelChambers; ++i)
+    theParallel4DAlgos.push_back(DTRecSegment4DAlgoFactory::get()->create(theReco4DAlgoName,
+									  pset.getParameter<ParameterSet>("Reco4DAlgoConfig")));
 }
 
 /// Destructor
@@ -50,6 +60,8 @@ DTRecSegment4DProducer::~DTRecSegment4DProducer(){
   if(debug)
     cout << "[DTRecSegment4DProducer] Destructor called" << endl;
   delete the4DAlgo;
+  for(vector<DTRecSegment4DBaseAlgo*>::iterator algo = theParallel4DAlgos.begin(); algo != theParallel4DAlgos.end(); ++algo)
+    delete *algo;
 }
 
 void DTRecSegment4DProducer::produce(Event& event, const EventSetup& setup){
@@ -78,6 +90,47 @@ void DTRecSegment4DProducer::produce(Event& event, const EventSetup& setup){
 
   DTChamberId oldChId;
 
+  if (!theParallel4DAlgos.empty()) {
+    vector<DTRecSegment4DBaseAlgo*> algos(1, the4DAlgo);
+    algos.insert(algos.end(), theParallel4DAlgos.begin(), theParallel4DAlgos.end());
+    for(unsigned int i = 1; i < algos.size(); ++i) algos[i]->setES(setup);
+
+    vector<DTChamberId> chambers;
+    for (dtLayerIt = all1DHits->id_begin(); dtLayerIt != all1DHits->id_end(); ++dtLayerIt){
+      const DTChamberId chId = (*dtLayerIt).chamberId();
+      if (chId==oldChId) continue; // I'm on the same Chamber as before
+      oldChId = chId;
+      chambers.push_back(chId);
+    }
+
+    // each task takes the next chamber, with its own algo
+    vector<OwnVector<DTRecSegment4D> > segments4D(chambers.size());
+    std::atomic<unsigned int> next(0);
+    tbb::parallel_for(size_t(0), algos.size(), [&](size_t i) {
+	DTRecSegment4DBaseAlgo* algo = algos[i];
+	for (unsigned int ich = next++; ich < chambers.size(); ich = next++) {
+	  algo->setChamber(chambers[ich]);
+	  algo->setDTRecHit1DContainer(all1DHits);
+	  algo->setDTRecSegment2DContainer(all2DSegments);
+	  segments4D[ich] = algo->reconstruct();
+	}
+      });
+
+    // fill the collection in the order of the chambers
+    for (unsigned int ich = 0; ich < chambers.size(); ++ich) {
+      if(debug) {
+	cout << "ChamberId: "<< chambers[ich] << endl;
+	cout << "Number of reconstructed 4D-segments " << segments4D[ich].size() << endl;
+	copy(segments4D[ich].begin(), segments4D[ich].end(),
+	     ostream_iterator<DTRecSegment4D>(cout, "\n"));
+      }
+      if (segments4D[ich].size() > 0 )
+	segments4DCollection->put(chambers[ich], segments4D[ich].begin(),segments4D[ich].end());
+    }
+    event.put(segments4DCollection);
+    return;
+  }
+
   for (dtLayerIt = all1DHits->id_begin(); dtLayerIt != all1DHits->id_end(); ++dtLayerIt){
 
     // Check the DTChamberId
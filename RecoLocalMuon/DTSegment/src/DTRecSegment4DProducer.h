@@ -11,6 +11,8 @@
 #include "DataFormats/DTRecHit/interface/DTRecHitCollection.h"
 #include "DataFormats/DTRecHit/interface/DTRecSegment2DCollection.h"
 
+#include <vector>
+
 namespace edm {
   class ParameterSet;
   class Event;
@@ -44,6 +46,9 @@ private:
   edm::EDGetTokenT<DTRecSegment2DCollection> recHits2DToken_;
   // The 4D-segments reconstruction algorithm
   DTRecSegment4DBaseAlgo* the4DAlgo;
+  // Its copies for the chambers reconstructed concurrently with the first
+  // one (parallelChambers > 1), as the algorithm has a state
+  std::vector<DTRecSegment4DBaseAlgo*> theParallel4DAlgos;
 };
 #endif
 
@@ -17,11 +17,17 @@
 //! do the calibrations ADC->electrons here.
 //! Modify the thresholds to be in electrons, convert adc to electrons. d.k. 20/3/06
 //! Get rid of the noiseVector. d.k. 28/3/06
+//!
+//! With UseOccupancyBitmap the matrix is replaced by a SiPixelOccupancyBitmap:
+//! an occupancy bitmap and the charges of the pixels above threshold only,
+//! so that neither the filling nor the reset touch a full size array.
+//! The clusters found are the same.
 //----------------------------------------------------------------------------
 
 // Our own includes
 #include "PixelThresholdClusterizer.h"
 #include "SiPixelArrayBuffer.h"
+#include "SiPixelOccupancyBitmap.h"
 #include "CondFormats/SiPixelObjects/interface/SiPixelGainCalibrationOffline.h"
 // Geometry
 #include "Geometry/TrackerGeometryBuilder/interface/PixelGeomDetUnit.h"
@@ -43,7 +49,9 @@ using namespace std;
 //----------------------------------------------------------------------------
 PixelThresholdClusterizer::PixelThresholdClusterizer
   (edm::ParameterSet const& conf) :
-    conf_(conf), bufferAlreadySet(false), theNumOfRows(0), theNumOfCols(0), detid_(0) 
+    conf_(conf), bufferAlreadySet(false),
+    useBitmap(conf.existsAs<bool>("UseOccupancyBitmap") ? conf.getParameter<bool>("UseOccupancyBitmap") : false),
+    theNumOfRows(0), theNumOfCols(0), detid_(0) 
 {
   // Get thresholds in electrons
   thePixelThreshold   = 
@@ -86,6 +94,13 @@ bool PixelThresholdClusterizer::setup(const PixelGeomDetUnit * pixDet)
   
   theNumOfRows = nrows;  // Set new sizes
   theNumOfCols = ncols;
+
+  if ( useBitmap ) {
+    // the bitmap is scanned by column: it must have the size of the module
+    if ( nrows != theBitmap.rows() || ncols != theBitmap.columns() )
+      theBitmap.setSize(nrows,ncols);
+    return true;
+  }
   
   if ( nrows > theBuffer.rows() || 
        ncols > theBuffer.columns() ) 
@@ -125,6 +140,20 @@ void PixelThresholdClusterizer::clusterizeDetUnit( const edm::DetSet<PixelDigi>
     return;
   
   detid_ = input.detId();
+
+  if ( useBitmap ) {
+    copy_to_bitmap(begin, end);
+    for (auto const & seed : theSeeds) {
+      // seeds already included in clusters are marked as used
+      if ( theBitmap.test(seed) && theBitmap(seed) >= theSeedThreshold ) {
+	SiPixelCluster && cluster = make_cluster_bitmap( seed );
+	if ( cluster.charge() >= theClusterThreshold) output.push_back( std::move(cluster) );
+      }
+    }
+    theSeeds.clear();
+    clear_bitmap(begin, end);
+    return;
+  }
   
   //  Copy PixelDigis to the buffer array; select the seed pixels
   //  on the way, and store them in theSeeds.
@@ -178,18 +207,10 @@ void PixelThresholdClusterizer::clear_buffer( DigiIterator begin, DigiIterator e
 }
 
 //----------------------------------------------------------------------------
-//! \brief Copy adc counts from PixelDigis into the buffer, identify seeds.
+//! \brief Convert the adc counts of the PixelDigis to electrons.
 //----------------------------------------------------------------------------
-void PixelThresholdClusterizer::copy_to_buffer( DigiIterator begin, DigiIterator end ) 
+void PixelThresholdClusterizer::digis_to_electrons( DigiIterator begin, DigiIterator end, int * electron ) 
 {
-#ifdef PIXELREGRESSION
-  static std::atomic<int> s_ic=0;
-  in ic = ++s_ic;
-  if (ic==1) {
-    // std::cout << (doMissCalibrate ? "VI from db" : "VI linear") << std::endl;
-  }
-#endif
-  int electron[end-begin];
   if ( doMissCalibrate ) {
     (*theSiPixelGainCalibrationService_).calibrate(detid_,begin,end,theConversionFactor, theOffset,electron);
   } else {
@@ -213,6 +234,22 @@ void PixelThresholdClusterizer::copy_to_buffer( DigiIterator begin, DigiIterator
     }
     assert(i==(end-begin));
   }
+}
+
+//----------------------------------------------------------------------------
+//! \brief Copy adc counts from PixelDigis into the buffer, identify seeds.
+//----------------------------------------------------------------------------
+void PixelThresholdClusterizer::copy_to_buffer( DigiIterator begin, DigiIterator end ) 
+{
+#ifdef PIXELREGRESSION
+  static std::atomic<int> s_ic=0;
+  in ic = ++s_ic;
+  if (ic==1) {
+    // std::cout << (doMissCalibrate ? "VI from db" : "VI linear") << std::endl;
+  }
+#endif
+  int electron[end-begin];
+  digis_to_electrons(begin, end, electron);
 
   int i=0;
 #ifdef PIXELREGRESSION
@@ -236,6 +273,39 @@ void PixelThresholdClusterizer::copy_to_buffer( DigiIterator begin, DigiIterator
 
 }
 
+//----------------------------------------------------------------------------
+//! \brief Set the PixelDigis above threshold in the bitmap, identify seeds.
+//----------------------------------------------------------------------------
+void PixelThresholdClusterizer::copy_to_bitmap( DigiIterator begin, DigiIterator end ) 
+{
+  int electron[end-begin];
+  digis_to_electrons(begin, end, electron);
+
+  // the storage of the charges is indexed once all the pixels are set;
+  // a pixel repeated keeps the last charge above threshold, as in the buffer
+  int i=0;
+  for(DigiIterator di = begin; di != end; ++di, ++i) {
+    if ( electron[i] >= thePixelThreshold) theBitmap.set( di->row(), di->column());
+  }
+  theBitmap.makeIndex();
+  i=0;
+  for(DigiIterator di = begin; di != end; ++di, ++i) {
+    int adc = electron[i];
+    if ( adc >= thePixelThreshold) {
+      theBitmap.set_adc( di->row(), di->column(), adc);
+      if ( adc >= theSeedThreshold) theSeeds.push_back( SiPixelCluster::PixelPos(di->row(),di->column()) );
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+//! \brief Clear the columns of the bitmap used by the PixelDigis.
+//----------------------------------------------------------------------------
+void PixelThresholdClusterizer::clear_bitmap( DigiIterator begin, DigiIterator end ) 
+{
+  for(DigiIterator di = begin; di != end; ++di ) theBitmap.clear( di->column() );
+}
+
 //----------------------------------------------------------------------------
 // Calibrate adc counts to electrons
 //-----------------------------------------------------------------
@@ -470,3 +540,32 @@ PixelThresholdClusterizer::make_cluster( const SiPixelCluster::PixelPos& pix,
   return cluster;
 }
 
+
+//----------------------------------------------------------------------------
+//!  \brief The same clustering as make_cluster on the bitmap: the unused neighbours
+//!  in each column are taken at once from the bitmap, in the same order.
+//----------------------------------------------------------------------------
+SiPixelCluster 
+PixelThresholdClusterizer::make_cluster_bitmap( const SiPixelCluster::PixelPos& pix ) 
+{
+  AccretionCluster acluster;
+  acluster.add(pix, theBitmap(pix));
+  theBitmap.reset(pix);
+
+  while ( ! acluster.empty()) 
+    {
+      auto curInd = acluster.top(); acluster.pop();
+      int row = acluster.x[curInd];
+      for ( auto c = std::max(0,int(acluster.y[curInd])-1); c < std::min(int(acluster.y[curInd])+2,theBitmap.columns()) ; ++c) {
+	// rows row-1, row and row+1 (rows outside the module are never set)
+	for ( unsigned int n = theBitmap.neighbours(row,c); n!=0; n &= n-1 ) {
+	  int r = row - 1 + __builtin_ctz(n);
+	  SiPixelCluster::PixelPos newpix(r,c);
+	  if (!acluster.add( newpix, theBitmap(r,c))) goto endClus;
+	  theBitmap.reset( newpix );
+	}
+      }
+    }  // while accretion
+ endClus:
+  return SiPixelCluster(acluster.isize,acluster.adc, acluster.x,acluster.y, acluster.xmin,acluster.ymin);
+}
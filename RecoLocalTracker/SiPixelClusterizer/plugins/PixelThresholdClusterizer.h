@@ -46,6 +46,7 @@
 
 // The private pixel buffer
 #include "SiPixelArrayBuffer.h"
+#include "SiPixelOccupancyBitmap.h"
 
 // Parameter Set:
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
@@ -74,6 +75,8 @@ class dso_hidden PixelThresholdClusterizer final : public PixelClusterizerBase {
   //! Data storage
   SiPixelArrayBuffer               theBuffer;         // internal nrow * ncol matrix
   bool                             bufferAlreadySet;  // status of the buffer array
+  SiPixelOccupancyBitmap           theBitmap;         // used instead of theBuffer if useBitmap
+  bool                             useBitmap;
   std::vector<SiPixelCluster::PixelPos>  theSeeds;          // cached seed pixels
   std::vector<SiPixelCluster>            theClusters;       // resulting clusters  
   
@@ -97,10 +100,14 @@ class dso_hidden PixelThresholdClusterizer final : public PixelClusterizerBase {
   bool doSplitClusters;
   //! Private helper methods:
   bool setup(const PixelGeomDetUnit * pixDet);
+  void digis_to_electrons( DigiIterator begin, DigiIterator end, int * electron );
   void copy_to_buffer( DigiIterator begin, DigiIterator end );   
   void clear_buffer( DigiIterator begin, DigiIterator end );   
   SiPixelCluster make_cluster( const SiPixelCluster::PixelPos& pix, edmNew::DetSetVector<SiPixelCluster>::FastFiller& output
 );
+  void copy_to_bitmap( DigiIterator begin, DigiIterator end );
+  void clear_bitmap( DigiIterator begin, DigiIterator end );
+  SiPixelCluster make_cluster_bitmap( const SiPixelCluster::PixelPos& pix );
   // Calibrate the ADC charge to electrons 
   int calibrate(int adc, int col, int row);
   int   theStackADC_;          // The maximum ADC count for the stack layers
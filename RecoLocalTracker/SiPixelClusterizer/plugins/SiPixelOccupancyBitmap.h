@@ -0,0 +1,107 @@
+#ifndef RecoLocalTracker_SiPixelClusterizer_SiPixelOccupancyBitmap_H
+#define RecoLocalTracker_SiPixelClusterizer_SiPixelOccupancyBitmap_H
+
+//----------------------------------------------------------------------------
+//! \class SiPixelOccupancyBitmap
+//! \brief Occupancy bitmap and compact ADC storage of a module during clustering.
+//!
+//! Alternative to SiPixelArrayBuffer: one bit per pixel, stored by column,
+//! and the ADC of the pixels set only, in the order of the bitmap.
+//! The ADC of a pixel is found from its rank (the number of pixels set
+//! before it), from the offset of its word and a popcount.
+//! A second bitmap keeps the pixels not yet used by a cluster: the three
+//! unused neighbours of a pixel in a column are found with a shift.
+//!
+//! Usage for a module: setSize(), set() the pixels, makeIndex(), then
+//! set_adc() the pixels set; reset() the pixels as they are used;
+//! after the clustering clear() the columns used.
+//!
+//! The bits of a column start with one empty guard bit, for the row -1.
+//----------------------------------------------------------------------------
+
+// We use PixelPos which is an inner class of SiPixelCluster:
+#include "DataFormats/SiPixelCluster/interface/SiPixelCluster.h"
+
+#include <cstdint>
+#include <vector>
+
+
+class SiPixelOccupancyBitmap
+{
+ public:
+  typedef uint64_t word;
+  static constexpr int wordBits = 64;
+
+  SiPixelOccupancyBitmap() : nrows(0), ncols(0), nwords(0) {}
+
+  void setSize( int rows, int cols) {
+    nrows = rows;
+    ncols = cols;
+    nwords = (rows + 2 + wordBits - 1)/wordBits;  // guard bits at row -1 and row nrows
+    bits.assign(nwords*ncols, 0);
+    unused.assign(nwords*ncols, 0);
+    wordOffset.assign(nwords*ncols, 0);
+  }
+  int rows() const { return nrows;}
+  int columns() const { return ncols;}
+
+  void set( int row, int col) { int p = row+1; column(bits,col)[p/wordBits] |= word(1) << (p%wordBits);}
+
+  /// pixel set and not used yet
+  bool test( int row, int col) const { int p = row+1; return (column(unused,col)[p/wordBits] >> (p%wordBits)) & 1;}
+  bool test( const SiPixelCluster::PixelPos& pix) const { return test(pix.row(), pix.col());}
+  /// mark the pixel as used
+  void reset( int row, int col) { int p = row+1; column(unused,col)[p/wordBits] &= ~(word(1) << (p%wordBits));}
+  void reset( const SiPixelCluster::PixelPos& pix) { reset(pix.row(), pix.col());}
+
+  /// rows row-1, row and row+1 of column col set and not used, as bits 0, 1 and 2
+  unsigned int neighbours( int row, int col) const {
+    const word * w = column(unused,col);
+    int p = row;   // bit of row-1
+    word n = w[p/wordBits] >> (p%wordBits);
+    if (p%wordBits > wordBits-3) n |= w[p/wordBits+1] << (wordBits - p%wordBits);
+    return n & 7;
+  }
+
+  /// offsets of the words in the ADC storage, once all the pixels are set
+  void makeIndex() {
+    int n = 0;
+    for (int i=0, e=nwords*ncols; i!=e; ++i) {
+      wordOffset[i] = n;
+      n += __builtin_popcountll(bits[i]);
+      unused[i] = bits[i];
+    }
+    adcs.resize(n);
+  }
+
+  /// ADC of a pixel set
+  int operator()( int row, int col) const { return adcs[rank(row,col)];}
+  int operator()( const SiPixelCluster::PixelPos& pix) const { return (*this)(pix.row(), pix.col());}
+  void set_adc( int row, int col, int adc) { adcs[rank(row,col)] = adc;}
+
+  /// clear the bits of a column
+  void clear( int col) {
+    word * w = column(bits,col), * u = column(unused,col);
+    for (int i=0; i!=nwords; ++i) w[i] = u[i] = 0;
+  }
+
+ private:
+  word * column( std::vector<word>& b, int col) { return &b[col*nwords];}
+  const word * column( const std::vector<word>& b, int col) const { return &b[col*nwords];}
+
+  int rank( int row, int col) const {
+    int p = row+1;
+    int i = col*nwords + p/wordBits;
+    return wordOffset[i] + __builtin_popcountll(bits[i] & ((word(1) << (p%wordBits)) - 1));
+  }
+
+  std::vector<word> bits;       // pixels set, nwords per column
+  std::vector<word> unused;     // pixels set and not used by a cluster
+  std::vector<int>  wordOffset; // first ADC of each word
+  std::vector<int>  adcs;       // of the pixels set, by column and row
+  int nrows;
+  int ncols;
+  int nwords;
+};
+
+#endif
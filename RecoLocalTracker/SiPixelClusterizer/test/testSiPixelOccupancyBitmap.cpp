@@ -0,0 +1,57 @@
+// compare the SiPixelOccupancyBitmap of random modules with a dense array of the same pixels
+
+#include "RecoLocalTracker/SiPixelClusterizer/plugins/SiPixelOccupancyBitmap.h"
+
+#include <cassert>
+#include <random>
+#include <vector>
+
+int main() {
+
+  std::mt19937 rng(1234);
+  constexpr int nrows = 160, ncols = 416;
+
+  SiPixelOccupancyBitmap bitmap;
+  for (double occupancy : {0.002, 0.02, 0.1, 0.5}) {
+    std::bernoulli_distribution hit(occupancy);
+    std::uniform_int_distribution<int> charge(1, 50000);
+
+    std::vector<int> dense(nrows*ncols, 0);
+    for (auto & adc : dense) if (hit(rng)) adc = charge(rng);
+    auto adcOf = [&](int row, int col) { return (row<0 || row>=nrows) ? 0 : dense[col*nrows+row]; };
+
+    bitmap.setSize(nrows, ncols);
+    for (int col=0; col!=ncols; ++col)
+      for (int row=0; row!=nrows; ++row)
+        if (adcOf(row,col)) bitmap.set(row,col);
+    bitmap.makeIndex();
+    for (int col=0; col!=ncols; ++col)
+      for (int row=0; row!=nrows; ++row)
+        if (adcOf(row,col)) bitmap.set_adc(row,col,adcOf(row,col));
+
+    for (int col=0; col!=ncols; ++col)
+      for (int row=0; row!=nrows; ++row) {
+        assert(bitmap.test(row,col) == (adcOf(row,col)!=0));
+        if (adcOf(row,col)) assert(bitmap(row,col) == adcOf(row,col));
+        unsigned int n = (adcOf(row-1,col)!=0) | (adcOf(row,col)!=0) << 1 | (adcOf(row+1,col)!=0) << 2;
+        assert(bitmap.neighbours(row,col) == n);
+      }
+
+    // the used pixels are no longer seen, their ADC is kept
+    for (int col=0; col<ncols; col+=3)
+      for (int row=0; row!=nrows; ++row)
+        if (adcOf(row,col)) bitmap.reset(row,col);
+    for (int col=0; col!=ncols; ++col)
+      for (int row=0; row!=nrows; ++row) {
+        assert(bitmap.test(row,col) == (col%3!=0 && adcOf(row,col)!=0));
+        if (adcOf(row,col)) assert(bitmap(row,col) == adcOf(row,col));
+      }
+
+    for (int col=0; col!=ncols; ++col) bitmap.clear(col);
+    for (int col=0; col!=ncols; ++col)
+      for (int row=0; row!=nrows; ++row)
+        assert(!bitmap.test(row,col) && bitmap.neighbours(row,col)==0);
+  }
+
+  return 0;
+}
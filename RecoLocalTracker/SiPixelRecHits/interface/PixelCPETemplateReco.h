@@ -79,6 +79,12 @@ class PixelCPETemplateReco : public PixelCPEBase
 
   bool UseClusterSplitter_;
 
+  // Cache of the PixelTempReco2D results, for the hits reconstructed again
+  // with the same track angles (e.g. in the refits)
+  unsigned int templateCacheSize_;   // 0: no cache
+  float templateCacheAngleStep_;     // >0: the angles are rounded to this step
+  unsigned int templateCacheId_;     // distinguishes the CPEs in the cache
+
   //bool DoCosmics_;
   //bool LoadTemplatesFromDB_;
 
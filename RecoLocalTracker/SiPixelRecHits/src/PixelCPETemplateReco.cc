@@ -23,6 +23,9 @@
 #include <vector>
 #include "boost/multi_array.hpp"
 
+#include <atomic>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 
 using namespace SiPixelTemplateReco;
@@ -33,6 +36,37 @@ namespace {
   constexpr float micronsToCm = 1.0e-4;  
   constexpr int cluster_matrix_size_x = 13;
   constexpr int cluster_matrix_size_y = 21;
+
+  // The results of PixelTempReco2D for a cluster and track angles.
+  // The key holds all the inputs: the template store (through the CPE),
+  // the module, the angles and the pixels of the cluster, so that a hit
+  // can only be found again with the same inputs, in any event.
+  struct TemplateCacheEntry {
+    unsigned int cpe = 0;   // 0: empty
+    unsigned int detId;
+    float cotalpha, cotbeta;
+    int rowOffset, colOffset;
+    std::vector<uint8_t>  pixelOffset;
+    std::vector<uint16_t> pixelADC;
+
+    int ierr;
+    float yrec, sigmay, proby, xrec, sigmax, probx, probQ;
+    int qbin;
+    float lorxbias, lorybias;
+
+    bool matches(unsigned int icpe, unsigned int id, float ca, float cb, const SiPixelCluster & cl) const {
+      return cpe==icpe && detId==id && cotalpha==ca && cotbeta==cb &&
+	rowOffset==cl.minPixelRow() && colOffset==cl.minPixelCol() &&
+	pixelOffset==cl.pixelOffset() && pixelADC==cl.pixelADC();
+    }
+  };
+
+  // by thread, as the CPE is shared
+  thread_local std::vector<TemplateCacheEntry> templateCache;
+
+  std::atomic<unsigned int> templateCacheIds(0);
+
+  unsigned int bits(float x) { unsigned int i; std::memcpy(&i, &x, sizeof(i)); return i; }
 }
 
 //-----------------------------------------------------------------------------
@@ -88,6 +122,10 @@ PixelCPETemplateReco::PixelCPETemplateReco(edm::ParameterSet const & conf,
     "Template speed = " << speed_ << "\n";
   
   UseClusterSplitter_ = conf.getParameter<bool>("UseClusterSplitter");
+
+  templateCacheSize_ = conf.existsAs<int>("TemplateCacheSize") ? conf.getParameter<int>("TemplateCacheSize") : 0;
+  templateCacheAngleStep_ = conf.existsAs<double>("TemplateCacheAngleStep") ? conf.getParameter<double>("TemplateCacheAngleStep") : 0.;
+  templateCacheId_ = ++templateCacheIds;
   
 }
 
@@ -227,18 +265,90 @@ PixelCPETemplateReco::localPosition(DetParam const & theDetParam, ClusterParam &
 
  
   float locBz = theDetParam.bz;
-    
-  theClusterParam.ierr =
-    PixelTempReco2D( ID, theClusterParam.cotalpha, theClusterParam.cotbeta,
-		     locBz, 
-		     clust_array_2d, ydouble, xdouble,
-		     templ,
-		     theClusterParam.templYrec_, theClusterParam.templSigmaY_, theClusterParam.templProbY_,
-		     theClusterParam.templXrec_, theClusterParam.templSigmaX_, theClusterParam.templProbX_, 
-		     theClusterParam.templQbin_, 
-		     speed_,
-		     theClusterParam.templProbQ_
-		     );
+
+  // The splitter below needs the interpolated template: no cache with it
+  float cotalpha = theClusterParam.cotalpha;
+  float cotbeta = theClusterParam.cotbeta;
+  TemplateCacheEntry * cached = nullptr;
+  if ( templateCacheSize_ > 0 && !UseClusterSplitter_ )
+    {
+      if ( templateCacheAngleStep_ > 0 )
+	{
+	  cotalpha = templateCacheAngleStep_ * std::round( cotalpha/templateCacheAngleStep_ );
+	  cotbeta  = templateCacheAngleStep_ * std::round( cotbeta/templateCacheAngleStep_ );
+	}
+      if ( templateCache.size() < templateCacheSize_ ) templateCache.resize(templateCacheSize_);
+      unsigned int detId = theDetParam.theDet->geographicalId().rawId();
+      unsigned int h = detId ^ (row_offset << 16) ^ col_offset;
+      h = h*0x9E3779B1u ^ bits(cotalpha);
+      h = h*0x9E3779B1u ^ bits(cotbeta);
+      h = h*0x9E3779B1u ^ theClusterParam.theCluster->charge();
+      cached = &templateCache[(h ^ (h >> 15)) % templateCacheSize_];
+      if ( cached->matches(templateCacheId_, detId, cotalpha, cotbeta, *theClusterParam.theCluster) )
+	{
+	  theClusterParam.ierr = cached->ierr;
+	  theClusterParam.templYrec_ = cached->yrec;
+	  theClusterParam.templSigmaY_ = cached->sigmay;
+	  theClusterParam.templProbY_ = cached->proby;
+	  theClusterParam.templXrec_ = cached->xrec;
+	  theClusterParam.templSigmaX_ = cached->sigmax;
+	  theClusterParam.templProbX_ = cached->probx;
+	  theClusterParam.templQbin_ = cached->qbin;
+	  theClusterParam.templProbQ_ = cached->probQ;
+	}
+      else
+	{
+	  cached->cpe = 0;
+	  cached->detId = detId;
+	  cached->cotalpha = cotalpha;
+	  cached->cotbeta = cotbeta;
+	  cached->rowOffset = row_offset;
+	  cached->colOffset = col_offset;
+	  cached->pixelOffset = theClusterParam.theCluster->pixelOffset();
+	  cached->pixelADC = theClusterParam.theCluster->pixelADC();
+	}
+    }
+
+  if ( cached == nullptr || cached->cpe == 0 )
+    theClusterParam.ierr =
+      PixelTempReco2D( ID, cotalpha, cotbeta,
+		       locBz, 
+		       clust_array_2d, ydouble, xdouble,
+		       templ,
+		       theClusterParam.templYrec_, theClusterParam.templSigmaY_, theClusterParam.templProbY_,
+		       theClusterParam.templXrec_, theClusterParam.templSigmaX_, theClusterParam.templProbX_, 
+		       theClusterParam.templQbin_, 
+		       speed_,
+		       theClusterParam.templProbQ_
+		       );
+
+  // the Lorentz biases of the template are used below
+  float templLorxbias, templLorybias;
+  if ( cached != nullptr && cached->cpe != 0 )
+    {
+      templLorxbias = cached->lorxbias;
+      templLorybias = cached->lorybias;
+    }
+  else
+    {
+      templLorxbias = templ.lorxbias();
+      templLorybias = templ.lorybias();
+    }
+  if ( cached != nullptr && cached->cpe == 0 )
+    {
+      cached->ierr = theClusterParam.ierr;
+      cached->yrec = theClusterParam.templYrec_;
+      cached->sigmay = theClusterParam.templSigmaY_;
+      cached->proby = theClusterParam.templProbY_;
+      cached->xrec = theClusterParam.templXrec_;
+      cached->sigmax = theClusterParam.templSigmaX_;
+      cached->probx = theClusterParam.templProbX_;
+      cached->qbin = theClusterParam.templQbin_;
+      cached->probQ = theClusterParam.templProbQ_;
+      cached->lorxbias = templLorxbias;
+      cached->lorybias = templLorybias;
+      cached->cpe = templateCacheId_;
+    }
 
   // ******************************************************************
 
@@ -423,8 +533,8 @@ PixelCPETemplateReco::localPosition(DetParam const & theDetParam, ClusterParam &
 	  // correct this by iserting (-)
 	  //float temp1 = -micronsToCm*templ.lorxwidth();  // old
 	  //float temp2 = -micronsToCm*templ.lorywidth();  // does not incl 1/2
-	  float templateLorbiasCmX = -micronsToCm*templ.lorxbias();  // new 
-	  float templateLorbiasCmY = -micronsToCm*templ.lorybias(); //incl. 1/2
+	  float templateLorbiasCmX = -micronsToCm*templLorxbias;  // new 
+	  float templateLorbiasCmY = -micronsToCm*templLorybias; //incl. 1/2
 	  // now, correctly, we can use the difference of shifts  
 	  //theClusterParam.templXrec_ += 0.5*(theDetParam.lorentzShiftInCmX - templateLorbiasCmX);
 	  //theClusterParam.templYrec_ += 0.5*(theDetParam.lorentzShiftInCmY - templateLorbiasCmY);
@@ -12,6 +12,7 @@ class SiStripDigi;
 #include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
 #include "EventFilter/SiStripRawToDigi/interface/SiStripFEDBuffer.h"
 #include <limits>
+#include <vector>
 
 
 class FedChannelConnection;
@@ -51,19 +52,23 @@ class StripClusterizerAlgorithm {
 
  protected:
 
-  StripClusterizerAlgorithm() : qualityLabel(""), noise_cache_id(0), gain_cache_id(0), quality_cache_id(0) {}
+  StripClusterizerAlgorithm() : qualityLabel(""), denseConditions(false), noise_cache_id(0), gain_cache_id(0), quality_cache_id(0) {}
 
   uint32_t currentId() {return detId;}
   bool setDetId(const uint32_t);
-  float noise(const uint16_t& strip) const { return SiStripNoises::getNoise( strip, noiseRange ); }
+  float noise(const uint16_t& strip) const { return denseNoise ? denseNoise[strip] : SiStripNoises::getNoise( strip, noiseRange ); }
   float gain(const uint16_t& strip)  const { return SiStripGain::getStripGain( strip, gainRange ); }
-  bool bad(const uint16_t& strip)    const { return qualityHandle->IsStripBad( qualityRange, strip ); }
+  bool bad(const uint16_t& strip)    const {
+    return denseNoise ? (strip < denseStrips && denseBad[strip]) : qualityHandle->IsStripBad( qualityRange, strip );
+  }
   bool isModuleBad(const uint32_t& id)  const { return qualityHandle->IsModuleBad( id ); }
   bool isModuleUsable(const uint32_t& id)  const { return qualityHandle->IsModuleUsable( id ); }
   bool allBadBetween(uint16_t L, const uint16_t& R) const { while( ++L < R  &&  bad(L) ); return L == R; }
 
   std::string qualityLabel;
   bool _setDetId;
+  // keep the noise and bad strips of each module used in dense arrays until the conditions change
+  bool denseConditions;
 
  private:
 
@@ -75,6 +80,8 @@ class StripClusterizerAlgorithm {
     }	
   }
 
+  void fillDenseConditions();
+
   static constexpr unsigned short invalidI = std::numeric_limits<unsigned short>::max();
   struct Index { 
     unsigned short 
@@ -95,5 +102,15 @@ class StripClusterizerAlgorithm {
   uint32_t noise_cache_id, gain_cache_id, quality_cache_id, detId=0;
   unsigned short ind=invalidI;
 
+  // dense conditions: per det index the offset in the arrays (or invalid) and the number of strips,
+  // filled at the first use of the det in the IOV
+  static constexpr unsigned int invalidOffset = std::numeric_limits<unsigned int>::max();
+  std::vector<std::pair<unsigned int, uint16_t> > denseOffsets;
+  std::vector<float> denseNoises;
+  std::vector<uint8_t> denseBads;
+  const float * denseNoise = nullptr;      // of the current det, null if not used
+  const uint8_t * denseBad = nullptr;
+  uint16_t denseStrips = 0;
+
 };
 #endif
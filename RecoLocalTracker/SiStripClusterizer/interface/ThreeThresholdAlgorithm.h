@@ -45,7 +45,7 @@ class ThreeThresholdAlgorithm final : public StripClusterizerAlgorithm {
 
   template<class T> void clusterizeDetUnit_(const T&, output_t::FastFiller&);
   ThreeThresholdAlgorithm(float, float, float, unsigned, unsigned, unsigned, std::string qualityLabel,
-			  bool setDetId, bool removeApvShots, float minGoodCharge);
+			  bool setDetId, bool removeApvShots, float minGoodCharge, bool denseConditions=false);
 
   //state of the candidate cluster
   std::vector<uint8_t> ADCs;  
@@ -28,6 +28,7 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include <sstream>
 #include <memory>
+#include <atomic>
 
 #include "FWCore/Utilities/interface/GCC11Compatibility.h"
 
@@ -101,17 +102,30 @@ namespace {
   }
   
   
+  // counts of the modules and FEDs touched, per event and summed over the job
+  struct ClusterFillerStat {
+    std::atomic<long> events{0};
+    std::atomic<long> totDet{0};   // all dets
+    std::atomic<long> detReady{0}; // dets "updated"
+    std::atomic<long> detSet{0};   // det actually set not empty
+    std::atomic<long> detAct{0};   // det actually set with content
+    std::atomic<long> detNoZ{0};   // det actually set with clusters
+    std::atomic<long> fedUnpacked{0};
+  };
+
   class ClusterFiller final : public StripClusterizerAlgorithm::output_t::Getter {
   public:
     ClusterFiller(const FEDRawDataCollection& irawColl,
 		  StripClusterizerAlgorithm & iclusterizer,
 		  SiStripRawProcessingAlgorithms & irawAlgos,
-		  bool idoAPVEmulatorCheck):
+		  bool idoAPVEmulatorCheck,
+		  std::shared_ptr<ClusterFillerStat> itotal = std::shared_ptr<ClusterFillerStat>()):
       rawColl(irawColl),
       clusterizer(iclusterizer),
       rawAlgos(irawAlgos),
-      doAPVEmulatorCheck(idoAPVEmulatorCheck){
-	incTot(clusterizer.allDetIds().size());
+      doAPVEmulatorCheck(idoAPVEmulatorCheck),
+      total(itotal){
+	stat.totDet = clusterizer.allDetIds().size();
       }
     
     
@@ -135,37 +149,24 @@ namespace {
     // March 2012: add flag for disabling APVe check in configuration
     bool doAPVEmulatorCheck; 
     
-    
-#ifdef VIDEBUG
-    struct Stat {
-      int totDet=0; // all dets
-      int detReady=0; // dets "updated"
-      int detSet=0;  // det actually set not empty
-      int detAct=0;  // det actually set with content
-      int detNoZ=0;  // det actually set with content
-    };
-    
-    mutable Stat stat;
-    void zeroStat() const { stat = Stat(); }
-    void incTot(int n) const { stat.totDet=n;}
-    void incReady() const { stat.detReady++;}
-    void incSet() const { stat.detSet++;}
-    void incAct() const { stat.detAct++;}
-    void incNoZ() const { stat.detNoZ++;}
+    // the counts of this event, added to the total of the producer at the end of the event
+    // (when the on-demand collection releases the filler)
+    ClusterFillerStat stat;
+    std::shared_ptr<ClusterFillerStat> total;
+
     void printStat() const {
-      COUT << "VI clusters " << stat.totDet <<','<< stat.detReady <<','<< stat.detSet <<','<< stat.detAct<<','<< stat.detNoZ  << std::endl;
+      COUT << "clusters " << stat.totDet <<','<< stat.detReady <<','<< stat.detSet <<','<< stat.detAct<<','<< stat.detNoZ
+	   << " from " << stat.fedUnpacked << " FEDs" << std::endl;
+      if (!total) return;
+      ++total->events;
+      total->totDet += stat.totDet;
+      total->detReady += stat.detReady;
+      total->detSet += stat.detSet;
+      total->detAct += stat.detAct;
+      total->detNoZ += stat.detNoZ;
+      total->fedUnpacked += stat.fedUnpacked;
     }
     
-#else
-    static void zeroStat(){}
-    static void incTot(int){}
-    static void incReady() {}
-    static void incSet() {}
-    static void incAct() {}
-    static void incNoZ() {}
-    static void printStat(){}
-#endif
-    
   };
   
   
@@ -182,13 +183,24 @@ class SiStripClusterizerFromRaw final : public edm::stream::EDProducer<>  {
     cabling_(nullptr),
     clusterizer_(StripClusterizerAlgorithmFactory::create(conf.getParameter<edm::ParameterSet>("Clusterizer"))),
     rawAlgos_(SiStripRawProcessingFactory::create(conf.getParameter<edm::ParameterSet>("Algorithms"))),
-    doAPVEmulatorCheck_(conf.existsAs<bool>("DoAPVEmulatorCheck") ? conf.getParameter<bool>("DoAPVEmulatorCheck") : true)
+    doAPVEmulatorCheck_(conf.existsAs<bool>("DoAPVEmulatorCheck") ? conf.getParameter<bool>("DoAPVEmulatorCheck") : true),
+    stat_(std::make_shared<ClusterFillerStat>())
       {
 	productToken_ = consumes<FEDRawDataCollection>(conf.getParameter<edm::InputTag>("ProductLabel"));
 	produces< edmNew::DetSetVector<SiStripCluster> > ();
 	assert(clusterizer_.get());
 	assert(rawAlgos_.get());
       }
+
+  ~SiStripClusterizerFromRaw() {
+    long n = stat_->events;
+    if (n==0) return;
+    edm::LogInfo(sistrip::mlRawToCluster_)
+      << "[SiStripClusterizerFromRaw] " << (onDemand ? "on demand: " : "")
+      << "per event " << double(stat_->detReady)/n << " of " << double(stat_->totDet)/n << " modules touched, "
+      << double(stat_->detAct)/n << " clusterized, " << double(stat_->detNoZ)/n << " with clusters, "
+      << double(stat_->fedUnpacked)/n << " FEDs unpacked, over " << n << " events";
+  }
   
 
   void beginRun( const edm::Run&, const edm::EventSetup& es) {
@@ -208,7 +220,7 @@ class SiStripClusterizerFromRaw final : public edm::stream::EDProducer<>  {
     std::auto_ptr< edmNew::DetSetVector<SiStripCluster> > 
       output( onDemand ?
 	      new edmNew::DetSetVector<SiStripCluster>(std::shared_ptr<edmNew::DetSetVector<SiStripCluster>::Getter>(std::make_shared<ClusterFiller>(*rawData, *clusterizer_, 
-																	 *rawAlgos_, doAPVEmulatorCheck_)
+																	 *rawAlgos_, doAPVEmulatorCheck_, stat_)
 														       ), 
 						       clusterizer_->allDetIds())
 	      : new edmNew::DetSetVector<SiStripCluster>());
@@ -253,6 +265,9 @@ private:
   // March 2012: add flag for disabling APVe check in configuration
   bool doAPVEmulatorCheck_; 
 
+  // modules touched, summed over the events (shared with the on-demand fillers, that may outlive an event)
+  std::shared_ptr<ClusterFillerStat> stat_;
+
 };
 
 #include "FWCore/Framework/interface/MakerMacros.h"
@@ -272,7 +287,7 @@ void SiStripClusterizerFromRaw::initialize(const edm::EventSetup& es) {
 void SiStripClusterizerFromRaw::run(const FEDRawDataCollection& rawColl,
 				     edmNew::DetSetVector<SiStripCluster> & output) {
   
-  ClusterFiller filler(rawColl, *clusterizer_, *rawAlgos_, doAPVEmulatorCheck_);
+  ClusterFiller filler(rawColl, *clusterizer_, *rawAlgos_, doAPVEmulatorCheck_, stat_);
   
   // loop over good det in cabling
   for ( auto idet : clusterizer_->allDetIds()) {
@@ -288,7 +303,7 @@ void SiStripClusterizerFromRaw::run(const FEDRawDataCollection& rawColl,
 
 void ClusterFiller::fill(StripClusterizerAlgorithm::output_t::FastFiller & record) {
 
-  incReady();
+  ++stat.detReady;
 
   auto idet= record.id();
 
@@ -296,7 +311,7 @@ void ClusterFiller::fill(StripClusterizerAlgorithm::output_t::FastFiller & recor
 
   if (!clusterizer.stripByStripBegin(idet)) { return; }
  
-  incSet();
+  ++stat.detSet;
 
   // Loop over apv-pairs of det
   for (auto const conn : clusterizer.currentConnection()) {
@@ -309,7 +324,7 @@ void ClusterFiller::fill(StripClusterizerAlgorithm::output_t::FastFiller & recor
     
 
     // If Fed hasnt already been initialised, extract data and initialise
-    if (!done[fedId]) { buffers[fedId].reset(fillBuffer(fedId, rawColl)); done[fedId]=true;}
+    if (!done[fedId]) { buffers[fedId].reset(fillBuffer(fedId, rawColl)); done[fedId]=true; ++stat.fedUnpacked;}
     auto buffer = buffers[fedId].get();
     if unlikely(!buffer) continue;
     
@@ -440,8 +455,8 @@ void ClusterFiller::fill(StripClusterizerAlgorithm::output_t::FastFiller & recor
   } // end loop over conn
   
   clusterizer.stripByStripEnd(record);
-  incAct();
-  if(!record.empty()) incNoZ();
+  ++stat.detAct;
+  if(!record.empty()) ++stat.detNoZ;
 
   // COUT << "filled " << record.size() << std::endl;
   
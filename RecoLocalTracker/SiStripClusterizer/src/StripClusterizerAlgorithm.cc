@@ -57,6 +57,11 @@ initialize(const edm::EventSetup& es) {
     indices.resize(detIds.size());
     COUT << "good detIds " << detIds.size() << std::endl;
 
+    denseOffsets.assign(denseConditions ? detIds.size() : 0, std::make_pair(invalidOffset, uint16_t(0)));
+    denseNoises.clear();
+    denseBads.clear();
+    denseNoise = nullptr; denseBad = nullptr; denseStrips = 0;
+
     if (0==detIds.size()) {
        ind=0; detId=0; return;
     }
@@ -136,8 +141,31 @@ initialize(const edm::EventSetup& es) {
   noiseRange = noiseHandle->getRangeByPos(indices[ind].ni);
   gainRange = gainHandle->getRangeByPos(indices[ind].gi);
   qualityRange = qualityHandle->getRangeByPos(indices[ind].qi);
+  if (denseConditions) fillDenseConditions();
   
 }
+
+void StripClusterizerAlgorithm::
+fillDenseConditions() {
+  auto & dense = denseOffsets[ind];
+  if (dense.first==invalidOffset) {
+    // decode the noise strip by strip and unroll the bad strip ranges once,
+    // instead of at each noise() and bad() call
+    unsigned int nStrips = (noiseRange.second-noiseRange.first)*8/9;
+    unsigned int offset = denseNoises.size();
+    dense = std::make_pair(offset, uint16_t(nStrips));
+    denseNoises.resize(offset+nStrips);
+    denseBads.resize(offset+nStrips, 0);
+    for (auto s=0U; s<nStrips; ++s) denseNoises[offset+s] = SiStripNoises::getNoise(s, noiseRange);
+    for (auto it=qualityRange.first; it!=qualityRange.second; ++it) {
+      auto fs = qualityHandle->decode(*it);
+      for (unsigned int s=fs.firstStrip; s<std::min(nStrips, (unsigned int)(fs.firstStrip+fs.range)); ++s) denseBads[offset+s] = 1;
+    }
+  }
+  denseNoise = denseNoises.data() + dense.first;
+  denseBad = denseBads.data() + dense.first;
+  denseStrips = dense.second;
+}
   
 
 bool StripClusterizerAlgorithm::
@@ -174,6 +202,7 @@ setDetId(const uint32_t id) {
   noiseRange = noiseHandle->getRangeByPos(indices[ind].ni);
   gainRange = gainHandle->getRangeByPos(indices[ind].gi);
   qualityRange = qualityHandle->getRangeByPos(indices[ind].qi);
+  if (denseConditions) fillDenseConditions();
 
 #ifdef EDM_ML_DEBUG
   assert(detIds[ind]==detId); 
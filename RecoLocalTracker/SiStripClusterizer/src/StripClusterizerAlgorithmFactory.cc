@@ -25,7 +25,8 @@ create(const edm::ParameterSet& conf) {
 	       conf.getParameter<std::string>("QualityLabel"),
 	       setDetId,
 	       conf.getParameter<bool>("RemoveApvShots"),
-               clusterChargeCut(conf)
+               clusterChargeCut(conf),
+	       conf.existsAs<bool>("DenseConditions") ? conf.getParameter<bool>("DenseConditions") : false
            ));
   }
 
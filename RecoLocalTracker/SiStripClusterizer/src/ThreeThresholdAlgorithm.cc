@@ -9,10 +9,11 @@
 
 ThreeThresholdAlgorithm::
 ThreeThresholdAlgorithm(float chan, float seed, float cluster, unsigned holes, unsigned bad, unsigned adj, std::string qL, 
-			bool setDetId, bool removeApvShots, float minGoodCharge) 
+			bool setDetId, bool removeApvShots, float minGoodCharge, bool dense) 
   : ChannelThreshold( chan ), SeedThreshold( seed ), ClusterThresholdSquared( cluster*cluster ),
     MaxSequentialHoles( holes ), MaxSequentialBad( bad ), MaxAdjacentBad( adj ), RemoveApvShots(removeApvShots), minGoodCharge(minGoodCharge) {
   _setDetId=setDetId;
+  denseConditions=dense;
   qualityLabel = (qL);
   ADCs.reserve(128);
 
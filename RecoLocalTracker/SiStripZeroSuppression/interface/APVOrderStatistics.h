@@ -0,0 +1,98 @@
+#ifndef RECOLOCALTRACKER_SISTRIPZEROSUPPRESSION_APVORDERSTATISTICS_H
+#define RECOLOCALTRACKER_SISTRIPZEROSUPPRESSION_APVORDERSTATISTICS_H
+
+/** Order statistics of the 128 strips of an APV by bisection on the value.
+ *
+ *  The k-th smallest value is the smallest x with more than k strips <= x:
+ *  it is found by bisection between the minimum and the maximum of the APV,
+ *  each step counting the strips <= x in a loop without branches that the
+ *  compiler vectorizes, instead of the data dependent partitions of
+ *  std::nth_element. The values are compared as integer keys, ordered as
+ *  the values also for floats.
+ *  Strips to be ignored are set to the largest value of T, so that the
+ *  order statistics of the n kept strips are unchanged.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace apvOrderStatistics {
+
+  constexpr int nStrips = 128;
+
+  inline int32_t key(int16_t x) { return x; }
+  inline int16_t value(int32_t k, int16_t) { return k; }
+
+  inline int32_t key(float x) {
+    int32_t i; std::memcpy(&i, &x, sizeof(i));
+    return i ^ ((i >> 31) & 0x7fffffff);   // negative floats in reverse order
+  }
+  inline float value(int32_t k, float) {
+    int32_t i = k ^ ((k >> 31) & 0x7fffffff);
+    float x; std::memcpy(&x, &i, sizeof(x));
+    return x;
+  }
+
+  /// the value used for the strips to be ignored
+  template<typename T>
+  constexpr T ignored() { return std::numeric_limits<T>::max(); }
+
+  class APV {
+  public:
+    template<typename T>
+    explicit APV(const T * v) : lo_(key(v[0])), hi_(lo_) {
+      for (int i=0; i<nStrips; ++i) {
+	keys_[i] = key(v[i]);
+	lo_ = std::min(lo_, keys_[i]);
+	hi_ = std::max(hi_, keys_[i]);
+      }
+    }
+
+    /// number of strips <= k
+    int count(int32_t k) const {
+      int c = 0;
+      for (int i=0; i<nStrips; ++i) c += keys_[i] <= k;
+      return c;
+    }
+
+    /// key of the k-th smallest value, k from 0
+    int32_t select(int k) const {
+      int32_t lo = lo_, hi = hi_;
+      while (lo < hi) {
+	int32_t mid = lo + int32_t((int64_t(hi) - lo) >> 1);
+	if (count(mid) > k) hi = mid; else lo = mid+1;
+      }
+      return lo;
+    }
+
+    /// key of the smallest value greater than k
+    int32_t next(int32_t k) const {
+      int32_t n = std::numeric_limits<int32_t>::max();
+      for (int i=0; i<nStrips; ++i) n = std::min(n, keys_[i] > k ? keys_[i] : std::numeric_limits<int32_t>::max());
+      return n;
+    }
+
+  private:
+    int32_t keys_[nStrips];
+    int32_t lo_, hi_;
+  };
+
+  /// k-th smallest value of the APV
+  template<typename T>
+  inline T select(const T * v, int k) { return value(APV(v).select(k), T()); }
+
+  /// median of the n smallest values of the APV, as SiStripCommonModeNoiseSubtractor::median
+  template<typename T>
+  inline float median(const T * v, int n = nStrips) {
+    APV apv(v);
+    int32_t a = apv.select((n-1)/2);
+    if (n & 1) return value(a, T());
+    int32_t b = apv.count(a) > n/2 ? a : apv.next(a);
+    return ( value(a, T()) + value(b, T()) ) / 2.;
+  }
+
+}
+
+#endif
@@ -23,13 +23,17 @@ class IteratedMedianCMNSubtractor : public SiStripCommonModeNoiseSubtractor {
   template<typename T >void subtract_(const uint32_t&, const uint16_t&, std::vector<T>&);
 inline float pairMedian( std::vector<std::pair<float,float> >& sample);
  
-  IteratedMedianCMNSubtractor(double sigma, int iterations) : 
+  template<typename T >void subtractBisection_(const uint32_t&, const uint16_t&, std::vector<T>&);
+ 
+  IteratedMedianCMNSubtractor(double sigma, int iterations, bool bisection=false) : 
     cut_to_avoid_signal_(sigma),
     iterations_(iterations),
+    bisection_(bisection),
     noise_cache_id(0),
     quality_cache_id(0) {};
   double cut_to_avoid_signal_;
   int iterations_;
+  bool bisection_;   // medians by bisection on the APV (see APVOrderStatistics.h) instead of nth_element
   edm::ESHandle<SiStripNoises> noiseHandle;
   edm::ESHandle<SiStripQuality> qualityHandle;
   uint32_t noise_cache_id, quality_cache_id;
@@ -14,7 +14,8 @@ class MedianCMNSubtractor : public SiStripCommonModeNoiseSubtractor {
  private:
   
   template<typename T> void subtract_(const uint32_t&,const uint16_t&,std::vector<T>&);
-  MedianCMNSubtractor(){};
+  MedianCMNSubtractor(bool bisection=false) : bisection_(bisection) {};
+  bool bisection_;   // median by bisection on the APV (see APVOrderStatistics.h) instead of nth_element
   
 };
 #endif
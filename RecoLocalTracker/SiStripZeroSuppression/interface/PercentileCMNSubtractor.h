@@ -15,9 +15,10 @@ class PercentileCMNSubtractor : public SiStripCommonModeNoiseSubtractor {
   
   template<typename T> float percentile(std::vector<T>&, double);
   template<typename T> void subtract_(const uint32_t&,const uint16_t& firstAPV, std::vector<T>&);
-  PercentileCMNSubtractor(double in) : 
-    percentile_(in) {};  
+  PercentileCMNSubtractor(double in, bool bisection=false) : 
+    percentile_(in), bisection_(bisection) {};  
   double percentile_;
+  bool bisection_;   // percentile by bisection on the APV (see APVOrderStatistics.h) instead of nth_element
   
 };
 #endif
@@ -1,4 +1,5 @@
 #include "RecoLocalTracker/SiStripZeroSuppression/interface/IteratedMedianCMNSubtractor.h"
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/APVOrderStatistics.h"
 
 #include "CondFormats/SiStripObjects/interface/SiStripNoises.h"
 #include "CalibFormats/SiStripObjects/interface/SiStripQuality.h"
@@ -20,8 +21,12 @@ void IteratedMedianCMNSubtractor::init(const edm::EventSetup& es){
   }
 }
 
-void IteratedMedianCMNSubtractor::subtract(const uint32_t& detId, const uint16_t& firstAPV, std::vector<int16_t>& digis){ subtract_(detId, firstAPV, digis);}
-void IteratedMedianCMNSubtractor::subtract(const uint32_t& detId, const uint16_t& firstAPV, std::vector<float>& digis){ subtract_(detId,firstAPV, digis);}
+void IteratedMedianCMNSubtractor::subtract(const uint32_t& detId, const uint16_t& firstAPV, std::vector<int16_t>& digis){
+  if (bisection_) subtractBisection_(detId, firstAPV, digis); else subtract_(detId, firstAPV, digis);
+}
+void IteratedMedianCMNSubtractor::subtract(const uint32_t& detId, const uint16_t& firstAPV, std::vector<float>& digis){
+  if (bisection_) subtractBisection_(detId, firstAPV, digis); else subtract_(detId,firstAPV, digis);
+}
 
 template<typename T>
 inline
@@ -86,6 +91,59 @@ subtract_(const uint32_t& detId, const uint16_t& firstAPV, std::vector<T>& digis
 }
 
 
+// Same as subtract_, with the medians found by bisection on the whole APV:
+// the bad strips and the strips over threshold are set aside as the largest values.
+template<typename T>
+inline
+void IteratedMedianCMNSubtractor::
+subtractBisection_(const uint32_t& detId, const uint16_t& firstAPV, std::vector<T>& digis){
+
+  using namespace apvOrderStatistics;
+
+  SiStripNoises::Range detNoiseRange = noiseHandle->getRange(detId);
+  SiStripQuality::Range detQualityRange = qualityHandle->getRange(detId);
+
+  float offset = 0;
+  float adcs[nStrips], noises[nStrips], subset[nStrips];
+  bool kept[nStrips];
+
+  _vmedians.clear(); 
+  
+  uint16_t APV=firstAPV;
+  for( ; APV< digis.size()/128+firstAPV; ++APV)
+  {
+    T * apv = &digis[(APV-firstAPV)*128];
+    int n = 0;
+    for (int i=0; i<nStrips; ++i) {
+      uint16_t istrip = APV*128+i;
+      kept[i] = !qualityHandle->IsStripBad(detQualityRange,istrip);
+      adcs[i] = apv[i];
+      noises[i] = noiseHandle->getNoiseFast(istrip,detNoiseRange);
+      n += kept[i];
+    }
+
+    for ( int ii = 0; ii<std::max(iterations_,1) && n!=0; ++ii )
+    {
+      if (ii>0) {
+	// remove strips over threshold and recalculate offset on remaining strips
+	n = 0;
+	for (int i=0; i<nStrips; ++i) {
+	  kept[i] = kept[i] && !(adcs[i]-offset > cut_to_avoid_signal_*noises[i]);
+	  n += kept[i];
+	}
+	if (n==0) break;
+      }
+      for (int i=0; i<nStrips; ++i) subset[i] = kept[i] ? adcs[i] : ignored<float>();
+      offset = median(subset,n);
+    }
+
+    _vmedians.push_back(std::pair<short,float>(APV,offset));
+    
+    // remove offset
+    for (int i=0; i<nStrips; ++i) apv[i] = static_cast<T>(apv[i]-offset);
+  }
+}
+
 
 inline float IteratedMedianCMNSubtractor::pairMedian( std::vector<std::pair<float,float> >& sample) {
   std::vector<std::pair<float,float> >::iterator mid = sample.begin() + sample.size()/2;
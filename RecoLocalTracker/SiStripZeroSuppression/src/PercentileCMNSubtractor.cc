@@ -1,4 +1,5 @@
 #include "RecoLocalTracker/SiStripZeroSuppression/interface/PercentileCMNSubtractor.h"
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/APVOrderStatistics.h"
 
 void PercentileCMNSubtractor::subtract(const uint32_t& detId, const uint16_t& firstAPV, std::vector<int16_t>& digis) {subtract_(detId, firstAPV, digis);}
 void PercentileCMNSubtractor::subtract(const uint32_t& detId, const uint16_t& firstAPV, std::vector<float>& digis) {subtract_(detId,firstAPV, digis);}
@@ -17,9 +18,15 @@ subtract_(const uint32_t& detId,const uint16_t& firstAPV, std::vector<T>& digis)
   _vmedians.clear();
 
   while( strip < end ) {
-    endAPV = strip+128; tmp.clear();
-    tmp.insert(tmp.end(),strip,endAPV);
-    const float offset = percentile(tmp,percentile_);
+    endAPV = strip+128;
+    float offset;
+    if (bisection_) {
+      offset = apvOrderStatistics::select(&*strip,int(apvOrderStatistics::nStrips*percentile_/100.0));
+    } else {
+      tmp.clear();
+      tmp.insert(tmp.end(),strip,endAPV);
+      offset = percentile(tmp,percentile_);
+    }
 
     _vmedians.push_back(std::pair<short,float>((strip-digis.begin())/128+firstAPV,offset));
 
@@ -382,17 +382,20 @@ bool inline SiStripAPVRestorer::FlatRegionsFinder(const std::vector<int16_t>& ad
   
    
   //============================= Height above local minimum ===============================                    
-  std::vector<float> adcsLocalMinSubtracted;
-  adcsLocalMinSubtracted.clear();
-  adcsLocalMinSubtracted.insert(adcsLocalMinSubtracted.begin(), 128,0);
-  for(uint32_t istrip=0; istrip<128; ++istrip) {
-    float localmin = 999.9;		
-    for(uint16_t jstrip=std::max(0,(int)(istrip-nSmooth_/2)); jstrip<std::min(128,(int)(istrip+nSmooth_/2)); ++jstrip) {
-      float nextvalue = adcs[jstrip];
-      if(nextvalue < localmin) localmin=nextvalue;			
-    }
-    adcsLocalMinSubtracted[istrip] = adcs[istrip] - localmin;
+  // minimum over the strips [istrip-nSmooth_/2, istrip+nSmooth_/2) within the APV:
+  // loop on the offsets outside, so that the loop on the strips vectorizes,
+  // with the APV padded on both sides by the starting value of the minimum
+  const int halfSmooth = nSmooth_/2;
+  std::vector<float> padded(128+2*halfSmooth, 999.9f);
+  for(uint32_t istrip=0; istrip<128; ++istrip) padded[halfSmooth+istrip] = adcs[istrip];
+  float localmin[128];
+  std::fill(localmin, localmin+128, 999.9f);
+  for(int offset=-halfSmooth; offset<halfSmooth; ++offset) {
+    const float * next = &padded[halfSmooth+offset];
+    for(uint32_t istrip=0; istrip<128; ++istrip) localmin[istrip] = std::min(localmin[istrip], next[istrip]);
   }
+  std::vector<float> adcsLocalMinSubtracted(128,0);
+  for(uint32_t istrip=0; istrip<128; ++istrip) adcsLocalMinSubtracted[istrip] = adcs[istrip] - localmin[istrip];
   
   
   //============================= Find regions with stable slopes ========================
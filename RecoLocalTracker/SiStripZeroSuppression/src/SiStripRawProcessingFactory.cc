@@ -42,19 +42,22 @@ create_SubtractorPed(const edm::ParameterSet& conf) {
 std::auto_ptr<SiStripCommonModeNoiseSubtractor> SiStripRawProcessingFactory::
 create_SubtractorCMN(const edm::ParameterSet& conf) {
   std::string mode = conf.getParameter<std::string>("CommonModeNoiseSubtractionMode");
+  // medians and percentiles by bisection on the APV instead of nth_element
+  bool bisection = conf.existsAs<bool>("CommonModeNoiseBisection") ?
+    conf.getParameter<bool>("CommonModeNoiseBisection") : false;
 
   if ( mode == "Median")
-    return std::auto_ptr<SiStripCommonModeNoiseSubtractor>( new MedianCMNSubtractor() );
+    return std::auto_ptr<SiStripCommonModeNoiseSubtractor>( new MedianCMNSubtractor(bisection) );
 
   if ( mode == "Percentile") {
     double percentile = conf.getParameter<double>("Percentile");
-    return std::auto_ptr<SiStripCommonModeNoiseSubtractor>( new PercentileCMNSubtractor(percentile) );
+    return std::auto_ptr<SiStripCommonModeNoiseSubtractor>( new PercentileCMNSubtractor(percentile,bisection) );
   }
 
   if ( mode == "IteratedMedian") {
     double cutToAvoidSignal = conf.getParameter<double>("CutToAvoidSignal");
     int iterations = conf.getParameter<int>("Iterations");
-    return std::auto_ptr<SiStripCommonModeNoiseSubtractor>( new IteratedMedianCMNSubtractor(cutToAvoidSignal,iterations) );
+    return std::auto_ptr<SiStripCommonModeNoiseSubtractor>( new IteratedMedianCMNSubtractor(cutToAvoidSignal,iterations,bisection) );
   }
 
   if ( mode == "FastLinear")
@@ -0,0 +1,73 @@
+// Regression test of the order statistics by bisection of the common mode
+// subtractors: the median, the percentiles and the median of a subset of the
+// strips of an APV must be the ones found with std::nth_element, as in
+// SiStripCommonModeNoiseSubtractor::median, PercentileCMNSubtractor and
+// IteratedMedianCMNSubtractor.
+
+#include "RecoLocalTracker/SiStripZeroSuppression/interface/APVOrderStatistics.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+  template<typename T>
+  float medianRef(std::vector<T> sample) {
+    typename std::vector<T>::iterator mid = sample.begin() + sample.size()/2;
+    std::nth_element(sample.begin(), mid, sample.end());
+    if( sample.size() & 1 ) return *mid;
+    return ( *std::max_element(sample.begin(), mid) + *mid ) / 2.;
+  }
+
+  template<typename T>
+  float percentileRef(std::vector<T> sample, double pct) {
+    typename std::vector<T>::iterator mid = sample.begin() + int(sample.size()*pct/100.0);
+    std::nth_element(sample.begin(), mid, sample.end());
+    return *mid;
+  }
+
+  // an APV of virgin raw data after pedestal subtraction: a common mode, noise and a few hits
+  template<typename T>
+  std::vector<T> apv(std::mt19937 & gen, float cmShift) {
+    std::normal_distribution<float> cm(cmShift, 20.f), noise(0.f, 4.f);
+    std::uniform_int_distribution<int> hits(0, 10), strip(0, 127), adc(20, 600);
+    float common = cm(gen);
+    std::vector<T> v(apvOrderStatistics::nStrips);
+    for (auto & x : v) x = T(common + noise(gen));
+    for (int h = hits(gen); h!=0; --h) v[strip(gen)] += T(adc(gen));
+    return v;
+  }
+
+  template<typename T>
+  int check(const char * name, int nAPVs) {
+    using namespace apvOrderStatistics;
+    std::mt19937 gen(1234);
+    std::bernoulli_distribution bad(0.1);
+    int failures = 0;
+    for (int a=0; a!=nAPVs; ++a) {
+      // common modes around 128 (after pedestal subtraction) and around 0 (after the median)
+      std::vector<T> v = apv<T>(gen, a%2 ? 128.f : 0.f);
+      if (median(v.data()) != medianRef(v)) ++failures;
+      for (double pct : {5., 25., 50., 90.})
+	if (select(v.data(), int(nStrips*pct/100.0)) != percentileRef(v, pct)) ++failures;
+
+      // median of the good strips, the others set aside as the largest values
+      std::vector<T> subset, masked(v);
+      for (int i=0; i!=nStrips; ++i) {
+	if (bad(gen)) masked[i] = ignored<T>(); else subset.push_back(v[i]);
+      }
+      if (!subset.empty() && median(masked.data(), subset.size()) != medianRef(subset)) ++failures;
+    }
+    std::cout << name << ": " << failures << " failures in " << nAPVs << " APVs" << std::endl;
+    return failures;
+  }
+
+}
+
+int main() {
+  int failures = check<int16_t>("int16_t", 10000) + check<float>("float", 10000);
+  return failures==0 ? 0 : 1;
+}
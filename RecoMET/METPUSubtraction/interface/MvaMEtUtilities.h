@@ -80,6 +80,8 @@ class MvaMEtUtilities
   CommonMETData computeCandSum( int compKey, double dZmax, int dZflag,
 				bool iCharged,  bool mvaPassFlag,
 				const std::vector<reco::PUSubMETCandInfo>& objects );
+  void computePFCandSums( double dZmax, const std::vector<reco::PUSubMETCandInfo>& pfCandidates );
+  void computeJetSums( const std::vector<reco::PUSubMETCandInfo>& jets );
 
 
   void finalize(CommonMETData& metData);
@@ -191,6 +191,68 @@ MvaMEtUtilities::computeCandSum( int compKey, double dZmax, int dZflag,
   return retVal;
 }
 
+// same sums as computeCandSum with the dZflag 2, 0 and 1 respectively,
+// in a single loop over the candidates
+void
+MvaMEtUtilities::computePFCandSums( double dZmax,
+				    const std::vector<reco::PUSubMETCandInfo>& pfCandidates ) {
+
+  CommonMETData* sums[3] = { &pfCandSum_, &pfCandChHSSum_, &pfCandChPUSum_ };
+  for ( CommonMETData* sum : sums ) {
+    sum->mex   = 0.;
+    sum->mey   = 0.;
+    sum->sumet = 0.;
+  }
+
+  for ( std::vector<reco::PUSubMETCandInfo>::const_iterator pfCandidate = pfCandidates.begin();
+	pfCandidate != pfCandidates.end(); ++pfCandidate ) {
+    const double px = pfCandidate->p4().px();
+    const double py = pfCandidate->p4().py();
+    const double pt = pfCandidate->p4().pt();
+    const double dZ = pfCandidate->dZ();
+
+    pfCandSum_.mex   += px;
+    pfCandSum_.mey   += py;
+    pfCandSum_.sumet += pt;
+    if ( dZ < 0. ) continue;
+    if ( !(dZ > dZmax) ) {
+      pfCandChHSSum_.mex   += px;
+      pfCandChHSSum_.mey   += py;
+      pfCandChHSSum_.sumet += pt;
+    }
+    if ( !(dZ < dZmax) ) {
+      pfCandChPUSum_.mex   += px;
+      pfCandChPUSum_.mey   += py;
+      pfCandChPUSum_.sumet += pt;
+    }
+  }
+
+  for ( CommonMETData* sum : sums ) finalize(*sum);
+}
+
+// same sums as computeCandSum with the mvaPassFlag true and false,
+// the jet Id is evaluated once per jet
+void
+MvaMEtUtilities::computeJetSums( const std::vector<reco::PUSubMETCandInfo>& jets ) {
+
+  CommonMETData* sums[2] = { &neutralJetHSSum_, &neutralJetPUSum_ };
+  for ( CommonMETData* sum : sums ) {
+    sum->mex   = 0.;
+    sum->mey   = 0.;
+    sum->sumet = 0.;
+  }
+
+  for ( std::vector<reco::PUSubMETCandInfo>::const_iterator jet = jets.begin();
+	jet != jets.end(); ++jet ) {
+    CommonMETData& sum = passesMVA(jet->p4(), jet->mva()) ? neutralJetHSSum_ : neutralJetPUSum_;
+    const double pFrac = 1-jet->chargedEnFrac();//neutral energy fraction
+    sum.mex   += jet->p4().px()*pFrac;
+    sum.mey   += jet->p4().py()*pFrac;
+    sum.sumet += jet->p4().pt()*pFrac;
+  }
+
+  for ( CommonMETData* sum : sums ) finalize(*sum);
+}
 
 CommonMETData
 MvaMEtUtilities::computeRecoil(int metType) {
@@ -249,11 +311,8 @@ MvaMEtUtilities::computeAllSums(const std::vector<reco::PUSubMETCandInfo>& jets,
 
   leptonsSum_ = computeCandSum( kLeptons, 0., 0, false , false, leptons );
   leptonsChSum_ = computeCandSum( kLeptons, 0., 0, true , false, leptons);
-  pfCandSum_ = computeCandSum( kPFCands, dzCut_, 2, false , false, pfCandidates);
-  pfCandChHSSum_ = computeCandSum( kPFCands, dzCut_, 0, false , false, pfCandidates);
-  pfCandChPUSum_ = computeCandSum( kPFCands, dzCut_, 1, false , false, pfCandidates);
-  neutralJetHSSum_ = computeCandSum( kJets, 0., 0, false , true, jets );
-  neutralJetPUSum_ = computeCandSum( kJets, 0., 0, false , false, jets );
+  computePFCandSums( dzCut_, pfCandidates );
+  computeJetSums( jets );
 
 }
 
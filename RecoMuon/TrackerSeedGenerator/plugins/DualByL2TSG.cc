@@ -9,41 +9,50 @@
 #include "DataFormats/MuonSeed/interface/L3MuonTrajectorySeedCollection.h"
 #include "RecoMuon/TrackerSeedGenerator/interface/TrackerSeedGenerator.h"
 
+#include <algorithm>
+
 DualByL2TSG::DualByL2TSG(const edm::ParameterSet &pset,edm::ConsumesCollector& iC ) : SeparatingTSG(pset,iC){  theCategory ="DualByL2TSG";
   theL3CollectionLabelA = pset.getParameter<edm::InputTag>("L3TkCollectionA");
   if (nTSGs()!=2)
     {edm::LogError(theCategory)<<"not two seed generators provided";}
 
+  theL3MaxNormalizedChi2 = pset.existsAs<double>("L3TkMaxNormalizedChi2") ? pset.getParameter<double>("L3TkMaxNormalizedChi2") : -1.;
+  theL3MinValidTrackerHits = pset.existsAs<int>("L3TkMinValidTrackerHits") ? pset.getParameter<int>("L3TkMinValidTrackerHits") : 0;
+
   l3muonToken = iC.consumes<reco::TrackCollection>(theL3CollectionLabelA); 
 }
 
-unsigned int DualByL2TSG::selectTSG(const TrackCand & muonTrackCand, const TrackingRegion& region)
+void DualByL2TSG::setEvent(const edm::Event &event)
 {
-  LogDebug(theCategory)<<"|eta|=|"<<muonTrackCand.second->eta()<<"|";
+  SeparatingTSG::setEvent(event);
+
+  //retrieve L3 track collection, once for all the L2 tracks of the event
+  theL2WithL3.clear();
+  event.getByToken(l3muonToken ,l3muonH);
+  if(l3muonH.failedToGet()) return;
 
-  bool re_do_this_L2 = true;
-  //LogDebug("TrackerSeedGenerator")<<theEvent;
-  //getEvent();
-  
-  //retrieve L3 track collection
-  edm::Handle<reco::TrackCollection> l3muonH;
-  getEvent()->getByToken(l3muonToken ,l3muonH);
-  if(l3muonH.failedToGet()) return 0;
-  
   unsigned int maxI = l3muonH->size();
-  
   LogDebug(theCategory) << "TheCollectionA size " << maxI;
 
-  // Loop through all tracks, if the track was seeded from this L2, then skip
   for (unsigned int i=0;i!=maxI;++i){
     reco::TrackRef tk(l3muonH,i);
+    if (theL3MaxNormalizedChi2 >= 0 && tk->normalizedChi2() > theL3MaxNormalizedChi2) continue;
+    if (tk->hitPattern().numberOfValidTrackerHits() < theL3MinValidTrackerHits) continue;
     edm::Ref<L3MuonTrajectorySeedCollection> l3seedRef = tk->seedRef().castTo<edm::Ref<L3MuonTrajectorySeedCollection> >();
-    reco::TrackRef staTrack = l3seedRef->l2Track();
-
-    if(staTrack == (muonTrackCand.second) ) re_do_this_L2 = false;
-    //LogDebug(theCategory) << "The DualByL2TSG selectTSG loop " << re_do_this_L2 << " staCand " << muonTrackCand.second->eta() << " " << muonTrackCand.second->pt() << " alreadyMadeRefToL3 " << staTrack->eta() << " " << staTrack->pt();
+    theL2WithL3.push_back(l3seedRef->l2Track());
   }
-  
+  std::sort(theL2WithL3.begin(), theL2WithL3.end());
+}
+
+unsigned int DualByL2TSG::selectTSG(const TrackCand & muonTrackCand, const TrackingRegion& region)
+{
+  LogDebug(theCategory)<<"|eta|=|"<<muonTrackCand.second->eta()<<"|";
+
+  if(l3muonH.failedToGet()) return 0;
+
+  // if a good track was seeded from this L2, then skip
+  bool re_do_this_L2 = !std::binary_search(theL2WithL3.begin(), theL2WithL3.end(), muonTrackCand.second);
+
   LogDebug(theCategory) << "The DualByL2TSG to use " << re_do_this_L2 ;
 
   return re_do_this_L2 ? 1 : 0;
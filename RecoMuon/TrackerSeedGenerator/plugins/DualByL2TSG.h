@@ -15,6 +15,8 @@
 #include "DataFormats/TrackReco/interface/TrackFwd.h"
 #include "FWCore/Framework/interface/ConsumesCollector.h"
 
+#include <vector>
+
 class DualByL2TSG : public SeparatingTSG{
  public:
   DualByL2TSG(const edm::ParameterSet &pset, edm::ConsumesCollector& iC);
@@ -23,11 +25,19 @@ class DualByL2TSG : public SeparatingTSG{
   /// decide the TSG depending on the existence of a L3 track seeded from the L2. Return value is 0 or 1.
   unsigned int selectTSG(const TrackCand&, const TrackingRegion&);
 
+  /// set the event and find the L2 tracks which already lead to a good L3 track
+  void setEvent(const edm::Event &event);
+
  private:
   std::string theCategory;
   edm::InputTag theL3CollectionLabelA;
   edm::Handle<reco::TrackCollection> l3muonH;
   edm::EDGetTokenT<reco::TrackCollection> l3muonToken;
+  // an L3 track of the collection A is good if it passes these cuts (none by default)
+  double theL3MaxNormalizedChi2;
+  int theL3MinValidTrackerHits;
+  // the L2 tracks of the good L3 tracks of the event, sorted
+  std::vector<reco::TrackRef> theL2WithL3;
 };
 
 #endif
@@ -13,6 +13,7 @@
 #include "DataFormats/ParticleFlowReco/interface/PFRecHit.h"
 #include "RecoParticleFlow/PFClusterTools/interface/PFEnergyCalibration.h"
 #include "DataFormats/EcalRecHit/interface/EcalRecHitCollections.h"
+#include "CondFormats/EgammaObjects/interface/FlatGBRForest.h"
 
 class PFClusterEMEnergyCorrector {
  public:
@@ -40,6 +41,12 @@ class PFClusterEMEnergyCorrector {
   std::vector<std::string> _condnames_mean_25ns;
   std::vector<std::string> _condnames_sigma_25ns;  
   
+  // the forests of the current IOV and bunch spacing, flattened
+  std::vector<FlatGBRForestD> _flatForests_mean;
+  std::vector<FlatGBRForestD> _flatForests_sigma;
+  unsigned long long _flatForestsCacheId;
+  int _flatForestsBunchSpacing;
+  
    std::unique_ptr<PFEnergyCalibration> _calibrator;
   
 };
@@ -123,10 +123,10 @@ class PFHFRecHitCreator :  public  PFRecHitCreatorBase {
 	}
 	  
 	if(keep) {
-	  tmpOut.push_back(rh);
+	  tmpOut.push_back(std::move(rh));
 	}
 	else if (rcleaned) 
-	  cleaned->push_back(rh);
+	  cleaned->push_back(std::move(rh));
       }
       //Sort by DetID the collection
       DetIDSorter sorter;
@@ -149,12 +149,11 @@ class PFHFRecHitCreator :  public  PFRecHitCreatorBase {
 	  lONG=hit.energy();
 	  //find the short hit
 	  HcalDetId shortID (HcalForward, detid.ieta(), detid.iphi(), 2);
-	  const reco::PFRecHit temp(shortID,PFLayer::NONE,0.0,math::XYZPoint(0,0,0),math::XYZVector(0,0,0),std::vector<math::XYZPoint>());
 	  auto found_hit = std::lower_bound(tmpOut.begin(),tmpOut.end(),
-					    temp,
+					    shortID.rawId(),
 					    [](const reco::PFRecHit& a, 
-					       const reco::PFRecHit& b){
-					      return a.detId() < b.detId();
+					       unsigned b){
+					      return a.detId() < b;
 					    });
 	  if( found_hit != tmpOut.end() && found_hit->detId() == shortID.rawId() ) {
 	    sHORT = found_hit->energy();
@@ -167,7 +166,7 @@ class PFHFRecHitCreator :  public  PFRecHitCreatorBase {
 	    if (!( lONG > longFibre_Cut && 
 		   ( sHORT/lONG < shortFibre_Fraction)))
 	      if (energy>thresh_HF_)
-		out->push_back(newHit);
+		out->push_back(std::move(newHit));
 	  }
 	  else
 	    {
@@ -178,7 +177,7 @@ class PFHFRecHitCreator :  public  PFRecHitCreatorBase {
 	      newHit.setEnergy(energy);
 
 	      if (energy>thresh_HF_)
-		out->push_back(newHit);
+		out->push_back(std::move(newHit));
 
 	    }
 
@@ -186,12 +185,11 @@ class PFHFRecHitCreator :  public  PFRecHitCreatorBase {
 	else {
 	  sHORT=hit.energy();
 	  HcalDetId longID (HcalForward, detid.ieta(), detid.iphi(), 1);
-	  const reco::PFRecHit temp(longID,PFLayer::NONE,0.0,math::XYZPoint(0,0,0),math::XYZVector(0,0,0),std::vector<math::XYZPoint>());
 	  auto found_hit = std::lower_bound(tmpOut.begin(),tmpOut.end(),
-					    temp,
+					    longID.rawId(),
 					    [](const reco::PFRecHit& a, 
-					       const reco::PFRecHit& b){
-					      return a.detId() < b.detId();
+					       unsigned b){
+					      return a.detId() < b;
 					    });
 	  double energy = 2*sHORT;
 	  if( found_hit != tmpOut.end() && found_hit->detId() == longID.rawId() ) {
@@ -209,7 +207,7 @@ class PFHFRecHitCreator :  public  PFRecHitCreatorBase {
 	    if (!( sHORT > shortFibre_Cut && 
 		   ( lONG/sHORT < longFibre_Fraction)))
 	      if (energy>thresh_HF_)
-		out->push_back(newHit);
+		out->push_back(std::move(newHit));
 
 	  }
 	  else {
@@ -218,7 +216,7 @@ class PFHFRecHitCreator :  public  PFRecHitCreatorBase {
 	      energy*=HFCalib_;
 	    newHit.setEnergy(energy);
 	      if (energy>thresh_HF_)
-		out->push_back(newHit);
+		out->push_back(std::move(newHit));
 	  }
 	}
 
@@ -107,10 +107,10 @@ template <typename Digi, typename Geometry,PFLayer::Layer Layer,int Detector>
 	}
 	  
 	if(keep) {
-	  out->push_back(rh);
+	  out->push_back(std::move(rh));
 	}
 	else if (rcleaned) 
-	  cleaned->push_back(rh);
+	  cleaned->push_back(std::move(rh));
       }
     }
 
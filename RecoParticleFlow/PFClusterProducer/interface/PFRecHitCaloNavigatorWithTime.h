@@ -119,13 +119,11 @@ class PFRecHitCaloNavigatorWithTime : public PFRecHitNavigatorBase {
   void associateNeighbour(const DetId& id, reco::PFRecHit& hit,std::auto_ptr<reco::PFRecHitCollection>& hits,edm::RefProd<reco::PFRecHitCollection>& refProd,short eta, short phi) {
     double sigma2=10000.0;
     
-    const reco::PFRecHit temp(id,PFLayer::NONE,0.0,math::XYZPoint(0,0,0),math::XYZVector(0,0,0),std::vector<math::XYZPoint>());
-
     auto found_hit = std::lower_bound(hits->begin(),hits->end(),
-				      temp,
+				      id.rawId(),
 				      [](const reco::PFRecHit& a, 
-					 const reco::PFRecHit& b){
-					return a.detId() < b.detId();
+					 unsigned b){
+					return a.detId() < b;
 				      });
 
 
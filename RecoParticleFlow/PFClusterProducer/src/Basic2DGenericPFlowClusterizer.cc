@@ -82,12 +82,14 @@ buildClusters(const reco::PFClusterCollection& input,
 	      const std::vector<bool>& seedable,
 	      reco::PFClusterCollection& output) {
   reco::PFClusterCollection clustersInTopo;
+  TopoCells cells;
   for( const auto& topocluster : input ) {
     clustersInTopo.clear();
     seedPFClustersFromTopo(topocluster,seedable,clustersInTopo);
     const unsigned tolScal = 
       std::pow(std::max(1.0,clustersInTopo.size()-1.0),2.0);
-    growPFClusters(topocluster,seedable,tolScal,0,tolScal,clustersInTopo);
+    fillTopoCells(topocluster,seedable,cells);
+    growPFClusters(topocluster,cells,tolScal,0,tolScal,clustersInTopo);
     // step added by Josh Bendavid, removes low-fraction clusters
     // did not impact position resolution with fraction cut of 1e-7
     // decreases the size of each pf cluster considerably
@@ -128,9 +130,33 @@ seedPFClustersFromTopo(const reco::PFCluster& topo,
   }
 }
 
+void Basic2DGenericPFlowClusterizer::
+fillTopoCells(const reco::PFCluster& topo,
+	      const std::vector<bool>& seedable,
+	      TopoCells& cells) const {
+  const auto& recHitFractions = topo.recHitFractions();
+  cells.clear();
+  cells.reserve(recHitFractions.size());
+  for( const reco::PFRecHitFraction& rhf : recHitFractions ) {
+    const reco::PFRecHitRef& refhit = rhf.recHitRef();
+    int cell_layer = (int)refhit->layer();
+    if( cell_layer == PFLayer::HCAL_BARREL2 && 
+	std::abs(refhit->positionREP().eta()) > 0.34 ) {
+      cell_layer *= 100;
+    }  
+    const math::XYZPoint& topocellpos_xyz = refhit->position();
+    cells.x.push_back(topocellpos_xyz.x());
+    cells.y.push_back(topocellpos_xyz.y());
+    cells.z.push_back(topocellpos_xyz.z());
+    cells.recHitEnergyNorm.push_back(_recHitEnergyNorms.find(cell_layer)->second);
+    cells.detId.push_back(refhit->detId());
+    cells.seedable.push_back(seedable[refhit.key()]);
+  }
+}
+
 void Basic2DGenericPFlowClusterizer::
 growPFClusters(const reco::PFCluster& topo,
-	       const std::vector<bool>& seedable,
+	       const TopoCells& cells,
 	       const unsigned toleranceScaling,
 	       const unsigned iter,
 	       double diff,
@@ -156,46 +182,59 @@ growPFClusters(const reco::PFCluster& topo,
     }
     cluster.resetHitsAndFractions();
   }
+  // the cluster positions and energies do not change while the rechits
+  // are shared: keep them in arrays for the distance computation
+  const unsigned nclusters = clusters.size();
+  std::vector<double> clus_x(nclusters), clus_y(nclusters), clus_z(nclusters);
+  std::vector<double> clus_e(nclusters);
+  std::vector<unsigned> clus_seed(nclusters);
+  for( unsigned i = 0; i < nclusters; ++i ) {
+    const math::XYZPoint& clusterpos_xyz = clusters[i].position();
+    clus_x[i] = clusterpos_xyz.x();
+    clus_y[i] = clusterpos_xyz.y();
+    clus_z[i] = clusterpos_xyz.z();
+    clus_e[i] = clusters[i].energy();
+    clus_seed[i] = clusters[i].seed().rawId();
+  }
   // loop over topo cluster and grow current PFCluster hypothesis 
-  std::vector<double> dist2, frac;
+  std::vector<double> dist2(nclusters), frac(nclusters);
   double fractot = 0, fraction = 0;
-  for( const reco::PFRecHitFraction& rhf : topo.recHitFractions() ) {
-    const reco::PFRecHitRef& refhit = rhf.recHitRef();
-    int cell_layer = (int)refhit->layer();
-    if( cell_layer == PFLayer::HCAL_BARREL2 && 
-	std::abs(refhit->positionREP().eta()) > 0.34 ) {
-      cell_layer *= 100;
-    }  
-    const double recHitEnergyNorm = 
-      _recHitEnergyNorms.find(cell_layer)->second; 
-    const math::XYZPoint& topocellpos_xyz = refhit->position();
-    dist2.clear(); frac.clear(); fractot = 0;
+  const auto& recHitFractions = topo.recHitFractions();
+  for( unsigned k = 0; k < recHitFractions.size(); ++k ) {
+    const reco::PFRecHitRef& refhit = recHitFractions[k].recHitRef();
+    const double recHitEnergyNorm = cells.recHitEnergyNorm[k];
+    const unsigned detId = cells.detId[k];
+    const bool seedable = cells.seedable[k];
+    // distances of the rechit to the clusters
+    for( unsigned i = 0; i < nclusters; ++i ) {
+      const double dx = clus_x[i] - cells.x[k];
+      const double dy = clus_y[i] - cells.y[k];
+      const double dz = clus_z[i] - cells.z[k];
+      dist2[i] = (dx*dx + dy*dy + dz*dz)/_showerSigma2;
+    }
+    fractot = 0;
     // add rechits to clusters, calculating fraction based on distance
-    for( auto& cluster : clusters ) {      
-      const math::XYZPoint& clusterpos_xyz = cluster.position();
-      fraction = 0.0;
-      const math::XYZVector deltav = clusterpos_xyz - topocellpos_xyz;
-      const double d2 = deltav.Mag2()/_showerSigma2;
-      dist2.emplace_back( d2 );
+    for( unsigned i = 0; i < nclusters; ++i ) {
+      const double d2 = dist2[i];
       if( d2 > 100 ) {
 	LOGDRESSED("Basic2DGenericPFlowClusterizer:growAndStabilizePFClusters")
 	  << "Warning! :: pfcluster-topocell distance is too large! d= "
 	  << d2;
       }
       // fraction assignment logic
-      if( refhit->detId() == cluster.seed() && _excludeOtherSeeds ) {
+      if( detId == clus_seed[i] && _excludeOtherSeeds ) {
 	fraction = 1.0;	
-      } else if ( seedable[refhit.key()] && _excludeOtherSeeds ) {
+      } else if ( seedable && _excludeOtherSeeds ) {
 	fraction = 0.0;
       } else {
-	fraction = cluster.energy()/recHitEnergyNorm * vdt::fast_expf( -0.5*d2 );
+	fraction = clus_e[i]/recHitEnergyNorm * vdt::fast_expf( -0.5*d2 );
       }      
       fractot += fraction;
-      frac.emplace_back(fraction);
+      frac[i] = fraction;
     }
-    for( unsigned i = 0; i < clusters.size(); ++i ) {      
+    for( unsigned i = 0; i < nclusters; ++i ) {      
       if( fractot > _minFracTot || 
-	  ( refhit->detId() == clusters[i].seed() && fractot > 0.0 ) ) {
+	  ( detId == clus_seed[i] && fractot > 0.0 ) ) {
 	frac[i]/=fractot;
       } else {
 	continue;
@@ -234,7 +273,7 @@ growPFClusters(const reco::PFCluster& topo,
   }
   diff = std::sqrt(diff2);
   dist2.clear(); frac.clear(); clus_prev_pos.clear();// avoid badness
-  growPFClusters(topo,seedable,toleranceScaling,iter+1,diff,clusters);
+  growPFClusters(topo,cells,toleranceScaling,iter+1,diff,clusters);
 }
 
 void Basic2DGenericPFlowClusterizer::
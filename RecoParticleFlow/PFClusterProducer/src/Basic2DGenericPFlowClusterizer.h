@@ -26,6 +26,22 @@ class Basic2DGenericPFlowClusterizer : public PFClusterBuilderBase {
 		     reco::PFClusterCollection& outclus);
 
  private:  
+  // the rechits of a topocluster, which do not change during the fit
+  struct TopoCells {
+    std::vector<double> x, y, z;
+    std::vector<double> recHitEnergyNorm;
+    std::vector<unsigned> detId;
+    std::vector<bool> seedable;
+    void clear() {
+      x.clear(); y.clear(); z.clear(); 
+      recHitEnergyNorm.clear(); detId.clear(); seedable.clear();
+    }
+    void reserve(unsigned n) {
+      x.reserve(n); y.reserve(n); z.reserve(n);
+      recHitEnergyNorm.reserve(n); detId.reserve(n); seedable.reserve(n);
+    }
+  };
+
   const unsigned _maxIterations;
   const double _stoppingTolerance;
   const double _showerSigma2;
@@ -40,8 +56,12 @@ class Basic2DGenericPFlowClusterizer : public PFClusterBuilderBase {
 			      const std::vector<bool>&,
 			      reco::PFClusterCollection&) const;
 
+  void fillTopoCells(const reco::PFCluster&,
+		     const std::vector<bool>&,
+		     TopoCells&) const;
+
   void growPFClusters(const reco::PFCluster&,
-		      const std::vector<bool>&,
+		      const TopoCells&,
 		      const unsigned toleranceScaling,
 		      const unsigned iter,
 		      double dist,
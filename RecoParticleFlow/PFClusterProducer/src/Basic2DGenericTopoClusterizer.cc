@@ -42,49 +42,71 @@ buildClusters(const edm::Handle<reco::PFRecHitCollection>& input,
     const int seed = idx_e.first;
     if( !rechitMask[seed] || !seedable[seed] || used[seed] ) continue;    
     temp.reset();
-    buildTopoCluster(input,rechitMask,makeRefhit(input,seed),used,temp);
+    buildTopoCluster(input,rechitMask,seed,used,temp);
     if( temp.recHitFractions().size() ) output.push_back(temp);
   }
 }
 
-void Basic2DGenericTopoClusterizer::
-buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
-		 const std::vector<bool>& rechitMask,
-		 const reco::PFRecHitRef& cell,
-		 std::vector<bool>& used,		 
-		 reco::PFCluster& topocluster) {
-  int cell_layer = (int)cell->layer();
+bool Basic2DGenericTopoClusterizer::
+passesThresholds(const reco::PFRecHit& cell) const {
+  int cell_layer = (int)cell.layer();
   if( cell_layer == PFLayer::HCAL_BARREL2 && 
-      std::abs(cell->positionREP().eta()) > 0.34 ) {
+      std::abs(cell.positionREP().eta()) > 0.34 ) {
       cell_layer *= 100;
     }    
   const std::pair<double,double>& thresholds =
       _thresholds.find(cell_layer)->second;
-  if( cell->energy() < thresholds.first || 
-      cell->pt2() < thresholds.second ) {
+  if( cell.energy() < thresholds.first || 
+      cell.pt2() < thresholds.second ) {
     LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
-      << "RecHit " << cell->detId() << " with enegy " 
-      << cell->energy() << " GeV was rejected!." << std::endl;
-    return;
+      << "RecHit " << cell.detId() << " with enegy " 
+      << cell.energy() << " GeV was rejected!." << std::endl;
+    return false;
   }
+  return true;
+}
 
-  used[cell.key()] = true;
-  topocluster.addRecHitFraction(reco::PFRecHitFraction(cell, 1.0));
-  
-  const reco::PFRecHitRefVector& neighbours = 
-    ( _useCornerCells ? cell->neighbours8() : cell->neighbours4() );
-  
-  for( const reco::PFRecHitRef nb : neighbours ) {
-    if( used[nb.key()] || !rechitMask[nb.key()] ) {
+// Depth-first growth of the topocluster from the seed, in the order of the 
+// neighbour lists, with an explicit stack of (rechit, next neighbour) and the
+// keys of the neighbours instead of the rechit references.
+void Basic2DGenericTopoClusterizer::
+buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>& input,
+		 const std::vector<bool>& rechitMask,
+		 const unsigned seed,
+		 std::vector<bool>& used,		 
+		 reco::PFCluster& topocluster) {
+  const reco::PFRecHitCollection& hits = *input;
+  if( !passesThresholds(hits[seed]) ) return;
+
+  used[seed] = true;
+  topocluster.addRecHitFraction(reco::PFRecHitFraction(makeRefhit(input,seed), 1.0));
+  _stack.clear();
+  _stack.emplace_back(seed,0);
+
+  while( !_stack.empty() ) {
+    const unsigned cell = _stack.back().first;
+    const std::vector<unsigned>& neighbours = 
+      ( _useCornerCells ? hits[cell].neighbours8() : hits[cell].neighbours4() ).refVector().keys();
+    const unsigned inb = _stack.back().second;
+    if( inb == neighbours.size() ) {
+      _stack.pop_back();
+      continue;
+    }
+    ++_stack.back().second;
+    const unsigned nb = neighbours[inb];
+    if( used[nb] || !rechitMask[nb] ) {
       LOGDRESSED("GenericTopoCluster::buildTopoCluster()")
-      	<< "  RecHit " << cell->detId() << "\'s" 
-	<< " neighbor RecHit " << input->at(nb.key()).detId() 
+      	<< "  RecHit " << hits[cell].detId() << "\'s" 
+	<< " neighbor RecHit " << hits[nb].detId() 
 	<< " with enegy " 
-	<< input->at(nb.key()).energy() << " GeV was rejected!" 
-	<< " Reasons : " << used[nb.key()] << " (used) " 
-	<< !rechitMask[nb.key()] << " (masked)." << std::endl;
+	<< hits[nb].energy() << " GeV was rejected!" 
+	<< " Reasons : " << used[nb] << " (used) " 
+	<< !rechitMask[nb] << " (masked)." << std::endl;
       continue;
     }
-    buildTopoCluster(input,rechitMask,nb,used,topocluster);
+    if( !passesThresholds(hits[nb]) ) continue;
+    used[nb] = true;
+    topocluster.addRecHitFraction(reco::PFRecHitFraction(makeRefhit(input,nb), 1.0));
+    _stack.emplace_back(nb,0);
   }
 }
@@ -21,9 +21,11 @@ class Basic2DGenericTopoClusterizer : public InitialClusteringStepBase {
   
  private:  
   const bool _useCornerCells;
+  std::vector<std::pair<unsigned,unsigned> > _stack; // (rechit, next neighbour)
+  bool passesThresholds(const reco::PFRecHit&) const;
   void buildTopoCluster(const edm::Handle<reco::PFRecHitCollection>&,
 			const std::vector<bool>&, // masked rechits
-			const reco::PFRecHitRef&, //present rechit
+			const unsigned, // seed rechit
 			std::vector<bool>&, // hit usage state
 			reco::PFCluster&); // the topocluster
   
@@ -3,6 +3,7 @@
 #include "RecoEcal/EgammaCoreTools/interface/EcalClusterLazyTools.h"
 #include "CondFormats/DataRecord/interface/GBRDWrapperRcd.h"
 #include "CondFormats/EgammaObjects/interface/GBRForestD.h"
+#include "CondFormats/EgammaObjects/interface/FlatGBRForest.h"
 #include "vdt/vdtMath.h"
 #include <array>
 
@@ -14,6 +15,8 @@ namespace {
 }
 
 PFClusterEMEnergyCorrector::PFClusterEMEnergyCorrector(const edm::ParameterSet& conf, edm::ConsumesCollector &&cc) :
+  _flatForestsCacheId(0),
+  _flatForestsBunchSpacing(0),
   _calibrator(new PFEnergyCalibration) {
 
    _applyCrackCorrections = conf.getParameter<bool>("applyCrackCorrections");
@@ -145,8 +148,25 @@ void PFClusterEMEnergyCorrector::correctEnergies(const edm::Event &evt, const ed
     es.get<GBRDWrapperRcd>().get(condnames_mean[icor],forestH_mean[icor]);
     es.get<GBRDWrapperRcd>().get(condnames_sigma[icor],forestH_sigma[icor]);
   }
+
+  //flattened forests, to evaluate all the clusters of a correction at once
+  const unsigned long long cacheId = es.get<GBRDWrapperRcd>().cacheIdentifier();
+  if (cacheId != _flatForestsCacheId || bunchspacing != _flatForestsBunchSpacing) {
+    _flatForests_mean.clear();
+    _flatForests_sigma.clear();
+    for (unsigned int icor=0; icor<ncor; ++icor) {
+      _flatForests_mean.emplace_back(*forestH_mean[icor].product());
+      _flatForests_sigma.emplace_back(*forestH_sigma[icor].product());
+    }
+    _flatForestsCacheId = cacheId;
+    _flatForestsBunchSpacing = bunchspacing;
+  }
   
-  std::array<float,11> eval;
+  const unsigned int nvars = 11;
+  std::array<float,nvars> eval;
+  // the variables of the clusters, grouped by correction
+  std::vector<std::vector<float> > evals(ncor);
+  std::vector<std::vector<unsigned int> > clusterIndices(ncor);
     
   EcalClusterLazyTools lazyTool(evt, es, _recHitsEB, _recHitsEE);
 
@@ -192,9 +212,6 @@ void PFClusterEMEnergyCorrector::correctEnergies(const edm::Event &evt, const ed
       coridx += 3;
     }
     
-    const GBRForestD &meanforest = *forestH_mean[coridx].product();
-    const GBRForestD &sigmaforest = *forestH_sigma[coridx].product();
-    
     double e1x3    = lazyTool.e1x3(cluster);
     double e2x2    = lazyTool.e2x2(cluster);
     double e2x5max = lazyTool.e2x5Max(cluster);    
@@ -258,17 +275,33 @@ void PFClusterEMEnergyCorrector::correctEnergies(const edm::Event &evt, const ed
       }
     }
     
-    //these are the actual BDT responses
-    double rawmean = meanforest.GetResponse(eval.data());
-    double rawsigma = sigmaforest.GetResponse(eval.data());
+    evals[coridx].insert(evals[coridx].end(),eval.begin(),eval.end());
+    clusterIndices[coridx].push_back(idx);
     
-    //apply transformation to limited output range (matching the training)
-    double mean = meanoffset + meanscale*vdt::fast_sin(rawmean);
-    double sigma = sigmaoffset + sigmascale*vdt::fast_sin(rawsigma);
+  }
+  
+  std::vector<double> rawmeans, rawsigmas;
+  for (unsigned int icor=0; icor<ncor; ++icor) {
+    const unsigned int nclus = clusterIndices[icor].size();
+    if (nclus==0) continue;
     
-    cluster.setCorrectedEnergy(mean*e);
-    cluster.setCorrectedEnergyUncertainty(sigma*e);
+    //these are the actual BDT responses
+    rawmeans.resize(nclus);
+    rawsigmas.resize(nclus);
+    _flatForests_mean[icor].GetResponses(evals[icor].data(),nvars,nclus,rawmeans.data());
+    _flatForests_sigma[icor].GetResponses(evals[icor].data(),nvars,nclus,rawsigmas.data());
     
+    for (unsigned int i=0; i<nclus; ++i) {
+      reco::PFCluster &cluster = cs[clusterIndices[icor][i]];
+      double e = cluster.energy();
+      
+      //apply transformation to limited output range (matching the training)
+      double mean = meanoffset + meanscale*vdt::fast_sin(rawmeans[i]);
+      double sigma = sigmaoffset + sigmascale*vdt::fast_sin(rawsigmas[i]);
+      
+      cluster.setCorrectedEnergy(mean*e);
+      cluster.setCorrectedEnergyUncertainty(sigma*e);
+    }
   }
   
 }
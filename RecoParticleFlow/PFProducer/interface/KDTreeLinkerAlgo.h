@@ -24,16 +24,16 @@ class KDTreeLinkerAlgo
   void search(const KDTreeBox			&searchBox,
 	      std::vector<KDTreeNodeInfo>	&resRecHitList);
   
-  // This method clears all allocated structures.
+  // This method clears the tree. The node pool is kept for the next build.
   void clear();
   
  private:
   // The KDTree root
   KDTreeNode*	root_;
   
-  // The node pool allow us to do just 1 call to new for each tree building.
-  KDTreeNode*	nodePool_;
-  int		nodePoolSize_;
+  // The node pool keeps all the nodes contiguous, each node followed by its left subtree,
+  // and is reused from one tree building to the next.
+  std::vector<KDTreeNode>	nodePool_;
   int		nodePoolPos_;
 
  private:
@@ -2,6 +2,7 @@
 #define RecoParticleFlow_PFProducer_PFAlgo_h 
 
 #include <iostream>
+#include <mutex>
 
 
 // #include "FWCore/Framework/interface/Handle.h"
@@ -65,6 +66,10 @@ class PFAlgo {
   void setMuonHandle(const edm::Handle<reco::MuonCollection>&);
   void setDebug( bool debug ) {debug_ = debug; connector_.setDebug(debug_);}
 
+  /// process the blocks in parallel when the e/gamma algorithms are off;
+  /// they then go through PFAlgo::reconstructBlock, even in derived classes
+  void setParallelBlocks( bool parallel ) {parallelBlocks_ = parallel;}
+
   void setParameters(double nSigmaECAL,
                      double nSigmaHCAL, 
                      const boost::shared_ptr<PFEnergyCalibration>& calibration,
@@ -244,11 +249,18 @@ class PFAlgo {
   virtual void processBlock( const reco::PFBlockRef& blockref,
                              std::list<reco::PFBlockRef>& hcalBlockRefs, 
                              std::list<reco::PFBlockRef>& ecalBlockRefs ); 
+
+  /// process one block, adding the candidates to pfCandidates
+  void reconstructBlock( const reco::PFBlockRef& blockref,
+                         const std::list<reco::PFBlockRef>& hcalBlockRefs, 
+                         const std::list<reco::PFBlockRef>& ecalBlockRefs,
+                         reco::PFCandidateCollection* pfCandidates );
   
   /// Reconstruct a charged particle from a track
-  /// Returns the index of the newly created candidate in pfCandidates_
+  /// Returns the index of the newly created candidate in pfCandidates
   /// Michalis added a flag here to treat muons inside jets
-  unsigned reconstructTrack( const reco::PFBlockElement& elt,bool allowLoose= false);
+  unsigned reconstructTrack( reco::PFCandidateCollection* pfCandidates,
+                             const reco::PFBlockElement& elt,bool allowLoose= false);
 
   /// Reconstruct a neutral particle from a cluster. 
   /// If chargedEnergy is specified, the neutral 
@@ -256,7 +268,8 @@ class PFAlgo {
   /// larger than the chargedEnergy. In this case, the energy of the 
   /// neutral particle is cluster energy - chargedEnergy
 
-  unsigned reconstructCluster( const reco::PFCluster& cluster,
+  unsigned reconstructCluster( reco::PFCandidateCollection* pfCandidates,
+                               const reco::PFCluster& cluster,
                                double particleEnergy,
 			       bool useDirection = false,
 			       double particleX=0.,
@@ -335,6 +348,12 @@ class PFAlgo {
   int                algo_;
   bool               debug_;
 
+  /// process the blocks in parallel
+  bool               parallelBlocks_;
+
+  /// serializes the hadron calibration, evaluated with ROOT functions
+  std::mutex         calibrationMutex_;
+
   /// Variables for PFElectrons
   std::string mvaWeightFileEleID_;
   std::vector<double> setchi2Values_;
@@ -388,6 +388,10 @@ PFProducer::PFProducer(const edm::ParameterSet& iConfig) {
   useHO_= iConfig.getParameter<bool>("useHO");
   pfAlgo_->setHOTag(useHO_);
 
+  // Process the blocks in parallel (without the e/gamma algorithms)
+  if( iConfig.existsAs<bool>("parallelBlocks") )
+    pfAlgo_->setParallelBlocks( iConfig.getParameter<bool>("parallelBlocks") );
+
   verbose_ = 
     iConfig.getUntrackedParameter<bool>("verbose",false);
 
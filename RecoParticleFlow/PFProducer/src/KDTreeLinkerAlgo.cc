@@ -2,8 +2,6 @@
 
 KDTreeLinkerAlgo::KDTreeLinkerAlgo()
   : root_ (0),
-    nodePool_(0),
-    nodePoolSize_(-1),
     nodePoolPos_(-1)
 {
 }
@@ -18,8 +16,8 @@ KDTreeLinkerAlgo::build(std::vector<KDTreeNodeInfo>	&eltList,
 			const KDTreeBox			&region)
 {
   if (eltList.size()) {
-    nodePoolSize_ = eltList.size() * 2 - 1;
-    nodePool_ = new KDTreeNode[nodePoolSize_];
+    nodePool_.resize(eltList.size() * 2 - 1);
+    nodePoolPos_ = -1;
 
     // Here we build the KDTree
     root_ = recBuild(eltList, 0, eltList.size(), 0, region);
@@ -212,22 +210,24 @@ KDTreeLinkerAlgo::addSubtree(const KDTreeNode		*current,
   // By construction, current can't be null
   assert(current != 0);
 
-  if ((current->left == 0) && (current->right == 0)) // leaf
-    recHits.push_back(current->rh);
-  else { // node
-    addSubtree(current->left, recHits);
-    addSubtree(current->right, recHits);
-  }
+  // The nodes of a subtree follow its root in the pool, in the order of the
+  // recursive traversal: it ends when there is one more leaf than nodes.
+  int balance = 0;
+  do {
+    if ((current->left == 0) && (current->right == 0)) { // leaf
+      recHits.push_back(current->rh);
+      ++balance;
+    } else // node
+      --balance;
+    ++current;
+  } while (balance != 1);
 }
 
 
 void 
 KDTreeLinkerAlgo::clearTree()
 {
-  delete[] nodePool_;
-  nodePool_ = 0;
   root_ = 0;
-  nodePoolSize_ = -1;
   nodePoolPos_ = -1;
 }
 
@@ -246,7 +246,10 @@ KDTreeLinkerAlgo::getNextNode()
 
   // The tree size is exactly 2 * nbrElts - 1 and this is the total allocated memory.
   // If we have used more than that....there is a big problem.
-  assert(nodePoolPos_ < nodePoolSize_);
+  assert(nodePoolPos_ < int(nodePool_.size()));
 
-  return &(nodePool_[nodePoolPos_]);
+  // the node may come from a previous tree
+  KDTreeNode *node = &(nodePool_[nodePoolPos_]);
+  node->left = node->right = 0;
+  return node;
 }
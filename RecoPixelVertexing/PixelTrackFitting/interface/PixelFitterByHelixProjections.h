@@ -45,6 +45,7 @@ private:
 
   mutable const TrackerGeometry * theTracker;
   mutable const MagneticField * theField;
+  mutable bool theFieldIsOn;   // Bz at the origin above 0.01 T, updated with theField
   mutable const TransientTrackingRecHitBuilder * theTTRecHitBuilder;
 
   mutable edm::ESWatcher<TrackerDigiGeometryRecord> theTrackerWatcher;
@@ -94,7 +94,7 @@ namespace {
   
 PixelFitterByHelixProjections::PixelFitterByHelixProjections(
    const edm::ParameterSet& cfg) 
- : theConfig(cfg), theTracker(0), theField(0), theTTRecHitBuilder(0) {}
+ : theConfig(cfg), theTracker(0), theField(0), theFieldIsOn(false), theTTRecHitBuilder(0) {}
 
 reco::Track* PixelFitterByHelixProjections::run(
     const edm::EventSetup& es,
@@ -118,6 +118,7 @@ reco::Track* PixelFitterByHelixProjections::run(
     edm::ESHandle<MagneticField> fieldESH;
     es.get<IdealMagneticFieldRecord>().get(fieldESH);
     theField = fieldESH.product();
+    theFieldIsOn = theField->inTesla(GlobalPoint(0.,0.,0.)).z()>0.01;
   }
 
   if (theTTRecHitBuilderWatcher.check(es)) {
@@ -148,7 +149,7 @@ reco::Track* PixelFitterByHelixProjections::run(
   float curvature = circle.curvature();
 
   if ((curvature > 1.e-4)&&
-	(likely(theField->inTesla(GlobalPoint(0.,0.,0.)).z()>0.01))) {
+	(likely(theFieldIsOn))) {
     float invPt = PixelRecoUtilities::inversePt( circle.curvature(), es);
     valPt = (invPt > 1.e-4f) ? 1.f/invPt : 1.e4f;
     CircleFromThreePoints::Vector2D center = circle.center();
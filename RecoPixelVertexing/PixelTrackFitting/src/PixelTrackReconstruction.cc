@@ -109,6 +109,7 @@ void PixelTrackReconstruction::run(TracksWithTTRHs& tracks, edm::Event& ev, cons
 
   if (theFilter) theFilter->update(ev, es);
 
+  std::vector<const TrackingRecHit *> hits;
   for (IR ir=regions.begin(), irEnd=regions.end(); ir < irEnd; ++ir) {
     const TrackingRegion & region = **ir;
 
@@ -121,7 +122,7 @@ void PixelTrackReconstruction::run(TracksWithTTRHs& tracks, edm::Event& ev, cons
     for (unsigned int iTuplet = 0; iTuplet < nTuplets; ++iTuplet) {
       const SeedingHitSet & tuplet = tuplets[iTuplet];
 
-      std::vector<const TrackingRecHit *> hits;
+      hits.clear();
       for (unsigned int iHit = 0, nHits = tuplet.size(); iHit < nHits; ++iHit) {
         hits.push_back( tuplet[iHit]->hit() );
       }
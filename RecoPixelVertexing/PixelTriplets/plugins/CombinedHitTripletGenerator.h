@@ -33,6 +33,10 @@ public:
 
   virtual ~CombinedHitTripletGenerator();
 
+  /// from base class
+  void setDoubletCache(const std::vector<const HitDoubletsCache *> & input, HitDoubletsCache * output) override
+    { theLayerCache.setDoubletCache(input, output); }
+
   /// from base class
   virtual void hitTriplets( const TrackingRegion& reg, OrderedHitTriplets & triplets,
       const edm::Event & ev,  const edm::EventSetup& es);
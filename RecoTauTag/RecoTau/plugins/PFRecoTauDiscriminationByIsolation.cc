@@ -5,6 +5,7 @@
 #include "RecoTauTag/RecoTau/interface/RecoTauVertexAssociator.h"
 #include "RecoTauTag/RecoTau/interface/ConeTools.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidateEtaPhiIndex.h"
 
 #include "TMath.h"
 #include "TFormula.h"
@@ -212,6 +213,8 @@ class PFRecoTauDiscriminationByIsolation : public PFTauDiscriminationProducerBas
   edm::InputTag vertexSrc_;
   edm::EDGetTokenT<reco::VertexCollection> vertex_token;
   std::vector<reco::PFCandidatePtr> chargedPFCandidatesInEvent_;
+  // to only apply the PU track selection to the candidates of the delta beta cone
+  PFCandidateEtaPhiIndex chargedPFCandidateIndex_;
   // Size of cone used to collect PU tracks
   double deltaBetaCollectionCone_;
   std::auto_ptr<TFormula> deltaBetaFormula_;
@@ -254,6 +257,7 @@ void PFRecoTauDiscriminationByIsolation::beginEvent(const edm::Event& event, con
         chargedPFCandidatesInEvent_.push_back(pfCandidate);
       }
     }
+    if ( !useAllPFCands_ ) chargedPFCandidateIndex_.reset(chargedPFCandidatesInEvent_);
     // Count all the vertices in the event, to parameterize the DB
     // correction factor
     edm::Handle<reco::VertexCollection> vertices;
@@ -345,18 +349,30 @@ PFRecoTauDiscriminationByIsolation::discriminate(const PFTauRef& pfTau) const
 
   // If desired, get PU tracks.
   if ( applyDeltaBeta_ || calculateWeights_) {
+    // Only the tracks of the delta beta cone are kept below, so the cuts
+    // are only applied to those which may be in it, in the event order
+    std::vector<PFCandidatePtr> chargedPFCandidatesNearTau;
+    if ( !useAllPFCands_ ) {
+      std::vector<unsigned int> inCone;
+      chargedPFCandidateIndex_.candidatesInCone(pfTau->eta(), pfTau->phi(), deltaBetaCollectionCone_, inCone);
+      chargedPFCandidatesNearTau.reserve(inCone.size());
+      for ( auto i : inCone ) chargedPFCandidatesNearTau.push_back(chargedPFCandidatesInEvent_[i]);
+    }
+    const std::vector<PFCandidatePtr>& chargedPFCandidates =
+      useAllPFCands_ ? chargedPFCandidatesInEvent_ : chargedPFCandidatesNearTau;
+
     // First select by inverted the DZ/track weight cuts. True = invert
     if ( verbosity_ ) {
-      std::cout << "Initial PFCands: " << chargedPFCandidatesInEvent_.size() << std::endl;
+      std::cout << "Initial PFCands: " << chargedPFCandidates.size() << std::endl;
     }
 
     std::vector<PFCandidatePtr> allPU =
       pileupQcutsPUTrackSelection_->filterCandRefs(
-          chargedPFCandidatesInEvent_, true);
+          chargedPFCandidates, true);
 
     std::vector<PFCandidatePtr> allNPU =
       pileupQcutsPUTrackSelection_->filterCandRefs(
-	  chargedPFCandidatesInEvent_);
+	  chargedPFCandidates);
       LogTrace("discriminate") << "After track cuts: " << allPU.size() ;
 
     // Now apply the rest of the cuts, like pt, and TIP, tracker hits, etc
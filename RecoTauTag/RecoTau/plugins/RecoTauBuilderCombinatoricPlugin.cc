@@ -44,6 +44,10 @@ class RecoTauBuilderCombinatoricPlugin : public RecoTauBuilderPlugin
     uint32_t maxPFCHs_;
     uint32_t nCharged_;
     uint32_t nPiZeros_;
+    // taus heavier than maxMass_ are not built (<= 0: all are); the mass of
+    // a tau is at least the one of its signal piZeros, so the combinations of
+    // piZeros heavier than maxMass_ are skipped before building the tau
+    double maxMass_;
   };
   std::vector<decayModeInfo> decayModesToBuild_;
 
@@ -64,6 +68,7 @@ RecoTauBuilderCombinatoricPlugin::RecoTauBuilderCombinatoricPlugin(const edm::Pa
     info.nPiZeros_ = decayMode->getParameter<uint32_t>("nPiZeros");
     info.maxPFCHs_ = decayMode->getParameter<uint32_t>("maxTracks");
     info.maxPiZeros_ = decayMode->getParameter<uint32_t>("maxPiZeros");
+    info.maxMass_ = decayMode->existsAs<double>("maxMass") ? decayMode->getParameter<double>("maxMass") : -1.;
     decayModesToBuild_.push_back(info);
   }
   
@@ -270,6 +275,14 @@ RecoTauBuilderCombinatoricPlugin::operator()(
       // Loop over the different combinations of PiZeros
       for ( PiZeroCombo::iterator piZeroCombo = piZeroCombos.begin();
             piZeroCombo != piZeroCombos.end(); ++piZeroCombo ) {
+        if ( decayMode->maxMass_ > 0. ) {
+          reco::Candidate::LorentzVector piZerosP4;
+          for ( PiZeroCombo::combo_iterator signalPiZero = piZeroCombo->combo_begin();
+                signalPiZero != piZeroCombo->combo_end(); ++signalPiZero ) {
+            piZerosP4 += signalPiZero->p4();
+          }
+          if ( piZerosP4.mass() > decayMode->maxMass_ ) continue;
+        }
         // Output tau
         RecoTauConstructor tau(jet, getPFCands(), true);
         // Reserve space in our collections
@@ -331,6 +344,9 @@ RecoTauBuilderCombinatoricPlugin::operator()(
             RecoTauConstructor::kSignal, 
             trackCombo->combo_begin(), trackCombo->combo_end());
 
+        // Skip the isolation of the taus out of the mass window
+        if ( decayMode->maxMass_ > 0. && tau.p4().mass() > decayMode->maxMass_ ) continue;
+
         // Now build isolation collections
         // Load our isolation tools
         using namespace reco::tau::cone;
@@ -11,6 +11,7 @@
 #include "TrackingTools/PatternTools/interface/TempTrajectory.h"
 
 class CkfDebugger;
+class CompatibleDetsCache;
 class Chi2MeasurementEstimatorBase;
 class DetGroup;
 class FreeTrajectoryState;
@@ -161,6 +162,7 @@ public:
   const TransientTrackingRecHitBuilder* theTTRHBuilder;
   const MeasurementTrackerEvent*        theMeasurementTracker;
   const NavigationSchool *              theNavigationSchool = nullptr;
+  std::unique_ptr<CompatibleDetsCache>  theCompatibleDetsCache; /** Optional per-event cache of the compatible dets of the layers */
 
 
  private:
@@ -79,6 +79,12 @@ namespace cms
     edm::EDGetTokenT<PixelClusterMask> maskPixels_;
     edm::EDGetTokenT<StripClusterMask> maskStrips_;
 
+    // build the trajectories of several seeds in parallel; the result is the same as in the serial case
+    bool parallelSeeds_;
+    // number of seeds built in parallel before applying the seed cleaning, the
+    // trajectories of the seeds it then rejects are thrown away
+    unsigned int parallelSeedsBlockSize_;
+
     // methods for debugging
     virtual TrajectorySeedCollection::const_iterator lastSeed(TrajectorySeedCollection const& theSeedColl){return theSeedColl.end();}
     virtual void printHitsDebugger(edm::Event& e){;}
@@ -69,6 +69,8 @@ public:
   bool theIntermediateCleaning;	/**< Tells whether an intermediary cleaning stage 
                                      should take place during TB. */
   bool theAlwaysUseInvalidHits;
+  bool theBatchedUpdate;        /**< Update all the candidate/hit pairs of an
+                                     iteration together, with the KFBatchUpdator. */
 
 
  protected:
@@ -80,6 +82,7 @@ public:
   void limitedCandidates(const boost::shared_ptr<const TrajectorySeed> & sharedSeed, TempTrajectoryContainer &candidates, TrajectoryContainer& result) const;
   
   void updateTrajectory( TempTrajectory& traj, TM && tm) const;
+  void updateTrajectory( TempTrajectory& traj, TM && tm, const TrajectoryStateOnSurface & upState) const;
 
   /*  
       //not mature for integration.  
@@ -566,7 +566,7 @@ GroupedCkfTrajectoryBuilder::advanceOneLayer (const TrajectorySeed& seed,
       } // last layer... 
     
     //unsigned int maxCandidates = theMaxCand > 21 ? theMaxCand*2 : 42; //limit the number of returned segments
-    LayerMeasurements layerMeasurements(theMeasurementTracker->measurementTracker(), *theMeasurementTracker);
+    LayerMeasurements layerMeasurements(theMeasurementTracker->measurementTracker(), *theMeasurementTracker, theCompatibleDetsCache.get());
     TrajectorySegmentBuilder layerBuilder(&layerMeasurements,
 					  **il,*propagator,
 					  *theUpdator,*theEstimator,
@@ -8,6 +8,7 @@
 
   
 #include "TrackingTools/DetLayers/interface/NavigationSchool.h"
+#include "TrackingTools/DetLayers/interface/CompatibleDetsCache.h"
 #include "TrackingTools/MeasurementDet/interface/LayerMeasurements.h"
 #include "TrackingTools/TrajectoryState/interface/TrajectoryStateTransform.h"
 #include "TrackingTools/GeomPropagators/interface/Propagator.h"
@@ -43,10 +44,22 @@ BaseCkfTrajectoryBuilder::BaseCkfTrajectoryBuilder(const edm::ParameterSet& conf
   theRecHitBuilderName(conf.getParameter<std::string>("TTRHBuilder"))
 {
   if (conf.exists("clustersToSkip")) edm::LogError("BaseCkfTrajectoryBuilder") << "ERROR: " << typeid(*this).name() << " has a clustersToSkip parameter set";
+
+  if (conf.existsAs<edm::ParameterSet>("compatibleDetsCache")) {
+    const edm::ParameterSet& cacheConf = conf.getParameter<edm::ParameterSet>("compatibleDetsCache");
+    auto bin = [&cacheConf](const char * name, double def) {
+      return cacheConf.existsAs<double>(name) ? cacheConf.getParameter<double>(name) : def;
+    };
+    theCompatibleDetsCache.reset(new CompatibleDetsCache(bin("positionBin", 0.05), bin("directionBin", 0.002),
+							 bin("qOverPBin", 0.01), bin("logErrorBin", 0.2)));
+  }
 }
 
 
 BaseCkfTrajectoryBuilder::~BaseCkfTrajectoryBuilder(){
+  if (theCompatibleDetsCache)
+    edm::LogInfo("BaseCkfTrajectoryBuilder") << "compatible dets cache: " << theCompatibleDetsCache->hits() << " hits, "
+					     << theCompatibleDetsCache->misses() << " misses, hit rate " << theCompatibleDetsCache->hitRate();
 }
 
 TrajectoryFilter *BaseCkfTrajectoryBuilder::createTrajectoryFilter(const edm::ParameterSet& pset, edm::ConsumesCollector& iC) {
@@ -269,6 +282,7 @@ void BaseCkfTrajectoryBuilder::setEvent(const edm::Event& iEvent, const edm::Eve
   theTTRHBuilder = recHitBuilderHandle.product();
 
   setData(data);
+  if(theCompatibleDetsCache) theCompatibleDetsCache->clear();
   if(theFilter) theFilter->setEvent(iEvent, iSetup);
   if(theInOutFilter) theInOutFilter->setEvent(iEvent, iSetup);
   setEvent_(iEvent, iSetup);
@@ -41,10 +41,7 @@
 #include<algorithm>
 #include<functional>
 
-#include <thread>
-#ifdef VI_TBB
 #include "tbb/parallel_for.h"
-#endif
 
 #include "RecoTracker/CkfPattern/interface/PrintoutHelper.h"
 
@@ -76,7 +73,9 @@ namespace cms{
     theSeedCleaner(0),
     maxSeedsBeforeCleaning_(0),
     theMTELabel(iC.consumes<MeasurementTrackerEvent>(conf.getParameter<edm::InputTag>("MeasurementTrackerEvent"))),
-    skipClusters_(false)
+    skipClusters_(false),
+    parallelSeeds_(conf.existsAs<bool>("parallelSeeds") && conf.getParameter<bool>("parallelSeeds")),
+    parallelSeedsBlockSize_(conf.existsAs<unsigned int>("parallelSeedsBlockSize") ? conf.getParameter<unsigned int>("parallelSeedsBlockSize") : 64)
   {  
     //produces<TrackCandidateCollection>();  
     // old configuration totally descoped.
@@ -209,10 +208,6 @@ namespace cms{
       // method for debugging
       countSeedsDebugger();
 
-      // the mutex
-      std::mutex theMutex;
-      using Lock = std::unique_lock<std::mutex>;
-
       // Loop over seeds
       size_t collseed_size = collseed->size();
 
@@ -251,21 +246,12 @@ namespace cms{
       
       */
 
-      auto theLoop = [&](size_t ii) {    
+      // build the trajectories from one seed; this does not depend on the results
+      // of the other seeds, so it can run in parallel
+      auto buildFromSeed = [&](size_t ii, std::vector<Trajectory> & theTmpTrajectories) {
         auto j = indeces[ii];
 
-        // to be moved inside a par section (how with tbb??)
-        std::vector<Trajectory> theTmpTrajectories;
-
-
 	LogDebug("CkfPattern") << "======== Begin to look for trajectories from seed " << j << " ========"<<endl;
-	
-        { Lock lock(theMutex); 
-	// Check if seed hits already used by another track
-	if (theSeedCleaner && !theSeedCleaner->good( &((*collseed)[j])) ) {
-          LogDebug("CkfTrackCandidateMakerBase")<<" Seed cleaning kills seed "<<j;
-          return;  // from the lambda! 
-        }}
 
 	// Build trajectory from seed outwards
         theTmpTrajectories.clear();
@@ -304,8 +290,23 @@ namespace cms{
         LogDebug("CkfPattern") << "======== Trajectory cleaning gave the following valid trajectories from seed " 
                                << j << " ========"<<endl
 			       <<PrintoutHelper::dumpCandidates(theTmpTrajectories);
+      };
+
+      // Check if seed hits already used by another track;
+      // must be called for the seeds in order, as the cleaner depends on the trajectories stored so far
+      auto seedIsGood = [&](size_t ii) {
+        auto j = indeces[ii];
+	if (theSeedCleaner && !theSeedCleaner->good( &((*collseed)[j])) ) {
+          LogDebug("CkfTrackCandidateMakerBase")<<" Seed cleaning kills seed "<<j;
+          return false;
+        }
+        return true;
+      };
+
+      // store the trajectories built from one seed; must be called for the seeds in order
+      auto storeResults = [&](size_t ii, std::vector<Trajectory> & theTmpTrajectories) {
+        auto j = indeces[ii];
 
-        { Lock lock(theMutex); 
 	for(vector<Trajectory>::iterator it=theTmpTrajectories.begin();
 	    it!=theTmpTrajectories.end(); it++){
 	  if( it->isValid() ) {
@@ -317,13 +318,12 @@ namespace cms{
             if (theSeedCleaner && rawResult.back().foundHits()>3) theSeedCleaner->add( &rawResult.back() );
             //if (theSeedCleaner ) theSeedCleaner->add( & (*it) );
 	  }
-	}}
+	}
 
         theTmpTrajectories.clear();
         
 	LogDebug("CkfPattern") << "rawResult trajectories found so far = " << rawResult.size();
 
-        { Lock lock(theMutex);
 	if ( maxSeedsBeforeCleaning_ >0 && rawResult.size() > maxSeedsBeforeCleaning_+lastCleanResult) {
           theTrajectoryCleaner->clean(rawResult);
           rawResult.erase(std::remove_if(rawResult.begin()+lastCleanResult,rawResult.end(),
@@ -331,22 +331,32 @@ namespace cms{
 			  rawResult.end());
           lastCleanResult=rawResult.size();
         }
-        }
-
       };
-      // end of loop over seeds
-
 
-#ifdef VI_TBB
-     tbb::parallel_for(0UL,collseed_size,1UL,theLoop);
-#else
-#ifdef VI_OMP
-#pragma omp parallel for schedule(dynamic,4)
-#endif
-      for (size_t j = 0; j < collseed_size; j++){
-       theLoop(j);
+      if (parallelSeeds_) {
+        // Speculatively build the trajectories of a block of seeds in parallel, then go through
+        // the block in the serial order: the seed cleaning decides which results are kept, and
+        // they are stored exactly as the serial loop would. Without a seed cleaner nothing is
+        // discarded, so all the seeds can go in a single block.
+        size_t blockSize = theSeedCleaner ? std::max(1U, parallelSeedsBlockSize_) : collseed_size;
+        std::vector<std::vector<Trajectory> > blockResults(std::min(blockSize, collseed_size));
+        for (size_t begin = 0; begin < collseed_size; begin += blockSize) {
+          size_t end = std::min(begin + blockSize, collseed_size);
+          tbb::parallel_for(begin, end, [&](size_t ii) { buildFromSeed(ii, blockResults[ii - begin]); });
+          for (size_t ii = begin; ii < end; ++ii) {
+            if (seedIsGood(ii)) storeResults(ii, blockResults[ii - begin]);
+            blockResults[ii - begin].clear();
+          }
+        }
+      } else {
+        std::vector<Trajectory> theTmpTrajectories;
+        for (size_t ii = 0; ii < collseed_size; ++ii) {
+          if (!seedIsGood(ii)) continue;
+          buildFromSeed(ii, theTmpTrajectories);
+          storeResults(ii, theTmpTrajectories);
+        }
       }
-#endif
+      // end of loop over seeds
      
       if (theSeedCleaner) theSeedCleaner->done();
    
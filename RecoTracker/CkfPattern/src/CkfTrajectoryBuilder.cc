@@ -7,6 +7,8 @@
 #include "TrackingTools/GeomPropagators/interface/Propagator.h"
 #include "TrackingTools/PatternTools/interface/TrajectoryStateUpdator.h"
 #include "TrackingTools/KalmanUpdators/interface/Chi2MeasurementEstimatorBase.h"
+#include "TrackingTools/KalmanUpdators/interface/KFUpdator.h"
+#include "TrackingTools/KalmanUpdators/interface/KFBatchUpdator.h"
 
 #include "TrackingTools/PatternTools/interface/Trajectory.h"
 #include "TrackingTools/PatternTools/interface/TrajMeasLessEstim.h"
@@ -39,6 +41,7 @@ CkfTrajectoryBuilder::CkfTrajectoryBuilder(const edm::ParameterSet& conf, Trajec
   theLostHitPenalty       = conf.getParameter<double>("lostHitPenalty");
   theIntermediateCleaning = conf.getParameter<bool>("intermediateCleaning");
   theAlwaysUseInvalidHits = conf.getParameter<bool>("alwaysUseInvalidHits");
+  theBatchedUpdate        = conf.existsAs<bool>("batchedUpdate") && conf.getParameter<bool>("batchedUpdate");
   /*
     theSharedSeedCheck = conf.getParameter<bool>("SharedSeedCheck");
     std::stringstream ss;
@@ -187,6 +190,10 @@ limitedCandidates(const boost::shared_ptr<const TrajectorySeed> & sharedSeed, Te
   newCand.reserve(2*theMaxCand);
 
   
+  // the batched update reproduces the KFUpdator, so it is used only together with it
+  bool batched = theBatchedUpdate && dynamic_cast<const KFUpdator*>(theUpdator) != nullptr;
+  KFBatchUpdator batch;
+
   auto trajCandLess = [&](TempTrajectory const & a, TempTrajectory const & b) {
     return  (a.chiSquared() + a.lostHits()*theLostHitPenalty)  <
     (b.chiSquared() + b.lostHits()*theLostHitPenalty);
@@ -196,33 +203,58 @@ limitedCandidates(const boost::shared_ptr<const TrajectorySeed> & sharedSeed, Te
   while ( !candidates.empty()) {
 
     newCand.clear();
-    for (auto traj=candidates.begin(); traj!=candidates.end(); traj++) {
-      std::vector<TM> meas;
-      findCompatibleMeasurements(*sharedSeed, *traj, meas);
+
+    // collect the compatible measurements of all candidates first, so that in batched
+    // mode the updates of all the candidate/hit pairs can be computed together
+    std::vector<std::vector<TM> > allMeas(candidates.size());
+    std::vector<std::size_t> allLast(candidates.size());
+    batch.clear();
+    for (std::size_t icand = 0; icand != candidates.size(); ++icand) {
+      auto const & traj = candidates[icand];
+      std::vector<TM> & meas = allMeas[icand];
+      findCompatibleMeasurements(*sharedSeed, traj, meas);
 
       // --- method for debugging
-      if(!analyzeMeasurementsDebugger(*traj,meas,
+      if(!analyzeMeasurementsDebugger(traj,meas,
 				      theMeasurementTracker,
 				      forwardPropagator(*sharedSeed),theEstimator,
 				      theTTRHBuilder)) return;
       // ---
 
+      std::vector<TM>::const_iterator last;
+      if ( theAlwaysUseInvalidHits || meas.empty()) last = meas.end();
+      else {
+	if (meas.front().recHit()->isValid()) {
+	  last = find_if( meas.begin(), meas.end(), RecHitIsInvalid());
+	}
+	else last = meas.end();
+      }
+      allLast[icand] = last - meas.begin();
+
+      if (batched) {
+	for (auto itm = meas.begin(); itm != last; itm++)
+	  if (itm->recHit()->isValid()) batch.add(itm->predictedState(), *itm->recHit());
+      }
+    }
+    if (batched) batch.run();
+
+    unsigned int ibatch = 0;
+    for (std::size_t icand = 0; icand != candidates.size(); ++icand) {
+      auto traj = candidates.begin() + icand;
+      std::vector<TM> & meas = allMeas[icand];
+
       if ( meas.empty()) {
 	if ( qualityFilter( *traj)) addToResult(sharedSeed, *traj, result);
       }
       else {
-	std::vector<TM>::const_iterator last;
-	if ( theAlwaysUseInvalidHits) last = meas.end();
-	else {
-	  if (meas.front().recHit()->isValid()) {
-	    last = find_if( meas.begin(), meas.end(), RecHitIsInvalid());
-	  }
-	  else last = meas.end();
-	}
+	auto last = meas.begin() + allLast[icand];
 
 	for(auto itm = meas.begin(); itm != last; itm++) {
 	  TempTrajectory newTraj = *traj;
-	  updateTrajectory( newTraj, std::move(*itm));
+	  if (batched && itm->recHit()->isValid())
+	    updateTrajectory( newTraj, std::move(*itm), batch.updatedState(ibatch++));
+	  else
+	    updateTrajectory( newTraj, std::move(*itm));
 
 	  if ( toBeContinued(newTraj)) {
 	    newCand.push_back(std::move(newTraj));  std::push_heap(newCand.begin(),newCand.end(),trajCandLess);
@@ -317,6 +349,16 @@ void CkfTrajectoryBuilder::updateTrajectory( TempTrajectory& traj,
   }
 }
 
+void CkfTrajectoryBuilder::updateTrajectory( TempTrajectory& traj,
+					     TM && tm,
+					     const TrajectoryStateOnSurface & upState) const
+{
+  auto && predictedState = tm.predictedState();
+  auto  && hit = tm.recHit();
+  traj.emplace( std::move(predictedState), TrajectoryStateOnSurface(upState),
+		std::move(hit), tm.estimate(), tm.layer());
+}
+
 
 void 
 CkfTrajectoryBuilder::findCompatibleMeasurements(const TrajectorySeed&seed,
@@ -350,7 +392,7 @@ CkfTrajectoryBuilder::findCompatibleMeasurements(const TrajectorySeed&seed,
 	LogDebug("CkfPattern")<<"to: "<<stateToUse;
       }
     
-    LayerMeasurements layerMeasurements(theMeasurementTracker->measurementTracker(), *theMeasurementTracker);
+    LayerMeasurements layerMeasurements(theMeasurementTracker->measurementTracker(), *theMeasurementTracker, theCompatibleDetsCache.get());
     std::vector<TrajectoryMeasurement> && tmp = layerMeasurements.measurements((**il),stateToUse, *fwdPropagator, *theEstimator);
     
     if ( !tmp.empty()) {
@@ -86,6 +86,8 @@ using namespace reco;
 	 double maxDdsz_;
 	 ///max difference in q/p between two tracks
 	 double maxDQoP_;
+	 ///if >=0, compare only the tracks whose lambda differ by less than maxDLambda plus this margin
+	 double lambdaPreselectionMargin_;
 
 	 edm::ESHandle<MagneticField> magfield_;
 
@@ -119,6 +121,7 @@ DuplicateTrackMerger::DuplicateTrackMerger(const edm::ParameterSet& iPara) : for
   maxDdsz_ = 10.0;
   maxDdxy_ = 10.0;
   maxDQoP_ = 0.25;
+  lambdaPreselectionMargin_ = -1.0;
   if(iPara.exists("minpT"))minpT_ = iPara.getParameter<double>("minpT");
   if(iPara.exists("minP"))minP_ = iPara.getParameter<double>("minP");
   if(iPara.exists("maxDCA"))maxDCA_ = iPara.getParameter<double>("maxDCA");
@@ -130,6 +133,7 @@ DuplicateTrackMerger::DuplicateTrackMerger(const edm::ParameterSet& iPara) : for
   if(iPara.exists("source"))trackSource_ = consumes<reco::TrackCollection>(iPara.getParameter<edm::InputTag>("source"));
   if(iPara.exists("minDeltaR3d"))minDeltaR3d_ = iPara.getParameter<double>("minDeltaR3d");
   if(iPara.exists("minBDTG"))minBDTG_ = iPara.getParameter<double>("minBDTG");
+  if(iPara.exists("lambdaPreselectionMargin"))lambdaPreselectionMargin_ = iPara.getParameter<double>("lambdaPreselectionMargin");
 
   produces<std::vector<TrackCandidate> >("candidates");
   produces<CandidateToDuplicate>("candidateMap");
@@ -195,14 +199,37 @@ void DuplicateTrackMerger::produce(edm::Event& iEvent, const edm::EventSetup& iS
 
   std::auto_ptr<CandidateToDuplicate> out_candidateMap(new CandidateToDuplicate());
 
+  // the tracks passing the momentum cuts
+  std::vector<int> good;
   for(int i = 0; i < (int)handle->size(); i++){
     const reco::Track *rt1 = &(handle->at(i));
     if(rt1->innerMomentum().Rho() < minpT_)continue;
     if(rt1->innerMomentum().R() < minP_)continue;
-    for(int j = i+1; j < (int)handle->size();j++){
+    good.push_back(i);
+  }
+
+  // the pairs of tracks to compare, in the order of the track indices
+  std::vector<std::pair<int,int> > pairs;
+  if(lambdaPreselectionMargin_ < 0){
+    for(unsigned int a = 0; a < good.size(); a++)
+      for(unsigned int b = a+1; b < good.size(); b++) pairs.emplace_back(good[a],good[b]);
+  }else{
+    // the lambda of a track hardly changes along its trajectory: compare only the neighbours in lambda
+    std::vector<std::pair<double,int> > byLambda;
+    byLambda.reserve(good.size());
+    for(auto i : good) byLambda.emplace_back(handle->at(i).lambda(),i);
+    std::sort(byLambda.begin(),byLambda.end());
+    double window = maxDLambda_ + lambdaPreselectionMargin_;
+    for(unsigned int a = 0; a < byLambda.size(); a++)
+      for(unsigned int b = a+1; b < byLambda.size() && byLambda[b].first - byLambda[a].first <= window; b++)
+	pairs.emplace_back(std::min(byLambda[a].second,byLambda[b].second),std::max(byLambda[a].second,byLambda[b].second));
+    std::sort(pairs.begin(),pairs.end());
+  }
+
+  for(auto const & ij : pairs){
+      int i = ij.first, j = ij.second;
+      const reco::Track *rt1 = &(handle->at(i));
       const reco::Track *rt2 = &(handle->at(j));
-      if(rt2->innerMomentum().Rho() < minpT_)continue;
-      if(rt2->innerMomentum().R() < minP_)continue;
       if(rt1->charge() != rt2->charge())continue;
       const reco::Track* t1,*t2;
       if(rt1->outerPosition().Rho() < rt2->outerPosition().Rho()){
@@ -282,7 +309,6 @@ void DuplicateTrackMerger::produce(edm::Event& iEvent, const edm::EventSetup& iS
       std::pair<TrackRef,TrackRef> trackPair(TrackRef(refTrks,i),TrackRef(refTrks,j));
       std::pair<TrackCandidate, std::pair<TrackRef,TrackRef> > cp(mergedTrack,trackPair);
       out_candidateMap->push_back(cp);
-    }
   }
   iEvent.put(out_duplicateCandidates,"candidates");
   iEvent.put(out_candidateMap,"candidateMap");
@@ -59,6 +59,8 @@ MultiTrackSelector::MultiTrackSelector()
 {
   useForestFromDB_ = true;
   forest_ = nullptr;
+  batchMVA_ = false;
+  flatForestCacheId_ = 0;
 }
 
 MultiTrackSelector::MultiTrackSelector( const edm::ParameterSet & cfg ) :
@@ -80,8 +82,11 @@ MultiTrackSelector::MultiTrackSelector( const edm::ParameterSet & cfg ) :
   dbFileName_ = "";
 
   forest_ = nullptr;
+  batchMVA_ = false;
+  flatForestCacheId_ = 0;
 
   if(cfg.exists("useAnyMVA")) useAnyMVA_ = cfg.getParameter<bool>("useAnyMVA");
+  if(cfg.exists("batchMVA")) batchMVA_ = cfg.getParameter<bool>("batchMVA");
 
   if(useAnyMVA_){
     if(cfg.exists("mvaType"))type = cfg.getParameter<std::string>("mvaType");
@@ -97,6 +102,8 @@ MultiTrackSelector::MultiTrackSelector( const edm::ParameterSet & cfg ) :
   qualityToSet_.reserve(trkSelectors.size());
   vtxNumber_.reserve(trkSelectors.size());
   vertexCut_.reserve(trkSelectors.size());
+  vertexSelection_.reserve(trkSelectors.size());
+  std::vector<std::string> vertexCutStrings;
   res_par_.reserve(trkSelectors.size());
   chi2n_par_.reserve(trkSelectors.size());
   chi2n_no1Dmod_par_.reserve(trkSelectors.size());
@@ -135,6 +142,10 @@ MultiTrackSelector::MultiTrackSelector( const edm::ParameterSet & cfg ) :
     // parameters for vertex selection
     vtxNumber_.push_back( useVertices_ ? trkSelectors[i].getParameter<int32_t>("vtxNumber") : 0 );
     vertexCut_.push_back( useVertices_ ? trkSelectors[i].getParameter<std::string>("vertexCut") : 0);
+    vertexCutStrings.push_back( useVertices_ ? trkSelectors[i].getParameter<std::string>("vertexCut") : "");
+    vertexSelection_.push_back(i);
+    for (unsigned int j=0; j<i; j++) 
+      if (vtxNumber_[j]==vtxNumber_[i] && vertexCutStrings[j]==vertexCutStrings[i]) { vertexSelection_[i]=j; break; }
     //  parameters for adapted optimal cuts on chi2 and primary vertex compatibility
     res_par_.push_back(trkSelectors[i].getParameter< std::vector<double> >("res_par") );
     chi2n_par_.push_back( trkSelectors[i].getParameter<double>("chi2n_par") );
@@ -237,6 +248,7 @@ void MultiTrackSelector::beginStream(edm::StreamID) {
   if(!useForestFromDB_){
      TFile gbrfile(dbFileName_.c_str());
        forest_ = (GBRForest*)gbrfile.Get(forestLabel_.c_str());
+     if (batchMVA_ && forest_) flatForest_ = FlatGBRForest(*forest_);
   }
 
 }
@@ -273,17 +285,27 @@ void MultiTrackSelector::run( edm::Event& evt, const edm::EventSetup& es ) const
   unsigned int trkSize=srcTracks.size();
   std::vector<int> selTracksSave( qualityToSet_.size()*trkSize,0);
 
+  // the quantities of the tracks common to all the selectors and the MVA
+  std::vector<TrackFeatures> features(trkSize);
+  for (unsigned int j=0; j<trkSize; j++) trackFeatures(vertexBeamSpot, srcHits, srcTracks[j], features[j]);
+
   std::vector<float> mvaVals_(srcTracks.size(),-99.f);
-  processMVA(evt,es, mvaVals_);
+  processMVA(evt,es, features, mvaVals_);
+
+  // the selected vertices, shared by the selectors with the same vertex selection
+  std::vector<std::vector<Point> > allPoints(qualityToSet_.size());
+  std::vector<std::vector<float> > allVterr(qualityToSet_.size()), allVzerr(qualityToSet_.size());
 
   for (unsigned int i=0; i<qualityToSet_.size(); i++) {  
     std::vector<int> selTracks(trkSize,0);
     auto_ptr<edm::ValueMap<int> > selTracksValueMap = auto_ptr<edm::ValueMap<int> >(new edm::ValueMap<int>);
     edm::ValueMap<int>::Filler filler(*selTracksValueMap);
 
-    std::vector<Point> points;
-    std::vector<float> vterr, vzerr;
-    if (useVertices_) selectVertices(i,*hVtx, points, vterr, vzerr);
+    unsigned int iv = vertexSelection_[i];
+    if (useVertices_ && iv==i) selectVertices(i,*hVtx, allPoints[i], allVterr[i], allVzerr[i]);
+    std::vector<Point> const & points = allPoints[iv];
+    std::vector<float> & vterr = allVterr[iv];
+    std::vector<float> & vzerr = allVzerr[iv];
 
     // Loop over tracks
     size_t current = 0;
@@ -304,7 +326,7 @@ void MultiTrackSelector::run( edm::Event& evt, const edm::EventSetup& es ) const
       else {
 	float mvaVal = 0;
 	if(useAnyMVA_) mvaVal = mvaVals_[current];
-	ok = select(i,vertexBeamSpot, srcHits, trk, points, vterr, vzerr,mvaVal);
+	ok = select(i,vertexBeamSpot, trk, features[current], points, vterr, vzerr,mvaVal);
 	if (!ok) { 
 	  LogTrace("TrackSelection") << "track with pt="<< trk.pt() << " NOT selected";
 	  if (!keepAllTracks_[i]) { 
@@ -352,6 +374,51 @@ void MultiTrackSelector::run( edm::Event& evt, const edm::EventSetup& es ) const
 }
 
 
+void MultiTrackSelector::trackFeatures(const reco::BeamSpot &vertexBeamSpot,
+				       const TrackingRecHitCollection & recHits,
+				       const reco::Track &tk,
+				       TrackFeatures & f) const {
+  f.nhits = tk.numberOfValidHits();
+  f.ndof = tk.ndof();
+  f.nlayers = tk.hitPattern().trackerLayersWithMeasurement();
+  f.nlayers3D = tk.hitPattern().pixelLayersWithMeasurement() +
+    tk.hitPattern().numberOfValidStripLayersWithMonoAndStereo();
+  f.nlayersLost = tk.hitPattern().trackerLayersWithoutMeasurement(reco::HitPattern::TRACK_HITS);
+
+  float chi2n =  tk.normalizedChi2();
+  f.chi2n_no1Dmod = chi2n;
+
+  int count1dhits = 0;
+  auto ith = tk.extra()->firstRecHit();
+  auto  edh = ith + tk.recHitsSize();
+  for (; ith<edh; ++ith) {
+    const TrackingRecHit & hit = recHits[ith];
+    if (hit.dimension()==1) ++count1dhits;
+  }
+  if (count1dhits > 0) {
+    float chi2 = tk.chi2();
+    float ndof = tk.ndof();
+    chi2n = (chi2+count1dhits)/float(ndof+count1dhits);
+  }
+  // For each 1D rechit, the chi^2 and ndof is increased by one.  This is a way of retaining approximately
+  // the same normalized chi^2 distribution as with 2D rechits.
+  f.chi2n = chi2n;
+
+  f.pt = std::max(float(tk.pt()),0.000001f);
+  f.eta = tk.eta();
+  f.relpterr = float(tk.ptError())/f.pt;
+
+  int lostIn = tk.hitPattern().numberOfLostTrackerHits(reco::HitPattern::MISSING_INNER_HITS);
+  int lostOut = tk.hitPattern().numberOfLostTrackerHits(reco::HitPattern::MISSING_OUTER_HITS);
+  f.minLost = std::min(lostIn,lostOut);
+  f.lostMidFrac = tk.numberOfLostHits() / (tk.numberOfValidHits() + tk.numberOfLostHits());
+
+  f.d0 = -tk.dxy(vertexBeamSpot.position());
+  f.d0E = tk.d0Error();
+  f.dz = tk.dz(vertexBeamSpot.position());
+  f.dzE = tk.dzError();
+}
+
  bool MultiTrackSelector::select(unsigned int tsNum, 
 				 const reco::BeamSpot &vertexBeamSpot,
         	       	       	 const TrackingRecHitCollection & recHits,
@@ -360,12 +427,25 @@ void MultiTrackSelector::run( edm::Event& evt, const edm::EventSetup& es ) const
 				 std::vector<float> &vterr,
 				 std::vector<float> &vzerr,
 				 double mvaVal) const {
+  TrackFeatures f;
+  trackFeatures(vertexBeamSpot, recHits, tk, f);
+  return select(tsNum, vertexBeamSpot, tk, f, points, vterr, vzerr, mvaVal);
+}
+
+ bool MultiTrackSelector::select(unsigned int tsNum, 
+				 const reco::BeamSpot &vertexBeamSpot,
+				 const reco::Track &tk, 
+				 const TrackFeatures &f,
+				 const std::vector<Point> &points,
+				 std::vector<float> &vterr,
+				 std::vector<float> &vzerr,
+				 double mvaVal) const {
   // Decide if the given track passes selection cuts.
 
   using namespace std; 
   
   //cuts on number of valid hits
-  auto nhits = tk.numberOfValidHits();
+  auto nhits = f.nhits;
   if(nhits>=min_hits_bypass_[tsNum]) return true;
   if(nhits < min_nhits_[tsNum]) return false;
 
@@ -384,10 +464,9 @@ void MultiTrackSelector::run( edm::Event& evt, const edm::EventSetup& es ) const
 
 
   // Cuts on numbers of layers with hits/3D hits/lost hits.
-  uint32_t nlayers     = tk.hitPattern().trackerLayersWithMeasurement();
-  uint32_t nlayers3D   = tk.hitPattern().pixelLayersWithMeasurement() +
-    tk.hitPattern().numberOfValidStripLayersWithMonoAndStereo();
-  uint32_t nlayersLost = tk.hitPattern().trackerLayersWithoutMeasurement(reco::HitPattern::TRACK_HITS);
+  uint32_t nlayers     = f.nlayers;
+  uint32_t nlayers3D   = f.nlayers3D;
+  uint32_t nlayersLost = f.nlayersLost;
   LogDebug("TrackSelection") << "cuts on nlayers: " << nlayers << " " << nlayers3D << " " << nlayersLost << " vs " 
 			     << min_layers_[tsNum] << " " << min_3Dlayers_[tsNum] << " " << max_lostLayers_[tsNum];
   if (nlayers < min_layers_[tsNum]) return false;
@@ -395,48 +474,30 @@ void MultiTrackSelector::run( edm::Event& evt, const edm::EventSetup& es ) const
   if (nlayersLost > max_lostLayers_[tsNum]) return false;
   LogTrace("TrackSelection") << "cuts on nlayers passed";
 
-  float chi2n =  tk.normalizedChi2();
-  float chi2n_no1Dmod = chi2n;
-
-  int count1dhits = 0;
-  auto ith = tk.extra()->firstRecHit();
-  auto  edh = ith + tk.recHitsSize();
-  for (; ith<edh; ++ith) {
-    const TrackingRecHit & hit = recHits[ith];
-    if (hit.dimension()==1) ++count1dhits;
-  }
-  if (count1dhits > 0) {
-    float chi2 = tk.chi2();
-    float ndof = tk.ndof();
-    chi2n = (chi2+count1dhits)/float(ndof+count1dhits);
-  }
-  // For each 1D rechit, the chi^2 and ndof is increased by one.  This is a way of retaining approximately
-  // the same normalized chi^2 distribution as with 2D rechits.
+  float chi2n = f.chi2n;
+  float chi2n_no1Dmod = f.chi2n_no1Dmod;
   if (chi2n > chi2n_par_[tsNum]*nlayers) return false;
 
   if (chi2n_no1Dmod > chi2n_no1Dmod_par_[tsNum]*nlayers) return false;
 
   // Get track parameters
-  float pt = std::max(float(tk.pt()),0.000001f);
-  float eta = tk.eta();
+  float pt = f.pt;
+  float eta = f.eta;
   if (eta<min_eta_[tsNum] || eta>max_eta_[tsNum]) return false;
 
   //cuts on relative error on pt
-  float relpterr = float(tk.ptError())/pt;
+  float relpterr = f.relpterr;
   if(relpterr > max_relpterr_[tsNum]) return false;
 
-  int lostIn = tk.hitPattern().numberOfLostTrackerHits(reco::HitPattern::MISSING_INNER_HITS);
-  int lostOut = tk.hitPattern().numberOfLostTrackerHits(reco::HitPattern::MISSING_OUTER_HITS);
-  int minLost = std::min(lostIn,lostOut);
+  int minLost = f.minLost;
   if (minLost > max_minMissHitOutOrIn_[tsNum]) return false;
-  float lostMidFrac = tk.numberOfLostHits() / (tk.numberOfValidHits() + tk.numberOfLostHits());
+  float lostMidFrac = f.lostMidFrac;
   if (lostMidFrac > max_lostHitFraction_[tsNum]) return false;
 
 
 
   //other track parameters
-  float d0 = -tk.dxy(vertexBeamSpot.position()), d0E =  tk.d0Error(),
-    dz = tk.dz(vertexBeamSpot.position()), dzE =  tk.dzError();
+  float d0 = f.d0, d0E = f.d0E, dz = f.dz, dzE = f.dzE;
 
   // parametrized d0 resolution for the track pt
   float nomd0E = sqrt(res_par_[tsNum][0]*res_par_[tsNum][0]+(res_par_[tsNum][1]/pt)*(res_par_[tsNum][1]/pt));
@@ -531,6 +592,23 @@ void MultiTrackSelector::run( edm::Event& evt, const edm::EventSetup& es ) const
 }
 
 void MultiTrackSelector::processMVA(edm::Event& evt, const edm::EventSetup& es, std::vector<float> & mvaVals_) const
+{
+  std::vector<TrackFeatures> features;
+  if (useAnyMVA_) {
+    edm::Handle<reco::TrackCollection> hSrcTrack;
+    evt.getByToken( src_, hSrcTrack );
+    edm::Handle<TrackingRecHitCollection> hSrcHits;
+    evt.getByToken( hSrc_, hSrcHits );
+    edm::Handle<reco::BeamSpot> hBsp;
+    evt.getByToken(beamspot_, hBsp);
+    features.resize(hSrcTrack->size());
+    for (unsigned int j=0; j<features.size(); j++) trackFeatures(*hBsp, *hSrcHits, (*hSrcTrack)[j], features[j]);
+  }
+  processMVA(evt, es, features, mvaVals_);
+}
+
+void MultiTrackSelector::processMVA(edm::Event& evt, const edm::EventSetup& es, const std::vector<TrackFeatures> & features,
+				    std::vector<float> & mvaVals_) const
 {
 
   using namespace std; 
@@ -543,11 +621,6 @@ void MultiTrackSelector::processMVA(edm::Event& evt, const edm::EventSetup& es,
   const TrackCollection& srcTracks(*hSrcTrack);
   assert(mvaVals_.size()==srcTracks.size());
 
- // get hits in track..
-  Handle<TrackingRecHitCollection> hSrcHits;
-  evt.getByToken( hSrc_, hSrcHits );
-  const TrackingRecHitCollection & srcHits(*hSrcHits);
-
 
   auto_ptr<edm::ValueMap<float> >mvaValValueMap = auto_ptr<edm::ValueMap<float> >(new edm::ValueMap<float>);
   edm::ValueMap<float>::Filler mvaFiller(*mvaValValueMap);
@@ -560,64 +633,43 @@ void MultiTrackSelector::processMVA(edm::Event& evt, const edm::EventSetup& es,
     evt.put(mvaValValueMap,"MVAVals");
     return;
   }
+  assert(features.size()==srcTracks.size());
+
+  // the MVA variables of each track, contiguous
+  const unsigned int nVars = 11;
+  std::vector<float> gbrVals_(nVars*features.size());
+  for (size_t current = 0; current != features.size(); ++current) {
+    const TrackFeatures & f = features[current];
+    float * v = &gbrVals_[nVars*current];
+    v[0] = f.lostMidFrac;
+    v[1] = f.minLost;
+    v[2] = f.nhits;
+    v[3] = f.relpterr;
+    v[4] = f.eta;
+    v[5] = f.chi2n_no1Dmod;
+    v[6] = f.chi2n;
+    v[7] = f.nlayersLost;
+    v[8] = f.nlayers3D;
+    v[9] = f.nlayers;
+    v[10] = f.ndof;
+  }
 
-
-  size_t current = 0;
-  for (TrackCollection::const_iterator it = srcTracks.begin(), ed = srcTracks.end(); it != ed; ++it, ++current) {
-    const Track & trk = * it;
-    auto tmva_ndof_ = trk.ndof();
-    auto tmva_nlayers_ = trk.hitPattern().trackerLayersWithMeasurement();
-    auto tmva_nlayers3D_ = trk.hitPattern().pixelLayersWithMeasurement()
-        + trk.hitPattern().numberOfValidStripLayersWithMonoAndStereo();
-    auto tmva_nlayerslost_ = trk.hitPattern().trackerLayersWithoutMeasurement(reco::HitPattern::TRACK_HITS);
-    float chi2n =  trk.normalizedChi2();
-    float chi2n_no1Dmod = chi2n;
-    
-    int count1dhits = 0;
-    auto ith = trk.extra()->firstRecHit();
-    auto  edh = ith + trk.recHitsSize();
-    for (; ith<edh; ++ith) {
-      const TrackingRecHit & hit = srcHits[ith];
-      if (hit.dimension()==1) ++count1dhits;
-    }
-    if (count1dhits > 0) {
-      float chi2 = trk.chi2();
-      float ndof = trk.ndof();
-      chi2n = (chi2+count1dhits)/float(ndof+count1dhits);
+  GBRForest const * forest = forest_;
+  if(useForestFromDB_){
+    edm::ESHandle<GBRForest> forestHandle;
+    es.get<GBRWrapperRcd>().get(forestLabel_,forestHandle);
+    forest = forestHandle.product();
+    if (batchMVA_ && es.get<GBRWrapperRcd>().cacheIdentifier()!=flatForestCacheId_) {
+      flatForest_ = FlatGBRForest(*forest);
+      flatForestCacheId_ = es.get<GBRWrapperRcd>().cacheIdentifier();
     }
-    auto tmva_chi2n_ = chi2n;
-    auto tmva_chi2n_no1dmod_ = chi2n_no1Dmod;
-    auto tmva_eta_ = trk.eta();
-    auto tmva_relpterr_ = float(trk.ptError())/std::max(float(trk.pt()),0.000001f);
-    auto tmva_nhits_ = trk.numberOfValidHits();
-    int lostIn = trk.hitPattern().numberOfLostTrackerHits(reco::HitPattern::MISSING_INNER_HITS);
-    int lostOut = trk.hitPattern().numberOfLostTrackerHits(reco::HitPattern::MISSING_OUTER_HITS);
-    auto tmva_minlost_ = std::min(lostIn,lostOut);
-    auto tmva_lostmidfrac_ = trk.numberOfLostHits() / (trk.numberOfValidHits() + trk.numberOfLostHits());
-
-    float gbrVals_[11];
-    gbrVals_[0] = tmva_lostmidfrac_;
-    gbrVals_[1] = tmva_minlost_;
-    gbrVals_[2] = tmva_nhits_;
-    gbrVals_[3] = tmva_relpterr_;
-    gbrVals_[4] = tmva_eta_;
-    gbrVals_[5] = tmva_chi2n_no1dmod_;
-    gbrVals_[6] = tmva_chi2n_;
-    gbrVals_[7] = tmva_nlayerslost_;
-    gbrVals_[8] = tmva_nlayers3D_;
-    gbrVals_[9] = tmva_nlayers_;
-    gbrVals_[10] = tmva_ndof_;
-
-
-    GBRForest const * forest = forest_;
-    if(useForestFromDB_){
-      edm::ESHandle<GBRForest> forestHandle;
-      es.get<GBRWrapperRcd>().get(forestLabel_,forestHandle);
-      forest = forestHandle.product();
-    }
-    
-    auto gbrVal = forest->GetClassifier(gbrVals_);
-    mvaVals_[current] = gbrVal;
+  }
+
+  if (batchMVA_) {
+    if (!features.empty()) flatForest_.GetClassifiers(&gbrVals_[0], nVars, features.size(), &mvaVals_[0]);
+  } else {
+    for (size_t current = 0; current != features.size(); ++current)
+      mvaVals_[current] = forest->GetClassifier(&gbrVals_[nVars*current]);
   }
   mvaFiller.insert(hSrcTrack,mvaVals_.begin(),mvaVals_.end());
   mvaFiller.fill();
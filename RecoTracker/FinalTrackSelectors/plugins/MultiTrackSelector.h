@@ -31,6 +31,7 @@
 #include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit1D.h"
 #include "CommonTools/Utils/interface/StringCutObjectSelector.h"
 #include "CondFormats/EgammaObjects/interface/GBRForest.h"
+#include "CondFormats/EgammaObjects/interface/FlatGBRForest.h"
 
     class dso_hidden MultiTrackSelector : public edm::stream::EDProducer<> {
         private:
@@ -51,6 +52,18 @@
             // void init(edm::EventSetup const& es) const;
 
             typedef math::XYZPoint Point;
+
+            /// the quantities of a track used by the selectors and the MVA, which do not depend on the selector
+            struct TrackFeatures {
+              uint32_t nhits, nlayers, nlayers3D, nlayersLost;
+              float ndof, chi2n, chi2n_no1Dmod, pt, eta, relpterr;
+              int minLost;
+              float lostMidFrac, d0, d0E, dz, dzE;
+            };
+            void trackFeatures(const reco::BeamSpot &vertexBeamSpot,
+                               const TrackingRecHitCollection & recHits,
+                               const reco::Track &tk,
+                               TrackFeatures & f) const;
             /// process one event
             void produce(edm::Event& evt, const edm::EventSetup& es ) override final {
                run(evt,es);
@@ -66,6 +79,14 @@
 			 std::vector<float> &vterr,
 			 std::vector<float> &vzerr,
 			 double mvaVal) const;
+            bool select (unsigned tsNum,
+			 const reco::BeamSpot &vertexBeamSpot,
+			 const reco::Track &tk, 
+			 const TrackFeatures &f,
+			 const std::vector<Point> &points,
+			 std::vector<float> &vterr,
+			 std::vector<float> &vzerr,
+			 double mvaVal) const;
             void selectVertices ( unsigned int tsNum,
 				  const reco::VertexCollection &vtxs, 
 				  std::vector<Point> &points,
@@ -73,6 +94,8 @@
 				  std::vector<float> &vzerr) const;
 
 	    void processMVA(edm::Event& evt, const edm::EventSetup& es, std::vector<float> & mvaVals_) const;
+	    void processMVA(edm::Event& evt, const edm::EventSetup& es, const std::vector<TrackFeatures> & features,
+			    std::vector<float> & mvaVals_) const;
 
             /// source collection label
             edm::EDGetTokenT<reco::TrackCollection> src_;
@@ -91,6 +114,8 @@
 	    std::vector<int32_t> vtxNumber_;
 	    //StringCutObjectSelector is not const thread safe
 	    std::vector<StringCutObjectSelector<reco::Vertex> > vertexCut_;
+	    // first selector with the same vertex selection, whose vertices are reused
+	    std::vector<unsigned int> vertexSelection_;
 
 	    //  parameters for adapted optimal cuts on chi2 and primary vertex compatibility
 	    std::vector< std::vector<double> > res_par_;
@@ -148,6 +173,11 @@
 	    bool useForestFromDB_;
 	    std::string dbFileName_;
 
+	    // evaluate the MVA of all the tracks at once with a FlatGBRForest
+	    bool batchMVA_;
+	    mutable FlatGBRForest flatForest_;
+	    mutable unsigned long long flatForestCacheId_;
+
 
     };
 
@@ -109,6 +109,7 @@ class dso_hidden TrackListMerger : public edm::stream::EDProducer<>
 #include <iostream>
 #include <cmath>
 #include <vector>
+#include <algorithm>
 
 #include "DataFormats/TrackerRecHit2D/interface/SiStripMatchedRecHit2DCollection.h"
 #include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit2DCollection.h"
@@ -451,6 +452,19 @@ TrackListMerger::~TrackListMerger() { }
       std::sort_heap(rh1[i].begin(),rh1[i].end(),compById);
     }
 
+    // tracks without any hit in a common module cannot be duplicates (unless a share fraction is negative):
+    // an index from the hit ids to the tracks gives the candidate duplicates of each track
+    bool useHitIndex = shareFrac_>=0 && std::all_of(indivShareFrac_.begin(),indivShareFrac_.end(),[](double f){return f>=0;});
+    std::vector<std::pair<unsigned int,unsigned int>> hitIndex;  // (id, track)
+    if (useHitIndex && ngood>1 && collsSize>1) {
+      for ( unsigned int j=0; j<rSize; j++) {
+	if (selected[j]==0) continue;
+	for (auto const & h : rh1[indexG[j]]) hitIndex.emplace_back(h.first,j);
+      }
+      std::sort(hitIndex.begin(),hitIndex.end());
+    }
+    std::vector<unsigned int> candidates;
+
     //DL here
     if likely(ngood>1 && collsSize>1)
     for ( unsigned int ltm=0; ltm<listsToMerge_.size(); ltm++) {
@@ -476,8 +490,19 @@ TrackListMerger::~TrackListMerger() { }
 	int nhit1 = nh1; // validHits[k1];
 	float score1 = score[k1];
 
+	candidates.clear();
+	if (useHitIndex) {
+	  for (auto const & h : rh1[k1]) {
+	    auto p = std::lower_bound(hitIndex.begin(),hitIndex.end(),std::make_pair(h.first,i+1));
+	    for (; p!=hitIndex.end() && p->first==h.first; ++p) candidates.push_back(p->second);
+	  }
+	  std::sort(candidates.begin(),candidates.end());
+	  candidates.erase(std::unique(candidates.begin(),candidates.end()),candidates.end());
+	}
+
 	// start at next collection
-	for ( unsigned int j=i+1; j<rSize; j++) {
+	for ( unsigned int jc=0, je = useHitIndex ? candidates.size() : rSize-i-1; jc<je; jc++) {
+	  unsigned int j = useHitIndex ? candidates[jc] : i+1+jc;
 	  if (selected[j]==0) continue;
 	  unsigned int collNum2=trackCollNum[j];
 	  if ( (collNum == collNum2) && indivShareFrac_[collNum] > 0.99) continue;
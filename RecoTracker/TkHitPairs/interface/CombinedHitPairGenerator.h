@@ -30,6 +30,10 @@ public:
 
   void setSeedingLayers(SeedingLayerSetsHits::SeedingLayerSet layers) override;
 
+  /// from base class
+  void setDoubletCache(const std::vector<const HitDoubletsCache *> & input, HitDoubletsCache * output) override
+    { theLayerCache.setDoubletCache(input, output); }
+
   /// form base class
   virtual void hitPairs( const TrackingRegion& reg, 
       OrderedHitPairs & result, const edm::Event& ev, const edm::EventSetup& es);
@@ -0,0 +1,61 @@
+#ifndef RecoTracker_TkHitPairs_HitDoubletsCache_h
+#define RecoTracker_TkHitPairs_HitDoubletsCache_h
+
+/** \class HitDoubletsCache
+ * Per-event store of the hit doublets built by HitPairGeneratorFromLayerPair,
+ * keyed by layer pair and tracking region, so that a later seeding step on
+ * the same layer pair and region can reuse them instead of redoing the
+ * combinatorics. <BR>
+ *
+ * The doublets are stored as pairs of hit pointers, together with the hits
+ * they were built from. A later step, whose hits are a subset of those
+ * because of the masking of the hits already used, keeps the doublets whose
+ * hits it still has; if its hits are not a subset, the doublets are rebuilt. <BR>
+ *
+ * Only the pixel layers are cached: their hits are the ones of the event
+ * collection in all steps, while strip hits may be copies owned by the
+ * SeedingLayerSetsHits of each step.
+ */
+
+#include "DataFormats/TrackerRecHit2D/interface/BaseTrackerRecHit.h"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class DetLayer;
+class TrackingRegion;
+
+class HitDoubletsCache {
+public:
+  using Hit = BaseTrackerRecHit const *;
+  using Hits = std::vector<Hit>;
+  using Doublets = std::vector<std::pair<Hit,Hit>>;   // (inner, outer)
+
+  struct Entry {
+    Hits innerHits;             // hits the doublets were built from, sorted by address
+    Hits outerHits;
+    Doublets doublets;
+  };
+
+  /// the key of the doublets of a layer pair for a region
+  static std::string key(const std::string & innerLayer, const std::string & outerLayer, const TrackingRegion & region);
+
+  /// whether the doublets of a layer pair can be cached
+  static bool cacheable(const DetLayer * innerLayer, const DetLayer * outerLayer);
+
+  /// the doublets stored for a key, or nullptr
+  const Entry * find(const std::string & key) const;
+
+  /// store the doublets for a key; the first ones stored are kept
+  void insert(const std::string & key, Entry && entry);
+
+  std::size_t size() const { return theEntries.size(); }
+  bool empty() const { return theEntries.empty(); }
+
+private:
+  std::unordered_map<std::string, Entry> theEntries;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef HitRZCheckKernel_H
+#define HitRZCheckKernel_H
+
+/** Checks the compatibility of the hits of a phi window with the r-z
+ *  constraint given by a HitRZCompatibility.
+ *  The concrete algorithm is a template argument, so that its range()
+ *  is inlined; the loop runs over the SoA coordinates of the hits with
+ *  no branches and is vectorized by the compiler.
+ */
+
+#include "RecoTracker/TkTrackingRegions/interface/HitRZCompatibility.h"
+#include "RecoTracker/TkTrackingRegions/interface/HitEtaCheck.h"
+#include "RecoTracker/TkTrackingRegions/interface/HitRCheck.h"
+#include "RecoTracker/TkTrackingRegions/interface/HitZCheck.h"
+#include "RecoTracker/TkHitPairs/interface/RecHitsSortedInPhi.h"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+
+template<typename Algo>
+struct HitRZCheckKernel {
+  using  Base = HitRZCompatibility;
+  void set(Base const * a) {
+    assert( a->algo()==Algo::me);
+    checkRZ=reinterpret_cast<Algo const *>(a);
+  }
+
+  // ok[i-b] is true if the hit i in [b,e) is compatible;
+  // u is the coordinate the allowed range is computed at, v the one it constrains
+  void operator()(int b, int e,
+		  float const * __restrict__ u, float const * __restrict__ v, float const * __restrict__ dv,
+		  bool * __restrict__ ok) const {
+    constexpr float nSigmaRZ = 3.46410161514f; // std::sqrt(12.f);
+    for (int i=b; i<e; ++i) {
+      auto allowed = checkRZ->range(u[i]);
+      float vErr = nSigmaRZ * dv[i];
+      // same as ! allowed.intersection(Range(v-vErr,v+vErr)).empty()
+      float lo = std::max(allowed.min(), v[i]-vErr);
+      float hi = std::min(allowed.max(), v[i]+vErr);
+      ok[i-b] = !(hi < lo);
+    }
+  }
+
+  void operator()(int b, int e, const RecHitsSortedInPhi & innerHitsMap, bool * ok) const {
+    (*this)(b, e, innerHitsMap.u.data(), innerHitsMap.v.data(), innerHitsMap.dv.data(), ok);
+  }
+
+  Algo const * checkRZ;
+};
+
+template<typename ... Args> using HitRZCheckKernels = std::tuple<HitRZCheckKernel<Args>...>;
+
+#endif
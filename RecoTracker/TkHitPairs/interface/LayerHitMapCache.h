@@ -7,6 +7,7 @@
 
 #include "RecoTracker/TkTrackingRegions/interface/TrackingRegion.h"
 #include "RecoTracker/TkHitPairs/interface/RecHitsSortedInPhi.h"
+#include "RecoTracker/TkHitPairs/interface/HitDoubletsCache.h"
 #include "TrackingTools/TransientTrackingRecHit/interface/SeedingLayerSetsHits.h"
 #include "FWCore/Framework/interface/EventSetup.h"
 
@@ -41,9 +42,25 @@ private:
 private:
   typedef SimpleCache Cache;
 public:
-  LayerHitMapCache(unsigned int initSize=50) : theCache(initSize) { }
+  LayerHitMapCache(unsigned int initSize=50) : theCache(initSize), theDoubletOutput(nullptr) { }
 
   void clear() { theCache.clear(); }
+
+  /// doublets built by earlier seeding steps, and the store for those built here;
+  /// unlike the hit maps they are kept for the whole event
+  void setDoubletCache(const std::vector<const HitDoubletsCache *> & input, HitDoubletsCache * output) {
+    theDoubletInput = input;
+    theDoubletOutput = output;
+  }
+  bool usesDoubletCache() const { return theDoubletOutput != nullptr || !theDoubletInput.empty(); }
+  const HitDoubletsCache::Entry * cachedDoublets(const std::string & key) const {
+    for (auto cache : theDoubletInput) {
+      auto entry = cache->find(key);
+      if (entry) return entry;
+    }
+    return nullptr;
+  }
+  HitDoubletsCache * doubletOutput() const { return theDoubletOutput; }
   
   const RecHitsSortedInPhi &
   operator()(const SeedingLayerSetsHits::SeedingLayer& layer, const TrackingRegion & region,
@@ -66,6 +83,8 @@ public:
 
 private:
   Cache theCache; 
+  std::vector<const HitDoubletsCache *> theDoubletInput;
+  HitDoubletsCache * theDoubletOutput;
 };
 
 #endif
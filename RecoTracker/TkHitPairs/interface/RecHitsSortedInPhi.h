@@ -6,6 +6,7 @@
 
 #include <vector>
 #include<array>
+#include <ostream>
 
 /** A RecHit container sorted in phi.
  *  Provides fast access for hits in a given phi window
@@ -83,8 +84,11 @@ public:
     return Range(theHits.begin(), theHits.end());
   }
 
+  // write the coordinates of the hits, one per line, in the format read by test/hitPairKernel_bench.cpp
+  void dump(std::ostream & out) const;
+
 public:
-  float       phi(int i) const { return theHits[i].phi();}
+  float       phi(int i) const { return phis[i];}
   float        gv(int i) const { return isBarrel ? z[i] : gp(i).perp();}  // global v
   float        rv(int i) const { return isBarrel ? u[i] : v[i];}  // dispaced r
   GlobalPoint gp(int i) const { return GlobalPoint(x[i],y[i],z[i]);}
@@ -98,6 +102,9 @@ public:
   DetLayer const * layer;
   bool isBarrel;
 
+  // the coordinates are stored in parallel arrays, in the order of theHits,
+  // so that the hits of a phi window can be processed by vectorized loops
+  std::vector<float> phis;  // same as theHits[i].phi(), searched by doubleRange
   std::vector<float> x;
   std::vector<float> y;
   std::vector<float> z;
@@ -147,6 +154,7 @@ public:
 
   DetLayer const * detLayer(layer l) const { return layers[l]->layer; }
 
+  int      index(int i, layer l) const { return indeces[2*i+l];}  // of the hit in its RecHitsSortedInPhi
   Hit const & hit(int i, layer l) const { return layers[l]->theHits[indeces[2*i+l]].hit();}
   float       phi(int i, layer l) const { return layers[l]->phi(indeces[2*i+l]);}
   float       rv(int i, layer l) const { return layers[l]->rv(indeces[2*i+l]);}
@@ -0,0 +1,32 @@
+#include "RecoTracker/TkHitPairs/interface/HitDoubletsCache.h"
+#include "RecoTracker/TkTrackingRegions/interface/TrackingRegion.h"
+#include "TrackingTools/DetLayers/interface/DetLayer.h"
+#include "Geometry/CommonDetUnit/interface/GeomDetEnumerators.h"
+
+#include <limits>
+#include <sstream>
+
+std::string HitDoubletsCache::key(const std::string & innerLayer, const std::string & outerLayer, const TrackingRegion & region) {
+  // print() describes the region, with the base parameters repeated at full precision
+  std::ostringstream str;
+  str.precision(std::numeric_limits<float>::max_digits10);
+  str << innerLayer << '+' << outerLayer << ' ' << region.print()
+      << " vtx:" << region.origin().x() << ',' << region.origin().y() << ',' << region.origin().z()
+      << " dr:" << region.originRBound() << " dz:" << region.originZBound()
+      << " dir:" << region.direction().x() << ',' << region.direction().y() << ',' << region.direction().z()
+      << " invpt:" << region.invPtRange().min() << ',' << region.invPtRange().max();
+  return str.str();
+}
+
+bool HitDoubletsCache::cacheable(const DetLayer * innerLayer, const DetLayer * outerLayer) {
+  return GeomDetEnumerators::isTrackerPixel(innerLayer->subDetector()) && GeomDetEnumerators::isTrackerPixel(outerLayer->subDetector());
+}
+
+const HitDoubletsCache::Entry * HitDoubletsCache::find(const std::string & key) const {
+  auto found = theEntries.find(key);
+  return found == theEntries.end() ? nullptr : & found->second;
+}
+
+void HitDoubletsCache::insert(const std::string & key, Entry && entry) {
+  theEntries.emplace(key, std::move(entry));
+}
@@ -9,10 +9,15 @@
 #include "RecoTracker/TkTrackingRegions/interface/TrackingRegion.h"
 #include "RecoTracker/TkTrackingRegions/interface/TrackingRegionBase.h"
 #include "RecoTracker/TkHitPairs/interface/OrderedHitPairs.h"
+#include "RecoTracker/TkHitPairs/interface/HitRZCheckKernel.h"
+#include "RecoTracker/TkHitPairs/interface/HitDoubletsCache.h"
 #include "RecoTracker/TkHitPairs/src/InnerDeltaPhi.h"
 
 #include "FWCore/Framework/interface/Event.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 using namespace GeomDetEnumerators;
 using namespace std;
 
@@ -20,6 +25,42 @@ typedef PixelRecoRange<float> Range;
 
 namespace {
   template<class T> inline T sqr( T t) {return t*t;}
+
+  // the hits of a map, sorted by address
+  HitDoubletsCache::Hits sortedHits(const RecHitsSortedInPhi & hits) {
+    HitDoubletsCache::Hits result; result.reserve(hits.size());
+    for (auto const & h : hits.theHits) result.push_back(h.hit());
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  // fill the doublets from the cached ones whose hits are in the maps;
+  // fails, leaving the result empty, if the maps have hits the doublets were not built from
+  bool doubletsFromCache(const HitDoubletsCache::Entry & cached,
+			 const RecHitsSortedInPhi & innerHitsMap, const RecHitsSortedInPhi & outerHitsMap,
+			 HitDoublets & result) {
+    auto index = [](const RecHitsSortedInPhi & hits, const HitDoubletsCache::Hits & cachedHits,
+		    std::unordered_map<HitDoubletsCache::Hit,int> & map) {
+      map.reserve(hits.size());
+      for (int i=0; i!=int(hits.size()); ++i) {
+	auto h = hits.theHits[i].hit();
+	if (!std::binary_search(cachedHits.begin(), cachedHits.end(), h)) return false;
+	map.emplace(h,i);
+      }
+      return true;
+    };
+    std::unordered_map<HitDoubletsCache::Hit,int> innerIndex, outerIndex;
+    if (!index(innerHitsMap, cached.innerHits, innerIndex) || !index(outerHitsMap, cached.outerHits, outerIndex))
+      return false;
+    for (auto const & d : cached.doublets) {
+      auto i = innerIndex.find(d.first);
+      if (i==innerIndex.end()) continue;
+      auto o = outerIndex.find(d.second);
+      if (o==outerIndex.end()) continue;
+      result.add(i->second, o->second);
+    }
+    return true;
+  }
 }
 
 
@@ -42,38 +83,6 @@ HitPairGeneratorFromLayerPair::HitPairGeneratorFromLayerPair(
 }
 
 
-// devirtualizer
-#include<tuple>
-namespace {
-
-  template<typename Algo>
-  struct Kernel {
-    using  Base = HitRZCompatibility;
-    void set(Base const * a) {
-      assert( a->algo()==Algo::me);
-      checkRZ=reinterpret_cast<Algo const *>(a);
-    }
-    
-    void operator()(int b, int e, const RecHitsSortedInPhi & innerHitsMap, bool * ok) const {
-      constexpr float nSigmaRZ = 3.46410161514f; // std::sqrt(12.f);
-      for (int i=b; i!=e; ++i) {
-	Range allowed = checkRZ->range(innerHitsMap.u[i]);
-	float vErr = nSigmaRZ * innerHitsMap.dv[i];
-	Range hitRZ(innerHitsMap.v[i]-vErr, innerHitsMap.v[i]+vErr);
-	Range crossRange = allowed.intersection(hitRZ);
-	ok[i-b] = ! crossRange.empty() ;
-      }
-    }
-    Algo const * checkRZ;
-    
-  };
-
-
-  template<typename ... Args> using Kernels = std::tuple<Kernel<Args>...>;
-
-}
-
-
 void HitPairGeneratorFromLayerPair::hitPairs(
 					     const TrackingRegion & region, OrderedHitPairs & result,
 					     const edm::Event& iEvent, const edm::EventSetup& iSetup) {
@@ -107,6 +116,28 @@ HitDoublets HitPairGeneratorFromLayerPair::doublets( const TrackingRegion& regio
 
   HitDoublets result(innerHitsMap,outerHitsMap); result.reserve(std::max(innerHitsMap.size(),outerHitsMap.size()));
 
+  // reuse the doublets built by an earlier seeding step on the same layers and region
+  std::string cacheKey;
+  bool useCache = theLayerCache.usesDoubletCache() &&
+    HitDoubletsCache::cacheable(innerLayerObj.detLayer(), outerLayerObj.detLayer());
+  if (useCache) {
+    cacheKey = HitDoubletsCache::key(innerLayerObj.name(), outerLayerObj.name(), region);
+    const HitDoubletsCache::Entry * cached = theLayerCache.cachedDoublets(cacheKey);
+    if (cached && doubletsFromCache(*cached, innerHitsMap, outerHitsMap, result)) {
+      LogDebug("HitPairGeneratorFromLayerPair")<<" got "<<result.size()<<" out of "<<cached->doublets.size()<<" cached pairs";
+      if (theMaxElement!=0 && result.size() > theMaxElement){
+	result.clear();
+	edm::LogError("TooManyPairs")<<"number of pairs exceed maximum, no pairs produced";
+	return result;
+      }
+      // the cached doublets stay valid for the steps that follow
+      if (theLayerCache.doubletOutput())
+	theLayerCache.doubletOutput()->insert(cacheKey, HitDoubletsCache::Entry(*cached));
+      result.shrink_to_fit();
+      return result;
+    }
+  }
+
   InnerDeltaPhi deltaPhi(*outerLayerObj.detLayer(), *innerLayerObj.detLayer(), region, iSetup);
 
   // std::cout << "layers " << theInnerLayer.detLayer()->seqNum()  << " " << outerLayer.detLayer()->seqNum() << std::endl;
@@ -130,7 +161,7 @@ HitDoublets HitPairGeneratorFromLayerPair::doublets( const TrackingRegion& regio
 						       );
     if(!checkRZ) continue;
 
-    Kernels<HitZCheck,HitRCheck,HitEtaCheck> kernels;
+    HitRZCheckKernels<HitZCheck,HitRCheck,HitEtaCheck> kernels;
 
     auto innerRange = innerHitsMap.doubleRange(phiRange.min(), phiRange.max());
     LogDebug("HitPairGeneratorFromLayerPair")<<
@@ -167,6 +198,17 @@ HitDoublets HitPairGeneratorFromLayerPair::doublets( const TrackingRegion& regio
     delete checkRZ;
   }
   LogDebug("HitPairGeneratorFromLayerPair")<<" total number of pairs provided back: "<<result.size();
+
+  if (useCache && theLayerCache.doubletOutput()) {
+    HitDoubletsCache::Entry entry;
+    entry.innerHits = sortedHits(innerHitsMap);
+    entry.outerHits = sortedHits(outerHitsMap);
+    entry.doublets.reserve(result.size());
+    for (std::size_t i=0; i!=result.size(); ++i)
+      entry.doublets.emplace_back(result.hit(i,HitDoublets::inner), result.hit(i,HitDoublets::outer));
+    theLayerCache.doubletOutput()->insert(cacheKey, std::move(entry));
+  }
+
   result.shrink_to_fit();
   return result;
 }
@@ -9,6 +9,7 @@
 RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint const & origin, DetLayer const * il) :
   layer(il),
   isBarrel(il->isBarrel()),
+  phis(hits.size()),
   x(hits.size()),y(hits.size()),z(hits.size()),drphi(hits.size()),
   u(hits.size()),v(hits.size()),du(hits.size()),dv(hits.size()),
   lphi(hits.size())
@@ -18,6 +19,7 @@ RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint
   // cosmic region never used here
   // assert(origin.x()==0 && origin.y()==0);
 
+  theHits.reserve(hits.size());
   for (std::vector<Hit>::const_iterator i=hits.begin(); i!=hits.end(); i++) {
     theHits.push_back(HitWithPhi(*i));
   }
@@ -34,6 +36,7 @@ RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint
     float dz = gs.errorZ;
     // r[i] = gs.position.perp();
     // phi[i] = gs.position.barePhi();
+    phis[i] = theHits[i].phi();
     x[i] = gs.position.x();
     y[i] = gs.position.y();
     z[i] = lz;
@@ -48,29 +51,37 @@ RecHitsSortedInPhi::RecHitsSortedInPhi(const std::vector<Hit>& hits, GlobalPoint
 }
 
 
+namespace {
+  // indices of the hits in [phiMin,phiMax], with -pi <= phiMin < phiMax <= pi
+  inline std::pair<int,int> indexRange(std::vector<float> const & phis, float phiMin, float phiMax) {
+    auto low = std::lower_bound(phis.begin(), phis.end(), phiMin);
+    auto high = std::upper_bound(low, phis.end(), phiMax);
+    return std::make_pair(int(low-phis.begin()), int(high-phis.begin()));
+  }
+}
+
 RecHitsSortedInPhi::DoubleRange RecHitsSortedInPhi::doubleRange(float phiMin, float phiMax) const {
-  Range r1,r2;
+  std::pair<int,int> r1,r2;
   if ( phiMin < phiMax) {
     if ( phiMin < -Geom::fpi()) {
-      r1 = unsafeRange( phiMin + Geom::ftwoPi(), Geom::fpi());
-      r2 = unsafeRange( -Geom::fpi(), phiMax);
+      r1 = indexRange( phis, phiMin + Geom::ftwoPi(), Geom::fpi());
+      r2 = indexRange( phis, -Geom::fpi(), phiMax);
     }
     else if (phiMax > Geom::pi()) {
-     r1 = unsafeRange( phiMin, Geom::fpi());
-     r2 = unsafeRange( -Geom::fpi(), phiMax-Geom::ftwoPi());
+     r1 = indexRange( phis, phiMin, Geom::fpi());
+     r2 = indexRange( phis, -Geom::fpi(), phiMax-Geom::ftwoPi());
     }
     else {
-      r1 = unsafeRange( phiMin, phiMax);
-      r2 = Range(theHits.begin(),theHits.begin());
+      r1 = indexRange( phis, phiMin, phiMax);
+      r2 = std::make_pair(0,0);
     }
   }
   else {
-    r1 =unsafeRange( phiMin, Geom::fpi());
-    r2 =unsafeRange( -Geom::fpi(), phiMax);
+    r1 =indexRange( phis, phiMin, Geom::fpi());
+    r2 =indexRange( phis, -Geom::fpi(), phiMax);
   }
 
-  return (DoubleRange){{int(r1.first-theHits.begin()),int(r1.second-theHits.begin())
-	,int(r2.first-theHits.begin()),int(r2.second-theHits.begin())}};
+  return (DoubleRange){{r1.first,r1.second,r2.first,r2.second}};
 }
 
 
@@ -105,7 +116,15 @@ std::vector<RecHitsSortedInPhi::Hit> RecHitsSortedInPhi::hits( float phiMin, flo
 RecHitsSortedInPhi::Range 
 RecHitsSortedInPhi::unsafeRange( float phiMin, float phiMax) const
 {
-  auto low = std::lower_bound( theHits.begin(), theHits.end(), HitWithPhi(phiMin), HitLessPhi());
-  return Range( low,
-	       std::upper_bound(low, theHits.end(), HitWithPhi(phiMax), HitLessPhi()));
+  auto r = indexRange( phis, phiMin, phiMax);
+  return Range( theHits.begin()+r.first, theHits.begin()+r.second);
+}
+
+void RecHitsSortedInPhi::dump(std::ostream & out) const
+{
+  // one header line per layer, then: phi u v du dv drphi x y z
+  out << "layer " << (isBarrel ? "barrel " : "forward ") << theHits.size() << '\n';
+  for (unsigned int i=0; i!=theHits.size(); ++i)
+    out << phis[i] << ' ' << u[i] << ' ' << v[i] << ' ' << du[i] << ' ' << dv[i] << ' '
+	<< drphi[i] << ' ' << x[i] << ' ' << y[i] << ' ' << z[i] << '\n';
 }
@@ -0,0 +1,8 @@
+#include "RecoTracker/TkHitPairs/interface/HitDoubletsCache.h"
+#include "DataFormats/Common/interface/Wrapper.h"
+
+namespace RecoTracker_TkHitPairs {
+  struct dictionary {
+    edm::Wrapper<HitDoubletsCache> whdc;
+  };
+}
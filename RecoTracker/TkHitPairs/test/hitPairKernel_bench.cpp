@@ -0,0 +1,190 @@
+// Microbenchmark of the doublet search of HitPairGeneratorFromLayerPair:
+// the phi window search and the r-z compatibility check of its inner hits.
+//
+//   hitPairKernel_bench [layers.txt ...]
+//
+// The input files hold pairs of layers (inner, then outer) as written by
+// RecHitsSortedInPhi::dump(); without input, a pair of barrel pixel layers
+// with the occupancy of a central PbPb event is generated.
+// The vectorized kernel is compared to the scalar check it replaces.
+
+#include "RecoTracker/TkHitPairs/interface/HitRZCheckKernel.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  typedef PixelRecoRange<float> Range;
+
+  struct Layer {
+    bool isBarrel = true;
+    std::vector<float> phi, u, v, du, dv;
+    std::vector<RecHitsSortedInPhi::HitWithPhi> aos;   // the former layout, for the phi search
+
+    void sort() {
+      std::vector<int> index(phi.size());
+      for (unsigned int i=0; i!=index.size(); ++i) index[i]=i;
+      std::sort(index.begin(), index.end(), [&](int a, int b) { return phi[a] < phi[b]; });
+      auto reorder = [&](std::vector<float> & a) {
+	std::vector<float> t(a.size());
+	for (unsigned int i=0; i!=index.size(); ++i) t[i]=a[index[i]];
+	a.swap(t);
+      };
+      reorder(phi); reorder(u); reorder(v); reorder(du); reorder(dv);
+      aos.clear();
+      for (auto p : phi) aos.emplace_back(p);
+    }
+  };
+
+  bool readLayer(std::istream & in, Layer & layer) {
+    std::string tag, type;
+    unsigned int n;
+    if (!(in >> tag >> type >> n) || tag!="layer") return false;
+    layer.isBarrel = (type=="barrel");
+    float phi, u, v, du, dv, drphi, x, y, z;
+    for (unsigned int i=0; i!=n; ++i) {
+      if (!(in >> phi >> u >> v >> du >> dv >> drphi >> x >> y >> z)) return false;
+      layer.phi.push_back(phi); layer.u.push_back(u); layer.v.push_back(v);
+      layer.du.push_back(du); layer.dv.push_back(dv);
+    }
+    layer.sort();
+    return true;
+  }
+
+  Layer barrelLayer(std::mt19937 & gen, unsigned int n, float r, float halfLength) {
+    std::uniform_real_distribution<float> phi(-M_PI, M_PI), z(-halfLength, halfLength), err(0.001f, 0.01f);
+    Layer layer;
+    for (unsigned int i=0; i!=n; ++i) {
+      layer.phi.push_back(phi(gen)); layer.u.push_back(r); layer.v.push_back(z(gen));
+      layer.du.push_back(0.f); layer.dv.push_back(err(gen));
+    }
+    layer.sort();
+    return layer;
+  }
+
+  // indices of the hits in the window, split in two at +-pi as done by RecHitsSortedInPhi::doubleRange
+  template<typename V, typename Less>
+  std::array<int,4> window(V const & hits, float phiMin, float phiMax, Less less) {
+    auto range = [&](float a, float b) {
+      auto low = std::lower_bound(hits.begin(), hits.end(), a, less);
+      auto high = std::upper_bound(low, hits.end(), b, [&](float x, typename V::value_type const & h) { return less(x,h); });
+      return std::make_pair(int(low-hits.begin()), int(high-hits.begin()));
+    };
+    std::pair<int,int> r1, r2(0,0);
+    if (phiMin < -float(M_PI)) {
+      r1 = range(phiMin+2*float(M_PI), M_PI); r2 = range(-M_PI, phiMax);
+    } else if (phiMax > float(M_PI)) {
+      r1 = range(phiMin, M_PI); r2 = range(-M_PI, phiMax-2*float(M_PI));
+    } else {
+      r1 = range(phiMin, phiMax);
+    }
+    return {{r1.first, r1.second, r2.first, r2.second}};
+  }
+
+  struct PhiLess {
+    bool operator()(float a, float b) const { return a < b; }
+    bool operator()(RecHitsSortedInPhi::HitWithPhi const & a, float b) const { return a.phi() < b; }
+    bool operator()(float a, RecHitsSortedInPhi::HitWithPhi const & b) const { return a < b.phi(); }
+  };
+
+  // r-z constraint of the inner hits given by the outer hit and a luminous region of +-15 cm
+  std::unique_ptr<HitRZCompatibility> checkRZ(Layer const & inner, Layer const & outer, int io) {
+    constexpr float zVertex = 15.f;
+    float ro = outer.isBarrel ? outer.u[io] : outer.v[io];
+    float zo = outer.isBarrel ? outer.v[io] : outer.u[io];
+    HitRZConstraint rz(PixelRecoPointRZ(0.f,-zVertex), (zo+zVertex)/ro, PixelRecoPointRZ(0.f,zVertex), (zo-zVertex)/ro);
+    if (inner.isBarrel) return std::unique_ptr<HitRZCompatibility>(new HitZCheck(rz));
+    return std::unique_ptr<HitRZCompatibility>(new HitRCheck(rz));
+  }
+
+  // the check as done before, through the virtual interface and PixelRecoRange
+  void scalarCheck(HitRZCompatibility const * check, Layer const & layer, int b, int e, bool * ok) {
+    constexpr float nSigmaRZ = 3.46410161514f;
+    for (int i=b; i!=e; ++i) {
+      Range allowed = check->range(layer.u[i]);
+      float vErr = nSigmaRZ * layer.dv[i];
+      Range hitRZ(layer.v[i]-vErr, layer.v[i]+vErr);
+      ok[i-b] = ! allowed.intersection(hitRZ).empty();
+    }
+  }
+
+  void vectorCheck(HitRZCompatibility const * check, Layer const & layer, int b, int e, bool * ok) {
+    if (check->algo()==HitRZCompatibility::zAlgo) {
+      HitRZCheckKernel<HitZCheck> k; k.set(check);
+      k(b, e, layer.u.data(), layer.v.data(), layer.dv.data(), ok);
+    } else {
+      HitRZCheckKernel<HitRCheck> k; k.set(check);
+      k(b, e, layer.u.data(), layer.v.data(), layer.dv.data(), ok);
+    }
+  }
+
+  // run the doublet search, return the number of doublets and the time spent in search and check
+  template<typename Search, typename Check>
+  long run(Layer const & inner, Layer const & outer, Search search, Check check, double & tSearch, double & tCheck) {
+    constexpr float dphi = 0.05f;
+    long found = 0;
+    std::unique_ptr<bool[]> ok(new bool[inner.phi.size()+1]);
+    for (unsigned int io=0; io!=outer.phi.size(); ++io) {
+      auto rz = checkRZ(inner, outer, io);
+      auto t0 = std::chrono::steady_clock::now();
+      std::array<int,4> w = search(outer.phi[io]-dphi, outer.phi[io]+dphi);
+      auto t1 = std::chrono::steady_clock::now();
+      for (int j=0; j<3; j+=2) {
+	check(rz.get(), inner, w[j], w[j+1], ok.get());
+	for (int i=0; i!=w[j+1]-w[j]; ++i) found += ok[i];
+      }
+      auto t2 = std::chrono::steady_clock::now();
+      tSearch += std::chrono::duration<double>(t1-t0).count();
+      tCheck  += std::chrono::duration<double>(t2-t1).count();
+    }
+    return found;
+  }
+
+}
+
+int main(int argc, char ** argv) {
+  std::vector<Layer> layers;
+  for (int i=1; i<argc; ++i) {
+    std::ifstream in(argv[i]);
+    Layer layer;
+    while (readLayer(in, layer)) { layers.push_back(std::move(layer)); layer = Layer(); }
+  }
+  if (layers.empty()) {
+    std::mt19937 gen(42);
+    layers.push_back(barrelLayer(gen, 8000, 4.4f, 26.7f));
+    layers.push_back(barrelLayer(gen, 6000, 7.3f, 26.7f));
+  }
+
+  constexpr int repeat = 5;
+  int status = 0;
+  for (unsigned int l=0; l+1<layers.size(); l+=2) {
+    Layer const & inner = layers[l];
+    Layer const & outer = layers[l+1];
+    double tAoS=0, tSoA=0, tScalar=0, tVector=0;
+    long nScalar=0, nVector=0;
+    for (int r=0; r!=repeat; ++r) {
+      nScalar = run(inner, outer, [&](float a, float b) { return window(inner.aos, a, b, PhiLess()); }, scalarCheck, tAoS, tScalar);
+      nVector = run(inner, outer, [&](float a, float b) { return window(inner.phi, a, b, PhiLess()); }, vectorCheck, tSoA, tVector);
+    }
+    double pairs = double(repeat) * outer.phi.size();
+    std::cout << "layers " << l << ' ' << l+1 << ": " << inner.phi.size() << " x " << outer.phi.size() << " hits, "
+	      << nVector << " doublets\n"
+	      << "  phi search  [ns/outer hit]  AoS " << 1.e9*tAoS/pairs << "  SoA " << 1.e9*tSoA/pairs << '\n'
+	      << "  r-z check   [ns/outer hit]  scalar " << 1.e9*tScalar/pairs << "  vectorized " << 1.e9*tVector/pairs << std::endl;
+    if (nScalar != nVector) {
+      std::cerr << "  MISMATCH: " << nScalar << " doublets with the scalar check" << std::endl;
+      status = 1;
+    }
+  }
+  return status;
+}
@@ -0,0 +1,186 @@
+#include "CAHitQuadrupletGenerator.h"
+
+#include "RecoTracker/TkHitPairs/interface/HitPairGeneratorFromLayerPair.h"
+#include "RecoTracker/TkHitPairs/interface/RecHitsSortedInPhi.h"
+#include "RecoTracker/TkTrackingRegions/interface/TrackingRegion.h"
+#include "RecoTracker/TkMSParametrization/interface/PixelRecoUtilities.h"
+#include "TrackingTools/TransientTrackingRecHit/interface/SeedingLayerSetsHits.h"
+#include "FWCore/Framework/interface/ConsumesCollector.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "DataFormats/Common/interface/Handle.h"
+
+#include <cmath>
+#include <deque>
+#include <map>
+
+namespace {
+  // the cells of a layer pair of a set, with their inner neighbours in the previous pair
+  struct CellLayer {
+    HitDoublets const * doublets = nullptr;
+    std::vector<std::vector<int> > innerNeighbours;
+    std::vector<int> state;
+    std::vector<bool> used;
+  };
+}
+
+CAHitQuadrupletGenerator::CAHitQuadrupletGenerator(const edm::ParameterSet& cfg, edm::ConsumesCollector& iC):
+  theSeedingLayerToken(iC.consumes<SeedingLayerSetsHits>(cfg.getParameter<edm::InputTag>("SeedingLayers"))),
+  theThetaCut(cfg.getParameter<double>("thetaCut")),
+  theDcaCut(cfg.getParameter<double>("dcaCut")),
+  theHardPtCut(cfg.existsAs<double>("hardPtCut") ? cfg.getParameter<double>("hardPtCut") : 0.),
+  theKeepTriplets(cfg.existsAs<bool>("keepTriplets") ? cfg.getParameter<bool>("keepTriplets") : false)
+{
+  theMaxElement = cfg.existsAs<unsigned int>("maxElement") ? cfg.getParameter<unsigned int>("maxElement") : 0;
+}
+
+CAHitQuadrupletGenerator::~CAHitQuadrupletGenerator() {}
+
+bool CAHitQuadrupletGenerator::areAlignedRZ(float r1, float z1, float r2, float z2, float r3, float z3, float ptMin) const
+{
+  // twice the area of the triangle is the product of two sides and the sine of the kink angle;
+  // the multiple scattering angle scales as 1/p, and p >= pt
+  float area = std::abs(z1*(r2-r3) + z2*(r3-r1) + z3*(r1-r2));
+  float d12 = std::sqrt((r2-r1)*(r2-r1) + (z2-z1)*(z2-z1));
+  float d23 = std::sqrt((r3-r2)*(r3-r2) + (z3-z2)*(z3-z2));
+  return area * ptMin <= theThetaCut * d12 * d23;
+}
+
+bool CAHitQuadrupletGenerator::haveSimilarCurvature(float x1, float y1, float x2, float y2, float x3, float y3,
+						    const TrackingRegion & region, float minRadius) const
+{
+  float ox = region.origin().x();
+  float oy = region.origin().y();
+  float ax = x2-x1, ay = y2-y1;
+  float bx = x3-x1, by = y3-y1;
+  float det = 2.f*(ax*by - ay*bx);
+  float a2 = ax*ax + ay*ay;
+  float b2 = bx*bx + by*by;
+
+  float dca;
+  if (std::abs(det) < 1.e-6f*std::sqrt(a2*b2)) {
+    // straight line
+    dca = std::abs(ax*(oy-y1) - ay*(ox-x1)) / std::sqrt(a2);
+  } else {
+    float cx = x1 + (by*a2 - ay*b2)/det;
+    float cy = y1 + (ax*b2 - bx*a2)/det;
+    float radius = std::sqrt((cx-x1)*(cx-x1) + (cy-y1)*(cy-y1));
+    if (radius < minRadius) return false;
+    dca = std::abs(std::sqrt((cx-ox)*(cx-ox) + (cy-oy)*(cy-oy)) - radius);
+  }
+  return dca <= region.originRBound() + theDcaCut;
+}
+
+void CAHitQuadrupletGenerator::hitSets(
+   const TrackingRegion& region, OrderedMultiHits & result,
+   const edm::Event& ev, const edm::EventSetup& es)
+{
+  edm::Handle<SeedingLayerSetsHits> hlayers;
+  ev.getByToken(theSeedingLayerToken, hlayers);
+  const SeedingLayerSetsHits& layers = *hlayers;
+  if(layers.numberOfLayersInSet() != 4)
+    throw cms::Exception("Configuration") << "CAHitQuadrupletGenerator expects SeedingLayerSetsHits::numberOfLayersInSet() to be 4, got " << layers.numberOfLayersInSet();
+
+  const float ptMin = region.ptMin();
+  const float minRadius = theHardPtCut > 0 ? PixelRecoUtilities::bendingRadius(theHardPtCut, es) : 0.f;
+  const float ox = region.origin().x();
+  const float oy = region.origin().y();
+  auto radius = [&](HitDoublets const & d, int i, HitDoublets::layer l) {
+    float x = d.x(i,l)-ox, y = d.y(i,l)-oy;
+    return std::sqrt(x*x + y*y);
+  };
+
+  // the doublets of each layer pair, built once for all the sets sharing it
+  std::deque<HitDoublets> allDoublets;
+  std::map<std::pair<SeedingLayerSetsHits::LayerIndex,SeedingLayerSetsHits::LayerIndex>, HitDoublets const *> doubletsOfPair;
+
+  for(SeedingLayerSetsHits::SeedingLayerSet layerSet: layers) {
+    CellLayer cells[3];
+    for (int p=0; p!=3; ++p) {
+      auto key = std::make_pair(layerSet[p].index(), layerSet[p+1].index());
+      auto found = doubletsOfPair.find(key);
+      if (found == doubletsOfPair.end()) {
+	HitPairGeneratorFromLayerPair pairGenerator(p, p+1, &theLayerCache);
+	pairGenerator.setSeedingLayers(layerSet);
+	allDoublets.emplace_back(pairGenerator.doublets(region, ev, es));
+	found = doubletsOfPair.emplace(key, &allDoublets.back()).first;
+      }
+      cells[p].doublets = found->second;
+      cells[p].innerNeighbours.resize(found->second->size());
+      cells[p].state.assign(found->second->size(), 0);
+      cells[p].used.assign(found->second->size(), false);
+    }
+
+    // connect the cells of consecutive pairs sharing a hit, and evolve:
+    // the state of a cell is the length of the longest chain of inner neighbours ending on it
+    for (int p=1; p!=3; ++p) {
+      HitDoublets const & inner = *cells[p-1].doublets;
+      HitDoublets const & outer = *cells[p].doublets;
+      if (inner.empty() || outer.empty()) continue;
+
+      // the inner cells, by the index of their outer hit in the shared layer
+      int nHits = 0;
+      for (std::size_t i=0; i!=inner.size(); ++i) nHits = std::max(nHits, inner.index(i,HitDoublets::outer)+1);
+      std::vector<std::vector<int> > byHit(nHits);
+      for (std::size_t i=0; i!=inner.size(); ++i) byHit[inner.index(i,HitDoublets::outer)].push_back(i);
+
+      for (std::size_t o=0; o!=outer.size(); ++o) {
+	int shared = outer.index(o,HitDoublets::inner);
+	if (shared >= nHits) continue;
+	float r2 = radius(outer,o,HitDoublets::inner), z2 = outer.z(o,HitDoublets::inner);
+	float r3 = radius(outer,o,HitDoublets::outer), z3 = outer.z(o,HitDoublets::outer);
+	for (int i : byHit[shared]) {
+	  float r1 = radius(inner,i,HitDoublets::inner), z1 = inner.z(i,HitDoublets::inner);
+	  if (!areAlignedRZ(r1,z1,r2,z2,r3,z3,ptMin)) continue;
+	  if (!haveSimilarCurvature(inner.x(i,HitDoublets::inner), inner.y(i,HitDoublets::inner),
+				    outer.x(o,HitDoublets::inner), outer.y(o,HitDoublets::inner),
+				    outer.x(o,HitDoublets::outer), outer.y(o,HitDoublets::outer),
+				    region, minRadius)) continue;
+	  cells[p].innerNeighbours[o].push_back(i);
+	  cells[p].state[o] = std::max(cells[p].state[o], cells[p-1].state[i]+1);
+	}
+      }
+    }
+
+    // the quadruplets end on the outermost cells with a full chain
+    HitDoublets const & d0 = *cells[0].doublets;
+    HitDoublets const & d1 = *cells[1].doublets;
+    HitDoublets const & d2 = *cells[2].doublets;
+    for (std::size_t c3=0; c3!=d2.size(); ++c3) {
+      if (cells[2].state[c3] != 2) continue;
+      for (int c2 : cells[2].innerNeighbours[c3]) {
+	if (cells[1].state[c2] != 1) continue;
+	for (int c1 : cells[1].innerNeighbours[c2]) {
+	  result.emplace_back(d0.hit(c1,HitDoublets::inner), d0.hit(c1,HitDoublets::outer),
+			      d1.hit(c2,HitDoublets::outer), d2.hit(c3,HitDoublets::outer));
+	  cells[0].used[c1] = cells[1].used[c2] = cells[2].used[c3] = true;
+	}
+      }
+    }
+
+    // the triplets of the cells left over, on the three inner or the three outer layers
+    if (theKeepTriplets) {
+      for (int p=1; p!=3; ++p) {
+	HitDoublets const & inner = *cells[p-1].doublets;
+	HitDoublets const & outer = *cells[p].doublets;
+	for (std::size_t o=0; o!=outer.size(); ++o) {
+	  if (cells[p].used[o]) continue;
+	  for (int i : cells[p].innerNeighbours[o]) {
+	    if (cells[p-1].used[i]) continue;
+	    result.emplace_back(inner.hit(i,HitDoublets::inner), inner.hit(i,HitDoublets::outer), outer.hit(o,HitDoublets::outer));
+	  }
+	}
+      }
+    }
+
+    if (theMaxElement!=0 && result.size() > theMaxElement) {
+      result.clear();
+      edm::LogError("TooManyQuadruplets")<<"number of quadruplets exceeds maximum, no quadruplets produced";
+      break;
+    }
+  }
+  LogDebug("CAHitQuadrupletGenerator")<<"built "<<result.size()<<" hit sets from the doublets of "<<allDoublets.size()<<" layer pairs";
+
+  theLayerCache.clear();
+}
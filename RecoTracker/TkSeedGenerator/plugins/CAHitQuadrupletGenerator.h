@@ -0,0 +1,63 @@
+#ifndef CAHitQuadrupletGenerator_H
+#define CAHitQuadrupletGenerator_H
+
+/** A MultiHitGenerator building hit quadruplets with a cellular automaton,
+ *  in one pass instead of merging triplets afterwards.
+ *
+ *  For each set of four SeedingLayers the doublets of the three consecutive
+ *  layer pairs are taken from HitPairGeneratorFromLayerPair, built once per
+ *  layer pair even if several sets share it. Each doublet is a cell; a cell
+ *  is an inner neighbour of another if they share a hit and their three hits
+ *  are aligned in r-z and lie on a circle compatible with the region.
+ *  The evolution gives each cell the length of the longest chain of inner
+ *  neighbours ending on it, and the quadruplets are read back from the
+ *  outermost cells at the end of a full chain. Optionally the triplets of the
+ *  cells not used by any quadruplet are kept as well.
+ */
+
+#include "RecoTracker/TkSeedGenerator/interface/MultiHitGenerator.h"
+#include "RecoTracker/TkHitPairs/interface/LayerHitMapCache.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+
+class TrackingRegion;
+class HitDoublets;
+class dso_hidden SeedingLayerSetsHits;
+
+namespace edm { class Event; }
+namespace edm { class EventSetup; }
+
+class dso_hidden CAHitQuadrupletGenerator final : public MultiHitGenerator {
+public:
+  typedef LayerHitMapCache  LayerCacheType;
+
+public:
+
+  CAHitQuadrupletGenerator( const edm::ParameterSet& cfg, edm::ConsumesCollector& iC);
+
+  virtual ~CAHitQuadrupletGenerator();
+
+  /// from base class
+  void setDoubletCache(const std::vector<const HitDoubletsCache *> & input, HitDoubletsCache * output) override
+    { theLayerCache.setDoubletCache(input, output); }
+
+  /// from base class
+  virtual void hitSets( const TrackingRegion& reg, OrderedMultiHits & result,
+      const edm::Event & ev,  const edm::EventSetup& es);
+
+private:
+  // compatibility of the cells (h1,h2) and (h2,h3)
+  bool areAlignedRZ(float r1, float z1, float r2, float z2, float r3, float z3, float ptMin) const;
+  bool haveSimilarCurvature(float x1, float y1, float x2, float y2, float x3, float y3,
+			    const TrackingRegion & region, float minRadius) const;
+
+  edm::EDGetTokenT<SeedingLayerSetsHits> theSeedingLayerToken;
+
+  LayerCacheType            theLayerCache;
+
+  const float theThetaCut;      // maximum r-z kink angle times the minimum pt [rad GeV]
+  const float theDcaCut;        // transverse distance of closest approach to the region origin, beyond its radius [cm]
+  const float theHardPtCut;     // minimum pt of the circle through the three hits [GeV]
+  const bool  theKeepTriplets;
+};
+#endif
@@ -31,6 +31,10 @@ public:
 
   virtual ~CombinedMultiHitGenerator();
 
+  /// from base class
+  void setDoubletCache(const std::vector<const HitDoubletsCache *> & input, HitDoubletsCache * output) override
+    { theLayerCache.setDoubletCache(input, output); }
+
   /// from base class
   virtual void hitSets( const TrackingRegion& reg, OrderedMultiHits & result,
       const edm::Event & ev,  const edm::EventSetup& es);
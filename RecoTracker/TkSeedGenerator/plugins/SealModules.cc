@@ -22,6 +22,8 @@ DEFINE_EDM_PLUGIN(SeedCreatorFactory, SeedFromConsecutiveHitsTripletOnlyCreator,
 #include "RecoTracker/TkTrackingRegions/interface/OrderedHitsGenerator.h"
 #include "CombinedMultiHitGenerator.h"
 DEFINE_EDM_PLUGIN(OrderedHitsGeneratorFactory, CombinedMultiHitGenerator, "StandardMultiHitGenerator");
+#include "CAHitQuadrupletGenerator.h"
+DEFINE_EDM_PLUGIN(OrderedHitsGeneratorFactory, CAHitQuadrupletGenerator, "CAHitQuadrupletGenerator");
 
 
 #include "MultiHitGeneratorFromChi2.h"
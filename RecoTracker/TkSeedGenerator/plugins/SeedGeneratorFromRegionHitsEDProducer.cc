@@ -3,6 +3,8 @@
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/Framework/interface/ConsumesCollector.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "DataFormats/Common/interface/Handle.h"
 
 #include "DataFormats/TrajectorySeed/interface/TrajectorySeedCollection.h"
 
@@ -20,6 +22,7 @@
 #include "RecoTracker/TkSeedGenerator/interface/SeedCreator.h"
 
 #include "RecoTracker/TkSeedGenerator/interface/SeedGeneratorFromRegionHits.h"
+#include "RecoTracker/TkHitPairs/interface/HitDoubletsCache.h"
 #include "RecoPixelVertexing/PixelTriplets/interface/QuadrupletSeedMerger.h"
 
 
@@ -27,7 +30,9 @@ SeedGeneratorFromRegionHitsEDProducer::SeedGeneratorFromRegionHitsEDProducer(
     const edm::ParameterSet& cfg) 
   : theRegionProducer(nullptr),
     theClusterCheck(cfg.getParameter<edm::ParameterSet>("ClusterCheckPSet"),consumesCollector()),
-    theMerger_(nullptr)
+    theMerger_(nullptr),
+    theHitsGenerator(nullptr),
+    theProduceDoubletCache(false)
 {
   theSilentOnClusterCheck = cfg.getParameter<edm::ParameterSet>("ClusterCheckPSet").getUntrackedParameter<bool>("silentClusterCheck",false);
 
@@ -67,8 +72,19 @@ SeedGeneratorFromRegionHitsEDProducer::SeedGeneratorFromRegionHitsEDProducer(
   SeedCreator * aCreator = SeedCreatorFactory::get()->create( creatorName, creatorPSet);
 
   theGenerator.reset(new SeedGeneratorFromRegionHits(hitsGenerator, aComparitor, aCreator));
+  theHitsGenerator = hitsGenerator;
+
+  // hit doublets shared with the other seeding steps: those of the earlier steps are reused
+  // for the same pixel layer pairs and regions, and those built here are put in the event
+  if (cfg.existsAs<std::vector<edm::InputTag> >("doubletCaches")) {
+    for (auto const & tag : cfg.getParameter<std::vector<edm::InputTag> >("doubletCaches"))
+      theDoubletCacheTokens.push_back(consumes<HitDoubletsCache>(tag));
+  }
+  theProduceDoubletCache = cfg.existsAs<bool>("produceDoubletCache") ? cfg.getParameter<bool>("produceDoubletCache") : false;
 
   produces<TrajectorySeedCollection>();
+  if (theProduceDoubletCache)
+    produces<HitDoubletsCache>();
 }
 
 SeedGeneratorFromRegionHitsEDProducer::~SeedGeneratorFromRegionHitsEDProducer()
@@ -79,6 +95,7 @@ void SeedGeneratorFromRegionHitsEDProducer::produce(edm::Event& ev, const edm::E
 {
   std::auto_ptr<TrajectorySeedCollection> triplets(new TrajectorySeedCollection());
   std::auto_ptr<TrajectorySeedCollection> quadruplets( new TrajectorySeedCollection() );
+  std::auto_ptr<HitDoubletsCache> doubletCache( theProduceDoubletCache ? new HitDoubletsCache() : nullptr );
 
   //protection for big ass events...
   size_t clustsOrZero = theClusterCheck.tooManyClusters(ev);
@@ -86,9 +103,23 @@ void SeedGeneratorFromRegionHitsEDProducer::produce(edm::Event& ev, const edm::E
     if (!theSilentOnClusterCheck)
 	edm::LogError("TooManyClusters") << "Found too many clusters (" << clustsOrZero << "), bailing out.\n";
     ev.put(triplets);
+    if (theProduceDoubletCache)
+      ev.put(doubletCache);
     return ;
   }
 
+  // a missing cache only means the doublets are built here
+  std::vector<const HitDoubletsCache *> doubletCaches;
+  for (auto const & token : theDoubletCacheTokens) {
+    edm::Handle<HitDoubletsCache> hcache;
+    ev.getByToken(token, hcache);
+    if (hcache.isValid())
+      doubletCaches.push_back(hcache.product());
+    else
+      edm::LogWarning("SeedGeneratorFromRegionHitsEDProducer") << "A doublet cache was not found, its doublets are built instead";
+  }
+  theHitsGenerator->setDoubletCache(doubletCaches, doubletCache.get());
+
   typedef std::vector<TrackingRegion* > Regions;
   typedef Regions::const_iterator IR;
   Regions regions = theRegionProducer->regions(ev,es);
@@ -117,10 +148,15 @@ void SeedGeneratorFromRegionHitsEDProducer::produce(edm::Event& ev, const edm::E
 
   // clear memory
   for (IR ir=regions.begin(), irEnd=regions.end(); ir < irEnd; ++ir) delete (*ir);
+  theHitsGenerator->setDoubletCache(std::vector<const HitDoubletsCache *>(), nullptr);
 
   // put to event
   if ( theMerger_)
     ev.put(quadruplets);
   else
     ev.put(triplets);
+  if (theProduceDoubletCache) {
+    LogDebug("SeedGeneratorFromRegionHitsEDProducer") << "storing the doublets of " << doubletCache->size() << " layer pairs and regions";
+    ev.put(doubletCache);
+  }
 }
@@ -3,6 +3,7 @@
 
 #include "FWCore/Framework/interface/stream/EDProducer.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
 #include "RecoTracker/SpecialSeedGenerators/interface/ClusterChecker.h"
 
 namespace edm { class Event; class EventSetup; }
@@ -10,6 +11,8 @@ namespace edm { class Event; class EventSetup; }
 class SeedGeneratorFromRegionHits;
 class TrackingRegionProducer;
 class QuadrupletSeedMerger;
+class OrderedHitsGenerator;
+class HitDoubletsCache;
 
 class dso_hidden SeedGeneratorFromRegionHitsEDProducer : public edm::stream::EDProducer<> {
 public:
@@ -25,6 +28,10 @@ private:
   ClusterChecker theClusterCheck;
   std::unique_ptr<QuadrupletSeedMerger> theMerger_;
 
+  OrderedHitsGenerator * theHitsGenerator;  // owned by theGenerator
+  std::vector<edm::EDGetTokenT<HitDoubletsCache> > theDoubletCacheTokens;
+  bool theProduceDoubletCache;
+
   std::string moduleName;
 
   bool theSilentOnClusterCheck;
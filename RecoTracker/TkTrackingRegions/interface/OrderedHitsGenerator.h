@@ -5,6 +5,7 @@
 #include <vector>
 
 class TrackingRegion;
+class HitDoubletsCache;
 namespace edm { class Event; class EventSetup; class ConsumesCollector;}
 
 class OrderedHitsGenerator {
@@ -17,6 +18,10 @@ public:
 
   virtual void clear() { }  //fixme: should be purely virtual!
 
+  /// hit doublets built by earlier seeding steps, and the store for those built by this generator;
+  /// used only by the generators based on HitPairGeneratorFromLayerPair
+  virtual void setDoubletCache(const std::vector<const HitDoubletsCache *> & input, HitDoubletsCache * output) { }
+
   unsigned int theMaxElement;
 };
 
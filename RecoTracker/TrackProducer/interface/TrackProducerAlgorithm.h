@@ -55,7 +55,8 @@ public:
     algoName_(conf_.getParameter<std::string>( "AlgorithmName" )),
     algo_(reco::TrackBase::algoByName(algoName_)),
     reMatchSplitHits_(false),
-    usePropagatorForPCA_(false)
+    usePropagatorForPCA_(false),
+    parallelFit_(conf_.existsAs<bool>("parallelFit") && conf_.getParameter<bool>("parallelFit"))
       {
         geometricInnerState_ = (conf_.exists("GeometricInnerState") ?
 	  conf_.getParameter<bool>( "GeometricInnerState" ) : true);
@@ -141,6 +142,13 @@ public:
   bool reMatchSplitHits_;
   bool geometricInnerState_;
   bool usePropagatorForPCA_;
+  // fit the inputs in parallel; the products are in the same order as in the serial case
+  bool parallelFit_;
+
+  // call fit(i, products) for the n inputs, which adds the product of the i-th in products
+  // and returns whether the fit succeeded; returns the number of products
+  template <typename F>
+  int runFits(size_t n, AlgoProductCollection & algoResults, F fit) const;
 
   TrajectoryStateOnSurface getInitialState(const T * theT,
 					   TransientTrackingRecHit::RecHitContainer& hits,
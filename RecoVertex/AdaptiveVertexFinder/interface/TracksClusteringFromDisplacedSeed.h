@@ -52,6 +52,7 @@ class TracksClusteringFromDisplacedSeed {
         double 					clusterMaxSignificance;
         double 					distanceRatio;
         double 					clusterMinAngleCosine;
+        double 					clusterMaxAngle; // between the seed and the track directions, <=0: no cut
 
 
 };
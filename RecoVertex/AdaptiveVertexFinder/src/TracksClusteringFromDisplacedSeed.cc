@@ -1,4 +1,6 @@
 #include "RecoVertex/AdaptiveVertexFinder/interface/TracksClusteringFromDisplacedSeed.h"
+#include <algorithm>
+#include <cmath>
 //#define VTXDEBUG 1
 
 
@@ -11,7 +13,8 @@ TracksClusteringFromDisplacedSeed::TracksClusteringFromDisplacedSeed(const edm::
 	clusterMaxDistance(params.getParameter<double>("clusterMaxDistance")),
         clusterMaxSignificance(params.getParameter<double>("clusterMaxSignificance")), //3
         distanceRatio(params.getParameter<double>("distanceRatio")),//was clusterScale/densityFactor
-        clusterMinAngleCosine(params.getParameter<double>("clusterMinAngleCosine")) //0.0
+        clusterMinAngleCosine(params.getParameter<double>("clusterMinAngleCosine")), //0.0
+        clusterMaxAngle(params.existsAs<double>("clusterMaxAngle") ? params.getParameter<double>("clusterMaxAngle") : 0.)
 
 {
 	
@@ -103,6 +106,20 @@ std::vector<TracksClusteringFromDisplacedSeed::Cluster> TracksClusteringFromDisp
  
 	}
 
+        // with clusterMaxAngle the tracks are sorted in polar angle, so that only those in
+        // a window around a seed are compared with it: the angle between two directions
+        // is at least the difference of their polar angles
+        std::vector<std::pair<float,unsigned int> > byTheta;
+        if(clusterMaxAngle > 0) {
+                byTheta.reserve(selectedTracks.size());
+                for(unsigned int j = 0; j < selectedTracks.size(); j++)
+                  byTheta.emplace_back(selectedTracks[j].impactPointState().globalDirection().theta(), j);
+                std::sort(byTheta.begin(), byTheta.end());
+        }
+        const float minCosine = std::cos(clusterMaxAngle);
+        std::vector<unsigned int> candidates;
+        std::vector<TransientTrack> nearby;
+
         std::vector< Cluster > clusters;
         int i = 0;
 	for(std::vector<TransientTrack>::const_iterator s = seeds.begin();
@@ -111,7 +128,22 @@ std::vector<TracksClusteringFromDisplacedSeed::Cluster> TracksClusteringFromDisp
 #ifdef VTXDEBUG
 		std::cout << "Seed N. "<<i <<   std::endl;
 #endif // VTXDEBUG
-        	std::pair<std::vector<reco::TransientTrack>,GlobalPoint>  ntracks = nearTracks(*s,selectedTracks,pv);
+                const std::vector<TransientTrack> * partners = &selectedTracks;
+                if(clusterMaxAngle > 0) {
+                  GlobalVector seedDir = s->impactPointState().globalDirection().unit();
+                  float theta = seedDir.theta();
+                  auto first = std::lower_bound(byTheta.begin(), byTheta.end(), std::make_pair(float(theta - clusterMaxAngle), 0u));
+                  candidates.clear();
+                  for(auto it = first; it != byTheta.end() && it->first <= theta + clusterMaxAngle; ++it)
+                    if(selectedTracks[it->second].impactPointState().globalDirection().unit().dot(seedDir) >= minCosine)
+                      candidates.push_back(it->second);
+                  // in the original order of the tracks
+                  std::sort(candidates.begin(), candidates.end());
+                  nearby.clear();
+                  for(auto j : candidates) nearby.push_back(selectedTracks[j]);
+                  partners = &nearby;
+                }
+        	std::pair<std::vector<reco::TransientTrack>,GlobalPoint>  ntracks = nearTracks(*s,*partners,pv);
 //	        std::cout << ntracks.first.size() << " " << ntracks.first.size()  << std::endl;
 //                if(ntracks.first.size() == 0 || ntracks.first.size() > maxNTracks ) continue;
                 ntracks.first.push_back(*s);
@@ -203,6 +203,7 @@ private:
   float betastop_;
   double dzCutOff_;
   double d0CutOff_;
+  double zrange_;
   bool useTc_;
 };
 
@@ -25,6 +25,9 @@ private:
   }
     
 
+  // all the tracks may be returned
+  bool preselect (const reco::Track& track) const{ return true; }
+
   // override the select method
   std::vector<reco::TransientTrack> select (const std::vector<reco::TransientTrack>& tracks) const{
     std::vector<reco::TransientTrack> seltks = TrackFilterForPVFinding::select(tracks);
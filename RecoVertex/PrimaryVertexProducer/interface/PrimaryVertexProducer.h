@@ -79,6 +79,7 @@ private:
 
   edm::ParameterSet theConfig;
   bool fVerbose;
+  bool parallelFit_;
   edm::EDGetTokenT<reco::BeamSpot> bsToken;
   edm::EDGetTokenT<reco::TrackCollection> trkToken;
 
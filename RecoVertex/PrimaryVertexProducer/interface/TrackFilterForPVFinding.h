@@ -17,6 +17,7 @@ public:
 
   TrackFilterForPVFinding(const edm::ParameterSet& conf);
   bool operator() (const reco::TransientTrack & tracks)const;
+  bool preselect (const reco::Track & track)const;
   std::vector<reco::TransientTrack> select (const std::vector<reco::TransientTrack>& tracks)const;
 
 private:
@@ -8,6 +8,7 @@
 */
 
 #include "TrackingTools/TransientTrack/interface/TransientTrack.h"
+#include "DataFormats/TrackReco/interface/Track.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include <vector>
 
@@ -18,6 +19,8 @@ public:
   TrackFilterForPVFindingBase(){};
   TrackFilterForPVFindingBase(const edm::ParameterSet& conf){};
   virtual std::vector<reco::TransientTrack> select (const std::vector<reco::TransientTrack>& tracks)const=0;
+  // the tracks failing preselect() are never selected and need no TransientTrack
+  virtual bool preselect (const reco::Track& track)const { return true; }
   virtual ~TrackFilterForPVFindingBase(){};
 };
 
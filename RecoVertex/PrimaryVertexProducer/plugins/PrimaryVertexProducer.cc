@@ -16,12 +16,16 @@
 #include "TrackingTools/Records/interface/TransientTrackRecord.h"
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 
 PrimaryVertexProducer::PrimaryVertexProducer(const edm::ParameterSet& conf)
   :theConfig(conf)
 {
 
   fVerbose   = conf.getUntrackedParameter<bool>("verbose", false);
+  parallelFit_ = conf.existsAs<bool>("parallelFit") ? conf.getParameter<bool>("parallelFit") : false;
   trkToken = consumes<reco::TrackCollection>(conf.getParameter<edm::InputTag>("TrackLabel"));
   bsToken = consumes<reco::BeamSpot>(conf.getParameter<edm::InputTag>("beamSpotLabel"));
 
@@ -148,7 +152,14 @@ PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup
   // interface RECO tracks to vertex reconstruction
   edm::ESHandle<TransientTrackBuilder> theB;
   iSetup.get<TransientTrackRecord>().get("TransientTrackBuilder",theB);
-  std::vector<reco::TransientTrack> t_tks = (*theB).build(tks, beamSpot);
+  // only for the tracks which can pass the track selection
+  std::vector<reco::TransientTrack> t_tks;
+  t_tks.reserve(tks->size());
+  for (unsigned int i = 0; i < tks->size(); i++) {
+    if (!theTrackFilter->preselect((*tks)[i])) continue;
+    t_tks.push_back((*theB).build(reco::TrackRef(tks, i)));
+    t_tks.back().setBeamSpot(beamSpot);
+  }
   if(fVerbose) {std::cout << "RecoVertex/PrimaryVertexProducer"
 		     << "Found: " << t_tks.size() << " reconstructed tracks" << "\n";
   }
@@ -171,21 +182,33 @@ PrimaryVertexProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup
     reco::VertexCollection & vColl = (*result);
 
 
-    std::vector<TransientVertex> pvs;
-    for (std::vector< std::vector<reco::TransientTrack> >::const_iterator iclus
-	   = clusters.begin(); iclus != clusters.end(); iclus++) {
-
-
+    auto fit = [&](VertexFitter<5> const & fitter, std::vector<reco::TransientTrack> const & clus) {
       TransientVertex v; 
-      if( algorithm->useBeamConstraint && validBS &&((*iclus).size()>1) ){
+      if( algorithm->useBeamConstraint && validBS &&(clus.size()>1) ){
 	
-	v = algorithm->fitter->vertex(*iclus, beamSpot);
+	v = fitter.vertex(clus, beamSpot);
 	
-      }else if( !(algorithm->useBeamConstraint) && ((*iclus).size()>1) ) {
+      }else if( !(algorithm->useBeamConstraint) && (clus.size()>1) ) {
       
-	v = algorithm->fitter->vertex(*iclus); 
+	v = fitter.vertex(clus); 
 	
       }// else: no fit ==> v.isValid()=False
+      return v;
+    };
+
+    std::vector<TransientVertex> fitted(clusters.size());
+    if (parallelFit_) {
+      // the fitters have a state: one clone per task
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, clusters.size()), [&](tbb::blocked_range<size_t> const & r) {
+	  std::unique_ptr<VertexFitter<5> > fitter(algorithm->fitter->clone());
+	  for (size_t i = r.begin(); i != r.end(); ++i) fitted[i] = fit(*fitter, clusters[i]);
+	});
+    } else {
+      for (size_t i = 0; i != clusters.size(); ++i) fitted[i] = fit(*algorithm->fitter, clusters[i]);
+    }
+
+    std::vector<TransientVertex> pvs;
+    for (auto const & v : fitted) {
 
 
       if (fVerbose){
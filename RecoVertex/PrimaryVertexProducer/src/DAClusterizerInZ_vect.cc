@@ -5,6 +5,7 @@
 
 #include <cmath>
 #include <cassert>
+#include <algorithm>
 #include <limits>
 #include <iomanip>
 #include "FWCore/Utilities/interface/isFinite.h"
@@ -38,6 +39,8 @@ DAClusterizerInZ_vect::DAClusterizerInZ_vect(const edm::ParameterSet& conf) {
   d0CutOff_ = conf.getParameter<double> ("d0CutOff");
   dzCutOff_ = conf.getParameter<double> ("dzCutOff");
   maxIterations_ = 100;
+  // only sum over the vertices within zrange "temperature widths" of a track (0: all the vertices)
+  zrange_ = conf.existsAs<double>("zrange") ? conf.getParameter<double>("zrange") : 0;
   if (Tmin == 0) {
     LogDebug("DAClusterizerinZ_vectorized")  << "DAClusterizerInZ: invalid Tmin" << Tmin
 					     << "  reset do default " << 1. / betamax_ << endl;
@@ -126,31 +129,33 @@ double DAClusterizerInZ_vect::update(double beta, track_t & gtracks,
   double Z_init = 0;
   
   // define kernels
-  auto kernel_calc_exp_arg = [ beta, nv ] ( const unsigned int itrack,
-					     track_t const& tracks,
-					     vertex_t const& vertices ) {
+  auto kernel_calc_exp_arg = [ beta ] ( const unsigned int itrack,
+					 track_t const& tracks,
+					 vertex_t const& vertices,
+					 unsigned int kmin, unsigned int kmax ) {
     const double track_z = tracks._z[itrack];
     const double botrack_dz2 = -beta*tracks._dz2[itrack];
 
     // auto-vectorized
-    for ( unsigned int ivertex = 0; ivertex < nv; ++ivertex) {
+    for ( unsigned int ivertex = kmin; ivertex < kmax; ++ivertex) {
       auto mult_res =  track_z - vertices._z[ivertex];
       vertices._ei_cache[ivertex] = botrack_dz2 * ( mult_res * mult_res );
     }
   };
   
-  auto kernel_add_Z = [ nv, Z_init ] (vertex_t const& vertices) -> double
+  auto kernel_add_Z = [ Z_init ] (vertex_t const& vertices, unsigned int kmin, unsigned int kmax) -> double
     {
       double ZTemp = Z_init;
-      for (unsigned int ivertex = 0; ivertex < nv; ++ivertex) {	
+      for (unsigned int ivertex = kmin; ivertex < kmax; ++ivertex) {	
 	ZTemp += vertices._pk[ivertex] * vertices._ei[ivertex];
       }
       return ZTemp;
     };
 
-  auto kernel_calc_normalization = [ beta, nv ] (const unsigned int track_num,
-						  track_t & tks_vec,
-						  vertex_t & y_vec ) {
+  auto kernel_calc_normalization = [ beta ] (const unsigned int track_num,
+					      track_t & tks_vec,
+					      vertex_t & y_vec,
+					      unsigned int kmin, unsigned int kmax ) {
     auto tmp_trk_pi = tks_vec._pi[track_num];
     auto o_trk_Z_sum = 1./tks_vec._Z_sum[track_num];
     auto o_trk_dz2 = tks_vec._dz2[track_num];
@@ -158,7 +163,7 @@ double DAClusterizerInZ_vect::update(double beta, track_t & gtracks,
     auto obeta =  -1./beta;
     
     // auto-vectorized
-    for (unsigned int k = 0; k < nv; ++k) {
+    for (unsigned int k = kmin; k < kmax; ++k) {
       y_vec._se[k] +=  y_vec._ei[k] * (tmp_trk_pi* o_trk_Z_sum);
       auto w = y_vec._pk[k] * y_vec._ei[k] * (tmp_trk_pi*o_trk_Z_sum *o_trk_dz2);
       y_vec._sw[k]  += w;
@@ -182,19 +187,32 @@ double DAClusterizerInZ_vect::update(double beta, track_t & gtracks,
       Z_init = rho0 * local_exp(-beta * dzCutOff_ * dzCutOff_); // cut-off
     }
   
+  // the vertices far from a track, beyond zrange_ widths sqrt(1/(beta*dz2)),
+  // can be skipped if they are in z order, as after split() and merge();
+  // the nearest vertex on each side of the window is always kept
+  const bool useRange = zrange_ > 0 && std::is_sorted(gvertices._z, gvertices._z + nv);
+  
   // loop over tracks
   for (auto itrack = 0U; itrack < nt; ++itrack) {
-    kernel_calc_exp_arg(itrack, gtracks, gvertices);
-    local_exp_list(gvertices._ei_cache, gvertices._ei, nv);
+    unsigned int kmin = 0, kmax = nv;
+    if (useRange) {
+      const double zwidth = zrange_ / std::sqrt(beta * gtracks._dz2[itrack]);
+      kmin = std::lower_bound(gvertices._z, gvertices._z + nv, gtracks._z[itrack] - zwidth) - gvertices._z;
+      kmax = std::upper_bound(gvertices._z + kmin, gvertices._z + nv, gtracks._z[itrack] + zwidth) - gvertices._z;
+      if (kmin > 0) --kmin;
+      if (kmax < nv) ++kmax;
+    }
+    kernel_calc_exp_arg(itrack, gtracks, gvertices, kmin, kmax);
+    local_exp_list(gvertices._ei_cache + kmin, gvertices._ei + kmin, kmax - kmin);
     
-    gtracks._Z_sum[itrack] = kernel_add_Z(gvertices);
+    gtracks._Z_sum[itrack] = kernel_add_Z(gvertices, kmin, kmax);
     
     // used in the next major loop to follow
     if (!useRho0)
       sumpi += gtracks._pi[itrack];
     
     if (gtracks._Z_sum[itrack] > 0) {
-      kernel_calc_normalization(itrack, gtracks, gvertices);
+      kernel_calc_normalization(itrack, gtracks, gvertices, kmin, kmax);
     }
   }
   
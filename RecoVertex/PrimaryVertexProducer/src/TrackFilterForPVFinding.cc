@@ -38,6 +38,18 @@ TrackFilterForPVFinding::operator() (const reco::TransientTrack & tk) const
 
 
 
+// the cuts which do not need the TransientTrack
+bool
+TrackFilterForPVFinding::preselect (const reco::Track & tk) const
+{
+	return tk.normalizedChi2() < maxNormChi2_
+	  && tk.hitPattern().pixelLayersWithMeasurement() >= minPxLayers_
+	  && tk.hitPattern().trackerLayersWithMeasurement() >= minSiLayers_
+	  && ((quality_==reco::TrackBase::undefQuality) || tk.quality(quality_));
+}
+
+
+
 // select the vector of tracks that pass the filter cuts
 std::vector<reco::TransientTrack> TrackFilterForPVFinding::select(const std::vector<reco::TransientTrack>& tracks) const
 {
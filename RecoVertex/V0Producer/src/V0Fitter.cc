@@ -118,9 +118,32 @@ void V0Fitter::fitAll(const edm::Event& iEvent, const edm::EventSetup& iSetup,
    }
    // good tracks have now been selected for vertexing
 
+   // the charge and the momentum at the impact point of each track, for the cuts of the pairs
+   // which need no closest approach: |p| does not change along the trajectory, so the mass
+   // of a pair is at least the one of collinear tracks, m^2 >= 2(m_pi^2 + E1*E2 - p1*p2)
+   const unsigned int nTracks = theTrackRefs.size();
+   std::vector<int> theCharges(nTracks);
+   std::vector<double> theP2(nTracks, -1.);   // <0: no valid impact point state
+   for (unsigned int trdx = 0; trdx < nTracks; ++trdx) {
+      theCharges[trdx] = theTrackRefs[trdx]->charge();
+      if (theTransTracks[trdx].impactPointTSCP().isValid()) theP2[trdx] = theTransTracks[trdx].impactPointTSCP().momentum().mag2();
+   }
+   // margin for the rounding of the momenta propagated to the crossing point
+   const double mPiPiCutSq = mPiPiCut_*mPiPiCut_*(1. + 1.e-4);
+
    // loop over tracks and vertex good charged track pairs
-   for (unsigned int trdx1 = 0; trdx1 < theTrackRefs.size(); ++trdx1) {
-   for (unsigned int trdx2 = trdx1 + 1; trdx2 < theTrackRefs.size(); ++trdx2) {
+   for (unsigned int trdx1 = 0; trdx1 < nTracks; ++trdx1) {
+   if (theP2[trdx1] < 0) continue;
+   for (unsigned int trdx2 = trdx1 + 1; trdx2 < nTracks; ++trdx2) {
+
+      if (theCharges[trdx1]*theCharges[trdx2] >= 0 || theP2[trdx2] < 0) continue;
+      if (mPiPiCut_ > 0) {
+         double p1sq = theP2[trdx1], p2sq = theP2[trdx2];
+         double e1e2 = sqrt((p1sq + piMassSquared)*(p2sq + piMassSquared));
+         double p1p2 = sqrt(p1sq*p2sq);
+         double excess = (piMassSquared*(p1sq + p2sq) + piMassSquared*piMassSquared)/(e1e2 + p1p2);   // E1*E2 - p1*p2
+         if (2.*(piMassSquared + excess) > mPiPiCutSq) continue;
+      }
 
       TrackRef positiveTrackRef;
       TrackRef negativeTrackRef;
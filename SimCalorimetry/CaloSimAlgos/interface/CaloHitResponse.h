@@ -9,6 +9,7 @@
 #include "SimCalorimetry/CaloSimAlgos/interface/CaloVPECorrection.h"
 
 #include<map>
+#include<unordered_map>
 #include<vector>
 
 /**
@@ -34,7 +35,11 @@ class CaloSimParameters;
 class CaloHitResponse 
 {
 public:
-  typedef std::map<DetId, CaloSamples> AnalogSignalMap;
+  /// the signals are only looked up by cell, e.g. for each cell of the detector by CaloTDigitizer, never in order
+  struct DetIdHash {
+    size_t operator()(const DetId & id) const { return std::hash<uint32_t>()(id.rawId()); }
+  };
+  typedef std::unordered_map<DetId, CaloSamples, DetIdHash> AnalogSignalMap;
   // get this from somewhere external
   enum {BUNCHSPACE=25};
 
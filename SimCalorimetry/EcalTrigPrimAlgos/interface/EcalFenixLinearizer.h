@@ -27,13 +27,13 @@
     int mult_;
     int shift_;
     int strip_;
-    bool init_;
     
     const EcalTPGLinearizationConstant  *linConsts_;
     const EcalTPGPedestal *peds_;
     const EcalTPGCrystalStatusCode *badXStatus_;
     
-    std::vector<const EcalTPGCrystalStatusCode *> vectorbadXStatus_;
+    // status of the crystals missing in EcalTPGCrystalStatus: good
+    const EcalTPGCrystalStatusCode noBadXStatus_;
      	
     int setInput(const EcalMGPASample &RawSam) ;
     int process() ;
@@ -7,16 +7,11 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 EcalFenixLinearizer::EcalFenixLinearizer(bool famos)
-  : famos_(famos), init_(false)
+  : famos_(famos)
 {
 }
 
 EcalFenixLinearizer::~EcalFenixLinearizer(){
-  if (init_) {
-    for (int i=0;i<(int)vectorbadXStatus_.size();i++){
-      delete vectorbadXStatus_[i];
-    }
-  }    
 }
 
 void EcalFenixLinearizer::setParameters(uint32_t raw, const EcalTPGPedestals * ecaltpPed, const EcalTPGLinearizationConst * ecaltpLin, const EcalTPGCrystalStatus * ecaltpBadX)
@@ -42,9 +37,7 @@ void EcalFenixLinearizer::setParameters(uint32_t raw, const EcalTPGPedestals * e
   else 
   {   
     edm::LogWarning("EcalTPG")<<" could not find EcalTPGCrystalStatusMap entry for "<<raw; 
-    badXStatus_ = new EcalTPGCrystalStatusCode();
-    vectorbadXStatus_.push_back(&(*badXStatus_));
-    init_ = true;  	
+    badXStatus_ = &noBadXStatus_;
   }
 }
 
@@ -32,7 +32,7 @@ int EcalFenixPeakFinder::process()
     
 }
 
-std::vector<int> EcalFenixPeakFinder::process(std::vector<int> &filtout, std::vector<int> & output)
+void EcalFenixPeakFinder::process(std::vector<int> &filtout, std::vector<int> & output)
 {
   
   // FIXME: 3
@@ -52,8 +52,6 @@ std::vector<int> EcalFenixPeakFinder::process(std::vector<int> &filtout, std::ve
     }
   }
   //  output.resize(filtout.size());
-
-  return output;
 }
 
 
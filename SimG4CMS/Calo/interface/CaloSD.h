@@ -33,6 +33,7 @@
 #include <fstream>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 class G4Step;
 class G4HCofThisEvent;
@@ -143,7 +144,22 @@ private:
   CaloSlaveSD*                    slave;
   int                             hcID;
   CaloG4HitCollection*            theHC; 
-  std::map<CaloHitID,CaloG4Hit*>  hitMap;
+  // hits by ID, equal if unit, depth, time slice and track all are (as
+  // for the ordering of CaloHitID, whatever ignoreTrackID)
+  struct HitIDHash {
+    size_t operator()(const CaloHitID& id) const {
+      size_t h = id.unitID();
+      h = h*1000003 ^ (size_t)(id.trackID());
+      h = h*1000003 ^ (size_t)(id.timeSliceID());
+      return h*1000003 ^ (size_t)(id.depth());
+    }
+  };
+  struct HitIDEqual {
+    bool operator()(const CaloHitID& a, const CaloHitID& b) const {
+      return !(a < b) && !(b < a);
+    }
+  };
+  std::unordered_map<CaloHitID,CaloG4Hit*,HitIDHash,HitIDEqual> hitMap;
 
   std::map<int,TrackWithHistory*> tkMap;
   CaloMeanResponse*               meanResponse;
@@ -21,6 +21,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 class DDCompactView;    
 class G4Step;
@@ -52,6 +53,9 @@ protected:
   bool                rInside(double r);
   void                getRecord(int, int);
   void                loadEventInfo(TBranch *);
+  struct BranchCache;
+  std::shared_ptr<const BranchCache> sharedBranchCache(const std::string&);
+  void                cacheBranch(TBranch *, std::vector<HFShowerPhotonCollection>&);
   void                interpolate(int, double);
   void                extrapolate(int, double);
   void                storePhoton(int j);
@@ -64,7 +68,7 @@ private:
   TFile *             hf;
   TBranch             *emBranch, *hadBranch;
 
-  bool                verbose, applyFidCut, newForm;
+  bool                verbose, applyFidCut, newForm, cacheBranches;
   int                 nMomBin, totEvents, evtPerBin;
   float               libVers, listVersion; 
   std::vector<double> pmom;
@@ -81,6 +85,12 @@ private:
   HFShowerPhotonCollection pe;
   HFShowerPhotonCollection* photo;
   HFShowerPhotonCollection photon;
+  // all the records of the branches, by entry, if cacheBranches; read
+  // once per process and shared by the libraries of all the threads
+  struct BranchCache {
+    std::vector<HFShowerPhotonCollection> em, had;
+  };
+  std::shared_ptr<const BranchCache> branchCache;
 
 };
 #endif
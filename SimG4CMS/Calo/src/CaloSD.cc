@@ -332,7 +332,7 @@ G4bool CaloSD::checkHit() {
   //look in the HitContainer whether a hit with the same ID already exists:
   bool       found = false;
   if (useMap) {
-    std::map<CaloHitID,CaloG4Hit*>::const_iterator it = hitMap.find(currentID);
+    auto it = hitMap.find(currentID);
     if (it != hitMap.end()) {
       currentHit = it->second;
       found      = true;
@@ -383,10 +383,10 @@ CaloG4Hit* CaloSD::createNewHit() {
   
   CaloG4Hit* aHit;
   if (reusehit.size() > 0) {
-    aHit = reusehit[0];
+    aHit = reusehit.back();
     aHit->setEM(0.);
     aHit->setHadr(0.);
-    reusehit.erase(reusehit.begin());
+    reusehit.pop_back();
   } else {
     aHit = new CaloG4Hit;
   }
@@ -554,7 +554,7 @@ void CaloSD::update(const ::EndOfEvent * ) {
 }
 
 void CaloSD::clearHits() {  
-  if (useMap) hitMap.erase (hitMap.begin(), hitMap.end());
+  if (useMap) hitMap.clear();
   for (unsigned int i = 0; i<reusehit.size(); ++i) delete reusehit[i];
   std::vector<CaloG4Hit*>().swap(reusehit);
   cleanIndex  = 0;
@@ -19,6 +19,9 @@
 #include "CLHEP/Units/GlobalSystemOfUnits.h"
 #include "CLHEP/Units/GlobalPhysicalConstants.h"
 
+#include <map>
+#include <mutex>
+
 //#define DebugLog
 
 HFShowerLibrary::HFShowerLibrary(std::string & name, const DDCompactView & cpv,
@@ -42,6 +45,7 @@ HFShowerLibrary::HFShowerLibrary(std::string & name, const DDCompactView & cpv,
   std::string branchPost   = m_HS.getUntrackedParameter<std::string>("BranchPost","_R.obj");
   verbose                  = m_HS.getUntrackedParameter<bool>("Verbosity",false);
   applyFidCut              = m_HS.getParameter<bool>("ApplyFiducialCut");
+  cacheBranches            = m_HS.getUntrackedParameter<bool>("cacheBranches",false);
 
   if (pTreeName.find(".") == 0) pTreeName.erase(0,2);
   const char* nTree = pTreeName.c_str();
@@ -155,6 +159,14 @@ HFShowerLibrary::HFShowerLibrary(std::string & name, const DDCompactView & cpv,
   
   fibre = new HFFibre(name, cpv, p);
   photo = new HFShowerPhotonCollection;
+  if (cacheBranches) {
+    // read the library once, instead of for every shower
+    branchCache = sharedBranchCache(pTreeName + "/" + emBranch->GetName() +
+				    "/" + hadBranch->GetName());
+    edm::LogInfo("HFShower") << "HFShowerLibrary: " << branchCache->em.size()
+			     << " EM and " << branchCache->had.size()
+			     << " hadronic records cached in memory";
+  }
   emPDG = epPDG = gammaPDG = 0;
   pi0PDG = etaPDG = nuePDG = numuPDG = nutauPDG= 0;
   anuePDG= anumuPDG = anutauPDG = geantinoPDG = 0;
@@ -397,7 +409,14 @@ void HFShowerLibrary::getRecord(int type, int record) {
   int nrc     = record-1;
   photon.clear();
   photo->clear();
-  if (type > 0) {
+  if (cacheBranches) {
+    const std::vector<HFShowerPhotonCollection> & cache = (type > 0) ? branchCache->had : branchCache->em;
+    int entry = (type > 0 && newForm) ? nrc+totEvents : nrc;
+    if (entry >= 0 && entry < (int)(cache.size())) {
+      if (newForm) *photo = cache[entry];
+      else         photon = cache[entry];
+    }
+  } else if (type > 0) {
     if (newForm) {
       hadBranch->SetAddress(&photo);
       hadBranch->GetEntry(nrc+totEvents);
@@ -424,6 +443,42 @@ void HFShowerLibrary::getRecord(int type, int record) {
 #endif
 }
 
+std::shared_ptr<const HFShowerLibrary::BranchCache>
+HFShowerLibrary::sharedBranchCache(const std::string& key) {
+
+  // the first library of the process reads the branches, the others (one
+  // per thread) wait for it and share the result
+  static std::mutex mutex;
+  static std::map<std::string, std::weak_ptr<const BranchCache> > caches;
+  std::lock_guard<std::mutex> guard(mutex);
+  std::shared_ptr<const BranchCache> cache = caches[key].lock();
+  if (!cache) {
+    std::shared_ptr<BranchCache> newCache = std::make_shared<BranchCache>();
+    cacheBranch(emBranch, newCache->em);
+    cacheBranch(hadBranch, newCache->had);
+    caches[key] = newCache;
+    cache = newCache;
+  }
+  return cache;
+}
+
+void HFShowerLibrary::cacheBranch(TBranch* branch,
+				  std::vector<HFShowerPhotonCollection>& cache) {
+
+  int nEntries = branch->GetEntries();
+  cache.resize(nEntries);
+  for (int i=0; i<nEntries; ++i) {
+    photon.clear();
+    photo->clear();
+    if (newForm) branch->SetAddress(&photo);
+    else         branch->SetAddress(&photon);
+    branch->GetEntry(i);
+    cache[i] = (newForm) ? *photo : photon;
+  }
+  photon.clear();
+  photo->clear();
+}
+
 void HFShowerLibrary::loadEventInfo(TBranch* branch) {
 
   if (branch) {
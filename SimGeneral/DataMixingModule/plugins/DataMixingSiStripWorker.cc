@@ -4,6 +4,7 @@
 //
 //--------------------------------------------
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
@@ -116,18 +117,25 @@ namespace edm
 
 	// find correct local map (or new one) for this detector ID
 
-	SiGlobalIndex::const_iterator itest;
+	SiGlobalIndex::iterator itest;
 
 	itest = SiHitStorage_.find(DSViter->id);
 
 	if(itest!=SiHitStorage_.end()) {  // this detID already has hits, add to existing map
 
-	  LocalMap = itest->second;
+	  OneDetectorMap& DetMap = itest->second;
+	  const OneDetectorMap::size_type nOld = DetMap.size();
 
 	  // fill in local map with extra channels
-	  LocalMap.insert(LocalMap.end(),(DSViter->data).begin(),(DSViter->data).end());
-	  std::stable_sort(LocalMap.begin(),LocalMap.end(),DataMixingSiStripWorker::StrictWeakOrdering());
-	  SiHitStorage_[DSViter->id]=LocalMap;
+	  DetMap.insert(DetMap.end(),(DSViter->data).begin(),(DSViter->data).end());
+	  // both lists are normally sorted by strip already: merging them then
+	  // gives the same order as the stable sort
+	  DataMixingSiStripWorker::StrictWeakOrdering order;
+	  if(std::is_sorted(DetMap.begin(),DetMap.begin()+nOld,order) &&
+	     std::is_sorted(DetMap.begin()+nOld,DetMap.end(),order))
+	    std::inplace_merge(DetMap.begin(),DetMap.begin()+nOld,DetMap.end(),order);
+	  else
+	    std::stable_sort(DetMap.begin(),DetMap.end(),order);
 	  
 	}
 	else{ // fill local storage with this information, put in global collection
@@ -51,7 +51,7 @@ class CorrelatedNoisifier
 
       const M& cholMat() const ; // return decomposition
 
-      const VecDou& vecgau() const ;
+      const VecDou& vecgau() const ; // numbers drawn by the last noisify without rangau
 
    private:
 
@@ -39,6 +39,7 @@
 // November, 2010: Bug fix in removing TBMB/A half-modules (V. Cuplov)
 // February, 2011: Time improvement in DriftDirection()  (J. Bashir Butt)
 // June, 2011: Bug Fix for pixels on ROC edges in module_killing_DB() (J. Bashir Butt)
+#include <algorithm>
 #include <iostream>
 
 #include "SimGeneral/NoiseGenerators/interface/GaussianTailNoiseGenerator.h"
@@ -941,12 +942,15 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
       << topol->pitch().first << " " << topol->pitch().second; //OK
 #endif
 
-   // local map to store pixels hit by 1 Hit.
-   typedef std::map< int, float, std::less<int> > hit_map_type;
-   hit_map_type hit_signal;
+   int numColumns = topol->ncolumns();  // det module number of cols&rows
+   int numRows = topol->nrows();
 
-   // map to store pixel integrals in the x and in the y directions
-   std::map<int, float, std::less<int> > x,y;
+   // local dense buffer to store pixels hit by 1 Hit.
+   if(hitSignal_.size() < size_t(numRows*numColumns)) hitSignal_.resize(numRows*numColumns, 0.);
+   hitPixels_.clear();
+
+   // pixel integrals in the x and in the y directions, from the left-down pixel of the cloud
+   std::vector<float> x,y;
 
    // Assign signals to readout channels and store sorted by channel number
 
@@ -1014,16 +1018,13 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
 #endif
 
      // Check detector limits to correct for pixels outside range.
-     int numColumns = topol->ncolumns();  // det module number of cols&rows
-     int numRows = topol->nrows();
-
      IPixRightUpX = numRows>IPixRightUpX ? IPixRightUpX : numRows-1 ;
      IPixRightUpY = numColumns>IPixRightUpY ? IPixRightUpY : numColumns-1 ;
      IPixLeftDownX = 0<IPixLeftDownX ? IPixLeftDownX : 0 ;
      IPixLeftDownY = 0<IPixLeftDownY ? IPixLeftDownY : 0 ;
 
-     x.clear(); // clear temporary integration array
-     y.clear();
+     x.assign(std::max(IPixRightUpX-IPixLeftDownX+1,0),0.); // clear temporary integration array
+     y.assign(std::max(IPixRightUpY-IPixLeftDownY+1,0),0.);
 
      // First integrate charge strips in x
      int ix; // TT for compatibility
@@ -1050,7 +1051,7 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
        }
 
        float   TotalIntegrationRange = UpperBound - LowerBound; // get strip
-       x[ix] = TotalIntegrationRange; // save strip integral
+       x[ix-IPixLeftDownX] = TotalIntegrationRange; // save strip integral
        //if(SigmaX==0 || SigmaY==0)
        //cout<<TotalIntegrationRange<<" "<<ix<<std::endl;
 
@@ -1078,30 +1079,28 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
       }
 
       float   TotalIntegrationRange = UpperBound - LowerBound;
-      y[iy] = TotalIntegrationRange; // save strip integral
+      y[iy-IPixLeftDownY] = TotalIntegrationRange; // save strip integral
       //if(SigmaX==0 || SigmaY==0)
       //cout<<TotalIntegrationRange<<" "<<iy<<std::endl;
     }
 
     // Get the 2D charge integrals by folding x and y strips
-    int chan;
     for (ix=IPixLeftDownX; ix<=IPixRightUpX; ix++) {  // loop over x index
       for (iy=IPixLeftDownY; iy<=IPixRightUpY; iy++) { //loope over y ind
 
-        float ChargeFraction = Charge*x[ix]*y[iy];
+        float ChargeFraction = Charge*x[ix-IPixLeftDownX]*y[iy-IPixLeftDownY];
 
         if( ChargeFraction > 0. ) {
-	  chan = PixelDigi::pixelToChannel( ix, iy);  // Get index
+	  int pixel = ix*numColumns + iy;  // Get index
           // Load the amplitude
-          hit_signal[chan] += ChargeFraction;
+	  if( hitSignal_[pixel] == 0. ) hitPixels_.push_back(pixel);
+          hitSignal_[pixel] += ChargeFraction;
 	} // endif
 
-
+#ifdef TP_DEBUG
 	mp = MeasurementPoint( float(ix), float(iy) );
 	LocalPoint lp = topol->localPosition(mp);
-	chan = topol->channel(lp);
-
-#ifdef TP_DEBUG
+	int chan = topol->channel(lp);
 	LogDebug ("Pixel Digitizer")
 	  << " pixel " << ix << " " << iy << " - "<<" "
 	  << chan << " " << ChargeFraction<<" "
@@ -1134,12 +1133,15 @@ void SiPixelDigitizerAlgorithm::induce_signal(const PSimHit& hit,
 
   } // loop over charge distributions
 
-  // Fill the global map with all hit pixels from this event
+  // Fill the global map with all hit pixels from this event, in the order of their channels
 
-  for ( hit_map_type::const_iterator im = hit_signal.begin();
-	im != hit_signal.end(); ++im) {
-    int chan =  (*im).first;
-    theSignal[chan] += (makeDigiSimLinks_ ? Amplitude( (*im).second, &hit, hitIndex, tofBin, (*im).second) : Amplitude( (*im).second, (*im).second) )  ;
+  std::sort(hitPixels_.begin(), hitPixels_.end());
+  for ( std::vector<int>::const_iterator ipix = hitPixels_.begin();
+	ipix != hitPixels_.end(); ++ipix) {
+    int chan = PixelDigi::pixelToChannel( *ipix/numColumns, *ipix%numColumns );
+    float amp = hitSignal_[*ipix];
+    hitSignal_[*ipix] = 0.;
+    theSignal[chan] += (makeDigiSimLinks_ ? Amplitude( amp, &hit, hitIndex, tofBin, amp) : Amplitude( amp, amp) )  ;
 
 #ifdef TP_DEBUG
     std::pair<int,int> ip = PixelDigi::channelToPixel(chan);
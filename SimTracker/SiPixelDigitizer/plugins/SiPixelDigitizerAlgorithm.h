@@ -280,6 +280,11 @@ class SiPixelDigitizerAlgorithm  {
     // Contains the accumulated hit info.
     signalMaps _signal;
 
+    // Charge induced by the hit being processed, by pixel (row*ncolumns+column) of the module,
+    // and the pixels it reached; used by induce_signal, kept to reuse the memory.
+    std::vector<float> hitSignal_;
+    std::vector<int> hitPixels_;
+
     const bool makeDigiSimLinks_;
 
     const bool use_ineff_from_db_;
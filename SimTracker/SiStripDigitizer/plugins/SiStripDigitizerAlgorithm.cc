@@ -141,7 +141,10 @@ SiStripDigitizerAlgorithm::accumulateSimHits(std::vector<PSimHit>::const_iterato
   if(CLHEP::RandFlat::shoot(engine) > inefficiency) {
     AssociationInfoForChannel* pDetIDAssociationInfo; // I only need this if makeDigiSimLinks_ is true...
     if( makeDigiSimLinks_ ) pDetIDAssociationInfo=&(associationInfoForDetId_[detId]); // ...so only search the map if that is the case
-    std::vector<float> previousLocalAmplitude; // Only used if makeDigiSimLinks_ is true. Needed to work out the change in amplitude.
+    // Only used if makeDigiSimLinks_ is true. Needed to work out the change in amplitude; a hit only changes the strips
+    // between its localFirstChannel and localLastChannel, so only those are compared and copied after each hit.
+    std::vector<float> previousLocalAmplitude;
+    if( makeDigiSimLinks_ ) previousLocalAmplitude=locAmpl;
 
     size_t simHitGlobalIndex=inputBeginGlobalIndex; // This needs to stored to create the digi-sim link later
     for (std::vector<PSimHit>::const_iterator simHitIter = inputBegin; simHitIter != inputEnd; ++simHitIter, ++simHitGlobalIndex ) {
@@ -151,7 +154,6 @@ SiStripDigitizerAlgorithm::accumulateSimHits(std::vector<PSimHit>::const_iterato
       }
       // check TOF
       if (std::fabs(simHitIter->tof() - cosmicShift - det->surface().toGlobal(simHitIter->localPosition()).mag()/30.) < tofCut && simHitIter->energyLoss()>0) {
-        if( makeDigiSimLinks_ ) previousLocalAmplitude=locAmpl; // Not needed except to make the sim link association.
         size_t localFirstChannel = numStrips;
         size_t localLastChannel  = 0;
         // process the hit
@@ -188,7 +190,7 @@ SiStripDigitizerAlgorithm::accumulateSimHits(std::vector<PSimHit>::const_iterato
         if(thisLastChannelWithSignal < localLastChannel) thisLastChannelWithSignal = localLastChannel;
 
         if( makeDigiSimLinks_ ) { // No need to do any of this if truth association was turned off in the configuration
-          for( size_t stripIndex=0; stripIndex<locAmpl.size(); ++stripIndex ) {
+          for( size_t stripIndex=localFirstChannel; stripIndex<localLastChannel; ++stripIndex ) {
             // Work out the amplitude from this SimHit from the difference of what it was before and what it is now
             float signalFromThisSimHit=locAmpl[stripIndex]-previousLocalAmplitude[stripIndex];
             if( signalFromThisSimHit!=0 ) { // If this SimHit had any contribution I need to record it.
@@ -207,6 +209,7 @@ SiStripDigitizerAlgorithm::accumulateSimHits(std::vector<PSimHit>::const_iterato
               // If the hit wasn't already in create a new association info structure.
               if( addNewEntry ) associationVector.push_back( AssociationInfo{ simHitIter->trackId(), simHitIter->eventId(), signalFromThisSimHit, simHitGlobalIndex, tofBin } );
             } // end of "if( signalFromThisSimHit!=0 )"
+            previousLocalAmplitude[stripIndex]=locAmpl[stripIndex];
           } // end of loop over locAmpl strips
         } // end of "if( makeDigiSimLinks_ )"
       } // end of TOF check
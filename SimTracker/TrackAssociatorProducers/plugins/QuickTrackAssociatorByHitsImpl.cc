@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
@@ -109,7 +110,7 @@ reco::RecoToSimCollection QuickTrackAssociatorByHitsImpl::associateRecoToSim( co
                                                                               const edm::Handle<TrackingParticleCollection>& trackingParticleCollectionHandle) const
 {
 	// Only pass the one that was successfully created to the templated method.
-	if( not clusterToTPMap_ ) return associateRecoToSimImplementation( trackCollectionHandle, trackingParticleCollectionHandle, *hitAssociator_ );
+	if( not clusterToTPMap_ ) return associateRecoToSimImplementation( trackCollectionHandle, trackingParticleCollectionHandle, makeIndexedHitAssociator( *hitAssociator_, trackingParticleCollectionHandle ) );
 	else return associateRecoToSimImplementation( trackCollectionHandle, trackingParticleCollectionHandle, *clusterToTPMap_ );
 }
 
@@ -117,7 +118,7 @@ reco::SimToRecoCollection QuickTrackAssociatorByHitsImpl::associateSimToReco( co
                                                                               const edm::Handle<TrackingParticleCollection>& trackingParticleCollectionHandle) const
 {
 	// Only pass the one that was successfully created to the templated method.
-	if( not clusterToTPMap_ ) return associateSimToRecoImplementation( trackCollectionHandle, trackingParticleCollectionHandle, *hitAssociator_ );
+	if( not clusterToTPMap_ ) return associateSimToRecoImplementation( trackCollectionHandle, trackingParticleCollectionHandle, makeIndexedHitAssociator( *hitAssociator_, trackingParticleCollectionHandle ) );
 	else return associateSimToRecoImplementation( trackCollectionHandle, trackingParticleCollectionHandle, *clusterToTPMap_ );
 }
 
@@ -125,7 +126,7 @@ reco::RecoToSimCollection QuickTrackAssociatorByHitsImpl::associateRecoToSim( co
                                                                               const edm::RefVector<TrackingParticleCollection>& trackingParticleCollection ) const 
 {
 	// Only pass the one that was successfully created to the templated method.
-	if( not clusterToTPMap_ ) return associateRecoToSimImplementation( trackCollection, trackingParticleCollection, *hitAssociator_ );
+	if( not clusterToTPMap_ ) return associateRecoToSimImplementation( trackCollection, trackingParticleCollection, makeIndexedHitAssociator( *hitAssociator_, trackingParticleCollection ) );
 	else return associateRecoToSimImplementation( trackCollection, trackingParticleCollection, *clusterToTPMap_ );
 }
 
@@ -133,13 +134,13 @@ reco::SimToRecoCollection QuickTrackAssociatorByHitsImpl::associateSimToReco( co
                                                                               const edm::RefVector<TrackingParticleCollection>& trackingParticleCollection) const
 {
 	// Only pass the one that was successfully created to the templated method.
-	if( not clusterToTPMap_ ) return associateSimToRecoImplementation( trackCollection, trackingParticleCollection, *hitAssociator_ );
+	if( not clusterToTPMap_ ) return associateSimToRecoImplementation( trackCollection, trackingParticleCollection, makeIndexedHitAssociator( *hitAssociator_, trackingParticleCollection ) );
 	else return associateSimToRecoImplementation( trackCollection, trackingParticleCollection, *clusterToTPMap_ );
 }
 
 
 template<class T_TrackCollection, class T_TrackingParticleCollection, class T_hitOrClusterAssociator>
-reco::RecoToSimCollection QuickTrackAssociatorByHitsImpl::associateRecoToSimImplementation( T_TrackCollection trackCollection, T_TrackingParticleCollection trackingParticleCollection, T_hitOrClusterAssociator hitOrClusterAssociator ) const
+reco::RecoToSimCollection QuickTrackAssociatorByHitsImpl::associateRecoToSimImplementation( T_TrackCollection trackCollection, T_TrackingParticleCollection trackingParticleCollection, const T_hitOrClusterAssociator& hitOrClusterAssociator ) const
 {
 	reco::RecoToSimCollection returnValue;
 
@@ -185,7 +186,7 @@ reco::RecoToSimCollection QuickTrackAssociatorByHitsImpl::associateRecoToSimImpl
 }
 
 template<class T_TrackCollection, class T_TrackingParticleCollection, class T_hitOrClusterAssociator>
-reco::SimToRecoCollection QuickTrackAssociatorByHitsImpl::associateSimToRecoImplementation( T_TrackCollection trackCollection, T_TrackingParticleCollection trackingParticleCollection, T_hitOrClusterAssociator hitOrClusterAssociator ) const
+reco::SimToRecoCollection QuickTrackAssociatorByHitsImpl::associateSimToRecoImplementation( T_TrackCollection trackCollection, T_TrackingParticleCollection trackingParticleCollection, const T_hitOrClusterAssociator& hitOrClusterAssociator ) const
 {
 	reco::SimToRecoCollection returnValue;
 
@@ -279,6 +280,60 @@ template<typename T_TPCollection,typename iter> std::vector<std::pair<edm::Ref<T
 	return returnValue;
 }
 
+template<typename T_TPCollection> QuickTrackAssociatorByHitsImpl::IndexedHitAssociator QuickTrackAssociatorByHitsImpl::makeIndexedHitAssociator( const TrackerHitAssociator& hitAssociator, T_TPCollection trackingParticles ) const
+{
+	IndexedHitAssociator returnValue{ hitAssociator, {} };
+
+	size_t collectionSize=::collectionSize(trackingParticles);
+	for( size_t i=0; i<collectionSize; ++i )
+	{
+		const TrackingParticle* pTrackingParticle=getTrackingParticleAt( trackingParticles, i );
+
+		// Ignore TrackingParticles with no hits
+		if( pTrackingParticle->numberOfHits()==0 ) continue;
+
+		for( std::vector<SimTrack>::const_iterator iSimTrack=pTrackingParticle->g4Track_begin(); iSimTrack != pTrackingParticle->g4Track_end(); ++iSimTrack )
+		{
+			returnValue.simTrackToTP.push_back( std::make_pair( SimTrackIdentifiers( iSimTrack->trackId(), iSimTrack->eventId() ), i ) );
+		}
+	}
+	// a sim track is only counted once for each TrackingParticle, as in trackingParticleContainsIdentifier
+	std::sort( returnValue.simTrackToTP.begin(), returnValue.simTrackToTP.end() );
+	returnValue.simTrackToTP.erase( std::unique( returnValue.simTrackToTP.begin(), returnValue.simTrackToTP.end() ), returnValue.simTrackToTP.end() );
+	return returnValue;
+}
+
+template<typename T_TPCollection,typename iter> std::vector<std::pair<edm::Ref<TrackingParticleCollection>,size_t> > QuickTrackAssociatorByHitsImpl::associateTrack( const IndexedHitAssociator& indexedHitAssociator, T_TPCollection trackingParticles, iter begin, iter end ) const
+{
+	std::vector< std::pair<edm::Ref<TrackingParticleCollection>,size_t> > returnValue;
+
+	std::vector< std::pair<SimTrackIdentifiers,size_t> > hitIdentifiers=getAllSimTrackIdentifiers( indexedHitAssociator.hitAssociator, begin, end );
+
+	// The pairs in this vector have first as the index of the TrackingParticle, and second the number of hits of one of its sim tracks
+	std::vector< std::pair<size_t,size_t> > tpHitCounts;
+	const auto& simTrackToTP=indexedHitAssociator.simTrackToTP;
+	for( std::vector< std::pair<SimTrackIdentifiers,size_t> >::const_iterator iIdentifierCountPair=hitIdentifiers.begin(); iIdentifierCountPair!=hitIdentifiers.end(); ++iIdentifierCountPair )
+	{
+		auto iEntry=std::lower_bound( simTrackToTP.begin(), simTrackToTP.end(), std::make_pair( iIdentifierCountPair->first, size_t(0) ) );
+		for( ; iEntry != simTrackToTP.end() && iEntry->first == iIdentifierCountPair->first; ++iEntry )
+		{
+			tpHitCounts.push_back( std::make_pair( iEntry->second, iIdentifierCountPair->second ) );
+		}
+	}
+
+	// Sum the hits of each TrackingParticle, in the order of the collection like the loop over all of them does
+	std::sort( tpHitCounts.begin(), tpHitCounts.end() );
+	for( std::vector< std::pair<size_t,size_t> >::const_iterator iTPCount=tpHitCounts.begin(); iTPCount != tpHitCounts.end(); )
+	{
+		size_t index=iTPCount->first;
+		size_t numberOfAssociatedHits=0;
+		for( ; iTPCount != tpHitCounts.end() && iTPCount->first == index; ++iTPCount ) numberOfAssociatedHits+=iTPCount->second;
+		returnValue.push_back( std::make_pair( getRefToTrackingParticleAt(trackingParticles,index), numberOfAssociatedHits ) );
+	}
+
+	return returnValue;
+}
+
 template<typename T_TPCollection,typename iter> std::vector< std::pair<edm::Ref<TrackingParticleCollection>,size_t> > QuickTrackAssociatorByHitsImpl::associateTrack( const ClusterTPAssociationList& clusterToTPMap, T_TPCollection trackingParticles, iter begin, iter end ) const
 {
 	// Note that the trackingParticles parameter is not actually required since all the information is in clusterToTPMap,
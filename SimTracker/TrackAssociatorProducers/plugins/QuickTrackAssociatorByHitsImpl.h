@@ -99,6 +99,17 @@ public:
   
  private:
   typedef std::pair<uint32_t,EncodedEventId> SimTrackIdentifiers; ///< @brief This is enough information to uniquely identify a sim track
+
+  /** @brief The TrackerHitAssociator with an index of the TrackingParticles by sim track.
+   *
+   * The index is built once for all the tracks of an association call, so that each track only looks up its own
+   * sim tracks instead of looping over the whole TrackingParticle collection.
+   */
+  struct IndexedHitAssociator {
+    const TrackerHitAssociator& hitAssociator;
+    std::vector< std::pair<SimTrackIdentifiers,size_t> > simTrackToTP; ///< @brief index of the TrackingParticles with hits, sorted by sim track
+  };
+  template<typename T_TPCollection> IndexedHitAssociator makeIndexedHitAssociator( const TrackerHitAssociator& hitAssociator, T_TPCollection trackingParticles ) const;
   
   // - added by S. Sarkar
   static bool tpIntPairGreater(std::pair<edm::Ref<TrackingParticleCollection>,size_t> i, std::pair<edm::Ref<TrackingParticleCollection>,size_t> j) { return (i.first.key()>j.first.key()); }
@@ -110,7 +121,7 @@ public:
    * are delegated out to overloaded methods.
    */
   template<class T_TrackCollection, class T_TrackingParticleCollection, class T_hitOrClusterAssociator>
-    reco::RecoToSimCollection associateRecoToSimImplementation( T_TrackCollection trackCollection, T_TrackingParticleCollection trackingParticleCollection, T_hitOrClusterAssociator hitOrClusterAssociator ) const;
+    reco::RecoToSimCollection associateRecoToSimImplementation( T_TrackCollection trackCollection, T_TrackingParticleCollection trackingParticleCollection, const T_hitOrClusterAssociator& hitOrClusterAssociator ) const;
   
   /** @brief The method that does the work for both overloads of associateSimToReco.
    *
@@ -119,7 +130,7 @@ public:
    * are delegated out to overloaded methods.
    */
   template<class T_TrackCollection, class T_TrackingParticleCollection, class T_hitOrClusterAssociator>
-    reco::SimToRecoCollection associateSimToRecoImplementation( T_TrackCollection trackCollection, T_TrackingParticleCollection trackingParticleCollection, T_hitOrClusterAssociator hitOrClusterAssociator ) const;
+    reco::SimToRecoCollection associateSimToRecoImplementation( T_TrackCollection trackCollection, T_TrackingParticleCollection trackingParticleCollection, const T_hitOrClusterAssociator& hitOrClusterAssociator ) const;
   
   
   /** @brief Returns the TrackingParticle that has the most associated hits to the given track.
@@ -128,6 +139,8 @@ public:
    * the number of associated hits.
    */
   template<typename T_TPCollection,typename iter> std::vector< std::pair<edm::Ref<TrackingParticleCollection>,size_t> > associateTrack( const TrackerHitAssociator& hitAssociator, T_TPCollection trackingParticles, iter begin, iter end ) const;
+  /** @brief Overload using the index of the TrackingParticles by sim track, gives the same result as the TrackerHitAssociator one. */
+  template<typename T_TPCollection,typename iter> std::vector< std::pair<edm::Ref<TrackingParticleCollection>,size_t> > associateTrack( const IndexedHitAssociator& indexedHitAssociator, T_TPCollection trackingParticles, iter begin, iter end ) const;
   /** @brief Returns the TrackingParticle that has the most associated hits to the given track.
    *
    * See the notes for the other overload for the return type.
@@ -146,6 +159,10 @@ public:
    * Modified 01/May/2014 to take the TrackerHitAssociator as a parameter rather than using a member.
    */
   template<typename iter> int getDoubleCount( const TrackerHitAssociator& hitAssociator, iter begin, iter end, TrackingParticleRef associatedTrackingParticle ) const;
+  template<typename iter> int getDoubleCount( const IndexedHitAssociator& indexedHitAssociator, iter begin, iter end, TrackingParticleRef associatedTrackingParticle ) const
+  {
+    return getDoubleCount( indexedHitAssociator.hitAssociator, begin, end, associatedTrackingParticle );
+  }
   /** @brief Overload for when using cluster to TrackingParticle association list.
    */
   template<typename iter> int getDoubleCount( const ClusterTPAssociationList& clusterToTPList, iter begin, iter end, TrackingParticleRef associatedTrackingParticle ) const;
@@ -0,0 +1,89 @@
+#ifndef DetLayers_CompatibleDetsCache_h
+#define DetLayers_CompatibleDetsCache_h
+
+#include "TrackingTools/DetLayers/interface/GeometricSearchDet.h"
+#include "TrackingTools/DetLayers/interface/DetGroup.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class DetLayer;
+class Propagator;
+class MeasurementEstimator;
+class TrajectoryStateOnSurface;
+
+/** Per-event memoization of DetLayer::compatibleDets() and
+ *  DetLayer::groupedCompatibleDets().
+ *  The starting states are put in coarse bins of global position, direction,
+ *  q/p and size of the position error; for the states of a bin the search over
+ *  the layer is done once, for the first state, and the compatible dets it gives
+ *  are kept. For the next states of the bin only those dets are tried: the state
+ *  is propagated to each of them and checked with the estimator, so the states
+ *  returned are always the ones of the current starting state.
+ *  The result is approximate: a det not compatible with the first state of a bin
+ *  is missed for the others, so the bins must be small compared to the dets.
+ *  Can be used from several threads; which state fills a bin then depends on the order.
+ */
+
+class CompatibleDetsCache {
+public:
+  typedef GeometricSearchDet::DetWithState DetWithState;
+
+  /// bin sizes of the position [cm], of the direction cosines, of q/p [1/GeV]
+  /// and of the logarithm of the position error
+  CompatibleDetsCache(float positionBin, float directionBin, float qOverPBin, float logErrorBin);
+
+  std::vector<DetWithState>
+  compatibleDets(const DetLayer& layer, const TrajectoryStateOnSurface& startingState,
+		 const Propagator& prop, const MeasurementEstimator& est);
+
+  std::vector<DetGroup>
+  groupedCompatibleDets(const DetLayer& layer, const TrajectoryStateOnSurface& startingState,
+			const Propagator& prop, const MeasurementEstimator& est);
+
+  /// forget the dets of the previous event
+  void clear();
+
+  unsigned long hits() const { return theHits; }
+  unsigned long misses() const { return theMisses; }
+  float hitRate() const { unsigned long n = hits()+misses(); return n>0 ? float(hits())/n : 0.f; }
+
+private:
+  struct Key {
+    const DetLayer*             layer;
+    const Propagator*           propagator;
+    const MeasurementEstimator* estimator;
+    int  bins[8];               // position, direction, q/p, error
+    int  direction;             // of the propagator
+    bool grouped;
+    bool operator==(const Key& other) const;
+  };
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  // the dets of each group, with the indices of the group
+  struct Entry {
+    std::vector<std::vector<const GeomDet*> > dets;
+    std::vector<std::pair<int,int> >           indices;
+  };
+
+  Key key(const DetLayer& layer, const TrajectoryStateOnSurface& startingState,
+	  const Propagator& prop, const MeasurementEstimator& est, bool grouped) const;
+  bool find(const Key& key, Entry& entry);
+  void insert(const Key& key, Entry&& entry);
+
+  const float thePositionBin;
+  const float theDirectionBin;
+  const float theQOverPBin;
+  const float theLogErrorBin;
+
+  std::mutex theMutex;
+  std::unordered_map<Key, Entry, KeyHash> theEntries;
+  std::atomic<unsigned long> theHits;
+  std::atomic<unsigned long> theMisses;
+};
+
+#endif
@@ -0,0 +1,134 @@
+#include "TrackingTools/DetLayers/interface/CompatibleDetsCache.h"
+#include "TrackingTools/DetLayers/interface/DetLayer.h"
+#include "TrackingTools/DetLayers/interface/GeomDetCompatibilityChecker.h"
+#include "TrackingTools/DetLayers/interface/MeasurementEstimator.h"
+#include "TrackingTools/GeomPropagators/interface/Propagator.h"
+#include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace {
+  inline int bin(float x, float size) { return int(std::floor(x/size)); }
+}
+
+CompatibleDetsCache::CompatibleDetsCache(float positionBin, float directionBin, float qOverPBin, float logErrorBin) :
+  thePositionBin(positionBin), theDirectionBin(directionBin), theQOverPBin(qOverPBin), theLogErrorBin(logErrorBin),
+  theHits(0), theMisses(0) {}
+
+bool CompatibleDetsCache::Key::operator==(const Key& other) const {
+  return layer==other.layer && propagator==other.propagator && estimator==other.estimator &&
+    direction==other.direction && grouped==other.grouped && std::equal(bins, bins+8, other.bins);
+}
+
+std::size_t CompatibleDetsCache::KeyHash::operator()(const Key& key) const {
+  std::size_t seed = std::hash<const void*>()(key.layer);
+  auto combine = [&seed](std::size_t h) { seed ^= h + 0x9e3779b9 + (seed<<6) + (seed>>2); };
+  combine(std::hash<const void*>()(key.propagator));
+  combine(std::hash<const void*>()(key.estimator));
+  for (int b : key.bins) combine(std::hash<int>()(b));
+  combine(key.direction);
+  combine(key.grouped);
+  return seed;
+}
+
+CompatibleDetsCache::Key
+CompatibleDetsCache::key(const DetLayer& layer, const TrajectoryStateOnSurface& startingState,
+			 const Propagator& prop, const MeasurementEstimator& est, bool grouped) const {
+  Key k;
+  k.layer = &layer;
+  k.propagator = &prop;
+  k.estimator = &est;
+  k.direction = prop.propagationDirection();
+  k.grouped = grouped;
+
+  GlobalPoint pos = startingState.globalPosition();
+  GlobalVector dir = startingState.globalMomentum().unit();
+  k.bins[0] = bin(pos.x(), thePositionBin);
+  k.bins[1] = bin(pos.y(), thePositionBin);
+  k.bins[2] = bin(pos.z(), thePositionBin);
+  k.bins[3] = bin(dir.x(), theDirectionBin);
+  k.bins[4] = bin(dir.y(), theDirectionBin);
+  k.bins[5] = bin(dir.z(), theDirectionBin);
+  k.bins[6] = bin(startingState.signedInverseMomentum(), theQOverPBin);
+  if (startingState.hasError()) {
+    LocalError err = startingState.localError().positionError();
+    k.bins[7] = bin(0.5f*std::log(std::max(err.xx()+err.yy(), 1.e-12f)), theLogErrorBin);
+  } else {
+    k.bins[7] = std::numeric_limits<int>::min();
+  }
+  return k;
+}
+
+bool CompatibleDetsCache::find(const Key& key, Entry& entry) {
+  std::lock_guard<std::mutex> guard(theMutex);
+  auto found = theEntries.find(key);
+  if (found == theEntries.end()) return false;
+  entry = found->second;
+  return true;
+}
+
+void CompatibleDetsCache::insert(const Key& key, Entry&& entry) {
+  std::lock_guard<std::mutex> guard(theMutex);
+  theEntries.emplace(key, std::move(entry));
+}
+
+void CompatibleDetsCache::clear() {
+  std::lock_guard<std::mutex> guard(theMutex);
+  theEntries.clear();
+}
+
+std::vector<CompatibleDetsCache::DetWithState>
+CompatibleDetsCache::compatibleDets(const DetLayer& layer, const TrajectoryStateOnSurface& startingState,
+				    const Propagator& prop, const MeasurementEstimator& est) {
+  Key k = key(layer, startingState, prop, est, false);
+  Entry entry;
+  std::vector<DetWithState> result;
+  if (find(k, entry)) {
+    ++theHits;
+    for (auto det : entry.dets.front()) {
+      auto compat = GeomDetCompatibilityChecker::isCompatible(det, startingState, prop, est);
+      if (compat.first) result.emplace_back(det, std::move(compat.second));
+    }
+    return result;
+  }
+
+  ++theMisses;
+  result = layer.compatibleDets(startingState, prop, est);
+  entry.dets.resize(1);
+  for (auto const & ds : result) entry.dets.front().push_back(ds.first);
+  insert(k, std::move(entry));
+  return result;
+}
+
+std::vector<DetGroup>
+CompatibleDetsCache::groupedCompatibleDets(const DetLayer& layer, const TrajectoryStateOnSurface& startingState,
+					   const Propagator& prop, const MeasurementEstimator& est) {
+  Key k = key(layer, startingState, prop, est, true);
+  Entry entry;
+  std::vector<DetGroup> result;
+  if (find(k, entry)) {
+    ++theHits;
+    for (std::size_t i=0; i!=entry.dets.size(); ++i) {
+      DetGroup group(entry.indices[i].first, entry.indices[i].second);
+      for (auto det : entry.dets[i]) {
+	auto compat = GeomDetCompatibilityChecker::isCompatible(det, startingState, prop, est);
+	if (compat.first) group.emplace_back(det, std::move(compat.second));
+      }
+      if (!group.empty()) result.push_back(std::move(group));
+    }
+    return result;
+  }
+
+  ++theMisses;
+  result = layer.groupedCompatibleDets(startingState, prop, est);
+  for (auto const & group : result) {
+    entry.dets.emplace_back();
+    entry.indices.emplace_back(group.index(), group.indexSize());
+    for (auto const & elem : group) entry.dets.back().push_back(elem.det());
+  }
+  insert(k, std::move(entry));
+  return result;
+}
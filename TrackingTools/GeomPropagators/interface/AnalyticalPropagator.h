@@ -30,6 +30,8 @@ public:
     Propagator(dir),
     theMaxDPhi2(maxDPhi*maxDPhi),
     theMaxDBzRatio(0.5),
+    theUniformFieldR2(0),
+    theUniformFieldZ(0),
     theField(field),
     isOldPropagationType(isOld) {}
 
@@ -80,8 +82,34 @@ public:
     theMaxDBzRatio = maxDBz;
   }
 
+  /** Set the region (r < radius and |z| < halfLength) where the field is taken as uniform:
+   *  a propagation starting and ending in it uses the field of the starting state,
+   *  without querying the field at the destination. The default is no such region.
+   **/
+  void setUniformFieldRegion (const float radius, const float halfLength) {
+    theUniformFieldR2 = radius*radius;
+    theUniformFieldZ = halfLength;
+  }
+
 
 private:
+  /// propagation to plane or cylinder, specialized for the uniform field region
+  template<bool uniformField>
+  std::pair<TrajectoryStateOnSurface,double>
+  propagateWithPathT(const FreeTrajectoryState& fts, const Plane& plane) const dso_internal;
+  template<bool uniformField>
+  std::pair<TrajectoryStateOnSurface,double>
+  propagateWithPathT(const FreeTrajectoryState& fts, const Cylinder& cylinder) const dso_internal;
+
+  /// the parameters at the destination, with the field of the starting state in the uniform field region
+  template<bool uniformField>
+  bool propagatedParameters(const FreeTrajectoryState& fts, const GlobalPoint& x, const GlobalVector& p,
+			    GlobalTrajectoryParameters& gtp) const dso_internal;
+
+  bool inUniformField(const GlobalPoint& gp) const {
+    return gp.perp2() < theUniformFieldR2 && std::abs(gp.z()) < theUniformFieldZ;
+  }
+
   /// propagation of errors (if needed) and generation of a new TSOS
   std::pair<TrajectoryStateOnSurface,double> 
   propagatedStateWithPath (const FreeTrajectoryState& fts, 
@@ -119,6 +147,8 @@ private:
   typedef std::pair<TrajectoryStateOnSurface,double> TsosWP;
   float theMaxDPhi2;
   float theMaxDBzRatio;
+  float theUniformFieldR2;
+  float theUniformFieldZ;
   const MagneticField* theField;
   bool isOldPropagationType;
 };
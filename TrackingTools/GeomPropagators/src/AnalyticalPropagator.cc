@@ -25,6 +25,38 @@ using namespace SurfaceSideDefinition;
 std::pair<TrajectoryStateOnSurface,double>
 AnalyticalPropagator::propagateWithPath(const FreeTrajectoryState& fts, 
 					const Plane& plane) const
+{
+  if (inUniformField(fts.position())) return propagateWithPathT<true>(fts,plane);
+  return propagateWithPathT<false>(fts,plane);
+}
+
+std::pair<TrajectoryStateOnSurface,double>
+AnalyticalPropagator::propagateWithPath(const FreeTrajectoryState& fts, 
+					const Cylinder& cylinder) const
+{
+  if (inUniformField(fts.position())) return propagateWithPathT<true>(fts,cylinder);
+  return propagateWithPathT<false>(fts,cylinder);
+}
+
+template<bool uniformField>
+bool
+AnalyticalPropagator::propagatedParameters(const FreeTrajectoryState& fts, const GlobalPoint& x, const GlobalVector& p,
+					   GlobalTrajectoryParameters& gtp) const
+{
+  // in the uniform field region the field, and so the curvature, does not change
+  if (uniformField && inUniformField(x)) {
+    gtp = GlobalTrajectoryParameters(x,p,fts.charge(),theField,fts.parameters().magneticFieldInTesla());
+    return true;
+  }
+  gtp = GlobalTrajectoryParameters(x,p,fts.charge(),theField);
+  auto rho = fts.transverseCurvature();
+  return !(std::abs(gtp.transverseCurvature()-rho) > theMaxDBzRatio*std::abs(rho));
+}
+
+template<bool uniformField>
+std::pair<TrajectoryStateOnSurface,double>
+AnalyticalPropagator::propagateWithPathT(const FreeTrajectoryState& fts, 
+					 const Plane& plane) const
 {
   // check curvature
   float rho = fts.transverseCurvature();
@@ -55,8 +87,8 @@ AnalyticalPropagator::propagateWithPath(const FreeTrajectoryState& fts,
   //
   // Compute propagated state and check change in curvature
   //
-  GlobalTrajectoryParameters gtp(x,p,fts.charge(),theField);
-  if unlikely(std::abs(gtp.transverseCurvature()-rho)>theMaxDBzRatio*std::abs(rho) ) 
+  GlobalTrajectoryParameters gtp;
+  if unlikely(!propagatedParameters<uniformField>(fts,x,p,gtp))
     return TsosWP(TrajectoryStateOnSurface(),0.);
   //
   // construct TrajectoryStateOnSurface
@@ -65,9 +97,10 @@ AnalyticalPropagator::propagateWithPath(const FreeTrajectoryState& fts,
 }
 
 
+template<bool uniformField>
 std::pair<TrajectoryStateOnSurface,double>
-AnalyticalPropagator::propagateWithPath(const FreeTrajectoryState& fts, 
-					const Cylinder& cylinder) const
+AnalyticalPropagator::propagateWithPathT(const FreeTrajectoryState& fts, 
+					 const Cylinder& cylinder) const
 {
   // check curvature
   auto rho = fts.transverseCurvature();
@@ -85,8 +118,8 @@ AnalyticalPropagator::propagateWithPath(const FreeTrajectoryState& fts,
   //
   // Compute propagated state and check change in curvature
   //
-  GlobalTrajectoryParameters gtp(x,p,fts.charge(),theField);
-  if unlikely( std::abs(gtp.transverseCurvature()-rho)>theMaxDBzRatio*std::abs(rho) ) 
+  GlobalTrajectoryParameters gtp;
+  if unlikely(!propagatedParameters<uniformField>(fts,x,p,gtp))
     return TsosWP(TrajectoryStateOnSurface(),0.);
   //
   // create result TSOS on TangentPlane (local parameters & errors are better defined)
@@ -0,0 +1,138 @@
+// Benchmark of the propagation of AnalyticalPropagator in a uniform field:
+// the generic path, which queries the field at the destination, against the
+// uniform field region, which takes the field of the starting state.
+// Both must give the same states; the time and the number of field queries
+// per propagation are printed.
+//
+//   AnalyticalPropagator_bench [cost of a field query]
+//
+// The optional argument is the number of iterations of a busy loop done for
+// each field query, to mimic the cost of the volume lookup of the full map.
+
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "DataFormats/GeometrySurface/interface/Plane.h"
+#include "DataFormats/GeometrySurface/interface/Cylinder.h"
+#include "DataFormats/GeometrySurface/interface/SimpleCylinderBounds.h"
+#include "TrackingTools/GeomPropagators/interface/AnalyticalPropagator.h"
+#include "TrackingTools/TrajectoryState/interface/FreeTrajectoryState.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+  class CountingMagneticField final : public MagneticField {
+  public:
+    explicit CountingMagneticField(int cost) : theCost(cost) {}
+    GlobalVector inTesla(const GlobalPoint& gp) const override {
+      ++queries;
+      // busy loop standing for the volume lookup
+      volatile float x = gp.z();
+      for (int i=0; i<theCost; ++i) x = x*0.999f + 0.001f;
+      return GlobalVector(0,0,3.8);
+    }
+    mutable long queries = 0;
+  private:
+    int theCost;
+  };
+
+  // a plane facing the origin at radius r, azimuth phi and height z
+  Plane::PlanePointer barrelPlane(float r, float phi, float z) {
+    float c = std::cos(phi), s = std::sin(phi);
+    Surface::RotationType rot(-s, c, 0,
+			      0,  0, 1,
+			      c,  s, 0);
+    return Plane::build(Surface::PositionType(r*c, r*s, z), rot);
+  }
+
+  bool same(const TrajectoryStateOnSurface& a, const TrajectoryStateOnSurface& b) {
+    if (a.isValid() != b.isValid()) return false;
+    if (!a.isValid()) return true;
+    if ((a.globalPosition()-b.globalPosition()).mag() > 1.e-5f) return false;
+    if ((a.globalMomentum()-b.globalMomentum()).mag() > 1.e-5f*a.globalMomentum().mag()) return false;
+    auto const & ea = a.curvilinearError().matrix();
+    auto const & eb = b.curvilinearError().matrix();
+    for (int i=0; i!=5; ++i)
+      for (int j=0; j!=5; ++j)
+	if (std::abs(ea(i,j)-eb(i,j)) > 1.e-5*(std::abs(ea(i,j))+1.e-9)) return false;
+    return true;
+  }
+
+
+  // propagate each start to its surface with both propagators, compare and time them
+  template<typename S>
+  int run(const char * name, const CountingMagneticField & field,
+	  const Propagator & generic, const Propagator & uniform,
+	  const std::vector<FreeTrajectoryState> & starts, const std::vector<const S*> & surfaces) {
+    const int n = starts.size();
+    std::vector<TrajectoryStateOnSurface> gen, uni;
+    gen.reserve(n); uni.reserve(n);
+    long q0 = field.queries;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int t=0; t!=n; ++t) gen.push_back(generic.propagate(starts[t], *surfaces[t]));
+    auto t1 = std::chrono::steady_clock::now();
+    long q1 = field.queries;
+    for (int t=0; t!=n; ++t) uni.push_back(uniform.propagate(starts[t], *surfaces[t]));
+    auto t2 = std::chrono::steady_clock::now();
+    long q2 = field.queries;
+    int bad = 0, valid = 0;
+    for (int t=0; t!=n; ++t) { bad += !same(gen[t], uni[t]); valid += gen[t].isValid(); }
+    std::cout << name << ": " << valid << " valid states\n"
+	      << "  generic  " << 1.e9*std::chrono::duration<double>(t1-t0).count()/n << " ns, "
+	      << double(q1-q0)/n << " field queries per propagation\n"
+	      << "  uniform  " << 1.e9*std::chrono::duration<double>(t2-t1).count()/n << " ns, "
+	      << double(q2-q1)/n << " field queries per propagation" << std::endl;
+    if (bad==0) return 0;
+    std::cerr << "  MISMATCH in " << bad << " states" << std::endl;
+    return 1;
+  }
+
+}
+
+int main(int argc, char ** argv) {
+  int cost = argc>1 ? std::atoi(argv[1]) : 0;
+  CountingMagneticField field(cost);
+
+  AnalyticalPropagator generic(&field, alongMomentum);
+  AnalyticalPropagator uniform(&field, alongMomentum);
+  uniform.setUniformFieldRegion(120.f, 280.f);
+
+  // tracks from around the beam spot, propagated through planes and cylinders at the radii of the barrel layers
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> phi(-M_PI, M_PI), eta(-1.f, 1.f), pt(0.5f, 10.f), z0(-5.f, 5.f);
+  const std::vector<float> radii = {4.4f, 7.3f, 10.2f, 25.5f, 33.9f, 41.8f, 49.8f, 60.8f, 69.2f, 78.0f, 86.8f, 96.5f, 108.0f};
+  const int nTracks = 20000;
+
+  std::vector<FreeTrajectoryState> starts;
+  std::vector<Plane::PlanePointer> planes;
+  std::vector<Cylinder::CylinderPointer> cylinders;
+  for (float r : radii)
+    cylinders.push_back(Cylinder::build(r, Surface::PositionType(0,0,0), Surface::RotationType(),
+					new SimpleCylinderBounds(r-0.1f, r+0.1f, -280.f, 280.f)));
+  AlgebraicSymMatrix55 err;
+  for (int i=0; i!=5; ++i) err(i,i) = 1.e-4;
+  for (int t=0; t!=nTracks; ++t) {
+    float ph = phi(gen), th = 2.f*std::atan(std::exp(-eta(gen)));
+    float p = pt(gen)/std::sin(th);
+    GlobalVector mom(p*std::sin(th)*std::cos(ph), p*std::sin(th)*std::sin(ph), p*std::cos(th));
+    GlobalTrajectoryParameters gtp(GlobalPoint(0,0,z0(gen)), mom, t%2 ? 1 : -1, &field);
+    starts.emplace_back(gtp, CurvilinearTrajectoryError(err));
+    planes.push_back(barrelPlane(radii[t%radii.size()], ph, radii[t%radii.size()]*std::cos(th)/std::sin(th)));
+  }
+
+  int status = 0;
+  std::vector<const Plane*> toPlanes;
+  std::vector<const Cylinder*> toCylinders;
+  for (int t=0; t!=nTracks; ++t) {
+    toPlanes.push_back(planes[t].get());
+    toCylinders.push_back(cylinders[t%cylinders.size()].get());
+  }
+  status |= run("plane", field, generic, uniform, starts, toPlanes);
+  status |= run("cylinder", field, generic, uniform, starts, toCylinders);
+
+  return status;
+}
@@ -6,7 +6,7 @@
 #include "DataFormats/GeometryCommonDetAlgo/interface/DeepCopyPointerByClone.h"
 
 #include "boost/shared_ptr.hpp"
-#include <map>
+#include <vector>
 
 
 /** Merging of a Gaussian mixture by clustering components
@@ -40,7 +40,9 @@ class CloseComponentsMerger : public MultiGaussianStateMerger<N> {
   
 
 public:
-  typedef std::multimap< double, SingleStatePtr > SingleStateMap;
+  // (weight, component) sorted by increasing weight, the components of equal
+  // weight in the order they were inserted (as a multimap, without its nodes)
+  typedef std::vector< std::pair< double, SingleStatePtr > > SingleStateMap;
   typedef std::pair< SingleStatePtr, typename SingleStateMap::iterator > MinDistResult;
 
 private:
@@ -49,6 +51,8 @@ private:
   MinDistResult
   compWithMinDistToLargestWeight(SingleStateMap&) const;
 
+  static void insert(SingleStateMap&, double weight, const SingleStatePtr&);
+
   int theMaxNumberOfComponents;
   DeepCopyPointerByClone< DistanceBetweenComponents<N> > theDistance;
 
@@ -5,6 +5,8 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/Exception.h"
 
+#include <algorithm>
+
 MultiTrajectoryStateAssembler::MultiTrajectoryStateAssembler () :
   combinationDone(false),
   thePzError(false),
@@ -197,20 +199,11 @@ MultiTrajectoryStateAssembler::removeSmallWeights()
     return;
   }
   //
-  // Loop until no more states are removed
-  //
-  bool redo;
-  do {
-    redo = false;
-    for ( MultiTSOS::iterator i=theStates.begin();
-	  i!=theStates.end(); i++ ) {
-      if ( (*i).weight()/totalWeight < minFractionalWeight ) {
-	theStates.erase(i);
-	redo = true;
-	break;
-      }
-    }
-  } while (redo);
+  // Remove the states in one pass, keeping the order of the others
+  //
+  theStates.erase(std::remove_if(theStates.begin(),theStates.end(),
+				 [&](const TSOS& s) { return s.weight()/totalWeight < minFractionalWeight; }),
+		  theStates.end());
 }
 
 void
@@ -0,0 +1,78 @@
+#ifndef _TRACKER_KFBATCHUPDATOR_H_
+#define _TRACKER_KFBATCHUPDATOR_H_
+
+/** \class KFBatchUpdator
+ * Kalman update of many (predicted state, hit) pairs at once, e.g. of all
+ * the candidate/hit combinations found while extending the candidates of a
+ * seed by one layer. <BR>
+ *
+ * Pairs with a two-dimensional hit measuring the local position (pixel and
+ * matched strip hits) are copied into a structure of arrays and updated by
+ * loops over the pairs, which gcc auto-vectorizes across candidates. The
+ * remaining pairs, and those whose residual covariance is not positive
+ * definite, are updated one by one by the KFUpdator. <BR>
+ *
+ * The batched results agree with those of the KFUpdator up to rounding, and
+ * do not depend on the number of pairs in the batch or on their position in it.
+ *
+ * Usage: add() all the pairs, run(), then read the results by index;
+ * the states and hits must stay alive until run() returns.
+ */
+
+#include "TrackingTools/KalmanUpdators/interface/KFUpdator.h"
+#include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
+
+#include <vector>
+
+class TrackingRecHit;
+
+class KFBatchUpdator {
+public:
+
+  KFBatchUpdator() {}
+
+  /// queue a pair, and return its index
+  unsigned int add(const TrajectoryStateOnSurface& tsos, const TrackingRecHit& hit);
+
+  /// update all the queued pairs
+  void run();
+
+  /// results, valid after run()
+  const TrajectoryStateOnSurface & updatedState(unsigned int i) const { return theUpdated[i]; }
+  double chiSquared(unsigned int i) const { return theChi2[i]; }
+  bool batched(unsigned int i) const { return theSlot[i] >= 0; }
+
+  unsigned int size() const { return theStates.size(); }
+  void clear();
+
+private:
+
+  // the batched pairs, one array per component of the inputs and outputs
+  struct soa_t {
+    void resize(unsigned int n);
+    unsigned int size() const { return pair.size(); }
+
+    std::vector<unsigned int> pair;     // index of the pair in the batch
+    std::vector<double> x[5];           // predicted local parameters
+    std::vector<double> c[15];          // predicted local errors, lower triangle by rows
+    std::vector<double> m[2];           // measured local position
+    std::vector<double> v[3];           // measured local position error (xx, xy, yy)
+    std::vector<double> fx[5];          // filtered local parameters
+    std::vector<double> fc[15];         // filtered local errors
+    std::vector<double> chi2;           // chi2 increment of the update
+    std::vector<double> r00;            // residual covariance and its determinant,
+    std::vector<double> det;            // used to flag the pairs the kernel cannot handle
+  };
+
+  void kernel(unsigned int n);
+
+  KFUpdator                                   theUpdator;
+  std::vector<const TrajectoryStateOnSurface *> theStates;
+  std::vector<const TrackingRecHit *>         theHits;
+  std::vector<int>                            theSlot;      // position in theBatch, or -1 for a scalar update
+  std::vector<TrajectoryStateOnSurface>       theUpdated;
+  std::vector<double>                         theChi2;
+  soa_t                                       theBatch;
+};
+
+#endif
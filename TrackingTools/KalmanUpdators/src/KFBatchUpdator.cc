@@ -0,0 +1,218 @@
+#include "TrackingTools/KalmanUpdators/interface/KFBatchUpdator.h"
+#include "TrackingTools/KalmanUpdators/interface/Chi2MeasurementEstimator.h"
+#include "TrackingTools/TransientTrackingRecHit/interface/TransientTrackingRecHit.h"
+#include "DataFormats/GeometrySurface/interface/Plane.h"
+#include "DataFormats/TrackingRecHit/interface/KfComponentsHolder.h"
+#include "DataFormats/Math/interface/ProjectMatrix.h"
+
+#include <limits>
+
+namespace {
+  // index of the element (i,j), i>=j, of a symmetric 5x5 matrix stored as a lower triangle by rows
+  constexpr unsigned int sym(unsigned int i, unsigned int j) { return i*(i+1)/2 + j; }
+}
+
+void KFBatchUpdator::soa_t::resize(unsigned int n) {
+  pair.resize(n);
+  for (auto & a : x)  a.resize(n);
+  for (auto & a : c)  a.resize(n);
+  for (auto & a : m)  a.resize(n);
+  for (auto & a : v)  a.resize(n);
+  for (auto & a : fx) a.resize(n);
+  for (auto & a : fc) a.resize(n);
+  chi2.resize(n);
+  r00.resize(n);
+  det.resize(n);
+}
+
+void KFBatchUpdator::clear() {
+  theStates.clear();
+  theHits.clear();
+  theSlot.clear();
+  theUpdated.clear();
+  theChi2.clear();
+  theBatch.resize(0);
+}
+
+unsigned int KFBatchUpdator::add(const TrajectoryStateOnSurface& tsos, const TrackingRecHit& hit) {
+  unsigned int index = theStates.size();
+  theStates.push_back(&tsos);
+  theHits.push_back(&hit);
+  theSlot.push_back(-1);
+
+  if (hit.dimension() != 2)
+    return index;
+
+  // let the hit fill in its measurement, in the same way as for the KFUpdator
+  AlgebraicVector2 r, rMeas;
+  AlgebraicSymMatrix22 V, VMeas;
+  ProjectMatrix<double,5,2> pf;
+  auto && x = tsos.localParameters().vector();
+  auto && C = tsos.localError().matrix();
+  KfComponentsHolder holder;
+  holder.setup<2>(&r, &V, &pf, &rMeas, &VMeas, x, C);
+  hit.getKfComponents(holder);
+
+  // only hits measuring the local position are batched
+  if (pf.index[0] != 3 or pf.index[1] != 4)
+    return index;
+
+  unsigned int slot = theBatch.size();
+  theBatch.pair.push_back(index);
+  for (unsigned int i = 0; i < 5; ++i)
+    theBatch.x[i].push_back(x[i]);
+  for (unsigned int i = 0; i < 5; ++i)
+    for (unsigned int j = 0; j <= i; ++j)
+      theBatch.c[sym(i,j)].push_back(C(i,j));
+  theBatch.m[0].push_back(r[0]);
+  theBatch.m[1].push_back(r[1]);
+  theBatch.v[0].push_back(V(0,0));
+  theBatch.v[1].push_back(V(0,1));
+  theBatch.v[2].push_back(V(1,1));
+  theSlot.back() = slot;
+  return index;
+}
+
+// Kalman update of the batched pairs, with H selecting the local position (parameters 3 and 4):
+//   residual              res = m - H x
+//   residual covariance   R   = V + H C H^T
+//   gain                  K   = C H^T R^-1
+//   filtered state        x'  = x + K res
+//   filtered error        C'  = (1 - K H) C (1 - K H)^T + K V K^T
+//   chi2 increment            = res^T R^-1 res
+// Each loop runs over the pairs with no branches, so that gcc auto-vectorizes it.
+void KFBatchUpdator::kernel(unsigned int n) {
+  soa_t & b = theBatch;
+  b.resize(n);          // allocate the outputs
+
+  double const * __restrict__ c33 = b.c[sym(3,3)].data();
+  double const * __restrict__ c43 = b.c[sym(4,3)].data();
+  double const * __restrict__ c44 = b.c[sym(4,4)].data();
+  double const * __restrict__ v00 = b.v[0].data();
+  double const * __restrict__ v01 = b.v[1].data();
+  double const * __restrict__ v11 = b.v[2].data();
+  double const * __restrict__ m0  = b.m[0].data();
+  double const * __restrict__ m1  = b.m[1].data();
+  double const * __restrict__ x3  = b.x[3].data();
+  double const * __restrict__ x4  = b.x[4].data();
+  double * __restrict__ r00 = b.r00.data();
+  double * __restrict__ det = b.det.data();
+  double * __restrict__ chi2 = b.chi2.data();
+
+  // inverse of the residual covariance and the residual
+  std::vector<double> ri00(n), ri01(n), ri11(n), res0(n), res1(n);
+  double * __restrict__ pri00 = ri00.data();
+  double * __restrict__ pri01 = ri01.data();
+  double * __restrict__ pri11 = ri11.data();
+  double * __restrict__ pres0 = res0.data();
+  double * __restrict__ pres1 = res1.data();
+  for (unsigned int k = 0; k < n; ++k) {
+    double a = v00[k] + c33[k];
+    double o = v01[k] + c43[k];
+    double d = v11[k] + c44[k];
+    double dt = a*d - o*o;
+    double id = 1./dt;
+    r00[k] = a;
+    det[k] = dt;
+    pri00[k] =  d * id;
+    pri01[k] = -o * id;
+    pri11[k] =  a * id;
+    pres0[k] = m0[k] - x3[k];
+    pres1[k] = m1[k] - x4[k];
+    chi2[k] = pres0[k] * (pri00[k]*pres0[k] + pri01[k]*pres1[k]) + pres1[k] * (pri01[k]*pres0[k] + pri11[k]*pres1[k]);
+  }
+
+  // gain, and filtered parameters
+  std::vector<double> k0[5], k1[5];
+  for (unsigned int i = 0; i < 5; ++i) {
+    k0[i].resize(n);
+    k1[i].resize(n);
+    double const * __restrict__ ci3 = b.c[i >= 3 ? sym(i,3) : sym(3,i)].data();
+    double const * __restrict__ ci4 = b.c[sym(4,i)].data();
+    double const * __restrict__ xi  = b.x[i].data();
+    double * __restrict__ pk0 = k0[i].data();
+    double * __restrict__ pk1 = k1[i].data();
+    double * __restrict__ fxi = b.fx[i].data();
+    for (unsigned int k = 0; k < n; ++k) {
+      pk0[k] = ci3[k]*pri00[k] + ci4[k]*pri01[k];
+      pk1[k] = ci3[k]*pri01[k] + ci4[k]*pri11[k];
+      fxi[k] = xi[k] + (pk0[k]*pres0[k] + pk1[k]*pres1[k]);
+    }
+  }
+
+  // A = (1 - K H) C, all five rows but only the columns needed below
+  // (the lower triangle, plus columns 3 and 4)
+  std::vector<double> a[5][5];
+  for (unsigned int i = 0; i < 5; ++i) {
+    double const * __restrict__ pk0 = k0[i].data();
+    double const * __restrict__ pk1 = k1[i].data();
+    for (unsigned int l = 0; l < 5; ++l) {
+      if (l > i and l < 3)
+        continue;
+      a[i][l].resize(n);
+      double const * __restrict__ cil = b.c[i >= l ? sym(i,l) : sym(l,i)].data();
+      double const * __restrict__ cl3 = b.c[l >= 3 ? sym(l,3) : sym(3,l)].data();
+      double const * __restrict__ cl4 = b.c[sym(4,l)].data();
+      double * __restrict__ ail = a[i][l].data();
+      for (unsigned int k = 0; k < n; ++k)
+        ail[k] = cil[k] - (pk0[k]*cl3[k] + pk1[k]*cl4[k]);
+    }
+  }
+
+  // C' = A (1 - K H)^T + K V K^T, lower triangle
+  for (unsigned int i = 0; i < 5; ++i) {
+    double const * __restrict__ ai3 = a[i][3].data();
+    double const * __restrict__ ai4 = a[i][4].data();
+    double const * __restrict__ pki0 = k0[i].data();
+    double const * __restrict__ pki1 = k1[i].data();
+    for (unsigned int l = 0; l <= i; ++l) {
+      double const * __restrict__ ail = a[i][l].data();
+      double const * __restrict__ pkl0 = k0[l].data();
+      double const * __restrict__ pkl1 = k1[l].data();
+      double * __restrict__ fcil = b.fc[sym(i,l)].data();
+      for (unsigned int k = 0; k < n; ++k) {
+        double mcm = ail[k] - (ai3[k]*pkl0[k] + ai4[k]*pkl1[k]);
+        double kvk = pki0[k]*(v00[k]*pkl0[k] + v01[k]*pkl1[k]) + pki1[k]*(v01[k]*pkl0[k] + v11[k]*pkl1[k]);
+        fcil[k] = mcm + kvk;
+      }
+    }
+  }
+}
+
+void KFBatchUpdator::run() {
+  unsigned int n = theBatch.size();
+  if (n > 0)
+    kernel(n);
+
+  theUpdated.resize(theStates.size());
+  theChi2.resize(theStates.size());
+
+  static const Chi2MeasurementEstimator estimator(std::numeric_limits<double>::max());
+  for (unsigned int i = 0; i < theStates.size(); ++i) {
+    const TrajectoryStateOnSurface & tsos = * theStates[i];
+    int slot = theSlot[i];
+
+    // the residual covariance must be positive definite, otherwise fall back to the KFUpdator
+    if (slot >= 0 and not (theBatch.r00[slot] > 0. and theBatch.det[slot] > 0.)) {
+      theSlot[i] = slot = -1;
+    }
+
+    if (slot < 0) {
+      theUpdated[i] = theUpdator.update(tsos, * theHits[i]);
+      theChi2[i]    = estimator.estimate(tsos, * theHits[i]).second;
+      continue;
+    }
+
+    AlgebraicVector5 fsv;
+    for (unsigned int j = 0; j < 5; ++j)
+      fsv[j] = theBatch.fx[j][slot];
+    AlgebraicSymMatrix55 fse;
+    for (unsigned int j = 0; j < 5; ++j)
+      for (unsigned int l = 0; l <= j; ++l)
+        fse(j,l) = theBatch.fc[sym(j,l)][slot];
+
+    theUpdated[i] = TrajectoryStateOnSurface( LocalTrajectoryParameters(fsv, tsos.localParameters().pzSign()),
+                                              LocalTrajectoryError(fse), tsos.surface(), &(tsos.globalParameters().magneticField()), tsos.surfaceSide() );
+    theChi2[i]    = theBatch.chi2[slot];
+  }
+}
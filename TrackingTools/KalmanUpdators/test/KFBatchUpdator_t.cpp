@@ -0,0 +1,156 @@
+#include "TrackingTools/KalmanUpdators/interface/KFUpdator.h"
+#include "TrackingTools/KalmanUpdators/interface/KFBatchUpdator.h"
+#include "TrackingTools/KalmanUpdators/interface/Chi2MeasurementEstimator.h"
+
+#include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
+#include "DataFormats/GeometrySurface/interface/Surface.h"
+#include "DataFormats/GeometrySurface/interface/BoundPlane.h"
+#include <Geometry/CommonDetUnit/interface/GeomDet.h>
+
+#include "MagneticField/Engine/interface/MagneticField.h"
+
+#include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit2D.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiStripRecHit1D.h"
+#include "DataFormats/TrackerRecHit2D/interface/SiPixelRecHit.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Compares the KFBatchUpdator with the KFUpdator, and checks that the batched
+// results do not depend on the size of the batch or on the position in it.
+
+class ConstMagneticField : public MagneticField {
+public:
+
+  virtual GlobalVector inTesla ( const GlobalPoint& ) const {
+    return GlobalVector(0,0,4);
+  }
+
+};
+
+// A fake Det class
+
+class MyDet : public GeomDet {
+ public:
+  MyDet(BoundPlane * bp, DetId id) :
+    GeomDet(bp){setDetId(id);}
+
+  virtual std::vector< const GeomDet*> components() const {
+    return std::vector< const GeomDet*>();
+  }
+
+  /// Which subdetector
+  virtual SubDetector subDetector() const {return GeomDetEnumerators::DT;}
+
+};
+
+namespace {
+
+  int failures = 0;
+
+  bool close(double a, double b, double tolerance) {
+    return std::abs(a - b) <= tolerance * std::max(1., std::max(std::abs(a), std::abs(b)));
+  }
+
+  void compare(TrajectoryStateOnSurface const & a, TrajectoryStateOnSurface const & b, double tolerance, const char * what) {
+    if (a.isValid() != b.isValid()) {
+      std::cout << what << ": validity differs" << std::endl;
+      ++failures;
+      return;
+    }
+    if (!a.isValid())
+      return;
+    auto && va = a.localParameters().vector();
+    auto && vb = b.localParameters().vector();
+    auto && ma = a.localError().matrix();
+    auto && mb = b.localError().matrix();
+    for (unsigned int i = 0; i < 5; ++i) {
+      bool same = (tolerance == 0.) ? va[i] == vb[i] : close(va[i], vb[i], tolerance);
+      for (unsigned int j = 0; j <= i; ++j)
+        same = same && ((tolerance == 0.) ? ma(i,j) == mb(i,j) : close(ma(i,j), mb(i,j), tolerance));
+      if (!same) {
+        std::cout << what << ": results differ\n" << va << '\n' << vb << '\n' << ma << '\n' << mb << std::endl;
+        ++failures;
+        return;
+      }
+    }
+  }
+
+}
+
+int main() {
+
+  MagneticField * field = new ConstMagneticField;
+  GlobalPoint gp(0,0,0);
+  BoundPlane* plane = new BoundPlane( gp, Surface::RotationType());
+  GeomDet *  det =  new MyDet(plane,41);
+
+  // a set of predicted states with different parameters and errors
+  std::vector<TrajectoryStateOnSurface> states;
+  for (int i = 0; i < 13; ++i) {
+    LocalPoint lp(0.01*i, -0.02*i, 0);
+    LocalVector lv(1.+0.1*i, 1.-0.05*i, 1);
+    LocalTrajectoryParameters ltp(lp, lv, (i%2) ? 1 : -1);
+    LocalTrajectoryError ler(0.1+0.01*i, 0.1, 0.01+0.002*i, 0.05, 0.1+0.03*i);
+    states.push_back(TrajectoryStateOnSurface(ltp, ler, *plane, field));
+  }
+
+  // 2D hits, which are batched, and 1D hits, which are not
+  OmniClusterRef cref;
+  SiPixelRecHit::ClusterRef pref;
+  std::vector<TrackingRecHit *> hits;
+  for (int i = 0; i < 5; ++i) {
+    LocalPoint m(0.1-0.03*i, 0.1+0.02*i, 0);
+    LocalError e(0.2+0.01*i, -0.05, 0.1);
+    hits.push_back(new SiPixelRecHit(m, e, 1., *det, pref));
+    hits.push_back(new SiStripRecHit2D(m, e, *det, cref));
+  }
+  hits.push_back(new SiStripRecHit1D(LocalPoint(0.1,0.1,0), LocalError(0.2,0.,0.1), *det, cref));
+
+  KFUpdator updator;
+  Chi2MeasurementEstimator estimator(1.e30);
+
+  // all the pairs in one batch
+  KFBatchUpdator all;
+  for (auto const & state : states)
+    for (auto const * hit : hits)
+      all.add(state, *hit);
+  all.run();
+
+  unsigned int index = 0;
+  unsigned int nbatched = 0;
+  for (auto const & state : states) {
+    for (auto const * hit : hits) {
+      // against the scalar updator and estimator
+      compare(all.updatedState(index), updator.update(state, *hit), 1.e-6, "batched vs. KFUpdator");
+      if (!close(all.chiSquared(index), estimator.estimate(state, *hit).second, 1.e-9)) {
+        std::cout << "batched vs. Chi2MeasurementEstimator: chi2 " << all.chiSquared(index) << " != " << estimator.estimate(state, *hit).second << std::endl;
+        ++failures;
+      }
+
+      // the same pair alone, and at the end of a batch of a different size: must be bit-for-bit identical
+      KFBatchUpdator one;
+      one.add(state, *hit);
+      one.run();
+      compare(all.updatedState(index), one.updatedState(0), 0., "batch of one vs. full batch");
+
+      KFBatchUpdator some;
+      for (unsigned int k = 0; k < index % 7; ++k)
+        some.add(states[k], *hits[k % hits.size()]);
+      unsigned int last = some.add(state, *hit);
+      some.run();
+      compare(all.updatedState(index), some.updatedState(last), 0., "partial batch vs. full batch");
+      if (all.chiSquared(index) != one.chiSquared(0) || all.chiSquared(index) != some.chiSquared(last)) {
+        std::cout << "chi2 depends on the batch" << std::endl;
+        ++failures;
+      }
+
+      if (all.batched(index)) ++nbatched;
+      ++index;
+    }
+  }
+
+  std::cout << index << " pairs, " << nbatched << " batched, " << failures << " failures" << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -13,6 +13,7 @@
 #include "TrackingTools/MaterialEffects/interface/MultipleScatteringUpdator.h"
 #include "TrackingTools/MaterialEffects/interface/EnergyLossUpdator.h"
 #include "TrackingTools/MaterialEffects/interface/MaterialEffectsUpdator.h"
+#include "TrackingTools/MaterialEffects/interface/MaterialEffectsTables.h"
 #include "FWCore/Utilities/interface/Visibility.h"
 
 class CombinedMaterialEffectsUpdator GCC11_FINAL : public MaterialEffectsUpdator
@@ -27,10 +28,18 @@ public:
   /// If ptMin > 0, then the rms muliple scattering angle will be calculated taking into account the uncertainty
   /// in the reconstructed track momentum. (By default, it is neglected). However, a lower limit on the possible
   /// value of the track Pt will be applied at ptMin, to avoid the rms multiple scattering becoming too big.
-  CombinedMaterialEffectsUpdator(double mass, double ptMin = -1. ) :
+  /// If useTables, the material effects are looked up in MaterialEffectsTables precomputed for the mass.
+  CombinedMaterialEffectsUpdator(double mass, double ptMin = -1., bool useTables = false ) :
+    CombinedMaterialEffectsUpdator(mass, ptMin,
+				   useTables ? std::make_shared<const MaterialEffectsTables>(mass) :
+				   std::shared_ptr<const MaterialEffectsTables>()) {}
+
+  /// With tables shared with other updators (may be null).
+  CombinedMaterialEffectsUpdator(double mass, double ptMin,
+				 std::shared_ptr<const MaterialEffectsTables> tables ) :
     MaterialEffectsUpdator(mass),
-    theMSUpdator(mass, ptMin),
-    theELUpdator(mass) {}
+    theMSUpdator(mass, ptMin, tables),
+    theELUpdator(mass, tables) {}
 
   // here comes the actual computation of the values
   virtual void compute (const TrajectoryStateOnSurface&, const PropagationDirection, Effect & effect) const;
@@ -15,7 +15,10 @@
 #include "DataFormats/GeometryVector/interface/LocalVector.h"
 #include "FWCore/Utilities/interface/Visibility.h"
 
+#include <memory>
+
 class MediumProperties;
+class MaterialEffectsTables;
 
 class EnergyLossUpdator GCC11_FINAL : public MaterialEffectsUpdator 
 {
@@ -25,13 +28,22 @@ class EnergyLossUpdator GCC11_FINAL : public MaterialEffectsUpdator
   }
 
 public:
-  EnergyLossUpdator( double mass ) :
-    MaterialEffectsUpdator(mass) {}
+  /// If tables are given, the energy loss and its variance are looked up in them.
+  EnergyLossUpdator( double mass,
+		     std::shared_ptr<const MaterialEffectsTables> tables = std::shared_ptr<const MaterialEffectsTables>() ) :
+    MaterialEffectsUpdator(mass), theTables(tables) {}
 
   // here comes the actual computation of the values
   virtual void compute (const TrajectoryStateOnSurface&, 
 			const PropagationDirection, Effect & effect) const;
 
+  /// Bethe-Bloch momentum loss and its variance in 1/p, divided by the effective xi,
+  /// for the squares of the momentum and of the mass
+  static void betheBloch (float p2, float m2, float & loss, float & variance);
+  /// Bethe-Heitler fraction of the momentum kept and its variance,
+  /// for the effective thickness t in radiation lengths
+  static void betheHeitler (float t, float & z, float & varz);
+
 private:
   // Internal routine for ionization acc. to Bethe-Bloch
   void computeBetheBloch (const LocalVector&, const MediumProperties&, Effect & effect) const dso_internal;
@@ -39,6 +51,7 @@ private:
   void computeElectrons (const LocalVector&, const MediumProperties&,
 			 const PropagationDirection, Effect & effect) const dso_internal;
 
+  std::shared_ptr<const MaterialEffectsTables> theTables;
 };
 
 #endif
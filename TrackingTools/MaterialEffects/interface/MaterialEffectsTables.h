@@ -0,0 +1,81 @@
+#ifndef _CR_MATERIALEFFECTSTABLES_H_
+#define _CR_MATERIALEFFECTSTABLES_H_
+
+/** \class MaterialEffectsTables
+ *  Tabulated material effects for one mass hypothesis, to replace the logs,
+ *  exps and divisions of MultipleScatteringUpdator and EnergyLossUpdator
+ *  by an interpolated lookup.
+ *  The surface enters the formulas only through its radiation length and xi
+ *  scaled by the path length, so the tables are shared by all surfaces:
+ *  the multiple scattering and the electron energy loss are functions of the
+ *  effective thickness (in radiation lengths, including the incidence angle),
+ *  the Bethe-Bloch energy loss is xi times a function of p^2.
+ *  Each lookup returns false outside the tabulated range, and the caller
+ *  then uses the formula.
+ */
+
+#include <cstring>
+#include <vector>
+
+class MaterialEffectsTables {
+public:
+  explicit MaterialEffectsTables(float mass);
+
+  /// radLen*(1+0.038*log(radLen))^2, for the effective thickness radLen
+  bool multipleScattering(float radLen, float & thicknessFactor) const {
+    return theMultipleScattering(radLen, thicknessFactor);
+  }
+
+  /// momentum loss and its variance in 1/p^2, both divided by the effective xi
+  bool betheBloch(float p2, float & loss, float & variance) const {
+    if (!theBetheBlochLoss(p2, loss)) return false;
+    theBetheBlochVariance(p2, variance);
+    variance /= p2*p2;
+    return true;
+  }
+
+  /// fraction of the momentum kept and its variance, for the effective thickness t
+  bool betheHeitler(float t, float & z, float & varz) const {
+    if (!theBetheHeitlerZ(t, z)) return false;
+    theBetheHeitlerVariance(t, varz);
+    return true;
+  }
+
+private:
+  // A function of x>0 tabulated at the edges of bins of equal width within each
+  // octave: the bin of x is given by its exponent and the leading bits of its mantissa,
+  // so that the lookup needs no log, and the interpolation is linear in x.
+  class LogBinnedTable {
+  public:
+    template<typename F> LogBinnedTable(F f, float xMin, float xMax);
+
+    bool operator()(float x, float & value) const {
+      unsigned int b = bits(x);
+      unsigned int u = b >> shift;
+      if (u < theFirst || u >= theLast) return false;  // also for x<=0 and nan
+      float frac = float(b & mask) * (1.f/(mask+1));
+      const float * v = &theValues[u - theFirst];
+      value = v[0] + frac*(v[1]-v[0]);
+      return true;
+    }
+
+  private:
+    static constexpr int mantissaBits = 7;             // 128 bins per octave
+    static constexpr int shift = 23 - mantissaBits;
+    static constexpr unsigned int mask = (1u << shift) - 1;
+    static unsigned int bits(float x) { unsigned int i; std::memcpy(&i, &x, sizeof(i)); return i; }
+    static float value(unsigned int i) { float x; std::memcpy(&x, &i, sizeof(x)); return x; }
+
+    unsigned int theFirst;
+    unsigned int theLast;
+    std::vector<float> theValues;
+  };
+
+  LogBinnedTable theMultipleScattering;
+  LogBinnedTable theBetheBlochLoss;
+  LogBinnedTable theBetheBlochVariance;   // times p^4
+  LogBinnedTable theBetheHeitlerZ;
+  LogBinnedTable theBetheHeitlerVariance;
+};
+
+#endif
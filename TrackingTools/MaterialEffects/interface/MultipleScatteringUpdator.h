@@ -12,6 +12,10 @@
 #include "TrackingTools/MaterialEffects/interface/MaterialEffectsUpdator.h"
 #include "FWCore/Utilities/interface/Visibility.h"
 
+#include <memory>
+
+class MaterialEffectsTables;
+
 class MultipleScatteringUpdator GCC11_FINAL : public MaterialEffectsUpdator 
 {
   virtual dso_export MultipleScatteringUpdator* clone() const {
@@ -23,9 +27,11 @@ public:
   /// If ptMin > 0, then the rms muliple scattering angle will be calculated taking into account the uncertainty
   /// in the reconstructed track momentum. (By default, it is neglected). However, a lower limit on the possible
   /// value of the track Pt will be applied at ptMin, to avoid the rms multiple scattering becoming too big.
-  MultipleScatteringUpdator(double mass, double ptMin=-1. ) :
+  /// If tables are given, the thickness factor of the Highland formula is looked up in them.
+  MultipleScatteringUpdator(double mass, double ptMin=-1.,
+			    std::shared_ptr<const MaterialEffectsTables> tables = std::shared_ptr<const MaterialEffectsTables>()) :
     MaterialEffectsUpdator(mass),
-    thePtMin(ptMin) {}
+    thePtMin(ptMin), theTables(tables) {}
   /// destructor
   ~MultipleScatteringUpdator() {}
 
@@ -33,10 +39,13 @@ public:
   // here comes the actual computation of the values
   virtual void compute (const TrajectoryStateOnSurface&, const PropagationDirection, Effect & effect) const;
 
+  /// radLen*(1+0.038*log(radLen))^2, for the effective thickness radLen in radiation lengths
+  static float thicknessFactor(float radLen);
 
 private:  
 
   double thePtMin;
+  std::shared_ptr<const MaterialEffectsTables> theTables;
 
 };
 
@@ -34,10 +34,14 @@ public:
    *  account the uncertainty in the reconstructed track momentum, (by
    *  default neglected), but assuming that the track Pt will never fall
    *  below ptMin.
+   *  If useMaterialTables, the material effects are interpolated in tables
+   *  precomputed for the mass (see MaterialEffectsTables) instead of
+   *  being computed at each surface.
    */
   PropagatorWithMaterial (PropagationDirection dir, const float mass,
 			  const MagneticField * mf=0,const float maxDPhi=1.6,
-			  bool useRungeKutta=false, float ptMin=-1.,bool useOldGeoPropLogic=true);
+			  bool useRungeKutta=false, float ptMin=-1.,bool useOldGeoPropLogic=true,
+			  bool useMaterialTables=false);
 
   virtual ~PropagatorWithMaterial();
 
@@ -37,6 +37,8 @@ PropagatorWithMaterialESProducer::produce(const TrackingComponentsRecord & iReco
   bool useOldAnalPropLogic = pset_.existsAs<bool>("useOldAnalPropLogic") ? 
     pset_.getParameter<bool>("useOldAnalPropLogic") : true;
   double ptMin     = pset_.existsAs<double>("ptMin") ? pset_.getParameter<double>("ptMin") : -1.0;
+  bool useMaterialTables = pset_.existsAs<bool>("useMaterialTables") ?
+    pset_.getParameter<bool>("useMaterialTables") : false;
 
   ESHandle<MagneticField> magfield;
   std::string mfName = "";
@@ -55,7 +57,7 @@ PropagatorWithMaterialESProducer::produce(const TrackingComponentsRecord & iReco
   
   _propagator  = boost::shared_ptr<Propagator>(new PropagatorWithMaterial(dir, mass, &(*magfield),
 									  maxDPhi,useRK,ptMin,
-									  useOldAnalPropLogic));
+									  useOldAnalPropLogic,useMaterialTables));
   return _propagator;
 }
 
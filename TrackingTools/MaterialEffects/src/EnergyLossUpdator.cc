@@ -1,4 +1,5 @@
 #include "TrackingTools/MaterialEffects/interface/EnergyLossUpdator.h"
+#include "TrackingTools/MaterialEffects/interface/MaterialEffectsTables.h"
 #include "DataFormats/GeometrySurface/interface/MediumProperties.h"
 
 #include "DataFormats/Math/interface/approx_exp.h"
@@ -47,24 +48,14 @@ void EnergyLossUpdator::compute (const TrajectoryStateOnSurface& TSoS,
   }
 }
 //
-// Computation of energy loss according to Bethe-Bloch
+// Bethe-Bloch per unit of xi: depends on the momentum and the mass only
 //
 void
-EnergyLossUpdator::computeBetheBloch (const LocalVector& localP,
-				      const MediumProperties& materialConstants, Effect & effect) const {
-  //
-  // calculate absolute momentum and correction to path length from angle 
-  // of incidence
-  //
+EnergyLossUpdator::betheBloch (float p2, float m2, float & loss, float & variance) {
 
   typedef float Float;
 
-  Float p2 = localP.mag2();
-  Float xf = std::abs(std::sqrt(p2)/localP.z());
-   
   // constants
-  const Float m2 = mass()*mass();           // use mass hypothesis from constructor
-
   constexpr Float emass = 0.511e-3;
   constexpr Float poti = 16.e-9 * 10.75; // = 16 eV * Z**0.9, for Si Z=14
   const Float eplasma = 28.816e-9 * sqrt(2.33*0.498); // 28.816 eV * sqrt(rho*(Z/A)) for Si
@@ -79,13 +70,37 @@ EnergyLossUpdator::computeBetheBloch (const LocalVector& localP,
   Float ratio2 = (emass*emass)*im2;
   Float emax  = Float(2.)*emass*eta2/(Float(1.) + Float(2.)*emass*e*im2 + ratio2);
   
-  Float xi = materialConstants.xi()*xf; xi /= beta2;
+  Float xi = Float(1.)/beta2;
   
   Float dEdx = xi*(unsafe_logf<2>(Float(2.)*emass*emax/(poti*poti)) - Float(2.)*(beta2) - delta0);
   
   Float dEdx2 = xi*emax*(Float(1.)-Float(0.5)*beta2);
-  Float dP    = dEdx/std::sqrt(beta2);
-  Float sigp2 = dEdx2/(beta2*p2*p2);
+  loss     = dEdx/std::sqrt(beta2);
+  variance = dEdx2/(beta2*p2*p2);
+}
+//
+// Computation of energy loss according to Bethe-Bloch
+//
+void
+EnergyLossUpdator::computeBetheBloch (const LocalVector& localP,
+				      const MediumProperties& materialConstants, Effect & effect) const {
+  //
+  // calculate absolute momentum and correction to path length from angle 
+  // of incidence
+  //
+
+  typedef float Float;
+
+  Float p2 = localP.mag2();
+  Float xf = std::abs(std::sqrt(p2)/localP.z());
+  Float xi = materialConstants.xi()*xf;
+
+  Float loss, variance;
+  if (!(theTables && theTables->betheBloch(p2, loss, variance)))
+    betheBloch(p2, mass()*mass(), loss, variance);
+
+  Float dP    = xi*loss;
+  Float sigp2 = xi*variance;
   effect.deltaP += -dP;
   using namespace materialEffect;
   effect.deltaCov[elos] += sigp2;
@@ -96,6 +111,17 @@ EnergyLossUpdator::computeBetheBloch (const LocalVector& localP,
 
 }
 //
+// Bethe-Heitler: fraction of the momentum kept by an electron
+//
+void
+EnergyLossUpdator::betheHeitler (float t, float & z, float & varz) {
+  const float l3ol2 = std::log(3.)/std::log(2.);
+  z = unsafe_expf<3>(-t);
+  varz = unsafe_expf<3>(-t*l3ol2)- 
+         z*z;
+  	 // exp(-2*t);
+}
+//
 // Computation of energy loss for electrons
 //
 void 
@@ -113,11 +139,9 @@ EnergyLossUpdator::computeElectrons (const LocalVector& localP,
   // Energy loss and variance according to Bethe and Heitler, see also
   // Comp. Phys. Comm. 79 (1994) 157. 
   //
-  const float l3ol2 = std::log(3.)/std::log(2.);
-  float z = unsafe_expf<3>(-normalisedPath);
-  float varz = unsafe_expf<3>(-normalisedPath*l3ol2)- 
-                z*z;
-  		// exp(-2*normalisedPath);
+  float z, varz;
+  if (!(theTables && theTables->betheHeitler(normalisedPath, z, varz)))
+    betheHeitler(normalisedPath, z, varz);
 
   if ( propDir==oppositeToMomentum ) {
     //
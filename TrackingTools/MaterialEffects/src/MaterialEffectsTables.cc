@@ -0,0 +1,33 @@
+#include "TrackingTools/MaterialEffects/interface/MaterialEffectsTables.h"
+#include "TrackingTools/MaterialEffects/interface/MultipleScatteringUpdator.h"
+#include "TrackingTools/MaterialEffects/interface/EnergyLossUpdator.h"
+
+//
+// The tables are filled with the formulas of the updators, so that the lookup
+// differs from them only by the linear interpolation within a bin
+// (relative bin width 1/128): the ranges cover thicknesses from 1e-6 to 16
+// radiation lengths and momenta from 10 MeV to 10 TeV.
+//
+template<typename F>
+MaterialEffectsTables::LogBinnedTable::LogBinnedTable(F f, float xMin, float xMax) :
+  theFirst(bits(xMin) >> shift), theLast(bits(xMax) >> shift)
+{
+  theValues.reserve(theLast - theFirst + 1);
+  for (unsigned int u = theFirst; u <= theLast; ++u) theValues.push_back(f(value(u << shift)));
+}
+
+MaterialEffectsTables::MaterialEffectsTables(float mass) :
+  theMultipleScattering([](float t) { return MultipleScatteringUpdator::thicknessFactor(t); }, 1.e-6f, 16.f),
+  theBetheBlochLoss([mass](float p2) {
+      float loss, variance; EnergyLossUpdator::betheBloch(p2, mass*mass, loss, variance); return loss;
+    }, 1.e-4f, 1.e8f),
+  theBetheBlochVariance([mass](float p2) {
+      float loss, variance; EnergyLossUpdator::betheBloch(p2, mass*mass, loss, variance); return variance*p2*p2;
+    }, 1.e-4f, 1.e8f),
+  theBetheHeitlerZ([](float t) {
+      float z, varz; EnergyLossUpdator::betheHeitler(t, z, varz); return z;
+    }, 1.e-6f, 16.f),
+  theBetheHeitlerVariance([](float t) {
+      float z, varz; EnergyLossUpdator::betheHeitler(t, z, varz); return varz;
+    }, 1.e-6f, 16.f)
+{}
@@ -1,4 +1,5 @@
 #include "TrackingTools/MaterialEffects/interface/MultipleScatteringUpdator.h"
+#include "TrackingTools/MaterialEffects/interface/MaterialEffectsTables.h"
 #include "DataFormats/GeometrySurface/interface/MediumProperties.h"
 
 #include "DataFormats/Math/interface/approx_log.h"
@@ -8,6 +9,11 @@ void oldMUcompute (const TrajectoryStateOnSurface& TSoS,
 
 //#define DBG_MSU
 
+float MultipleScatteringUpdator::thicknessFactor(float radLen) {
+  float fact = 1.f + 0.038f*unsafe_logf<2>(radLen); fact *=fact;
+  return radLen*fact;
+}
+
 //
 // Computation of contribution of multiple scatterning to covariance matrix 
 //   of local parameters based on Highland formula for sigma(alpha) in plane.
@@ -41,9 +47,10 @@ void MultipleScatteringUpdator::compute (const TrajectoryStateOnSurface& TSoS,
   float sigt2 = 0.;                  // sigma(alpha)**2
 
   // Calculated rms scattering angle squared.
-  float fact = 1.f + 0.038f*unsafe_logf<2>(radLen); fact *=fact;
-  float a = fact/(beta2*p2);
-  sigt2 = amscon*radLen*a;
+  float fact;
+  if (!(theTables && theTables->multipleScattering(radLen, fact))) fact = thicknessFactor(radLen);
+  float a = 1.f/(beta2*p2);
+  sigt2 = amscon*fact*a;
   
   if (thePtMin > 0) {
 #ifdef DBG_MSU
@@ -65,8 +72,8 @@ void MultipleScatteringUpdator::compute (const TrajectoryStateOnSurface& TSoS,
     float pMin2 = thePtMin*thePtMin*(p2/TSoS.globalMomentum().perp2());       
     // Use P constraint to calculate rms maximum scattering angle.
     float betaMin2 = pMin2/(pMin2 + m2);
-    float a_max = fact/(betaMin2 * pMin2);
-    float sigt2_max = amscon*radLen*a_max;
+    float a_max = 1.f/(betaMin2 * pMin2);
+    float sigt2_max = amscon*fact*a_max;
     if (sigt2 > sigt2_max) sigt2 = sigt2_max;
 #ifdef DBG_MSU
     std::cout<<" after P constraint ("<<pMin<<") = "<<sqrt(sigt2);
@@ -15,14 +15,15 @@ PropagatorWithMaterial::PropagatorWithMaterial (PropagationDirection dir,
 						const MagneticField * mf,
 						const float maxDPhi,
 						bool useRungeKutta,
-                                                float ptMin,bool useOldAnalPropLogic) :
+                                                float ptMin,bool useOldAnalPropLogic,
+						bool useMaterialTables) :
   Propagator(dir),
   rkProduct(mf,dir),
   theGeometricalPropagator(useRungeKutta ?
 			   rkProduct.propagator.clone() :
 			   new AnalyticalPropagator(mf,dir,maxDPhi,useOldAnalPropLogic)
 			   ),
-  theMEUpdator(new CombinedMaterialEffectsUpdator(mass, ptMin)),
+  theMEUpdator(new CombinedMaterialEffectsUpdator(mass, ptMin, useMaterialTables)),
   theMaterialLocation(atDestination), field(mf),useRungeKutta_(useRungeKutta) {
 
 
@@ -16,6 +16,7 @@ class TrajectoryMeasurementGroup;
 class MeasurementTrackerEvent;
 class DetLayer;
 class DetGroup;
+class CompatibleDetsCache;
 
 
 class LayerMeasurements {
@@ -25,11 +26,13 @@ using SimpleHitContainer=std::vector<BaseTrackerRecHit *>;
 
 
 // dummy default constructor (obviously you can't use any object created this way), but it can be needed in some cases
-LayerMeasurements() : theDetSystem(0), theData(0) {}
+LayerMeasurements() : theDetSystem(0), theData(0), theDetsCache(0) {}
   
-  // the constructor that most of the people should be using
-  LayerMeasurements( const MeasurementDetSystem& detSystem, const MeasurementTrackerEvent &data) :
-    theDetSystem(&detSystem), theData(&data) {}
+  // the constructor that most of the people should be using;
+  // if given, the compatible dets of the layers are taken from the cache
+  LayerMeasurements( const MeasurementDetSystem& detSystem, const MeasurementTrackerEvent &data,
+		     CompatibleDetsCache * detsCache = 0) :
+    theDetSystem(&detSystem), theData(&data), theDetsCache(detsCache) {}
     
     // return just valid hits, no sorting (for seeding mostly)
     bool recHits(SimpleHitContainer & result,
@@ -64,6 +67,7 @@ private:
 
   const MeasurementDetSystem* theDetSystem;
   const MeasurementTrackerEvent* theData;
+  CompatibleDetsCache* theDetsCache;
 
 };
 
@@ -11,6 +11,7 @@
 #include "TrackingTools/DetLayers/interface/GeometricSearchDet.h"
 #include "TrackingTools/DetLayers/interface/DetLayer.h"
 #include "TrackingTools/DetLayers/interface/DetGroup.h"
+#include "TrackingTools/DetLayers/interface/CompatibleDetsCache.h"
 
 #include "TrackingTools/TransientTrackingRecHit/interface/InvalidTransientRecHit.h"
 
@@ -95,7 +96,8 @@ bool LayerMeasurements::recHits(SimpleHitContainer & result,
 			     const Propagator& prop, 
 			     const MeasurementEstimator& est) const {
 
-  auto  const & compatDets = layer.compatibleDets( startingState, prop, est);  
+  auto  const & compatDets = theDetsCache ? theDetsCache->compatibleDets( layer, startingState, prop, est)
+                                          : layer.compatibleDets( startingState, prop, est);
   if (compatDets.empty()) return false;
   bool ret=false;
   for ( auto const & ds : compatDets) {
@@ -114,7 +116,8 @@ LayerMeasurements::measurements( const DetLayer& layer,
 
   typedef DetLayer::DetWithState   DetWithState;
 
-  vector<DetWithState>  const & compatDets = layer.compatibleDets( startingState, prop, est);
+  vector<DetWithState>  const & compatDets = theDetsCache ? theDetsCache->compatibleDets( layer, startingState, prop, est)
+                                                            : layer.compatibleDets( startingState, prop, est);
   
   if (!compatDets.empty())  return get(theDetSystem, theData, layer, compatDets, startingState, prop, est);
     
@@ -141,7 +144,8 @@ LayerMeasurements::groupedMeasurements( const DetLayer& layer,
 					const MeasurementEstimator& est) const {
   vector<TrajectoryMeasurementGroup> result;
   
-  vector<DetGroup> && groups = layer.groupedCompatibleDets( startingState, prop, est);
+  vector<DetGroup> && groups = theDetsCache ? theDetsCache->groupedCompatibleDets( layer, startingState, prop, est)
+                                            : layer.groupedCompatibleDets( startingState, prop, est);
   result.reserve(groups.size());
 
   tracking::TempMeasurements tmps;
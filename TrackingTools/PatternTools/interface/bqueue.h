@@ -2,6 +2,7 @@
 #define CMSUTILS_BEUEUE_H
 #include <boost/intrusive_ptr.hpp>
 #include<cassert>
+#include<new>
 
 /**  Backwards linked queue with "head sharing"
 
@@ -31,6 +32,11 @@
     to support c++11 begin,end and operator++ has been added with the same semantics of rbegin,rend and operator--
     Highly confusing, still the bqueue is a sort of reversed slist: provided the user knows should work....
 
+    The items are allocated from a per-thread pool, which keeps the memory of the items deleted
+    (up to _bqueue_pool::maxSize of them) for the next ones: during the trajectory building the
+    candidates are forked, grown and dropped continuously, and their measurements no longer go
+    through malloc and free each time.
+
 
 */
 namespace cmsutils {
@@ -40,6 +46,59 @@ namespace cmsutils {
   template<class T> class _bqueue_item;
   template<class T> void intrusive_ptr_add_ref(_bqueue_item<T> *it) ;
   template<class T> void intrusive_ptr_release(_bqueue_item<T> *it) ;
+
+  // free list of the memory of the deleted items, by thread.
+  // An item deleted by another thread than the one which created it just goes in the list of that thread.
+  template<class T>
+  class _bqueue_pool {
+  public:
+    static constexpr unsigned int maxSize = 1<<14;
+
+    static void * get() {
+      List & l = local();
+      if (l.head==nullptr) return ::operator new(sizeof(_bqueue_item<T>));
+      Node * n = l.head; l.head = n->next; --l.size;
+      return n;
+    }
+
+    static void put(void * p) {
+      List & l = local();
+      if (l.size>=maxSize) { ::operator delete(p); return; }
+      Node * n = static_cast<Node*>(p); n->next = l.head; l.head = n; ++l.size;
+    }
+
+  private:
+    struct Node { Node * next; };
+    // trivially destructible, so that it can still be used by the items deleted by other
+    // thread_local objects at the exit of the thread, after the Cleaner has run
+    struct List {
+      Node * head;
+      unsigned int size;
+      bool registered;
+    };
+    // gives the memory back to the system at the exit of the thread; the items deleted
+    // afterwards find the list full and are given back to the system as well
+    struct Cleaner {
+      ~Cleaner() {
+	List & l = list();
+	while (l.head) { Node * n = l.head; l.head = n->next; ::operator delete(n); }
+	l.size = maxSize;
+      }
+    };
+    static List & list() {
+      static thread_local List l = {nullptr, 0, false};
+      return l;
+    }
+    static List & local() {
+      List & l = list();
+      if (!l.registered) {
+	l.registered = true;
+	static thread_local Cleaner cleaner;
+	(void)cleaner;
+      }
+      return l;
+    }
+  };
   
   template <class T> 
   class _bqueue_item  {
@@ -49,6 +108,8 @@ namespace cmsutils {
     friend void intrusive_ptr_release<T>(_bqueue_item<T> *it);
     void addRef() { ++refCount; }
     void delRef() { if ((--refCount) == 0) delete this; }
+    static void * operator new(std::size_t) { return _bqueue_pool<T>::get(); }
+    static void operator delete(void * p) { _bqueue_pool<T>::put(p); }
   private:
     _bqueue_item() : back(0), value(), refCount(0) { }
     _bqueue_item(boost::intrusive_ptr< _bqueue_item<T> > tail, const T &val) : back(tail), value(val), refCount(0) { }
@@ -1,6 +1,7 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <thread>
 #include "TrackingTools/PatternTools/interface/bqueue.h"
 #include<iostream>
 #include<cassert>
@@ -90,6 +91,23 @@ int main() {
   verifySeq(cont);
   assert(cont.begin()==cont.end());
 
+  // the memory of the items deleted is used again
+  cont.emplace_back(new int(0));
+  auto first = &cont.back();
+  cont.clear();
+  cont.emplace_back(new int(0));
+  assert(&cont.back()==first);
+  verifySeq(cont);
+  cont.clear();
+
+  // items deleted at the exit of a thread, after the pool of the thread is gone
+  std::thread([]() {
+    static thread_local Cont late;
+    late.emplace_back(new int(0));
+    late.emplace_back(new int(1));
+    verifySeq(late);
+  }).join();
+
   return cont.size();
 
 }
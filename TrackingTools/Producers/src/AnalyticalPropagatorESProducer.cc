@@ -45,7 +45,12 @@ AnalyticalPropagatorESProducer::produce(const TrackingComponentsRecord & iRecord
   if (pdir == "alongMomentum") dir = alongMomentum;
   if (pdir == "anyDirection") dir = anyDirection;
   
-  _propagator  = boost::shared_ptr<Propagator>(new AnalyticalPropagator(&(*magfield), dir,dphiCut));
+  AnalyticalPropagator * propagator = new AnalyticalPropagator(&(*magfield), dir,dphiCut);
+  // optional region where the field is taken as uniform, e.g. the tracker barrel
+  if (pset_.existsAs<double>("UniformFieldRadius") && pset_.existsAs<double>("UniformFieldHalfLength"))
+    propagator->setUniformFieldRegion(pset_.getParameter<double>("UniformFieldRadius"),
+				      pset_.getParameter<double>("UniformFieldHalfLength"));
+  _propagator  = boost::shared_ptr<Propagator>(propagator);
   return _propagator;
 }
 
@@ -81,6 +81,23 @@ class DetIdAssociator{
 						  const double dThetaMinus,
 						  const double dPhiPlus,
 						  const double dPhiMinus) const;
+   /// Same as getDetIdsCloseToAPoint, the DetIds are sorted, without
+   /// duplicates, in a vector: "ids" is cleared first, so it can be reused
+   void fillDetIdsCloseToAPoint(const GlobalPoint& direction,
+				const unsigned int iNEtaPlus,
+				const unsigned int iNEtaMinus,
+				const unsigned int iNPhiPlus,
+				const unsigned int iNPhiMinus,
+				std::vector<DetId>& ids) const;
+   void fillDetIdsCloseToAPoint(const GlobalPoint& point,
+				const double dThetaPlus,
+				const double dThetaMinus,
+				const double dPhiPlus,
+				const double dPhiMinus,
+				std::vector<DetId>& ids) const;
+   void fillDetIdsCloseToAPoint(const GlobalPoint& direction,
+				const MapRange& mapRange,
+				std::vector<DetId>& ids) const;
    /// Find DetIds that satisfy given requirements
    /// - inside eta-phi cone of radius dR
    virtual std::set<DetId> getDetIdsInACone(const std::set<DetId>&,
@@ -144,6 +161,8 @@ class DetIdAssociator{
      return iEta*nPhi_+iPhi;
    }
    void fillSet( std::set<DetId>& set, unsigned int iEta, unsigned int iPhi) const;
+   /// append the DetIds of a bin, unsorted
+   void fillVector( std::vector<DetId>& ids, unsigned int iEta, unsigned int iPhi) const;
 
    // map parameters
    const int nPhi_;
@@ -161,6 +161,13 @@ class TrackDetectorAssociator {
 			      const AssociatorParameters& parameters) dso_internal;
   
    void           init( const edm::EventSetup&) dso_internal;
+
+   /// propagate the track through the detector into cachedTrajectory_,
+   /// unless it holds the propagation of the same track in the event
+   bool propagate( const edm::Event&,
+		   const AssociatorParameters&,
+		   const FreeTrajectoryState* innerState,
+		   const FreeTrajectoryState* outerState ) dso_internal;
    
    math::XYZPoint getPoint( const GlobalPoint& point)  dso_internal
      {
@@ -198,5 +205,13 @@ class TrackDetectorAssociator {
    edm::ESHandle<GlobalTrackingGeometry> theTrackingGeometry_;
    
    edm::ESWatcher<IdealMagneticFieldRecord>     theMagneticFeildWatcher_;
+
+   // the track and settings of the propagation in cachedTrajectory_
+   bool propagated_, propagationOK_;
+   edm::EventID propagatedEvent_;
+   FreeTrajectoryState propagatedInnerState_, propagatedOuterState_;
+   bool propagatedWithOuterState_, propagatedWithMuon_;
+   float propagatedStep_;
+   const Propagator* propagatedPropagator_;
 };
 #endif
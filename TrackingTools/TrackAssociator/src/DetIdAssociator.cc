@@ -20,6 +20,7 @@
 #include "TrackingTools/TrackAssociator/interface/DetIdAssociator.h"
 #include "DetIdInfo.h"
 #include "FWCore/Utilities/interface/isFinite.h"
+#include <algorithm>
 #include <map>
 
 DetIdAssociator::DetIdAssociator(const int nPhi, const int nEta, const double etaBinSize)
@@ -46,7 +47,20 @@ std::set<DetId> DetIdAssociator::getDetIdsCloseToAPoint(const GlobalPoint& direc
 							const unsigned int iNPhiPlus,
 							const unsigned int iNPhiMinus) const
 {
-   std::set<DetId> set;
+   std::vector<DetId> ids;
+   fillDetIdsCloseToAPoint(direction, iNEtaPlus, iNEtaMinus, iNPhiPlus, iNPhiMinus, ids);
+   // sorted: the set is filled in linear time
+   return std::set<DetId>(ids.begin(), ids.end());
+}
+
+void DetIdAssociator::fillDetIdsCloseToAPoint(const GlobalPoint& direction,
+					      const unsigned int iNEtaPlus,
+					      const unsigned int iNEtaMinus,
+					      const unsigned int iNPhiPlus,
+					      const unsigned int iNPhiMinus,
+					      std::vector<DetId>& ids) const
+{
+   ids.clear();
    check_setup();
    if (! theMapIsValid_ ) throw cms::Exception("FatalError") << "map is not valid.";
    LogTrace("TrackAssociator") << "(iNEtaPlus, iNEtaMinus, iNPhiPlus, iNPhiMinus): " <<
@@ -56,7 +70,7 @@ std::set<DetId> DetIdAssociator::getDetIdsCloseToAPoint(const GlobalPoint& direc
    int iphi = iPhi(direction);
    LogTrace("TrackAssociator") << "(ieta,iphi): " << ieta << "," << iphi << "\n";
    if (ieta>=0 && ieta<nEta_ && iphi>=0 && iphi<nPhi_){
-      fillSet(set,ieta,iphi);
+      fillVector(ids,ieta,iphi);
       // dumpMapContent(ieta,iphi);
       // check if any neighbor bin is requested
       if (iNEtaPlus + iNEtaMinus + iNPhiPlus + iNPhiMinus >0 ){
@@ -82,13 +96,14 @@ std::set<DetId> DetIdAssociator::getDetIdsCloseToAPoint(const GlobalPoint& direc
 	 // dumpMapContent(minIEta,maxIEta,minIPhi,maxIPhi);
 	 for (int i=minIEta;i<=maxIEta;i++)
 	   for (int j=minIPhi;j<=maxIPhi;j++) {
-	      if( i==ieta && j==iphi) continue; // already in the set
-	      fillSet(set,i,j%nPhi_);
+	      if( i==ieta && j==iphi) continue; // already in the list
+	      fillVector(ids,i,j%nPhi_);
 	   }
       }
-      
+      // large elements are in several bins
+      std::sort(ids.begin(), ids.end());
+      ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
    }
-   return set;
 }
 
 std::set<DetId> DetIdAssociator::getDetIdsCloseToAPoint(const GlobalPoint& point,
@@ -102,18 +117,33 @@ std::set<DetId> DetIdAssociator::getDetIdsCloseToAPoint(const GlobalPoint& point
 							const double dThetaMinus,
 							const double dPhiPlus,
 							const double dPhiMinus) const
+{
+   std::vector<DetId> ids;
+   fillDetIdsCloseToAPoint(point, dThetaPlus, dThetaMinus, dPhiPlus, dPhiMinus, ids);
+   return std::set<DetId>(ids.begin(), ids.end());
+}
+
+void DetIdAssociator::fillDetIdsCloseToAPoint(const GlobalPoint& point,
+					      const double dThetaPlus,
+					      const double dThetaMinus,
+					      const double dPhiPlus,
+					      const double dPhiMinus,
+					      std::vector<DetId>& ids) const
 {
    LogTrace("TrackAssociator") << "(dThetaPlus,dThetaMinus,dPhiPlus,dPhiMinus): " <<
      dThetaPlus << ", " << dThetaMinus << ", " << dPhiPlus << ", " << dPhiMinus;
    unsigned int n = 0;
    if ( dThetaPlus<0 || dThetaMinus<0 || dPhiPlus<0 || dPhiMinus<0) 
-     return getDetIdsCloseToAPoint(point,n,n,n,n);
+     return fillDetIdsCloseToAPoint(point,n,n,n,n,ids);
    // check that region of interest overlaps with the look-up map
    double maxTheta = point.theta()+dThetaPlus;
    if (maxTheta > M_PI-minTheta_) maxTheta =  M_PI-minTheta_;
    double minTheta = point.theta()-dThetaMinus;
    if (minTheta < minTheta_) minTheta = minTheta_;
-   if ( maxTheta < minTheta_ || minTheta > M_PI-minTheta_) return std::set<DetId>();
+   if ( maxTheta < minTheta_ || minTheta > M_PI-minTheta_) {
+      ids.clear();
+      return;
+   }
    
    // take into account non-linear dependence of eta from
    // theta in regions with large |eta|
@@ -124,7 +154,7 @@ std::set<DetId> DetIdAssociator::getDetIdsCloseToAPoint(const GlobalPoint& point
    unsigned int iNPhiPlus = abs(int( dPhiPlus/(2*M_PI)*nPhi_ ));
    unsigned int iNPhiMinus  = abs(int( dPhiMinus/(2*M_PI)*nPhi_ ));
    // add one more bin in each direction to guaranty that we don't miss anything
-   return getDetIdsCloseToAPoint(point, iNEtaPlus+1, iNEtaMinus+1, iNPhiPlus+1, iNPhiMinus+1);
+   fillDetIdsCloseToAPoint(point, iNEtaPlus+1, iNEtaMinus+1, iNPhiPlus+1, iNPhiMinus+1, ids);
 }
 
 
@@ -259,6 +289,10 @@ void DetIdAssociator::buildMap()
    }
    if ( totalNumberOfElementsInTheContainer != 0 )
      throw cms::Exception("FatalError") << "Look-up map filled incorrectly. Structural problem. Get in touch with the developer.";
+   // the filling leaves the range index one element before the first element of the range
+   for ( std::vector<std::pair<unsigned int,unsigned int> >::iterator bin = lookupMap_.begin();
+	 bin != lookupMap_.end(); ++bin )
+     if (bin->second!=0) ++bin->first;
    volume_.determinInnerDimensions();
    edm::LogVerbatim("TrackAssociator") << "Fiducial volume for " << name() << " (minR, maxR, minZ, maxZ): " << 
      volume_.minR() << ", " << volume_.maxR() << ", " << volume_.minZ() << ", " << volume_.maxZ();
@@ -275,7 +309,7 @@ std::set<DetId> DetIdAssociator::getDetIdsInACone(const std::set<DetId>& inset,
    for(std::set<DetId>::const_iterator id_iter = inset.begin(); id_iter != inset.end(); id_iter++)
      for(std::vector<GlobalPoint>::const_iterator point_iter = trajectory.begin(); point_iter != trajectory.end(); point_iter++)
        if (nearElement(*point_iter,*id_iter,dR)) {
-	  outset.insert(*id_iter);
+	  outset.insert(outset.end(),*id_iter);
 	  break;
        }
    return outset;
@@ -286,16 +320,17 @@ std::vector<DetId> DetIdAssociator::getCrossedDetIds(const std::set<DetId>& inse
 {
    check_setup();
    std::vector<DetId> output;
-   std::set<DetId> ids(inset);
+   // the ids not crossed yet, kept in order
+   std::vector<DetId> ids(inset.begin(), inset.end());
    for ( unsigned int i=0; i+1 < trajectory.size(); ++i ) {
-      std::set<DetId>::const_iterator id_iter = ids.begin();
-      while ( id_iter != ids.end() ) {
-	 if ( crossedElement(trajectory[i],trajectory[i+1],*id_iter) ){
-	    output.push_back(*id_iter);
-	    ids.erase(id_iter++);
-	 }else
-	   id_iter++;
+      std::vector<DetId>::iterator last = ids.begin();
+      for ( std::vector<DetId>::iterator id_iter = ids.begin(); id_iter != ids.end(); ++id_iter ) {
+	 if ( crossedElement(trajectory[i],trajectory[i+1],*id_iter) )
+	   output.push_back(*id_iter);
+	 else
+	   *last++ = *id_iter;
       }
+      ids.erase(last, ids.end());
    }
    return output;
 }
@@ -306,16 +341,17 @@ std::vector<DetId> DetIdAssociator::getCrossedDetIds(const std::set<DetId>& inse
 {
    check_setup();
    std::vector<DetId> output;
-   std::set<DetId> ids(inset);
+   // the ids not crossed yet, kept in order
+   std::vector<DetId> ids(inset.begin(), inset.end());
    for ( unsigned int i=0; i+1 < trajectory.size(); ++i ) {
-      std::set<DetId>::const_iterator id_iter = ids.begin();
-      while ( id_iter != ids.end() ) {
-	 if ( crossedElement(trajectory[i].position(),trajectory[i+1].position(),*id_iter,tolerance,&trajectory[i]) ){
-	    output.push_back(*id_iter);
-	    ids.erase(id_iter++);
-	 }else
-	   id_iter++;
+      std::vector<DetId>::iterator last = ids.begin();
+      for ( std::vector<DetId>::iterator id_iter = ids.begin(); id_iter != ids.end(); ++id_iter ) {
+	 if ( crossedElement(trajectory[i].position(),trajectory[i+1].position(),*id_iter,tolerance,&trajectory[i]) )
+	   output.push_back(*id_iter);
+	 else
+	   *last++ = *id_iter;
       }
+      ids.erase(last, ids.end());
    }
    return output;
 }
@@ -364,6 +400,14 @@ std::set<DetId> DetIdAssociator::getDetIdsCloseToAPoint(const GlobalPoint& direc
 
 }
 
+void DetIdAssociator::fillDetIdsCloseToAPoint(const GlobalPoint& direction,
+					      const MapRange& mapRange,
+					      std::vector<DetId>& ids) const
+{
+   fillDetIdsCloseToAPoint(direction, mapRange.dThetaPlus, mapRange.dThetaMinus,
+			   mapRange.dPhiPlus, mapRange.dPhiMinus, ids);
+}
+
 bool DetIdAssociator::nearElement(const GlobalPoint& point, 
 				  const DetId& id, 
 				  const double distance) const 
@@ -391,6 +435,14 @@ void DetIdAssociator::fillSet( std::set<DetId>& set, unsigned int iEta, unsigned
     set.insert(container_.at(i));
 }
 
+void DetIdAssociator::fillVector( std::vector<DetId>& ids, unsigned int iEta, unsigned int iPhi) const
+{
+  const std::pair<unsigned int,unsigned int>& bin = lookupMap_.at(index(iEta,iPhi));
+  if ( bin.second == 0 ) return;
+  std::vector<DetId>::const_iterator first = container_.begin()+bin.first;
+  ids.insert(ids.end(), first, first+bin.second);
+}
+
 #include "FWCore/PluginManager/interface/ModuleDef.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 
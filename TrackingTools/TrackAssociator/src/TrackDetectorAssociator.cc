@@ -101,6 +101,8 @@ TrackDetectorAssociator::TrackDetectorAssociator()
    ivProp_ = 0;
    defProp_ = 0;
    useDefaultPropagator_ = false;
+   propagated_ = false;
+   propagationOK_ = false;
 }
 
 TrackDetectorAssociator::~TrackDetectorAssociator()
@@ -189,6 +191,71 @@ TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
    
    info.setCaloGeometry(theCaloGeometry_);
    
+   if ( ! propagate( iEvent, parameters, innerState, outerState ) ) return info;
+
+   info.trkGlobPosAtEcal = getPoint( cachedTrajectory_.getStateAtEcal().position() );
+   info.trkGlobPosAtHcal = getPoint( cachedTrajectory_.getStateAtHcal().position() );
+   info.trkGlobPosAtHO  = getPoint( cachedTrajectory_.getStateAtHO().position() );
+   
+   info.trkMomAtEcal = cachedTrajectory_.getStateAtEcal().momentum();
+   info.trkMomAtHcal = cachedTrajectory_.getStateAtHcal().momentum();
+   info.trkMomAtHO   = cachedTrajectory_.getStateAtHO().momentum();
+   
+   if (parameters.useEcal) fillEcal( iEvent, info, parameters);
+   if (parameters.useCalo) fillCaloTowers( iEvent, info, parameters);
+   if (parameters.useHcal) fillHcal( iEvent, info, parameters);
+   if (parameters.useHO)   fillHO( iEvent, info, parameters);
+   if (parameters.usePreshower) fillPreshower( iEvent, info, parameters);
+   if (parameters.useMuon) fillMuon( iEvent, info, parameters);
+   if (parameters.truthMatch) fillCaloTruth( iEvent, info, parameters);
+   
+   return info;
+}
+
+namespace {
+   bool sameState( const FreeTrajectoryState& a, const FreeTrajectoryState& b )
+   {
+      if ( a.position().x() != b.position().x() || a.position().y() != b.position().y() ||
+	   a.position().z() != b.position().z() || a.momentum().x() != b.momentum().x() ||
+	   a.momentum().y() != b.momentum().y() || a.momentum().z() != b.momentum().z() ||
+	   a.charge() != b.charge() || a.hasError() != b.hasError() ) return false;
+      if ( ! a.hasError() ) return true;
+      const AlgebraicSymMatrix55& ea = a.curvilinearError().matrix();
+      const AlgebraicSymMatrix55& eb = b.curvilinearError().matrix();
+      for ( unsigned int i = 0; i < 5; ++i )
+	for ( unsigned int j = 0; j <= i; ++j )
+	  if ( ea(i,j) != eb(i,j) ) return false;
+      return true;
+   }
+}
+
+bool TrackDetectorAssociator::propagate( const edm::Event& iEvent,
+					 const AssociatorParameters& parameters,
+					 const FreeTrajectoryState* innerState,
+					 const FreeTrajectoryState* outerState )
+{
+   // the clients often associate the same track again, e.g. with other
+   // parameters: the propagation depends only on the states, on the
+   // propagator and on whether the muon system is used
+   if ( propagated_ && propagatedEvent_ == iEvent.id() &&
+	propagatedPropagator_ == ivProp_ &&
+	propagatedStep_ == cachedTrajectory_.getPropagationStep() &&
+	propagatedWithMuon_ == parameters.useMuon &&
+	propagatedWithOuterState_ == ( outerState != 0 ) &&
+	sameState( propagatedInnerState_, *innerState ) &&
+	( ! outerState || sameState( propagatedOuterState_, *outerState ) ) )
+     return propagationOK_;
+
+   propagated_ = true;
+   propagatedEvent_ = iEvent.id();
+   propagatedPropagator_ = ivProp_;
+   propagatedStep_ = cachedTrajectory_.getPropagationStep();
+   propagatedWithMuon_ = parameters.useMuon;
+   propagatedWithOuterState_ = ( outerState != 0 );
+   propagatedInnerState_ = *innerState;
+   if ( outerState ) propagatedOuterState_ = *outerState;
+
+   SteppingHelixStateInfo trackOrigin(*innerState);
    cachedTrajectory_.reset_trajectory();
    // estimate propagation outer boundaries based on 
    // requested sub-detector information. For now limit
@@ -233,31 +300,15 @@ TrackDetMatchInfo TrackDetectorAssociator::associate( const edm::Event& iEvent,
      }
    }
 
-   if ( ! cachedTrajectory_.propagateAll(trackOrigin) ) return info;
+   propagationOK_ = cachedTrajectory_.propagateAll(trackOrigin);
+   if ( ! propagationOK_ ) return false;
    
    // get trajectory in calorimeters
    cachedTrajectory_.findEcalTrajectory( ecalDetIdAssociator_->volume() );
    cachedTrajectory_.findHcalTrajectory( hcalDetIdAssociator_->volume() );
    cachedTrajectory_.findHOTrajectory( hoDetIdAssociator_->volume() );
    cachedTrajectory_.findPreshowerTrajectory( preshowerDetIdAssociator_->volume() );
-
-   info.trkGlobPosAtEcal = getPoint( cachedTrajectory_.getStateAtEcal().position() );
-   info.trkGlobPosAtHcal = getPoint( cachedTrajectory_.getStateAtHcal().position() );
-   info.trkGlobPosAtHO  = getPoint( cachedTrajectory_.getStateAtHO().position() );
-   
-   info.trkMomAtEcal = cachedTrajectory_.getStateAtEcal().momentum();
-   info.trkMomAtHcal = cachedTrajectory_.getStateAtHcal().momentum();
-   info.trkMomAtHO   = cachedTrajectory_.getStateAtHO().momentum();
-   
-   if (parameters.useEcal) fillEcal( iEvent, info, parameters);
-   if (parameters.useCalo) fillCaloTowers( iEvent, info, parameters);
-   if (parameters.useHcal) fillHcal( iEvent, info, parameters);
-   if (parameters.useHO)   fillHO( iEvent, info, parameters);
-   if (parameters.usePreshower) fillPreshower( iEvent, info, parameters);
-   if (parameters.useMuon) fillMuon( iEvent, info, parameters);
-   if (parameters.truthMatch) fillCaloTruth( iEvent, info, parameters);
-   
-   return info;
+   return true;
 }
 
 void TrackDetectorAssociator::fillEcal( const edm::Event& iEvent,
@@ -641,10 +692,10 @@ void TrackDetectorAssociator::getTAMuonChamberMatches(std::vector<TAMuonChamberM
      
    // and find chamber DetIds
 
-   std::set<DetId> muonIdsInRegion = 
-     muonDetIdAssociator_->getDetIdsCloseToAPoint(trajectoryPoint.position(), mapRange);
+   std::vector<DetId> muonIdsInRegion;
+   muonDetIdAssociator_->fillDetIdsCloseToAPoint(trajectoryPoint.position(), mapRange, muonIdsInRegion);
    LogTrace("TrackAssociator") << "Number of chambers to check: " << muonIdsInRegion.size();
-   for(std::set<DetId>::const_iterator detId = muonIdsInRegion.begin(); detId != muonIdsInRegion.end(); detId++)
+   for(std::vector<DetId>::const_iterator detId = muonIdsInRegion.begin(); detId != muonIdsInRegion.end(); detId++)
    {
       const GeomDet* geomDet = muonDetIdAssociator_->getGeomDet(*detId);
       TrajectoryStateOnSurface stateOnSurface = cachedTrajectory_.propagate( &geomDet->surface() );
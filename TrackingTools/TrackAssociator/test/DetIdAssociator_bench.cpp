@@ -0,0 +1,129 @@
+// Benchmark of the preselection queries of DetIdAssociator: the std::set
+// results of getDetIdsCloseToAPoint against the sorted vector filled by
+// fillDetIdsCloseToAPoint, on a toy detector made of calorimeter towers and
+// of large chambers covering several bins of the look-up map.
+// Both must give the same DetIds; the number of queries per second is printed.
+//
+//   DetIdAssociator_bench [number of queries]
+
+#include "TrackingTools/TrackAssociator/interface/DetIdAssociator.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+  // rectangles in eta-phi on a cylinder, each described by its four corners
+  class ToyDetIdAssociator final : public DetIdAssociator {
+  public:
+    struct Element {
+      double eta, phi, dEta, dPhi;
+    };
+
+    ToyDetIdAssociator(int nPhi, int nEta, double etaBinSize, const std::vector<Element>& elements)
+      : DetIdAssociator(nPhi, nEta, etaBinSize), elements_(elements) {}
+
+    void setGeometry(const DetIdAssociatorRecord&) override {}
+    const GeomDet* getGeomDet(const DetId&) const override { return 0; }
+    const char* name() const override { return "Toy"; }
+
+    DetId detId(unsigned int i) const { return DetId(DetId::Hcal, 1).rawId() + i; }
+    unsigned int element(const DetId& id) const { return id.rawId() - DetId(DetId::Hcal, 1).rawId(); }
+
+  protected:
+    GlobalPoint getPosition(const DetId& id) const override {
+      const Element& e = elements_[element(id)];
+      return point(e.eta, e.phi);
+    }
+    void getValidDetIds(unsigned int, std::vector<DetId>& ids) const override {
+      ids.clear();
+      for (unsigned int i = 0; i != elements_.size(); ++i) ids.push_back(detId(i));
+    }
+    std::pair<const_iterator, const_iterator> getDetIdPoints(const DetId& id, std::vector<GlobalPoint>& points) const override {
+      const Element& e = elements_[element(id)];
+      points.clear();
+      for (int i = -1; i <= 1; i += 2)
+	for (int j = -1; j <= 1; j += 2)
+	  points.push_back(point(e.eta + 0.49*i*e.dEta, e.phi + 0.49*j*e.dPhi));
+      return std::make_pair(points.begin(), points.end());
+    }
+    bool insideElement(const GlobalPoint&, const DetId&) const override { return false; }
+
+  private:
+    static GlobalPoint point(double eta, double phi) {
+      const double r = 200.;
+      return GlobalPoint(r*std::cos(phi), r*std::sin(phi), r*std::sinh(eta));
+    }
+
+    std::vector<Element> elements_;
+  };
+
+}
+
+int main(int argc, char** argv) {
+  const int nQueries = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+  // towers of 0.087x0.087 up to |eta| 3, and chambers of 0.3x0.5 up to |eta| 2.4
+  // (the binning of the calo and muon associators)
+  std::vector<ToyDetIdAssociator::Element> elements;
+  for (int i = 0; i != 68; ++i)
+    for (int j = 0; j != 72; ++j)
+      elements.push_back({-3. + 0.087*(i + 0.5), -M_PI + 2*M_PI/72*(j + 0.5), 0.087, 2*M_PI/72});
+  for (int i = 0; i != 16; ++i)
+    for (int j = 0; j != 12; ++j)
+      elements.push_back({-2.4 + 0.3*(i + 0.5), -M_PI + 2*M_PI/12*(j + 0.5), 0.3, 2*M_PI/12});
+  ToyDetIdAssociator associator(72, 70, 0.087, elements);
+  associator.buildMap();
+
+  // points and the ranges of the muon preselection
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> eta(-2.8, 2.8), phi(-M_PI, M_PI), range(0., 0.3);
+  std::vector<GlobalPoint> points;
+  std::vector<DetIdAssociator::MapRange> ranges;
+  for (int q = 0; q != nQueries; ++q) {
+    double th = 2*std::atan(std::exp(-eta(gen))), ph = phi(gen);
+    points.push_back(GlobalPoint(std::sin(th)*std::cos(ph), std::sin(th)*std::sin(ph), std::cos(th)));
+    DetIdAssociator::MapRange r;
+    r.dThetaPlus = range(gen); r.dThetaMinus = range(gen);
+    r.dPhiPlus = range(gen); r.dPhiMinus = range(gen);
+    ranges.push_back(r);
+  }
+
+  std::vector<std::set<DetId> > sets;
+  sets.reserve(nQueries);
+  auto t0 = std::chrono::steady_clock::now();
+  for (int q = 0; q != nQueries; ++q) sets.push_back(associator.getDetIdsCloseToAPoint(points[q], ranges[q]));
+  auto t1 = std::chrono::steady_clock::now();
+  std::vector<DetId> ids;
+  long nIds = 0;
+  for (int q = 0; q != nQueries; ++q) {
+    associator.fillDetIdsCloseToAPoint(points[q], ranges[q], ids);
+    nIds += ids.size();
+  }
+  auto t2 = std::chrono::steady_clock::now();
+
+  int bad = 0;
+  for (int q = 0; q != nQueries; ++q) {
+    associator.fillDetIdsCloseToAPoint(points[q], ranges[q], ids);
+    if (std::vector<DetId>(sets[q].begin(), sets[q].end()) != ids) ++bad;
+  }
+  // every element is found in the bin of its center
+  for (unsigned int i = 0; i != elements.size(); ++i) {
+    DetId id = associator.detId(i);
+    std::set<DetId> inBin = associator.getDetIdsCloseToAPoint(GlobalPoint(std::cos(elements[i].phi), std::sin(elements[i].phi),
+									   std::sinh(elements[i].eta)), 0);
+    if (inBin.count(id) == 0) ++bad;
+  }
+
+  std::cout << nQueries << " queries, " << double(nIds)/nQueries << " DetIds per query\n"
+	    << "  std::set  " << nQueries/std::chrono::duration<double>(t1 - t0).count() << " queries/s\n"
+	    << "  vector    " << nQueries/std::chrono::duration<double>(t2 - t1).count() << " queries/s" << std::endl;
+  if (bad == 0) return 0;
+  std::cerr << "  MISMATCH in " << bad << " queries" << std::endl;
+  return 1;
+}
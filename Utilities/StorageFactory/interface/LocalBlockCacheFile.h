@@ -0,0 +1,96 @@
+#ifndef STORAGE_FACTORY_LOCAL_BLOCK_CACHE_FILE_H
+# define STORAGE_FACTORY_LOCAL_BLOCK_CACHE_FILE_H
+
+# include "Utilities/StorageFactory/interface/Storage.h"
+# include "Utilities/StorageFactory/interface/StorageAccount.h"
+# include <atomic>
+# include <condition_variable>
+# include <memory>
+# include <mutex>
+# include <string>
+# include <thread>
+# include <vector>
+
+/** Node-wide cache of fixed size blocks of remote files, kept in a
+    directory shared by all jobs on the node.  Each block is stored in a
+    file of its own named after the digest of the file key and the block
+    index, so any job reading the same file finds the blocks the others
+    fetched.  The block is followed in the file by the MD5 digest of its
+    contents, damaged blocks are discarded when read.  The least recently
+    used blocks are removed by a helper thread once the cache grows beyond
+    its size limit.  */
+class LocalBlockCache
+{
+public:
+  static const IOOffset BLOCK_SIZE = 1024*1024;
+
+  LocalBlockCache (const std::string &dir, double maxSizeGB);
+  ~LocalBlockCache (void);
+
+  const std::string &	dir (void) const;
+  IOOffset		maxSize (void) const;
+
+  std::string		blockPath (const std::string &fileId, IOOffset block) const;
+  bool			load (const std::string &path, std::vector<char> &data,
+			      IOSize blockSize);
+  void			store (const std::string &path, const void *from, IOSize n);
+
+private:
+  void			evict (void);
+  void			evictLoop (void);
+
+  std::string		dir_;
+  IOOffset		maxSize_;
+  std::mutex		mutex_;
+  std::condition_variable evictWanted_;
+  IOOffset		stored_;
+  bool			evictPending_;
+  bool			stopEvictor_;
+  std::atomic<bool>	warned_;
+  std::thread		evictor_;
+};
+
+/** Proxy class reading a file through a LocalBlockCache. */
+class LocalBlockCacheFile : public Storage
+{
+public:
+  LocalBlockCacheFile (Storage *base, std::shared_ptr<LocalBlockCache> cache,
+		       const std::string &key);
+  ~LocalBlockCacheFile (void);
+
+  using Storage::read;
+  using Storage::write;
+
+  virtual bool		prefetch (const IOPosBuffer *what, IOSize n);
+  virtual IOSize	read (void *into, IOSize n);
+  virtual IOSize	read (void *into, IOSize n, IOOffset pos);
+  virtual IOSize	readv (IOBuffer *into, IOSize n);
+  virtual IOSize	readv (IOPosBuffer *into, IOSize n);
+  virtual IOSize	write (const void *from, IOSize n);
+  virtual IOSize	write (const void *from, IOSize n, IOOffset pos);
+  virtual IOSize	writev (const IOBuffer *from, IOSize n);
+  virtual IOSize	writev (const IOPosBuffer *from, IOSize n);
+
+  virtual IOOffset	size (void) const;
+  virtual IOOffset	position (IOOffset offset, Relative whence = SET);
+  virtual void		resize (IOOffset size);
+  virtual void		flush (void);
+  virtual void		close (void);
+
+private:
+  IOSize		blockSize (IOOffset block) const;
+  IOSize		readBlocks (IOPosBuffer *into, IOSize n);
+  void			fetch (const std::vector<IOOffset> &blocks,
+			       std::vector<std::vector<char> > &data);
+
+  IOOffset		image_;
+  IOOffset		position_;
+  Storage		*storage_;
+  std::shared_ptr<LocalBlockCache> cache_;
+  std::string		fileId_;
+  bool			accounting_;
+  StorageAccount::Counter *statsHit_;
+  StorageAccount::Counter *statsMiss_;
+};
+
+#endif // STORAGE_FACTORY_LOCAL_BLOCK_CACHE_FILE_H
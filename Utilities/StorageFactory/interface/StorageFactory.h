@@ -10,6 +10,7 @@
 #include "tbb/concurrent_unordered_map.h"
 
 class Storage;
+class LocalBlockCache;
 class StorageFactory 
 {
 public:
@@ -54,6 +55,10 @@ public:
   std::string	tempPath (void) const;
   double	tempMinFree (void) const;
 
+  void		setBlockCache (const std::string &dir, double maxSizeGB);
+  std::string	blockCacheDir (void) const;
+  double	blockCacheMaxSize (void) const;
+
   void		stagein (const std::string &url);
   Storage *	open (const std::string &url,
 	    	      int mode = IOFlags::OpenRead);
@@ -84,6 +89,9 @@ private:
   std::string	m_tempdir;
   unsigned int  m_timeout;
   unsigned int  m_debugLevel;
+  std::string	m_blockCacheDir;
+  double	m_blockCacheMaxSize;
+  std::shared_ptr<LocalBlockCache> m_blockCache;
   LocalFileSystem m_lfs;
   static StorageFactory s_instance;
 };
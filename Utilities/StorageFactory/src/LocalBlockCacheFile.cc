@@ -0,0 +1,535 @@
+#include "Utilities/StorageFactory/interface/LocalBlockCacheFile.h"
+#include "Utilities/StorageFactory/interface/StorageFactory.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Digest.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include <algorithm>
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+// Largest number of missing blocks fetched from the remote file at once.
+static const size_t MAX_FETCH_BLOCKS = 64;
+
+// Temporary files older than this (in seconds) were left behind by a job
+// which died while storing a block.
+static const time_t STALE_TEMP_AGE = 3600;
+
+// Size of the MD5 digest stored after the contents of each block.
+static const IOSize CHECKSUM_SIZE = sizeof(cms::MD5Result().bytes);
+
+static void
+nowrite(const std::string &why)
+{
+  cms::Exception ex("LocalBlockCacheFile");
+  ex << "Cannot change file but operation '" << why << "' was called";
+  ex.addContext("LocalBlockCacheFile::" + why + "()");
+  throw ex;
+}
+
+const IOOffset LocalBlockCache::BLOCK_SIZE;
+
+LocalBlockCache::LocalBlockCache(const std::string &dir, double maxSizeGB)
+  : dir_(dir),
+    maxSize_(static_cast<IOOffset>(maxSizeGB * 1024 * 1024 * 1024)),
+    // Scan the directory on the first store to start from the real size.
+    stored_(maxSize_),
+    evictPending_(false),
+    stopEvictor_(false),
+    warned_(false)
+{
+  ::mkdir(dir_.c_str(), 0700);
+  evictor_ = std::thread(&LocalBlockCache::evictLoop, this);
+}
+
+LocalBlockCache::~LocalBlockCache(void)
+{
+  {
+    std::lock_guard<std::mutex> sentry(mutex_);
+    stopEvictor_ = true;
+  }
+  evictWanted_.notify_one();
+  evictor_.join();
+}
+
+const std::string &
+LocalBlockCache::dir(void) const
+{ return dir_; }
+
+IOOffset
+LocalBlockCache::maxSize(void) const
+{ return maxSize_; }
+
+std::string
+LocalBlockCache::blockPath(const std::string &fileId, IOOffset block) const
+{
+  std::ostringstream ost;
+  ost << dir_ << '/' << fileId.substr(0, 2) << '/' << fileId.substr(2) << '-' << block;
+  return ost.str();
+}
+
+bool
+LocalBlockCache::load(const std::string &path, std::vector<char> &data, IOSize blockSize)
+{
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1)
+    return false;
+
+  // A block of the wrong size was not written by us; treat it as a miss.
+  struct stat st;
+  bool ok = (fstat(fd, &st) == 0) && (st.st_size == static_cast<off_t>(blockSize + CHECKSUM_SIZE));
+
+  // The whole block is read to check it against its digest.
+  data.resize(ok ? blockSize + CHECKSUM_SIZE : 0);
+  IOSize done = 0;
+  while (ok && done < data.size())
+  {
+    ssize_t s = ::pread(fd, &data[done], data.size() - done, done);
+    if (s == -1 && errno == EINTR)
+      continue;
+    if (s <= 0)
+      ok = false;
+    else
+      done += s;
+  }
+
+  if (ok)
+  {
+    cms::Digest digest;
+    digest.append(&data[0], blockSize);
+    if (memcmp(digest.digest().bytes, &data[blockSize], CHECKSUM_SIZE) == 0)
+      data.resize(blockSize);
+    else
+    {
+      ok = false;
+      ::unlink(path.c_str());
+      edm::LogWarning("LocalBlockCache")
+        << "Removed the damaged block '" << path << "' from the local block cache";
+    }
+  }
+
+  // The modification time marks the last use of the block for eviction.
+  if (ok)
+  {
+    struct timespec times[2];
+    times[0].tv_sec = times[1].tv_sec = 0;
+    times[0].tv_nsec = UTIME_OMIT;
+    times[1].tv_nsec = UTIME_NOW;
+    futimens(fd, times);
+  }
+
+  ::close(fd);
+  return ok;
+}
+
+void
+LocalBlockCache::store(const std::string &path, const void *from, IOSize n)
+{
+  ::mkdir(path.substr(0, path.rfind('/')).c_str(), 0700);
+
+  // Write to a temporary file and rename it into place so that other jobs
+  // never see a partially written block.
+  std::string pattern = path + ".XXXXXX";
+  std::vector<char> temp(pattern.c_str(), pattern.c_str()+pattern.size()+1);
+  int fd = mkstemp(&temp[0]);
+  bool ok = (fd != -1);
+  if (ok)
+  {
+    fchmod(fd, 0600);
+    cms::Digest digest;
+    digest.append(static_cast<const char *>(from), n);
+    cms::MD5Result checksum = digest.digest();
+    IOBuffer pieces[] = { IOBuffer(from, n), IOBuffer(checksum.bytes, CHECKSUM_SIZE) };
+    for (const auto &piece : pieces)
+    {
+      IOSize done = 0;
+      while (ok && done < piece.size())
+      {
+        ssize_t s = ::write(fd, static_cast<const char *>(piece.data()) + done, piece.size() - done);
+        if (s == -1 && errno == EINTR)
+          continue;
+        if (s <= 0)
+          ok = false;
+        else
+          done += s;
+      }
+    }
+    ok = (::close(fd) == 0) && ok;
+    ok = ok && (::rename(&temp[0], path.c_str()) == 0);
+    if (!ok)
+      ::unlink(&temp[0]);
+  }
+
+  if (!ok)
+  {
+    // The cache is only an optimisation; carry on reading remotely.
+    if (!warned_.exchange(true))
+      edm::LogWarning("LocalBlockCache")
+        << "Unable to store blocks in the local block cache '" << dir_ << "': "
+        << strerror(errno) << " (error " << errno << ")";
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> sentry(mutex_);
+    stored_ += n + CHECKSUM_SIZE;
+    if (stored_ < std::max(maxSize_ / 20, BLOCK_SIZE))
+      return;
+    stored_ = 0;
+    evictPending_ = true;
+  }
+  evictWanted_.notify_one();
+}
+
+void
+LocalBlockCache::evictLoop(void)
+{
+  // Directory scans can take long on a big cache, so they are done here
+  // rather than by the thread which happened to store the last block.
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true)
+  {
+    evictWanted_.wait(lock, [this] { return evictPending_ || stopEvictor_; });
+    if (stopEvictor_)
+      return;
+    evictPending_ = false;
+    lock.unlock();
+    evict();
+    lock.lock();
+  }
+}
+
+void
+LocalBlockCache::evict(void)
+{
+  // Only one job on the node cleans up at a time; the others skip it.
+  std::string lockPath = dir_ + "/.lock";
+  int lock = ::open(lockPath.c_str(), O_RDWR | O_CREAT, 0600);
+  if (lock == -1)
+    return;
+  if (flock(lock, LOCK_EX | LOCK_NB) != 0)
+  {
+    ::close(lock);
+    return;
+  }
+
+  struct Entry
+  {
+    std::string path;
+    time_t      mtime;
+    IOOffset    size;
+  };
+  std::vector<Entry> entries;
+  IOOffset total = 0;
+  time_t now = time(0);
+
+  if (DIR *top = opendir(dir_.c_str()))
+  {
+    while (struct dirent *d = readdir(top))
+    {
+      if (d->d_name[0] == '.')
+        continue;
+      std::string sub = dir_ + '/' + d->d_name;
+      DIR *blocks = opendir(sub.c_str());
+      if (!blocks)
+        continue;
+      while (struct dirent *b = readdir(blocks))
+      {
+        if (b->d_name[0] == '.')
+          continue;
+        std::string path = sub + '/' + b->d_name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+          continue;
+        if (strchr(b->d_name, '.'))
+        {
+          if (now - st.st_mtime > STALE_TEMP_AGE)
+            ::unlink(path.c_str());
+          continue;
+        }
+        entries.push_back(Entry{path, st.st_mtime, st.st_size});
+        total += st.st_size;
+      }
+      closedir(blocks);
+    }
+    closedir(top);
+  }
+
+  // Remove the least recently used blocks, leaving some room to grow.
+  if (total > maxSize_)
+  {
+    IOOffset target = maxSize_ / 10 * 9;
+    size_t removed = 0;
+    std::sort(entries.begin(), entries.end(),
+	      [](const Entry &a, const Entry &b) { return a.mtime < b.mtime; });
+    for (const auto &e : entries)
+    {
+      if (total <= target)
+        break;
+      if (::unlink(e.path.c_str()) == 0)
+      {
+        total -= e.size;
+        ++removed;
+      }
+    }
+    edm::LogInfo("LocalBlockCache")
+      << "Removed " << removed << " blocks from the local block cache '"
+      << dir_ << "', " << total / 1024 / 1024 << "MB left";
+  }
+
+  flock(lock, LOCK_UN);
+  ::close(lock);
+}
+
+LocalBlockCacheFile::LocalBlockCacheFile(Storage *base, std::shared_ptr<LocalBlockCache> cache,
+					 const std::string &key)
+  : image_(base->size()),
+    position_(0),
+    storage_(base),
+    cache_(cache),
+    accounting_(StorageFactory::get()->accounting()),
+    statsHit_(0),
+    statsMiss_(0)
+{
+  // Include the size so that a file replaced under the same name does not
+  // pick up the blocks of the old one.
+  std::ostringstream ost;
+  ost << key << ':' << image_;
+  fileId_ = cms::Digest(ost.str()).digest().toString();
+
+  if (accounting_)
+  {
+    statsHit_ = &StorageAccount::counter("local-block-cache", "hit");
+    statsMiss_ = &StorageAccount::counter("local-block-cache", "miss");
+  }
+}
+
+LocalBlockCacheFile::~LocalBlockCacheFile(void)
+{
+  delete storage_;
+}
+
+IOSize
+LocalBlockCacheFile::blockSize(IOOffset block) const
+{ return std::min(image_ - block * LocalBlockCache::BLOCK_SIZE, LocalBlockCache::BLOCK_SIZE); }
+
+void
+LocalBlockCacheFile::fetch(const std::vector<IOOffset> &blocks,
+			   std::vector<std::vector<char> > &data)
+{
+  std::vector<IOPosBuffer> iov;
+  IOSize expected = 0;
+  data.resize(blocks.size());
+  for (size_t i = 0; i < blocks.size(); ++i)
+  {
+    data[i].resize(blockSize(blocks[i]));
+    iov.push_back(IOPosBuffer(blocks[i] * LocalBlockCache::BLOCK_SIZE, &data[i][0], data[i].size()));
+    expected += data[i].size();
+  }
+
+  std::unique_ptr<StorageAccount::Stamp> stats;
+  if (accounting_)
+    stats.reset(new StorageAccount::Stamp(*statsMiss_));
+
+  IOSize nread = 0;
+  try
+  {
+    nread = storage_->readv(&iov[0], iov.size());
+  }
+  catch (cms::Exception &e)
+  {
+    std::ostringstream ost;
+    ost << "Unable to fetch " << blocks.size() << " blocks (" << expected << " bytes) for the local block cache: ";
+    edm::Exception ex(edm::errors::FileReadError, ost.str(), e);
+    ex.addContext("LocalBlockCacheFile::fetch()");
+    throw ex;
+  }
+
+  if (nread != expected)
+  {
+    edm::Exception ex(edm::errors::FileReadError);
+    ex << "Unable to fetch " << blocks.size() << " blocks (" << expected
+       << " bytes) for the local block cache: got only " << nread << " bytes back";
+    ex.addContext("LocalBlockCacheFile::fetch()");
+    throw ex;
+  }
+
+  if (stats)
+    stats->tick(nread, iov.size());
+
+  for (size_t i = 0; i < blocks.size(); ++i)
+    cache_->store(cache_->blockPath(fileId_, blocks[i]), &data[i][0], data[i].size());
+}
+
+IOSize
+LocalBlockCacheFile::readBlocks(IOPosBuffer *into, IOSize n)
+{
+  struct Piece
+  {
+    IOOffset block;
+    IOSize   offset;
+    IOSize   size;
+    char     *into;
+  };
+
+  std::vector<Piece> pieces;
+  IOSize total = 0;
+  for (IOSize i = 0; i < n; ++i)
+  {
+    IOOffset pos = into[i].offset();
+    if (pos >= image_)
+      continue;
+    IOSize len = std::min(static_cast<IOOffset>(into[i].size()), image_ - pos);
+    char *data = static_cast<char *>(into[i].data());
+    total += len;
+    while (len)
+    {
+      IOOffset block = pos / LocalBlockCache::BLOCK_SIZE;
+      IOSize offset = pos - block * LocalBlockCache::BLOCK_SIZE;
+      IOSize size = std::min(len, blockSize(block) - offset);
+      pieces.push_back(Piece{block, offset, size, data});
+      pos += size;
+      data += size;
+      len -= size;
+    }
+  }
+
+  // Many pieces of a vector read usually fall in the same block: read and
+  // verify each cached block once and serve all its pieces from it.
+  std::stable_sort(pieces.begin(), pieces.end(),
+		   [](const Piece &a, const Piece &b) { return a.block < b.block; });
+
+  std::vector<Piece> missed;
+  std::vector<IOOffset> blocks;
+  std::vector<char> cached;
+  IOSize hits = 0;
+  for (size_t first = 0, last = 0; first < pieces.size(); first = last)
+  {
+    IOOffset block = pieces[first].block;
+    for (last = first; last < pieces.size() && pieces[last].block == block; ++last)
+      ;
+    if (cache_->load(cache_->blockPath(fileId_, block), cached, blockSize(block)))
+      for (size_t i = first; i < last; ++i)
+      {
+        memcpy(pieces[i].into, &cached[pieces[i].offset], pieces[i].size);
+        hits += pieces[i].size;
+      }
+    else
+    {
+      missed.insert(missed.end(), pieces.begin() + first, pieces.begin() + last);
+      blocks.push_back(block);
+    }
+  }
+
+  if (accounting_ && hits)
+    StorageAccount::Stamp(*statsHit_).tick(hits);
+
+  for (size_t first = 0; first < blocks.size(); first += MAX_FETCH_BLOCKS)
+  {
+    std::vector<IOOffset> batch(blocks.begin() + first,
+				blocks.begin() + std::min(first + MAX_FETCH_BLOCKS, blocks.size()));
+    std::vector<std::vector<char> > data;
+    fetch(batch, data);
+    for (const auto &piece : missed)
+    {
+      auto found = std::lower_bound(batch.begin(), batch.end(), piece.block);
+      if (found != batch.end() && *found == piece.block)
+        memcpy(piece.into, &data[found - batch.begin()][piece.offset], piece.size);
+    }
+  }
+
+  return total;
+}
+
+IOSize
+LocalBlockCacheFile::read(void *into, IOSize n)
+{
+  IOSize result = read(into, n, position_);
+  position_ += result;
+  return result;
+}
+
+IOSize
+LocalBlockCacheFile::read(void *into, IOSize n, IOOffset pos)
+{
+  IOPosBuffer buf(pos, into, n);
+  return readBlocks(&buf, 1);
+}
+
+IOSize
+LocalBlockCacheFile::readv(IOBuffer *into, IOSize n)
+{
+  std::vector<IOPosBuffer> iov;
+  iov.reserve(n);
+  IOOffset pos = position_;
+  for (IOSize i = 0; i < n; ++i)
+  {
+    iov.push_back(IOPosBuffer(pos, into[i].data(), into[i].size()));
+    pos += into[i].size();
+  }
+  IOSize result = readBlocks(&iov[0], n);
+  position_ += result;
+  return result;
+}
+
+IOSize
+LocalBlockCacheFile::readv(IOPosBuffer *into, IOSize n)
+{ return readBlocks(into, n); }
+
+IOSize
+LocalBlockCacheFile::write(const void */*from*/, IOSize)
+{ nowrite("write"); return 0; }
+
+IOSize
+LocalBlockCacheFile::write(const void */*from*/, IOSize, IOOffset /*pos*/)
+{ nowrite("write"); return 0; }
+
+IOSize
+LocalBlockCacheFile::writev(const IOBuffer */*from*/, IOSize)
+{ nowrite("writev"); return 0; }
+
+IOSize
+LocalBlockCacheFile::writev(const IOPosBuffer */*from*/, IOSize)
+{ nowrite("writev"); return 0; }
+
+IOOffset
+LocalBlockCacheFile::size(void) const
+{ return image_; }
+
+IOOffset
+LocalBlockCacheFile::position(IOOffset offset, Relative whence)
+{
+  if (whence == CURRENT)
+    offset += position_;
+  else if (whence == END)
+    offset += image_;
+  position_ = std::max(offset, IOOffset(0));
+  return position_;
+}
+
+void
+LocalBlockCacheFile::resize(IOOffset /*size*/)
+{ nowrite("resize"); }
+
+void
+LocalBlockCacheFile::flush(void)
+{ nowrite("flush"); }
+
+void
+LocalBlockCacheFile::close(void)
+{ storage_->close(); }
+
+bool
+LocalBlockCacheFile::prefetch(const IOPosBuffer */*what*/, IOSize /*n*/)
+{
+  // Blocks are fetched synchronously when read; asynchronous prefetching
+  // is not supported.
+  return false;
+}
@@ -86,6 +86,13 @@ StorageAccount::fillSummary(std::map<std::string, std::string>& summary) {
       summary.insert(std::make_pair(os.str() + "minMsecs", d2str(j->second.timeMin / oneM)));
       summary.insert(std::make_pair(os.str() + "maxMsecs", d2str(j->second.timeMax / oneM)));
     }
+    // Caches count the bytes found as "hit" and those fetched as "miss".
+    OperationStats::const_iterator hit = i->second->find("hit");
+    OperationStats::const_iterator miss = i->second->find("miss");
+    if (hit != i->second->end() && miss != i->second->end() && hit->second.amount + miss->second.amount > 0) {
+      summary.insert(std::make_pair("Timing-" + i->first + "-hitRate",
+                                    d2str(hit->second.amount / (hit->second.amount + miss->second.amount))));
+    }
   }
 }
 
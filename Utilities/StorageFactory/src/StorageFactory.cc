@@ -3,6 +3,7 @@
 #include "Utilities/StorageFactory/interface/StorageAccount.h"
 #include "Utilities/StorageFactory/interface/StorageAccountProxy.h"
 #include "Utilities/StorageFactory/interface/LocalCacheFile.h"
+#include "Utilities/StorageFactory/interface/LocalBlockCacheFile.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/PluginManager/interface/PluginManager.h"
 #include "FWCore/PluginManager/interface/standard.h"
@@ -18,7 +19,8 @@ StorageFactory::StorageFactory (void)
     m_tempfree (4.), // GB
     m_temppath (".:$TMPDIR"),
     m_timeout(0U),
-    m_debugLevel(0U)
+    m_debugLevel(0U),
+    m_blockCacheMaxSize (20.) // GB
 {
   setTempDir(m_temppath, m_tempfree);
 }
@@ -127,6 +129,25 @@ double
 StorageFactory::tempMinFree(void) const
 { return m_tempfree; }
 
+void
+StorageFactory::setBlockCache(const std::string &dir, double maxSizeGB)
+{
+  m_blockCacheDir = dir;
+  m_blockCacheMaxSize = maxSizeGB;
+  if (dir.empty())
+    m_blockCache.reset();
+  else
+    m_blockCache.reset(new LocalBlockCache(dir, maxSizeGB));
+}
+
+std::string
+StorageFactory::blockCacheDir(void) const
+{ return m_blockCacheDir; }
+
+double
+StorageFactory::blockCacheMaxSize(void) const
+{ return m_blockCacheMaxSize; }
+
 StorageMaker *
 StorageFactory::getMaker (const std::string &proto)
 {
@@ -180,7 +201,23 @@ StorageFactory::open (const std::string &url, int mode /* = IOFlags::OpenRead */
     {
       if (Storage *storage = maker->open (protocol, rest, mode))
       {
-	if (dynamic_cast<LocalCacheFile *>(storage))
+	if (m_blockCache
+	    && ! (mode & IOFlags::OpenWrite)
+	    && ! (protocol == "file" && m_lfs.isLocalPath(rest)))
+	{
+	  // Key the blocks by LFN where possible so that the same file read
+	  // through different servers or redirectors shares its blocks.
+	  std::string key = url;
+	  size_t lfn = url.find("/store/");
+	  if (lfn != std::string::npos)
+	    key = url.substr(lfn);
+
+	  if (m_accounting)
+	    storage = new StorageAccountProxy(protocol, storage);
+	  storage = new LocalBlockCacheFile(storage, m_blockCache, key);
+	  protocol = "local-block-cache";
+	}
+	else if (dynamic_cast<LocalCacheFile *>(storage))
 	  protocol = "local-cache";
 
 	if (m_accounting)
@@ -278,6 +315,10 @@ StorageFactory::wrapNonLocalFile (Storage *s,
       {
         // For now, issue no warning - otherwise, we'd always warn on local input files.
       }
+      else if (m_blockCache)
+      {
+        // open() puts the file behind the node-wide block cache instead.
+      }
       else
       {
         if (accounting()) {s = new StorageAccountProxy(proto, s);}
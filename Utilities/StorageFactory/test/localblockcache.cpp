@@ -0,0 +1,95 @@
+#include "Utilities/StorageFactory/test/Test.h"
+#include "Utilities/StorageFactory/interface/File.h"
+#include "Utilities/StorageFactory/interface/LocalBlockCacheFile.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <memory>
+#include <stdlib.h>
+#include <unistd.h>
+#include <vector>
+
+// Reads the same file twice through a block cache; the second pass
+// must be served from the cache and both must match the file.
+static void
+check (Storage &s, const std::vector<char> &expected)
+{
+  std::vector<char> buf (expected.size ());
+  if (s.read (&buf[0], buf.size (), 0) != expected.size () || buf != expected)
+    throw cms::Exception ("LocalBlockCacheTest") << "Full read returned the wrong data";
+
+  IOOffset offsets [] = { 17, 1024*1024 - 3, 2*1024*1024 + 5 };
+  IOSize sizes [] = { 100, 10, 1000 };
+  std::vector<char> v0 (sizes[0]), v1 (sizes[1]), v2 (sizes[2]);
+  IOPosBuffer iov [] = { IOPosBuffer (offsets[0], &v0[0], sizes[0]),
+			 IOPosBuffer (offsets[1], &v1[0], sizes[1]),
+			 IOPosBuffer (offsets[2], &v2[0], sizes[2]) };
+  if (s.readv (iov, 3) != sizes[0] + sizes[1] + sizes[2])
+    throw cms::Exception ("LocalBlockCacheTest") << "Vector read returned the wrong size";
+  for (int i = 0; i < 3; ++i)
+    if (! std::equal (static_cast<char *>(iov[i].data ()), static_cast<char *>(iov[i].data ()) + sizes[i],
+		      expected.begin () + offsets[i]))
+      throw cms::Exception ("LocalBlockCacheTest") << "Vector read " << i << " returned the wrong data";
+}
+
+int main (int, char **) try
+{
+  initTest();
+
+  char dirPattern [] = "blockcache-test-XXXXXX";
+  if (! mkdtemp (dirPattern))
+    throw cms::Exception ("LocalBlockCacheTest") << "Cannot create the cache directory";
+  std::string dir (dirPattern);
+  std::string name = dir + "/data";
+
+  std::vector<char> data (2*1024*1024 + 12345);
+  for (size_t i = 0; i < data.size (); ++i)
+    data[i] = static_cast<char> (i * 7 + i / 4096);
+  {
+    File out (name, IOFlags::OpenWrite | IOFlags::OpenCreate | IOFlags::OpenTruncate);
+    out.write (&data[0], data.size ());
+    out.close ();
+  }
+
+  std::shared_ptr<LocalBlockCache> cache (new LocalBlockCache (dir + "/cache", 1.));
+  {
+    LocalBlockCacheFile first (new File (name), cache, "/store/test/data.root");
+    check (first, data);
+  }
+  StorageAccount::Counter &hits = StorageAccount::counter ("local-block-cache", "hit");
+  double firstHits = hits.amount;
+  {
+    LocalBlockCacheFile second (new File (name), cache, "/store/test/data.root");
+    check (second, data);
+  }
+  if (hits.amount - firstHits < data.size ())
+    throw cms::Exception ("LocalBlockCacheTest") << "Second pass was not served from the cache";
+
+  // A damaged block must be fetched again rather than returned.
+  for (boost::filesystem::recursive_directory_iterator it (dir + "/cache"), end; it != end; ++it)
+  {
+    if (! boost::filesystem::is_regular_file (it->path ()) || it->path ().filename ().string ()[0] == '.')
+      continue;
+    File block (it->path ().string (), IOFlags::OpenRead | IOFlags::OpenWrite);
+    char c = 0;
+    block.read (&c, 1, 100);
+    c = ~c;
+    block.write (&c, 1, 100);
+    block.close ();
+  }
+  {
+    LocalBlockCacheFile third (new File (name), cache, "/store/test/data.root");
+    check (third, data);
+  }
+
+  std::cout << "stats:\n" << StorageAccount::summaryText () << std::endl;
+  boost::filesystem::remove_all (dir);
+  return EXIT_SUCCESS;
+} catch(cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return EXIT_FAILURE;
+} catch(std::exception const& e) {
+  std::cerr << e.what() << std::endl;
+  return EXIT_FAILURE;
+}
@@ -37,6 +37,13 @@ public:
     if (env)
     {
       env->PutString("NetworkStack", "IPAuto");
+      // Number of sources a vector read is striped across, and the latency
+      // percentile of past stripes after which a slow stripe is re-requested
+      // from another source (0 disables hedging).
+      env->PutInt("CMSSWMaxActiveSources", 2);
+      env->ImportInt("CMSSWMaxActiveSources", "XRD_CMSSWMAXACTIVESOURCES");
+      env->PutInt("CMSSWHedgeLatencyPercentile", 0);
+      env->ImportInt("CMSSWHedgeLatencyPercentile", "XRD_CMSSWHEDGELATENCYPERCENTILE");
     }
     XrdNetUtils::SetAuto(XrdNetUtils::prefAuto);
     setTimeout(XRD_DEFAULT_TIMEOUT);
@@ -26,11 +26,16 @@ XrdAdaptor::ClientRequest::HandleResponse(XrdCl::XRootDStatus *stat, XrdCl::AnyO
     std::unique_ptr<XrdCl::XRootDStatus> status(stat);
     std::shared_ptr<ClientRequest> self_ref = m_self_reference;
     m_self_reference.reset();
+    // Wake up whoever waits on this request once the promise is set; a
+    // request which is retried on another source only causes a spurious wakeup.
+    std::shared_ptr<RequestCompletion> completion = m_completion;
+    std::shared_ptr<void> notifySentry(nullptr, [completion](void*) {if (completion) {completion->notify();}});
     {
         QualityMetricWatch qmw;
         m_qmw.swap(qmw);
     }
     m_stats.reset();
+    m_server_stats.reset();
 
     if ((!FAKE_ERROR_COUNTER || ((++g_fakeError % FAKE_ERROR_COUNTER) != 0)) && (status->IsOK() && resp))
     {
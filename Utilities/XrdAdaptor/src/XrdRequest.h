@@ -1,7 +1,9 @@
 #ifndef Utilities_XrdAdaptor_XrdRequest_h
 #define Utilities_XrdAdaptor_XrdRequest_h
 
+#include <condition_variable>
 #include <future>
+#include <mutex>
 #include <vector>
 
 #include <boost/utility.hpp>
@@ -19,6 +21,38 @@ class RequestManager;
 
 class XrdReadStatistics;
 
+/**
+ * Signalled each time one of the requests it is attached to completes, so
+ * that a caller can sleep until the first of several requests is done.
+ */
+class RequestCompletion : boost::noncopyable {
+
+public:
+
+    void notify()
+    {
+        {
+            std::lock_guard<std::mutex> sentry(m_mutex);
+        }
+        m_cv.notify_all();
+    }
+
+    /**
+     * Blocks until ready() returns true; ready() is checked each time one of
+     * the attached requests completes.
+     */
+    template <typename F>
+    void wait(F ready)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, ready);
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
 class ClientRequest : boost::noncopyable, public XrdCl::ResponseHandler {
 
 friend class Source;
@@ -57,6 +91,29 @@ public:
         m_stats = stats;
     }
 
+    void setServerStatistics(std::shared_ptr<XrdReadStatistics> stats)
+    {
+        m_server_stats = stats;
+    }
+
+    /**
+     * Keep the given object alive for as long as this request exists;
+     * used when the request reads into a buffer owned by someone else
+     * than the caller.
+     */
+    void setBufferHolder(std::shared_ptr<void> holder)
+    {
+        m_buffer_holder = holder;
+    }
+
+    /**
+     * Notify the given object once the result of this request is known.
+     */
+    void setCompletion(std::shared_ptr<RequestCompletion> completion)
+    {
+        m_completion = completion;
+    }
+
     virtual ~ClientRequest();
 
     std::future<IOSize> get_future()
@@ -88,6 +145,9 @@ private:
     RequestManager &m_manager;
     std::shared_ptr<Source> m_source;
     std::shared_ptr<XrdReadStatistics> m_stats;
+    std::shared_ptr<XrdReadStatistics> m_server_stats;
+    std::shared_ptr<void> m_buffer_holder;
+    std::shared_ptr<RequestCompletion> m_completion;
 
     // Some explanation is due here.  When an IO is outstanding,
     // Xrootd takes a raw pointer to this object.  Hence we cannot
@@ -2,6 +2,8 @@
 #include <assert.h>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <netdb.h>
 
 #include "XrdCl/XrdClFile.hh"
@@ -21,6 +23,16 @@
 
 #define XRD_ADAPTOR_SHORT_OPEN_DELAY 5
 
+// Number of searches in a row which bring no new server after which free
+// striping slots are no longer a reason to search for one.
+#define XRD_ADAPTOR_MAX_UNPRODUCTIVE_SEARCHES 3
+
+// Number of past stripe latencies kept to compute the hedging percentile,
+// the number needed before hedging starts and the smallest hedging delay in ms.
+#define XRD_ADAPTOR_HEDGE_SAMPLES 100
+#define XRD_ADAPTOR_HEDGE_MIN_SAMPLES 20
+#define XRD_ADAPTOR_HEDGE_MIN_DELAY 10
+
 #ifdef XRD_FAKE_OPEN_PROBE
 #define XRD_ADAPTOR_OPEN_PROBE_PERCENT 100
 #define XRD_ADAPTOR_LONG_OPEN_DELAY 20
@@ -102,12 +114,16 @@ SendMonitoringInfo(XrdCl::File &file)
 
 RequestManager::RequestManager(const std::string &filename, XrdCl::OpenFlags::Flags flags, XrdCl::Access::Mode perms)
     : m_timeout(XRD_DEFAULT_TIMEOUT),
-      m_nextInitialSourceToggle(false),
+      m_nextInitialSource(1),
+      m_maxActiveSources(2),
+      m_hedgePercentile(0),
+      m_unproductiveSearches(0),
       m_name(filename),
       m_flags(flags),
       m_perms(perms),
       m_distribution(0,100),
-      m_excluded_active_count(0)
+      m_excluded_active_count(0),
+      m_nextStripeLatency(0)
 {
 }
 
@@ -115,10 +131,21 @@ RequestManager::RequestManager(const std::string &filename, XrdCl::OpenFlags::Fl
 void
 RequestManager::initialize(std::weak_ptr<RequestManager> self)
 {
+  m_self = self;
   m_open_handler = OpenHandler::getInstance(self);
 
   XrdCl::Env *env = XrdCl::DefaultEnv::GetEnv();
-  if (env) {env->GetInt("StreamErrorWindow", m_timeout);}
+  if (env)
+  {
+    env->GetInt("StreamErrorWindow", m_timeout);
+    int maxActiveSources = m_maxActiveSources;
+    if (env->GetInt("CMSSWMaxActiveSources", maxActiveSources) && (maxActiveSources > 0))
+    {
+      m_maxActiveSources = maxActiveSources;
+    }
+    env->GetInt("CMSSWHedgeLatencyPercentile", m_hedgePercentile);
+    m_hedgePercentile = std::min(std::max(m_hedgePercentile, 0), 100);
+  }
 
   std::string orig_site;
   if (!Source::getXrootdSiteFromURL(m_name, orig_site) && (orig_site.find(".") == std::string::npos))
@@ -236,11 +263,17 @@ RequestManager::initialize(std::weak_ptr<RequestManager> self)
 void
 RequestManager::updateSiteInfo(std::string orig_site)
 {
-  std::string siteA, siteB, siteList;
-  if (m_activeSources.size()) {siteA = m_activeSources[0]->Site();}
-  if (m_activeSources.size() == 2) {siteB = m_activeSources[1]->Site();}
-  siteList = siteA;
-  if (siteB.size() && (siteB != siteA)) {siteList = siteA + ", " + siteB;}
+  std::vector<std::string> sites;
+  for (const auto & source : m_activeSources)
+  {
+    if (std::find(sites.begin(), sites.end(), source->Site()) == sites.end()) {sites.push_back(source->Site());}
+  }
+  std::string siteList;
+  for (const auto & site : sites)
+  {
+    if (siteList.size()) {siteList += ", ";}
+    siteList += site;
+  }
   if (orig_site.size() && (orig_site != siteList))
   {
     edm::LogWarning("XrdAdaptor") << "Data is served from " << siteList << " instead of original site " << orig_site;
@@ -265,8 +298,7 @@ RequestManager::checkSources(timespec &now, IOSize requestSize)
   {
     { // Be more aggressive about getting rid of very bad sources.
       std::lock_guard<std::recursive_mutex> sentry(m_source_mutex);   
-      compareSources(now, 0, 1);
-      compareSources(now, 1, 0);
+      compareAllSources(now);
     }
     if (timeDiffMS(now, m_nextActiveSourceCheck) > 0)
     {
@@ -297,6 +329,26 @@ RequestManager::compareSources(const timespec &now, unsigned a, unsigned b)
   return findNewSource;
 }
 
+bool
+RequestManager::compareAllSources(const timespec &now)
+{
+  bool findNewSource = false;
+  unsigned a = 0;
+  while ((a < m_activeSources.size()) && (m_activeSources.size() > 1))
+  {
+    unsigned best = (a == 0) ? 1 : 0;
+    for (unsigned b = 0; b < m_activeSources.size(); b++)
+    {
+      if ((b != a) && (m_activeSources[b]->getQuality() < m_activeSources[best]->getQuality())) {best = b;}
+    }
+    size_t count = m_activeSources.size();
+    findNewSource |= compareSources(now, a, best);
+    // If a was removed, the next source moved into its place.
+    if (m_activeSources.size() == count) {a++;}
+  }
+  return findNewSource;
+}
+
 void
 RequestManager::checkSourcesImpl(timespec &now, IOSize requestSize)
 {
@@ -309,9 +361,16 @@ RequestManager::checkSourcesImpl(timespec &now, IOSize requestSize)
   }
   else if (m_activeSources.size() > 1)
   {
-    edm::LogVerbatim("XrdAdaptorInternal") << "Source 0 quality " << m_activeSources[0]->getQuality() << ", source 1 quality " << m_activeSources[1]->getQuality() << std::endl;
-    findNewSource |= compareSources(now, 0, 1);
-    findNewSource |= compareSources(now, 1, 0);
+    // With N-way striping, keep looking until all the active slots are used,
+    // unless the last searches show there are no more servers to be found.
+    findNewSource = (m_activeSources.size() < m_maxActiveSources) && (m_unproductiveSearches < XRD_ADAPTOR_MAX_UNPRODUCTIVE_SEARCHES);
+    std::stringstream ss;
+    for (size_t idx = 0; idx < m_activeSources.size(); idx++)
+    {
+      ss << (idx ? ", " : "") << "source " << idx << " quality " << m_activeSources[idx]->getQuality();
+    }
+    edm::LogVerbatim("XrdAdaptorInternal") << "Active sources: " << ss.str() << std::endl;
+    findNewSource |= compareAllSources(now);
 
     // NOTE: We could probably replace the copy with a better sort function.
     // However, there are typically very few sources and the correctness is more obvious right now.
@@ -324,6 +383,8 @@ RequestManager::checkSourcesImpl(timespec &now, IOSize requestSize)
         [](const std::shared_ptr<Source> &s1, const std::shared_ptr<Source> &s2) {return s1->getQuality() < s2->getQuality();});
     std::vector<std::shared_ptr<Source> >::iterator worstActiveSource = std::max_element(m_activeSources.begin(), m_activeSources.end(),
         [](const std::shared_ptr<Source> &s1, const std::shared_ptr<Source> &s2) {return s1->getQuality() < s2->getQuality();});
+    std::vector<std::shared_ptr<Source> >::iterator bestActiveSource = std::min_element(m_activeSources.begin(), m_activeSources.end(),
+        [](const std::shared_ptr<Source> &s1, const std::shared_ptr<Source> &s2) {return s1->getQuality() < s2->getQuality();});
     if (bestInactiveSource != eligibleInactiveSources.end() && bestInactiveSource->get())
     {
       edm::LogVerbatim("XrdAdaptorInternal") << "Best inactive source: " <<(*bestInactiveSource)->PrettyID()
@@ -331,9 +392,9 @@ RequestManager::checkSourcesImpl(timespec &now, IOSize requestSize)
     }
     edm::LogVerbatim("XrdAdaptorInternal") << "Worst active source: " <<(*worstActiveSource)->PrettyID() 
         << ", quality " << (*worstActiveSource)->getQuality();
-        // Only upgrade the source if we only have one source and the best inactive one isn't too horrible.
+        // Only upgrade the source if we have a free active slot and the best inactive one isn't too horrible.
         // Regardless, we will want to re-evaluate the new source quickly (within 5s).
-    if ((bestInactiveSource != eligibleInactiveSources.end()) && m_activeSources.size() == 1 && ((*bestInactiveSource)->getQuality() < 4*m_activeSources[0]->getQuality()))
+    if ((bestInactiveSource != eligibleInactiveSources.end()) && (m_activeSources.size() < m_maxActiveSources) && ((*bestInactiveSource)->getQuality() < 4*(*bestActiveSource)->getQuality()))
     {
         m_activeSources.push_back(*bestInactiveSource);
         updateSiteInfo();
@@ -373,8 +434,8 @@ RequestManager::checkSourcesImpl(timespec &now, IOSize requestSize)
     m_lastSourceCheck = now;
   }
 
-  // Only aggressively look for new sources if we don't have two.
-  if (m_activeSources.size() == 2)
+  // Only aggressively look for new sources if we don't have all we want.
+  if (m_activeSources.size() >= m_maxActiveSources)
   {
     now.tv_sec += XRD_ADAPTOR_LONG_OPEN_DELAY - XRD_ADAPTOR_SHORT_OPEN_DELAY;
   }
@@ -445,18 +506,10 @@ RequestManager::pickSingleSource()
   std::shared_ptr<Source> source = nullptr;
   {
     std::lock_guard<std::recursive_mutex> sentry(m_source_mutex);
-    if (m_activeSources.size() == 2)
+    if (m_activeSources.size() > 1)
     {
-        if (m_nextInitialSourceToggle)
-        {
-            source = m_activeSources[0];
-            m_nextInitialSourceToggle = false;
-        }
-        else
-        {
-            source = m_activeSources[1];
-            m_nextInitialSourceToggle = true;
-        }
+        source = m_activeSources[m_nextInitialSource % m_activeSources.size()];
+        m_nextInitialSource++;
     }
     else
     {
@@ -522,6 +575,7 @@ XrdAdaptor::RequestManager::handleOpen(XrdCl::XRootDStatus &status, std::shared_
             {
                 edm::LogVerbatim("XrdAdaptorInternal") << "Xrootd server returned excluded source " << source->PrettyID()
                     << "; ignoring" << std::endl;
+                ++m_unproductiveSearches;
                 unsigned returned_count = ++m_excluded_active_count;
                 m_nextActiveSourceCheck.tv_sec += XRD_ADAPTOR_SHORT_OPEN_DELAY;
                 if (returned_count >= 3) {m_nextActiveSourceCheck.tv_sec += XRD_ADAPTOR_LONG_OPEN_DELAY - 2*XRD_ADAPTOR_SHORT_OPEN_DELAY;}
@@ -534,11 +588,13 @@ XrdAdaptor::RequestManager::handleOpen(XrdCl::XRootDStatus &status, std::shared_
             {
                 edm::LogVerbatim("XrdAdaptorInternal") << "Xrootd server returned excluded inactive source " << source->PrettyID() 
                     << "; ignoring" << std::endl;
+                ++m_unproductiveSearches;
                 m_nextActiveSourceCheck.tv_sec += XRD_ADAPTOR_LONG_OPEN_DELAY - XRD_ADAPTOR_SHORT_OPEN_DELAY;
                 return;
             }
         }
-        if (m_activeSources.size() < 2)
+        m_unproductiveSearches = 0;
+        if (m_activeSources.size() < m_maxActiveSources)
         {
             m_activeSources.push_back(source);
             updateSiteInfo();
@@ -551,6 +607,7 @@ XrdAdaptor::RequestManager::handleOpen(XrdCl::XRootDStatus &status, std::shared_
     else
     {   // File-open failure - wait at least 120s before next attempt.
         edm::LogVerbatim("XrdAdaptorInternal") << "Got failure when trying to open a new source" << std::endl;
+        ++m_unproductiveSearches;
         m_nextActiveSourceCheck.tv_sec += XRD_ADAPTOR_LONG_OPEN_DELAY - XRD_ADAPTOR_SHORT_OPEN_DELAY;
     }
 }
@@ -576,6 +633,21 @@ XrdAdaptor::RequestManager::handle(std::shared_ptr<std::vector<IOPosBuffer> > io
     }
 
     assert(iolist.get());
+    if ((m_activeSources.size() > 2) || m_hedgePercentile)
+    {
+        IOSize size = 0;
+        for (const auto & it : *iolist) size += it.size();
+        checkSources(now, size);
+        // CheckSources may have removed a source
+        if (m_activeSources.size() > 1)
+        {
+            return handleStriped(iolist);
+        }
+        std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr(new XrdAdaptor::ClientRequest(*this, iolist));
+        m_activeSources[0]->handle(c_ptr);
+        return c_ptr->get_future();
+    }
+
     std::shared_ptr<std::vector<IOPosBuffer> > req1(new std::vector<IOPosBuffer>);
     std::shared_ptr<std::vector<IOPosBuffer> > req2(new std::vector<IOPosBuffer>);
     splitClientRequest(*iolist, *req1, *req2);
@@ -665,14 +737,10 @@ RequestManager::requestFailure(std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr,
     m_disabledExcludeStrings.insert(source_ptr->ExcludeID());
     m_disabledSources.insert(source_ptr);
 
-    if ((m_activeSources.size() > 0) && (m_activeSources[0].get() == source_ptr.get()))
-    {
-        m_activeSources.erase(m_activeSources.begin());
-        updateSiteInfo();
-    }
-    else if ((m_activeSources.size() > 1) && (m_activeSources[1].get() == source_ptr.get()))
+    auto failed = std::find(m_activeSources.begin(), m_activeSources.end(), source_ptr);
+    if (failed != m_activeSources.end())
     {
-        m_activeSources.erase(m_activeSources.begin()+1);
+        m_activeSources.erase(failed);
         updateSiteInfo();
     }
     std::shared_ptr<Source> new_source;
@@ -905,6 +973,276 @@ XrdAdaptor::RequestManager::splitClientRequest(const std::vector<IOPosBuffer> &i
     edm::LogVerbatim("XrdAdaptorInternal") << "Original request size " << iolist.size() << " (" << size_orig << " bytes) split into requests size " << req1.size() << " (" << size1 << " bytes) and " << req2.size() << " (" << size2 << " bytes)" << std::endl;
 }
 
+void
+XrdAdaptor::RequestManager::splitClientRequest(const std::vector<IOPosBuffer> &iolist, std::vector<std::shared_ptr<std::vector<IOPosBuffer> > > &requests)
+{
+    size_t count = m_activeSources.size();
+    requests.clear();
+    for (size_t idx = 0; idx < count; idx++) {requests.emplace_back(new std::vector<IOPosBuffer>);}
+    if (iolist.size() == 0) return;
+
+        // As in the two-source case, the share of each source goes as 1/quality^2;
+        // the quality is increased by 5 to prevent strange effects if it is 0 for one source.
+    std::vector<float> weights;
+    float weight_sum = 0;
+    for (const auto & source : m_activeSources)
+    {
+        float q = static_cast<float>(source->getQuality())+5;
+        weights.push_back(1/(q*q));
+        weight_sum += weights.back();
+    }
+
+    IOSize size_orig = 0;
+    for (const auto & it : iolist) size_orig += it.size();
+
+        // Each source gets one contiguous range of the request so that its reads stay
+        // large and sequential; only the buffers straddling a boundary are split.
+    size_t idx = 0;
+    IOSize used = 0;
+    IOSize share = static_cast<IOSize>(static_cast<float>(size_orig)*weights[0]/weight_sum);
+    for (const auto & it : iolist)
+    {
+        IOOffset offset = it.offset();
+        char *data = static_cast<char *>(it.data());
+        IOSize remaining = it.size();
+        while (remaining)
+        {
+            if ((used >= share) && (idx+1 < count))
+            {
+                idx++;
+                used = 0;
+                share = static_cast<IOSize>(static_cast<float>(size_orig)*weights[idx]/weight_sum);
+                continue;
+            }
+            IOSize chunk = (idx+1 < count) ? std::min(remaining, share-used) : remaining;
+            requests[idx]->emplace_back(offset, data, chunk);
+            offset += chunk;
+            data += chunk;
+            remaining -= chunk;
+            used += chunk;
+        }
+    }
+
+    IOSize size_total = 0;
+    std::stringstream ss;
+    for (const auto & req : requests)
+    {
+        IOSize size = validateList(*req);
+        size_total += size;
+        ss << " " << req->size() << " (" << size << " bytes)";
+    }
+    assert(size_orig == size_total);
+
+    edm::LogVerbatim("XrdAdaptorInternal") << "Original request size " << iolist.size() << " (" << size_orig << " bytes) split into requests size" << ss.str() << std::endl;
+}
+
+namespace {
+  // Private destination of a hedged stripe; keeps the RequestManager alive
+  // for as long as XrdCl may write into it.
+  struct StripeBuffer
+  {
+    std::vector<char> m_data;
+    std::shared_ptr<XrdAdaptor::RequestManager> m_manager;
+  };
+
+  struct StripeCopy
+  {
+    std::shared_ptr<XrdAdaptor::Source> m_source;
+    std::shared_ptr<std::vector<IOPosBuffer> > m_iolist;
+    std::future<IOSize> m_future;
+  };
+
+  struct Stripe
+  {
+    std::shared_ptr<std::vector<IOPosBuffer> > m_target;
+    StripeCopy m_primary;
+    // Notified when the primary or the hedged copy completes.
+    std::shared_ptr<XrdAdaptor::RequestCompletion> m_completion;
+  };
+
+  // Issue a read of the target list from the given source.  If `buffered`, the
+  // read goes into a private buffer which is copied out by copyStripe; otherwise
+  // directly into the caller's buffers.  `completion`, if set, is notified when
+  // the read is done.
+  StripeCopy
+  issueStripe(XrdAdaptor::RequestManager &manager, std::shared_ptr<XrdAdaptor::RequestManager> self,
+              std::shared_ptr<XrdAdaptor::Source> source, const std::vector<IOPosBuffer> &target, bool buffered,
+              std::shared_ptr<XrdAdaptor::RequestCompletion> completion)
+  {
+    StripeCopy copy;
+    copy.m_source = source;
+    std::shared_ptr<StripeBuffer> holder;
+    if (buffered)
+    {
+      IOSize size = 0;
+      for (const auto & it : target) size += it.size();
+      holder.reset(new StripeBuffer);
+      holder->m_data.resize(size);
+      holder->m_manager = self;
+      copy.m_iolist.reset(new std::vector<IOPosBuffer>);
+      copy.m_iolist->reserve(target.size());
+      char *data = &holder->m_data[0];
+      for (const auto & it : target)
+      {
+        copy.m_iolist->emplace_back(it.offset(), data, it.size());
+        data += it.size();
+      }
+    }
+    else
+    {
+      copy.m_iolist.reset(new std::vector<IOPosBuffer>(target));
+    }
+    std::shared_ptr<XrdAdaptor::ClientRequest> c_ptr(new XrdAdaptor::ClientRequest(manager, copy.m_iolist));
+    if (holder) {c_ptr->setBufferHolder(holder);}
+    if (completion) {c_ptr->setCompletion(completion);}
+    source->handle(c_ptr);
+    copy.m_future = c_ptr->get_future();
+    return copy;
+  }
+
+  void
+  copyStripe(const StripeCopy &copy, const std::vector<IOPosBuffer> &target)
+  {
+    assert(copy.m_iolist->size() == target.size());
+    for (size_t idx = 0; idx < target.size(); idx++)
+    {
+      memcpy(target[idx].data(), (*copy.m_iolist)[idx].data(), target[idx].size());
+    }
+  }
+}
+
+std::future<IOSize>
+XrdAdaptor::RequestManager::handleStriped(std::shared_ptr<std::vector<IOPosBuffer> > iolist)
+{
+    std::vector<std::shared_ptr<std::vector<IOPosBuffer> > > requests;
+    splitClientRequest(*iolist, requests);
+
+    std::shared_ptr<RequestManager> self = m_self.lock();
+    int threshold = hedgeThreshold();
+    // A hedged stripe may be abandoned while still in flight, so it cannot read
+    // into the caller's buffers; this costs one copy of the stripe.
+    bool hedge = (threshold >= 0) && self;
+
+    std::vector<Stripe> stripes;
+    for (size_t idx = 0; idx < requests.size(); idx++)
+    {
+        if (requests[idx]->empty()) continue;
+        Stripe stripe;
+        stripe.m_target = requests[idx];
+        if (hedge) {stripe.m_completion = std::make_shared<RequestCompletion>();}
+        stripe.m_primary = issueStripe(*this, self, m_activeSources[idx], *requests[idx], hedge, stripe.m_completion);
+        stripes.push_back(std::move(stripe));
+    }
+    if (stripes.empty())
+    {   // Degenerate case - no bytes to read.
+        std::promise<IOSize> p; p.set_value(0);
+        return p.get_future();
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::async(std::launch::deferred,
+        [self, hedge, threshold, start](std::vector<Stripe> stripes) {
+            // As in the two-source case, we must wait until every stripe reading into
+            // the caller's buffers is done before returning or throwing.
+            IOSize total = 0;
+            std::exception_ptr failure;
+            for (auto & stripe : stripes)
+            {
+                StripeCopy *first = &stripe.m_primary;
+                StripeCopy hedged;
+                if (hedge && (stripe.m_primary.m_future.wait_until(start + std::chrono::milliseconds(threshold)) == std::future_status::timeout))
+                {
+                    std::shared_ptr<Source> other = self->pickHedgeSource(stripe.m_primary.m_source.get());
+                    if (other)
+                    {
+                        edm::LogVerbatim("XrdAdaptorInternal") << "Stripe from " << stripe.m_primary.m_source->PrettyID()
+                            << " slower than " << threshold << "ms; hedging on " << other->PrettyID() << std::endl;
+                        hedged = issueStripe(*self, self, other, *stripe.m_target, true, stripe.m_completion);
+                        first = nullptr;
+                        stripe.m_completion->wait([&]() {
+                            if (stripe.m_primary.m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {first = &stripe.m_primary;}
+                            else if (hedged.m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {first = &hedged;}
+                            return first != nullptr;
+                        });
+                        other->recordHedge(first == &hedged);
+                    }
+                }
+                StripeCopy *second = (first == &hedged) ? &stripe.m_primary : (hedged.m_future.valid() ? &hedged : nullptr);
+                bool done = false;
+                std::exception_ptr stripe_failure;
+                for (StripeCopy *copy : {first, second})
+                {
+                    if (!copy) continue;
+                    try
+                    {
+                        total += copy->m_future.get();
+                        if (hedge) {copyStripe(*copy, *stripe.m_target);}
+                        done = true;
+                        break;
+                    }
+                    catch (...)
+                    {
+                        stripe_failure = std::current_exception();
+                    }
+                }
+                if (!done && !failure) {failure = stripe_failure;}
+                // Stripes are waited for in order, so later ones may be recorded as
+                // slower than they were; this only makes hedging more conservative.
+                if (done && self)
+                {
+                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+                    self->recordStripeLatency(elapsed.count());
+                }
+            }
+            if (failure) {std::rethrow_exception(failure);}
+            return total;
+        },
+        std::move(stripes));
+}
+
+int
+XrdAdaptor::RequestManager::hedgeThreshold()
+{
+    if (m_hedgePercentile <= 0) {return -1;}
+    std::vector<int> latencies;
+    {
+        std::lock_guard<std::mutex> sentry(m_latency_mutex);
+        if (m_stripeLatencies.size() < XRD_ADAPTOR_HEDGE_MIN_SAMPLES) {return -1;}
+        latencies = m_stripeLatencies;
+    }
+    size_t idx = std::min(latencies.size()*m_hedgePercentile/100, latencies.size()-1);
+    std::nth_element(latencies.begin(), latencies.begin()+idx, latencies.end());
+    return std::max(latencies[idx], XRD_ADAPTOR_HEDGE_MIN_DELAY);
+}
+
+void
+XrdAdaptor::RequestManager::recordStripeLatency(int ms)
+{
+    std::lock_guard<std::mutex> sentry(m_latency_mutex);
+    if (m_stripeLatencies.size() < XRD_ADAPTOR_HEDGE_SAMPLES)
+    {
+        m_stripeLatencies.push_back(ms);
+    }
+    else
+    {
+        m_stripeLatencies[m_nextStripeLatency] = ms;
+        m_nextStripeLatency = (m_nextStripeLatency+1) % XRD_ADAPTOR_HEDGE_SAMPLES;
+    }
+}
+
+std::shared_ptr<Source>
+XrdAdaptor::RequestManager::pickHedgeSource(const Source *exclude)
+{
+    std::lock_guard<std::recursive_mutex> sentry(m_source_mutex);
+    std::shared_ptr<Source> best;
+    for (const auto & source : m_activeSources)
+    {
+        if (source.get() == exclude) continue;
+        if (!best || (source->getQuality() < best->getQuality())) {best = source;}
+    }
+    return best;
+}
+
 XrdAdaptor::RequestManager::OpenHandler::OpenHandler(std::weak_ptr<RequestManager> manager)
   : m_manager(manager)
 {
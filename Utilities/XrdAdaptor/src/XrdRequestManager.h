@@ -137,6 +137,39 @@ private:
      */
     void splitClientRequest(const std::vector<IOPosBuffer> &iolist, std::vector<IOPosBuffer> &req1, std::vector<IOPosBuffer> &req2);
 
+    /**
+     * Given a client request, split it into one request list per active source
+     * weighted by the source quality.  Entries for a source may be empty.
+     */
+    void splitClientRequest(const std::vector<IOPosBuffer> &iolist, std::vector<std::shared_ptr<std::vector<IOPosBuffer> > > &requests);
+
+    /**
+     * Stripe a vector read across all active sources.  If hedging is enabled, a
+     * stripe that is slower than the configured latency percentile is duplicated
+     * on another source and the first result wins.
+     *
+     * NOTE: the caller must already hold m_source_mutex
+     */
+    std::future<IOSize> handleStriped(std::shared_ptr<std::vector<IOPosBuffer> > iolist);
+
+    /**
+     * The latency in ms after which a stripe is hedged, or -1 if not enough
+     * stripes were seen yet or hedging is disabled.
+     */
+    int hedgeThreshold();
+    void recordStripeLatency(int ms);
+
+    /**
+     * Picks the best active source other than the given one; may return nullptr.
+     */
+    std::shared_ptr<Source> pickHedgeSource(const Source *exclude);
+
+    /**
+     * Helper function for checkSources; compares every active source against
+     * the best of the others.  The caller must already hold m_source_mutex.
+     */
+    bool compareAllSources(const timespec &now);
+
     /**
      * Given a request, broadcast it to all sources.
      * If active is true, broadcast is made to all active sources.
@@ -192,8 +225,14 @@ private:
 
     timespec m_lastSourceCheck;
     int m_timeout;
-    // If set to true, the next active source should be 1; 0 otherwise.
-    bool m_nextInitialSourceToggle;
+    // Index (modulo the number of active sources) of the next source used for a single read.
+    unsigned m_nextInitialSource;
+    // Maximum number of sources kept active; vector reads are striped across all of them.
+    unsigned m_maxActiveSources;
+    // Latency percentile (0-100) of past stripes above which a stripe is hedged; 0 disables hedging.
+    int m_hedgePercentile;
+    // Searches in a row for a new source which brought no new server.
+    unsigned m_unproductiveSearches;
     // The time when the next active source check should be performed.
     timespec m_nextActiveSourceCheck;
     bool searchMode;
@@ -208,6 +247,12 @@ private:
 
     std::atomic<unsigned> m_excluded_active_count;
 
+    std::mutex m_latency_mutex;
+    std::vector<int> m_stripeLatencies;
+    size_t m_nextStripeLatency;
+
+    std::weak_ptr<RequestManager> m_self;
+
     class OpenHandler : boost::noncopyable, public XrdCl::ResponseHandler {
 
     public:
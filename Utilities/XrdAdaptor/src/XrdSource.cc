@@ -82,7 +82,8 @@ Source::Source(timespec now, std::unique_ptr<XrdCl::File> fh, const std::string
       m_exclude(exclude),
       m_fh(std::move(fh)),
       m_qm(QualityMetricFactory::get(now, m_id)),
-      m_stats(nullptr)
+      m_stats(nullptr),
+      m_serverStats(nullptr)
 #ifdef XRD_FAKE_SLOW
     , m_slow(++g_delayCount % XRD_SLOW_RATE == 0)
     //, m_slow(++g_delayCount >= XRD_SLOW_RATE)
@@ -109,6 +110,7 @@ Source::Source(timespec now, std::unique_ptr<XrdCl::File> fh, const std::string
     if (statsService)
     {
         m_stats = statsService->getStatisticsForSite(m_site);
+        m_serverStats = statsService->getStatisticsForServer(m_id);
     }
 }
 
@@ -306,6 +308,13 @@ validateList(const XrdCl::ChunkList& cl)
     assert(cl.size() <= 1024);
 }
 
+void
+Source::recordHedge(bool won)
+{
+    if (m_stats) {m_stats->recordHedge(won);}
+    if (m_serverStats) {m_serverStats->recordHedge(won);}
+}
+
 void
 Source::handle(std::shared_ptr<ClientRequest> c)
 {
@@ -318,6 +327,10 @@ Source::handle(std::shared_ptr<ClientRequest> c)
         std::shared_ptr<XrdReadStatistics> readStats = XrdSiteStatistics::startRead(m_stats, c);
         c->setStatistics(readStats);
     }
+    if (m_serverStats)
+    {
+        c->setServerStatistics(XrdSiteStatistics::startRead(m_serverStats, c));
+    }
 #ifdef XRD_FAKE_SLOW
     if (m_slow) std::this_thread::sleep_for(std::chrono::milliseconds(XRD_DELAY));
 #endif
@@ -39,6 +39,9 @@ public:
 
     unsigned getQuality() {return m_qm->get();}
 
+    // Record a hedged duplicate request sent to this source.
+    void recordHedge(bool won);
+
     struct timespec getLastDowngrade() const {return m_lastDowngrade;}
     void setLastDowngrade(struct timespec now) {m_lastDowngrade = now;}
 
@@ -72,6 +75,7 @@ private:
 
     std::unique_ptr<QualityMetricSource> m_qm;
     std::shared_ptr<XrdSiteStatistics> m_stats;
+    std::shared_ptr<XrdSiteStatistics> m_serverStats;
 
 #ifdef XRD_FAKE_SLOW
     bool m_slow;
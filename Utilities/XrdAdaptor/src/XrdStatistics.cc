@@ -42,6 +42,11 @@ void XrdStatisticsService::postEndJob()
         stats->recomputeProperties(props);
         reportSvc->reportPerformanceForModule(stats->site(), "XrdSiteStatistics", props);
     }
+    for (std::shared_ptr<XrdSiteStatistics> const &stats : instance->m_servers)
+    {
+        stats->recomputeProperties(props);
+        reportSvc->reportPerformanceForModule(stats->site(), "XrdServerStatistics", props);
+    }
 }
 
 
@@ -58,6 +63,19 @@ XrdSiteStatisticsInformation::getStatisticsForSite(std::string const &site)
 }
 
 
+std::shared_ptr<XrdSiteStatistics>
+XrdSiteStatisticsInformation::getStatisticsForServer(std::string const &server)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::shared_ptr<XrdSiteStatistics> &stats : m_servers)
+    {
+        if (stats->site() == server) {return stats;}
+    }
+    m_servers.emplace_back(new XrdSiteStatistics(server));
+    return m_servers.back();
+}
+
+
 void
 XrdSiteStatisticsInformation::createInstance()
 {
@@ -97,7 +115,9 @@ XrdSiteStatistics::XrdSiteStatistics(std::string const &site) :
     m_readvNS(0.0),
     m_readCount(0),
     m_readSize(0),
-    m_readNS(0)
+    m_readNS(0),
+    m_hedgeCount(0),
+    m_hedgeWinCount(0)
 {
 }
 
@@ -140,6 +160,13 @@ XrdSiteStatistics::recomputeProperties(std::map<std::string, std::string> &props
     props["read-numOperations"] = i2str(m_readCount);
     props["read-totalMegabytes"] = d2str(static_cast<float>(m_readSize)/(1024.0*1024.0));
     props["read-totalMsecs"] = d2str(static_cast<float>(m_readNS)/1e6);
+
+    uint64_t const totalNS = m_readvNS + m_readNS;
+    float const totalMB = static_cast<float>(m_readvSize + m_readSize)/(1024.0*1024.0);
+    props["read-MBps"] = d2str(totalNS ? totalMB/(totalNS/1e9) : 0.);
+
+    props["hedged-numOperations"] = i2str(m_hedgeCount);
+    props["hedged-numWon"] = i2str(m_hedgeWinCount);
 }
 
 
@@ -162,6 +189,14 @@ XrdSiteStatistics::finishRead(XrdReadStatistics const &readStats)
 }
 
 
+void
+XrdSiteStatistics::recordHedge(bool won)
+{
+    m_hedgeCount ++;
+    if (won) {m_hedgeWinCount ++;}
+}
+
+
 XrdReadStatistics::XrdReadStatistics(std::shared_ptr<XrdSiteStatistics> parent, IOSize size, size_t count) :
     m_size(size),
     m_count(count),
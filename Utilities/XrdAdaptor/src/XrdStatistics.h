@@ -50,12 +50,16 @@ public:
 
     std::shared_ptr<XrdSiteStatistics> getStatisticsForSite(std::string const &site);
 
+    // Same bookkeeping as for sites, but for each individual data server.
+    std::shared_ptr<XrdSiteStatistics> getStatisticsForServer(std::string const &server);
+
 private:
     static void createInstance();
 
     static std::atomic<XrdSiteStatisticsInformation*> m_instance;
     std::mutex m_mutex;
     std::vector<std::shared_ptr<XrdSiteStatistics>> m_sites;
+    std::vector<std::shared_ptr<XrdSiteStatistics>> m_servers;
 };
 
 class XrdSiteStatistics
@@ -77,6 +81,10 @@ public:
 
     void finishRead(XrdReadStatistics const &);
 
+    // A duplicate request was sent here because another server was slow;
+    // won is true if it finished first.
+    void recordHedge(bool won);
+
 private:
     const std::string m_site = "Unknown";
 
@@ -87,6 +95,8 @@ private:
     std::atomic<unsigned> m_readCount;
     std::atomic<uint64_t> m_readSize;
     std::atomic<uint64_t> m_readNS;
+    std::atomic<unsigned> m_hedgeCount;
+    std::atomic<unsigned> m_hedgeWinCount;
 };
 
 class XrdReadStatistics